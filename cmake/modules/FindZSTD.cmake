@@ -0,0 +1,58 @@
+#
+# Copyright 2013-2022 Software Radio Systems Limited
+#
+# This file is part of srsRAN
+#
+# srsRAN is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Affero General Public License as
+# published by the Free Software Foundation, either version 3 of
+# the License, or (at your option) any later version.
+#
+# srsRAN is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU Affero General Public License for more details.
+#
+# A copy of the GNU Affero General Public License can be found in
+# the LICENSE file in the top-level directory of this distribution
+# and at http://www.gnu.org/licenses/.
+#
+
+# - Try to find zstd
+#
+# Once done this will define
+#  ZSTD_FOUND        - System has zstd
+#  ZSTD_INCLUDE_DIRS - The zstd include directories
+#  ZSTD_LIBRARIES    - The zstd library
+
+FIND_PACKAGE(PkgConfig REQUIRED)
+PKG_CHECK_MODULES(PC_ZSTD libzstd)
+
+FIND_PATH(
+    ZSTD_INCLUDE_DIRS
+    NAMES zstd.h
+    HINTS ${PC_ZSTD_INCLUDEDIR}
+          ${CMAKE_INSTALL_PREFIX}/include
+    PATHS /usr/local/include
+          /usr/include
+)
+
+FIND_LIBRARY(
+    ZSTD_LIBRARIES
+    NAMES zstd
+    HINTS ${PC_ZSTD_LIBDIR}
+          ${CMAKE_INSTALL_PREFIX}/lib
+          ${CMAKE_INSTALL_PREFIX}/lib64
+    PATHS /usr/local/lib
+          /usr/local/lib64
+          /usr/lib
+          /usr/lib64
+          /usr/lib/x86_64-linux-gnu/
+)
+
+message(STATUS "ZSTD LIBRARIES: " ${ZSTD_LIBRARIES})
+message(STATUS "ZSTD INCLUDE DIRS: " ${ZSTD_INCLUDE_DIRS})
+
+INCLUDE(FindPackageHandleStandardArgs)
+FIND_PACKAGE_HANDLE_STANDARD_ARGS(ZSTD DEFAULT_MSG ZSTD_LIBRARIES ZSTD_INCLUDE_DIRS)
+MARK_AS_ADVANCED(ZSTD_LIBRARIES ZSTD_INCLUDE_DIRS)
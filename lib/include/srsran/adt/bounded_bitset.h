@@ -24,9 +24,12 @@
 
 #include "srsran/srslog/bundled/fmt/format.h"
 #include "srsran/support/srsran_assert.h"
+#include <algorithm>
 #include <cstdint>
 #include <inttypes.h>
+#include <limits>
 #include <string>
+#include <utility>
 
 namespace srsran {
 
@@ -126,6 +129,21 @@ struct zerobit_counter<Integer, 8> {
 };
 #endif
 
+/// Number of bits set to one
+template <typename Integer>
+unsigned popcount(Integer value)
+{
+#ifdef __GNUC__
+  return static_cast<unsigned>(__builtin_popcountll(value));
+#else
+  unsigned c = 0;
+  for (; value != 0; c++) {
+    value &= value - 1;
+  }
+  return c;
+#endif
+}
+
 } // namespace detail
 
 /// uses lsb as zero position
@@ -218,14 +236,16 @@ public:
   bounded_bitset<N, reversed>& fill(size_t startpos, size_t endpos, bool value = true)
   {
     assert_range_bounds_(startpos, endpos);
-    // NOTE: can be optimized
-    if (value) {
-      for (size_t i = startpos; i < endpos; ++i) {
-        set_(i);
-      }
-    } else {
-      for (size_t i = startpos; i < endpos; ++i) {
-        reset_(i);
+    if (startpos == endpos) {
+      return *this;
+    }
+    size_t bstart = get_range_start_(startpos, endpos), bend = bstart + (endpos - startpos);
+    for (size_t i = bstart / bits_per_word; i <= (bend - 1) / bits_per_word; ++i) {
+      word_t mask = range_mask_(i, bstart, bend);
+      if (value) {
+        buffer[i] |= mask;
+      } else {
+        buffer[i] &= ~mask;
       }
     }
     return *this;
@@ -273,15 +293,86 @@ public:
   {
     assert_within_bounds_(start, false);
     assert_within_bounds_(stop, false);
-    // NOTE: can be optimized
-    for (size_t i = start; i < stop; ++i) {
-      if (test_(i)) {
+    if (start >= stop) {
+      return false;
+    }
+    size_t bstart = get_range_start_(start, stop), bend = bstart + (stop - start);
+    for (size_t i = bstart / bits_per_word; i <= (bend - 1) / bits_per_word; ++i) {
+      if ((buffer[i] & range_mask_(i, bstart, bend)) != 0) {
         return true;
       }
     }
     return false;
   }
 
+  /// Number of bits set in [startpos, endpos)
+  size_t count(size_t startpos, size_t endpos) const noexcept
+  {
+    assert_range_bounds_(startpos, endpos);
+    if (startpos == endpos) {
+      return 0;
+    }
+    size_t bstart = get_range_start_(startpos, endpos), bend = bstart + (endpos - startpos);
+    size_t result = 0;
+    for (size_t i = bstart / bits_per_word; i <= (bend - 1) / bits_per_word; ++i) {
+      result += detail::popcount(buffer[i] & range_mask_(i, bstart, bend));
+    }
+    return result;
+  }
+
+  /**
+   * @brief Finds the lowest run of "length" consecutive bits equal to "value" in [startpos, endpos). The bitset is
+   * processed a word at a time. Within a word, the positions where a run fits are derived with shifts and ANDs, and
+   * runs that cross words are tracked through their leading/trailing bits
+   * @return Position of the first bit of the run, or -1 if there is no such run
+   */
+  int find_lowest_run(size_t startpos, size_t endpos, size_t length, bool value = true) const noexcept
+  {
+    assert_range_bounds_(startpos, endpos);
+    if (length == 0) {
+      return static_cast<int>(startpos);
+    }
+    // Not enough bits with the given value in the range for the run to fit
+    if (endpos - startpos < length or
+        (value ? count(startpos, endpos) : (endpos - startpos) - count(startpos, endpos)) < length) {
+      return -1;
+    }
+    if (not reversed) {
+      return find_run_(startpos, endpos, length, value);
+    }
+    int pos = find_run_reversed_(size() - endpos, size() - startpos, length, value);
+    return pos < 0 ? -1 : static_cast<int>(size() - 1 - pos);
+  }
+
+  /**
+   * @brief Finds the longest run of consecutive bits equal to "value" in [startpos, endpos). Among runs of the same
+   * length, the lowest one is returned. The search stops early once a run of max_length bits is found
+   * @return Pair with the position of the first bit of the run, or -1 if there is none, and the run length
+   */
+  std::pair<int, size_t> find_longest_run(size_t startpos,
+                                          size_t endpos,
+                                          bool   value      = true,
+                                          size_t max_length = std::numeric_limits<size_t>::max()) const noexcept
+  {
+    std::pair<int, size_t> ret{-1, 0};
+    for (size_t n = startpos; n < endpos;) {
+      int pos = find_lowest(n, endpos, value);
+      if (pos < 0) {
+        break;
+      }
+      int    pos2 = find_lowest(pos, endpos, not value);
+      size_t stop = pos2 < 0 ? endpos : pos2;
+      if (stop - pos > ret.second) {
+        ret = {pos, stop - pos};
+        if (ret.second >= max_length) {
+          break;
+        }
+      }
+      n = stop;
+    }
+    return ret;
+  }
+
   bool none() const noexcept { return !any(); }
 
   size_t count() const noexcept
@@ -457,6 +548,125 @@ private:
 
   static word_t maskbit(size_t pos) noexcept { return (static_cast<word_t>(1)) << (pos % bits_per_word); }
 
+  /// Position in the buffer of the first bit of the range [startpos, endpos)
+  size_t get_range_start_(size_t startpos, size_t endpos) const noexcept
+  {
+    return reversed ? size() - endpos : startpos;
+  }
+
+  /// Mask of the bits of the word i that are within the buffer positions [bstart, bend)
+  static word_t range_mask_(size_t i, size_t bstart, size_t bend) noexcept
+  {
+    word_t mask = ~static_cast<word_t>(0);
+    if (i == bstart / bits_per_word) {
+      mask &= mask_lsb_zeros<word_t>(bstart % bits_per_word);
+    }
+    if (i == (bend - 1) / bits_per_word) {
+      mask &= mask_lsb_ones<word_t>((bend - 1) % bits_per_word + 1);
+    }
+    return mask;
+  }
+
+  /// Word i with ones in the buffer positions within [bstart, bend) whose bit is equal to "value"
+  word_t get_run_word_(size_t i, size_t bstart, size_t bend, bool value) const noexcept
+  {
+    return (value ? buffer[i] : ~buffer[i]) & range_mask_(i, bstart, bend);
+  }
+
+  /// Sets the bit i of the word iff the bits [i, i + length) are set. Requires length <= bits_per_word
+  static word_t run_starts_(word_t w, size_t length) noexcept
+  {
+    for (size_t len = 1; len < length and w != 0;) {
+      size_t step = std::min(len, length - len);
+      w &= w >> step;
+      len += step;
+    }
+    return w;
+  }
+
+  /// Sets the bit i of the word iff the bits [i - length + 1, i] are set. Requires length <= bits_per_word
+  static word_t run_ends_(word_t w, size_t length) noexcept
+  {
+    for (size_t len = 1; len < length and w != 0;) {
+      size_t step = std::min(len, length - len);
+      w &= w << step;
+      len += step;
+    }
+    return w;
+  }
+
+  /// Returns the buffer position of the first bit of the lowest run within the buffer positions [bstart, bend)
+  int find_run_(size_t bstart, size_t bend, size_t length, bool value) const noexcept
+  {
+    using counter     = detail::zerobit_counter<word_t, sizeof(word_t)>;
+    size_t run_start  = 0;
+    size_t run_length = 0;
+    for (size_t i = bstart / bits_per_word; i <= (bend - 1) / bits_per_word; ++i) {
+      word_t w = get_run_word_(i, bstart, bend, value);
+      if (run_length > 0) {
+        // Continue the run that reached the end of the previous word
+        size_t nof_ones = counter::lsb_count(~w);
+        if (run_length + nof_ones >= length) {
+          return static_cast<int>(run_start);
+        }
+        if (nof_ones == bits_per_word) {
+          run_length += bits_per_word;
+          continue;
+        }
+        run_length = 0;
+      }
+      if (length <= bits_per_word) {
+        word_t starts = run_starts_(w, length);
+        if (starts != 0) {
+          return static_cast<int>(i * bits_per_word + find_first_lsb_one(starts));
+        }
+      }
+      // Run that reaches the end of the word
+      size_t nof_ones = counter::msb_count(~w);
+      if (nof_ones > 0) {
+        run_start  = (i + 1) * bits_per_word - nof_ones;
+        run_length = nof_ones;
+      }
+    }
+    return -1;
+  }
+
+  /// Returns the buffer position of the last bit of the highest run within the buffer positions [bstart, bend)
+  int find_run_reversed_(size_t bstart, size_t bend, size_t length, bool value) const noexcept
+  {
+    using counter     = detail::zerobit_counter<word_t, sizeof(word_t)>;
+    size_t run_stop   = 0;
+    size_t run_length = 0;
+    for (size_t i = (bend - 1) / bits_per_word + 1; i-- > bstart / bits_per_word;) {
+      word_t w = get_run_word_(i, bstart, bend, value);
+      if (run_length > 0) {
+        // Continue the run that reached the start of the previous word
+        size_t nof_ones = counter::msb_count(~w);
+        if (run_length + nof_ones >= length) {
+          return static_cast<int>(run_stop);
+        }
+        if (nof_ones == bits_per_word) {
+          run_length += bits_per_word;
+          continue;
+        }
+        run_length = 0;
+      }
+      if (length <= bits_per_word) {
+        word_t ends = run_ends_(w, length);
+        if (ends != 0) {
+          return static_cast<int>(i * bits_per_word + find_first_msb_one(ends));
+        }
+      }
+      // Run that reaches the start of the word
+      size_t nof_ones = counter::lsb_count(~w);
+      if (nof_ones > 0) {
+        run_stop   = i * bits_per_word + nof_ones - 1;
+        run_length = nof_ones;
+      }
+    }
+    return -1;
+  }
+
   static size_t max_nof_words_() noexcept { return (N - 1) / bits_per_word + 1; }
 
   int find_last_(size_t startpos, size_t endpos, bool value) const noexcept
@@ -0,0 +1,174 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_INDEXED_HEAP_H
+#define SRSRAN_INDEXED_HEAP_H
+
+#include "srsran/support/srsran_assert.h"
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace srsran {
+
+/**
+ * Binary heap of objects identified by an index in [0, capacity). Contrarily to std::priority_queue, the key of an
+ * object in the heap can be updated, or the object removed, in O(log N), so the priority of a set of objects can be
+ * kept up-to-date without rebuilding the heap.
+ * As in std::priority_queue, the top of the heap is the object with the highest key for the given comparator.
+ * Memory is only allocated at construction.
+ */
+template <typename Key, typename Compare = std::less<Key> >
+class indexed_heap
+{
+public:
+  using index_type = uint32_t;
+
+  static constexpr index_type npos = UINT32_MAX;
+
+  explicit indexed_heap(size_t capacity_, const Compare& comp_ = Compare{}) : pos(capacity_, npos), comp(comp_)
+  {
+    heap.reserve(capacity_);
+  }
+
+  size_t size() const { return heap.size(); }
+  bool   empty() const { return heap.empty(); }
+  size_t capacity() const { return pos.size(); }
+  bool   contains(index_type idx) const { return idx < pos.size() and pos[idx] != npos; }
+
+  const Key& key(index_type idx) const
+  {
+    srsran_assert(contains(idx), "Index %d is not in the heap", idx);
+    return heap[pos[idx]].key;
+  }
+  index_type top() const
+  {
+    srsran_assert(not empty(), "top() called for empty heap");
+    return heap[0].idx;
+  }
+  const Key& top_key() const
+  {
+    srsran_assert(not empty(), "top() called for empty heap");
+    return heap[0].key;
+  }
+
+  /// Inserts the object with the given key, or updates its key if it is already in the heap
+  void set(index_type idx, const Key& key_)
+  {
+    srsran_assert(idx < pos.size(), "Index %d exceeds heap capacity %zd", idx, pos.size());
+    if (pos[idx] == npos) {
+      pos[idx] = heap.size();
+      heap.push_back(node_t{key_, idx});
+      sift_up(pos[idx]);
+      return;
+    }
+    size_t i     = pos[idx];
+    bool   is_up = comp(heap[i].key, key_);
+    heap[i].key  = key_;
+    if (is_up) {
+      sift_up(i);
+    } else {
+      sift_down(i);
+    }
+  }
+
+  /// Removes the object from the heap. Does nothing if it is not in the heap
+  void erase(index_type idx)
+  {
+    if (not contains(idx)) {
+      return;
+    }
+    size_t i = pos[idx];
+    pos[idx] = npos;
+    if (i == heap.size() - 1) {
+      heap.pop_back();
+      return;
+    }
+    heap[i] = heap.back();
+    heap.pop_back();
+    pos[heap[i].idx] = i;
+    if (i > 0 and comp(heap[parent(i)].key, heap[i].key)) {
+      sift_up(i);
+    } else {
+      sift_down(i);
+    }
+  }
+
+  void pop() { erase(top()); }
+
+  void clear()
+  {
+    for (const node_t& n : heap) {
+      pos[n.idx] = npos;
+    }
+    heap.clear();
+  }
+
+private:
+  struct node_t {
+    Key        key;
+    index_type idx;
+  };
+
+  static size_t parent(size_t i) { return (i - 1) / 2; }
+
+  void sift_up(size_t i)
+  {
+    node_t n = heap[i];
+    while (i > 0 and comp(heap[parent(i)].key, n.key)) {
+      heap[i]          = heap[parent(i)];
+      pos[heap[i].idx] = i;
+      i                = parent(i);
+    }
+    heap[i]    = n;
+    pos[n.idx] = i;
+  }
+
+  void sift_down(size_t i)
+  {
+    node_t n = heap[i];
+    while (true) {
+      size_t child = 2 * i + 1;
+      if (child >= heap.size()) {
+        break;
+      }
+      if (child + 1 < heap.size() and comp(heap[child].key, heap[child + 1].key)) {
+        child++;
+      }
+      if (not comp(n.key, heap[child].key)) {
+        break;
+      }
+      heap[i]          = heap[child];
+      pos[heap[i].idx] = i;
+      i                = child;
+    }
+    heap[i]    = n;
+    pos[n.idx] = i;
+  }
+
+  std::vector<node_t>     heap;
+  std::vector<index_type> pos;
+  Compare                 comp;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_INDEXED_HEAP_H
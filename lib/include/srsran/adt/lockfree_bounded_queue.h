@@ -0,0 +1,201 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_LOCKFREE_BOUNDED_QUEUE_H
+#define SRSRAN_LOCKFREE_BOUNDED_QUEUE_H
+
+#include "srsran/support/srsran_assert.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+namespace srsran {
+
+/**
+ * Bounded queue for multiple producers and multiple consumers that does not take locks (D. Vyukov's algorithm).
+ * Each cell has a sequence number that tells whether it is free for the next push or holds the value of the next pop,
+ * so producers and consumers only contend on the increment of their position.
+ * A thread may find the next cell still claimed by a consumer releasing it or a producer filling it. try_push() and
+ * try_pop() yield a bounded number of times and then give up as if the queue was full or empty: yielding does not let
+ * a preempted thread of lower priority run, so a SCHED_FIFO thread waiting for it without bound would livelock.
+ * push() and pop() only fail if the queue is full or empty, they sleep between attempts until the cell is completed.
+ * The capacity is rounded up to a power of 2.
+ * @tparam T type of the stored values. It should be cheap to move
+ */
+template <typename T>
+class lockfree_bounded_queue
+{
+public:
+  explicit lockfree_bounded_queue(size_t capacity_) : cells(new cell_t[next_pow2(capacity_)])
+  {
+    srsran_assert(capacity_ > 0, "The queue capacity must be positive");
+    mask = next_pow2(capacity_) - 1;
+    for (size_t i = 0; i <= mask; ++i) {
+      cells[i].seq.store(i, std::memory_order_relaxed);
+    }
+  }
+  lockfree_bounded_queue(const lockfree_bounded_queue&) = delete;
+  lockfree_bounded_queue& operator=(const lockfree_bounded_queue&) = delete;
+
+  /// Returns false if the queue is full or the next cell is not ready, in which case the value is left untouched
+  template <typename U>
+  bool try_push(U&& value)
+  {
+    return push_(std::forward<U>(value)) == result::success;
+  }
+
+  /// Returns false if the queue is empty or the next cell is not ready
+  bool try_pop(T& value) { return pop_(value) == result::success; }
+
+  /// Returns false if the queue is full, in which case the value is left untouched. It waits for the next cell
+  template <typename U>
+  bool push(U&& value)
+  {
+    result ret;
+    while ((ret = push_(std::forward<U>(value))) == result::not_ready) {
+      std::this_thread::sleep_for(std::chrono::microseconds(not_ready_backoff_us));
+    }
+    return ret == result::success;
+  }
+
+  /// Returns false if the queue is empty. It waits for the next cell
+  bool pop(T& value)
+  {
+    result ret;
+    while ((ret = pop_(value)) == result::not_ready) {
+      std::this_thread::sleep_for(std::chrono::microseconds(not_ready_backoff_us));
+    }
+    return ret == result::success;
+  }
+
+  size_t capacity() const { return mask + 1; }
+
+  /// Number of stored values. Only a hint while other threads push or pop
+  size_t size() const
+  {
+    size_t tail = dequeue_pos.load(std::memory_order_relaxed);
+    size_t head = enqueue_pos.load(std::memory_order_relaxed);
+    return head > tail ? head - tail : 0;
+  }
+
+private:
+  enum class result { success, full_or_empty, not_ready };
+
+  /// Number of times a thread yields waiting for the next cell before reporting it as not ready
+  static constexpr uint32_t max_not_ready_yields = 64;
+  /// Sleep of push() and pop() between attempts, long enough for the scheduler to run a preempted thread
+  static constexpr uint32_t not_ready_backoff_us = 10;
+
+  template <typename U>
+  result push_(U&& value)
+  {
+    cell_t*  cell;
+    uint32_t nof_yields = 0;
+    size_t   pos        = enqueue_pos.load(std::memory_order_relaxed);
+    while (true) {
+      cell         = &cells[pos & mask];
+      size_t  seq  = cell->seq.load(std::memory_order_acquire);
+      int64_t diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos);
+      if (diff == 0) {
+        if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        if (dequeue_pos.load(std::memory_order_relaxed) + mask + 1 == pos) {
+          return result::full_or_empty;
+        }
+        // A consumer claimed the cell but was preempted before releasing it
+        if (++nof_yields > max_not_ready_yields) {
+          return result::not_ready;
+        }
+        std::this_thread::yield();
+        pos = enqueue_pos.load(std::memory_order_relaxed);
+      } else {
+        pos = enqueue_pos.load(std::memory_order_relaxed);
+      }
+    }
+    cell->value = std::forward<U>(value);
+    cell->seq.store(pos + 1, std::memory_order_release);
+    return result::success;
+  }
+
+  result pop_(T& value)
+  {
+    cell_t*  cell;
+    uint32_t nof_yields = 0;
+    size_t   pos        = dequeue_pos.load(std::memory_order_relaxed);
+    while (true) {
+      cell         = &cells[pos & mask];
+      size_t  seq  = cell->seq.load(std::memory_order_acquire);
+      int64_t diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos + 1);
+      if (diff == 0) {
+        if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        if (enqueue_pos.load(std::memory_order_relaxed) == pos) {
+          return result::full_or_empty;
+        }
+        // A producer claimed the cell but was preempted before filling it. The values pushed after it are only
+        // reachable once it completes
+        if (++nof_yields > max_not_ready_yields) {
+          return result::not_ready;
+        }
+        std::this_thread::yield();
+        pos = dequeue_pos.load(std::memory_order_relaxed);
+      } else {
+        pos = dequeue_pos.load(std::memory_order_relaxed);
+      }
+    }
+    value = std::move(cell->value);
+    cell->seq.store(pos + mask + 1, std::memory_order_release);
+    return result::success;
+  }
+
+  struct cell_t {
+    std::atomic<size_t> seq;
+    T                   value;
+  };
+
+  static size_t next_pow2(size_t n)
+  {
+    size_t ret = 1;
+    while (ret < n) {
+      ret <<= 1;
+    }
+    return ret;
+  }
+
+  // The positions are kept in different cache lines, the producers and the consumers do not invalidate each other
+  std::unique_ptr<cell_t[]> cells;
+  size_t                    mask = 0;
+  uint8_t                   padding0[64];
+  std::atomic<size_t>       enqueue_pos = {0};
+  uint8_t                   padding1[64];
+  std::atomic<size_t>       dequeue_pos = {0};
+  uint8_t                   padding2[64];
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_LOCKFREE_BOUNDED_QUEUE_H
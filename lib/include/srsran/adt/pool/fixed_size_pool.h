@@ -31,8 +31,8 @@ namespace srsran {
 /**
  * Concurrent fixed size memory pool made of blocks of equal size
  * Each worker keeps a separate thread-local memory block cache that it uses for fast allocation/deallocation.
- * When this cache gets depleted, the worker tries to obtain blocks from a central memory block cache.
- * When accessing a thread local cache, no locks are required.
+ * When this cache gets depleted, the worker tries to obtain a batch of blocks from a central memory block cache.
+ * Neither the thread local caches nor the exchange of batches with the central cache take locks.
  * Since there is no stealing of blocks between workers, it is possible that a worker can't allocate while another
  * worker still has blocks in its own cache. To minimize the impact of this event, an upper bound is place on a worker
  * thread cache size. Once a worker reaches that upper bound, it sends half of its stored blocks to the central cache.
@@ -55,17 +55,22 @@ class concurrent_fixed_memory_pool
   const static size_t batch_steal_size = 16;
 
   // ctor only accessible from singleton get_instance()
-  explicit concurrent_fixed_memory_pool(size_t nof_objects_)
+  explicit concurrent_fixed_memory_pool(size_t nof_objects_) : central_mem_cache(nof_objects_)
   {
     srsran_assert(nof_objects_ > batch_steal_size, "A positive pool size must be provided");
 
     std::lock_guard<std::mutex> lock(mutex);
     allocated_blocks.resize(nof_objects_);
+    free_memblock_list batch;
     for (std::unique_ptr<obj_storage_t>& b : allocated_blocks) {
       b.reset(new obj_storage_t());
       srsran_assert(b.get() != nullptr, "Failed to instantiate fixed memory pool");
-      central_mem_cache.push(static_cast<void*>(b.get()));
+      batch.push(static_cast<void*>(b.get()));
+      if (batch.size() == batch_steal_size) {
+        central_mem_cache.push(batch);
+      }
     }
+    central_mem_cache.push(batch);
     local_growth_thres = allocated_blocks.size() / 16;
     local_growth_thres = local_growth_thres < batch_steal_size ? batch_steal_size : local_growth_thres;
   }
@@ -99,13 +104,8 @@ public:
 
     void* node = worker_ctxt->cache.try_pop();
     if (node == nullptr) {
-      // fill the thread local cache enough for this and next allocations
-      std::array<void*, batch_steal_size> popped_blocks;
-      size_t                              n = central_mem_cache.try_pop(popped_blocks);
-      for (size_t i = 0; i < n; ++i) {
-        new (popped_blocks[i]) obj_storage_t();
-        worker_ctxt->cache.push(static_cast<void*>(popped_blocks[i]));
-      }
+      // fill the thread local cache with a batch of blocks for this and next allocations
+      central_mem_cache.try_pop(worker_ctxt->cache);
       node = worker_ctxt->cache.try_pop();
     }
 
@@ -137,7 +137,11 @@ public:
 
     if (worker_ctxt->cache.size() >= local_growth_thres) {
       // if local cache reached max capacity, send half of the blocks to central cache
-      central_mem_cache.steal_blocks(worker_ctxt->cache, worker_ctxt->cache.size() / 2);
+      free_memblock_list batch;
+      for (size_t n = worker_ctxt->cache.size() / 2; n > 0; --n) {
+        batch.push(worker_ctxt->cache.pop());
+      }
+      central_mem_cache.push(batch);
     }
   }
 
@@ -173,8 +177,8 @@ private:
     worker_ctxt() : id(std::this_thread::get_id()) {}
     ~worker_ctxt()
     {
-      concurrent_free_memblock_list& central_cache = pool_type::get_instance()->central_mem_cache;
-      central_cache.steal_blocks(cache, cache.size());
+      concurrent_memblock_batch_queue& central_cache = pool_type::get_instance()->central_mem_cache;
+      central_cache.push(cache);
     }
   };
 
@@ -198,7 +202,7 @@ private:
   size_t                local_growth_thres = 0;
   srslog::basic_logger* logger             = nullptr;
 
-  concurrent_free_memblock_list                central_mem_cache;
+  concurrent_memblock_batch_queue              central_mem_cache;
   std::mutex                                   mutex;
   std::vector<std::unique_ptr<obj_storage_t> > allocated_blocks;
 };
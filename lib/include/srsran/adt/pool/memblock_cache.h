@@ -23,6 +23,7 @@
 #define SRSRAN_MEMBLOCK_CACHE_H
 
 #include "pool_utils.h"
+#include "srsran/adt/lockfree_bounded_queue.h"
 #include <mutex>
 
 namespace srsran {
@@ -269,6 +270,51 @@ private:
   mutable std::mutex mutex;
 };
 
+/**
+ * Queue of batches of free memory blocks, shared by several threads without locks. Each batch is a
+ * free_memblock_list that is exchanged as a whole, so the threads only contend once per batch.
+ */
+class concurrent_memblock_batch_queue
+{
+public:
+  /// Each batch has at least one block, so the number of blocks is enough for max_batches
+  explicit concurrent_memblock_batch_queue(size_t max_batches) : batches(max_batches) {}
+
+  /// Moves all the blocks of the list to the queue as one batch. Returns false if the queue is full
+  bool push(free_memblock_list& batch) noexcept
+  {
+    if (batch.empty()) {
+      return true;
+    }
+    size_t n = batch.size();
+    nof_blocks.fetch_add(n, std::memory_order_relaxed);
+    if (not batches.push(batch)) {
+      nof_blocks.fetch_sub(n, std::memory_order_relaxed);
+      return false;
+    }
+    batch.clear();
+    return true;
+  }
+
+  /// Moves the blocks of the oldest batch to the given empty list. Returns false if the queue is empty
+  bool try_pop(free_memblock_list& batch) noexcept
+  {
+    srsran_assert(batch.empty(), "Batches can only be popped to empty lists");
+    if (not batches.try_pop(batch)) {
+      return false;
+    }
+    nof_blocks.fetch_sub(batch.size(), std::memory_order_relaxed);
+    return true;
+  }
+
+  /// Number of blocks in the queue. Only a hint while other threads push or pop
+  size_t size() const noexcept { return nof_blocks.load(std::memory_order_relaxed); }
+
+private:
+  lockfree_bounded_queue<free_memblock_list> batches;
+  std::atomic<size_t>                        nof_blocks{0};
+};
+
 /**
  * Manages the allocation, caching and deallocation of memory blocks.
  * On alloc, a memory block is stolen from cache. If cache is empty, malloc/new is called.
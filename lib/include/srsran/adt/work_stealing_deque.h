@@ -0,0 +1,136 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_WORK_STEALING_DEQUE_H
+#define SRSRAN_WORK_STEALING_DEQUE_H
+
+#include "srsran/support/srsran_assert.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+namespace srsran {
+
+/**
+ * Bounded double ended queue with a single owner and multiple thieves that does not take locks (Chase-Lev deque, with
+ * the memory orderings of Le et al., "Correct and Efficient Work-Stealing for Weak Memory Models").
+ * The owner pushes and pops at the bottom, the newest values first, and only contends with the thieves for the last
+ * value. The thieves take the oldest values from the top with a CAS.
+ * The capacity is rounded up to a power of 2.
+ * @tparam T type of the stored values. A thief may read a cell that the owner is overwriting, and discards it when its
+ *           CAS fails, so the values must be trivially copyable (e.g. indexes or pointers)
+ */
+template <typename T>
+class work_stealing_deque
+{
+  static_assert(std::is_trivially_copyable<T>::value, "The values of the deque must be trivially copyable");
+
+public:
+  explicit work_stealing_deque(size_t capacity_) : cells(new std::atomic<T>[next_pow2(capacity_)])
+  {
+    srsran_assert(capacity_ > 0, "The deque capacity must be positive");
+    mask = next_pow2(capacity_) - 1;
+  }
+  work_stealing_deque(const work_stealing_deque&) = delete;
+  work_stealing_deque& operator=(const work_stealing_deque&) = delete;
+
+  /// Called by the owner only. Returns false if the deque is full
+  bool try_push(T value)
+  {
+    int64_t b = bottom.load(std::memory_order_relaxed);
+    int64_t t = top.load(std::memory_order_acquire);
+    if (b - t > static_cast<int64_t>(mask)) {
+      return false;
+    }
+    cells[b & mask].store(value, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom.store(b + 1, std::memory_order_relaxed);
+    return true;
+  }
+
+  /// Called by the owner only. Returns false if the deque is empty, or a thief took its last value
+  bool try_pop(T& value)
+  {
+    int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+    bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t t = top.load(std::memory_order_relaxed);
+    if (t > b) {
+      bottom.store(b + 1, std::memory_order_relaxed);
+      return false;
+    }
+    value = cells[b & mask].load(std::memory_order_relaxed);
+    if (t == b) {
+      // Last value, race against the thieves for it
+      bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+      bottom.store(b + 1, std::memory_order_relaxed);
+      return won;
+    }
+    return true;
+  }
+
+  /// Can be called from any thread. Returns false if the deque is empty, or another thread took the oldest value
+  bool try_steal(T& value)
+  {
+    int64_t t = top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t b = bottom.load(std::memory_order_acquire);
+    if (t >= b) {
+      return false;
+    }
+    value = cells[t & mask].load(std::memory_order_relaxed);
+    return top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+  }
+
+  size_t capacity() const { return mask + 1; }
+
+  /// Number of stored values. Only a hint while other threads push, pop or steal
+  size_t size() const
+  {
+    int64_t b = bottom.load(std::memory_order_relaxed);
+    int64_t t = top.load(std::memory_order_relaxed);
+    return b > t ? static_cast<size_t>(b - t) : 0;
+  }
+
+private:
+  static size_t next_pow2(size_t n)
+  {
+    size_t ret = 1;
+    while (ret < n) {
+      ret <<= 1;
+    }
+    return ret;
+  }
+
+  // The owner end and the thieves end are kept in different cache lines
+  std::unique_ptr<std::atomic<T>[]> cells;
+  size_t                            mask = 0;
+  uint8_t                           padding0[64];
+  std::atomic<int64_t>              top = {0};
+  uint8_t                           padding1[64];
+  std::atomic<int64_t>              bottom = {0};
+  uint8_t                           padding2[64];
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_WORK_STEALING_DEQUE_H
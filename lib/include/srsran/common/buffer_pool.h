@@ -24,6 +24,7 @@
 
 #include "byte_buffer.h"
 #include "srsran/adt/bounded_vector.h"
+#include "srsran/adt/lockfree_bounded_queue.h"
 #include <algorithm>
 #include <map>
 #include <pthread.h>
@@ -42,7 +43,9 @@ namespace srsran {
  *
  * Preallocates a large number of buffer_t and provides allocate and
  * deallocate functions. Provides quick object creation and deletion as well
- * as object reuse.
+ * as object reuse. The free buffers are kept in a lock-free queue, so threads
+ * allocating and deallocating do not block each other. Only the blocking
+ * allocation from an empty pool takes a lock.
  * Singleton class of byte_buffer_t (but other pools of different type can be created)
  *****************************************************************************/
 
@@ -51,26 +54,22 @@ class buffer_pool
 {
 public:
   // non-static methods
-  buffer_pool(int capacity_ = -1)
+  buffer_pool(int capacity_ = -1) : capacity(capacity_ > 0 ? (uint32_t)capacity_ : POOL_SIZE), free_list(capacity)
   {
-    uint32_t nof_buffers = POOL_SIZE;
-    if (capacity_ > 0) {
-      nof_buffers = (uint32_t)capacity_;
-    }
-    pool.reserve(nof_buffers);
-    free_list.reserve(nof_buffers);
+    pool.reserve(capacity);
     pthread_mutex_init(&mutex, nullptr);
     pthread_cond_init(&cv_not_empty, nullptr);
-    for (uint32_t i = 0; i < nof_buffers; i++) {
+    for (uint32_t i = 0; i < capacity; i++) {
       buffer_t* b = new (std::nothrow) buffer_t;
       if (!b) {
         perror("Error allocating memory. Exiting...\n");
         exit(-1);
       }
       pool.push_back(b);
-      free_list.push_back(b);
+      free_list.try_push(b);
     }
-    capacity = nof_buffers;
+    // Sorted, to find the buffers of this pool in deallocate()
+    std::sort(pool.begin(), pool.end());
   }
 
   ~buffer_pool()
@@ -84,12 +83,13 @@ public:
 
   void print_all_buffers()
   {
-    printf("%d buffers in queue\n", static_cast<int>(pool.size() - free_list.size()));
+    printf("%d buffers in queue\n", static_cast<int>(capacity - nof_available_pdus()));
 #ifdef SRSRAN_BUFFER_POOL_LOG_ENABLED
+    // The buffers in use keep the name given in allocate()
     std::map<std::string, uint32_t> buffer_cnt;
     for (uint32_t i = 0; i < pool.size(); i++) {
-      if (std::find(free_list.cbegin(), free_list.cend(), pool[i]) == free_list.cend()) {
-        buffer_cnt[strlen(pool[i]->debug_name) ? pool[i]->debug_name : "Undefined"]++;
+      if (strlen(pool[i]->debug_name) > 0) {
+        buffer_cnt[pool[i]->debug_name]++;
       }
     }
     std::map<std::string, uint32_t>::iterator it;
@@ -101,35 +101,26 @@ public:
 
   uint32_t nof_available_pdus() { return free_list.size(); }
 
-  bool is_almost_empty() { return free_list.size() < capacity / 20; }
+  bool is_almost_empty() { return nof_available_pdus() < capacity / 20; }
 
   buffer_t* allocate(const char* debug_name = nullptr, bool blocking = false)
   {
-    pthread_mutex_lock(&mutex);
     buffer_t* b = nullptr;
 
-    if (!free_list.empty()) {
-      b = free_list.back();
-      free_list.pop_back();
-
+    if (free_list.pop(b)) {
       if (is_almost_empty()) {
-        printf("Warning buffer pool capacity is %f %%\n", (float)100 * free_list.size() / capacity);
-      }
-#ifdef SRSRAN_BUFFER_POOL_LOG_ENABLED
-      if (debug_name) {
-        strncpy(b->debug_name, debug_name, SRSRAN_BUFFER_POOL_LOG_NAME_LEN);
-        b->debug_name[SRSRAN_BUFFER_POOL_LOG_NAME_LEN - 1] = 0;
+        printf("Warning buffer pool capacity is %f %%\n", (float)100 * nof_available_pdus() / capacity);
       }
-#endif
     } else if (blocking) {
-      // blocking allocation
-      while (free_list.empty()) {
+      // blocking allocation, the waiters are registered before the last check so deallocate() can't miss them
+      pthread_mutex_lock(&mutex);
+      nof_waiters.fetch_add(1);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      while (not free_list.try_pop(b)) {
         pthread_cond_wait(&cv_not_empty, &mutex);
       }
-
-      // retrieve the new buffer
-      b = free_list.back();
-      free_list.pop_back();
+      nof_waiters.fetch_sub(1);
+      pthread_mutex_unlock(&mutex);
 
       // do not print any warning
     } else {
@@ -140,30 +131,42 @@ public:
 #endif
     }
 
-    pthread_mutex_unlock(&mutex);
+#ifdef SRSRAN_BUFFER_POOL_LOG_ENABLED
+    if (b != nullptr) {
+      strncpy(b->debug_name, debug_name != nullptr ? debug_name : "Undefined", SRSRAN_BUFFER_POOL_LOG_NAME_LEN);
+      b->debug_name[SRSRAN_BUFFER_POOL_LOG_NAME_LEN - 1] = 0;
+    }
+#endif
     return b;
   }
 
   bool deallocate(buffer_t* b)
   {
-    bool ret = false;
-    pthread_mutex_lock(&mutex);
-    if (std::find(pool.cbegin(), pool.cend(), b) != pool.cend()) {
-      free_list.push_back(b);
-      ret = true;
+    if (not std::binary_search(pool.cbegin(), pool.cend(), b)) {
+      return false;
     }
-    pthread_cond_signal(&cv_not_empty);
-    pthread_mutex_unlock(&mutex);
-    return ret;
+#ifdef SRSRAN_BUFFER_POOL_LOG_ENABLED
+    b->debug_name[0] = 0;
+#endif
+    free_list.push(b);
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (nof_waiters.load(std::memory_order_relaxed) > 0) {
+      pthread_mutex_lock(&mutex);
+      pthread_cond_signal(&cv_not_empty);
+      pthread_mutex_unlock(&mutex);
+    }
+    return true;
   }
 
 private:
-  static const int       POOL_SIZE = 4096;
-  std::vector<buffer_t*> pool;
-  std::vector<buffer_t*> free_list;
-  pthread_mutex_t        mutex;
-  pthread_cond_t         cv_not_empty;
-  uint32_t               capacity;
+  static const int                  POOL_SIZE = 4096;
+  const uint32_t                    capacity;
+  std::vector<buffer_t*>            pool;
+  lockfree_bounded_queue<buffer_t*> free_list;
+  std::atomic<uint32_t>             nof_waiters = {0};
+  pthread_mutex_t                   mutex;
+  pthread_cond_t                    cv_not_empty;
 };
 
 /// Type of global byte buffer pool
@@ -102,6 +102,7 @@ public:
   struct buffer_metadata_t {
     uint32_t            pdcp_sn = 0;
     buffer_latency_calc tp;
+    uint64_t            flow_id = 0; ///< Span trace flow of the packet, 0 until the packet is traced
   } md;
 
   byte_buffer_t() : msg(&buffer[SRSRAN_BUFFER_HEADER_OFFSET])
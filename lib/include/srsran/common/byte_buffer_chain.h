@@ -0,0 +1,157 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_BYTE_BUFFER_CHAIN_H
+#define SRSRAN_BYTE_BUFFER_CHAIN_H
+
+#include "srsran/adt/bounded_vector.h"
+#include "srsran/common/byte_buffer.h"
+#include <atomic>
+
+namespace srsran {
+
+/**
+ * Memory block of a byte_buffer_chain, allocated from a pool of small blocks. The segments are reference counted,
+ * so several chains can point to the same bytes without copying them.
+ */
+struct byte_buffer_segment {
+  /// Size of the pool memory block of each segment
+  static constexpr uint32_t block_size = 1024;
+  static constexpr uint32_t capacity   = block_size - 16;
+
+  std::atomic<uint32_t> ref_count = {1};
+  uint8_t               payload[capacity];
+
+  /// Allocates a segment with a reference count of 1. Returns nullptr if the pool is depleted
+  static byte_buffer_segment* make() noexcept;
+
+  /// Drops one reference to the segment. The segment is returned to the pool with the last one
+  static void release(byte_buffer_segment* seg) noexcept;
+
+  static void acquire(byte_buffer_segment* seg) noexcept { seg->ref_count.fetch_add(1, std::memory_order_relaxed); }
+};
+
+/******************************************************************************
+ * Byte buffer chain
+ *
+ * Byte buffer made of a chain of pooled segments, so a PDU only takes the
+ * memory its bytes need. The segments are shared between the chains created
+ * by slice() or copy() and by the concatenation of chains, which are
+ * therefore zero-copy. The first segment keeps a headroom to prepend the
+ * protocol headers in place.
+ * A chain is not thread-safe, but chains sharing segments can be used from
+ * different threads.
+ *****************************************************************************/
+class byte_buffer_chain
+{
+public:
+  /// Bytes left free at the beginning of the first segment of a chain
+  static constexpr uint32_t default_headroom = 64;
+  static constexpr uint32_t max_segments     = 16;
+
+  byte_buffer_t::buffer_metadata_t md;
+
+  byte_buffer_chain() = default;
+  byte_buffer_chain(const byte_buffer_chain&) = delete;
+  byte_buffer_chain(byte_buffer_chain&& other) noexcept;
+  byte_buffer_chain& operator=(const byte_buffer_chain&) = delete;
+  byte_buffer_chain& operator=(byte_buffer_chain&& other) noexcept;
+  ~byte_buffer_chain() { clear(); }
+
+  bool     empty() const { return nof_bytes == 0; }
+  uint32_t size() const { return nof_bytes; }
+  uint32_t nof_segments() const { return segments.size(); }
+
+  /// Bytes of the segment with the given index
+  const_byte_span segment(uint32_t idx) const
+  {
+    return const_byte_span{&segments[idx].seg->payload[segments[idx].begin], segments[idx].length()};
+  }
+
+  uint8_t operator[](uint32_t idx) const;
+
+  /// Releases all the segments
+  void clear();
+
+  /// Appends a copy of the bytes. Returns false, leaving the chain unchanged, if the segments run out
+  bool append(const_byte_span bytes);
+
+  /// Appends the segments of another chain, which are shared with it
+  bool append(const byte_buffer_chain& other);
+
+  /// Appends the segments of another chain, which is left empty
+  bool append(byte_buffer_chain&& other);
+
+  /// Inserts a copy of the bytes at the beginning. Returns false, leaving the chain unchanged, if no segment is left
+  bool prepend(const_byte_span bytes);
+
+  /// Removes bytes from the beginning or the end of the chain
+  void trim_head(uint32_t len);
+  void trim_tail(uint32_t len);
+
+  /**
+   * @brief Grows the chain with uninitialized bytes or trims its tail, e.g. to take the segments of a PDU before it is
+   * built
+   * @return False, leaving the chain unchanged, if the segments run out
+   */
+  bool resize(uint32_t len);
+
+  /// Chain that shares the bytes [offset, offset + len) with this one
+  byte_buffer_chain slice(uint32_t offset, uint32_t len) const;
+
+  /// Chain that shares all the bytes with this one
+  byte_buffer_chain copy() const { return slice(0, nof_bytes); }
+
+  /**
+   * @brief Copies the bytes starting at the given offset to a contiguous buffer
+   * @return Number of bytes copied, limited by the size of the buffer and the bytes after the offset
+   */
+  uint32_t copy_to(byte_span dest, uint32_t offset = 0) const;
+
+  /**
+   * @brief Overwrites the bytes starting at the given offset. The chain must not share its segments
+   * @return Number of bytes copied, limited by the size of the source and the bytes after the offset
+   */
+  uint32_t copy_from(const_byte_span src, uint32_t offset = 0);
+
+  std::chrono::microseconds                      get_latency_us() const { return md.tp.get_latency_us(); }
+  std::chrono::high_resolution_clock::time_point get_timestamp() const { return md.tp.get_timestamp(); }
+  void                                           set_timestamp() { md.tp.set_timestamp(); }
+
+private:
+  struct segment_ref {
+    byte_buffer_segment* seg   = nullptr;
+    uint16_t             begin = 0;
+    uint16_t             end   = 0;
+
+    uint32_t length() const { return end - begin; }
+    bool     is_writable() const { return seg->ref_count.load(std::memory_order_acquire) == 1; }
+  };
+
+  void push_back_shared(const segment_ref& ref);
+
+  srsran::bounded_vector<segment_ref, max_segments> segments;
+  uint32_t                                          nof_bytes = 0;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_BYTE_BUFFER_CHAIN_H
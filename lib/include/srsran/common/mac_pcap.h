@@ -32,7 +32,7 @@ class mac_pcap : public mac_pcap_base
 public:
   mac_pcap();
   ~mac_pcap();
-  uint32_t open(std::string filename, uint32_t ue_id = 0);
+  uint32_t open(std::string filename, uint32_t ue_id = 0, int compression_level = 0);
   uint32_t close();
 
 private:
@@ -24,6 +24,7 @@
 
 #include "srsran/adt/circular_buffer.h"
 #include "srsran/common/buffer_pool.h"
+#include "srsran/common/byte_buffer_chain.h"
 #include "srsran/common/common.h"
 #include "srsran/common/pcap.h"
 #include "srsran/common/threads.h"
@@ -49,6 +50,10 @@ public:
 
   void set_ue_id(uint16_t ue_id);
 
+  /// Limits the number of bytes of each user-plane (C-RNTI) PDU that are captured, a value of zero disables truncation.
+  /// The original length is still recorded so that analysis tools can account for the missing bytes.
+  void set_max_pdu_len(uint32_t max_pdu_len);
+
   // EUTRA
   void
   write_ul_crnti(uint8_t* pdu, uint32_t pdu_len_bytes, uint16_t crnti, uint32_t reTX, uint32_t tti, uint8_t cc_idx);
@@ -102,20 +107,27 @@ protected:
     srsran::srsran_rat_t  rat;
     MAC_Context_Info_t    context;
     mac_nr_context_info_t context_nr;
-    unique_byte_buffer_t  pdu;
+    byte_buffer_chain     pdu;
+    uint32_t              orig_len; // Length of the PDU before truncation
   } pcap_pdu_t;
 
   virtual void write_pdu(pcap_pdu_t& pdu) = 0;
   void         run_thread() final;
 
+  /// Copies the queued PDU to a contiguous buffer. Only used by the writer thread
+  const_byte_span linearize(const byte_buffer_chain& pdu);
+
   std::mutex                              mutex;
   srslog::basic_logger&                   logger;
   std::atomic<bool>                       running = {false};
   static_blocking_queue<pcap_pdu_t, 1024> queue;
   uint16_t                                ue_id                = 0;
   int                                     emergency_handler_id = -1;
+  std::atomic<uint32_t>                   max_pdu_len          = {0};
 
 private:
+  std::array<uint8_t, byte_buffer_chain::max_segments * byte_buffer_segment::capacity> write_buffer;
+
   void pack_and_queue(uint8_t* payload,
                       uint32_t payload_len,
                       uint16_t ue_id,
@@ -22,83 +22,110 @@
 /******************************************************************************
  *  File:         multiqueue.h
  *  Description:  General-purpose non-blocking multiqueue. It behaves as a list
- *                of bounded/unbounded queues.
+ *                of bounded queues, drained by a single consumer.
  *****************************************************************************/
 
 #ifndef SRSRAN_MULTIQUEUE_H
 #define SRSRAN_MULTIQUEUE_H
 
 #include "srsran/adt/circular_buffer.h"
+#include "srsran/adt/lockfree_bounded_queue.h"
 #include "srsran/adt/move_callback.h"
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <queue>
+#include <sys/eventfd.h>
+#include <thread>
+#include <unistd.h>
 #include <vector>
 
 namespace srsran {
 
 #define MULTIQUEUE_DEFAULT_CAPACITY (8192) // Default per-queue capacity
+#define MULTIQUEUE_MAX_QUEUES (64)         // Maximum number of queues of a multiqueue
 
 /**
  * N-to-1 Message-Passing Broker that manages the creation, destruction of input ports, and popping of messages that
  * are pushed to these ports.
- * Each port provides a thread-safe push(...) / try_push(...) interface to enqueue messages
- * The class will pop from the several created ports in a round-robin fashion.
+ * Each port provides a thread-safe push(...) / try_push(...) interface to enqueue messages. The ports are lock-free
+ * bounded queues, the pushing threads only take a lock when they block on a full port.
+ * The class will pop from the several created ports in a round-robin fashion, taking up to batch_size messages
+ * from a port before moving to the next one.
  * The popping() interface is not safe-thread. That means, that it is expected that only one thread will
- * be popping tasks.
+ * be popping tasks. When all the ports are empty, the consumer sleeps on an eventfd that the producers only signal
+ * while it is sleeping.
  * @tparam myobj message type
  */
 template <typename myobj>
 class multiqueue_handler
 {
+public:
+  /// Metrics of a port, accumulated since the last call to get_metrics()
+  struct port_metrics_t {
+    uint32_t capacity       = 0;
+    uint32_t depth          = 0; ///< Number of messages waiting in the port
+    uint32_t max_depth      = 0;
+    uint64_t nof_popped     = 0;
+    uint64_t nof_rejected   = 0; ///< Messages discarded by try_push() because the port was full
+    float    avg_latency_us = 0; ///< Average time between the push and the pop of the messages
+    float    max_latency_us = 0;
+  };
+
+private:
+  using clock_t = std::chrono::steady_clock;
+
+  struct entry_t {
+    myobj               obj;
+    clock_t::time_point push_time;
+  };
+
   class input_port_impl
   {
   public:
-    input_port_impl(uint32_t cap, multiqueue_handler<myobj>* parent_) : buffer(cap), parent(parent_) {}
+    input_port_impl(uint32_t cap, multiqueue_handler<myobj>* parent_) : cap_(cap), buffer(cap), parent(parent_) {}
     input_port_impl(const input_port_impl&) = delete;
     input_port_impl(input_port_impl&&)      = delete;
     input_port_impl& operator=(const input_port_impl&) = delete;
     input_port_impl& operator=(input_port_impl&&) = delete;
     ~input_port_impl() { deactivate_blocking(); }
 
-    size_t capacity() const { return buffer.max_size(); }
-    size_t size() const
+    size_t capacity() const { return cap_; }
+    size_t size() const { return count.load(std::memory_order_relaxed); }
+    bool   active() const { return active_.load(std::memory_order_relaxed); }
+    void   set_active(bool val)
     {
-      std::lock_guard<std::mutex> lock(q_mutex);
-      return buffer.size();
-    }
-    bool active() const
-    {
-      std::lock_guard<std::mutex> lock(q_mutex);
-      return active_;
-    }
-    void set_active(bool val)
-    {
-      std::unique_lock<std::mutex> lock(q_mutex);
-      if (val == active_) {
+      if (val) {
+        // reactivation of a port that was emptied by deactivate_blocking()
+        active_.store(true);
+        return;
+      }
+      if (not active_.exchange(false)) {
         // no-op
         return;
       }
-      active_ = val;
 
-      if (not active_) {
-        buffer.clear();
-        lock.unlock();
-        // unlock blocked pushing threads
-        cv_full.notify_all();
-      }
+      // unlock blocked pushing threads
+      std::lock_guard<std::mutex> lock(q_mutex);
+      cv_full.notify_all();
     }
 
     void deactivate_blocking()
     {
       set_active(false);
 
-      // wait for all the pushers to unlock
-      std::unique_lock<std::mutex> lock(q_mutex);
-      while (nof_waiting > 0) {
-        cv_exit.wait(lock);
+      // wait for all the pushers to leave, and discard the messages that they left behind
+      while (nof_pushing.load() > 0) {
+        std::this_thread::yield();
+      }
+      entry_t e;
+      while (buffer.pop(e)) {
+        count--;
       }
     }
 
@@ -120,65 +147,106 @@ class multiqueue_handler
 
     bool try_pop(myobj& obj)
     {
-      std::unique_lock<std::mutex> lock(q_mutex);
-      return pop_(lock, obj);
+      if (not active() or not buffer.try_pop(tmp)) {
+        return false;
+      }
+      count--;
+      obj = std::move(tmp.obj);
+
+      uint64_t latency_ns =
+          std::chrono::duration_cast<std::chrono::nanoseconds>(clock_t::now() - tmp.push_time).count();
+      nof_popped.fetch_add(1, std::memory_order_relaxed);
+      sum_latency_ns.fetch_add(latency_ns, std::memory_order_relaxed);
+      if (latency_ns > max_latency_ns.load(std::memory_order_relaxed)) {
+        max_latency_ns.store(latency_ns, std::memory_order_relaxed);
+      }
+
+      if (nof_waiting.load() > 0) {
+        std::lock_guard<std::mutex> lock(q_mutex);
+        cv_full.notify_one();
+      }
+      return true;
     }
 
-    bool try_pop(myobj& obj, bool& try_lock_success)
+    port_metrics_t get_metrics()
     {
-      std::unique_lock<std::mutex> lock(q_mutex, std::try_to_lock);
-      try_lock_success = lock.owns_lock();
-      return try_lock_success ? pop_(lock, obj) : false;
+      port_metrics_t m = {};
+      m.capacity       = cap_;
+      m.depth          = size();
+      m.max_depth      = max_depth.exchange(0, std::memory_order_relaxed);
+      m.nof_popped     = nof_popped.exchange(0, std::memory_order_relaxed);
+      m.nof_rejected   = nof_rejected.exchange(0, std::memory_order_relaxed);
+      uint64_t sum_ns  = sum_latency_ns.exchange(0, std::memory_order_relaxed);
+      m.avg_latency_us = m.nof_popped > 0 ? sum_ns / (1000.0f * m.nof_popped) : 0;
+      m.max_latency_us = max_latency_ns.exchange(0, std::memory_order_relaxed) / 1000.0f;
+      return m;
     }
 
   private:
     template <typename T>
     bool push_(T* o, bool blocking) noexcept
     {
-      std::unique_lock<std::mutex> lock(q_mutex);
-      if (not blocking) {
-        // non-blocking case
-        if (not active_ or buffer.full()) {
+      // The pusher is registered before checking the port state, so that deactivate_blocking() waits for it
+      nof_pushing++;
+      bool ret = push_impl_(o, blocking);
+      nof_pushing--;
+      return ret;
+    }
+
+    template <typename T>
+    bool push_impl_(T* o, bool blocking) noexcept
+    {
+      uint32_t depth = 0;
+      while (true) {
+        if (not active_.load()) {
           return false;
         }
-      } else {
-        // blocking case
-        while (active_ and buffer.full()) {
-          nof_waiting++;
-          cv_full.wait(lock);
-          nof_waiting--;
+        // reserve a position in the port
+        depth = ++count;
+        if (depth <= cap_) {
+          break;
         }
-        if (not active_) {
-          lock.unlock();
-          cv_exit.notify_one();
+        count--;
+        if (not blocking) {
+          nof_rejected.fetch_add(1, std::memory_order_relaxed);
           return false;
         }
-      }
-      buffer.push(std::forward<T>(*o));
-      return true;
-    }
 
-    bool pop_(std::unique_lock<std::mutex>& lock, myobj& obj)
-    {
-      if (buffer.empty()) {
-        return false;
+        // blocking case. The waiters are registered before the last check, so the consumer can't miss them
+        std::unique_lock<std::mutex> lock(q_mutex);
+        nof_waiting++;
+        while (active_.load() and count.load() >= cap_) {
+          cv_full.wait(lock);
+        }
+        nof_waiting--;
       }
-      obj = std::move(buffer.top());
-      buffer.pop();
-      if (nof_waiting > 0) {
-        lock.unlock();
-        cv_full.notify_one();
+      if (depth > max_depth.load(std::memory_order_relaxed)) {
+        max_depth.store(depth, std::memory_order_relaxed);
       }
+
+      // Always succeeds, the reserved positions do not exceed the buffer capacity
+      buffer.push(entry_t{std::forward<T>(*o), clock_t::now()});
+      parent->notify_consumer();
       return true;
     }
 
-    multiqueue_handler<myobj>* parent = nullptr;
-
-    mutable std::mutex                 q_mutex;
-    srsran::dyn_circular_buffer<myobj> buffer;
-    std::condition_variable            cv_full, cv_exit;
-    bool                               active_     = true;
-    int                                nof_waiting = 0;
+    const uint32_t                  cap_;
+    lockfree_bounded_queue<entry_t> buffer;
+    multiqueue_handler<myobj>*      parent = nullptr;
+    entry_t                         tmp; ///< used by the consumer to pop, avoids constructing an entry per pop
+    std::atomic<bool>               active_     = {true};
+    std::atomic<uint32_t>           count       = {0};
+    std::atomic<uint32_t>           nof_pushing = {0};
+    std::atomic<uint32_t>           nof_waiting = {0};
+    std::mutex                      q_mutex;
+    std::condition_variable         cv_full;
+
+    // metrics
+    std::atomic<uint32_t> max_depth      = {0};
+    std::atomic<uint64_t> nof_popped     = {0};
+    std::atomic<uint64_t> nof_rejected   = {0};
+    std::atomic<uint64_t> sum_latency_ns = {0};
+    std::atomic<uint64_t> max_latency_ns = {0};
   };
 
 public:
@@ -221,25 +289,32 @@ public:
     std::unique_ptr<input_port_impl, recycle_op> impl;
   };
 
-  explicit multiqueue_handler(uint32_t default_capacity_ = MULTIQUEUE_DEFAULT_CAPACITY) :
-    default_capacity(default_capacity_)
-  {}
-  ~multiqueue_handler() { stop(); }
+  explicit multiqueue_handler(uint32_t default_capacity_ = MULTIQUEUE_DEFAULT_CAPACITY, uint32_t batch_size_ = 1) :
+    default_capacity(default_capacity_), batch_size(std::max(batch_size_, 1u)), event_fd(eventfd(0, EFD_CLOEXEC))
+  {
+    srsran_assert(event_fd >= 0, "Failed to create the multiqueue eventfd");
+  }
+  ~multiqueue_handler()
+  {
+    stop();
+    close(event_fd);
+  }
 
   void stop()
   {
     std::unique_lock<std::mutex> lock(mutex);
     running = false;
-    for (auto& q : queues) {
+    for (uint32_t i = 0; i < nof_ports.load(); ++i) {
       // signal deactivation to pushing threads in a non-blocking way
-      q.set_active(false);
+      ports[i]->set_active(false);
     }
+    wake_consumer();
     while (consumer_state) {
       cv_exit.wait(lock);
     }
-    for (auto& q : queues) {
+    for (uint32_t i = 0; i < nof_ports.load(); ++i) {
       // ensure the queues are finished being deactivated
-      q.deactivate_blocking();
+      ports[i]->deactivate_blocking();
     }
   }
 
@@ -255,19 +330,23 @@ public:
     if (not running) {
       return queue_handle();
     }
-    while (qidx < queues.size() and (queues[qidx].active() or (queues[qidx].capacity() != capacity_))) {
+    uint32_t n = nof_ports.load();
+    while (qidx < n and (ports[qidx]->active() or (ports[qidx]->capacity() != capacity_))) {
       ++qidx;
     }
 
     // check if there is a free queue of the required size
-    if (qidx == queues.size()) {
-      // create new queue
-      queues.emplace_back(capacity_, this);
-      qidx = queues.size() - 1; // update qidx to the last element
+    if (qidx == n) {
+      if (n == ports.size()) {
+        return queue_handle();
+      }
+      // create new queue. The consumer only sees it once it is fully constructed
+      ports[n].reset(new input_port_impl(capacity_, this));
+      nof_ports.store(n + 1, std::memory_order_release);
     } else {
-      queues[qidx].set_active(true);
+      ports[qidx]->set_active(true);
     }
-    return queue_handle(&queues[qidx]);
+    return queue_handle(ports[qidx].get());
   }
 
   /**
@@ -280,66 +359,117 @@ public:
   {
     std::lock_guard<std::mutex> lock(mutex);
     uint32_t                    count = 0;
-    for (uint32_t i = 0; i < queues.size(); ++i) {
-      count += queues[i].active() ? 1 : 0;
+    for (uint32_t i = 0; i < nof_ports.load(); ++i) {
+      count += ports[i]->active() ? 1 : 0;
     }
     return count;
   }
 
+  /// Returns the metrics of all the queues, active or not, accumulated since the last call
+  void get_metrics(std::vector<port_metrics_t>& metrics)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    metrics.resize(nof_ports.load());
+    for (uint32_t i = 0; i < metrics.size(); ++i) {
+      metrics[i] = ports[i]->get_metrics();
+    }
+  }
+
   bool wait_pop(myobj* value)
   {
-    std::unique_lock<std::mutex> lock(mutex);
     consumer_state = true;
-    while (running) {
+    while (running.load(std::memory_order_relaxed)) {
       if (round_robin_pop_(value)) {
-        consumer_state = false;
+        leave_consumer();
         return true;
       }
-      lock.unlock();
-      std::this_thread::sleep_for(std::chrono::microseconds(100));
-      lock.lock();
+
+      // Announce the sleep before checking the queues one last time. A push that is not seen by this check will find
+      // the consumer sleeping and signal the eventfd
+      consumer_sleeping.store(true);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (round_robin_pop_(value)) {
+        consumer_sleeping.store(false, std::memory_order_relaxed);
+        leave_consumer();
+        return true;
+      }
+      if (running.load()) {
+        uint64_t nof_events = 0;
+        if (read(event_fd, &nof_events, sizeof(nof_events)) < 0) {
+          perror("Error reading the multiqueue eventfd");
+        }
+      }
+      consumer_sleeping.store(false, std::memory_order_relaxed);
     }
-    consumer_state = false;
-    lock.unlock();
-    cv_exit.notify_one();
+    leave_consumer();
     return false;
   }
 
-  bool try_pop(myobj* value)
-  {
-    std::unique_lock<std::mutex> lock(mutex);
-    return running and round_robin_pop_(value);
-  }
+  bool try_pop(myobj* value) { return running.load(std::memory_order_relaxed) and round_robin_pop_(value); }
 
 private:
   bool round_robin_pop_(myobj* value)
   {
+    uint32_t n = nof_ports.load(std::memory_order_acquire);
+    if (n == 0) {
+      return false;
+    }
+
+    // Continue with the batch of the last queue
+    if (batch_count < batch_size and spin_idx < n and ports[spin_idx]->try_pop(*value)) {
+      batch_count++;
+      return true;
+    }
+
     // Round-robin for all queues
-    auto     q_it  = queues.begin() + spin_idx;
-    uint32_t count = 0;
-    for (; count < queues.size(); ++count, ++q_it) {
-      if (q_it == queues.end()) {
-        q_it = queues.begin(); // wrap-around
-      }
-      bool try_lock_success = true;
-      if (q_it->try_pop(*value, try_lock_success)) {
-        spin_idx = (spin_idx + count + 1) % queues.size();
+    for (uint32_t count = 1; count <= n; ++count) {
+      uint32_t qidx = (spin_idx + count) % n;
+      if (ports[qidx]->try_pop(*value)) {
+        spin_idx    = qidx;
+        batch_count = 1;
         return true;
       }
-      if (not try_lock_success) {
-        // restart RR search, as there was a collision with a producer
-        count = 0;
-      }
     }
     return false;
   }
 
-  mutable std::mutex          mutex;
-  std::condition_variable     cv_exit;
-  uint32_t                    spin_idx = 0;
-  bool                        running = true, consumer_state = false;
-  std::deque<input_port_impl> queues;
-  uint32_t                    default_capacity = 0;
+  void notify_consumer()
+  {
+    // Only a sleeping consumer requires the system call
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (consumer_sleeping.load(std::memory_order_relaxed)) {
+      wake_consumer();
+    }
+  }
+
+  void wake_consumer()
+  {
+    uint64_t nof_events = 1;
+    if (write(event_fd, &nof_events, sizeof(nof_events)) < 0) {
+      perror("Error writing the multiqueue eventfd");
+    }
+  }
+
+  void leave_consumer()
+  {
+    consumer_state = false;
+    if (not running.load()) {
+      // stop() may be waiting for the consumer to leave
+      std::lock_guard<std::mutex> lock(mutex);
+      cv_exit.notify_one();
+    }
+  }
+
+  mutable std::mutex                                                  mutex;
+  std::condition_variable                                             cv_exit;
+  uint32_t                                                            spin_idx = 0, batch_count = 0;
+  std::atomic<bool>                                                   running = {true}, consumer_state = {false};
+  std::atomic<bool>                                                   consumer_sleeping = {false};
+  std::array<std::unique_ptr<input_port_impl>, MULTIQUEUE_MAX_QUEUES> ports;
+  std::atomic<uint32_t>                                               nof_ports        = {0};
+  uint32_t                                                            default_capacity = 0;
+  uint32_t                                                            batch_size       = 1;
+  int                                                                 event_fd         = -1;
 };
 
 template <typename T>
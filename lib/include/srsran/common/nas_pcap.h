@@ -34,7 +34,10 @@ public:
   nas_pcap();
   ~nas_pcap();
   void     enable();
-  uint32_t open(std::string filename_, uint32_t ue_id = 0, srsran_rat_t rat_type = srsran_rat_t::lte);
+  uint32_t open(std::string  filename_,
+                uint32_t     ue_id             = 0,
+                srsran_rat_t rat_type          = srsran_rat_t::lte,
+                int          compression_level = 0);
   void     close();
   void     write_nas(uint8_t* pdu, uint32_t pdu_len_bytes);
 
@@ -38,7 +38,7 @@ public:
   ngap_pcap& operator=(ngap_pcap&& other) = delete;
 
   void enable();
-  void open(const char* filename_);
+  void open(const char* filename_, int compression_level = 0);
   void close();
   void write_ngap(uint8_t* pdu, uint32_t pdu_len_bytes);
 
@@ -203,12 +203,20 @@ extern "C" {
 /* Open the file and write file header */
 FILE* DLT_PCAP_Open(uint32_t DLT, const char* fileName);
 
+/* Open a zstd compressed file with the given compression level and write file header */
+FILE* DLT_PCAP_Open_Compressed(uint32_t DLT, const char* fileName, int level);
+
 /* Close the PCAP file */
 void DLT_PCAP_Close(FILE* fd);
 
 /* Write an individual MAC PDU (PCAP packet header + mac-context + mac-pdu) */
 int LTE_PCAP_MAC_WritePDU(FILE* fd, MAC_Context_Info_t* context, const unsigned char* PDU, unsigned int length);
 int LTE_PCAP_MAC_UDP_WritePDU(FILE* fd, MAC_Context_Info_t* context, const unsigned char* PDU, unsigned int length);
+int LTE_PCAP_MAC_UDP_WriteTruncatedPDU(FILE*                fd,
+                                       MAC_Context_Info_t*  context,
+                                       const unsigned char* PDU,
+                                       unsigned int         length,
+                                       unsigned int         orig_length);
 int LTE_PCAP_PACK_MAC_CONTEXT_TO_BUFFER(MAC_Context_Info_t* context, uint8_t* PDU, unsigned int length);
 
 /* Write an individual NAS PDU (PCAP packet header + nas-context + nas-pdu) */
@@ -225,6 +233,11 @@ int LTE_PCAP_NGAP_WritePDU(FILE* fd, NGAP_Context_Info_t* context, const unsigne
 
 /* Write an individual NR MAC PDU (PCAP packet header + UDP header + nr-mac-context + mac-pdu) */
 int NR_PCAP_MAC_UDP_WritePDU(FILE* fd, mac_nr_context_info_t* context, const unsigned char* PDU, unsigned int length);
+int NR_PCAP_MAC_UDP_WriteTruncatedPDU(FILE*                  fd,
+                                      mac_nr_context_info_t* context,
+                                      const unsigned char*   PDU,
+                                      unsigned int           length,
+                                      unsigned int           orig_length);
 int NR_PCAP_PACK_MAC_CONTEXT_TO_BUFFER(mac_nr_context_info_t* context, uint8_t* buffer, unsigned int length);
 
 #ifdef __cplusplus
@@ -38,7 +38,7 @@ public:
   s1ap_pcap& operator=(s1ap_pcap&& other) = delete;
 
   void enable();
-  void open(const char* filename_);
+  void open(const char* filename_, int compression_level = 0);
   void close();
   void write_s1ap(uint8_t* pdu, uint32_t pdu_len_bytes);
 
@@ -0,0 +1,223 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ *  File:         task_graph.h
+ *  Description:  Graph of tasks with dependencies and a deadline, and the
+ *                executor that runs them on a set of pinned threads. Each
+ *                thread and each running graph own a lock-free task queue;
+ *                the tasks made ready by a thread are pushed to its own queue
+ *                and idle threads steal from the queues of the others. The
+ *                thread waiting for a graph only executes tasks of that graph.
+ *  Reference:
+ *****************************************************************************/
+
+#ifndef SRSRAN_TASK_GRAPH_H
+#define SRSRAN_TASK_GRAPH_H
+
+#include "srsran/adt/bounded_vector.h"
+#include "srsran/adt/move_callback.h"
+#include "srsran/adt/work_stealing_deque.h"
+#include "srsran/common/threads.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace srsran {
+
+class task_graph_executor;
+
+/**
+ * Set of tasks and the dependencies between them. The graph is built for every processing unit (e.g. a TTI) and
+ * given to task_graph_executor::run(). Clearing and building it again does not allocate memory.
+ */
+class task_graph
+{
+public:
+  using task_t  = srsran::move_callback<void(), default_move_callback_buffer_size, true>;
+  using task_id = uint32_t;
+  using clock_t = std::chrono::steady_clock;
+
+  static constexpr task_id  invalid_task   = UINT32_MAX;
+  static constexpr uint32_t max_successors = 8;
+
+  explicit task_graph(uint32_t max_tasks_);
+  task_graph(const task_graph&) = delete;
+  task_graph& operator=(const task_graph&) = delete;
+
+  /// Adds a task to the graph. Returns invalid_task if the graph is full
+  task_id add_task(task_t&& task);
+
+  /// Makes the task "after" wait for the completion of the task "before". Tasks can only depend on older tasks
+  bool add_dependency(task_id before, task_id after);
+
+  /// Sets the time by which all the tasks of the graph shall be completed
+  void set_deadline(clock_t::time_point deadline_) { deadline = deadline_; }
+
+  /// Removes all the tasks and the deadline
+  void clear();
+
+  uint32_t size() const { return nof_tasks; }
+  bool     empty() const { return nof_tasks == 0; }
+
+  /// True if the last run of the graph was completed after the deadline
+  bool is_late() const { return late; }
+
+private:
+  friend class task_graph_executor;
+
+  struct node_t {
+    task_t                                          task;
+    std::atomic<uint32_t>                           nof_pending_deps = {0};
+    uint32_t                                        nof_deps         = 0;
+    srsran::bounded_vector<task_id, max_successors> successors;
+  };
+
+  std::unique_ptr<node_t[]> nodes;
+  uint32_t                  max_tasks         = 0;
+  uint32_t                  nof_tasks         = 0;
+  std::atomic<uint32_t>     nof_pending_tasks = {0};
+  clock_t::time_point       deadline          = clock_t::time_point::max();
+  bool                      late              = false;
+
+  // Set by task_graph_executor::start(), valid until the graph is completed
+  uint32_t              slot               = UINT32_MAX; ///< Submission queue of the graph, UINT32_MAX if none was free
+  bool                  guard_enabled      = false;      ///< The starting thread was counting its heap allocations
+  bool                  guard_assert       = false;
+  std::atomic<uint32_t> nof_guarded_allocs = {0}; ///< Heap allocations of the tasks run by the executor threads
+};
+
+/**
+ * Runs task graphs on a set of threads. The thread calling run() also executes tasks of the graph, so an executor
+ * without threads runs the graphs inline, in dependency order. It never executes tasks of other graphs, which would
+ * delay its own graph.
+ *
+ * Each graph takes one of max_graphs submission queues while it runs. The graphs started while all of them are taken
+ * are executed by the thread calling wait(), without the help of the executor threads.
+ *
+ * If the thread starting a graph counts its heap allocations (srsran_mem_guard_enter()), the executor threads count
+ * the allocations of the tasks of the graph too, and wait() adds them to the count of the calling thread.
+ *
+ * The threads are pinned one by one to the CPUs of the mask, in round-robin. A mask of 255 leaves them unpinned.
+ */
+class task_graph_executor
+{
+public:
+  struct metrics_t {
+    uint64_t nof_graphs          = 0; ///< Number of graphs run
+    uint64_t nof_deadline_misses = 0; ///< Graphs completed after their deadline
+    uint64_t nof_tasks           = 0; ///< Number of tasks executed
+    uint64_t nof_late_tasks      = 0; ///< Tasks started after the deadline of their graph
+    uint64_t nof_stolen_tasks    = 0; ///< Tasks taken from the queue of another thread
+  };
+
+  explicit task_graph_executor(uint32_t nof_threads,
+                               int32_t  prio       = -1,
+                               uint32_t mask       = 255,
+                               uint32_t queue_size = 256,
+                               uint32_t max_graphs = 16);
+  task_graph_executor(const task_graph_executor&) = delete;
+  task_graph_executor& operator=(const task_graph_executor&) = delete;
+  ~task_graph_executor();
+
+  void stop();
+
+  /**
+   * @brief Runs all the tasks of a graph and waits for their completion. Several threads may run graphs concurrently
+   * @return True if the graph was completed before its deadline, false otherwise
+   */
+  bool run(task_graph& graph);
+
+  /**
+   * @brief Releases the tasks of a graph without waiting for them. The executor threads, and the threads waiting for
+   * other graphs, start executing them. Without executor threads, they are executed by the next call to wait(). The
+   * same thread must call wait() before modifying or running the graph again
+   */
+  void start(task_graph& graph);
+
+  /**
+   * @brief Helps executing tasks until a graph released with start() is completed
+   * @return True if the graph was completed before its deadline, false otherwise
+   */
+  bool wait(task_graph& graph);
+
+  /// Returns the metrics accumulated since the last call
+  metrics_t get_metrics();
+
+  uint32_t get_nof_threads() const { return static_cast<uint32_t>(workers.size()); }
+
+private:
+  /// Task of a running graph, as the index of the submission queue of the graph and the task id
+  using task_ref_t = uint64_t;
+  using task_queue = srsran::work_stealing_deque<task_ref_t>;
+
+  static task_ref_t make_task_ref(uint32_t slot, task_graph::task_id id)
+  {
+    return (static_cast<uint64_t>(slot) << 32U) | id;
+  }
+
+  /// Submission queue of a running graph. Its owner is the thread that started the graph
+  struct graph_slot_t {
+    explicit graph_slot_t(uint32_t queue_size) : queue(queue_size) {}
+    std::atomic<bool> in_use = {false};
+    task_graph*       graph  = nullptr;
+    task_queue        queue;
+  };
+
+  class worker_t : public thread
+  {
+  public:
+    worker_t(task_graph_executor* parent_, uint32_t queue_idx_, int32_t prio, int32_t cpu);
+    void run_thread() override;
+
+  private:
+    task_graph_executor* parent    = nullptr;
+    uint32_t             queue_idx = 0;
+  };
+
+  bool steal_task(uint32_t queue_idx, task_ref_t& t);
+  void push_task(task_queue& queue, task_ref_t t, bool in_worker);
+  void execute(task_queue& queue, task_ref_t t, bool in_worker);
+  void execute_inline(task_graph& graph);
+  void wait_task(const task_graph* graph);
+
+  std::vector<std::unique_ptr<task_queue> >   queues; ///< The queue i belongs to the executor thread i
+  std::vector<std::unique_ptr<graph_slot_t> > slots;
+  std::vector<std::unique_ptr<worker_t> >     workers;
+  std::atomic<bool>                           running    = {true};
+  std::atomic<uint32_t>                       nof_queued = {0};
+  std::mutex                                  sleep_mutex;
+  std::condition_variable                     sleep_cvar; ///< Wakes the executor threads when tasks are pushed
+  std::condition_variable                     done_cvar;  ///< Wakes the threads in wait() when a graph is completed
+
+  std::atomic<uint64_t> nof_graphs          = {0};
+  std::atomic<uint64_t> nof_deadline_misses = {0};
+  std::atomic<uint64_t> nof_tasks           = {0};
+  std::atomic<uint64_t> nof_late_tasks      = {0};
+  std::atomic<uint64_t> nof_stolen_tasks    = {0};
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_TASK_GRAPH_H
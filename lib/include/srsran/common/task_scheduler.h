@@ -34,7 +34,9 @@ class task_scheduler
 {
 public:
   explicit task_scheduler(uint32_t default_extern_tasks_size = 512, uint32_t nof_timers_prealloc = 100) :
-    external_tasks{default_extern_tasks_size}, timers{nof_timers_prealloc}, internal_tasks(512)
+    external_tasks{default_extern_tasks_size, external_tasks_batch_size},
+    timers{nof_timers_prealloc},
+    internal_tasks(512)
   {
     background_queue = external_tasks.add_queue();
   }
@@ -104,7 +106,16 @@ public:
 
   srsran::timer_handler* get_timer_handler() { return &timers; }
 
+  //! Returns the depth and latency metrics of the queues of external tasks, accumulated since the last call
+  void get_queue_metrics(std::vector<task_multiqueue::port_metrics_t>& metrics)
+  {
+    external_tasks.get_metrics(metrics);
+  }
+
 private:
+  //! Number of tasks run from an external queue before moving to the next one
+  static const uint32_t external_tasks_batch_size = 8;
+
   // Perform pending stack deferred tasks
   void run_all_internal_tasks()
   {
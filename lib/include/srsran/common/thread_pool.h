@@ -30,7 +30,9 @@
 #define SRSRAN_THREAD_POOL_H
 
 #include "srsran/adt/circular_buffer.h"
+#include "srsran/adt/lockfree_bounded_queue.h"
 #include "srsran/adt/move_callback.h"
+#include "srsran/adt/work_stealing_deque.h"
 #include "srsran/srslog/srslog.h"
 #include <atomic>
 #include <condition_variable>
@@ -101,14 +103,43 @@ private:
   std::vector<std::condition_variable> cvar_worker = {};
 };
 
+/**
+ * Pool of threads that execute callables. Each worker owns a work-stealing deque per priority, where it queues the
+ * tasks pushed from its own tasks and the batches it takes from the shared queues. The other threads push into the
+ * shared queue of each priority. Idle workers steal the oldest tasks of the other workers, first from those in the same
+ * NUMA node. Pending high priority tasks are always executed before the low priority ones.
+ *
+ * By default all the workers run on the CPUs of the mask. With pin_workers, each worker is pinned to one CPU of the
+ * mask, in round-robin.
+ */
 class task_thread_pool
 {
-  using task_t                             = srsran::move_callback<void(), default_move_callback_buffer_size, true>;
-  static constexpr uint32_t max_task_shift = 14;
-  static constexpr uint32_t max_task_num   = 1u << max_task_shift;
+  using task_t                               = srsran::move_callback<void(), default_move_callback_buffer_size, true>;
+  static constexpr uint32_t max_task_shift   = 14;
+  static constexpr uint32_t max_task_num     = 1u << max_task_shift;
+  static constexpr uint32_t max_workers      = 128;
+  static constexpr uint32_t local_queue_size = 256;
+  static constexpr uint32_t max_batch_size   = 16;
+
+  // Times a worker yields while a counted task is not reachable yet, before sleeping instead
+  static constexpr uint32_t max_yields_before_sleep = 64;
 
 public:
-  task_thread_pool(uint32_t nof_workers = 1, bool start_deferred = false, int32_t prio_ = -1, uint32_t mask_ = 255);
+  /// Latency critical tasks have high priority, background jobs (e.g. memory pool allocations) have low priority
+  enum class task_priority { high = 0, low = 1 };
+  static constexpr uint32_t nof_priorities = 2;
+
+  struct metrics_t {
+    uint64_t nof_tasks         = 0; ///< Number of tasks executed
+    uint64_t nof_stolen_tasks  = 0; ///< Tasks taken from the deque of another worker
+    uint64_t nof_remote_steals = 0; ///< Stolen tasks that belonged to a worker of another NUMA node
+  };
+
+  task_thread_pool(uint32_t nof_workers    = 1,
+                   bool     start_deferred = false,
+                   int32_t  prio_          = -1,
+                   uint32_t mask_          = 255,
+                   bool     pin_workers_   = false);
   task_thread_pool(const task_thread_pool&) = delete;
   task_thread_pool(task_thread_pool&&)      = delete;
   task_thread_pool& operator=(const task_thread_pool&) = delete;
@@ -116,41 +147,78 @@ public:
   ~task_thread_pool();
 
   void stop();
-  void start(int32_t prio_ = -1, uint32_t mask_ = 255);
+  void start(int32_t prio_ = -1, uint32_t mask_ = 255, bool pin_workers_ = false);
   void set_nof_workers(uint32_t nof_workers);
 
-  void     push_task(task_t&& task);
+  void     push_task(task_t&& task, task_priority priority = task_priority::low);
   uint32_t nof_pending_tasks() const;
   size_t   nof_workers() const { return workers.size(); }
 
+  /// Returns the metrics accumulated since the last call
+  metrics_t get_metrics();
+
 private:
+  /// Deques of a worker. They outlive the worker, the other workers may be stealing from them at any time
+  struct local_queues_t {
+    local_queues_t()
+    {
+      for (auto& q : queues) {
+        q.reset(new work_stealing_deque<uint32_t>(local_queue_size));
+      }
+    }
+    std::unique_ptr<work_stealing_deque<uint32_t> > queues[nof_priorities];
+    int32_t                                         numa_node = -1; ///< NUMA node of the worker, -1 if unknown
+  };
+
   class worker_t : public thread
   {
   public:
-    explicit worker_t(task_thread_pool* parent_, uint32_t id);
+    explicit worker_t(task_thread_pool* parent_, uint32_t id, int32_t cpu);
     void     stop();
-    bool     is_running() const { return running; }
     uint32_t id() const { return id_; }
 
     void run_thread() override;
 
   private:
-    bool wait_task(task_t* task);
-
-    task_thread_pool* parent  = nullptr;
-    uint32_t          id_     = 0;
-    bool              running = false;
+    bool find_task(uint32_t* task_idx);
+    bool take_shared_tasks(task_priority priority, uint32_t* task_idx);
+    bool steal_task(task_priority priority, uint32_t* task_idx);
+    bool wait_task();
+    void update_victims();
+
+    task_thread_pool*     parent            = nullptr;
+    uint32_t              id_               = 0;
+    uint32_t              nof_victim_queues = 0;
+    std::vector<uint32_t> victims; // Other workers in stealing order
   };
 
-  int32_t               prio = -1;
-  uint32_t              mask = 255;
+  int32_t get_worker_cpu(uint32_t id) const;
+  void    alloc_worker_queues(uint32_t nof_queues);
+  void    run_task(uint32_t task_idx);
+
+  int32_t               prio        = -1;
+  uint32_t              mask        = 255;
+  bool                  pin_workers = false;
   srslog::basic_logger& logger;
 
-  srsran::dyn_circular_buffer<task_t>     pending_tasks;
+  // The tasks are stored in a fixed array, the queues carry the indexes of the slots
+  std::unique_ptr<task_t[]>                          tasks;
+  lockfree_bounded_queue<uint32_t>                   free_slots;
+  std::unique_ptr<lockfree_bounded_queue<uint32_t> > shared_queues[nof_priorities];
+  std::unique_ptr<local_queues_t>                    local_queues[max_workers];
+  std::atomic<uint32_t>                              nof_local_queues = {0};
+
   std::vector<std::unique_ptr<worker_t> > workers;
-  mutable std::mutex                      queue_mutex;
+  std::mutex                              queue_mutex;
+  std::atomic<bool>                       running      = {false};
+  std::atomic<uint32_t>                   nof_queued   = {0};
+  std::atomic<uint32_t>                   nof_sleeping = {0};
+  std::mutex                              sleep_mutex;
   std::condition_variable                 cv_empty;
-  bool                                    running = false;
+
+  std::atomic<uint64_t> nof_tasks         = {0};
+  std::atomic<uint64_t> nof_stolen_tasks  = {0};
+  std::atomic<uint64_t> nof_remote_steals = {0};
 };
 
 /// Class used to create a single worker with an input task queue with a single reader
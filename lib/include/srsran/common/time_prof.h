@@ -23,6 +23,8 @@
 #define SRSRAN_TIME_PROF_H
 
 #include "srsran/srslog/srslog.h"
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <mutex>
 
@@ -162,6 +164,34 @@ public:
 };
 using sliding_window_stats_ms = sliding_window_stats<std::chrono::milliseconds>;
 
+/**
+ * Histogram of latencies with power of two bins in microseconds, always enabled. The bin i > 0 counts the latencies in
+ * [2^(i-1), 2^i) us. Several threads may add samples concurrently.
+ */
+class latency_histogram
+{
+public:
+  static constexpr uint32_t nof_bins = 16;
+
+  struct summary_t {
+    uint64_t nof_samples = 0;
+    uint64_t nof_late    = 0; ///< Samples flagged as late
+    uint32_t p50_us      = 0; ///< Upper bound of the median
+    uint32_t p99_us      = 0; ///< Upper bound of the 99th percentile
+    uint32_t max_us      = 0;
+  };
+
+  void add(std::chrono::microseconds latency, bool late);
+
+  /// Returns the summary of the samples added since the last call
+  summary_t get_and_reset();
+
+private:
+  std::array<std::atomic<uint64_t>, nof_bins> bins     = {};
+  std::atomic<uint64_t>                       nof_late = {0};
+  std::atomic<uint32_t>                       max_us   = {0};
+};
+
 } // namespace srsran
 
 #endif // SRSRAN_TIME_PROF_H
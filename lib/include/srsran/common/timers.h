@@ -32,6 +32,8 @@
 #include "srsran/adt/intrusive_list.h"
 #include "srsran/adt/move_callback.h"
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstdint>
 #include <deque>
 #include <inttypes.h>
@@ -56,20 +58,26 @@ public:
  *   This deque will only grow in size. Erased timers are just tagged in the deque as empty, and can be reused for the
  *   creation of new timers. To avoid unnecessary runtime allocations, the user can set an initial capacity.
  * - free_list - intrusive forward linked list to keep track of the empty timers and speed up new timer creation.
- * - A large circular vector of size WHEEL_SIZE which works as a time wheel, storing and circularly indexing the
- *   currently running timers by their respective timeout value.
- *   For a number of running timers N, and uniform distribution of timeout values, the step_all() complexity
- *   should be O(N/WHEEL_SIZE). Thus, the performance should improve with a larger WHEEL_SIZE, at the expense of more
- *   used memory.
+ * - A hierarchical time wheel of NOF_LEVELS levels of LEVEL_SIZE slots. The level 0 has a slot per tic, and each slot
+ *   of the level N covers a whole turn of the level N - 1. When the time enters a slot of a level N > 0, its timers
+ *   are moved to the lower levels, so each timer is moved at most NOF_LEVELS - 1 times before it expires.
+ *   The wheel takes a few KB, independently of the maximum timer duration.
+ * - pending_list - lock-free stack of the timers started/stopped by a thread while another was using the wheel. The
+ *   timer state is updated by the calling thread, and the timer is moved in the wheel by the next thread that gets
+ *   the wheel lock, at the latest in the next step_all(). Thus, the threads starting and stopping timers never block.
+ * - step_all() keeps the wheel locked while calling the expiry callbacks. The timers started/stopped by the callbacks
+ *   are moved in the wheel directly, and a callback set by set(duration, callback) is handed over to the stepping
+ *   thread through a small per timer slot, so no thread waits for the wheel while the callbacks run.
  */
 class timer_handler
 {
   using tic_diff_t                      = uint32_t;
   using tic_t                           = uint32_t;
   constexpr static uint32_t INVALID_ID  = std::numeric_limits<uint32_t>::max();
-  constexpr static size_t   WHEEL_SHIFT = 16U;
-  constexpr static size_t   WHEEL_SIZE  = 1U << WHEEL_SHIFT;
-  constexpr static size_t   WHEEL_MASK  = WHEEL_SIZE - 1U;
+  constexpr static size_t   LEVEL_SHIFT = 6U;
+  constexpr static size_t   LEVEL_SIZE  = 1U << LEVEL_SHIFT;
+  constexpr static size_t   LEVEL_MASK  = LEVEL_SIZE - 1U;
+  constexpr static size_t   NOF_LEVELS  = 5U; ///< the levels cover 30 bits, enough for MAX_TIMER_DURATION
 
   constexpr static uint64_t   STOPPED_FLAG       = 0U;
   constexpr static uint64_t   RUNNING_FLAG       = static_cast<uint64_t>(1U) << 63U;
@@ -85,6 +93,9 @@ class timer_handler
     return mode_flag + (static_cast<uint64_t>(duration) << 32U) + timeout;
   }
 
+  struct timer_impl;
+  using wheel_list_t = srsran::intrusive_double_linked_list<timer_impl>;
+
   struct timer_impl : public intrusive_double_linked_list_element<>, public intrusive_forward_list_element<> {
     // const
     const uint32_t id;
@@ -92,7 +103,18 @@ class timer_handler
     // writes protected by backend lock
     bool                                  allocated = false;
     std::atomic<uint64_t>                 state{0}; ///< read can be without lock, thus writes must be atomic
-    srsran::move_callback<void(uint32_t)> callback;
+    srsran::move_callback<void(uint32_t)> callback; ///< only accessed by the wheel lock holder
+    // callback set by set(duration, callback), taken by the wheel lock holder before the timer expires
+    srsran::move_callback<void(uint32_t)> new_callback;
+    std::atomic<bool>                     new_callback_lock{false};
+    std::atomic<bool>                     new_callback_present{false};
+    // position in the wheel, protected by the wheel lock
+    wheel_list_t* wheel_list    = nullptr;
+    tic_t         wheel_timeout = 0;
+    // link in the pending_list
+    std::atomic<bool> pending{false};
+    std::atomic<bool> pending_dealloc{false};
+    timer_impl*       pending_next = nullptr;
 
     explicit timer_impl(timer_handler& parent_, uint32_t id_) : parent(parent_), id(id_) {}
     timer_impl(const timer_impl&) = delete;
@@ -119,7 +141,6 @@ class timer_handler
                     "Invalid timer duration=%" PRIu32 ">%" PRIu32,
                     duration_,
                     MAX_TIMER_DURATION);
-      std::lock_guard<std::mutex> lock(parent.mutex);
       set_(duration_);
     }
 
@@ -129,41 +150,89 @@ class timer_handler
                     "Invalid timer duration=%" PRIu32 ">%" PRIu32,
                     duration_,
                     MAX_TIMER_DURATION);
-      std::lock_guard<std::mutex> lock(parent.mutex);
+      // Published before the timer state, which is what lets the stepping thread expire the timer
+      lock_new_callback();
+      new_callback = std::move(callback_);
+      new_callback_present.store(true, std::memory_order_release);
+      unlock_new_callback();
       set_(duration_);
-      callback = std::move(callback_);
+    }
+
+    /// called in locked context. Applies the callback set by set(duration, callback), if any
+    void take_new_callback()
+    {
+      if (not new_callback_present.load(std::memory_order_acquire)) {
+        return;
+      }
+      lock_new_callback();
+      callback = std::move(new_callback);
+      new_callback_present.store(false, std::memory_order_relaxed);
+      unlock_new_callback();
+    }
+
+    /// called in locked context, when the timer is released
+    void clear_callbacks()
+    {
+      lock_new_callback();
+      new_callback = srsran::move_callback<void(uint32_t)>();
+      new_callback_present.store(false, std::memory_order_relaxed);
+      unlock_new_callback();
+      callback = srsran::move_callback<void(uint32_t)>();
     }
 
     void run()
     {
-      std::lock_guard<std::mutex> lock(parent.mutex);
-      parent.start_run_(*this);
+      // The new state does not depend on the running/expired flags, so a plain store is enough. A concurrent expiry or
+      // stop is ordered either before or after it, as their compare-exchange fails on the restarted state
+      uint32_t d = decode_duration(state.load(std::memory_order_relaxed));
+      state.store(encode_state(RUNNING_FLAG, d, parent.cur_time.load(std::memory_order_relaxed) + d),
+                  std::memory_order_release);
+      parent.update_wheel_(*this);
     }
 
     void stop()
     {
-      std::lock_guard<std::mutex> lock(parent.mutex);
       // does not call callback
-      parent.stop_timer_(*this, false);
+      uint64_t old_state = state.load(std::memory_order_relaxed), new_state;
+      do {
+        if (not decode_is_running(old_state)) {
+          return;
+        }
+        new_state = encode_state(STOPPED_FLAG, decode_duration(old_state), decode_timeout(old_state));
+      } while (not state.compare_exchange_weak(old_state, new_state));
+      parent.update_wheel_(*this);
     }
 
     void deallocate()
     {
-      std::lock_guard<std::mutex> lock(parent.mutex);
-      parent.dealloc_timer_(*this);
+      state.store(encode_state(STOPPED_FLAG, 0, 0));
+      pending_dealloc = true;
+      parent.update_wheel_(*this);
     }
 
   private:
+    void lock_new_callback()
+    {
+      while (new_callback_lock.exchange(true, std::memory_order_acquire)) {
+      }
+    }
+    void unlock_new_callback() { new_callback_lock.store(false, std::memory_order_release); }
+
     void set_(uint32_t duration_)
     {
       duration_ = std::max(duration_, 1U); // the next step will be one place ahead of current one
-      // called in locked context
-      uint64_t old_state = state.load(std::memory_order_relaxed);
+      uint64_t old_state = state.load(std::memory_order_relaxed), new_state;
+      do {
+        if (decode_is_running(old_state)) {
+          // if already running, just extends timer lifetime
+          new_state =
+              encode_state(RUNNING_FLAG, duration_, parent.cur_time.load(std::memory_order_relaxed) + duration_);
+        } else {
+          new_state = encode_state(STOPPED_FLAG, duration_, 0);
+        }
+      } while (not state.compare_exchange_weak(old_state, new_state));
       if (decode_is_running(old_state)) {
-        // if already running, just extends timer lifetime
-        parent.start_run_(*this, duration_);
-      } else {
-        state.store(encode_state(STOPPED_FLAG, duration_, 0), std::memory_order_relaxed);
+        parent.update_wheel_(*this);
       }
     }
   };
@@ -234,7 +303,6 @@ public:
 
   explicit timer_handler(uint32_t capacity = 64)
   {
-    time_wheel.resize(WHEEL_SIZE);
     // Pre-reserve timers
     while (timer_list.size() < capacity) {
       timer_list.emplace_back(*this, timer_list.size());
@@ -248,28 +316,54 @@ public:
 
   void step_all()
   {
-    std::unique_lock<std::mutex> lock(mutex);
-    uint32_t                     cur_time_local = cur_time.load(std::memory_order_relaxed) + 1;
-    auto&                        wheel_list     = time_wheel[cur_time_local & WHEEL_MASK];
-
-    for (auto it = wheel_list.begin(); it != wheel_list.end();) {
-      timer_impl& timer = timer_list[it->id];
-      ++it;
-      if (decode_timeout(timer.state.load(std::memory_order_relaxed)) == cur_time_local) {
-        // stop timer (callback has to see the timer has already expired)
-        stop_timer_(timer, true);
+    std::lock_guard<std::mutex> lock(wheel_mutex);
+    stepping_thread_guard       stepping(*this);
+    apply_pending_();
+
+    tic_t cur_time_local = wheel_time;
+
+    // Move down the timers of the higher level slots that the time enters
+    for (size_t level = NOF_LEVELS - 1; level > 0; --level) {
+      if ((cur_time_local & ((1U << (level * LEVEL_SHIFT)) - 1U)) == 0) {
+        wheel_list_t& slot = time_wheel[level][(cur_time_local >> (level * LEVEL_SHIFT)) & LEVEL_MASK];
+        while (not slot.empty()) {
+          timer_impl& timer = slot.front();
+          unlink_timer_(timer);
+          sync_timer_(timer);
+        }
+      }
+    }
 
-        // Call callback if configured
-        if (not timer.callback.is_empty()) {
-          // unlock mutex. It can happen that the callback tries to run a timer too
-          lock.unlock();
+    // The timers of the current slot are moved to a separate list, as the callbacks may add new timers to the wheel
+    wheel_list_t& slot = time_wheel[0][cur_time_local & LEVEL_MASK];
+    while (not slot.empty()) {
+      timer_impl& timer = slot.front();
+      slot.pop(&timer);
+      expiring_list.push_front(&timer);
+      timer.wheel_list = &expiring_list;
+    }
+    wheel_time = cur_time_local + 1;
 
-          timer.callback(timer.id);
+    while (not expiring_list.empty()) {
+      timer_impl& timer = expiring_list.front();
+      unlink_timer_(timer);
 
-          // Lock again to keep protecting the wheel
-          lock.lock();
+      uint64_t timer_state = timer.state.load();
+      tic_t    timeout     = decode_timeout(timer_state);
+      if (decode_is_running(timer_state) and static_cast<int32_t>(timeout - cur_time_local) <= 0) {
+        // stop timer (callback has to see the timer has already expired)
+        uint64_t new_state = encode_state(EXPIRED_FLAG, decode_duration(timer_state), timeout);
+        if (timer.state.compare_exchange_strong(timer_state, new_state)) {
+          // Call callback if configured. The timers it starts or stops are moved in the wheel by this thread
+          timer.take_new_callback();
+          if (not timer.callback.is_empty()) {
+            timer.callback(timer.id);
+          }
+          continue;
         }
       }
+      // The timer was restarted or stopped by another thread
+      sync_timer_(timer);
     }
 
     cur_time.fetch_add(1, std::memory_order_relaxed);
@@ -277,10 +371,20 @@ public:
 
   void stop_all()
   {
-    std::lock_guard<std::mutex> lock(mutex);
+    // It can be called from an expiry callback, with the wheel already locked by this thread
+    std::unique_lock<std::mutex> lock(wheel_mutex, std::defer_lock);
+    if (not is_stepping_thread_()) {
+      lock.lock();
+    }
+    std::lock_guard<std::mutex> alloc_lock(alloc_mutex);
     // does not call callback
     for (timer_impl& timer : timer_list) {
-      stop_timer_(timer, false);
+      uint64_t old_state = timer.state.load();
+      while (decode_is_running(old_state) and
+             not timer.state.compare_exchange_weak(
+                 old_state, encode_state(STOPPED_FLAG, decode_duration(old_state), decode_timeout(old_state)))) {
+      }
+      unlink_timer_(timer);
     }
   }
 
@@ -288,15 +392,12 @@ public:
 
   uint32_t nof_timers() const
   {
-    std::lock_guard<std::mutex> lock(mutex);
+    std::lock_guard<std::mutex> lock(alloc_mutex);
     return timer_list.size() - nof_free_timers;
   }
 
-  uint32_t nof_running_timers() const
-  {
-    std::lock_guard<std::mutex> lock(mutex);
-    return nof_timers_running_;
-  }
+  /// Timers started or stopped by a thread while another one was using the wheel are accounted in the next step
+  uint32_t nof_running_timers() const { return nof_timers_running_.load(std::memory_order_relaxed); }
 
   constexpr static uint32_t max_timer_duration() { return MAX_TIMER_DURATION; }
 
@@ -314,12 +415,12 @@ public:
   }
 
   // useful for testing
-  static size_t get_wheel_size() { return WHEEL_SIZE; }
+  static size_t get_wheel_size() { return LEVEL_SIZE; }
 
 private:
   timer_impl& alloc_timer()
   {
-    std::lock_guard<std::mutex> lock(mutex);
+    std::lock_guard<std::mutex> lock(alloc_mutex);
     timer_impl*                 t;
     if (not free_list.empty()) {
       t = &free_list.front();
@@ -335,72 +436,152 @@ private:
     return *t;
   }
 
+  /// called in locked context, after the timer has been stopped
   void dealloc_timer_(timer_impl& timer)
   {
+    timer.pending_dealloc = false;
+    unlink_timer_(timer);
+    std::lock_guard<std::mutex> lock(alloc_mutex);
     if (not timer.allocated) {
       // already deallocated
       return;
     }
-    stop_timer_(timer, false);
     timer.allocated = false;
-    timer.state.store(encode_state(STOPPED_FLAG, 0, 0), std::memory_order_relaxed);
-    timer.callback = srsran::move_callback<void(uint32_t)>();
+    timer.clear_callbacks();
     free_list.push_front(&timer);
     nof_free_timers++;
     // leave id unchanged.
   }
 
-  void start_run_(timer_impl& timer, uint32_t duration_ = 0)
+  /// Moves the timer in the wheel after a change of its state. If another thread is using the wheel, the timer is left
+  /// in the pending list
+  void update_wheel_(timer_impl& timer)
   {
-    uint64_t timer_old_state = timer.state.load(std::memory_order_relaxed);
-    duration_                = duration_ == 0 ? decode_duration(timer_old_state) : duration_;
-    uint32_t new_timeout     = cur_time.load(std::memory_order_relaxed) + duration_;
-    size_t   new_wheel_pos   = new_timeout & WHEEL_MASK;
-
-    uint32_t old_timeout = decode_timeout(timer_old_state);
-    bool     was_running = decode_is_running(timer_old_state);
-    if (was_running and (old_timeout & WHEEL_MASK) == new_wheel_pos) {
-      // If no change in timer wheel position. Just update absolute timeout
-      timer.state.store(encode_state(RUNNING_FLAG, duration_, new_timeout), std::memory_order_relaxed);
+    if (is_stepping_thread_()) {
+      // Called from an expiry callback, the wheel is already locked
+      sync_timer_(timer);
       return;
     }
+    if (not wheel_mutex.try_lock()) {
+      push_pending_(timer);
+      return;
+    }
+    sync_timer_(timer);
+    apply_pending_();
+    wheel_mutex.unlock();
+  }
 
-    // Stop timer if it was running, removing it from wheel in the process
-    if (was_running) {
-      time_wheel[old_timeout & WHEEL_MASK].pop(&timer);
-      nof_timers_running_--;
+  void push_pending_(timer_impl& timer)
+  {
+    if (timer.pending.exchange(true)) {
+      // already in the list
+      return;
+    }
+    timer_impl* head = pending_list.load(std::memory_order_relaxed);
+    do {
+      timer.pending_next = head;
+    } while (not pending_list.compare_exchange_weak(head, &timer, std::memory_order_release));
+  }
+
+  /// called in locked context
+  void apply_pending_()
+  {
+    if (pending_list.load(std::memory_order_relaxed) == nullptr) {
+      return;
+    }
+    timer_impl* timer = pending_list.exchange(nullptr, std::memory_order_acquire);
+    while (timer != nullptr) {
+      timer_impl* next = timer->pending_next;
+      // Cleared before reading the timer state, the later changes will push the timer to the list again
+      timer->pending.store(false);
+      sync_timer_(*timer);
+      timer = next;
     }
+  }
 
-    // Insert timer in wheel
-    time_wheel[new_wheel_pos].push_front(&timer);
-    timer.state.store(encode_state(RUNNING_FLAG, duration_, new_timeout), std::memory_order_relaxed);
-    nof_timers_running_++;
+  /// Handler whose step_all() is running in the calling thread, if any
+  static timer_handler*& stepping_handler_()
+  {
+    static thread_local timer_handler* handler = nullptr;
+    return handler;
   }
+  bool is_stepping_thread_() { return stepping_handler_() == this; }
 
-  /// called when user manually stops timer (as an alternative to expiry)
-  void stop_timer_(timer_impl& timer, bool expiry)
+  /// Marks the calling thread as the wheel lock holder of step_all(), for the timers used by the expiry callbacks
+  class stepping_thread_guard
   {
-    uint64_t timer_old_state = timer.state.load(std::memory_order_relaxed);
-    if (not decode_is_running(timer_old_state)) {
+  public:
+    explicit stepping_thread_guard(timer_handler& parent) : prev(stepping_handler_()) { stepping_handler_() = &parent; }
+    stepping_thread_guard(const stepping_thread_guard&) = delete;
+    stepping_thread_guard& operator=(const stepping_thread_guard&) = delete;
+    ~stepping_thread_guard() { stepping_handler_() = prev; }
+
+  private:
+    timer_handler* prev;
+  };
+
+  /// called in locked context. Places the timer in the wheel according to its state
+  void sync_timer_(timer_impl& timer)
+  {
+    if (timer.pending_dealloc.load()) {
+      dealloc_timer_(timer);
       return;
     }
 
-    // If already running, need to disconnect it from previous wheel
-    uint32_t old_timeout = decode_timeout(timer_old_state);
-    time_wheel[old_timeout & WHEEL_MASK].pop(&timer);
-    uint64_t new_state =
-        encode_state(expiry ? EXPIRED_FLAG : STOPPED_FLAG, decode_duration(timer_old_state), old_timeout);
-    timer.state.store(new_state, std::memory_order_relaxed);
-    nof_timers_running_--;
+    uint64_t timer_state = timer.state.load();
+    tic_t    timeout     = decode_timeout(timer_state);
+    if (timer.wheel_list != nullptr) {
+      if (decode_is_running(timer_state) and timer.wheel_timeout == timeout) {
+        // no change in timer wheel position
+        return;
+      }
+      unlink_timer_(timer);
+    }
+    if (not decode_is_running(timer_state)) {
+      return;
+    }
+
+    // Timeouts already past, e.g. set by another thread while the time was stepped, expire in the next step
+    tic_t pos = static_cast<int32_t>(timeout - wheel_time) < 0 ? wheel_time : timeout;
+
+    // Lowest level whose turn covers the time left to the timeout
+    tic_diff_t left  = pos - wheel_time;
+    size_t     level = 0;
+    while (level < NOF_LEVELS - 1 and (left >> ((level + 1) * LEVEL_SHIFT)) != 0) {
+      ++level;
+    }
+    wheel_list_t& slot = time_wheel[level][(pos >> (level * LEVEL_SHIFT)) & LEVEL_MASK];
+    slot.push_front(&timer);
+    timer.wheel_list    = &slot;
+    timer.wheel_timeout = timeout;
+    nof_timers_running_.store(nof_timers_running_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  }
+
+  /// called in locked context. The running timers are the ones linked to the wheel
+  void unlink_timer_(timer_impl& timer)
+  {
+    if (timer.wheel_list == nullptr) {
+      return;
+    }
+    timer.wheel_list->pop(&timer);
+    timer.wheel_list = nullptr;
+    nof_timers_running_.store(nof_timers_running_.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
   }
 
-  std::atomic<tic_t> cur_time{0};
-  size_t             nof_timers_running_ = 0, nof_free_timers = 0;
+  std::atomic<tic_t>    cur_time{0};
+  std::atomic<uint32_t> nof_timers_running_{0}; ///< written in locked context
+  size_t                nof_free_timers = 0;
   // using a deque to maintain reference validity on emplace_back. Also, this deque will only grow.
-  std::deque<timer_impl>                                         timer_list;
-  srsran::intrusive_forward_list<timer_impl>                     free_list;
-  std::vector<srsran::intrusive_double_linked_list<timer_impl> > time_wheel;
-  mutable std::mutex                                             mutex; // Protect priority queue
+  std::deque<timer_impl>                     timer_list;
+  srsran::intrusive_forward_list<timer_impl> free_list;
+  mutable std::mutex                         alloc_mutex; // Protect timer_list and free_list
+  std::atomic<timer_impl*>                   pending_list{nullptr};
+
+  // Protected by wheel_mutex
+  std::mutex                                                       wheel_mutex;
+  tic_t                                                            wheel_time = 1; ///< time of the next step
+  std::array<std::array<wheel_list_t, LEVEL_SIZE>, NOF_LEVELS> time_wheel;
+  wheel_list_t                                                     expiring_list;
 };
 
 using unique_timer = timer_handler::unique_timer;
@@ -231,6 +231,9 @@ struct phy_args_nr_t {
   float                  trs_sinr_ema_alpha    = 0.1f; ///< SINR measurement exponential average alpha
   float                  trs_cfo_ema_alpha     = 0.1f; ///< RSRP measurement exponential average alpha
   bool                   enable_worker_cfo     = true; ///< Enable/Disable open loop CFO correction at the workers
+  bool                   assert_no_alloc       = false; ///< Abort on heap allocations while processing slots
+  bool                   pdsch_mmse_enable     = false; ///< Estimate the PDSCH with the 2D MMSE DMRS filter
+  srsran_wiener_2d_cfg_t pdsch_mmse            = {};    ///< Channel statistics assumed by the PDSCH MMSE filter
 
   phy_args_nr_t()
   {
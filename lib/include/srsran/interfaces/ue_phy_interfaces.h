@@ -56,6 +56,8 @@ struct phy_args_t {
   int force_N_id_2 = -1; // Cell identity within the identity group (PSS) to filter.
   int force_N_id_1 = -1; // Cell identity group (SSS) to filter.
 
+  bool cellsearch_wideband = false; // Pre-scan the DL EARFCN list with a wideband capture before the cell search
+
   float dl_freq = -1.0f;
   float ul_freq = -1.0f;
 
@@ -95,6 +97,9 @@ struct phy_args_t {
   bool        estimator_fil_auto           = false;
   float       estimator_fil_stddev         = 1.0f;
   uint32_t    estimator_fil_order          = 4;
+  bool        estimator_mmse_enabled       = false;
+  float       estimator_mmse_delay_ns      = 0.0f;
+  float       estimator_mmse_doppler_hz    = 0.0f;
   float       snr_to_cqi_offset            = 0.0f;
   std::string sss_algorithm                = "full";
   float       rx_gain_offset               = 62;
@@ -104,6 +109,7 @@ struct phy_args_t {
   uint32_t    intra_freq_meas_period_ms    = 200;
   float       force_ul_amplitude           = 0.0f;
   bool        detect_cp                    = false;
+  bool        assert_no_alloc              = false;
 
   bool nr_store_pdsch_ko = false;
 
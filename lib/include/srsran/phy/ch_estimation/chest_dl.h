@@ -45,6 +45,7 @@
 #include "srsran/phy/common/phy_common.h"
 #include "srsran/phy/resampling/interp.h"
 #include "srsran/phy/sync/pss.h"
+#include "wiener_2d.h"
 #include "wiener_dl.h"
 
 typedef struct SRSRAN_API {
@@ -79,6 +80,7 @@ typedef enum SRSRAN_API {
   SRSRAN_ESTIMATOR_ALG_AVERAGE = 0,
   SRSRAN_ESTIMATOR_ALG_INTERPOLATE,
   SRSRAN_ESTIMATOR_ALG_WIENER,
+  SRSRAN_ESTIMATOR_ALG_MMSE,
 } srsran_chest_dl_estimator_alg_t;
 
 typedef struct SRSRAN_API {
@@ -89,6 +91,7 @@ typedef struct SRSRAN_API {
   srsran_refsignal_t** mbsfn_refs;
 
   srsran_wiener_dl_t* wiener_dl;
+  srsran_wiener_2d_t* wiener_2d;
 
   cf_t* pilot_estimates;
   cf_t* pilot_estimates_average;
@@ -126,6 +129,7 @@ typedef struct SRSRAN_API {
 
   srsran_chest_filter_t       filter_type;
   float                       filter_coef[2];
+  srsran_wiener_2d_cfg_t      mmse_cfg; ///< Channel statistics assumed by the MMSE estimator
 
   uint16_t mbsfn_area_id;
   bool     rsrp_neighbour;
@@ -60,6 +60,8 @@ typedef struct {
 
   float* filter; ///< Smoothing filter
 
+  srsran_wiener_2d_t* wiener_2d; ///< 2D MMSE estimator, only for receivers
+
   srsran_csi_trs_measurements_t csi; ///< Last estimated channel state information
 } srsran_dmrs_sch_t;
 
@@ -0,0 +1,192 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/**********************************************************************************************
+ *  File:         wiener_2d.h
+ *
+ *  Description:  Two dimensional MMSE (Wiener) channel estimator for any pilot grid.
+ *                The 2D filter is the product of a frequency domain filter, applied in sliding
+ *                windows of pilots, and a time domain filter across pilot symbols. The filters
+ *                are derived from an exponential power delay profile and a Jakes Doppler
+ *                spectrum, and they are computed once for each delay spread, Doppler and SNR
+ *                bin and kept in a cache, so that the run time only applies precomputed
+ *                coefficients.
+ *
+ *  Reference:    O. Edfors et al, "OFDM channel estimation by singular value decomposition"
+ *                P. Hoeher et al, "Two-dimensional pilot-symbol-aided channel estimation by
+ *                Wiener filtering"
+ *********************************************************************************************/
+
+#ifndef SRSRAN_WIENER_2D_H
+#define SRSRAN_WIENER_2D_H
+
+#include "srsran/config.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Number of pilots of the frequency domain filter window
+ */
+#define SRSRAN_WIENER_2D_WINDOW_PILOTS 8
+
+/**
+ * @brief Maximum pilot pattern period in subcarriers
+ */
+#define SRSRAN_WIENER_2D_MAX_PERIOD 12
+
+/**
+ * @brief Maximum number of OFDM symbols carrying pilots
+ */
+#define SRSRAN_WIENER_2D_MAX_PILOT_SYMBOLS 4
+
+/**
+ * @brief Maximum number of estimated OFDM symbols
+ */
+#define SRSRAN_WIENER_2D_MAX_SYMBOLS 14
+
+/**
+ * @brief Number of frequency and time filters kept in the cache. A receiver serving several UEs keeps a filter for
+ * every SNR bin of its UEs and every DMRS time pattern in use, about 30 in a loaded cell, with room to spare so that
+ * the filters are not recomputed in the decoding path.
+ */
+#define SRSRAN_WIENER_2D_CACHE_SIZE 64
+
+/**
+ * @brief Default channel parameters, used when they are not configured
+ */
+#define SRSRAN_WIENER_2D_DEFAULT_DELAY_SPREAD_NS 400.0f
+#define SRSRAN_WIENER_2D_DEFAULT_DOPPLER_HZ 80.0f
+
+/**
+ * @brief Channel statistics assumed by the estimator, selectable for each UE or bearer. Zero values select the
+ * defaults. The values are rounded to the closest bin, so that a limited set of filters is ever computed.
+ */
+typedef struct SRSRAN_API {
+  float delay_spread_ns; ///< RMS delay spread
+  float doppler_hz;      ///< Maximum Doppler shift
+} srsran_wiener_2d_cfg_t;
+
+/**
+ * @brief Describes the pilot grid of a transmission. Every pilot symbol has the same number of pilots and pilots
+ * repeat every period subcarriers in the positions given by the mask.
+ */
+typedef struct SRSRAN_API {
+  float    scs_hz;                                                ///< Subcarrier spacing
+  float    symbol_duration_s;                                     ///< OFDM symbol duration, including CP
+  uint32_t period;                                                ///< Pilot pattern period in subcarriers
+  uint32_t nof_pilots;                                            ///< Number of pilots in each pilot symbol
+  uint32_t nof_pilot_symbols;                                     ///< Number of pilot symbols
+  uint32_t pilot_symbols[SRSRAN_WIENER_2D_MAX_PILOT_SYMBOLS];     ///< Pilot symbol indexes, in increasing order
+  uint32_t pilot_mask[SRSRAN_WIENER_2D_MAX_PILOT_SYMBOLS];        ///< Subcarriers with pilots in each period
+  uint32_t first_symbol;                                          ///< First estimated symbol
+  uint32_t nof_symbols;                                           ///< Number of estimated symbols
+} srsran_wiener_2d_grid_t;
+
+typedef struct SRSRAN_API {
+  bool     valid;
+  uint64_t last_used;
+  float    scs_hz;
+  uint32_t period;
+  uint32_t mask;
+  uint32_t nof_window_pilots;
+  uint32_t delay_bin;
+  uint32_t snr_bin;
+  float    noise_gain; ///< Average noise power gain of the filter
+  cf_t     coef[SRSRAN_WIENER_2D_WINDOW_PILOTS][SRSRAN_WIENER_2D_WINDOW_PILOTS * SRSRAN_WIENER_2D_MAX_PERIOD];
+} srsran_wiener_2d_freq_filter_t;
+
+typedef struct SRSRAN_API {
+  bool     valid;
+  uint64_t last_used;
+  float    symbol_duration_s;
+  uint32_t nof_pilot_symbols;
+  uint32_t pilot_symbols[SRSRAN_WIENER_2D_MAX_PILOT_SYMBOLS];
+  uint32_t first_symbol;
+  uint32_t nof_symbols;
+  uint32_t doppler_bin;
+  uint32_t snr_bin;
+  float    coef[SRSRAN_WIENER_2D_MAX_SYMBOLS][SRSRAN_WIENER_2D_MAX_PILOT_SYMBOLS];
+} srsran_wiener_2d_time_filter_t;
+
+typedef struct SRSRAN_API {
+  uint32_t max_re;
+
+  // Filter cache, least recently used filters are replaced
+  srsran_wiener_2d_freq_filter_t freq_cache[SRSRAN_WIENER_2D_CACHE_SIZE];
+  srsran_wiener_2d_time_filter_t time_cache[SRSRAN_WIENER_2D_CACHE_SIZE];
+  uint64_t                       use_count;
+  uint32_t                       nof_computed; ///< Number of filters computed since initialisation
+
+  // Last frequency domain estimates and the time filter selected for them
+  cf_t*                                 freq_estimates[SRSRAN_WIENER_2D_MAX_PILOT_SYMBOLS];
+  uint32_t                              nof_re;
+  const srsran_wiener_2d_time_filter_t* time_filter;
+
+  cf_t* temp;
+} srsran_wiener_2d_t;
+
+/**
+ * @brief Initialises the estimator
+ * @param q Estimator object
+ * @param max_re Maximum number of subcarriers
+ * @return SRSRAN_SUCCESS if no error occurs, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_wiener_2d_init(srsran_wiener_2d_t* q, uint32_t max_re);
+
+SRSRAN_API void srsran_wiener_2d_free(srsran_wiener_2d_t* q);
+
+/**
+ * @brief Filters the least squares estimates of every pilot symbol in frequency and selects the time filter. The
+ * estimates are read with srsran_wiener_2d_get_symbol().
+ * @param q Estimator object
+ * @param cfg Channel statistics, NULL for defaults
+ * @param grid Pilot grid
+ * @param snr_db Pilot signal-to-noise ratio
+ * @param pilots Least squares estimates, nof_pilots for each pilot symbol consecutively
+ * @return The number of subcarriers of every estimated symbol, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_wiener_2d_run(srsran_wiener_2d_t*            q,
+                                    const srsran_wiener_2d_cfg_t*  cfg,
+                                    const srsran_wiener_2d_grid_t* grid,
+                                    float                          snr_db,
+                                    const cf_t*                    pilots);
+
+/**
+ * @brief Interpolates in time the channel estimate of a symbol from the last srsran_wiener_2d_run()
+ * @param q Estimator object
+ * @param symbol_idx Symbol index, between first_symbol and first_symbol + nof_symbols - 1
+ * @param ce Channel estimates of the symbol
+ * @return SRSRAN_SUCCESS if no error occurs, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_wiener_2d_get_symbol(srsran_wiener_2d_t* q, uint32_t symbol_idx, cf_t* ce);
+
+/**
+ * @brief Runs the estimator and writes the estimates of all the grid symbols consecutively
+ * @return The number of subcarriers of every estimated symbol, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_wiener_2d_estimate(srsran_wiener_2d_t*            q,
+                                         const srsran_wiener_2d_cfg_t*  cfg,
+                                         const srsran_wiener_2d_grid_t* grid,
+                                         float                          snr_db,
+                                         const cf_t*                    pilots,
+                                         cf_t*                          ce);
+
+#endif // SRSRAN_WIENER_2D_H
@@ -43,6 +43,7 @@
 #include "srsran/phy/phch/regs.h"
 #include "srsran/phy/phch/sch.h"
 #include "srsran/phy/scrambling/scrambling.h"
+#include "srsran/phy/utils/mem_arena.h"
 
 /* PDSCH object */
 typedef struct SRSRAN_API {
@@ -76,6 +77,10 @@ typedef struct SRSRAN_API {
 
   void* coworker_ptr;
 
+  /* per-subframe buffers taken from an arena, reset by the owner every subframe */
+  srsran_mem_arena_t* scratch;
+  uint32_t            scratch_epoch;
+
 } srsran_pdsch_t;
 
 typedef struct {
@@ -96,6 +101,23 @@ SRSRAN_API int srsran_pdsch_enable_coworker(srsran_pdsch_t* q);
 
 SRSRAN_API int srsran_pdsch_set_cell(srsran_pdsch_t* q, srsran_cell_t cell);
 
+/**
+ * @brief Number of arena bytes the PDSCH takes every subframe when it is given a scratch arena
+ * @param max_prb Maximum number of PRB given to srsran_pdsch_init_ue() or srsran_pdsch_init_enb()
+ * @param nof_rx_antennas Number of receive antennas for the UE, 0 for the eNb
+ * @return The number of bytes
+ */
+SRSRAN_API size_t srsran_pdsch_scratch_size(uint32_t max_prb, uint32_t nof_rx_antennas);
+
+/**
+ * @brief Releases the heap buffers of the PDSCH and takes them from the given arena every subframe instead. The arena
+ * is reset by its owner between subframes, the buffers do not survive the reset
+ * @param q PDSCH object
+ * @param scratch Arena of the subframe buffers
+ * @return SRSRAN_SUCCESS if no error occurs, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_pdsch_set_scratch(srsran_pdsch_t* q, srsran_mem_arena_t* scratch);
+
 /* These functions do not modify the state and run in real-time */
 SRSRAN_API int srsran_pdsch_encode(srsran_pdsch_t*     q,
                                    srsran_dl_sf_cfg_t* sf,
@@ -38,6 +38,7 @@
 #include "srsran/phy/phch/regs.h"
 #include "srsran/phy/phch/sch_nr.h"
 #include "srsran/phy/scrambling/scrambling.h"
+#include "srsran/phy/utils/mem_arena.h"
 
 /**
  * @brief PDSCH encoder and decoder initialization arguments
@@ -48,6 +49,8 @@ typedef struct SRSRAN_API {
   bool                 measure_time;
   uint32_t             max_prb;
   uint32_t             max_layers;
+  srsran_mem_arena_t*  scratch; ///< Per-slot buffers are taken from this arena, reset by the owner every slot. NULL
+                                ///< allocates them from the heap
 } srsran_pdsch_nr_args_t;
 
 /**
@@ -68,6 +71,8 @@ typedef struct SRSRAN_API {
   uint32_t             meas_time_us;
   srsran_re_pattern_t  dmrs_re_pattern;
   uint32_t             nof_rvd_re;
+  srsran_mem_arena_t*  scratch;       ///< Arena of the per-slot buffers, NULL if they are in the heap
+  uint32_t             scratch_epoch; ///< Arena epoch of the per-slot buffers
 } srsran_pdsch_nr_t;
 
 /**
@@ -84,6 +89,13 @@ SRSRAN_API int srsran_pdsch_nr_init_ue(srsran_pdsch_nr_t* q, const srsran_pdsch_
 
 SRSRAN_API void srsran_pdsch_nr_free(srsran_pdsch_nr_t* q);
 
+/**
+ * @brief Number of arena bytes the PDSCH takes every slot when it is given a scratch arena
+ * @param args PDSCH arguments
+ * @return The number of bytes
+ */
+SRSRAN_API size_t srsran_pdsch_nr_scratch_size(const srsran_pdsch_nr_args_t* args);
+
 SRSRAN_API int srsran_pdsch_nr_set_carrier(srsran_pdsch_nr_t* q, const srsran_carrier_nr_t* carrier);
 
 SRSRAN_API int srsran_pdsch_nr_encode(srsran_pdsch_nr_t*           q,
@@ -31,6 +31,7 @@
 #define SRSRAN_PHCH_CFG_NR_H
 
 #include "srsran/phy/ch_estimation/csi_rs_cfg.h"
+#include "srsran/phy/ch_estimation/wiener_2d.h"
 #include "srsran/phy/common/phy_common_nr.h"
 #include "srsran/phy/phch/sch_cfg_nr.h"
 #include "srsran/phy/phch/uci_cfg_nr.h"
@@ -91,6 +92,10 @@ typedef struct {
   /// Parameters provided by FeatureSetDownlink-v1540
   bool additional_DMRS_DL_Alt;
 
+  /// Receiver only parameters, estimates the channel with a 2D MMSE filter instead of interpolating
+  bool                   mmse_enable;
+  srsran_wiener_2d_cfg_t mmse;
+
 } srsran_dmrs_sch_cfg_t;
 
 /**
@@ -208,6 +213,10 @@ typedef struct SRSRAN_API {
     bool                      present;
   } dmrs_typeB;
 
+  /// Receiver only parameters, estimates this shared channel with the 2D MMSE DMRS filter instead of interpolating
+  bool                   dmrs_mmse_enable;
+  srsran_wiener_2d_cfg_t dmrs_mmse;
+
   srsran_sch_time_ra_t common_time_ra[SRSRAN_MAX_NOF_TIME_RA];
   uint32_t             nof_common_time_ra;
 
@@ -31,6 +31,7 @@
 #include "srsran/phy/phch/sch_nr.h"
 #include "srsran/phy/phch/uci_nr.h"
 #include "srsran/phy/scrambling/scrambling.h"
+#include "srsran/phy/utils/mem_arena.h"
 
 /**
  * @brief PUSCH encoder and decoder initialization arguments
@@ -42,6 +43,8 @@ typedef struct SRSRAN_API {
   bool                 measure_time;
   uint32_t             max_layers;
   uint32_t             max_prb;
+  srsran_mem_arena_t*  scratch; ///< Per-slot buffers are taken from this arena, reset by the owner every slot. NULL
+                                ///< allocates them from the heap
 } srsran_pusch_nr_args_t;
 
 /**
@@ -75,6 +78,8 @@ typedef struct SRSRAN_API {
   uint32_t             G_csi1;    ///< Number of encoded CSI part 1 bits
   uint32_t             G_csi2;    ///< Number of encoded CSI part 2 bits
   uint32_t             G_ulsch;   ///< Number of encoded shared channel
+  srsran_mem_arena_t*  scratch;       ///< Arena of the per-slot buffers, NULL if they are in the heap
+  uint32_t             scratch_epoch; ///< Arena epoch of the per-slot buffers
 } srsran_pusch_nr_t;
 
 /**
@@ -100,6 +105,13 @@ SRSRAN_API int srsran_pusch_nr_init_ue(srsran_pusch_nr_t* q, const srsran_pusch_
 
 SRSRAN_API void srsran_pusch_nr_free(srsran_pusch_nr_t* q);
 
+/**
+ * @brief Number of arena bytes the PUSCH takes every slot when it is given a scratch arena
+ * @param args PUSCH arguments
+ * @return The number of bytes
+ */
+SRSRAN_API size_t srsran_pusch_nr_scratch_size(const srsran_pusch_nr_args_t* args);
+
 SRSRAN_API int srsran_pusch_nr_set_carrier(srsran_pusch_nr_t* q, const srsran_carrier_nr_t* carrier);
 
 SRSRAN_API int srsran_pusch_nr_encode(srsran_pusch_nr_t*            q,
@@ -0,0 +1,125 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ *  File:         rf_sample_format.h
+ *
+ *  Description:  Sample format conversion kernels shared by the RF backends.
+ *                Converts between complex float (cf32) and the wire formats
+ *                sc16, packed sc12 (3 bytes per complex sample) and sc8. Every
+ *                kernel applies the scaling (e.g. Rx/Tx gain) in the same pass
+ *                as the conversion and, optionally, (de)interleaves channels.
+ *
+ *  Reference:
+ *****************************************************************************/
+
+#ifndef SRSRAN_RF_SAMPLE_FORMAT_H
+#define SRSRAN_RF_SAMPLE_FORMAT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "srsran/config.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef enum SRSRAN_API {
+  SRSRAN_RF_SAMPLE_FORMAT_FC32 = 0, ///< Complex float, 8 bytes per sample
+  SRSRAN_RF_SAMPLE_FORMAT_SC16,     ///< Complex int16, 4 bytes per sample
+  SRSRAN_RF_SAMPLE_FORMAT_SC12,     ///< Packed complex int12, 3 bytes per sample
+  SRSRAN_RF_SAMPLE_FORMAT_SC8,      ///< Complex int8, 2 bytes per sample
+  SRSRAN_RF_SAMPLE_FORMAT_INVALID
+} srsran_rf_sample_format_t;
+
+/**
+ * @brief Parses a sample format name ("fc32", "sc16", "sc12" or "sc8")
+ * @return The sample format or SRSRAN_RF_SAMPLE_FORMAT_INVALID if the name is unknown
+ */
+SRSRAN_API srsran_rf_sample_format_t srsran_rf_sample_format_from_string(const char* str);
+
+SRSRAN_API const char* srsran_rf_sample_format_to_string(srsran_rf_sample_format_t format);
+
+/**
+ * @brief Number of bytes used by nof_samples complex samples of the given format in the wire
+ */
+SRSRAN_API uint32_t srsran_rf_sample_format_nof_bytes(srsran_rf_sample_format_t format, uint32_t nof_samples);
+
+/**
+ * @brief Full-scale integer value of the format, i.e. the integer value that maps to 1.0 in cf32 (1.0 for fc32)
+ */
+SRSRAN_API float srsran_rf_sample_format_full_scale(srsran_rf_sample_format_t format);
+
+/**
+ * @brief Converts wire samples into cf32, applying the gain in the same pass: y = gain * x / full_scale
+ * @param format Wire format of the source samples
+ * @param src Source buffer in wire format
+ * @param dst Destination complex float buffer, it can alias src only for fc32
+ * @param gain Linear amplitude gain
+ * @param nof_samples Number of complex samples
+ */
+SRSRAN_API void srsran_rf_convert_to_cf(srsran_rf_sample_format_t format,
+                                        const void*               src,
+                                        cf_t*                     dst,
+                                        float                     gain,
+                                        uint32_t                  nof_samples);
+
+/**
+ * @brief Converts cf32 samples into the wire format, applying the gain in the same pass. Integer formats saturate.
+ * @param format Wire format of the destination samples
+ * @param src Source complex float buffer, it is never modified
+ * @param dst Destination buffer in wire format
+ * @param gain Linear amplitude gain
+ * @param nof_samples Number of complex samples
+ */
+SRSRAN_API void srsran_rf_convert_from_cf(srsran_rf_sample_format_t format,
+                                          const cf_t*               src,
+                                          void*                     dst,
+                                          float                     gain,
+                                          uint32_t                  nof_samples);
+
+/**
+ * @brief Converts a channel-interleaved wire buffer (ch0 s0, ch1 s0, ..., ch0 s1, ...) into one cf32 buffer per
+ * channel. NULL destination channels are skipped.
+ */
+SRSRAN_API void srsran_rf_convert_to_cf_deinterleave(srsran_rf_sample_format_t format,
+                                                     const void*               src,
+                                                     cf_t**                    dst,
+                                                     uint32_t                  nof_channels,
+                                                     float                     gain,
+                                                     uint32_t                  nof_samples);
+
+/**
+ * @brief Converts one cf32 buffer per channel into a channel-interleaved wire buffer. NULL source channels are
+ * transmitted as zeros.
+ */
+SRSRAN_API void srsran_rf_convert_from_cf_interleave(srsran_rf_sample_format_t format,
+                                                     const cf_t**              src,
+                                                     void*                     dst,
+                                                     uint32_t                  nof_channels,
+                                                     float                     gain,
+                                                     uint32_t                  nof_samples);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SRSRAN_RF_SAMPLE_FORMAT_H
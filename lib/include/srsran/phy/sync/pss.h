@@ -137,6 +137,10 @@ SRSRAN_API int srsran_pss_set_N_id_2(srsran_pss_t* q, uint32_t N_id_2);
 
 SRSRAN_API int srsran_pss_find_pss(srsran_pss_t* q, const cf_t* input, float* corr_peak_value);
 
+SRSRAN_API int srsran_pss_input_fft(srsran_pss_t* q, const cf_t* input);
+
+SRSRAN_API int srsran_pss_find_pss_fft(srsran_pss_t* q, const srsran_pss_t* src, float* corr_peak_value);
+
 SRSRAN_API int srsran_pss_chest(srsran_pss_t* q, const cf_t* input, cf_t ce[SRSRAN_PSS_LEN]);
 
 SRSRAN_API float srsran_pss_cfo_compute(srsran_pss_t* q, const cf_t* pss_recv);
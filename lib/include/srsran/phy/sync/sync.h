@@ -149,6 +149,15 @@ SRSRAN_API srsran_sync_find_ret_t srsran_sync_find(srsran_sync_t* q,
                                                    uint32_t       find_offset,
                                                    uint32_t*      peak_position);
 
+/* Same as srsran_sync_find() for an input and find_offset that have just been processed by src. The PSS input transform
+ * of src is reused, so several N_id_2 hypotheses can be searched with a single forward FFT. It falls back to
+ * srsran_sync_find() if src corrects the CFO of the input or has a different size */
+SRSRAN_API srsran_sync_find_ret_t srsran_sync_find_shared(srsran_sync_t*       q,
+                                                          const srsran_sync_t* src,
+                                                          const cf_t*          input,
+                                                          uint32_t             find_offset,
+                                                          uint32_t*            peak_position);
+
 /* Estimates the CP length */
 SRSRAN_API srsran_cp_t srsran_sync_detect_cp(srsran_sync_t* q, const cf_t* input, uint32_t peak_pos);
 
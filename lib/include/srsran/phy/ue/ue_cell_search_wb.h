@@ -0,0 +1,119 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ *  File:         ue_cell_search_wb.h
+ *
+ *  Description:  Incremental LTE cell search of one channel inside a wideband
+ *                capture.
+ *
+ *                The object down-converts the channel centered at a given
+ *                frequency offset from the capture center, decimates it to
+ *                SRSRAN_CS_SAMP_FREQ and looks for PSS/SSS of the three N_id_2
+ *                at once. Samples are fed incrementally so the search can be
+ *                terminated as soon as a PSS peak with enough confidence is
+ *                found. Several objects can run concurrently on the same
+ *                capture, one per channel.
+ *
+ *  Reference:
+ *****************************************************************************/
+
+#ifndef SRSRAN_UE_CELL_SEARCH_WB_H
+#define SRSRAN_UE_CELL_SEARCH_WB_H
+
+#include "srsran/config.h"
+#include "srsran/phy/resampling/resampler.h"
+#include "srsran/phy/sync/sync.h"
+#include "srsran/phy/ue/ue_cell_search.h"
+
+typedef struct SRSRAN_API {
+  float    psr_threshold;    ///< Minimum PSS peak-to-side-lobe ratio for considering a detection (default 2.0)
+  float    early_exit_psr;   ///< A detection with a PSR above this value terminates the search immediately (default 8.0)
+  uint32_t nof_valid_frames; ///< Number of 5 ms detections of the same cell that terminate the search (default 4)
+} srsran_ue_cellsearch_wb_cfg_t;
+
+typedef struct SRSRAN_API {
+  // Configuration
+  srsran_ue_cellsearch_wb_cfg_t cfg;
+  double                        srate_hz;
+  double                        offset_hz;
+  uint32_t                      decimation;
+
+  // Digital down-converter
+  srsran_resampler_fft_t decimator;
+  cf_t*                  mix_buffer;
+  uint64_t               mix_count;
+
+  // Narrowband detector, one sync object per N_id_2
+  srsran_sync_t sfind[SRSRAN_NOF_NID_2];
+  cf_t*         nb_buffer;
+  uint32_t      nb_len;
+
+  // Detection state
+  srsran_ue_cellsearch_result_t best;
+  uint32_t                      nof_detections[SRSRAN_NUM_PCI];
+  uint32_t                      nof_frames;
+  bool                          found;
+} srsran_ue_cellsearch_wb_t;
+
+/**
+ * @brief Initialises a wideband channel search object
+ * @param q Object
+ * @param srate_hz Sampling rate of the wideband capture, it shall be a multiple of SRSRAN_CS_SAMP_FREQ
+ * @return SRSRAN_SUCCESS if no error occurs, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_ue_cellsearch_wb_init(srsran_ue_cellsearch_wb_t* q, double srate_hz);
+
+SRSRAN_API void srsran_ue_cellsearch_wb_free(srsran_ue_cellsearch_wb_t* q);
+
+/**
+ * @brief Sets the search configuration, the default values are used if cfg is NULL
+ */
+SRSRAN_API void srsran_ue_cellsearch_wb_set_cfg(srsran_ue_cellsearch_wb_t* q, const srsran_ue_cellsearch_wb_cfg_t* cfg);
+
+/**
+ * @brief Selects the channel to search and resets the detection state
+ * @param q Object
+ * @param offset_hz Channel center frequency relative to the capture center frequency
+ * @return SRSRAN_SUCCESS if the channel fits in the capture bandwidth, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_ue_cellsearch_wb_set_channel(srsran_ue_cellsearch_wb_t* q, double offset_hz);
+
+/**
+ * @brief Processes a block of consecutive wideband samples
+ * @param q Object
+ * @param wb Wideband samples, contiguous with the ones of the previous call since the last channel selection
+ * @param nof_samples Number of samples, it shall be a multiple of the decimation factor
+ * @param result Detected cell, written only if the search terminates
+ * @return 1 if the search terminated with a cell, 0 if more samples are required, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_ue_cellsearch_wb_feed(srsran_ue_cellsearch_wb_t*     q,
+                                            const cf_t*                    wb,
+                                            uint32_t                       nof_samples,
+                                            srsran_ue_cellsearch_result_t* result);
+
+/**
+ * @brief Gets the most detected cell so far, regardless of the termination criteria
+ * @return 1 if any cell was detected, 0 otherwise
+ */
+SRSRAN_API int srsran_ue_cellsearch_wb_get_best(srsran_ue_cellsearch_wb_t* q, srsran_ue_cellsearch_result_t* result);
+
+#endif // SRSRAN_UE_CELL_SEARCH_WB_H
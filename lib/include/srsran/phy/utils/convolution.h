@@ -67,6 +67,21 @@ SRSRAN_API uint32_t srsran_conv_fft_cc_run(srsran_conv_fft_cc_t* q,
                                            const cf_t*           filter,
                                            cf_t*                 output);
 
+/**
+ * @brief Transforms the input of a convolution into the frequency domain and stores it in q->input_fft. The same
+ * transform can be convolved with several filters of the same size using srsran_conv_fft_cc_run_freq().
+ */
+SRSRAN_API void srsran_conv_fft_cc_run_input(srsran_conv_fft_cc_t* q, const cf_t* input);
+
+/**
+ * @brief Convolves an input and a filter already transformed into the frequency domain, both output_len long
+ * @return The number of valid output samples
+ */
+SRSRAN_API uint32_t srsran_conv_fft_cc_run_freq(srsran_conv_fft_cc_t* q,
+                                                const cf_t*           input_freq,
+                                                const cf_t*           filter_freq,
+                                                cf_t*                 output);
+
 SRSRAN_API uint32_t srsran_conv_fft_cc_run_opt(srsran_conv_fft_cc_t* q,
                                                const cf_t*           input,
                                                const cf_t*           filter_freq,
@@ -0,0 +1,135 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ *  File:         mem_arena.h
+ *
+ *  Description:  Memory arena for PHY workers. The arena is a single aligned
+ *                block allocated once, from which buffers are carved with a bump
+ *                pointer. Buffers are never freed individually; the arena is reset
+ *                to a mark instead, so memory obtained after the mark can be used as
+ *                scratch that lasts one TTI.
+ *
+ *                The allocation guard counts the heap allocations done through the
+ *                srsran_vec_malloc() family by the calling thread between enter and
+ *                exit, and the C++ operator new when built with
+ *                ENABLE_NEW_GUARD. It is used to verify that the real-time
+ *                paths do not allocate.
+ *****************************************************************************/
+
+#ifndef SRSRAN_MEM_ARENA_H
+#define SRSRAN_MEM_ARENA_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "srsran/config.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct SRSRAN_API {
+  uint8_t* buffer;
+  size_t   size;
+  size_t   offset;     ///< Bytes in use
+  size_t   mark;       ///< Offset restored by srsran_mem_arena_reset()
+  size_t   high_water; ///< Maximum number of bytes ever in use
+  uint32_t nof_failed; ///< Number of allocations that did not fit
+  uint32_t epoch;      ///< Incremented by srsran_mem_arena_reset(), lets users detect that their buffers were released
+} srsran_mem_arena_t;
+
+/**
+ * @brief Alignment of the arena buffers, suitable for any SIMD instruction set
+ */
+#define SRSRAN_MEM_ARENA_ALIGN 64
+
+/**
+ * @brief Number of arena bytes taken by a buffer of N elements of type T
+ */
+#define SRSRAN_MEM_ARENA_SIZE(T, N)                                                                                    \
+  ((sizeof(T) * (N) + SRSRAN_MEM_ARENA_ALIGN - 1) & ~((size_t)SRSRAN_MEM_ARENA_ALIGN - 1))
+
+#define SRSRAN_MEM_ARENA_ALLOC(Q, T, N) ((T*)srsran_mem_arena_alloc(Q, sizeof(T) * (N)))
+
+/**
+ * @brief Initialises an arena and allocates its memory
+ * @param q Arena object
+ * @param size Arena size in bytes
+ * @return SRSRAN_SUCCESS if no error occurs, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_mem_arena_init(srsran_mem_arena_t* q, size_t size);
+
+SRSRAN_API void srsran_mem_arena_free(srsran_mem_arena_t* q);
+
+/**
+ * @brief Carves a SIMD aligned buffer from the arena
+ * @param q Arena object
+ * @param nbytes Buffer size in bytes
+ * @return Pointer to the buffer, NULL if the arena is exhausted
+ */
+SRSRAN_API void* srsran_mem_arena_alloc(srsran_mem_arena_t* q, size_t nbytes);
+
+/**
+ * @brief Sets the mark to the current offset. Buffers allocated before the mark survive srsran_mem_arena_reset()
+ */
+SRSRAN_API void srsran_mem_arena_set_mark(srsran_mem_arena_t* q);
+
+/**
+ * @brief Releases all the buffers allocated after the mark and starts a new epoch
+ */
+SRSRAN_API void srsran_mem_arena_reset(srsran_mem_arena_t* q);
+
+/**
+ * @brief Starts counting the heap allocations of the calling thread
+ * @param assert_no_alloc Set to true for aborting on the first heap allocation
+ */
+SRSRAN_API void srsran_mem_guard_enter(bool assert_no_alloc);
+
+/**
+ * @brief Stops counting the heap allocations of the calling thread
+ * @return The number of heap allocations since srsran_mem_guard_enter()
+ */
+SRSRAN_API uint32_t srsran_mem_guard_exit(void);
+
+/**
+ * @brief Informs the guard of a heap allocation. Called by the allocation functions
+ */
+SRSRAN_API void srsran_mem_guard_notify(size_t nbytes);
+
+/**
+ * @brief Tells if the calling thread is counting its heap allocations, so other threads doing work on its behalf can
+ * count theirs too
+ * @param assert_no_alloc Set to the assert flag given to srsran_mem_guard_enter(), can be NULL
+ * @return True between srsran_mem_guard_enter() and srsran_mem_guard_exit()
+ */
+SRSRAN_API bool srsran_mem_guard_is_enabled(bool* assert_no_alloc);
+
+/**
+ * @brief Adds the heap allocations done by other threads on behalf of the calling thread to its count
+ */
+SRSRAN_API void srsran_mem_guard_add(uint32_t nof_allocs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SRSRAN_MEM_ARENA_H
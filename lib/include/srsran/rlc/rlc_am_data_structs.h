@@ -26,6 +26,7 @@
 #include "srsran/adt/circular_map.h"
 #include "srsran/adt/intrusive_list.h"
 #include "srsran/common/buffer_pool.h"
+#include "srsran/common/byte_buffer_chain.h"
 #include <array>
 #include <vector>
 
@@ -124,10 +125,10 @@ public:
   using iterator       = typename list_type::iterator;
   using const_iterator = typename list_type::const_iterator;
 
-  const uint32_t       rlc_sn     = invalid_rlc_sn;
-  uint32_t             retx_count = 0;
-  HeaderType           header     = {};
-  unique_byte_buffer_t buf        = nullptr;
+  const uint32_t    rlc_sn     = invalid_rlc_sn;
+  uint32_t          retx_count = 0;
+  HeaderType        header     = {};
+  byte_buffer_chain buf;
 
   explicit rlc_amd_tx_pdu(uint32_t rlc_sn_) : rlc_sn(rlc_sn_) {}
   rlc_amd_tx_pdu(const rlc_amd_tx_pdu&)           = delete;
@@ -0,0 +1,431 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#ifndef SRSLOG_DETAIL_BINARY_LOG_WRITER_H
+#define SRSLOG_DETAIL_BINARY_LOG_WRITER_H
+
+#include "srsran/srslog/detail/log_entry_metadata.h"
+#include "srsran/srslog/detail/support/byte_ring.h"
+#include "srsran/srslog/detail/support/thread_utils.h"
+#include <algorithm>
+#include <array>
+#include <thread>
+#include <vector>
+
+namespace srslog {
+
+namespace detail {
+
+/// Binary log format. The log entries are stored unformatted: the format
+/// string and the channel name are referenced by an id, the hash of their
+/// contents, and the arguments are stored in their binary form.
+/// Every record is stored as a 32 bit size, followed by the record type and its
+/// payload. Records are written in the native byte order.
+namespace binary_log {
+
+/// Magic string at the beginning of binary log files.
+constexpr char     file_magic[]    = "SRSLOGB1";
+constexpr size_t   file_magic_size = sizeof(file_magic) - 1;
+constexpr uint32_t max_nof_args    = 255;
+
+enum class record_type : uint8_t {
+  /// Payload: 64 bit string id followed by the string characters.
+  string_def = 1,
+  /// Payload: entry_header followed by the hex dump bytes and the encoded
+  /// arguments.
+  entry = 2,
+  /// Payload: text formatted by the backend.
+  text = 3
+};
+
+/// Each argument is stored as its type followed by its value. Strings values
+/// are a 32 bit length followed by the characters.
+enum class arg_type : uint8_t { i32, u32, i64, u64, dbl, chr, boolean, ptr, str };
+
+/// Fixed part of the entry records.
+struct entry_header {
+  int64_t  timestamp;   ///< Ticks of the high resolution clock.
+  uint64_t fmt_id;      ///< Id of the format string.
+  uint64_t name_id;     ///< Id of the log channel name.
+  uint32_t ctx_value;   ///< Log channel context value.
+  uint32_t hex_len;     ///< Length of the hex dump.
+  uint8_t  ctx_enabled; ///< When true, the context value is printed.
+  char     tag;         ///< Log channel tag.
+  uint8_t  nof_args;    ///< Number of encoded arguments.
+};
+
+/// Returns the id of a string, a 64 bit hash of its contents. The id 0 is
+/// never returned, it marks the empty slots of the string caches.
+inline uint64_t string_id(const char* str, size_t len)
+{
+  const uint64_t mul = 0x9E3779B97F4A7C15ULL;
+  uint64_t       h   = len * mul;
+  for (; len >= sizeof(uint64_t); str += sizeof(uint64_t), len -= sizeof(uint64_t)) {
+    uint64_t word;
+    std::memcpy(&word, str, sizeof(word));
+    h = (h ^ word) * mul;
+    h ^= h >> 32U;
+  }
+  uint64_t tail = 0;
+  std::memcpy(&tail, str, len);
+  h = (h ^ tail) * mul;
+  h ^= h >> 29U;
+  return (h != 0) ? h : 1;
+}
+
+/// Arguments stored with their own value, the rest of them are stored as their
+/// formatted string.
+template <typename T>
+struct is_native_arg
+  : std::integral_constant<bool,
+                           std::is_arithmetic<T>::value || std::is_enum<T>::value ||
+                               std::is_same<T, std::nullptr_t>::value || std::is_same<T, const char*>::value ||
+                               std::is_same<T, char*>::value || std::is_same<T, std::string>::value ||
+                               std::is_same<T, fmt::string_view>::value ||
+                               (std::is_pointer<T>::value && std::is_void<typename std::remove_pointer<T>::type>::value)> {
+};
+
+template <typename T, typename std::enable_if<is_native_arg<typename std::decay<T>::type>::value, int>::type = 0>
+const T& to_native_arg(const T& arg)
+{
+  return arg;
+}
+
+template <typename T, typename std::enable_if<!is_native_arg<typename std::decay<T>::type>::value, int>::type = 0>
+std::string to_native_arg(const T& arg)
+{
+  return fmt::format("{}", arg);
+}
+
+template <typename V>
+uint8_t* put_arg(uint8_t* p, arg_type type, V value)
+{
+  *p++ = static_cast<uint8_t>(type);
+  std::memcpy(p, &value, sizeof(V));
+  return p + sizeof(V);
+}
+
+inline uint8_t* put_string_arg(uint8_t* p, const char* str, uint32_t len)
+{
+  *p++ = static_cast<uint8_t>(arg_type::str);
+  std::memcpy(p, &len, sizeof(len));
+  std::memcpy(p + sizeof(len), str, len);
+  return p + sizeof(len) + len;
+}
+
+/// Returns the size of the encoded argument.
+template <typename T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+size_t arg_size(T)
+{
+  return 1 + ((std::is_same<T, bool>::value || std::is_same<T, char>::value) ? 1 : (sizeof(T) <= 4 ? 4 : 8));
+}
+template <typename T, typename std::enable_if<std::is_floating_point<T>::value, int>::type = 0>
+size_t arg_size(T)
+{
+  return 1 + sizeof(double);
+}
+template <typename T, typename std::enable_if<std::is_enum<T>::value, int>::type = 0>
+size_t arg_size(T value)
+{
+  return arg_size(static_cast<typename std::underlying_type<T>::type>(value));
+}
+inline size_t arg_size(const void*)
+{
+  return 1 + sizeof(uint64_t);
+}
+inline size_t arg_size(std::nullptr_t)
+{
+  return 1 + sizeof(uint64_t);
+}
+inline size_t arg_size(const char* str)
+{
+  return 1 + sizeof(uint32_t) + ((str != nullptr) ? std::strlen(str) : sizeof("(null)") - 1);
+}
+inline size_t arg_size(fmt::string_view str)
+{
+  return 1 + sizeof(uint32_t) + str.size();
+}
+inline size_t arg_size(const std::string& str)
+{
+  return 1 + sizeof(uint32_t) + str.size();
+}
+
+/// Encodes the argument and returns the position following it.
+template <typename T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+uint8_t* encode_arg(uint8_t* p, T value)
+{
+  if (std::is_same<T, bool>::value) {
+    return put_arg(p, arg_type::boolean, static_cast<uint8_t>(value));
+  }
+  if (std::is_same<T, char>::value) {
+    return put_arg(p, arg_type::chr, static_cast<char>(value));
+  }
+  if (sizeof(T) <= 4) {
+    return std::is_signed<T>::value ? put_arg(p, arg_type::i32, static_cast<int32_t>(value))
+                                    : put_arg(p, arg_type::u32, static_cast<uint32_t>(value));
+  }
+  return std::is_signed<T>::value ? put_arg(p, arg_type::i64, static_cast<int64_t>(value))
+                                  : put_arg(p, arg_type::u64, static_cast<uint64_t>(value));
+}
+template <typename T, typename std::enable_if<std::is_floating_point<T>::value, int>::type = 0>
+uint8_t* encode_arg(uint8_t* p, T value)
+{
+  return put_arg(p, arg_type::dbl, static_cast<double>(value));
+}
+template <typename T, typename std::enable_if<std::is_enum<T>::value, int>::type = 0>
+uint8_t* encode_arg(uint8_t* p, T value)
+{
+  return encode_arg(p, static_cast<typename std::underlying_type<T>::type>(value));
+}
+inline uint8_t* encode_arg(uint8_t* p, const void* ptr)
+{
+  return put_arg(p, arg_type::ptr, reinterpret_cast<uint64_t>(ptr));
+}
+inline uint8_t* encode_arg(uint8_t* p, std::nullptr_t)
+{
+  return put_arg(p, arg_type::ptr, uint64_t(0));
+}
+inline uint8_t* encode_arg(uint8_t* p, const char* str)
+{
+  // Same output as the printf formatting of null strings.
+  if (str == nullptr) {
+    return put_string_arg(p, "(null)", sizeof("(null)") - 1);
+  }
+  return put_string_arg(p, str, std::strlen(str));
+}
+inline uint8_t* encode_arg(uint8_t* p, fmt::string_view str)
+{
+  return put_string_arg(p, str.data(), str.size());
+}
+inline uint8_t* encode_arg(uint8_t* p, const std::string& str)
+{
+  return put_string_arg(p, str.data(), str.size());
+}
+
+} // namespace binary_log
+
+/// Producer side of the binary logs. Each thread writing log entries gets its
+/// own lock-free ring, so the log entries are encoded without any locking and
+/// formatted offline. The owner of the writer drains the rings with
+/// for_each_ring().
+/// Entries that do not fit in the ring of their thread are discarded.
+/// NOTE: Thread safe class.
+class binary_log_writer
+{
+  /// Number of string ids remembered by each thread, the definitions of
+  /// forgotten strings are just written again.
+  static constexpr size_t string_cache_size = 512;
+
+  struct thread_buffer {
+    explicit thread_buffer(size_t ring_size) : ring(ring_size) {}
+
+    byte_ring                               ring;
+    std::array<uint64_t, string_cache_size> known_strings = {};
+    std::atomic<uint64_t>                   nof_dropped{0};
+    std::thread::id                         owner = std::this_thread::get_id();
+  };
+
+public:
+  /// Creates a writer whose threads get a ring of ring_size bytes.
+  explicit binary_log_writer(size_t ring_size) : ring_size(ring_size), writer_id(next_writer_id()) {}
+
+  binary_log_writer(const binary_log_writer&) = delete;
+  binary_log_writer& operator=(const binary_log_writer&) = delete;
+
+  /// Encodes a log entry into the ring of the calling thread.
+  template <typename... Args>
+  void write_entry(std::chrono::high_resolution_clock::time_point tp,
+                   log_context                                    ctx,
+                   const std::string&                             name,
+                   char                                           tag,
+                   const uint8_t*                                 hex,
+                   size_t                                         hex_len,
+                   const char*                                    fmtstr,
+                   const Args&... args)
+  {
+    write_native_entry(tp, ctx, name, tag, hex, hex_len, fmtstr, binary_log::to_native_arg(args)...);
+  }
+
+  /// Writes a text record, already formatted, into the ring of the calling
+  /// thread.
+  void write_text(const char* text, size_t len)
+  {
+    thread_buffer& tb = get_thread_buffer();
+    uint8_t*       p  = tb.ring.reserve(1 + len);
+    if (!p) {
+      drop(tb);
+      return;
+    }
+    *p = static_cast<uint8_t>(binary_log::record_type::text);
+    std::memcpy(p + 1, text, len);
+    tb.ring.commit();
+  }
+
+  /// Calls f(byte_ring& ring) for the ring of each thread. Only one thread may
+  /// consume the rings at a time.
+  template <typename F>
+  void for_each_ring(F&& f)
+  {
+    scoped_lock lock(m);
+    for (auto& tb : buffers) {
+      f(tb->ring);
+    }
+  }
+
+  /// Returns the number of entries discarded because their ring was full.
+  uint64_t get_nof_dropped() const
+  {
+    scoped_lock lock(m);
+    uint64_t    count = 0;
+    for (const auto& tb : buffers) {
+      count += tb->nof_dropped.load(std::memory_order_relaxed);
+    }
+    return count;
+  }
+
+private:
+  template <typename... Args>
+  void write_native_entry(std::chrono::high_resolution_clock::time_point tp,
+                          log_context                                    ctx,
+                          const std::string&                             name,
+                          char                                           tag,
+                          const uint8_t*                                 hex,
+                          size_t                                         hex_len,
+                          const char*                                    fmtstr,
+                          const Args&... args)
+  {
+    static_assert(sizeof...(Args) <= binary_log::max_nof_args, "Too many log arguments");
+
+    thread_buffer& tb = get_thread_buffer();
+    size_t   fmt_len = std::strlen(fmtstr);
+    uint64_t fmt_id  = binary_log::string_id(fmtstr, fmt_len);
+    uint64_t name_id = binary_log::string_id(name.data(), name.size());
+    if (!define_string(tb, fmt_id, fmtstr, fmt_len) || !define_string(tb, name_id, name.data(), name.size())) {
+      drop(tb);
+      return;
+    }
+
+    size_t args_size = 0;
+    (void)std::initializer_list<int>{(args_size += binary_log::arg_size(args), 0)...};
+
+    uint8_t* p = tb.ring.reserve(1 + sizeof(binary_log::entry_header) + hex_len + args_size);
+    if (!p) {
+      drop(tb);
+      return;
+    }
+
+    binary_log::entry_header header = {};
+    header.timestamp                = tp.time_since_epoch().count();
+    header.fmt_id                   = fmt_id;
+    header.name_id                  = name_id;
+    header.ctx_value                = ctx.value;
+    header.hex_len                  = hex_len;
+    header.ctx_enabled              = ctx.enabled;
+    header.tag                      = tag;
+    header.nof_args                 = sizeof...(Args);
+
+    *p++ = static_cast<uint8_t>(binary_log::record_type::entry);
+    std::memcpy(p, &header, sizeof(header));
+    p += sizeof(header);
+    if (hex_len) {
+      std::memcpy(p, hex, hex_len);
+      p += hex_len;
+    }
+    (void)std::initializer_list<int>{(p = binary_log::encode_arg(p, args), 0)...};
+
+    tb.ring.commit();
+  }
+
+  /// Writes the definition of a string the first time the calling thread
+  /// references it. Returns false when there is no room in the ring.
+  bool define_string(thread_buffer& tb, uint64_t id, const char* str, size_t len)
+  {
+    uint64_t& slot = tb.known_strings[(id * 0x9E3779B97F4A7C15ULL) >> 55U];
+    if (slot == id) {
+      return true;
+    }
+
+    uint8_t* p = tb.ring.reserve(1 + sizeof(id) + len);
+    if (!p) {
+      return false;
+    }
+    *p = static_cast<uint8_t>(binary_log::record_type::string_def);
+    std::memcpy(p + 1, &id, sizeof(id));
+    std::memcpy(p + 1 + sizeof(id), str, len);
+    tb.ring.commit();
+    slot = id;
+
+    return true;
+  }
+
+  static void drop(thread_buffer& tb)
+  {
+    tb.nof_dropped.store(tb.nof_dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  }
+
+  /// Returns the buffer of the calling thread, creating it on its first call.
+  thread_buffer& get_thread_buffer()
+  {
+    struct cache_entry {
+      uint32_t       writer_id;
+      thread_buffer* buffer;
+    };
+    static thread_local std::array<cache_entry, 4> cache = {};
+
+    cache_entry& entry = cache[writer_id % cache.size()];
+    if (entry.writer_id == writer_id) {
+      return *entry.buffer;
+    }
+
+    // The entry may have been taken by another writer, look for the buffer of
+    // this thread before creating a new one.
+    scoped_lock lock(m);
+    auto        it = std::find_if(buffers.begin(), buffers.end(), [](const std::unique_ptr<thread_buffer>& tb) {
+      return tb->owner == std::this_thread::get_id();
+    });
+    if (it == buffers.end()) {
+      buffers.emplace_back(new thread_buffer(ring_size));
+      it = buffers.end() - 1;
+    }
+    entry = {writer_id, it->get()};
+
+    return *entry.buffer;
+  }
+
+  static uint32_t next_writer_id()
+  {
+    static std::atomic<uint32_t> counter{0};
+    return ++counter;
+  }
+
+private:
+  const size_t                                ring_size;
+  const uint32_t                              writer_id;
+  mutable mutex                               m;
+  std::vector<std::unique_ptr<thread_buffer> > buffers;
+};
+
+} // namespace detail
+
+} // namespace srslog
+
+#endif // SRSLOG_DETAIL_BINARY_LOG_WRITER_H
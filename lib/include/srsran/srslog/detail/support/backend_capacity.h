@@ -22,9 +22,10 @@
 #ifndef SRSLOG_DETAIL_SUPPORT_BACKEND_CAPACITY_H
 #define SRSLOG_DETAIL_SUPPORT_BACKEND_CAPACITY_H
 
-/// Take this default value if users did not specify any custom size.
+/// Capacity of the log entry queue of each logging thread. Take this default
+/// value if users did not specify any custom size.
 #ifndef SRSLOG_QUEUE_CAPACITY
-#define SRSLOG_QUEUE_CAPACITY 8192
+#define SRSLOG_QUEUE_CAPACITY 4096
 #endif
 
 #endif // SRSLOG_DETAIL_SUPPORT_BACKEND_CAPACITY_H
@@ -0,0 +1,160 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#ifndef SRSLOG_DETAIL_SUPPORT_BYTE_RING_H
+#define SRSLOG_DETAIL_SUPPORT_BYTE_RING_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+namespace srslog {
+
+namespace detail {
+
+/// Lock-free single producer single consumer ring of variable sized records.
+/// Each record is stored contiguously, prefixed by its size. When a record does
+/// not fit in the space left at the end of the buffer, the producer fills it
+/// with a padding marker and writes the record at the beginning.
+class byte_ring
+{
+  static constexpr uint32_t padding_marker = UINT32_MAX;
+  static constexpr size_t   header_size    = sizeof(uint32_t);
+
+public:
+  /// The capacity is rounded up to a power of two.
+  explicit byte_ring(size_t min_capacity) : capacity(round_up_pow2(min_capacity)), buffer(new uint8_t[capacity]) {}
+
+  byte_ring(const byte_ring&) = delete;
+  byte_ring& operator=(const byte_ring&) = delete;
+
+  /// Producer side: returns a pointer to the storage of a new record of the
+  /// specified size, or nullptr when there is no room for it. The record is
+  /// made visible to the consumer by commit().
+  uint8_t* reserve(uint32_t size)
+  {
+    uint64_t total      = header_size + size;
+    uint64_t pos        = write_pos;
+    size_t   offset     = pos & (capacity - 1);
+    size_t   contiguous = capacity - offset;
+    uint64_t skip       = (contiguous < total) ? contiguous : 0;
+
+    if (total > capacity) {
+      return nullptr;
+    }
+    if (pos + skip + total - cached_read_pos > capacity) {
+      cached_read_pos = read_pos.load(std::memory_order_acquire);
+      if (pos + skip + total - cached_read_pos > capacity) {
+        return nullptr;
+      }
+    }
+
+    if (skip) {
+      if (contiguous >= header_size) {
+        uint32_t marker = padding_marker;
+        std::memcpy(&buffer[offset], &marker, header_size);
+      }
+      pos += skip;
+      offset = 0;
+    }
+    std::memcpy(&buffer[offset], &size, header_size);
+    pending_write_pos = pos + total;
+
+    return &buffer[offset + header_size];
+  }
+
+  /// Producer side: publishes the record returned by the last call to
+  /// reserve().
+  void commit()
+  {
+    write_pos = pending_write_pos;
+    published_write_pos.store(write_pos, std::memory_order_release);
+  }
+
+  /// Consumer side: calls f(const uint8_t* data, uint32_t size) for each
+  /// committed record, in order, and releases them. Returns the number of
+  /// records consumed.
+  template <typename F>
+  size_t consume(F&& f)
+  {
+    uint64_t pos   = read_pos.load(std::memory_order_relaxed);
+    uint64_t end   = published_write_pos.load(std::memory_order_acquire);
+    size_t   count = 0;
+
+    while (pos != end) {
+      size_t offset     = pos & (capacity - 1);
+      size_t contiguous = capacity - offset;
+      if (contiguous < header_size) {
+        pos += contiguous;
+        continue;
+      }
+      uint32_t size;
+      std::memcpy(&size, &buffer[offset], header_size);
+      if (size == padding_marker) {
+        pos += contiguous;
+        continue;
+      }
+      f(&buffer[offset + header_size], size);
+      pos += header_size + size;
+      ++count;
+    }
+    read_pos.store(pos, std::memory_order_release);
+
+    return count;
+  }
+
+  /// Returns the size of the ring in bytes.
+  size_t get_capacity() const { return capacity; }
+
+private:
+  static size_t round_up_pow2(size_t n)
+  {
+    size_t result = 64;
+    while (result < n) {
+      result <<= 1;
+    }
+    return result;
+  }
+
+private:
+  // The positions are padded instead of aligned, so that the ring can be
+  // allocated with new before C++17.
+  const size_t               capacity;
+  std::unique_ptr<uint8_t[]> buffer;
+  uint8_t                    padding0[64];
+  // Written by the producer.
+  std::atomic<uint64_t> published_write_pos{0};
+  uint64_t              write_pos         = 0;
+  uint64_t              pending_write_pos = 0;
+  uint64_t              cached_read_pos   = 0;
+  uint8_t               padding1[64];
+  // Written by the consumer.
+  std::atomic<uint64_t> read_pos{0};
+  uint8_t               padding2[64];
+};
+
+} // namespace detail
+
+} // namespace srslog
+
+#endif // SRSLOG_DETAIL_SUPPORT_BYTE_RING_H
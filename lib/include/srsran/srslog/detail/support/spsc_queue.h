@@ -0,0 +1,126 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#ifndef SRSLOG_DETAIL_SUPPORT_SPSC_QUEUE_H
+#define SRSLOG_DETAIL_SUPPORT_SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace srslog {
+
+namespace detail {
+
+/// Lock-free bounded queue for a single producer and a single consumer thread.
+/// Elements are stored in a preallocated buffer and moved in and out of it, so
+/// no memory is allocated after construction.
+template <typename T>
+class spsc_queue
+{
+public:
+  /// The capacity is rounded up to a power of two.
+  explicit spsc_queue(size_t min_capacity) : capacity(round_up_pow2(min_capacity)), buffer(new T[capacity]) {}
+
+  spsc_queue(const spsc_queue&) = delete;
+  spsc_queue& operator=(const spsc_queue&) = delete;
+
+  /// Producer side: inserts a new element into the back of the queue. Returns
+  /// false when the queue is full, in which case the element is not moved,
+  /// otherwise true.
+  bool push(T&& value)
+  {
+    uint64_t pos = write_pos.load(std::memory_order_relaxed);
+    if (pos - cached_read_pos == capacity) {
+      cached_read_pos = read_pos.load(std::memory_order_acquire);
+      if (pos - cached_read_pos == capacity) {
+        return false;
+      }
+    }
+    buffer[pos & (capacity - 1)] = std::move(value);
+    write_pos.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// Consumer side: returns a pointer to the front element, or nullptr when
+  /// the queue is empty. The element remains in the queue until pop() is
+  /// called.
+  T* front()
+  {
+    uint64_t pos = read_pos.load(std::memory_order_relaxed);
+    if (pos == cached_write_pos) {
+      cached_write_pos = write_pos.load(std::memory_order_acquire);
+      if (pos == cached_write_pos) {
+        return nullptr;
+      }
+    }
+    return &buffer[pos & (capacity - 1)];
+  }
+
+  /// Consumer side: removes the front element.
+  /// NOTE: The queue must not be empty.
+  void pop() { read_pos.store(read_pos.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+  /// Returns the number of elements in the queue. The value may be outdated
+  /// when it is called from a thread other than the producer and consumer.
+  size_t size() const
+  {
+    // Load the read position first so that it never exceeds the write position.
+    uint64_t pos = read_pos.load(std::memory_order_acquire);
+    return write_pos.load(std::memory_order_acquire) - pos;
+  }
+
+  /// Capacity of the queue.
+  size_t get_capacity() const { return capacity; }
+
+private:
+  static size_t round_up_pow2(size_t n)
+  {
+    size_t result = 1;
+    while (result < n) {
+      result <<= 1;
+    }
+    return result;
+  }
+
+private:
+  // The positions are padded instead of aligned, so that the queue can be
+  // allocated with new before C++17.
+  const size_t         capacity;
+  std::unique_ptr<T[]> buffer;
+  uint8_t              padding0[64];
+  // Written by the producer.
+  std::atomic<uint64_t> write_pos{0};
+  uint64_t              cached_read_pos = 0;
+  uint8_t               padding1[64];
+  // Written by the consumer.
+  std::atomic<uint64_t> read_pos{0};
+  uint64_t              cached_write_pos = 0;
+  uint8_t               padding2[64];
+};
+
+} // namespace detail
+
+} // namespace srslog
+
+#endif // SRSLOG_DETAIL_SUPPORT_SPSC_QUEUE_H
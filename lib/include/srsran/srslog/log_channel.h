@@ -22,6 +22,7 @@
 #ifndef SRSLOG_LOG_CHANNEL_H
 #define SRSLOG_LOG_CHANNEL_H
 
+#include "srsran/srslog/detail/binary_log_writer.h"
 #include "srsran/srslog/detail/log_backend.h"
 #include "srsran/srslog/detail/log_entry.h"
 #include "srsran/srslog/sink.h"
@@ -66,6 +67,7 @@ public:
     log_name(std::move(config.name)),
     log_tag(config.tag),
     should_print_context(config.should_print_context),
+    binary_writer(s.get_binary_writer()),
     ctx_value(0),
     hex_max_size(0),
     is_enabled(true)
@@ -100,6 +102,19 @@ public:
       return;
     }
 
+    // Binary sinks take the entry unformatted.
+    if (binary_writer) {
+      binary_writer->write_entry(std::chrono::high_resolution_clock::now(),
+                                 {ctx_value, should_print_context},
+                                 log_name,
+                                 log_tag,
+                                 nullptr,
+                                 0,
+                                 fmtstr,
+                                 args...);
+      return;
+    }
+
     // Populate the store with all incoming arguments.
     auto* store = backend.alloc_arg_store();
     if (!store) {
@@ -131,6 +146,24 @@ public:
       return;
     }
 
+    // Calculate the length to capture in the buffer.
+    if (hex_max_size >= 0) {
+      len = std::min<size_t>(len, hex_max_size);
+    }
+
+    // Binary sinks take the entry unformatted.
+    if (binary_writer) {
+      binary_writer->write_entry(std::chrono::high_resolution_clock::now(),
+                                 {ctx_value, should_print_context},
+                                 log_name,
+                                 log_tag,
+                                 buffer,
+                                 len,
+                                 fmtstr,
+                                 args...);
+      return;
+    }
+
     // Populate the store with all incoming arguments.
     auto* store = backend.alloc_arg_store();
     if (!store) {
@@ -138,11 +171,6 @@ public:
     }
     (void)std::initializer_list<int>{(store->push_back(std::forward<Args>(args)), 0)...};
 
-    // Calculate the length to capture in the buffer.
-    if (hex_max_size >= 0) {
-      len = std::min<size_t>(len, hex_max_size);
-    }
-
     // Send the log entry to the backend.
     log_formatter&    formatter = log_sink.get_formatter();
     detail::log_entry entry     = {&log_sink,
@@ -215,15 +243,16 @@ public:
   }
 
 private:
-  const std::string     log_id;
-  sink&                 log_sink;
-  detail::log_backend&  backend;
-  const std::string     log_name;
-  const char            log_tag;
-  const bool            should_print_context;
-  std::atomic<uint32_t> ctx_value;
-  std::atomic<int>      hex_max_size;
-  std::atomic<bool>     is_enabled;
+  const std::string                log_id;
+  sink&                            log_sink;
+  detail::log_backend&             backend;
+  const std::string                log_name;
+  const char                       log_tag;
+  const bool                       should_print_context;
+  detail::binary_log_writer* const binary_writer;
+  std::atomic<uint32_t>            ctx_value;
+  std::atomic<int>                 hex_max_size;
+  std::atomic<bool>                is_enabled;
 };
 
 } // namespace srslog
@@ -22,6 +22,7 @@
 #ifndef SRSLOG_SHARED_TYPES_H
 #define SRSLOG_SHARED_TYPES_H
 
+#include <cstdint>
 #include <functional>
 #include <string>
 
@@ -40,6 +41,28 @@ enum class backend_priority {
   very_high
 };
 
+/// Policies applied when the log entry queue of a thread is full.
+enum class backend_queue_policy {
+  /// New log entries are discarded.
+  drop,
+  /// The logging thread waits until the backend makes room for the entry.
+  block
+};
+
+/// Log backend metrics.
+struct backend_metrics {
+  /// Number of log entries processed by the backend.
+  uint64_t nof_entries;
+  /// Number of log entries discarded because the queue of their thread was
+  /// full.
+  uint64_t nof_dropped_entries;
+  /// Number of log entries that had to wait for room in the queue of their
+  /// thread.
+  uint64_t nof_blocked_entries;
+  /// Number of threads that have logged through the backend.
+  unsigned nof_producers;
+};
+
 /// syslog log local types
 enum class syslog_local_type {
   local0,
@@ -29,6 +29,10 @@
 
 namespace srslog {
 
+namespace detail {
+class binary_log_writer;
+} // namespace detail
+
 /// This interface provides the way to write incoming memory buffers to any kind
 /// of backing store.
 class sink
@@ -51,6 +55,11 @@ public:
   /// Flushes any buffered contents to the backing store.
   virtual detail::error_string flush() = 0;
 
+  /// Returns the writer of the sinks that store the log entries unformatted,
+  /// otherwise nullptr. Log channels write their entries directly into it,
+  /// bypassing the formatting in the backend.
+  virtual detail::binary_log_writer* get_binary_writer() { return nullptr; }
+
 private:
   std::unique_ptr<log_formatter> formatter;
 };
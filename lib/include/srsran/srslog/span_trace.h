@@ -0,0 +1,186 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#ifndef SRSLOG_SPAN_TRACE_H
+#define SRSLOG_SPAN_TRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace srslog {
+
+/// Span tracing records the duration of code regions into a ring owned by the
+/// calling thread, without locks nor system calls, and exports them in the
+/// Chrome trace event JSON format that Perfetto (ui.perfetto.dev) and
+/// chrome://tracing open.
+/// A span may carry a flow id, the viewer then links it with arrows to the
+/// other spans of the same category and id. This allows to follow a TTI or a
+/// packet across threads: trace_span_flow_start() begins a new flow and each
+/// later trace_span_flow() with the same category and id extends it. Objects
+/// whose address is reused, such as pooled buffers, take their flow id from
+/// span_trace_new_flow_id() instead.
+/// As for the event traces, the macros below compile to nothing unless the
+/// ENABLE_SRSLOG_EVENT_TRACE macro symbol is defined. Categories and names
+/// must be string literals as only their addresses are stored.
+
+/// Initializes span tracing. Each thread keeps its last nof_spans spans, which
+/// are written into the specified filename by span_trace_flush(). At most
+/// max_snapshots snapshots are written by trace_span_snapshot().
+/// Returns true on success, otherwise false.
+bool span_trace_init(const std::string& filename, std::size_t nof_spans = 16384, uint32_t max_snapshots = 8);
+
+/// Writes the spans recorded so far into the trace file.
+/// Returns true on success, otherwise false.
+bool span_trace_flush();
+
+/// Writes the spans recorded so far into the specified file.
+/// Returns true on success, otherwise false.
+bool span_trace_flush(const std::string& filename);
+
+/// Requests a snapshot of the spans recorded so far, written into the trace
+/// file name followed by the snapshot number. It is safe to call from real
+/// time threads as the file is written by a background thread. Requests are
+/// ignored while a snapshot is pending or after max_snapshots of them.
+void span_trace_snapshot();
+
+/// Returns a flow id that no other call returns, never 0.
+uint64_t span_trace_new_flow_id();
+
+#ifdef ENABLE_SRSLOG_EVENT_TRACE
+
+#define SRSLOG_SPAN_COMBINE1(X, Y) X##Y
+#define SRSLOG_SPAN_COMBINE(X, Y) SRSLOG_SPAN_COMBINE1(X, Y)
+
+/// Traces the enclosing scope.
+#define trace_span(C, N)                                                                                               \
+  srslog::detail::scoped_span SRSLOG_SPAN_COMBINE(scoped_span, __LINE__)(C, N, 0, srslog::detail::span_kind::plain)
+
+/// Traces the enclosing scope and starts a new flow with the specified id.
+#define trace_span_flow_start(C, N, ID)                                                                                \
+  srslog::detail::scoped_span SRSLOG_SPAN_COMBINE(scoped_span, __LINE__)(                                              \
+      C, N, ID, srslog::detail::span_kind::flow_start)
+
+/// Traces the enclosing scope as the next step of the flow with the specified id.
+#define trace_span_flow(C, N, ID)                                                                                      \
+  srslog::detail::scoped_span SRSLOG_SPAN_COMBINE(scoped_span, __LINE__)(C, N, ID, srslog::detail::span_kind::flow_step)
+
+/// Marks a point in time, e.g. a missed deadline.
+#define trace_span_instant(C, N, ID) srslog::detail::record_instant(C, N, ID)
+
+/// Requests a snapshot of the recorded spans.
+#define trace_span_snapshot() srslog::span_trace_snapshot()
+
+/// Assigns a new flow id to the specified variable when it does not hold one,
+/// i.e. it is 0.
+#define trace_span_stamp_flow(ID)                                                                                      \
+  do {                                                                                                                 \
+    if ((ID) == 0) {                                                                                                   \
+      (ID) = srslog::span_trace_new_flow_id();                                                                         \
+    }                                                                                                                  \
+  } while (0)
+
+#else
+
+/// No-ops.
+#define trace_span(C, N)
+#define trace_span_flow_start(C, N, ID)
+#define trace_span_flow(C, N, ID)
+#define trace_span_instant(C, N, ID)
+#define trace_span_snapshot()
+#define trace_span_stamp_flow(ID)
+
+#endif
+
+namespace detail {
+
+enum class span_kind : uint8_t { plain, flow_start, flow_step, instant };
+
+/// True while span tracing is initialized.
+extern std::atomic<bool> span_trace_enabled;
+
+/// Returns the current time in ticks of the span clock. The TSC is used when
+/// available, the tracer converts the ticks into time when exporting them.
+inline uint64_t span_clock_now()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#elif defined(__aarch64__)
+  uint64_t ticks;
+  asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+  return ticks;
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+#endif
+}
+
+/// Stores a span into the ring of the calling thread.
+void record_span(const char* category, const char* name, uint64_t id, span_kind kind, uint64_t start, uint64_t end);
+
+inline void record_instant(const char* category, const char* name, uint64_t id)
+{
+  if (span_trace_enabled.load(std::memory_order_relaxed)) {
+    uint64_t now = span_clock_now();
+    record_span(category, name, id, span_kind::instant, now, now);
+  }
+}
+
+/// Scoped type object for implementing a span.
+class scoped_span
+{
+public:
+  scoped_span(const char* category, const char* name, uint64_t id, span_kind kind) :
+    category(category),
+    name(name),
+    id(id),
+    kind(kind),
+    start(span_trace_enabled.load(std::memory_order_relaxed) ? span_clock_now() : 0)
+  {}
+
+  scoped_span(const scoped_span&) = delete;
+  scoped_span& operator=(const scoped_span&) = delete;
+
+  ~scoped_span()
+  {
+    if (start != 0) {
+      record_span(category, name, id, kind, start, span_clock_now());
+    }
+  }
+
+private:
+  const char* const category;
+  const char* const name;
+  const uint64_t    id;
+  const span_kind   kind;
+  const uint64_t    start;
+};
+
+} // namespace detail
+
+} // namespace srslog
+
+#endif // SRSLOG_SPAN_TRACE_H
@@ -195,6 +195,30 @@ sink& fetch_file_sink(const std::string&             path,
                       bool                           force_flush = false,
                       std::unique_ptr<log_formatter> f           = get_default_log_formatter());
 
+/// Returns an instance of a sink that writes into a file in the specified path
+/// without blocking the backend thread on the disk. The formatted entries are
+/// collected into buffers of buffer_size bytes that are written in the
+/// background with io_uring, or with a dedicated thread when io_uring is not
+/// available.
+/// Specifying a max_size value different to zero will make the sink create a
+/// new file each time the current file exceeds this value. The units of
+/// max_size are bytes.
+/// NOTE: Any '#' characters in the path will get removed.
+sink& fetch_async_file_sink(const std::string&             path,
+                            size_t                         max_size    = 0,
+                            size_t                         buffer_size = 1024 * 1024,
+                            std::unique_ptr<log_formatter> f           = get_default_log_formatter());
+
+/// Returns an instance of a sink that writes the log entries unformatted into
+/// a binary file in the specified path, to be converted to text offline with
+/// the srslog_decoder tool. Each logging thread encodes its entries into its
+/// own ring of ring_size bytes, entries that do not fit are discarded.
+/// Specifying a max_size value different to zero will make the sink create a
+/// new file each time the current file exceeds this value. The units of
+/// max_size are bytes.
+/// NOTE: Any '#' characters in the path will get removed.
+sink& fetch_binary_file_sink(const std::string& path, size_t max_size = 0, size_t ring_size = 1024 * 1024);
+
 /// Returns an instance of a sink that writes into syslog
 /// preamble: The string  prepended to every message, If ident is "", the program name is used.
 /// log_local: custom unused facilities that syslog provides which can be used by the user
@@ -254,6 +278,15 @@ void flush();
 /// NOTE: This function should be called before init() and is NOT thread safe.
 void set_error_handler(error_handler handler);
 
+/// Sets the policy applied when the log entry queue of a thread is full. Each
+/// thread logs into its own queue, the default policy discards new entries
+/// when it is full.
+void set_backend_queue_policy(backend_queue_policy policy);
+
+/// Returns the metrics of the backend, including the number of discarded log
+/// entries.
+backend_metrics get_backend_metrics();
+
 } // namespace srslog
 
 #endif // SRSLOG_SRSLOG_H
@@ -24,8 +24,10 @@
 
 #ifdef __cplusplus
 #include <cstddef>
+#include <cstdio>
 #else
 #include <stddef.h>
+#include <stdio.h>
 #endif
 
 #ifdef __cplusplus
@@ -162,6 +164,26 @@ srslog_sink* srslog_fetch_stderr_sink(void);
  */
 srslog_sink* srslog_fetch_file_sink(const char* path, size_t max_size, srslog_bool force_flush);
 
+/**
+ * Opens a file in the specified path that is written in the background, like
+ * the async file sink does, and returns an unbuffered stream to write into it.
+ * Returns NULL on error. The stream must be closed with fclose(), which waits
+ * for the pending writes.
+ * Every file starts with the header_len bytes of header. Specifying a max_size
+ * value different to zero will make the stream create a new file each time the
+ * current file exceeds this value. The data of a single write call is never
+ * split between two files. The units of max_size are bytes.
+ */
+FILE* srslog_open_async_file(const char* path, size_t max_size, const void* header, size_t header_len);
+
+/**
+ * Like srslog_open_async_file(), but the data is compressed into a zstd stream
+ * by a dedicated thread with the specified compression level. Each file is a
+ * single zstd frame, and max_size applies to the uncompressed data.
+ * Returns NULL when the library was built without zstd support.
+ */
+FILE* srslog_open_compressed_file(const char* path, size_t max_size, const void* header, size_t header_len, int level);
+
 #ifdef __cplusplus
 }
 #endif
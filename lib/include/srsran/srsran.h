@@ -38,6 +38,7 @@ extern "C" {
 #include "srsran/phy/utils/cexptab.h"
 #include "srsran/phy/utils/convolution.h"
 #include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/mem_arena.h"
 #include "srsran/phy/utils/ringbuffer.h"
 #include "srsran/phy/utils/vector.h"
 
@@ -119,6 +120,7 @@ extern "C" {
 #include "srsran/phy/phch/uci_nr.h"
 
 #include "srsran/phy/ue/ue_cell_search.h"
+#include "srsran/phy/ue/ue_cell_search_wb.h"
 #include "srsran/phy/ue/ue_dl.h"
 #include "srsran/phy/ue/ue_dl_nr.h"
 #include "srsran/phy/ue/ue_mib.h"
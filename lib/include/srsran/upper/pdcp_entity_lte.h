@@ -24,6 +24,7 @@
 
 #include "srsran/adt/circular_array.h"
 #include "srsran/common/buffer_pool.h"
+#include "srsran/common/byte_buffer_chain.h"
 #include "srsran/common/common.h"
 #include "srsran/common/security.h"
 #include "srsran/common/threads.h"
@@ -51,7 +52,7 @@ public:
   bool            has_sdu(uint32_t sn) const
   {
     assert(sn != invalid_sn && "provided PDCP SN is invalid");
-    return sdus[sn].sdu != nullptr and sdus[sn].sdu->md.pdcp_sn == sn;
+    return sdus[sn].sdu.md.pdcp_sn == sn;
   }
   // Getter for the number of discard timers. Used for debugging.
   size_t nof_discard_timers() const;
@@ -61,7 +62,7 @@ public:
                uint32_t                              discard_timeout,
                srsran::move_callback<void(uint32_t)> callback);
 
-  unique_byte_buffer_t& operator[](uint32_t sn)
+  byte_buffer_chain& operator[](uint32_t sn)
   {
     assert(has_sdu(sn));
     return sdus[sn].sdu;
@@ -86,9 +87,11 @@ private:
 
   uint32_t increment_sn(uint32_t sn) { return (sn + 1) % sn_mod; }
 
+  // The SDUs are kept in chains of small segments, so a 40 B SDU doesn't hold a full byte_buffer_t until it is ACKed.
+  // Free entries have an invalid SN.
   struct sdu_data {
-    srsran::unique_byte_buffer_t sdu;
-    srsran::unique_timer         discard_timer;
+    srsran::byte_buffer_chain sdu;
+    srsran::unique_timer      discard_timer;
   };
 
   uint32_t                                   count = 0;
@@ -0,0 +1,327 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/byte_buffer_chain.h"
+#include "srsran/adt/pool/fixed_size_pool.h"
+#include <algorithm>
+#include <limits>
+
+namespace srsran {
+
+static_assert(sizeof(byte_buffer_segment) <= byte_buffer_segment::block_size, "Segment does not fit its memory block");
+static_assert(byte_buffer_segment::capacity <= std::numeric_limits<uint16_t>::max(), "Segment offsets are 16-bit");
+
+namespace {
+
+using byte_buffer_segment_pool = concurrent_fixed_memory_pool<byte_buffer_segment::block_size>;
+
+/// The pool holds as many bytes as 1024 byte_buffer_t, in blocks 19 times smaller
+const size_t segment_pool_size = 16384;
+
+byte_buffer_segment_pool* get_segment_pool()
+{
+  return byte_buffer_segment_pool::get_instance(segment_pool_size);
+}
+
+} // namespace
+
+byte_buffer_segment* byte_buffer_segment::make() noexcept
+{
+  void* block = get_segment_pool()->allocate_node(sizeof(byte_buffer_segment));
+  if (block == nullptr) {
+    return nullptr;
+  }
+  // Default-initialized, the payload is not zeroed
+  return new (block) byte_buffer_segment;
+}
+
+void byte_buffer_segment::release(byte_buffer_segment* seg) noexcept
+{
+  // The last owner skips the atomic decrement, no other chain can take a reference to the segment
+  if (seg->ref_count.load(std::memory_order_acquire) == 1 or
+      seg->ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    seg->~byte_buffer_segment();
+    get_segment_pool()->deallocate_node(seg);
+  }
+}
+
+byte_buffer_chain::byte_buffer_chain(byte_buffer_chain&& other) noexcept :
+  md(other.md), segments(std::move(other.segments)), nof_bytes(other.nof_bytes)
+{
+  other.nof_bytes = 0;
+}
+
+byte_buffer_chain& byte_buffer_chain::operator=(byte_buffer_chain&& other) noexcept
+{
+  if (this != &other) {
+    clear();
+    md              = other.md;
+    segments        = std::move(other.segments);
+    nof_bytes       = other.nof_bytes;
+    other.nof_bytes = 0;
+  }
+  return *this;
+}
+
+uint8_t byte_buffer_chain::operator[](uint32_t idx) const
+{
+  srsran_assert(idx < nof_bytes, "Index %d is out of bounds of byte_buffer_chain of %d bytes", idx, nof_bytes);
+  for (const segment_ref& ref : segments) {
+    if (idx < ref.length()) {
+      return ref.seg->payload[ref.begin + idx];
+    }
+    idx -= ref.length();
+  }
+  return 0;
+}
+
+void byte_buffer_chain::clear()
+{
+  for (segment_ref& ref : segments) {
+    byte_buffer_segment::release(ref.seg);
+  }
+  segments.clear();
+  nof_bytes = 0;
+  md        = {};
+}
+
+bool byte_buffer_chain::append(const_byte_span bytes)
+{
+  uint32_t offset = nof_bytes;
+  if (not resize(offset + bytes.size())) {
+    return false;
+  }
+  copy_from(bytes, offset);
+  return true;
+}
+
+bool byte_buffer_chain::append(const byte_buffer_chain& other)
+{
+  if (other.empty()) {
+    return true;
+  }
+  bool contiguous = not segments.empty() and segments.back().seg == other.segments.front().seg and
+                    segments.back().end == other.segments.front().begin;
+  if (segments.size() + other.segments.size() - (contiguous ? 1 : 0) > max_segments) {
+    return false;
+  }
+
+  // Copy the references first, other may be this chain
+  bounded_vector<segment_ref, max_segments> refs(other.segments);
+  for (const segment_ref& ref : refs) {
+    push_back_shared(ref);
+  }
+  return true;
+}
+
+bool byte_buffer_chain::append(byte_buffer_chain&& other)
+{
+  if (&other == this) {
+    return append(static_cast<const byte_buffer_chain&>(other));
+  }
+  if (not append(static_cast<const byte_buffer_chain&>(other))) {
+    return false;
+  }
+  other.clear();
+  return true;
+}
+
+void byte_buffer_chain::push_back_shared(const segment_ref& ref)
+{
+  if (not segments.empty() and segments.back().seg == ref.seg and segments.back().end == ref.begin) {
+    // Slices of the same segment that are rejoined
+    segments.back().end = ref.end;
+  } else {
+    byte_buffer_segment::acquire(ref.seg);
+    segments.push_back(ref);
+  }
+  nof_bytes += ref.length();
+}
+
+bool byte_buffer_chain::prepend(const_byte_span bytes)
+{
+  uint32_t remaining = bytes.size();
+
+  // Headroom of the first segment
+  if (remaining > 0 and not segments.empty() and segments.front().is_writable()) {
+    segment_ref& head = segments.front();
+    uint32_t     n    = std::min(remaining, static_cast<uint32_t>(head.begin));
+    head.begin -= n;
+    remaining -= n;
+    memcpy(&head.seg->payload[head.begin], bytes.data() + remaining, n);
+    nof_bytes += n;
+  }
+
+  // New segments, filled from the end to leave headroom for the next headers
+  while (remaining > 0) {
+    byte_buffer_segment* seg = segments.full() ? nullptr : byte_buffer_segment::make();
+    if (seg == nullptr) {
+      trim_head(bytes.size() - remaining);
+      return false;
+    }
+    uint32_t n     = std::min(remaining, byte_buffer_segment::capacity);
+    uint16_t begin = byte_buffer_segment::capacity - n;
+    remaining -= n;
+    memcpy(&seg->payload[begin], bytes.data() + remaining, n);
+    segments.push_back(segment_ref{seg, begin, static_cast<uint16_t>(byte_buffer_segment::capacity)});
+    std::rotate(segments.begin(), segments.end() - 1, segments.end());
+    nof_bytes += n;
+  }
+  return true;
+}
+
+void byte_buffer_chain::trim_head(uint32_t len)
+{
+  srsran_assert(len <= nof_bytes, "Trimming %d bytes of byte_buffer_chain of %d bytes", len, nof_bytes);
+  nof_bytes -= len;
+  while (len > 0) {
+    segment_ref& head = segments.front();
+    if (head.length() > len) {
+      head.begin += len;
+      return;
+    }
+    len -= head.length();
+    byte_buffer_segment::release(head.seg);
+    segments.erase(segments.begin());
+  }
+}
+
+void byte_buffer_chain::trim_tail(uint32_t len)
+{
+  srsran_assert(len <= nof_bytes, "Trimming %d bytes of byte_buffer_chain of %d bytes", len, nof_bytes);
+  nof_bytes -= len;
+  while (len > 0) {
+    segment_ref& tail = segments.back();
+    if (tail.length() > len) {
+      tail.end -= len;
+      return;
+    }
+    len -= tail.length();
+    byte_buffer_segment::release(tail.seg);
+    segments.pop_back();
+  }
+}
+
+bool byte_buffer_chain::resize(uint32_t len)
+{
+  if (len <= nof_bytes) {
+    trim_tail(nof_bytes - len);
+    return true;
+  }
+
+  uint32_t count = 0;
+  while (nof_bytes < len) {
+    // Segments shared with other chains are never written, the bytes after the end of this chain may be in use
+    if (segments.empty() or segments.back().end == byte_buffer_segment::capacity or
+        not segments.back().is_writable()) {
+      byte_buffer_segment* seg = segments.full() ? nullptr : byte_buffer_segment::make();
+      if (seg == nullptr) {
+        trim_tail(count);
+        return false;
+      }
+      uint16_t begin = segments.empty() ? default_headroom : 0;
+      segments.push_back(segment_ref{seg, begin, begin});
+    }
+
+    segment_ref& tail = segments.back();
+    uint32_t     n    = std::min(len - nof_bytes, byte_buffer_segment::capacity - tail.end);
+    tail.end += n;
+    nof_bytes += n;
+    count += n;
+  }
+  return true;
+}
+
+byte_buffer_chain byte_buffer_chain::slice(uint32_t offset, uint32_t len) const
+{
+  srsran_assert(offset + len <= nof_bytes,
+                "Slice [%d, %d) is out of bounds of byte_buffer_chain of %d bytes",
+                offset,
+                offset + len,
+                nof_bytes);
+  byte_buffer_chain ret;
+  ret.md = md;
+  for (const segment_ref& ref : segments) {
+    if (len == 0) {
+      break;
+    }
+    if (offset >= ref.length()) {
+      offset -= ref.length();
+      continue;
+    }
+    segment_ref part = ref;
+    part.begin += offset;
+    part.end = part.begin + std::min(len, part.length());
+    ret.push_back_shared(part);
+    len -= part.length();
+    offset = 0;
+  }
+  return ret;
+}
+
+uint32_t byte_buffer_chain::copy_to(byte_span dest, uint32_t offset) const
+{
+  if (offset >= nof_bytes) {
+    return 0;
+  }
+  uint32_t count = std::min(static_cast<uint32_t>(dest.size()), nof_bytes - offset);
+  uint32_t n     = 0;
+  for (const segment_ref& ref : segments) {
+    if (n == count) {
+      break;
+    }
+    if (offset >= ref.length()) {
+      offset -= ref.length();
+      continue;
+    }
+    uint32_t len = std::min(count - n, ref.length() - offset);
+    memcpy(dest.data() + n, &ref.seg->payload[ref.begin + offset], len);
+    n += len;
+    offset = 0;
+  }
+  return count;
+}
+
+uint32_t byte_buffer_chain::copy_from(const_byte_span src, uint32_t offset)
+{
+  if (offset >= nof_bytes) {
+    return 0;
+  }
+  uint32_t count = std::min(static_cast<uint32_t>(src.size()), nof_bytes - offset);
+  uint32_t n     = 0;
+  for (segment_ref& ref : segments) {
+    if (n == count) {
+      break;
+    }
+    if (offset >= ref.length()) {
+      offset -= ref.length();
+      continue;
+    }
+    srsran_assert(ref.is_writable(), "Writing to a segment shared with other byte_buffer_chain");
+    uint32_t len = std::min(count - n, ref.length() - offset);
+    memcpy(&ref.seg->payload[ref.begin + offset], src.data() + n, len);
+    n += len;
+    offset = 0;
+  }
+  return count;
+}
+
+} // namespace srsran
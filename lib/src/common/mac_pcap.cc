@@ -31,7 +31,7 @@ mac_pcap::~mac_pcap()
   close();
 }
 
-uint32_t mac_pcap::open(std::string filename_, uint32_t ue_id_)
+uint32_t mac_pcap::open(std::string filename_, uint32_t ue_id_, int compression_level)
 {
   std::lock_guard<std::mutex> lock(mutex);
   if (pcap_file != nullptr) {
@@ -41,7 +41,7 @@ uint32_t mac_pcap::open(std::string filename_, uint32_t ue_id_)
 
   // set UDP DLT
   dlt       = UDP_DLT;
-  pcap_file = DLT_PCAP_Open(dlt, filename_.c_str());
+  pcap_file = DLT_PCAP_Open_Compressed(dlt, filename_.c_str(), compression_level);
   if (pcap_file == nullptr) {
     logger.error("Couldn't open %s to write PCAP", filename_.c_str());
     return SRSRAN_ERROR;
@@ -86,13 +86,14 @@ uint32_t mac_pcap::close()
 
 void mac_pcap::write_pdu(srsran::mac_pcap_base::pcap_pdu_t& pdu)
 {
-  if (pdu.pdu != nullptr) {
+  if (not pdu.pdu.empty()) {
+    const_byte_span bytes = linearize(pdu.pdu);
     switch (pdu.rat) {
       case srsran_rat_t::lte:
-        LTE_PCAP_MAC_UDP_WritePDU(pcap_file, &pdu.context, pdu.pdu->msg, pdu.pdu->N_bytes);
+        LTE_PCAP_MAC_UDP_WriteTruncatedPDU(pcap_file, &pdu.context, bytes.data(), bytes.size(), pdu.orig_len);
         break;
       case srsran_rat_t::nr:
-        NR_PCAP_MAC_UDP_WritePDU(pcap_file, &pdu.context_nr, pdu.pdu->msg, pdu.pdu->N_bytes);
+        NR_PCAP_MAC_UDP_WriteTruncatedPDU(pcap_file, &pdu.context_nr, bytes.data(), bytes.size(), pdu.orig_len);
         break;
       default:
         logger.error("Error writing PDU to PCAP. Unsupported RAT selected.");
@@ -57,6 +57,11 @@ void mac_pcap_base::set_ue_id(uint16_t ue_id_)
   ue_id = ue_id_;
 }
 
+void mac_pcap_base::set_max_pdu_len(uint32_t max_pdu_len_)
+{
+  max_pdu_len = max_pdu_len_;
+}
+
 void mac_pcap_base::run_thread()
 {
   // blocking write until stopped
@@ -76,6 +81,12 @@ void mac_pcap_base::run_thread()
   }
 }
 
+const_byte_span mac_pcap_base::linearize(const byte_buffer_chain& pdu)
+{
+  uint32_t len = pdu.copy_to(byte_span{write_buffer.data(), write_buffer.size()});
+  return const_byte_span{write_buffer.data(), len};
+}
+
 // Function called from PHY worker context, locking not needed as PDU queue is thread-safe
 void mac_pcap_base::pack_and_queue(uint8_t* payload,
                                    uint32_t payload_len,
@@ -102,17 +113,21 @@ void mac_pcap_base::pack_and_queue(uint8_t* payload,
     pdu.context.sysFrameNumber = (uint16_t)(tti / 10);
     pdu.context.subFrameNumber = (uint16_t)(tti % 10);
 
-    // try to allocate PDU buffer
-    pdu.pdu = srsran::make_byte_buffer();
-    if (pdu.pdu != nullptr && pdu.pdu->get_tailroom() >= payload_len) {
-      // copy payload into PDU buffer
-      memcpy(pdu.pdu->msg, payload, payload_len);
-      pdu.pdu->N_bytes = payload_len;
+    // only the first bytes of user-plane PDUs are captured when truncation is enabled
+    pdu.orig_len          = payload_len;
+    uint32_t max_pdu_len_ = max_pdu_len;
+    if (rnti_type == C_RNTI && max_pdu_len_ > 0 && payload_len > max_pdu_len_) {
+      payload_len = max_pdu_len_;
+    }
+
+    // copy payload into the PDU segments, which only take the memory the PDU needs while it is queued
+    if (pdu.pdu.append(const_byte_span{payload, payload_len})) {
       if (not queue.try_push(std::move(pdu))) {
         logger.warning("Dropping PDU (%d B) in PCAP. Write queue full.", payload_len);
       }
     } else {
-      logger.warning("Dropping PDU in PCAP. No buffer available or not enough space (pdu_len=%d).", payload_len);
+      logger.warning("Dropping PDU in PCAP. No buffer segments available or not enough space (pdu_len=%d).",
+                     payload_len);
     }
   }
 }
@@ -139,17 +154,21 @@ void mac_pcap_base::pack_and_queue_nr(uint8_t* payload,
     pdu.context_nr.system_frame_number = tti / 10;
     pdu.context_nr.sub_frame_number    = tti % 10;
 
-    // try to allocate PDU buffer
-    pdu.pdu = srsran::make_byte_buffer();
-    if (pdu.pdu != nullptr && pdu.pdu->get_tailroom() >= payload_len) {
-      // copy payload into PDU buffer
-      memcpy(pdu.pdu->msg, payload, payload_len);
-      pdu.pdu->N_bytes = payload_len;
+    // only the first bytes of user-plane PDUs are captured when truncation is enabled
+    pdu.orig_len          = payload_len;
+    uint32_t max_pdu_len_ = max_pdu_len;
+    if (rnti_type == C_RNTI && max_pdu_len_ > 0 && payload_len > max_pdu_len_) {
+      payload_len = max_pdu_len_;
+    }
+
+    // copy payload into the PDU segments, which only take the memory the PDU needs while it is queued
+    if (pdu.pdu.append(const_byte_span{payload, payload_len})) {
       if (not queue.try_push(std::move(pdu))) {
         logger.warning("Dropping PDU (%d B) in NR PCAP. Write queue full.", payload_len);
       }
     } else {
-      logger.warning("Dropping PDU in NR PCAP. No buffer available or not enough space (pdu_len=%d).", payload_len);
+      logger.warning("Dropping PDU in NR PCAP. No buffer segments available or not enough space (pdu_len=%d).",
+                     payload_len);
     }
   }
 }
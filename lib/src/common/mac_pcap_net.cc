@@ -97,7 +97,7 @@ uint32_t mac_pcap_net::close()
 
 void mac_pcap_net::write_pdu(pcap_pdu_t& pdu)
 {
-  if (pdu.pdu != nullptr && socket.is_open()) {
+  if (not pdu.pdu.empty() && socket.is_open()) {
     switch (pdu.rat) {
       case srsran_rat_t::lte:
         write_mac_lte_pdu_to_net(pdu);
@@ -123,25 +123,17 @@ void mac_pcap_net::write_mac_lte_pdu_to_net(pcap_pdu_t& pdu)
 
   offset += LTE_PCAP_PACK_MAC_CONTEXT_TO_BUFFER(&pdu.context, buffer + offset, PCAP_CONTEXT_HEADER_MAX);
 
-  if (pdu.pdu.get()->get_headroom() < offset) {
-    logger.error("PDU headroom is to small for adding context buffer");
+  if (not pdu.pdu.prepend(const_byte_span{buffer, offset})) {
+    logger.error("No buffer segment left for adding context buffer");
     return;
   }
 
-  pdu.pdu.get()->msg -= offset;
-  memcpy(pdu.pdu.get()->msg, buffer, offset);
-  pdu.pdu.get()->N_bytes += offset;
+  const_byte_span bytes = linearize(pdu.pdu);
+  bytes_sent            = sendto(
+      socket.get_socket(), bytes.data(), bytes.size(), 0, (const struct sockaddr*)&client_addr, sizeof(client_addr));
 
-  bytes_sent = sendto(socket.get_socket(),
-                      pdu.pdu.get()->msg,
-                      pdu.pdu.get()->N_bytes,
-                      0,
-                      (const struct sockaddr*)&client_addr,
-                      sizeof(client_addr));
-
-  if ((int)pdu.pdu.get()->N_bytes != bytes_sent || bytes_sent < 0) {
-    logger.error(
-        "Sending UDP packet mismatches %d != %d (err %s)", pdu.pdu.get()->N_bytes, bytes_sent, strerror(errno));
+  if ((int)bytes.size() != bytes_sent || bytes_sent < 0) {
+    logger.error("Sending UDP packet mismatches %zu != %d (err %s)", bytes.size(), bytes_sent, strerror(errno));
   }
 }
 
@@ -157,25 +149,17 @@ void mac_pcap_net::write_mac_nr_pdu_to_net(pcap_pdu_t& pdu)
 
   offset += NR_PCAP_PACK_MAC_CONTEXT_TO_BUFFER(&pdu.context_nr, buffer + offset, PCAP_CONTEXT_HEADER_MAX);
 
-  if (pdu.pdu.get()->get_headroom() < offset) {
-    logger.error("PDU headroom is to small for adding context buffer");
+  if (not pdu.pdu.prepend(const_byte_span{buffer, offset})) {
+    logger.error("No buffer segment left for adding context buffer");
     return;
   }
 
-  pdu.pdu.get()->msg -= offset;
-  memcpy(pdu.pdu.get()->msg, buffer, offset);
-  pdu.pdu.get()->N_bytes += offset;
-
-  bytes_sent = sendto(socket.get_socket(),
-                      pdu.pdu.get()->msg,
-                      pdu.pdu.get()->N_bytes,
-                      0,
-                      (const struct sockaddr*)&client_addr,
-                      sizeof(client_addr));
+  const_byte_span bytes = linearize(pdu.pdu);
+  bytes_sent            = sendto(
+      socket.get_socket(), bytes.data(), bytes.size(), 0, (const struct sockaddr*)&client_addr, sizeof(client_addr));
 
-  if ((int)pdu.pdu.get()->N_bytes != bytes_sent || bytes_sent < 0) {
-    logger.error(
-        "Sending UDP packet mismatches %d != %d (err %s)", pdu.pdu.get()->N_bytes, bytes_sent, strerror(errno));
+  if ((int)bytes.size() != bytes_sent || bytes_sent < 0) {
+    logger.error("Sending UDP packet mismatches %zu != %d (err %s)", bytes.size(), bytes_sent, strerror(errno));
   }
 }
 } // namespace srsran
\ No newline at end of file
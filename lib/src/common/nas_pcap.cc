@@ -50,13 +50,13 @@ void nas_pcap::enable()
   enable_write = true;
 }
 
-uint32_t nas_pcap::open(std::string filename_, uint32_t ue_id_, srsran_rat_t rat_type)
+uint32_t nas_pcap::open(std::string filename_, uint32_t ue_id_, srsran_rat_t rat_type, int compression_level)
 {
   filename = filename_;
   if (rat_type == srsran_rat_t::nr) {
-    pcap_file = DLT_PCAP_Open(NAS_5G_DLT, filename.c_str());
+    pcap_file = DLT_PCAP_Open_Compressed(NAS_5G_DLT, filename.c_str(), compression_level);
   } else {
-    pcap_file = DLT_PCAP_Open(NAS_LTE_DLT, filename.c_str());
+    pcap_file = DLT_PCAP_Open_Compressed(NAS_LTE_DLT, filename.c_str(), compression_level);
   }
   if (pcap_file == nullptr) {
     return SRSRAN_ERROR;
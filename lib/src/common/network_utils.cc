@@ -20,6 +20,7 @@
  */
 
 #include "srsran/common/network_utils.h"
+#include "srsran/srslog/span_trace.h"
 
 #include <netinet/sctp.h>
 #include <sys/socket.h>
@@ -623,6 +624,8 @@ public:
       logger.error("Unable to allocate byte buffer");
       return true;
     }
+    trace_span_stamp_flow(pdu->md.flow_id);
+    trace_span_flow_start("pkt", "net::recvfrom", pdu->md.flow_id);
     sockaddr_in from    = {};
     socklen_t   fromlen = sizeof(from);
 
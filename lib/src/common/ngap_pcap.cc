@@ -49,10 +49,10 @@ void ngap_pcap::enable()
 {
   enable_write = true;
 }
-void ngap_pcap::open(const char* filename_)
+void ngap_pcap::open(const char* filename_, int compression_level)
 {
   filename     = filename_;
-  pcap_file    = DLT_PCAP_Open(NGAP_5G_DLT, filename.c_str());
+  pcap_file    = DLT_PCAP_Open_Compressed(NGAP_5G_DLT, filename.c_str(), compression_level);
   enable_write = true;
 }
 void ngap_pcap::close()
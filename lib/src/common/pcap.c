@@ -20,14 +20,23 @@
  */
 
 #include "srsran/common/pcap.h"
+#include "srsran/srslog/srslog_c.h"
 #include <arpa/inet.h>
 #include <linux/udp.h>
 #include <stdio.h>
 #include <string.h>
 #include <sys/time.h>
 
-/* Open the file and write file header */
+/* Open the file and write file header. The file is written in the background, so that slow disks do not block the
+ * PCAP writers */
 FILE* DLT_PCAP_Open(uint32_t DLT, const char* fileName)
+{
+  return DLT_PCAP_Open_Compressed(DLT, fileName, 0);
+}
+
+/* Open a zstd compressed file and write file header, writes it uncompressed when the compression level is zero or
+ * the compressed file can not be created */
+FILE* DLT_PCAP_Open_Compressed(uint32_t DLT, const char* fileName, int level)
 {
   pcap_hdr_t file_header = {
       0xa1b2c3d4, /* magic number */
@@ -39,15 +48,21 @@ FILE* DLT_PCAP_Open(uint32_t DLT, const char* fileName)
       DLT    /* Data Link Type (DLT).  Set as unused value 147 for now */
   };
 
-  FILE* fd = fopen(fileName, "w");
+  FILE* fd = NULL;
+  if (level > 0) {
+    fd = srslog_open_compressed_file(fileName, 0, &file_header, sizeof(pcap_hdr_t), level);
+    if (fd == NULL) {
+      printf("Unable to write compressed PCAP to \"%s\", writing it uncompressed\n", fileName);
+    }
+  }
+  if (fd == NULL) {
+    fd = srslog_open_async_file(fileName, 0, &file_header, sizeof(pcap_hdr_t));
+  }
   if (fd == NULL) {
     printf("Failed to open file \"%s\" for writing\n", fileName);
     return NULL;
   }
 
-  /* Write the file header */
-  fwrite(&file_header, sizeof(pcap_hdr_t), 1, fd);
-
   return fd;
 }
 
@@ -149,6 +164,16 @@ inline int LTE_PCAP_MAC_WritePDU(FILE* fd, MAC_Context_Info_t* context, const un
 /* Write an individual PDU (PCAP packet header + mac-context + mac-pdu) */
 inline int
 LTE_PCAP_MAC_UDP_WritePDU(FILE* fd, MAC_Context_Info_t* context, const unsigned char* PDU, unsigned int length)
+{
+  return LTE_PCAP_MAC_UDP_WriteTruncatedPDU(fd, context, PDU, length, length);
+}
+
+/* Write the first length bytes of a PDU of orig_length bytes */
+int LTE_PCAP_MAC_UDP_WriteTruncatedPDU(FILE*                fd,
+                                       MAC_Context_Info_t*  context,
+                                       const unsigned char* PDU,
+                                       unsigned int         length,
+                                       unsigned int         orig_length)
 {
   pcaprec_hdr_t  packet_header;
   uint8_t        context_header[PCAP_CONTEXT_HEADER_MAX] = {};
@@ -179,7 +204,7 @@ LTE_PCAP_MAC_UDP_WritePDU(FILE* fd, MAC_Context_Info_t* context, const unsigned
   offset += strlen(MAC_LTE_START_STRING);
 
   offset += LTE_PCAP_PACK_MAC_CONTEXT_TO_BUFFER(context, &context_header[offset], PCAP_CONTEXT_HEADER_MAX);
-  udp_header->len = htons(length + offset);
+  udp_header->len = htons(orig_length + offset);
 
   /****************************************************************/
   /* PCAP Header                                                  */
@@ -188,7 +213,7 @@ LTE_PCAP_MAC_UDP_WritePDU(FILE* fd, MAC_Context_Info_t* context, const unsigned
   packet_header.ts_sec   = t.tv_sec;
   packet_header.ts_usec  = t.tv_usec;
   packet_header.incl_len = offset + length;
-  packet_header.orig_len = offset + length;
+  packet_header.orig_len = offset + orig_length;
 
   /***************************************************************/
   /* Now write everything to the file                            */
@@ -427,6 +452,16 @@ inline int NR_PCAP_PACK_MAC_CONTEXT_TO_BUFFER(mac_nr_context_info_t* context, ui
 
 /* Write an individual NR MAC PDU (PCAP packet header + UDP header + nr-mac-context + mac-pdu) */
 int NR_PCAP_MAC_UDP_WritePDU(FILE* fd, mac_nr_context_info_t* context, const unsigned char* PDU, unsigned int length)
+{
+  return NR_PCAP_MAC_UDP_WriteTruncatedPDU(fd, context, PDU, length, length);
+}
+
+/* Write the first length bytes of a NR MAC PDU of orig_length bytes */
+int NR_PCAP_MAC_UDP_WriteTruncatedPDU(FILE*                  fd,
+                                      mac_nr_context_info_t* context,
+                                      const unsigned char*   PDU,
+                                      unsigned int           length,
+                                      unsigned int           orig_length)
 {
   uint8_t        context_header[PCAP_CONTEXT_HEADER_MAX] = {};
   struct udphdr* udp_header;
@@ -457,7 +492,7 @@ int NR_PCAP_MAC_UDP_WritePDU(FILE* fd, mac_nr_context_info_t* context, const uns
 
   offset += NR_PCAP_PACK_MAC_CONTEXT_TO_BUFFER(context, &context_header[offset], PCAP_CONTEXT_HEADER_MAX);
 
-  udp_header->len = htons(offset + length);
+  udp_header->len = htons(offset + orig_length);
 
   if (offset != 31) {
     printf("ERROR Does not match offset %d != 31\n", offset);
@@ -471,7 +506,7 @@ int NR_PCAP_MAC_UDP_WritePDU(FILE* fd, mac_nr_context_info_t* context, const uns
   packet_header.ts_sec   = t.tv_sec;
   packet_header.ts_usec  = t.tv_usec;
   packet_header.incl_len = offset + length;
-  packet_header.orig_len = offset + length;
+  packet_header.orig_len = offset + orig_length;
 
   /***************************************************************/
   /* Now write everything to the file                            */
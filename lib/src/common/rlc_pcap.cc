@@ -31,10 +31,10 @@ void rlc_pcap::enable(bool en)
   enable_write = true;
 }
 
-void rlc_pcap::open(const char* filename, const rlc_config_t& config)
+void rlc_pcap::open(const char* filename, const rlc_config_t& config, int compression_level)
 {
   fprintf(stdout, "Opening RLC PCAP with DLT=%d\n", UDP_DLT);
-  pcap_file    = DLT_PCAP_Open(UDP_DLT, filename);
+  pcap_file    = DLT_PCAP_Open_Compressed(UDP_DLT, filename, compression_level);
   enable_write = true;
 
   if (config.rlc_mode == rlc_mode_t::am) {
@@ -49,10 +49,10 @@ void s1ap_pcap::enable()
 {
   enable_write = true;
 }
-void s1ap_pcap::open(const char* filename_)
+void s1ap_pcap::open(const char* filename_, int compression_level)
 {
   filename     = filename_;
-  pcap_file    = DLT_PCAP_Open(S1AP_LTE_DLT, filename.c_str());
+  pcap_file    = DLT_PCAP_Open_Compressed(S1AP_LTE_DLT, filename.c_str(), compression_level);
   enable_write = true;
 }
 void s1ap_pcap::close()
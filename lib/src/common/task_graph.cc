@@ -0,0 +1,344 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/task_graph.h"
+#include "srsran/phy/utils/mem_arena.h"
+#include <string>
+
+namespace srsran {
+
+/**************************************************************************
+ *  task_graph
+ *************************************************************************/
+
+task_graph::task_graph(uint32_t max_tasks_) : nodes(new node_t[max_tasks_]), max_tasks(max_tasks_) {}
+
+task_graph::task_id task_graph::add_task(task_t&& task)
+{
+  if (nof_tasks >= max_tasks) {
+    return invalid_task;
+  }
+
+  node_t& node  = nodes[nof_tasks];
+  node.task     = std::move(task);
+  node.nof_deps = 0;
+  node.successors.clear();
+
+  return nof_tasks++;
+}
+
+bool task_graph::add_dependency(task_id before, task_id after)
+{
+  // Only allowing dependencies on older tasks keeps the graph acyclic
+  if (before >= after or after >= nof_tasks) {
+    return false;
+  }
+
+  node_t& node = nodes[before];
+  if (node.successors.size() >= max_successors) {
+    return false;
+  }
+
+  node.successors.push_back(after);
+  nodes[after].nof_deps++;
+
+  return true;
+}
+
+void task_graph::clear()
+{
+  // Release the resources held by the callables
+  for (uint32_t i = 0; i < nof_tasks; i++) {
+    nodes[i].task = task_t{};
+  }
+  nof_tasks = 0;
+  deadline  = clock_t::time_point::max();
+  late      = false;
+}
+
+/**************************************************************************
+ *  task_graph_executor
+ *************************************************************************/
+
+task_graph_executor::worker_t::worker_t(task_graph_executor* parent_, uint32_t queue_idx_, int32_t prio, int32_t cpu) :
+  thread(std::string("GRAPHWORKER") + std::to_string(queue_idx_)), parent(parent_), queue_idx(queue_idx_)
+{
+  if (cpu < 0) {
+    start(prio);
+  } else {
+    start_cpu(prio, cpu);
+  }
+}
+
+void task_graph_executor::worker_t::run_thread()
+{
+  task_queue& queue = *parent->queues[queue_idx];
+  task_ref_t  t;
+  while (parent->running.load(std::memory_order_relaxed)) {
+    // Newest task of the own queue first, it is likely to use data still in cache
+    if (queue.try_pop(t)) {
+      parent->nof_queued--;
+      parent->execute(queue, t, true);
+    } else if (parent->steal_task(queue_idx, t)) {
+      parent->execute(queue, t, true);
+    } else {
+      parent->wait_task(nullptr);
+    }
+  }
+}
+
+task_graph_executor::task_graph_executor(uint32_t nof_threads,
+                                         int32_t  prio,
+                                         uint32_t mask,
+                                         uint32_t queue_size,
+                                         uint32_t max_graphs)
+{
+  for (uint32_t i = 0; i < nof_threads; i++) {
+    queues.emplace_back(new task_queue(queue_size));
+  }
+  for (uint32_t i = 0; i < max_graphs; i++) {
+    slots.emplace_back(new graph_slot_t(queue_size));
+  }
+
+  std::vector<int32_t> cpus;
+  if (mask != 255) {
+    for (int32_t cpu = 0; cpu < 32; cpu++) {
+      if (mask & (1u << cpu)) {
+        cpus.push_back(cpu);
+      }
+    }
+  }
+
+  for (uint32_t i = 0; i < nof_threads; i++) {
+    int32_t cpu = cpus.empty() ? -1 : cpus[i % cpus.size()];
+    workers.emplace_back(new worker_t(this, i, prio, cpu));
+  }
+}
+
+task_graph_executor::~task_graph_executor()
+{
+  stop();
+}
+
+void task_graph_executor::stop()
+{
+  if (not running.exchange(false)) {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex);
+    sleep_cvar.notify_all();
+    done_cvar.notify_all();
+  }
+
+  for (std::unique_ptr<worker_t>& w : workers) {
+    w->wait_thread_finish();
+  }
+}
+
+void task_graph_executor::start(task_graph& graph)
+{
+  graph.late = false;
+  graph.nof_pending_tasks.store(graph.nof_tasks, std::memory_order_relaxed);
+  if (graph.empty()) {
+    return;
+  }
+
+  nof_graphs++;
+  for (uint32_t i = 0; i < graph.nof_tasks; i++) {
+    graph.nodes[i].nof_pending_deps.store(graph.nodes[i].nof_deps, std::memory_order_relaxed);
+  }
+  graph.guard_enabled = srsran_mem_guard_is_enabled(&graph.guard_assert);
+  graph.nof_guarded_allocs.store(0, std::memory_order_relaxed);
+
+  // Take a free submission queue. If there is none, wait() executes the graph
+  graph.slot = UINT32_MAX;
+  for (uint32_t i = 0; i < slots.size(); i++) {
+    bool expected = false;
+    if (slots[i]->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+      graph.slot      = i;
+      slots[i]->graph = &graph;
+      break;
+    }
+  }
+  if (graph.slot == UINT32_MAX) {
+    return;
+  }
+
+  // Release the tasks without dependencies, the rest are released as their dependencies complete
+  for (uint32_t i = 0; i < graph.nof_tasks; i++) {
+    if (graph.nodes[i].nof_deps == 0) {
+      push_task(slots[graph.slot]->queue, make_task_ref(graph.slot, i), false);
+    }
+  }
+}
+
+bool task_graph_executor::wait(task_graph& graph)
+{
+  if (graph.empty()) {
+    return true;
+  }
+
+  if (graph.slot == UINT32_MAX) {
+    execute_inline(graph);
+  } else {
+    // Help executing the tasks of the graph until it is completed. The ones made ready by the executor threads are in
+    // their queues, they are left to them
+    graph_slot_t& slot = *slots[graph.slot];
+    task_ref_t    t;
+    while (graph.nof_pending_tasks.load(std::memory_order_acquire) > 0) {
+      if (slot.queue.try_pop(t)) {
+        nof_queued--;
+        execute(slot.queue, t, false);
+      } else {
+        wait_task(&graph);
+      }
+    }
+    slot.graph = nullptr;
+    slot.in_use.store(false, std::memory_order_release);
+  }
+  srsran_mem_guard_add(graph.nof_guarded_allocs.load(std::memory_order_relaxed));
+
+  if (task_graph::clock_t::now() > graph.deadline) {
+    graph.late = true;
+    nof_deadline_misses++;
+  }
+
+  return not graph.late;
+}
+
+bool task_graph_executor::run(task_graph& graph)
+{
+  start(graph);
+  return wait(graph);
+}
+
+task_graph_executor::metrics_t task_graph_executor::get_metrics()
+{
+  metrics_t m           = {};
+  m.nof_graphs          = nof_graphs.exchange(0);
+  m.nof_deadline_misses = nof_deadline_misses.exchange(0);
+  m.nof_tasks           = nof_tasks.exchange(0);
+  m.nof_late_tasks      = nof_late_tasks.exchange(0);
+  m.nof_stolen_tasks    = nof_stolen_tasks.exchange(0);
+  return m;
+}
+
+bool task_graph_executor::steal_task(uint32_t queue_idx, task_ref_t& t)
+{
+  // Oldest task of the other executor threads first, then of the running graphs
+  for (uint32_t i = 1; i < queues.size(); i++) {
+    if (queues[(queue_idx + i) % queues.size()]->try_steal(t)) {
+      nof_queued--;
+      nof_stolen_tasks++;
+      return true;
+    }
+  }
+  for (std::unique_ptr<graph_slot_t>& slot : slots) {
+    if (slot->queue.try_steal(t)) {
+      nof_queued--;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void task_graph_executor::push_task(task_queue& queue, task_ref_t t, bool in_worker)
+{
+  nof_queued++;
+  if (not queue.try_push(t)) {
+    // The queue is full, run the task now
+    nof_queued--;
+    execute(queue, t, in_worker);
+    return;
+  }
+
+  if (not workers.empty()) {
+    std::lock_guard<std::mutex> lock(sleep_mutex);
+    sleep_cvar.notify_one();
+  }
+}
+
+void task_graph_executor::execute(task_queue& queue, task_ref_t t, bool in_worker)
+{
+  task_graph*         graph = slots[t >> 32U]->graph;
+  task_graph::node_t& node  = graph->nodes[t & UINT32_MAX];
+
+  if (graph->deadline != task_graph::clock_t::time_point::max() and task_graph::clock_t::now() > graph->deadline) {
+    nof_late_tasks++;
+  }
+
+  if (in_worker and graph->guard_enabled) {
+    // Count the heap allocations of the task as done by the thread waiting for the graph
+    srsran_mem_guard_enter(graph->guard_assert);
+    node.task();
+    graph->nof_guarded_allocs.fetch_add(srsran_mem_guard_exit(), std::memory_order_relaxed);
+  } else {
+    node.task();
+  }
+  nof_tasks++;
+
+  for (task_graph::task_id succ : node.successors) {
+    if (graph->nodes[succ].nof_pending_deps.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      push_task(queue, make_task_ref(graph->slot, succ), in_worker);
+    }
+  }
+
+  // The graph must not be accessed after the last task completes, the thread in wait() may return at any time
+  if (graph->nof_pending_tasks.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    std::lock_guard<std::mutex> lock(sleep_mutex);
+    done_cvar.notify_all();
+  }
+}
+
+void task_graph_executor::execute_inline(task_graph& graph)
+{
+  // The tasks only depend on older tasks, so the order of the graph is a valid execution order
+  for (uint32_t i = 0; i < graph.nof_tasks; i++) {
+    if (graph.deadline != task_graph::clock_t::time_point::max() and task_graph::clock_t::now() > graph.deadline) {
+      nof_late_tasks++;
+    }
+    graph.nodes[i].task();
+    nof_tasks++;
+  }
+  graph.nof_pending_tasks.store(0, std::memory_order_relaxed);
+}
+
+void task_graph_executor::wait_task(const task_graph* graph)
+{
+  std::unique_lock<std::mutex> lock(sleep_mutex);
+  if (graph == nullptr) {
+    // Executor thread, waits for tasks of any graph
+    sleep_cvar.wait(lock, [this]() {
+      return nof_queued.load(std::memory_order_relaxed) > 0 or not running.load(std::memory_order_relaxed);
+    });
+    return;
+  }
+
+  // Thread waiting for a graph. Only itself pushes tasks to the queue of the graph, so it waits for the completion
+  done_cvar.wait(lock, [this, graph]() {
+    return graph->nof_pending_tasks.load(std::memory_order_acquire) == 0 or not running.load(std::memory_order_relaxed);
+  });
+}
+
+} // namespace srsran
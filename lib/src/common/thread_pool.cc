@@ -23,7 +23,12 @@
 #include "srsran/srslog/srslog.h"
 #include <assert.h>
 #include <chrono>
+#include <ctype.h>
+#include <dirent.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
 
 #define DEBUG 0
 #define debug_thread(fmt, ...)                                                                                         \
@@ -268,15 +273,59 @@ std::string thread_pool::get_id()
 }
 
 /**************************************************************************
- *  task_thread_pool - uses a queue to enqueue callables, that start
- *  once a worker is available
+ *  task_thread_pool - workers with work-stealing deques execute the
+ *  enqueued callables, high priority tasks first
  *************************************************************************/
 
-task_thread_pool::task_thread_pool(uint32_t nof_workers, bool start_deferred, int32_t prio_, uint32_t mask_) :
-  logger(srslog::fetch_basic_logger("POOL")), pending_tasks(max_task_num), workers(std::max(1u, nof_workers))
+// Pool and id of the worker running in the current thread, the tasks that it pushes go to its own deque
+static thread_local const task_thread_pool* current_pool      = nullptr;
+static thread_local uint32_t                current_worker_id = 0;
+
+/// Returns the NUMA node of a CPU, or -1 if it is unknown
+static int32_t get_cpu_numa_node(int32_t cpu)
+{
+  if (cpu < 0) {
+    return -1;
+  }
+  std::string path = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+  DIR*        dir  = opendir(path.c_str());
+  if (dir == nullptr) {
+    return -1;
+  }
+  int32_t node = -1;
+  while (struct dirent* entry = readdir(dir)) {
+    if (strncmp(entry->d_name, "node", 4) == 0 and isdigit(entry->d_name[4])) {
+      node = atoi(entry->d_name + 4);
+      break;
+    }
+  }
+  closedir(dir);
+  return node;
+}
+
+task_thread_pool::task_thread_pool(uint32_t nof_workers,
+                                   bool     start_deferred,
+                                   int32_t  prio_,
+                                   uint32_t mask_,
+                                   bool     pin_workers_) :
+  logger(srslog::fetch_basic_logger("POOL")),
+  tasks(new task_t[max_task_num]),
+  free_slots(max_task_num),
+  workers(nof_workers > max_workers ? max_workers : std::max(1u, nof_workers))
 {
+  if (nof_workers > max_workers) {
+    logger.error("The number of workers is limited to %u", uint32_t(max_workers));
+  }
+  for (auto& q : shared_queues) {
+    q.reset(new lockfree_bounded_queue<uint32_t>(max_task_num));
+  }
+  for (uint32_t i = 0; i < max_task_num; ++i) {
+    free_slots.try_push(i);
+  }
+  alloc_worker_queues(workers.size());
+
   if (not start_deferred) {
-    start(prio_, mask_);
+    start(prio_, mask_, pin_workers_);
   }
 }
 
@@ -285,6 +334,31 @@ task_thread_pool::~task_thread_pool()
   stop();
 }
 
+int32_t task_thread_pool::get_worker_cpu(uint32_t id) const
+{
+  if (not pin_workers or mask == 255) {
+    return -1;
+  }
+  std::vector<int32_t> cpus;
+  for (int32_t cpu = 0; cpu < 32; cpu++) {
+    if (mask & (1u << cpu)) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus.empty() ? -1 : cpus[id % cpus.size()];
+}
+
+void task_thread_pool::alloc_worker_queues(uint32_t nof_queues)
+{
+  // The deques are never released, the other workers may be stealing from them
+  for (uint32_t i = nof_local_queues.load(std::memory_order_relaxed); i < nof_queues; ++i) {
+    local_queues[i].reset(new local_queues_t);
+    local_queues[i]->numa_node = get_cpu_numa_node(get_worker_cpu(i));
+  }
+  nof_local_queues.store(std::max(nof_queues, nof_local_queues.load(std::memory_order_relaxed)),
+                         std::memory_order_release);
+}
+
 void task_thread_pool::set_nof_workers(uint32_t nof_workers)
 {
   std::lock_guard<std::mutex> lock(queue_mutex);
@@ -292,27 +366,38 @@ void task_thread_pool::set_nof_workers(uint32_t nof_workers)
     logger.error("Reducing the number of workers dynamically not supported");
     return;
   }
+  if (nof_workers > max_workers) {
+    logger.error("The number of workers is limited to %u", uint32_t(max_workers));
+    nof_workers = max_workers;
+  }
   uint32_t old_size = workers.size();
   workers.resize(nof_workers);
+  alloc_worker_queues(nof_workers);
   if (running) {
     for (uint32_t i = old_size; i < nof_workers; ++i) {
-      workers[i].reset(new worker_t(this, i));
+      workers[i].reset(new worker_t(this, i, get_worker_cpu(i)));
     }
   }
 }
 
-void task_thread_pool::start(int32_t prio_, uint32_t mask_)
+void task_thread_pool::start(int32_t prio_, uint32_t mask_, bool pin_workers_)
 {
   std::lock_guard<std::mutex> lock(queue_mutex);
   if (running) {
     logger.error("Starting thread pool that has already started");
     return;
   }
-  prio    = prio_;
-  mask    = mask_;
-  running = true;
+  prio        = prio_;
+  mask        = mask_;
+  pin_workers = pin_workers_;
+  running     = true;
+
+  // The NUMA nodes of all the workers are set before any of them starts looking for tasks to steal
+  for (uint32_t i = 0; i < workers.size(); ++i) {
+    local_queues[i]->numa_node = get_cpu_numa_node(get_worker_cpu(i));
+  }
   for (uint32_t i = 0; i < workers.size(); ++i) {
-    workers[i].reset(new worker_t(this, i));
+    workers[i].reset(new worker_t(this, i, get_worker_cpu(i)));
   }
 }
 
@@ -320,16 +405,10 @@ void task_thread_pool::stop()
 {
   std::unique_lock<std::mutex> lock(queue_mutex);
   if (running) {
-    running              = false;
-    bool workers_running = false;
-    for (std::unique_ptr<worker_t>& w : workers) {
-      if (w->is_running()) {
-        workers_running = true;
-        break;
-      }
-    }
+    running = false;
     lock.unlock();
-    if (workers_running) {
+    {
+      std::lock_guard<std::mutex> sleep_lock(sleep_mutex);
       cv_empty.notify_all();
     }
     for (std::unique_ptr<worker_t>& w : workers) {
@@ -338,29 +417,61 @@ void task_thread_pool::stop()
   }
 }
 
-void task_thread_pool::push_task(task_t&& task)
+void task_thread_pool::push_task(task_t&& task, task_priority priority)
 {
-  {
-    std::lock_guard<std::mutex> lock(queue_mutex);
-    if (pending_tasks.full()) {
-      logger.error("Cannot push anymore tasks into the queue, maximum size is %u", uint32_t(max_task_num));
-      return;
-    }
-    pending_tasks.push(std::move(task));
+  uint32_t task_idx = 0;
+  if (not free_slots.pop(task_idx)) {
+    logger.error("Cannot push anymore tasks into the queue, maximum size is %u", uint32_t(max_task_num));
+    return;
+  }
+  tasks[task_idx] = std::move(task);
+
+  // Counted before the task is visible, so that the workers never see more tasks than the counter
+  nof_queued++;
+
+  // The tasks pushed by a worker go to its own deque, the rest to the shared queue
+  uint32_t p = static_cast<uint32_t>(priority);
+  if (current_pool != this or not local_queues[current_worker_id]->queues[p]->try_push(task_idx)) {
+    shared_queues[p]->push(task_idx);
+  }
+
+  // A sleeping worker checks the counter after announcing itself, one of the two sides always sees the other
+  if (nof_sleeping > 0) {
+    std::lock_guard<std::mutex> lock(sleep_mutex);
+    cv_empty.notify_one();
   }
-  cv_empty.notify_one();
 }
 
 uint32_t task_thread_pool::nof_pending_tasks() const
 {
-  std::lock_guard<std::mutex> lock(queue_mutex);
-  return pending_tasks.size();
+  return nof_queued;
 }
 
-task_thread_pool::worker_t::worker_t(srsran::task_thread_pool* parent_, uint32_t my_id) :
-  parent(parent_), thread(std::string("TASKWORKER") + std::to_string(my_id)), id_(my_id), running(true)
+task_thread_pool::metrics_t task_thread_pool::get_metrics()
 {
-  if (parent->mask == 255) {
+  metrics_t m         = {};
+  m.nof_tasks         = nof_tasks.exchange(0);
+  m.nof_stolen_tasks  = nof_stolen_tasks.exchange(0);
+  m.nof_remote_steals = nof_remote_steals.exchange(0);
+  return m;
+}
+
+void task_thread_pool::run_task(uint32_t task_idx)
+{
+  tasks[task_idx]();
+
+  // Release the resources held by the callable before the slot is reused
+  tasks[task_idx] = task_t{};
+  free_slots.push(task_idx);
+  nof_tasks.fetch_add(1, std::memory_order_relaxed);
+}
+
+task_thread_pool::worker_t::worker_t(srsran::task_thread_pool* parent_, uint32_t my_id, int32_t cpu) :
+  thread(std::string("TASKWORKER") + std::to_string(my_id)), parent(parent_), id_(my_id)
+{
+  if (cpu >= 0) {
+    start_cpu_mask(parent->prio, 1u << cpu);
+  } else if (parent->mask == 255) {
     start(parent->prio);
   } else {
     start_cpu_mask(parent->prio, parent->mask);
@@ -372,33 +483,119 @@ void task_thread_pool::worker_t::stop()
   wait_thread_finish();
 }
 
-bool task_thread_pool::worker_t::wait_task(task_t* task)
+void task_thread_pool::worker_t::update_victims()
 {
-  std::unique_lock<std::mutex> lock(parent->queue_mutex);
-  while (parent->running and parent->pending_tasks.empty()) {
-    parent->cv_empty.wait(lock);
+  nof_victim_queues = parent->nof_local_queues.load(std::memory_order_acquire);
+  int32_t node      = parent->local_queues[id_]->numa_node;
+
+  // The workers of the same NUMA node first, stealing their tasks does not move data across nodes
+  victims.clear();
+  for (bool same_node : {true, false}) {
+    for (uint32_t i = 1; i < nof_victim_queues; ++i) {
+      uint32_t victim = (id_ + i) % nof_victim_queues;
+      if ((parent->local_queues[victim]->numa_node == node) == same_node) {
+        victims.push_back(victim);
+      }
+    }
   }
-  if (not parent->running) {
+}
+
+bool task_thread_pool::worker_t::take_shared_tasks(task_priority priority, uint32_t* task_idx)
+{
+  uint32_t                          p      = static_cast<uint32_t>(priority);
+  lockfree_bounded_queue<uint32_t>& shared = *parent->shared_queues[p];
+  if (not shared.try_pop(*task_idx)) {
     return false;
   }
-  if (task) {
-    *task = std::move(parent->pending_tasks.top());
+
+  // Low priority tasks are taken in batches, so that the workers contend less on the shared queue. The idle workers
+  // steal them from the deque of this one
+  if (priority == task_priority::low) {
+    work_stealing_deque<uint32_t>& own       = *parent->local_queues[id_]->queues[p];
+    size_t                         nof_extra = std::min(shared.size() / nof_victim_queues, size_t(max_batch_size - 1));
+    nof_extra                                = std::min(nof_extra, own.capacity() - own.size());
+    uint32_t extra_idx                       = 0;
+    for (size_t i = 0; i < nof_extra and shared.try_pop(extra_idx); ++i) {
+      own.try_push(extra_idx);
+    }
   }
-  parent->pending_tasks.pop();
   return true;
 }
 
+bool task_thread_pool::worker_t::steal_task(task_priority priority, uint32_t* task_idx)
+{
+  uint32_t p    = static_cast<uint32_t>(priority);
+  int32_t  node = parent->local_queues[id_]->numa_node;
+  for (uint32_t victim : victims) {
+    local_queues_t& victim_queues = *parent->local_queues[victim];
+    if (victim_queues.queues[p]->try_steal(*task_idx)) {
+      parent->nof_stolen_tasks.fetch_add(1, std::memory_order_relaxed);
+      if (victim_queues.numa_node != node) {
+        parent->nof_remote_steals.fetch_add(1, std::memory_order_relaxed);
+      }
+      return true;
+    }
+  }
+  return false;
+}
+
+bool task_thread_pool::worker_t::find_task(uint32_t* task_idx)
+{
+  if (nof_victim_queues != parent->nof_local_queues.load(std::memory_order_acquire)) {
+    update_victims();
+  }
+
+  // All the sources of high priority tasks are checked before the low priority ones
+  local_queues_t& own = *parent->local_queues[id_];
+  for (uint32_t p = 0; p < nof_priorities; ++p) {
+    task_priority priority = static_cast<task_priority>(p);
+    // Newest task of the own deque first, it is likely to use data still in cache
+    if (own.queues[p]->try_pop(*task_idx) or take_shared_tasks(priority, task_idx) or steal_task(priority, task_idx)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool task_thread_pool::worker_t::wait_task()
+{
+  std::unique_lock<std::mutex> lock(parent->sleep_mutex);
+  parent->nof_sleeping++;
+  while (parent->running and parent->nof_queued == 0) {
+    parent->cv_empty.wait(lock);
+  }
+  parent->nof_sleeping--;
+  return parent->running;
+}
+
 void task_thread_pool::worker_t::run_thread()
 {
+  current_pool      = parent;
+  current_worker_id = id_;
+
   // main loop
-  task_t task;
-  while (wait_task(&task)) {
-    task();
+  uint32_t task_idx   = 0;
+  uint32_t nof_misses = 0;
+  while (parent->running) {
+    if (find_task(&task_idx)) {
+      nof_misses = 0;
+      parent->nof_queued--;
+      parent->run_task(task_idx);
+    } else if (parent->nof_queued == 0) {
+      nof_misses = 0;
+      if (not wait_task()) {
+        break;
+      }
+    } else if (++nof_misses < max_yields_before_sleep) {
+      // A task is still being pushed, or another worker has just taken it
+      std::this_thread::yield();
+    } else {
+      // The pusher may be a preempted thread of lower priority, which yielding does not let run
+      std::this_thread::sleep_for(std::chrono::microseconds(10));
+    }
   }
 
-  // on exit, notify pool class
-  std::unique_lock<std::mutex> lock(parent->queue_mutex);
-  running = false;
+  current_pool = nullptr;
 }
 
 task_worker::task_worker(std::string thread_name_,
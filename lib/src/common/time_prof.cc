@@ -115,3 +115,53 @@ void sliding_window_stats<TUnit>::operator()(nanoseconds duration)
 
 template class srsran::sliding_window_stats<std::chrono::microseconds>;
 template class srsran::sliding_window_stats<std::chrono::milliseconds>;
+
+// latency histogram
+
+void latency_histogram::add(std::chrono::microseconds latency, bool late)
+{
+  uint32_t us  = static_cast<uint32_t>(std::max<int64_t>(latency.count(), 0));
+  uint32_t bin = 0;
+  while (bin < nof_bins - 1 and us >= (1U << bin)) {
+    bin++;
+  }
+  bins[bin].fetch_add(1, std::memory_order_relaxed);
+
+  if (late) {
+    nof_late.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  uint32_t prev_max = max_us.load(std::memory_order_relaxed);
+  while (us > prev_max and not max_us.compare_exchange_weak(prev_max, us, std::memory_order_relaxed)) {
+  }
+}
+
+latency_histogram::summary_t latency_histogram::get_and_reset()
+{
+  std::array<uint64_t, nof_bins> counts = {};
+  summary_t                      s      = {};
+  for (uint32_t i = 0; i < nof_bins; i++) {
+    counts[i] = bins[i].exchange(0, std::memory_order_relaxed);
+    s.nof_samples += counts[i];
+  }
+  s.nof_late = nof_late.exchange(0, std::memory_order_relaxed);
+  s.max_us   = max_us.exchange(0, std::memory_order_relaxed);
+
+  // The percentiles are reported as the upper bound of the bin they fall in, never above the maximum
+  uint64_t acc       = 0;
+  bool     p50_found = false;
+  for (uint32_t i = 0; i < nof_bins and s.nof_samples > 0; i++) {
+    acc += counts[i];
+    uint32_t upper = std::min(1U << i, s.max_us);
+    if (not p50_found and acc * 2 >= s.nof_samples) {
+      s.p50_us  = upper;
+      p50_found = true;
+    }
+    if (acc * 100 >= s.nof_samples * 99) {
+      s.p99_us = upper;
+      break;
+    }
+  }
+
+  return s;
+}
@@ -767,10 +767,10 @@ void pdcp_entity_lte::notify_delivery(const pdcp_sn_vector_t& pdcp_sns)
       // Metrics
       auto& sdu = (*undelivered_sdus)[sn];
       tx_pdu_ack_latency_ms.push(std::chrono::duration_cast<std::chrono::milliseconds>(
-                                     std::chrono::high_resolution_clock::now() - sdu->get_timestamp())
+                                     std::chrono::high_resolution_clock::now() - sdu.get_timestamp())
                                      .count());
-      metrics.num_tx_acked_bytes += sdu->N_bytes;
-      metrics.num_tx_buffered_pdus_bytes -= sdu->N_bytes;
+      metrics.num_tx_acked_bytes += sdu.size();
+      metrics.num_tx_buffered_pdus_bytes -= sdu.size();
 
       // Remove PDU and disarm timer.
       undelivered_sdus->clear_sdu(sn);
@@ -874,7 +874,8 @@ void pdcp_entity_lte::reset_metrics()
 undelivered_sdus_queue::undelivered_sdus_queue(srsran::task_sched_handle task_sched, uint32_t sn_mod) : sn_mod(sn_mod)
 {
   for (auto& e : sdus) {
-    e.discard_timer = task_sched.get_unique_timer();
+    e.sdu.md.pdcp_sn = invalid_sn;
+    e.discard_timer  = task_sched.get_unique_timer();
   }
 }
 
@@ -900,9 +901,9 @@ bool undelivered_sdus_queue::add_sdu(uint32_t                              sn,
     }
   }
 
-  // Allocate buffer and exit on error
-  srsran::unique_byte_buffer_t tmp = make_byte_buffer();
-  if (tmp == nullptr) {
+  // Allocate the segments and exit on error
+  srsran::byte_buffer_chain tmp;
+  if (not tmp.append(make_span(sdu))) {
     return false;
   }
 
@@ -915,15 +916,13 @@ bool undelivered_sdus_queue::add_sdu(uint32_t                              sn,
   }
   // Add SDU
   count++;
-  sdus[sn].sdu             = std::move(tmp);
-  sdus[sn].sdu->md.pdcp_sn = sn;
-  sdus[sn].sdu->N_bytes    = sdu->N_bytes;
-  memcpy(sdus[sn].sdu->msg, sdu->msg, sdu->N_bytes);
+  sdus[sn].sdu            = std::move(tmp);
+  sdus[sn].sdu.md.pdcp_sn = sn;
   if (discard_timeout > 0) {
     sdus[sn].discard_timer.set(discard_timeout, std::move(callback));
     sdus[sn].discard_timer.run();
   }
-  sdus[sn].sdu->set_timestamp(); // Metrics
+  sdus[sn].sdu.set_timestamp(); // Metrics
   bytes += sdu->N_bytes;
   return true;
 }
@@ -934,9 +933,10 @@ bool undelivered_sdus_queue::clear_sdu(uint32_t sn)
     return false;
   }
   count--;
-  bytes -= sdus[sn].sdu->N_bytes;
+  bytes -= sdus[sn].sdu.size();
   sdus[sn].discard_timer.stop();
-  sdus[sn].sdu.reset();
+  sdus[sn].sdu.clear();
+  sdus[sn].sdu.md.pdcp_sn = invalid_sn;
   // Find next FMS, if necessary
   if (sn == fms) {
     update_fms();
@@ -951,14 +951,15 @@ void undelivered_sdus_queue::clear()
   fms   = 0;
   for (uint32_t sn = 0; sn < capacity; sn++) {
     sdus[sn].discard_timer.stop();
-    sdus[sn].sdu.reset();
+    sdus[sn].sdu.clear();
+    sdus[sn].sdu.md.pdcp_sn = invalid_sn;
   }
 }
 
 size_t undelivered_sdus_queue::nof_discard_timers() const
 {
   return std::count_if(sdus.begin(), sdus.end(), [](const sdu_data& s) {
-    return s.sdu != nullptr and s.discard_timer.is_valid() and s.discard_timer.is_running();
+    return s.sdu.md.pdcp_sn != invalid_sn and s.discard_timer.is_valid() and s.discard_timer.is_running();
   });
 }
 
@@ -999,12 +1000,13 @@ std::map<uint32_t, srsran::unique_byte_buffer_t> undelivered_sdus_queue::get_buf
 {
   std::map<uint32_t, srsran::unique_byte_buffer_t> fwd_sdus;
   for (auto& sdu : sdus) {
-    if (sdu.sdu != nullptr) {
-      // TODO: Find ways to avoid deep copy
+    if (sdu.sdu.md.pdcp_sn != invalid_sn) {
+      // The forwarded SDUs go to the target over the byte_buffer_t interfaces
       srsran::unique_byte_buffer_t fwd_sdu = make_byte_buffer();
       if (fwd_sdu != nullptr) {
-        *fwd_sdu = *sdu.sdu;
-        fwd_sdus.emplace(sdu.sdu->md.pdcp_sn, std::move(fwd_sdu));
+        fwd_sdu->N_bytes = sdu.sdu.copy_to(byte_span{fwd_sdu->msg, fwd_sdu->get_tailroom()});
+        fwd_sdu->md      = sdu.sdu.md;
+        fwd_sdus.emplace(sdu.sdu.md.pdcp_sn, std::move(fwd_sdu));
       } else {
         srslog::fetch_basic_logger("PDCP").warning("Can't allocate buffer to forward buffered SDUs.");
       }
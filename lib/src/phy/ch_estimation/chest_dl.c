@@ -149,6 +149,12 @@ int srsran_chest_dl_init(srsran_chest_dl_t* q, uint32_t max_prb, uint32_t nof_rx
       goto clean_exit;
     }
 
+    q->wiener_2d = calloc(sizeof(srsran_wiener_2d_t), 1);
+    if (!q->wiener_2d || srsran_wiener_2d_init(q->wiener_2d, SRSRAN_NRE * max_prb) < SRSRAN_SUCCESS) {
+      ERROR("Error initializing MMSE estimator");
+      goto clean_exit;
+    }
+
     q->nof_rx_antennas = nof_rx_antennas;
   }
 
@@ -202,6 +208,10 @@ void srsran_chest_dl_free(srsran_chest_dl_t* q)
     srsran_wiener_dl_free(q->wiener_dl);
     free(q->wiener_dl);
   }
+  if (q->wiener_2d) {
+    srsran_wiener_2d_free(q->wiener_2d);
+    free(q->wiener_2d);
+  }
   bzero(q, sizeof(srsran_chest_dl_t));
 }
 
@@ -639,6 +649,38 @@ static float chest_estimate_cfo(srsran_chest_dl_t* q)
   return -cargf(sum) * n / (ns * (n + ng)) / 2 / M_PI;
 }
 
+/* 2D MMSE estimation of the whole subframe from the least squares estimates of the CRS */
+static int chest_dl_mmse(srsran_chest_dl_t*     q,
+                         srsran_dl_sf_cfg_t*    sf,
+                         srsran_chest_dl_cfg_t* cfg,
+                         cf_t*                  ce,
+                         uint32_t               port_id,
+                         uint32_t               rxant_id)
+{
+  srsran_wiener_2d_grid_t grid = {};
+  grid.scs_hz                  = 15e3f;
+  grid.symbol_duration_s       = 1e-3f / (SRSRAN_NOF_SLOTS_PER_SF * SRSRAN_CP_NSYMB(q->cell.cp));
+  grid.period                  = SRSRAN_NRE / 2;
+  grid.nof_pilots              = 2 * q->cell.nof_prb;
+  grid.nof_pilot_symbols       = srsran_refsignal_cs_nof_symbols(&q->csr_refs, sf, port_id);
+  grid.first_symbol            = 0;
+  grid.nof_symbols             = SRSRAN_NOF_SLOTS_PER_SF * SRSRAN_CP_NSYMB(q->cell.cp);
+  if (grid.nof_pilot_symbols > SRSRAN_WIENER_2D_MAX_PILOT_SYMBOLS) {
+    return SRSRAN_ERROR;
+  }
+  for (uint32_t l = 0; l < grid.nof_pilot_symbols; l++) {
+    grid.pilot_symbols[l] = srsran_refsignal_cs_nsymbol(l, q->cell.cp, port_id);
+    grid.pilot_mask[l]    = 1U << srsran_refsignal_cs_fidx(q->cell, l, port_id, 0);
+  }
+
+  float snr_db = +INFINITY;
+  if (isnormal(q->noise_estimate[rxant_id][port_id]) && isnormal(q->rsrp[rxant_id][port_id])) {
+    snr_db = srsran_convert_power_to_dB(q->rsrp[rxant_id][port_id] / q->noise_estimate[rxant_id][port_id]);
+  }
+
+  return srsran_wiener_2d_estimate(q->wiener_2d, &cfg->mmse_cfg, &grid, snr_db, q->pilot_estimates, ce);
+}
+
 static void chest_interpolate_noise_est(srsran_chest_dl_t*     q,
                                         srsran_dl_sf_cfg_t*    sf,
                                         srsran_chest_dl_cfg_t* cfg,
@@ -720,12 +762,18 @@ static void chest_interpolate_noise_est(srsran_chest_dl_t*     q,
       ERROR("Warning: Subframe interpolation must be enabled in MBSFN subframes");
     }
 
-    /* Smooth estimates (if applicable) and interpolate */
-    if (cfg->filter_type == SRSRAN_CHEST_FILTER_NONE) {
-      interpolate_pilots(q, sf, cfg, q->pilot_estimates, ce, port_id);
-    } else {
-      average_pilots(q, sf, cfg, q->pilot_estimates, q->pilot_estimates_average, port_id, filter, filter_len);
-      interpolate_pilots(q, sf, cfg, q->pilot_estimates_average, ce, port_id);
+    /* Smooth estimates (if applicable) and interpolate. The MMSE estimator falls back to interpolation if it fails */
+    bool estimated = false;
+    if (cfg->estimator_alg == SRSRAN_ESTIMATOR_ALG_MMSE && ch_mode == SRSRAN_SF_NORM) {
+      estimated = chest_dl_mmse(q, sf, cfg, ce, port_id, rxant_id) >= SRSRAN_SUCCESS;
+    }
+    if (!estimated) {
+      if (cfg->filter_type == SRSRAN_CHEST_FILTER_NONE) {
+        interpolate_pilots(q, sf, cfg, q->pilot_estimates, ce, port_id);
+      } else {
+        average_pilots(q, sf, cfg, q->pilot_estimates, q->pilot_estimates_average, port_id, filter, filter_len);
+        interpolate_pilots(q, sf, cfg, q->pilot_estimates_average, ce, port_id);
+      }
     }
 
     /* Estimate noise for PSS and EMPTY algorithms */
@@ -1037,6 +1085,8 @@ srsran_chest_dl_estimator_alg_t srsran_chest_dl_str2estimator_alg(const char* st
       ret = SRSRAN_ESTIMATOR_ALG_AVERAGE;
     } else if (strcmp(str, "wiener") == 0) {
       ret = SRSRAN_ESTIMATOR_ALG_WIENER;
+    } else if (strcmp(str, "mmse") == 0) {
+      ret = SRSRAN_ESTIMATOR_ALG_MMSE;
     }
   }
 
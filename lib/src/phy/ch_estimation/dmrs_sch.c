@@ -579,6 +579,20 @@ static int dmrs_sch_alloc(srsran_dmrs_sch_t* q, uint32_t max_nof_prb)
       ERROR("malloc");
       return SRSRAN_ERROR;
     }
+
+    if (q->wiener_2d == NULL) {
+      q->wiener_2d = calloc(1, sizeof(srsran_wiener_2d_t));
+      if (q->wiener_2d == NULL) {
+        ERROR("malloc");
+        return SRSRAN_ERROR;
+      }
+    } else {
+      srsran_wiener_2d_free(q->wiener_2d);
+    }
+    if (srsran_wiener_2d_init(q->wiener_2d, max_nof_prb * SRSRAN_NRE) < SRSRAN_SUCCESS) {
+      ERROR("Error initialising MMSE estimator");
+      return SRSRAN_ERROR;
+    }
   }
 
   return SRSRAN_SUCCESS;
@@ -630,6 +644,10 @@ void srsran_dmrs_sch_free(srsran_dmrs_sch_t* q)
   if (q->filter) {
     free(q->filter);
   }
+  if (q->wiener_2d) {
+    srsran_wiener_2d_free(q->wiener_2d);
+    free(q->wiener_2d);
+  }
 
   SRSRAN_MEM_ZERO(q, srsran_dmrs_sch_t, 1);
 }
@@ -762,6 +780,83 @@ static int srsran_dmrs_sch_get_symbol(srsran_dmrs_sch_t*           q,
   return pilot_count;
 }
 
+static int dmrs_sch_interpolate(srsran_dmrs_sch_t*           q,
+                                const srsran_dmrs_sch_cfg_t* dmrs_cfg,
+                                uint32_t                     nof_symbols,
+                                uint32_t                     nof_pilots_x_symbol,
+                                cf_t*                        ce)
+{
+  const uint32_t delta = 0;
+
+  // Average over time, only if more than one DMRS symbol
+  for (uint32_t i = 1; i < nof_symbols; i++) {
+    srsran_vec_sum_ccc(
+        q->pilot_estimates, &q->pilot_estimates[nof_pilots_x_symbol * i], q->pilot_estimates, nof_pilots_x_symbol);
+  }
+  if (nof_symbols > 0) {
+    srsran_vec_sc_prod_cfc(q->pilot_estimates, 1.0f / (float)nof_symbols, q->pilot_estimates, nof_pilots_x_symbol);
+  }
+
+#if DMRS_SCH_SMOOTH_FILTER_LEN
+  // Apply smoothing filter
+  srsran_conv_same_cf(
+      q->pilot_estimates, q->filter, q->pilot_estimates, nof_pilots_x_symbol, DMRS_SCH_SMOOTH_FILTER_LEN);
+#endif // DMRS_SCH_SMOOTH_FILTER_LEN
+
+  // Frequency domain interpolate
+  if (dmrs_cfg->type == srsran_dmrs_sch_type_1) {
+    // Prepare interpolator
+    if (srsran_interp_linear_resize(&q->interpolator_type1, nof_pilots_x_symbol, 2) < SRSRAN_SUCCESS) {
+      ERROR("Resizing interpolator nof_pilots_x_symbol=%d; M=%d;", nof_pilots_x_symbol, 2);
+      return SRSRAN_ERROR;
+    }
+
+    // Interpolate
+    srsran_interp_linear_offset(&q->interpolator_type1, q->pilot_estimates, ce, delta, 2 - delta);
+
+  } else {
+    // Prepare interpolator
+    if (srsran_interp_linear_resize(&q->interpolator_type2, nof_pilots_x_symbol, 3) < SRSRAN_SUCCESS) {
+      ERROR("Resizing interpolator nof_pilots_x_symbol=%d; M=%d;", nof_pilots_x_symbol, 3);
+      return SRSRAN_ERROR;
+    }
+
+    // Interpolate
+    srsran_interp_linear_offset(&q->interpolator_type2, q->pilot_estimates, ce, delta, 3 - delta);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+// Filters the DMRS least squares estimates with the 2D MMSE estimator, estimates are read for each symbol afterwards
+static int dmrs_sch_mmse_run(srsran_dmrs_sch_t*           q,
+                             const srsran_dmrs_sch_cfg_t* dmrs_cfg,
+                             const srsran_sch_grant_nr_t* grant,
+                             const uint32_t*              symbols,
+                             uint32_t                     nof_symbols,
+                             uint32_t                     nof_pilots_x_symbol)
+{
+  if (q->wiener_2d == NULL || nof_symbols > SRSRAN_WIENER_2D_MAX_PILOT_SYMBOLS) {
+    return SRSRAN_ERROR;
+  }
+
+  srsran_wiener_2d_grid_t grid = {};
+  grid.scs_hz                  = SRSRAN_SUBC_SPACING_NR(q->carrier.scs);
+  grid.symbol_duration_s =
+      srsran_symbol_distance_s(0, SRSRAN_NSYMB_PER_SLOT_NR, q->carrier.scs) / SRSRAN_NSYMB_PER_SLOT_NR;
+  grid.period            = (dmrs_cfg->type == srsran_dmrs_sch_type_1) ? 2 : 6;
+  grid.nof_pilots        = nof_pilots_x_symbol;
+  grid.nof_pilot_symbols = nof_symbols;
+  grid.first_symbol      = grant->S;
+  grid.nof_symbols       = grant->L;
+  for (uint32_t i = 0; i < nof_symbols; i++) {
+    grid.pilot_symbols[i] = symbols[i];
+    grid.pilot_mask[i]    = (dmrs_cfg->type == srsran_dmrs_sch_type_1) ? 0x1 : 0x3;
+  }
+
+  return srsran_wiener_2d_run(q->wiener_2d, &dmrs_cfg->mmse, &grid, q->csi.snr_dB, q->pilot_estimates);
+}
+
 int srsran_dmrs_sch_estimate(srsran_dmrs_sch_t*           q,
                              const srsran_slot_cfg_t*     slot,
                              const srsran_sch_cfg_nr_t*   cfg,
@@ -913,55 +1008,41 @@ int srsran_dmrs_sch_estimate(srsran_dmrs_sch_t*           q,
        cfo_avg_hz,
        chest_res->sync_error * 1e6);
 
-  // Average over time, only if more than one DMRS symbol
-  for (uint32_t i = 1; i < nof_symbols; i++) {
-    srsran_vec_sum_ccc(
-        q->pilot_estimates, &q->pilot_estimates[nof_pilots_x_symbol * i], q->pilot_estimates, nof_pilots_x_symbol);
-  }
-  if (nof_symbols > 0) {
-    srsran_vec_sc_prod_cfc(q->pilot_estimates, 1.0f / (float)nof_symbols, q->pilot_estimates, nof_pilots_x_symbol);
-  }
-
-#if DMRS_SCH_SMOOTH_FILTER_LEN
-  // Apply smoothing filter
-  srsran_conv_same_cf(
-      q->pilot_estimates, q->filter, q->pilot_estimates, nof_pilots_x_symbol, DMRS_SCH_SMOOTH_FILTER_LEN);
-#endif // DMRS_SCH_SMOOTH_FILTER_LEN
-
-  // Frequency domain interpolate
+  // Frequency domain interpolation, unless the 2D MMSE estimator is enabled and it succeeds
   uint32_t nof_re_x_symbol =
       (dmrs_cfg->type == srsran_dmrs_sch_type_1) ? nof_pilots_x_symbol * 2 : nof_pilots_x_symbol * 3;
-  if (dmrs_cfg->type == srsran_dmrs_sch_type_1) {
-    // Prepare interpolator
-    if (srsran_interp_linear_resize(&q->interpolator_type1, nof_pilots_x_symbol, 2) < SRSRAN_SUCCESS) {
-      ERROR("Resizing interpolator nof_pilots_x_symbol=%d; M=%d;", nof_pilots_x_symbol, 2);
+  bool mmse = dmrs_cfg->mmse_enable &&
+              dmrs_sch_mmse_run(q, dmrs_cfg, grant, symbols, nof_symbols, nof_pilots_x_symbol) >= SRSRAN_SUCCESS;
+  if (!mmse) {
+    if (dmrs_sch_interpolate(q, dmrs_cfg, nof_symbols, nof_pilots_x_symbol, ce) < SRSRAN_SUCCESS) {
       return SRSRAN_ERROR;
     }
 
-    // Interpolate
-    srsran_interp_linear_offset(&q->interpolator_type1, q->pilot_estimates, ce, delta, 2 - delta);
-
-  } else {
-    // Prepare interpolator
-    if (srsran_interp_linear_resize(&q->interpolator_type2, nof_pilots_x_symbol, 3) < SRSRAN_SUCCESS) {
-      ERROR("Resizing interpolator nof_pilots_x_symbol=%d; M=%d;", nof_pilots_x_symbol, 3);
-      return SRSRAN_ERROR;
+#if DMRS_SCH_SYNC_PRECOMPENSATE
+    // Remove synchronization error pre-compensation
+    if (isnormal(sync_err)) {
+      srsran_vec_apply_cfo(ce, -sync_err / dmrs_stride, ce, nof_re_x_symbol);
     }
-
-    // Interpolate
-    srsran_interp_linear_offset(&q->interpolator_type2, q->pilot_estimates, ce, delta, 3 - delta);
+#endif // DMRS_SCH_SYNC_ERROR_PRECOMPENSATE
   }
 
+  // Time domain hold or MMSE interpolation, extract resource elements estimates for PDSCH
+  uint32_t count = 0;
+  for (uint32_t l = grant->S; l < grant->S + grant->L; l++) {
+    if (mmse) {
+      if (srsran_wiener_2d_get_symbol(q->wiener_2d, l, ce) < SRSRAN_SUCCESS) {
+        ERROR("Error getting MMSE estimates of symbol %d", l);
+        return SRSRAN_ERROR;
+      }
+
 #if DMRS_SCH_SYNC_PRECOMPENSATE
-  // Remove synchronization error pre-compensation
-  if (isnormal(sync_err)) {
-    srsran_vec_apply_cfo(ce, -sync_err / dmrs_stride, ce, nof_re_x_symbol);
-  }
+      // Remove synchronization error pre-compensation
+      if (isnormal(sync_err)) {
+        srsran_vec_apply_cfo(ce, -sync_err / dmrs_stride, ce, nof_re_x_symbol);
+      }
 #endif // DMRS_SCH_SYNC_ERROR_PRECOMPENSATE
+    }
 
-  // Time domain hold, extract resource elements estimates for PDSCH
-  uint32_t count = 0;
-  for (uint32_t l = grant->S; l < grant->S + grant->L; l++) {
     // Initialise reserved mask
     bool rvd_mask_wb[SRSRAN_NRE * SRSRAN_MAX_PRB_NR] = {};
 
@@ -0,0 +1,412 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/ch_estimation/chest_common.h"
+#include "srsran/phy/channel/ch_awgn.h"
+#include "srsran/phy/ch_estimation/wiener_2d.h"
+#include "srsran/phy/common/phy_common.h"
+#include "srsran/phy/resampling/interp.h"
+#include "srsran/phy/utils/convolution.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/random.h"
+#include "srsran/phy/utils/vector.h"
+#include "srsran/support/srsran_test.h"
+#include <complex.h>
+#include <math.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#define NOF_SYMBOLS 14
+#define NOF_TAPS 16
+#define NOF_SINUSOIDS 8
+#define SMOOTH_FILTER_LEN 5
+
+static uint32_t nof_prb         = 50;
+static float    snr_db          = 10.0f;
+static float    delay_spread_ns = 400.0f;
+static float    doppler_hz      = 80.0f;
+static uint32_t nof_repetitions = 100;
+
+static srsran_channel_awgn_t awgn = {};
+
+typedef struct {
+  double mse;
+  double power;
+  double elapsed_us;
+  double nof_re;
+} benchmark_t;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [pdfsn]\n", prog);
+  printf("\t-p nof_prb [Default %d]\n", nof_prb);
+  printf("\t-d RMS delay spread in ns [Default %.0f]\n", delay_spread_ns);
+  printf("\t-f maximum Doppler in Hz [Default %.0f]\n", doppler_hz);
+  printf("\t-s SNR in dB [Default %.1f]\n", snr_db);
+  printf("\t-n number of channel realizations [Default %d]\n", nof_repetitions);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "pdfsn")) != -1) {
+    switch (opt) {
+      case 'p':
+        nof_prb = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'd':
+        delay_spread_ns = strtof(argv[optind], NULL);
+        break;
+      case 'f':
+        doppler_hz = strtof(argv[optind], NULL);
+        break;
+      case 's':
+        snr_db = strtof(argv[optind], NULL);
+        break;
+      case 'n':
+        nof_repetitions = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+/* Generates a channel with an exponential power delay profile and a Jakes Doppler spectrum for every resource element
+ * of a slot or subframe */
+static void channel_generate(srsran_random_t random, float scs_hz, float symbol_duration_s, uint32_t nof_re, cf_t* h)
+{
+  cf_t  tap_gain[NOF_TAPS][NOF_SYMBOLS];
+  float tap_delay_s[NOF_TAPS];
+  float total_power = 0.0f;
+  float t0          = srsran_random_uniform_real_dist(random, 0.0f, 1.0f);
+
+  for (uint32_t i = 0; i < NOF_TAPS; i++) {
+    tap_delay_s[i] = i * delay_spread_ns * 1e-9f / 2.0f;
+    total_power += expf(-(float)i / 2.0f);
+  }
+
+  for (uint32_t i = 0; i < NOF_TAPS; i++) {
+    float amplitude = sqrtf(expf(-(float)i / 2.0f) / total_power / NOF_SINUSOIDS);
+    float freq[NOF_SINUSOIDS];
+    float phase[NOF_SINUSOIDS];
+    for (uint32_t n = 0; n < NOF_SINUSOIDS; n++) {
+      freq[n]  = doppler_hz * cosf(srsran_random_uniform_real_dist(random, 0.0f, 2.0f * (float)M_PI));
+      phase[n] = srsran_random_uniform_real_dist(random, 0.0f, 2.0f * (float)M_PI);
+    }
+    for (uint32_t l = 0; l < NOF_SYMBOLS; l++) {
+      float t        = t0 + l * symbol_duration_s;
+      tap_gain[i][l] = 0.0f;
+      for (uint32_t n = 0; n < NOF_SINUSOIDS; n++) {
+        tap_gain[i][l] += amplitude * cexpf(I * (2.0f * (float)M_PI * freq[n] * t + phase[n]));
+      }
+    }
+  }
+
+  for (uint32_t l = 0; l < NOF_SYMBOLS; l++) {
+    srsran_vec_cf_zero(&h[l * nof_re], nof_re);
+    for (uint32_t i = 0; i < NOF_TAPS; i++) {
+      for (uint32_t k = 0; k < nof_re; k++) {
+        h[l * nof_re + k] += tap_gain[i][l] * cexpf(-I * 2.0f * (float)M_PI * k * scs_hz * tap_delay_s[i]);
+      }
+    }
+  }
+}
+
+// Least squares estimates of the pilots in the given grid
+static void channel_ls(const srsran_wiener_2d_grid_t* grid, uint32_t nof_re, const cf_t* h, cf_t* pilots)
+{
+  for (uint32_t i = 0; i < grid->nof_pilot_symbols; i++) {
+    const cf_t* h_symbol = &h[grid->pilot_symbols[i] * nof_re];
+    for (uint32_t k = 0, p = 0; p < grid->nof_pilots; k++) {
+      if (grid->pilot_mask[i] & (1U << (k % grid->period))) {
+        pilots[grid->nof_pilots * i + p++] = h_symbol[k];
+      }
+    }
+  }
+
+  srsran_channel_awgn_run_c(&awgn, pilots, pilots, grid->nof_pilots * grid->nof_pilot_symbols);
+}
+
+static void benchmark_accumulate(benchmark_t* b, const cf_t* h, const cf_t* ce, uint32_t nof_re, struct timeval* t)
+{
+  for (uint32_t i = 0; i < nof_re; i++) {
+    cf_t err = ce[i] - h[i];
+    b->mse += __real__ err * __real__ err + __imag__ err * __imag__ err;
+    b->power += __real__ h[i] * __real__ h[i] + __imag__ h[i] * __imag__ h[i];
+  }
+  get_time_interval(t);
+  b->elapsed_us += t[0].tv_sec * 1e6 + t[0].tv_usec;
+  b->nof_re += nof_re;
+}
+
+static float benchmark_print(const char* name, const benchmark_t* b)
+{
+  float mse_db = srsran_convert_power_to_dB(b->mse / b->power);
+  printf("  %-8s MSE=%+6.2f dB; %7.2f MRE/s\n", name, mse_db, b->nof_re / b->elapsed_us);
+  return mse_db;
+}
+
+/* LTE CRS of antenna port 0. The reference is the subframe interpolation of the LTE DL estimator: linear interpolation
+ * in frequency and in time. */
+static int test_lte_crs(srsran_random_t random, srsran_wiener_2d_t* wiener, cf_t* h, cf_t* ce, cf_t* pilots)
+{
+  const uint32_t         nof_re   = nof_prb * SRSRAN_NRE;
+  const uint32_t         shift    = 1;
+  srsran_wiener_2d_cfg_t cfg      = {delay_spread_ns, doppler_hz};
+  benchmark_t            linear   = {};
+  benchmark_t            mmse     = {};
+  uint32_t               nof_filt = 0;
+
+  srsran_wiener_2d_grid_t grid = {};
+  grid.scs_hz                  = 15e3f;
+  grid.symbol_duration_s       = 1e-3f / NOF_SYMBOLS;
+  grid.period                  = SRSRAN_NRE / 2;
+  grid.nof_pilots              = 2 * nof_prb;
+  grid.nof_pilot_symbols       = 4;
+  grid.first_symbol            = 0;
+  grid.nof_symbols             = NOF_SYMBOLS;
+  for (uint32_t i = 0; i < grid.nof_pilot_symbols; i++) {
+    grid.pilot_symbols[i] = (i / 2) * 7 + (i % 2) * 4;
+    grid.pilot_mask[i]    = 1U << ((shift + (i % 2) * 3) % 6);
+  }
+
+  srsran_interp_lin_t           interp_lin    = {};
+  srsran_interp_linsrsran_vec_t interp_linvec = {};
+  TESTASSERT(srsran_interp_linear_init(&interp_lin, 2 * nof_prb, SRSRAN_NRE / 2) == SRSRAN_SUCCESS);
+  TESTASSERT(srsran_interp_linear_vector_init(&interp_linvec, nof_re) == SRSRAN_SUCCESS);
+
+  for (uint32_t r = 0; r < nof_repetitions; r++) {
+    struct timeval t[3];
+    channel_generate(random, grid.scs_hz, grid.symbol_duration_s, nof_re, h);
+    channel_ls(&grid, nof_re, h, pilots);
+
+    gettimeofday(&t[1], NULL);
+    for (uint32_t i = 0; i < grid.nof_pilot_symbols; i++) {
+      uint32_t offset = (shift + (i % 2) * 3) % 6;
+      srsran_interp_linear_offset(&interp_lin,
+                                  &pilots[grid.nof_pilots * i],
+                                  &ce[grid.pilot_symbols[i] * nof_re],
+                                  offset,
+                                  SRSRAN_NRE / 2 - offset);
+    }
+    srsran_interp_linear_vector(&interp_linvec, &ce[0], &ce[4 * nof_re], &ce[1 * nof_re], 4, 3);
+    srsran_interp_linear_vector(&interp_linvec, &ce[4 * nof_re], &ce[7 * nof_re], &ce[5 * nof_re], 3, 2);
+    srsran_interp_linear_vector(&interp_linvec, &ce[7 * nof_re], &ce[11 * nof_re], &ce[8 * nof_re], 4, 3);
+    srsran_interp_linear_vector2(
+        &interp_linvec, &ce[7 * nof_re], &ce[11 * nof_re], &ce[11 * nof_re], &ce[12 * nof_re], 4, 2);
+    gettimeofday(&t[2], NULL);
+    benchmark_accumulate(&linear, h, ce, nof_re * NOF_SYMBOLS, t);
+
+    gettimeofday(&t[1], NULL);
+    TESTASSERT(srsran_wiener_2d_estimate(wiener, &cfg, &grid, snr_db, pilots, ce) == (int)nof_re);
+    gettimeofday(&t[2], NULL);
+    benchmark_accumulate(&mmse, h, ce, nof_re * NOF_SYMBOLS, t);
+
+    // The filters are computed in the first estimation and taken from the cache afterwards
+    if (r == 0) {
+      nof_filt = wiener->nof_computed;
+    }
+    TESTASSERT(wiener->nof_computed == nof_filt);
+  }
+
+  printf("LTE CRS port 0, %d PRB:\n", nof_prb);
+  float linear_mse_db = benchmark_print("linear", &linear);
+  float mmse_mse_db   = benchmark_print("MMSE", &mmse);
+  TESTASSERT(mmse_mse_db < linear_mse_db);
+
+  srsran_interp_linear_free(&interp_lin);
+  srsran_interp_linear_vector_free(&interp_linvec);
+
+  return SRSRAN_SUCCESS;
+}
+
+/* NR PDSCH DMRS type 1 in symbols 2 and 11. The reference is the NR DMRS estimator: time averaging, smoothing, linear
+ * interpolation in frequency and hold in time. */
+static int test_nr_dmrs(srsran_random_t random, srsran_wiener_2d_t* wiener, cf_t* h, cf_t* ce, cf_t* pilots)
+{
+  const uint32_t         nof_re = nof_prb * SRSRAN_NRE;
+  srsran_wiener_2d_cfg_t cfg    = {delay_spread_ns, doppler_hz};
+  benchmark_t            linear = {};
+  benchmark_t            mmse   = {};
+  float                  filter[SMOOTH_FILTER_LEN];
+
+  srsran_wiener_2d_grid_t grid = {};
+  grid.scs_hz                  = 30e3f;
+  grid.symbol_duration_s       = 0.5e-3f / NOF_SYMBOLS;
+  grid.period                  = 2;
+  grid.nof_pilots              = nof_re / 2;
+  grid.nof_pilot_symbols       = 2;
+  grid.pilot_symbols[0]        = 2;
+  grid.pilot_symbols[1]        = 11;
+  grid.pilot_mask[0]           = 0x1;
+  grid.pilot_mask[1]           = 0x1;
+  grid.first_symbol            = 0;
+  grid.nof_symbols             = NOF_SYMBOLS;
+
+  srsran_interp_lin_t interp_lin = {};
+  TESTASSERT(srsran_interp_linear_init(&interp_lin, grid.nof_pilots, 2) == SRSRAN_SUCCESS);
+  srsran_chest_set_smooth_filter_gauss(filter, SMOOTH_FILTER_LEN - 1, 2);
+
+  for (uint32_t r = 0; r < nof_repetitions; r++) {
+    struct timeval t[3];
+    channel_generate(random, grid.scs_hz, grid.symbol_duration_s, nof_re, h);
+    channel_ls(&grid, nof_re, h, pilots);
+
+    gettimeofday(&t[1], NULL);
+    srsran_vec_sum_ccc(pilots, &pilots[grid.nof_pilots], pilots, grid.nof_pilots);
+    srsran_vec_sc_prod_cfc(pilots, 0.5f, pilots, grid.nof_pilots);
+    srsran_conv_same_cf(pilots, filter, &pilots[grid.nof_pilots], grid.nof_pilots, SMOOTH_FILTER_LEN);
+    srsran_interp_linear_offset(&interp_lin, &pilots[grid.nof_pilots], ce, 0, 2);
+    for (uint32_t l = 1; l < NOF_SYMBOLS; l++) {
+      srsran_vec_cf_copy(&ce[l * nof_re], ce, nof_re);
+    }
+    gettimeofday(&t[2], NULL);
+    benchmark_accumulate(&linear, h, ce, nof_re * NOF_SYMBOLS, t);
+
+    // The reference estimator overwrites the pilots
+    channel_ls(&grid, nof_re, h, pilots);
+
+    gettimeofday(&t[1], NULL);
+    TESTASSERT(srsran_wiener_2d_estimate(wiener, &cfg, &grid, snr_db, pilots, ce) == (int)nof_re);
+    gettimeofday(&t[2], NULL);
+    benchmark_accumulate(&mmse, h, ce, nof_re * NOF_SYMBOLS, t);
+  }
+
+  printf("NR PDSCH DMRS type 1, %d PRB:\n", nof_prb);
+  float linear_mse_db = benchmark_print("linear", &linear);
+  float mmse_mse_db   = benchmark_print("MMSE", &mmse);
+  TESTASSERT(mmse_mse_db < linear_mse_db);
+
+  srsran_interp_linear_free(&interp_lin);
+
+  return SRSRAN_SUCCESS;
+}
+
+/* A receiver cycles through the filters of every UE SNR and DMRS time pattern. Once computed, all of them must stay in
+ * the cache. */
+static int test_cache(srsran_random_t random, srsran_wiener_2d_t* wiener, cf_t* h, cf_t* ce, cf_t* pilots)
+{
+  const uint32_t         nof_re = nof_prb * SRSRAN_NRE;
+  srsran_wiener_2d_cfg_t cfg    = {delay_spread_ns, doppler_hz};
+
+  srsran_wiener_2d_grid_t grid = {};
+  grid.scs_hz                  = 30e3f;
+  grid.symbol_duration_s       = 0.5e-3f / NOF_SYMBOLS;
+  grid.period                  = 2;
+  grid.nof_pilots              = nof_re / 2;
+  grid.pilot_symbols[0]        = 2;
+  grid.pilot_symbols[1]        = 11;
+  grid.pilot_mask[0]           = 0x1;
+  grid.pilot_mask[1]           = 0x1;
+  grid.first_symbol            = 0;
+  grid.nof_symbols             = NOF_SYMBOLS;
+
+  channel_generate(random, grid.scs_hz, grid.symbol_duration_s, nof_re, h);
+
+  uint32_t nof_computed = 0;
+  for (uint32_t pass = 0; pass < 2; pass++) {
+    // 2 DMRS time patterns and the 15 SNR bins
+    for (uint32_t nof_pilot_symbols = 1; nof_pilot_symbols <= 2; nof_pilot_symbols++) {
+      for (float ue_snr_db = -6.0f; ue_snr_db <= 36.0f; ue_snr_db += 3.0f) {
+        grid.nof_pilot_symbols = nof_pilot_symbols;
+        channel_ls(&grid, nof_re, h, pilots);
+        TESTASSERT(srsran_wiener_2d_estimate(wiener, &cfg, &grid, ue_snr_db, pilots, ce) == (int)nof_re);
+      }
+    }
+    if (pass == 0) {
+      nof_computed = wiener->nof_computed;
+    }
+  }
+
+  printf("Filter cache: %d filters computed, none recomputed\n", nof_computed);
+  TESTASSERT(wiener->nof_computed == nof_computed);
+
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  int                ret    = SRSRAN_ERROR;
+  srsran_random_t    random = srsran_random_init(0x1234);
+  srsran_wiener_2d_t wiener = {};
+  uint32_t           nof_re = nof_prb * SRSRAN_NRE;
+  cf_t*              h      = NULL;
+  cf_t*              ce     = NULL;
+  cf_t*              pilots = NULL;
+
+  parse_args(argc, argv);
+  nof_re = nof_prb * SRSRAN_NRE;
+
+  h      = srsran_vec_cf_malloc(nof_re * NOF_SYMBOLS);
+  ce     = srsran_vec_cf_malloc(nof_re * NOF_SYMBOLS);
+  pilots = srsran_vec_cf_malloc(nof_re * NOF_SYMBOLS);
+  if (h == NULL || ce == NULL || pilots == NULL) {
+    ERROR("Error allocating memory");
+    goto clean_exit;
+  }
+
+  if (srsran_channel_awgn_init(&awgn, 0x1234) < SRSRAN_SUCCESS) {
+    ERROR("Error initialising AWGN");
+    goto clean_exit;
+  }
+  srsran_channel_awgn_set_n0(&awgn, -snr_db);
+
+  if (srsran_wiener_2d_init(&wiener, nof_re) < SRSRAN_SUCCESS) {
+    ERROR("Error initialising MMSE estimator");
+    goto clean_exit;
+  }
+
+  printf("Delay spread=%.0f ns; Doppler=%.0f Hz; SNR=%.1f dB;\n", delay_spread_ns, doppler_hz, snr_db);
+
+  if (test_lte_crs(random, &wiener, h, ce, pilots) < SRSRAN_SUCCESS) {
+    goto clean_exit;
+  }
+
+  if (test_nr_dmrs(random, &wiener, h, ce, pilots) < SRSRAN_SUCCESS) {
+    goto clean_exit;
+  }
+
+  if (test_cache(random, &wiener, h, ce, pilots) < SRSRAN_SUCCESS) {
+    goto clean_exit;
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_random_free(random);
+  srsran_channel_awgn_free(&awgn);
+  srsran_wiener_2d_free(&wiener);
+  if (h) {
+    free(h);
+  }
+  if (ce) {
+    free(ce);
+  }
+  if (pilots) {
+    free(pilots);
+  }
+
+  printf("%s\n", ret == SRSRAN_SUCCESS ? "Ok" : "Failed");
+  return ret;
+}
@@ -0,0 +1,551 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/ch_estimation/wiener_2d.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/simd.h"
+#include "srsran/phy/utils/vector.h"
+#include <complex.h>
+#include <math.h>
+#include <string.h>
+
+// Channel statistics bins, values are rounded to the closest one in logarithmic scale
+static const float wiener_2d_delay_spread_bins_ns[] = {25.0f, 50.0f, 100.0f, 200.0f, 400.0f, 800.0f, 1600.0f, 3200.0f};
+static const float wiener_2d_doppler_bins_hz[]      = {5.0f, 10.0f, 20.0f, 40.0f, 80.0f, 160.0f, 320.0f, 640.0f, 1280.0f};
+
+#define WIENER_2D_NOF_DELAY_BINS (sizeof(wiener_2d_delay_spread_bins_ns) / sizeof(float))
+#define WIENER_2D_NOF_DOPPLER_BINS (sizeof(wiener_2d_doppler_bins_hz) / sizeof(float))
+
+// SNR bins, from -6 dB to 36 dB in 3 dB steps
+#define WIENER_2D_SNR_MIN_DB (-6.0f)
+#define WIENER_2D_SNR_STEP_DB (3.0f)
+#define WIENER_2D_NOF_SNR_BINS (15U)
+
+static uint32_t wiener_2d_log_bin(const float* bins, uint32_t nof_bins, float value)
+{
+  uint32_t best      = 0;
+  float    best_dist = INFINITY;
+
+  for (uint32_t i = 0; i < nof_bins; i++) {
+    float dist = fabsf(log2f(value / bins[i]));
+    if (dist < best_dist) {
+      best      = i;
+      best_dist = dist;
+    }
+  }
+
+  return best;
+}
+
+static uint32_t wiener_2d_snr_bin(float snr_db)
+{
+  if (isnan(snr_db) || snr_db > WIENER_2D_SNR_MIN_DB + WIENER_2D_SNR_STEP_DB * (WIENER_2D_NOF_SNR_BINS - 1)) {
+    return WIENER_2D_NOF_SNR_BINS - 1;
+  }
+  if (snr_db < WIENER_2D_SNR_MIN_DB) {
+    return 0;
+  }
+  return (uint32_t)roundf((snr_db - WIENER_2D_SNR_MIN_DB) / WIENER_2D_SNR_STEP_DB);
+}
+
+static double wiener_2d_snr_bin_lin(uint32_t snr_bin)
+{
+  return pow(10.0, (WIENER_2D_SNR_MIN_DB + WIENER_2D_SNR_STEP_DB * snr_bin) / 10.0);
+}
+
+/* Solves A X = B for a Hermitian positive definite n x n matrix A and a n x m matrix B, overwriting B with X. The
+ * filters are computed in double precision as the correlation matrices are badly conditioned at high SNR. */
+static int wiener_2d_solve(double complex* A, double complex* B, uint32_t n, uint32_t m)
+{
+  // Cholesky factorisation A = L * L^H, L is stored in the lower triangle of A
+  for (uint32_t j = 0; j < n; j++) {
+    double d = creal(A[j * n + j]);
+    for (uint32_t k = 0; k < j; k++) {
+      d -= creal(A[j * n + k] * conj(A[j * n + k]));
+    }
+    if (!(d > 0.0)) {
+      return SRSRAN_ERROR;
+    }
+    d                = sqrt(d);
+    A[j * n + j] = d;
+    for (uint32_t i = j + 1; i < n; i++) {
+      double complex s = A[i * n + j];
+      for (uint32_t k = 0; k < j; k++) {
+        s -= A[i * n + k] * conj(A[j * n + k]);
+      }
+      A[i * n + j] = s / d;
+    }
+  }
+
+  for (uint32_t c = 0; c < m; c++) {
+    // Forward substitution L * Y = B
+    for (uint32_t i = 0; i < n; i++) {
+      double complex s = B[i * m + c];
+      for (uint32_t k = 0; k < i; k++) {
+        s -= A[i * n + k] * B[k * m + c];
+      }
+      B[i * m + c] = s / creal(A[i * n + i]);
+    }
+
+    // Backward substitution L^H * X = Y
+    for (int i = (int)n - 1; i >= 0; i--) {
+      double complex s = B[i * m + c];
+      for (uint32_t k = i + 1; k < n; k++) {
+        s -= conj(A[k * n + i]) * B[k * m + c];
+      }
+      B[i * m + c] = s / creal(A[i * n + i]);
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+// Frequency correlation of an exponential power delay profile
+static double complex wiener_2d_freq_corr(double delay_spread_s, double scs_hz, int delta)
+{
+  return 1.0 / (1.0 + I * 2.0 * M_PI * delay_spread_s * scs_hz * delta);
+}
+
+// Time correlation of a Jakes Doppler spectrum
+static double wiener_2d_time_corr(double doppler_hz, double symbol_duration_s, int delta)
+{
+  return j0(2.0 * M_PI * doppler_hz * symbol_duration_s * delta);
+}
+
+/* Computes the filter that estimates the channel in all the subcarriers spanned by a window of pilots:
+ *   W = R_hp * (R_pp + I / SNR)^-1
+ * W is stored transposed, so that each pilot contribution is applied to consecutive subcarriers. */
+static int wiener_2d_freq_compute(srsran_wiener_2d_freq_filter_t* f)
+{
+  uint32_t M        = f->nof_window_pilots;
+  uint32_t nof_re   = (M / __builtin_popcount(f->mask)) * f->period;
+  double   tau      = wiener_2d_delay_spread_bins_ns[f->delay_bin] * 1e-9;
+  double   snr_lin  = wiener_2d_snr_bin_lin(f->snr_bin);
+  uint32_t pos[SRSRAN_WIENER_2D_WINDOW_PILOTS];
+
+  double complex A[SRSRAN_WIENER_2D_WINDOW_PILOTS * SRSRAN_WIENER_2D_WINDOW_PILOTS];
+  double complex B[SRSRAN_WIENER_2D_WINDOW_PILOTS * SRSRAN_WIENER_2D_WINDOW_PILOTS * SRSRAN_WIENER_2D_MAX_PERIOD];
+
+  // Pilot subcarriers in the window
+  for (uint32_t k = 0, re = 0; k < M; re++) {
+    if (f->mask & (1U << (re % f->period))) {
+      pos[k++] = re;
+    }
+  }
+
+  for (uint32_t i = 0; i < M; i++) {
+    for (uint32_t k = 0; k < M; k++) {
+      A[i * M + k] = wiener_2d_freq_corr(tau, f->scs_hz, (int)pos[i] - (int)pos[k]);
+    }
+    A[i * M + i] += 1.0 / snr_lin;
+    for (uint32_t r = 0; r < nof_re; r++) {
+      B[i * nof_re + r] = conj(wiener_2d_freq_corr(tau, f->scs_hz, (int)r - (int)pos[i]));
+    }
+  }
+
+  if (wiener_2d_solve(A, B, M, nof_re) < SRSRAN_SUCCESS) {
+    ERROR("Error computing frequency filter");
+    return SRSRAN_ERROR;
+  }
+
+  double noise_gain = 0.0;
+  for (uint32_t k = 0; k < M; k++) {
+    for (uint32_t r = 0; r < nof_re; r++) {
+      double complex w = conj(B[k * nof_re + r]);
+      f->coef[k][r]    = (cf_t)w;
+      noise_gain += creal(w * conj(w));
+    }
+  }
+  f->noise_gain = (float)(noise_gain / nof_re);
+
+  return SRSRAN_SUCCESS;
+}
+
+// Computes the filter that interpolates the frequency filtered pilot symbols in time, W = R_hp * (R_pp + I / SNR)^-1
+static int wiener_2d_time_compute(srsran_wiener_2d_time_filter_t* t)
+{
+  uint32_t N       = t->nof_pilot_symbols;
+  double   fd      = wiener_2d_doppler_bins_hz[t->doppler_bin];
+  double   snr_lin = wiener_2d_snr_bin_lin(t->snr_bin);
+
+  double complex A[SRSRAN_WIENER_2D_MAX_PILOT_SYMBOLS * SRSRAN_WIENER_2D_MAX_PILOT_SYMBOLS];
+  double complex B[SRSRAN_WIENER_2D_MAX_PILOT_SYMBOLS * SRSRAN_WIENER_2D_MAX_SYMBOLS];
+
+  for (uint32_t i = 0; i < N; i++) {
+    for (uint32_t k = 0; k < N; k++) {
+      A[i * N + k] =
+          wiener_2d_time_corr(fd, t->symbol_duration_s, (int)t->pilot_symbols[i] - (int)t->pilot_symbols[k]);
+    }
+    A[i * N + i] += 1.0 / snr_lin;
+    for (uint32_t l = 0; l < t->nof_symbols; l++) {
+      B[i * t->nof_symbols + l] =
+          wiener_2d_time_corr(fd, t->symbol_duration_s, (int)(t->first_symbol + l) - (int)t->pilot_symbols[i]);
+    }
+  }
+
+  if (wiener_2d_solve(A, B, N, t->nof_symbols) < SRSRAN_SUCCESS) {
+    ERROR("Error computing time filter");
+    return SRSRAN_ERROR;
+  }
+
+  for (uint32_t i = 0; i < N; i++) {
+    for (uint32_t l = 0; l < t->nof_symbols; l++) {
+      t->coef[l][i] = (float)creal(B[i * t->nof_symbols + l]);
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+static const srsran_wiener_2d_freq_filter_t* wiener_2d_get_freq_filter(srsran_wiener_2d_t* q,
+                                                                       float               scs_hz,
+                                                                       uint32_t            period,
+                                                                       uint32_t            mask,
+                                                                       uint32_t            nof_window_pilots,
+                                                                       uint32_t            delay_bin,
+                                                                       uint32_t            snr_bin)
+{
+  srsran_wiener_2d_freq_filter_t* oldest = &q->freq_cache[0];
+
+  for (uint32_t i = 0; i < SRSRAN_WIENER_2D_CACHE_SIZE; i++) {
+    srsran_wiener_2d_freq_filter_t* f = &q->freq_cache[i];
+    if (f->valid && f->scs_hz == scs_hz && f->period == period && f->mask == mask &&
+        f->nof_window_pilots == nof_window_pilots && f->delay_bin == delay_bin && f->snr_bin == snr_bin) {
+      f->last_used = ++q->use_count;
+      return f;
+    }
+    if (!f->valid || (oldest->valid && f->last_used < oldest->last_used)) {
+      oldest = f;
+    }
+  }
+
+  // Replace the least recently used filter
+  oldest->valid             = false;
+  oldest->scs_hz            = scs_hz;
+  oldest->period            = period;
+  oldest->mask              = mask;
+  oldest->nof_window_pilots = nof_window_pilots;
+  oldest->delay_bin         = delay_bin;
+  oldest->snr_bin           = snr_bin;
+  if (wiener_2d_freq_compute(oldest) < SRSRAN_SUCCESS) {
+    return NULL;
+  }
+  oldest->valid     = true;
+  oldest->last_used = ++q->use_count;
+  q->nof_computed++;
+
+  return oldest;
+}
+
+static const srsran_wiener_2d_time_filter_t* wiener_2d_get_time_filter(srsran_wiener_2d_t*            q,
+                                                                       const srsran_wiener_2d_grid_t* grid,
+                                                                       uint32_t                       doppler_bin,
+                                                                       uint32_t                       snr_bin)
+{
+  srsran_wiener_2d_time_filter_t* oldest = &q->time_cache[0];
+
+  for (uint32_t i = 0; i < SRSRAN_WIENER_2D_CACHE_SIZE; i++) {
+    srsran_wiener_2d_time_filter_t* t = &q->time_cache[i];
+    if (t->valid && t->symbol_duration_s == grid->symbol_duration_s &&
+        t->nof_pilot_symbols == grid->nof_pilot_symbols && t->first_symbol == grid->first_symbol &&
+        t->nof_symbols == grid->nof_symbols && t->doppler_bin == doppler_bin && t->snr_bin == snr_bin &&
+        memcmp(t->pilot_symbols, grid->pilot_symbols, sizeof(uint32_t) * grid->nof_pilot_symbols) == 0) {
+      t->last_used = ++q->use_count;
+      return t;
+    }
+    if (!t->valid || (oldest->valid && t->last_used < oldest->last_used)) {
+      oldest = t;
+    }
+  }
+
+  // Replace the least recently used filter
+  oldest->valid             = false;
+  oldest->symbol_duration_s = grid->symbol_duration_s;
+  oldest->nof_pilot_symbols = grid->nof_pilot_symbols;
+  oldest->first_symbol      = grid->first_symbol;
+  oldest->nof_symbols       = grid->nof_symbols;
+  oldest->doppler_bin       = doppler_bin;
+  oldest->snr_bin           = snr_bin;
+  memcpy(oldest->pilot_symbols, grid->pilot_symbols, sizeof(uint32_t) * grid->nof_pilot_symbols);
+  if (wiener_2d_time_compute(oldest) < SRSRAN_SUCCESS) {
+    return NULL;
+  }
+  oldest->valid     = true;
+  oldest->last_used = ++q->use_count;
+  q->nof_computed++;
+
+  return oldest;
+}
+
+// z += x * h
+static inline void wiener_2d_mac_ccc(const cf_t* x, cf_t h, cf_t* z, uint32_t len)
+{
+  uint32_t i = 0;
+
+#if SRSRAN_SIMD_CF_SIZE
+  simd_cf_t h_simd = srsran_simd_cf_set1(h);
+  for (; i + SRSRAN_SIMD_CF_SIZE <= len; i += SRSRAN_SIMD_CF_SIZE) {
+    simd_cf_t a = srsran_simd_cfi_loadu(&x[i]);
+    simd_cf_t b = srsran_simd_cfi_loadu(&z[i]);
+    srsran_simd_cfi_storeu(&z[i], srsran_simd_cf_add(b, srsran_simd_cf_prod(a, h_simd)));
+  }
+#endif // SRSRAN_SIMD_CF_SIZE
+
+  for (; i < len; i++) {
+    z[i] += x[i] * h;
+  }
+}
+
+// z += x * h, with real h
+static inline void wiener_2d_mac_cfc(const cf_t* x, float h, cf_t* z, uint32_t len)
+{
+  const float* x_ptr = (const float*)x;
+  float*       z_ptr = (float*)z;
+  uint32_t     n     = 2 * len;
+  uint32_t     i     = 0;
+
+#if SRSRAN_SIMD_F_SIZE
+  simd_f_t h_simd = srsran_simd_f_set1(h);
+  for (; i + SRSRAN_SIMD_F_SIZE <= n; i += SRSRAN_SIMD_F_SIZE) {
+    simd_f_t a = srsran_simd_f_loadu(&x_ptr[i]);
+    simd_f_t b = srsran_simd_f_loadu(&z_ptr[i]);
+    srsran_simd_f_storeu(&z_ptr[i], srsran_simd_f_add(b, srsran_simd_f_mul(a, h_simd)));
+  }
+#endif // SRSRAN_SIMD_F_SIZE
+
+  for (; i < n; i++) {
+    z_ptr[i] += x_ptr[i] * h;
+  }
+}
+
+/* Filters a pilot symbol with windows of pilots. Windows advance half of their length and every window writes the
+ * center of its span, except for the first and the last windows which also write the band edges. */
+static void wiener_2d_freq_apply(const srsran_wiener_2d_freq_filter_t* f,
+                                 const cf_t*                           pilots,
+                                 uint32_t                              nof_pilots,
+                                 cf_t*                                 output)
+{
+  uint32_t nof_pilots_period  = __builtin_popcount(f->mask);
+  uint32_t nof_periods        = nof_pilots / nof_pilots_period;
+  uint32_t nof_window_periods = f->nof_window_pilots / nof_pilots_period;
+  uint32_t step               = SRSRAN_MAX(1, nof_window_periods / 2);
+  uint32_t guard              = (nof_window_periods - step) / 2;
+
+  uint32_t out_begin = 0;
+  uint32_t start     = 0;
+  for (;;) {
+    bool last = (start + nof_window_periods >= nof_periods);
+    if (last) {
+      start = nof_periods - nof_window_periods;
+    }
+    uint32_t out_end = last ? nof_periods : start + guard + step;
+
+    uint32_t    r0 = (out_begin - start) * f->period;
+    uint32_t    n  = (out_end - out_begin) * f->period;
+    cf_t*       y  = &output[out_begin * f->period];
+    const cf_t* p  = &pilots[start * nof_pilots_period];
+
+    srsran_vec_sc_prod_ccc(&f->coef[0][r0], p[0], y, n);
+    for (uint32_t k = 1; k < f->nof_window_pilots; k++) {
+      wiener_2d_mac_ccc(&f->coef[k][r0], p[k], y, n);
+    }
+
+    if (last) {
+      break;
+    }
+    out_begin = out_end;
+    start += step;
+  }
+}
+
+int srsran_wiener_2d_init(srsran_wiener_2d_t* q, uint32_t max_re)
+{
+  if (q == NULL || max_re == 0) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  SRSRAN_MEM_ZERO(q, srsran_wiener_2d_t, 1);
+
+  q->max_re = max_re;
+
+  for (uint32_t i = 0; i < SRSRAN_WIENER_2D_MAX_PILOT_SYMBOLS; i++) {
+    q->freq_estimates[i] = srsran_vec_cf_malloc(max_re);
+    if (q->freq_estimates[i] == NULL) {
+      ERROR("Error allocating memory");
+      return SRSRAN_ERROR;
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_wiener_2d_free(srsran_wiener_2d_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  for (uint32_t i = 0; i < SRSRAN_WIENER_2D_MAX_PILOT_SYMBOLS; i++) {
+    if (q->freq_estimates[i]) {
+      free(q->freq_estimates[i]);
+    }
+  }
+
+  SRSRAN_MEM_ZERO(q, srsran_wiener_2d_t, 1);
+}
+
+static bool wiener_2d_grid_isvalid(const srsran_wiener_2d_t* q, const srsran_wiener_2d_grid_t* grid)
+{
+  if (grid->period == 0 || grid->period > SRSRAN_WIENER_2D_MAX_PERIOD || grid->nof_pilot_symbols == 0 ||
+      grid->nof_pilot_symbols > SRSRAN_WIENER_2D_MAX_PILOT_SYMBOLS || grid->nof_symbols == 0 ||
+      grid->nof_symbols > SRSRAN_WIENER_2D_MAX_SYMBOLS || !isnormal(grid->scs_hz) ||
+      !isnormal(grid->symbol_duration_s)) {
+    return false;
+  }
+
+  int nof_pilots_period = __builtin_popcount(grid->pilot_mask[0]);
+  for (uint32_t i = 0; i < grid->nof_pilot_symbols; i++) {
+    if (grid->pilot_mask[i] == 0 || (grid->pilot_mask[i] >> grid->period) != 0 ||
+        __builtin_popcount(grid->pilot_mask[i]) != nof_pilots_period) {
+      return false;
+    }
+  }
+
+  if (grid->nof_pilots == 0 || grid->nof_pilots % nof_pilots_period != 0 ||
+      (grid->nof_pilots / nof_pilots_period) * grid->period > q->max_re) {
+    return false;
+  }
+
+  return true;
+}
+
+int srsran_wiener_2d_run(srsran_wiener_2d_t*            q,
+                         const srsran_wiener_2d_cfg_t*  cfg,
+                         const srsran_wiener_2d_grid_t* grid,
+                         float                          snr_db,
+                         const cf_t*                    pilots)
+{
+  if (q == NULL || grid == NULL || pilots == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  if (!wiener_2d_grid_isvalid(q, grid)) {
+    ERROR("Invalid pilot grid");
+    return SRSRAN_ERROR;
+  }
+
+  // Select the channel statistics bins
+  float delay_spread_ns = SRSRAN_WIENER_2D_DEFAULT_DELAY_SPREAD_NS;
+  float doppler_hz      = SRSRAN_WIENER_2D_DEFAULT_DOPPLER_HZ;
+  if (cfg != NULL && isnormal(cfg->delay_spread_ns) && cfg->delay_spread_ns > 0.0f) {
+    delay_spread_ns = cfg->delay_spread_ns;
+  }
+  if (cfg != NULL && isnormal(cfg->doppler_hz) && cfg->doppler_hz > 0.0f) {
+    doppler_hz = cfg->doppler_hz;
+  }
+  uint32_t delay_bin   = wiener_2d_log_bin(wiener_2d_delay_spread_bins_ns, WIENER_2D_NOF_DELAY_BINS, delay_spread_ns);
+  uint32_t doppler_bin = wiener_2d_log_bin(wiener_2d_doppler_bins_hz, WIENER_2D_NOF_DOPPLER_BINS, doppler_hz);
+
+  // The window holds an integer number of pattern periods
+  uint32_t nof_pilots_period = __builtin_popcount(grid->pilot_mask[0]);
+  uint32_t nof_window_pilots =
+      (SRSRAN_MIN(SRSRAN_WIENER_2D_WINDOW_PILOTS, grid->nof_pilots) / nof_pilots_period) * nof_pilots_period;
+  if (nof_window_pilots == 0) {
+    ERROR("Too many pilots per period (%d)", nof_pilots_period);
+    return SRSRAN_ERROR;
+  }
+
+  // Filter every pilot symbol in frequency
+  float noise_gain = 0.0f;
+  for (uint32_t i = 0; i < grid->nof_pilot_symbols; i++) {
+    const srsran_wiener_2d_freq_filter_t* f = wiener_2d_get_freq_filter(q,
+                                                                        grid->scs_hz,
+                                                                        grid->period,
+                                                                        grid->pilot_mask[i],
+                                                                        nof_window_pilots,
+                                                                        delay_bin,
+                                                                        wiener_2d_snr_bin(snr_db));
+    if (f == NULL) {
+      return SRSRAN_ERROR;
+    }
+
+    wiener_2d_freq_apply(f, &pilots[grid->nof_pilots * i], grid->nof_pilots, q->freq_estimates[i]);
+    noise_gain += f->noise_gain;
+  }
+  noise_gain /= (float)grid->nof_pilot_symbols;
+
+  // The time filter sees the noise left by the frequency filter
+  q->time_filter =
+      wiener_2d_get_time_filter(q, grid, doppler_bin, wiener_2d_snr_bin(snr_db - srsran_convert_power_to_dB(noise_gain)));
+  if (q->time_filter == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  q->nof_re = (grid->nof_pilots / nof_pilots_period) * grid->period;
+
+  return (int)q->nof_re;
+}
+
+int srsran_wiener_2d_get_symbol(srsran_wiener_2d_t* q, uint32_t symbol_idx, cf_t* ce)
+{
+  if (q == NULL || ce == NULL || q->time_filter == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  const srsran_wiener_2d_time_filter_t* t = q->time_filter;
+  if (symbol_idx < t->first_symbol || symbol_idx >= t->first_symbol + t->nof_symbols) {
+    ERROR("Symbol %d is out of the estimated range", symbol_idx);
+    return SRSRAN_ERROR;
+  }
+
+  const float* coef = t->coef[symbol_idx - t->first_symbol];
+  srsran_vec_sc_prod_cfc(q->freq_estimates[0], coef[0], ce, q->nof_re);
+  for (uint32_t i = 1; i < t->nof_pilot_symbols; i++) {
+    wiener_2d_mac_cfc(q->freq_estimates[i], coef[i], ce, q->nof_re);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_wiener_2d_estimate(srsran_wiener_2d_t*            q,
+                              const srsran_wiener_2d_cfg_t*  cfg,
+                              const srsran_wiener_2d_grid_t* grid,
+                              float                          snr_db,
+                              const cf_t*                    pilots,
+                              cf_t*                          ce)
+{
+  if (ce == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  int nof_re = srsran_wiener_2d_run(q, cfg, grid, snr_db, pilots);
+  if (nof_re < SRSRAN_SUCCESS) {
+    return nof_re;
+  }
+
+  for (uint32_t l = 0; l < grid->nof_symbols; l++) {
+    if (srsran_wiener_2d_get_symbol(q, grid->first_symbol + l, &ce[nof_re * l]) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+  }
+
+  return nof_re;
+}
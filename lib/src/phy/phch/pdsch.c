@@ -409,47 +409,128 @@ clean:
   return ret;
 }
 
-void srsran_pdsch_free(srsran_pdsch_t* q)
+/** Frees the subframe buffers, the ones taken from the scratch arena are only forgotten */
+static void pdsch_free_buffers(srsran_pdsch_t* q)
 {
-  srsran_pdsch_disable_coworker(q);
-
   for (int i = 0; i < SRSRAN_MAX_CODEWORDS; i++) {
-    if (q->e[i]) {
+    if (q->e[i] && !q->scratch) {
       free(q->e[i]);
     }
+    q->e[i] = NULL;
 
-    if (q->d[i]) {
+    if (q->d[i] && !q->scratch) {
       free(q->d[i]);
     }
+    q->d[i] = NULL;
 
-    if (q->csi[i]) {
+    if (q->csi[i] && !q->scratch) {
       free(q->csi[i]);
     }
-
-    if (q->evm_buffer[i]) {
-      srsran_evm_free(q->evm_buffer[i]);
-    }
+    q->csi[i] = NULL;
   }
 
-  /* Free sch objects */
-  srsran_sch_free(&q->dl_sch);
-
   for (int i = 0; i < SRSRAN_MAX_PORTS; i++) {
-    if (q->x[i]) {
+    if (q->x[i] && !q->scratch) {
       free(q->x[i]);
     }
-    if (q->symbols[i]) {
+    q->x[i] = NULL;
+
+    if (q->symbols[i] && !q->scratch) {
       free(q->symbols[i]);
     }
-    if (q->is_ue) {
-      for (int j = 0; j < SRSRAN_MAX_PORTS; j++) {
-        if (q->ce[i][j]) {
-          free(q->ce[i][j]);
-        }
+    q->symbols[i] = NULL;
+
+    for (int j = 0; j < SRSRAN_MAX_PORTS; j++) {
+      if (q->ce[i][j] && !q->scratch) {
+        free(q->ce[i][j]);
+      }
+      q->ce[i][j] = NULL;
+    }
+  }
+}
+
+size_t srsran_pdsch_scratch_size(uint32_t max_prb, uint32_t nof_rx_antennas)
+{
+  uint32_t max_re   = max_prb * MAX_PDSCH_RE(SRSRAN_CP_NORM);
+  uint32_t max_bits = max_re * srsran_mod_bits_x_symbol(SRSRAN_MOD_256QAM);
+
+  // LLR, symbols and CSI of each codeword
+  size_t size = SRSRAN_MAX_CODEWORDS * (SRSRAN_MEM_ARENA_SIZE(int16_t, max_bits) + SRSRAN_MEM_ARENA_SIZE(cf_t, max_re) +
+                                        SRSRAN_MEM_ARENA_SIZE(float, max_re * 2));
+
+  // Layer mapped and precoded symbols of each port, and the channel estimates for the UE
+  size += 2 * SRSRAN_MAX_PORTS * SRSRAN_MEM_ARENA_SIZE(cf_t, max_re);
+  size += SRSRAN_MAX_PORTS * nof_rx_antennas * SRSRAN_MEM_ARENA_SIZE(cf_t, max_re);
+
+  return size;
+}
+
+int srsran_pdsch_set_scratch(srsran_pdsch_t* q, srsran_mem_arena_t* scratch)
+{
+  if (q == NULL || scratch == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  pdsch_free_buffers(q);
+  q->scratch       = scratch;
+  q->scratch_epoch = 0;
+
+  return SRSRAN_SUCCESS;
+}
+
+/** Takes the subframe buffers from the scratch arena, once every arena epoch */
+static int pdsch_scratch(srsran_pdsch_t* q)
+{
+  if (q->scratch == NULL || q->scratch_epoch == q->scratch->epoch) {
+    return SRSRAN_SUCCESS;
+  }
+
+  for (int i = 0; i < SRSRAN_MAX_CODEWORDS; i++) {
+    q->e[i]   = SRSRAN_MEM_ARENA_ALLOC(q->scratch, int16_t, q->max_re * srsran_mod_bits_x_symbol(SRSRAN_MOD_256QAM));
+    q->d[i]   = SRSRAN_MEM_ARENA_ALLOC(q->scratch, cf_t, q->max_re);
+    q->csi[i] = SRSRAN_MEM_ARENA_ALLOC(q->scratch, float, q->max_re * 2);
+    if (!q->e[i] || !q->d[i] || !q->csi[i]) {
+      ERROR("Error taking the PDSCH codewords from the scratch arena");
+      return SRSRAN_ERROR;
+    }
+  }
+
+  for (int i = 0; i < SRSRAN_MAX_PORTS; i++) {
+    q->x[i]       = SRSRAN_MEM_ARENA_ALLOC(q->scratch, cf_t, q->max_re);
+    q->symbols[i] = SRSRAN_MEM_ARENA_ALLOC(q->scratch, cf_t, q->max_re);
+    if (!q->x[i] || !q->symbols[i]) {
+      ERROR("Error taking the PDSCH symbols from the scratch arena");
+      return SRSRAN_ERROR;
+    }
+    for (int j = 0; j < q->nof_rx_antennas && q->is_ue; j++) {
+      q->ce[i][j] = SRSRAN_MEM_ARENA_ALLOC(q->scratch, cf_t, q->max_re);
+      if (!q->ce[i][j]) {
+        ERROR("Error taking the PDSCH channel estimates from the scratch arena");
+        return SRSRAN_ERROR;
       }
     }
   }
 
+  q->scratch_epoch = q->scratch->epoch;
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_pdsch_free(srsran_pdsch_t* q)
+{
+  srsran_pdsch_disable_coworker(q);
+
+  for (int i = 0; i < SRSRAN_MAX_CODEWORDS; i++) {
+    if (q->evm_buffer[i]) {
+      srsran_evm_free(q->evm_buffer[i]);
+    }
+  }
+
+  /* Free sch objects */
+  srsran_sch_free(&q->dl_sch);
+
+  pdsch_free_buffers(q);
+
   for (int i = 0; i < SRSRAN_MOD_NITEMS; i++) {
     srsran_modem_table_free(&q->mod[i]);
   }
@@ -462,8 +543,9 @@ int srsran_pdsch_set_cell(srsran_pdsch_t* q, srsran_cell_t cell)
   int ret = SRSRAN_ERROR_INVALID_INPUTS;
 
   if (q != NULL && srsran_cell_isvalid(&cell)) {
-    q->cell   = cell;
-    q->max_re = q->cell.nof_prb * MAX_PDSCH_RE(q->cell.cp);
+    q->cell          = cell;
+    q->max_re        = q->cell.nof_prb * MAX_PDSCH_RE(q->cell.cp);
+    q->scratch_epoch = 0;
 
     // Resize EVM buffer, only for UE
     if (q->is_ue) {
@@ -818,6 +900,10 @@ int srsran_pdsch_decode(srsran_pdsch_t*        q,
 
     float noise_estimate = cfg->decoder_type == SRSRAN_MIMO_DECODER_ZF ? 0 : channel->noise_estimate;
 
+    if (pdsch_scratch(q) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+
     INFO("Decoding PDSCH SF: %d, RNTI: 0x%x, NofSymbols: %d, C_prb=%d, mod=%s, nof_layers=%d, nof_tb=%d",
          sf->tti % 10,
          cfg->rnti,
@@ -1054,6 +1140,10 @@ int srsran_pdsch_encode(srsran_pdsch_t*     q,
       return SRSRAN_ERROR_INVALID_INPUTS;
     }
 
+    if (pdsch_scratch(q) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+
     float rho_a = apply_power_allocation(q, cfg, sf_symbols);
 
     /* Implementation of 3GPP 36.212 Table 5.3.3.1.5-1 and Table 5.3.3.1.5-2 */
@@ -26,6 +26,55 @@
 #include "srsran/phy/mimo/precoding.h"
 #include "srsran/phy/modem/demod_soft.h"
 
+// Maximum number of RE mapped on a codeword, a codeword is mapped on up to 4 layers
+static uint32_t pdsch_nr_cw_max_re(uint32_t max_prb, uint32_t max_layers)
+{
+  return SRSRAN_SLOT_LEN_RE_NR(max_prb) * SRSRAN_MIN(max_layers, 4);
+}
+
+size_t srsran_pdsch_nr_scratch_size(const srsran_pdsch_nr_args_t* args)
+{
+  if (args == NULL) {
+    return 0;
+  }
+
+  uint32_t max_cw = (args->max_layers > 5) ? 2 : 1;
+  uint32_t cw_re  = pdsch_nr_cw_max_re(args->max_prb, args->max_layers);
+
+  return args->max_layers * SRSRAN_MEM_ARENA_SIZE(cf_t, SRSRAN_SLOT_LEN_RE_NR(args->max_prb)) +
+         max_cw * (SRSRAN_MEM_ARENA_SIZE(uint8_t, cw_re * SRSRAN_MAX_QM) + SRSRAN_MEM_ARENA_SIZE(cf_t, cw_re));
+}
+
+// Takes the per-slot buffers from the scratch arena, once every arena epoch
+static int pdsch_nr_scratch(srsran_pdsch_nr_t* q)
+{
+  if (q->scratch == NULL || q->scratch_epoch == q->scratch->epoch) {
+    return SRSRAN_SUCCESS;
+  }
+
+  uint32_t cw_re = pdsch_nr_cw_max_re(q->max_prb, q->max_layers);
+  for (uint32_t i = 0; i < q->max_layers; i++) {
+    q->x[i] = SRSRAN_MEM_ARENA_ALLOC(q->scratch, cf_t, SRSRAN_SLOT_LEN_RE_NR(q->max_prb));
+    if (q->x[i] == NULL) {
+      ERROR("Error taking the PDSCH symbols from the scratch arena");
+      return SRSRAN_ERROR;
+    }
+  }
+
+  for (uint32_t i = 0; i < q->max_cw; i++) {
+    q->b[i] = SRSRAN_MEM_ARENA_ALLOC(q->scratch, uint8_t, cw_re * SRSRAN_MAX_QM);
+    q->d[i] = SRSRAN_MEM_ARENA_ALLOC(q->scratch, cf_t, cw_re);
+    if (q->b[i] == NULL || q->d[i] == NULL) {
+      ERROR("Error taking the PDSCH codewords from the scratch arena");
+      return SRSRAN_ERROR;
+    }
+  }
+
+  q->scratch_epoch = q->scratch->epoch;
+
+  return SRSRAN_SUCCESS;
+}
+
 static int pdsch_nr_alloc(srsran_pdsch_nr_t* q, uint32_t max_mimo_layers, uint32_t max_prb)
 {
   // Reallocate symbols if necessary
@@ -33,6 +82,12 @@ static int pdsch_nr_alloc(srsran_pdsch_nr_t* q, uint32_t max_mimo_layers, uint32
     q->max_layers = max_mimo_layers;
     q->max_prb    = max_prb;
 
+    // The scratch buffers are taken again with the new sizes
+    if (q->scratch != NULL) {
+      q->scratch_epoch = 0;
+      return SRSRAN_SUCCESS;
+    }
+
     // Free current allocations
     for (uint32_t i = 0; i < SRSRAN_MAX_LAYERS_NR; i++) {
       if (q->x[i] != NULL) {
@@ -56,6 +111,7 @@ static int pdsch_nr_alloc(srsran_pdsch_nr_t* q, uint32_t max_mimo_layers, uint32
 int pdsch_nr_init_common(srsran_pdsch_nr_t* q, const srsran_pdsch_nr_args_t* args)
 {
   SRSRAN_MEM_ZERO(q, srsran_pdsch_nr_t, 1);
+  q->scratch = args->scratch;
 
   for (srsran_mod_t mod = SRSRAN_MOD_BPSK; mod < SRSRAN_MOD_NITEMS; mod++) {
     if (srsran_modem_table_lte(&q->modem_tables[mod], mod) < SRSRAN_SUCCESS) {
@@ -132,9 +188,10 @@ int srsran_pdsch_nr_set_carrier(srsran_pdsch_nr_t* q, const srsran_carrier_nr_t*
   // Allocate code words according to table 7.3.1.3-1
   uint32_t max_cw = (q->max_layers > 5) ? 2 : 1;
   if (q->max_cw < max_cw) {
-    q->max_cw = max_cw;
+    q->max_cw        = max_cw;
+    q->scratch_epoch = 0;
 
-    for (uint32_t i = 0; i < max_cw; i++) {
+    for (uint32_t i = 0; i < max_cw && q->scratch == NULL; i++) {
       if (q->b[i] == NULL) {
         q->b[i] = srsran_vec_u8_malloc(SRSRAN_SLOT_MAX_NOF_BITS_NR);
         if (q->b[i] == NULL) {
@@ -171,6 +228,13 @@ void srsran_pdsch_nr_free(srsran_pdsch_nr_t* q)
     return;
   }
 
+  // The buffers taken from the scratch arena are not freed
+  if (q->scratch != NULL) {
+    SRSRAN_MEM_ZERO(q->b, uint8_t*, SRSRAN_MAX_CODEWORDS);
+    SRSRAN_MEM_ZERO(q->d, cf_t*, SRSRAN_MAX_CODEWORDS);
+    SRSRAN_MEM_ZERO(q->x, cf_t*, SRSRAN_MAX_LAYERS_NR);
+  }
+
   for (uint32_t cw = 0; cw < SRSRAN_MAX_CODEWORDS; cw++) {
     if (q->b[cw]) {
       free(q->b[cw]);
@@ -372,6 +436,10 @@ int srsran_pdsch_nr_encode(srsran_pdsch_nr_t*           q,
     return SRSRAN_ERROR;
   }
 
+  if (pdsch_nr_scratch(q) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
   // Compute DMRS pattern
   if (srsran_dmrs_sch_rvd_re_pattern(&cfg->dmrs, grant, &q->dmrs_re_pattern) < SRSRAN_SUCCESS) {
     ERROR("Error computing DMRS pattern");
@@ -500,6 +568,10 @@ int srsran_pdsch_nr_decode(srsran_pdsch_nr_t*           q,
     gettimeofday(&t[1], NULL);
   }
 
+  if (pdsch_nr_scratch(q) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
   // Compute DMRS pattern
   if (srsran_dmrs_sch_rvd_re_pattern(&cfg->dmrs, grant, &q->dmrs_re_pattern) < SRSRAN_SUCCESS) {
     ERROR("Error computing DMRS pattern");
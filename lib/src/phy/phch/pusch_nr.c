@@ -27,6 +27,71 @@
 #include "srsran/phy/phch/ra_nr.h"
 #include "srsran/phy/phch/uci_cfg.h"
 
+// Maximum number of bits mapped on a codeword, a codeword is mapped on up to 4 layers
+static uint32_t pusch_nr_cw_max_bits(uint32_t max_prb, uint32_t max_layers)
+{
+  return SRSRAN_SLOT_LEN_RE_NR(max_prb) * SRSRAN_MIN(max_layers, 4) * SRSRAN_MAX_QM;
+}
+
+size_t srsran_pusch_nr_scratch_size(const srsran_pusch_nr_args_t* args)
+{
+  if (args == NULL) {
+    return 0;
+  }
+
+  uint32_t max_cw  = (args->max_layers > 5) ? 2 : 1;
+  uint32_t cw_bits = pusch_nr_cw_max_bits(args->max_prb, args->max_layers);
+
+  // Symbols, codewords and the four UCI multiplexing buffers with their positions
+  return args->max_layers * SRSRAN_MEM_ARENA_SIZE(cf_t, SRSRAN_SLOT_LEN_RE_NR(args->max_prb)) +
+         max_cw * (SRSRAN_MEM_ARENA_SIZE(uint8_t, cw_bits) + SRSRAN_MEM_ARENA_SIZE(cf_t, cw_bits / SRSRAN_MAX_QM)) +
+         4 * (SRSRAN_MEM_ARENA_SIZE(uint8_t, cw_bits) + SRSRAN_MEM_ARENA_SIZE(uint32_t, cw_bits));
+}
+
+// Takes the per-slot buffers from the scratch arena, once every arena epoch
+static int pusch_nr_scratch(srsran_pusch_nr_t* q)
+{
+  if (q->scratch == NULL || q->scratch_epoch == q->scratch->epoch) {
+    return SRSRAN_SUCCESS;
+  }
+
+  uint32_t cw_bits = pusch_nr_cw_max_bits(q->max_prb, q->max_layers);
+  for (uint32_t i = 0; i < q->max_layers; i++) {
+    q->x[i] = SRSRAN_MEM_ARENA_ALLOC(q->scratch, cf_t, SRSRAN_SLOT_LEN_RE_NR(q->max_prb));
+    if (q->x[i] == NULL) {
+      ERROR("Error taking the PUSCH symbols from the scratch arena");
+      return SRSRAN_ERROR;
+    }
+  }
+
+  for (uint32_t i = 0; i < q->max_cw; i++) {
+    q->b[i] = SRSRAN_MEM_ARENA_ALLOC(q->scratch, uint8_t, cw_bits);
+    q->d[i] = SRSRAN_MEM_ARENA_ALLOC(q->scratch, cf_t, cw_bits / SRSRAN_MAX_QM);
+    if (q->b[i] == NULL || q->d[i] == NULL) {
+      ERROR("Error taking the PUSCH codewords from the scratch arena");
+      return SRSRAN_ERROR;
+    }
+  }
+
+  q->g_ulsch   = SRSRAN_MEM_ARENA_ALLOC(q->scratch, uint8_t, cw_bits);
+  q->g_ack     = SRSRAN_MEM_ARENA_ALLOC(q->scratch, uint8_t, cw_bits);
+  q->g_csi1    = SRSRAN_MEM_ARENA_ALLOC(q->scratch, uint8_t, cw_bits);
+  q->g_csi2    = SRSRAN_MEM_ARENA_ALLOC(q->scratch, uint8_t, cw_bits);
+  q->pos_ulsch = SRSRAN_MEM_ARENA_ALLOC(q->scratch, uint32_t, cw_bits);
+  q->pos_ack   = SRSRAN_MEM_ARENA_ALLOC(q->scratch, uint32_t, cw_bits);
+  q->pos_csi1  = SRSRAN_MEM_ARENA_ALLOC(q->scratch, uint32_t, cw_bits);
+  q->pos_csi2  = SRSRAN_MEM_ARENA_ALLOC(q->scratch, uint32_t, cw_bits);
+  if (q->g_ulsch == NULL || q->g_ack == NULL || q->g_csi1 == NULL || q->g_csi2 == NULL || q->pos_ulsch == NULL ||
+      q->pos_ack == NULL || q->pos_csi1 == NULL || q->pos_csi2 == NULL) {
+    ERROR("Error taking the PUSCH UCI multiplexing buffers from the scratch arena");
+    return SRSRAN_ERROR;
+  }
+
+  q->scratch_epoch = q->scratch->epoch;
+
+  return SRSRAN_SUCCESS;
+}
+
 static int pusch_nr_alloc(srsran_pusch_nr_t* q, uint32_t max_mimo_layers, uint32_t max_prb)
 {
   // Reallocate symbols if necessary
@@ -34,6 +99,12 @@ static int pusch_nr_alloc(srsran_pusch_nr_t* q, uint32_t max_mimo_layers, uint32
     q->max_layers = max_mimo_layers;
     q->max_prb    = max_prb;
 
+    // The scratch buffers are taken again with the new sizes
+    if (q->scratch != NULL) {
+      q->scratch_epoch = 0;
+      return SRSRAN_SUCCESS;
+    }
+
     // Free current allocations
     for (uint32_t i = 0; i < SRSRAN_MAX_LAYERS_NR; i++) {
       if (q->x[i] != NULL) {
@@ -56,6 +127,9 @@ static int pusch_nr_alloc(srsran_pusch_nr_t* q, uint32_t max_mimo_layers, uint32
 
 int pusch_nr_init_common(srsran_pusch_nr_t* q, const srsran_pusch_nr_args_t* args)
 {
+  q->scratch       = args->scratch;
+  q->scratch_epoch = 0;
+
   for (srsran_mod_t mod = SRSRAN_MOD_BPSK; mod < SRSRAN_MOD_NITEMS; mod++) {
     if (srsran_modem_table_lte(&q->modem_tables[mod], mod) < SRSRAN_SUCCESS) {
       ERROR("Error initialising modem table for %s", srsran_mod_string(mod));
@@ -75,6 +149,13 @@ int pusch_nr_init_common(srsran_pusch_nr_t* q, const srsran_pusch_nr_args_t* arg
     return SRSRAN_ERROR;
   }
 
+  q->meas_time_en = args->measure_time;
+
+  // The UCI multiplexing buffers are taken from the scratch arena every slot
+  if (q->scratch != NULL) {
+    return SRSRAN_SUCCESS;
+  }
+
   q->g_ulsch = srsran_vec_u8_malloc(SRSRAN_SLOT_MAX_NOF_BITS_NR);
   q->g_ack   = srsran_vec_u8_malloc(SRSRAN_SLOT_MAX_NOF_BITS_NR);
   q->g_csi1  = srsran_vec_u8_malloc(SRSRAN_SLOT_MAX_NOF_BITS_NR);
@@ -93,8 +174,6 @@ int pusch_nr_init_common(srsran_pusch_nr_t* q, const srsran_pusch_nr_args_t* arg
     return SRSRAN_ERROR;
   }
 
-  q->meas_time_en = args->measure_time;
-
   return SRSRAN_SUCCESS;
 }
 
@@ -154,9 +233,10 @@ int srsran_pusch_nr_set_carrier(srsran_pusch_nr_t* q, const srsran_carrier_nr_t*
   // Allocate code words according to table 7.3.1.3-1
   uint32_t max_cw = (q->max_layers > 5) ? 2 : 1;
   if (q->max_cw < max_cw) {
-    q->max_cw = max_cw;
+    q->max_cw        = max_cw;
+    q->scratch_epoch = 0;
 
-    for (uint32_t i = 0; i < max_cw; i++) {
+    for (uint32_t i = 0; i < max_cw && q->scratch == NULL; i++) {
       if (q->b[i] == NULL) {
         q->b[i] = srsran_vec_u8_malloc(SRSRAN_SLOT_MAX_NOF_BITS_NR);
         if (q->b[i] == NULL) {
@@ -193,6 +273,21 @@ void srsran_pusch_nr_free(srsran_pusch_nr_t* q)
     return;
   }
 
+  // The buffers taken from the scratch arena are not freed
+  if (q->scratch != NULL) {
+    SRSRAN_MEM_ZERO(q->b, uint8_t*, SRSRAN_MAX_CODEWORDS);
+    SRSRAN_MEM_ZERO(q->d, cf_t*, SRSRAN_MAX_CODEWORDS);
+    SRSRAN_MEM_ZERO(q->x, cf_t*, SRSRAN_MAX_LAYERS_NR);
+    q->g_ulsch   = NULL;
+    q->g_ack     = NULL;
+    q->g_csi1    = NULL;
+    q->g_csi2    = NULL;
+    q->pos_ulsch = NULL;
+    q->pos_ack   = NULL;
+    q->pos_csi1  = NULL;
+    q->pos_csi2  = NULL;
+  }
+
   if (q->g_ulsch != NULL) {
     free(q->g_ulsch);
   }
@@ -728,6 +823,10 @@ int srsran_pusch_nr_encode(srsran_pusch_nr_t*            q,
     return SRSRAN_ERROR;
   }
 
+  if (pusch_nr_scratch(q) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
   // Compute DMRS pattern
   if (srsran_dmrs_sch_rvd_re_pattern(&cfg->dmrs, grant, &q->dmrs_re_pattern) < SRSRAN_SUCCESS) {
     ERROR("Error computing DMRS pattern");
@@ -950,6 +1049,10 @@ int srsran_pusch_nr_decode(srsran_pusch_nr_t*           q,
     return SRSRAN_ERROR;
   }
 
+  if (pusch_nr_scratch(q) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
   // Compute DMRS pattern
   if (srsran_dmrs_sch_rvd_re_pattern(&cfg->dmrs, grant, &q->dmrs_re_pattern) < SRSRAN_SUCCESS) {
     ERROR("Error computing DMRS pattern");
@@ -707,6 +707,10 @@ static int ra_dl_dmrs(const srsran_sch_hl_cfg_nr_t* hl_cfg, const srsran_dci_dl_
   }
   cfg->grant.nof_dmrs_cdm_groups_without_data = (uint32_t)n;
 
+  // Receiver channel estimator selection
+  cfg->dmrs.mmse_enable = hl_cfg->dmrs_mmse_enable;
+  cfg->dmrs.mmse        = hl_cfg->dmrs_mmse;
+
   // Set DMRS power offset Table 6.2.2-1: The ratio of PUSCH EPRE to DM-RS EPRE
   if (ra_nr_dmrs_power_offset(&cfg->grant) < SRSRAN_SUCCESS) {
     ERROR("Error setting DMRS power offset");
@@ -881,6 +885,10 @@ ra_ul_dmrs(const srsran_sch_hl_cfg_nr_t* pusch_hl_cfg, const srsran_dci_ul_nr_t*
   }
   cfg->grant.nof_dmrs_cdm_groups_without_data = (uint32_t)n;
 
+  // Receiver channel estimator selection
+  cfg->dmrs.mmse_enable = pusch_hl_cfg->dmrs_mmse_enable;
+  cfg->dmrs.mmse        = pusch_hl_cfg->dmrs_mmse;
+
   // Set DMRS power offset Table 6.2.2-1: The ratio of PUSCH EPRE to DM-RS EPRE
   if (ra_nr_dmrs_power_offset(&cfg->grant) < SRSRAN_SUCCESS) {
     ERROR("Error setting DMRS power offset");
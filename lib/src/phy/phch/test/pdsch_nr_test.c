@@ -35,22 +35,24 @@ static uint32_t            n_prb     = 0;  // Set to 0 for steering
 static uint32_t            mcs       = 30; // Set to 30 for steering
 static srsran_sch_cfg_nr_t pdsch_cfg = {};
 static uint16_t            rnti      = 0x1234;
+static bool                use_arena = false;
 
 void usage(char* prog)
 {
-  printf("Usage: %s [pTL] \n", prog);
+  printf("Usage: %s [pTLS] \n", prog);
   printf("\t-p Number of grant PRB, set to 0 for steering [Default %d]\n", n_prb);
   printf("\t-m MCS PRB, set to >28 for steering [Default %d]\n", mcs);
   printf("\t-T Provide MCS table (64qam, 256qam, 64qamLowSE) [Default %s]\n",
          srsran_mcs_table_to_str(pdsch_cfg.sch_cfg.mcs_table));
   printf("\t-L Provide number of layers [Default %d]\n", carrier.max_mimo_layers);
+  printf("\t-S Take the PDSCH buffers from a scratch arena reset every slot [Default %s]\n", use_arena ? "yes" : "no");
   printf("\t-v [set srsran_verbose to debug, default none]\n");
 }
 
 int parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "pmTLv")) != -1) {
+  while ((opt = getopt(argc, argv, "pmTLSv")) != -1) {
     switch (opt) {
       case 'p':
         n_prb = (uint32_t)strtol(argv[optind], NULL, 10);
@@ -64,6 +66,9 @@ int parse_args(int argc, char** argv)
       case 'L':
         carrier.max_mimo_layers = (uint32_t)strtol(argv[optind], NULL, 10);
         break;
+      case 'S':
+        use_arena = true;
+        break;
       case 'v':
         increase_srsran_verbose_level();
         break;
@@ -84,6 +89,7 @@ int main(int argc, char** argv)
   srsran_chest_dl_res_t chest     = {};
   srsran_pdsch_res_nr_t pdsch_res = {};
   srsran_random_t       rand_gen  = srsran_random_init(1234);
+  srsran_mem_arena_t    scratch   = {};
 
   uint8_t* data_tx[SRSRAN_MAX_TB]           = {};
   uint8_t* data_rx[SRSRAN_MAX_CODEWORDS]    = {};
@@ -100,6 +106,17 @@ int main(int argc, char** argv)
   pdsch_args.sch.disable_simd       = false;
   pdsch_args.measure_evm            = true;
 
+  if (use_arena) {
+    // Both PDSCH take their buffers from the same arena
+    pdsch_args.max_prb    = carrier.nof_prb;
+    pdsch_args.max_layers = carrier.max_mimo_layers;
+    if (srsran_mem_arena_init(&scratch, 2 * srsran_pdsch_nr_scratch_size(&pdsch_args)) < SRSRAN_SUCCESS) {
+      ERROR("Error initiating scratch arena");
+      goto clean_exit;
+    }
+    pdsch_args.scratch = &scratch;
+  }
+
   if (srsran_pdsch_nr_init_enb(&pdsch_tx, &pdsch_args) < SRSRAN_SUCCESS) {
     ERROR("Error initiating PDSCH for Tx");
     goto clean_exit;
@@ -187,6 +204,9 @@ int main(int argc, char** argv)
 
   for (n_prb = n_prb_start; n_prb < n_prb_end; n_prb++) {
     for (mcs = mcs_start; mcs < mcs_end; mcs++) {
+      // Every slot starts with the scratch buffers released
+      srsran_mem_arena_reset(&scratch);
+
       for (uint32_t n = 0; n < SRSRAN_MAX_PRB_NR; n++) {
         pdsch_cfg.grant.prb_idx[n] = (n < n_prb);
       }
@@ -280,6 +300,7 @@ clean_exit:
   srsran_random_free(rand_gen);
   srsran_pdsch_nr_free(&pdsch_tx);
   srsran_pdsch_nr_free(&pdsch_rx);
+  srsran_mem_arena_free(&scratch);
   for (uint32_t i = 0; i < SRSRAN_MAX_CODEWORDS; i++) {
     if (data_tx[i]) {
       free(data_tx[i]);
@@ -55,6 +55,7 @@ static char*       input_file                   = NULL;
 static int         M                            = 1;
 static bool        enable_256qam                = false;
 static bool        use_8_bit                    = false;
+static bool        use_arena                    = false;
 
 void usage(char* prog)
 {
@@ -76,6 +77,7 @@ void usage(char* prog)
   printf("\t-p pmi (multiplex only)  [Default %d]\n", pmi);
   printf("\t-w Swap Transport Blocks\n");
   printf("\t-j Enable PDSCH decoder coworker\n");
+  printf("\t-S Take the PDSCH buffers from a scratch arena\n");
   printf("\t-v [set srsran_verbose to debug, default none]\n");
   printf("\t-q Enable/Disable 256QAM modulation (default %s)\n", enable_256qam ? "enabled" : "disabled");
 }
@@ -83,7 +85,7 @@ void usage(char* prog)
 void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "fmMcsbrtRFpnqawvXxj")) != -1) {
+  while ((opt = getopt(argc, argv, "fmMcsbrtRFpnqawvXxjS")) != -1) {
     switch (opt) {
       case 'f':
         input_file = argv[optind];
@@ -136,6 +138,9 @@ void parse_args(int argc, char** argv)
       case 'j':
         enable_coworker = true;
         break;
+      case 'S':
+        use_arena = true;
+        break;
       case 'v':
         increase_srsran_verbose_level();
         break;
@@ -209,6 +214,7 @@ int main(int argc, char** argv)
   srsran_pdsch_res_t      pdsch_res[SRSRAN_MAX_CODEWORDS];
   srsran_random_t         random_gen = srsran_random_init(0x1234);
   srsran_crc_t            crc_tb;
+  srsran_mem_arena_t      scratch = {};
 
   /* Initialise to zeros */
   ZERO_OBJECT(softbuffers_tx);
@@ -330,10 +336,22 @@ int main(int argc, char** argv)
     }
   }
 
+  // The transmitter and the receiver take their buffers from the same arena
+  if (use_arena && srsran_mem_arena_init(&scratch,
+                                         srsran_pdsch_scratch_size(cell.nof_prb, nof_rx_antennas) +
+                                             srsran_pdsch_scratch_size(cell.nof_prb, 0))) {
+    ERROR("Error creating scratch arena");
+    goto quit;
+  }
+
   if (srsran_pdsch_init_ue(&pdsch_rx, cell.nof_prb, nof_rx_antennas)) {
     ERROR("Error creating PDSCH object");
     goto quit;
   }
+  if (use_arena && srsran_pdsch_set_scratch(&pdsch_rx, &scratch)) {
+    ERROR("Error setting PDSCH scratch arena");
+    goto quit;
+  }
   if (srsran_pdsch_set_cell(&pdsch_rx, cell)) {
     ERROR("Error creating PDSCH object");
     goto quit;
@@ -382,6 +400,10 @@ int main(int argc, char** argv)
       ERROR("Error creating PDSCH object");
       goto quit;
     }
+    if (use_arena && srsran_pdsch_set_scratch(&pdsch_tx, &scratch)) {
+      ERROR("Error setting PDSCH scratch arena");
+      goto quit;
+    }
     if (srsran_pdsch_set_cell(&pdsch_tx, cell)) {
       ERROR("Error creating PDSCH object");
       goto quit;
@@ -564,6 +586,7 @@ quit:
   srsran_chest_dl_free(&chest);
   srsran_pdsch_free(&pdsch_tx);
   srsran_pdsch_free(&pdsch_rx);
+  srsran_mem_arena_free(&scratch);
   for (uint32_t i = 0; i < SRSRAN_MAX_CODEWORDS; i++) {
     srsran_softbuffer_tx_free(softbuffers_tx[i]);
     if (softbuffers_tx[i]) {
@@ -35,10 +35,11 @@ static srsran_sch_cfg_nr_t pusch_cfg    = {};
 static uint16_t            rnti         = 0x1234;
 static uint32_t            nof_ack_bits = 0;
 static uint32_t            nof_csi_bits = 0;
+static bool                use_arena    = false;
 
 void usage(char* prog)
 {
-  printf("Usage: %s [pTL] \n", prog);
+  printf("Usage: %s [pTLACS] \n", prog);
   printf("\t-p Number of grant PRB, set to 0 for steering [Default %d]\n", n_prb);
   printf("\t-m MCS PRB, set to >28 for steering [Default %d]\n", mcs);
   printf("\t-T Provide MCS table (64qam, 256qam, 64qamLowSE) [Default %s]\n",
@@ -46,13 +47,14 @@ void usage(char* prog)
   printf("\t-L Provide number of layers [Default %d]\n", carrier.max_mimo_layers);
   printf("\t-A Provide a number of HARQ-ACK bits [Default %d]\n", nof_ack_bits);
   printf("\t-C Provide a number of CSI bits [Default %d]\n", nof_csi_bits);
+  printf("\t-S Take the PUSCH buffers from a scratch arena reset every slot [Default %s]\n", use_arena ? "yes" : "no");
   printf("\t-v [set srsran_verbose to debug, default none]\n");
 }
 
 int parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "pmTLACv")) != -1) {
+  while ((opt = getopt(argc, argv, "pmTLACSv")) != -1) {
     switch (opt) {
       case 'p':
         n_prb = (uint32_t)strtol(argv[optind], NULL, 10);
@@ -72,6 +74,9 @@ int parse_args(int argc, char** argv)
       case 'C':
         nof_csi_bits = (uint32_t)strtol(argv[optind], NULL, 10);
         break;
+      case 'S':
+        use_arena = true;
+        break;
       case 'v':
         increase_srsran_verbose_level();
         break;
@@ -91,6 +96,7 @@ int main(int argc, char** argv)
   srsran_pusch_nr_t     pusch_rx = {};
   srsran_chest_dl_res_t chest    = {};
   srsran_random_t       rand_gen = srsran_random_init(1234);
+  srsran_mem_arena_t    scratch  = {};
 
   srsran_pusch_data_nr_t data_tx                          = {};
   srsran_pusch_res_nr_t  data_rx                          = {};
@@ -107,6 +113,17 @@ int main(int argc, char** argv)
   pusch_args.sch.disable_simd       = false;
   pusch_args.measure_evm            = true;
 
+  if (use_arena) {
+    // Both PUSCH take their buffers from the same arena
+    pusch_args.max_prb    = carrier.nof_prb;
+    pusch_args.max_layers = carrier.max_mimo_layers;
+    if (srsran_mem_arena_init(&scratch, 2 * srsran_pusch_nr_scratch_size(&pusch_args)) < SRSRAN_SUCCESS) {
+      ERROR("Error initiating scratch arena");
+      goto clean_exit;
+    }
+    pusch_args.scratch = &scratch;
+  }
+
   if (srsran_pusch_nr_init_ue(&pusch_tx, &pusch_args) < SRSRAN_SUCCESS) {
     ERROR("Error initiating PUSCH for Tx");
     goto clean_exit;
@@ -198,6 +215,9 @@ int main(int argc, char** argv)
 
   for (n_prb = n_prb_start; n_prb < n_prb_end; n_prb++) {
     for (mcs = mcs_start; mcs < mcs_end; mcs++) {
+      // Every slot starts with the scratch buffers released
+      srsran_mem_arena_reset(&scratch);
+
       for (uint32_t n = 0; n < SRSRAN_MAX_PRB_NR; n++) {
         pusch_cfg.grant.prb_idx[n] = (n < n_prb);
       }
@@ -389,6 +409,7 @@ clean_exit:
   srsran_random_free(rand_gen);
   srsran_pusch_nr_free(&pusch_tx);
   srsran_pusch_nr_free(&pusch_rx);
+  srsran_mem_arena_free(&scratch);
   for (uint32_t i = 0; i < SRSRAN_MAX_CODEWORDS; i++) {
     if (data_tx.payload[i]) {
       free(data_tx.payload[i]);
@@ -291,8 +291,8 @@ int rf_file_open_file(void** h, FILE** rx_files, FILE** tx_files, uint32_t nof_c
 
     // rx_format, tx_format
     // TODO: add other formats
-    rx_opts.sample_format = FILERF_TYPE_FC32;
-    tx_opts.sample_format = FILERF_TYPE_FC32;
+    rx_opts.sample_format = SRSRAN_RF_SAMPLE_FORMAT_FC32;
+    tx_opts.sample_format = SRSRAN_RF_SAMPLE_FORMAT_FC32;
 
     update_rates(handler, 1.92e6);
 
@@ -628,6 +628,14 @@ int rf_file_recv_with_time_multi(void*    h,
       }
     }
 
+    // Load the gain, it also incorporates the decimation factor. Without decimation it is applied while converting the
+    // read samples
+    pthread_mutex_lock(&handler->rx_gain_mutex);
+    float scale = srsran_convert_dB_to_amplitude(handler->rx_gain);
+    pthread_mutex_unlock(&handler->rx_gain_mutex);
+    scale         = scale / decim_factor;
+    float rx_gain = (decim_factor == 1) ? scale : 1.0f;
+
     // copy from rx buffer as many samples as requested into provided buffer
     bool    completed                  = false;
     int32_t count[SRSRAN_MAX_CHANNELS] = {};
@@ -641,7 +649,7 @@ int rf_file_recv_with_time_multi(void*    h,
         // Completed condition
         if (count[i] < nsamples_baserate && handler->receiver[i].running) {
           // Keep receiving
-          int32_t n = rf_file_rx_baseband(&handler->receiver[i], &ptr[count[i]], nsamples_baserate - count[i]);
+          int32_t n = rf_file_rx_baseband(&handler->receiver[i], &ptr[count[i]], nsamples_baserate - count[i], rx_gain);
           if (n > 0) {
             // No error
             count[i] += n;
@@ -690,15 +698,12 @@ int rf_file_recv_with_time_multi(void*    h,
       }
     }
 
-    // Set gain
-    pthread_mutex_lock(&handler->rx_gain_mutex);
-    float scale = srsran_convert_dB_to_amplitude(handler->rx_gain);
-    pthread_mutex_unlock(&handler->rx_gain_mutex);
-    // scale shall also incorporate decim_factor
-    scale = scale / decim_factor;
-    for (uint32_t c = 0; c < handler->nof_channels; c++) {
-      if (buffers[c]) {
-        srsran_vec_sc_prod_cfc(buffers[c], scale, buffers[c], nsamples);
+    // Set gain if it was not applied while converting
+    if (decim_factor != 1) {
+      for (uint32_t c = 0; c < handler->nof_channels; c++) {
+        if (buffers[c]) {
+          srsran_vec_sc_prod_cfc(buffers[c], scale, buffers[c], nsamples);
+        }
       }
     }
 
@@ -69,12 +69,20 @@ clean_exit:
   return ret;
 }
 
-int rf_file_rx_baseband(rf_file_rx_t* q, cf_t* buffer, uint32_t nsamples)
+int rf_file_rx_baseband(rf_file_rx_t* q, cf_t* buffer, uint32_t nsamples, float gain)
 {
-  uint32_t sample_sz = sizeof(cf_t);
+  void*    dst_buffer = buffer;
+  uint32_t sample_sz  = srsran_rf_sample_format_nof_bytes(q->sample_format, 1);
+  if (q->sample_format != SRSRAN_RF_SAMPLE_FORMAT_FC32) {
+    dst_buffer = q->temp_buffer_convert;
+  }
 
-  int ret = fread(buffer, sample_sz, nsamples, q->file);
+  int ret = fread(dst_buffer, sample_sz, nsamples, q->file);
   if (ret > 0) {
+    // Convert and scale in a single pass, fc32 is scaled in place
+    if (q->sample_format != SRSRAN_RF_SAMPLE_FORMAT_FC32 || gain != 1.0f) {
+      srsran_rf_convert_to_cf(q->sample_format, dst_buffer, buffer, gain, (uint32_t)ret);
+    }
     return ret;
   } else {
     return SRSRAN_ERROR_RX_EOF;
@@ -23,6 +23,7 @@
 #define SRSRAN_RF_FILE_IMP_TRX_H
 
 #include "srsran/config.h"
+#include "srsran/phy/rf/rf_sample_format.h"
 #include <math.h>
 #include <pthread.h>
 #include <stdbool.h>
@@ -40,39 +41,37 @@
 #define FILE_MAX_GAIN_DB (30.0f)
 #define FILE_MIN_GAIN_DB (0.0f)
 
-typedef enum { FILERF_TYPE_FC32 = 0, FILERF_TYPE_SC16 } rf_file_format_t;
-
 typedef struct {
-  char             id[FILE_ID_STRLEN];
-  rf_file_format_t sample_format;
-  FILE*            file;
-  uint64_t         nsamples;
-  bool             running;
-  pthread_mutex_t  mutex;
-  cf_t*            zeros;
-  void*            temp_buffer_convert;
-  uint32_t         frequency_mhz;
-  int32_t          sample_offset;
+  char                      id[FILE_ID_STRLEN];
+  srsran_rf_sample_format_t sample_format;
+  FILE*                     file;
+  uint64_t                  nsamples;
+  bool                      running;
+  pthread_mutex_t           mutex;
+  cf_t*                     zeros;
+  void*                     temp_buffer_convert;
+  uint32_t                  frequency_mhz;
+  int32_t                   sample_offset;
 } rf_file_tx_t;
 
 typedef struct {
-  char             id[FILE_ID_STRLEN];
-  rf_file_format_t sample_format;
-  FILE*            file;
-  uint64_t         nsamples;
-  bool             running;
-  pthread_t        thread;
-  pthread_mutex_t  mutex;
-  cf_t*            temp_buffer;
-  void*            temp_buffer_convert;
-  uint32_t         frequency_mhz;
+  char                      id[FILE_ID_STRLEN];
+  srsran_rf_sample_format_t sample_format;
+  FILE*                     file;
+  uint64_t                  nsamples;
+  bool                      running;
+  pthread_t                 thread;
+  pthread_mutex_t           mutex;
+  cf_t*                     temp_buffer;
+  void*                     temp_buffer_convert;
+  uint32_t                  frequency_mhz;
 } rf_file_rx_t;
 
 typedef struct {
-  const char*      id;
-  rf_file_format_t sample_format;
-  FILE*            file;
-  uint32_t         frequency_mhz;
+  const char*               id;
+  srsran_rf_sample_format_t sample_format;
+  FILE*                     file;
+  uint32_t                  frequency_mhz;
 } rf_file_opts_t;
 
 /*
@@ -106,7 +105,7 @@ SRSRAN_API void rf_file_tx_close(rf_file_tx_t* q);
  */
 SRSRAN_API int rf_file_rx_open(rf_file_rx_t* q, rf_file_opts_t opts);
 
-SRSRAN_API int rf_file_rx_baseband(rf_file_rx_t* q, cf_t* buffer, uint32_t nsamples);
+SRSRAN_API int rf_file_rx_baseband(rf_file_rx_t* q, cf_t* buffer, uint32_t nsamples, float gain);
 
 SRSRAN_API bool rf_file_rx_match_freq(rf_file_rx_t* q, uint32_t freq_hz);
 
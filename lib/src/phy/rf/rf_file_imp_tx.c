@@ -77,14 +77,13 @@ static int _rf_file_tx_baseband(rf_file_tx_t* q, cf_t* buffer, uint32_t nsamples
 {
   int n = SRSRAN_ERROR;
 
-  // convert samples if necessary
+  // convert samples if necessary, zeros are the same in every format
   void*    buf       = (buffer) ? buffer : q->zeros;
-  uint32_t sample_sz = sizeof(cf_t);
+  uint32_t sample_sz = srsran_rf_sample_format_nof_bytes(q->sample_format, 1);
 
-  if (q->sample_format == FILERF_TYPE_SC16) {
-    buf       = q->temp_buffer_convert;
-    sample_sz = 2 * sizeof(short);
-    srsran_vec_convert_fi((float*)buffer, INT16_MAX, (short*)q->temp_buffer_convert, 2 * nsamples);
+  if (q->sample_format != SRSRAN_RF_SAMPLE_FORMAT_FC32 && buf != q->zeros) {
+    buf = q->temp_buffer_convert;
+    srsran_rf_convert_from_cf(q->sample_format, buffer, buf, 1.0f, nsamples);
   }
 
   size_t ret = fwrite(buf, (size_t)sample_sz, (size_t)nsamples, q->file);
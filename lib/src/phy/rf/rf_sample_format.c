@@ -0,0 +1,329 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/rf/rf_sample_format.h"
+#include "srsran/phy/utils/vector.h"
+#include <math.h>
+#include <string.h>
+
+#define SC12_MAX (2047)
+#define SC12_MIN (-2048)
+#define SC12_NOF_BYTES (3)
+
+srsran_rf_sample_format_t srsran_rf_sample_format_from_string(const char* str)
+{
+  if (str == NULL) {
+    return SRSRAN_RF_SAMPLE_FORMAT_INVALID;
+  }
+  if (strcmp(str, "fc32") == 0) {
+    return SRSRAN_RF_SAMPLE_FORMAT_FC32;
+  }
+  if (strcmp(str, "sc16") == 0) {
+    return SRSRAN_RF_SAMPLE_FORMAT_SC16;
+  }
+  if (strcmp(str, "sc12") == 0) {
+    return SRSRAN_RF_SAMPLE_FORMAT_SC12;
+  }
+  if (strcmp(str, "sc8") == 0) {
+    return SRSRAN_RF_SAMPLE_FORMAT_SC8;
+  }
+  return SRSRAN_RF_SAMPLE_FORMAT_INVALID;
+}
+
+const char* srsran_rf_sample_format_to_string(srsran_rf_sample_format_t format)
+{
+  switch (format) {
+    case SRSRAN_RF_SAMPLE_FORMAT_FC32:
+      return "fc32";
+    case SRSRAN_RF_SAMPLE_FORMAT_SC16:
+      return "sc16";
+    case SRSRAN_RF_SAMPLE_FORMAT_SC12:
+      return "sc12";
+    case SRSRAN_RF_SAMPLE_FORMAT_SC8:
+      return "sc8";
+    default:; // Do nothing
+  }
+  return "invalid";
+}
+
+uint32_t srsran_rf_sample_format_nof_bytes(srsran_rf_sample_format_t format, uint32_t nof_samples)
+{
+  switch (format) {
+    case SRSRAN_RF_SAMPLE_FORMAT_FC32:
+      return nof_samples * (uint32_t)sizeof(cf_t);
+    case SRSRAN_RF_SAMPLE_FORMAT_SC16:
+      return nof_samples * 2 * (uint32_t)sizeof(int16_t);
+    case SRSRAN_RF_SAMPLE_FORMAT_SC12:
+      return nof_samples * SC12_NOF_BYTES;
+    case SRSRAN_RF_SAMPLE_FORMAT_SC8:
+      return nof_samples * 2 * (uint32_t)sizeof(int8_t);
+    default:; // Do nothing
+  }
+  return 0;
+}
+
+float srsran_rf_sample_format_full_scale(srsran_rf_sample_format_t format)
+{
+  switch (format) {
+    case SRSRAN_RF_SAMPLE_FORMAT_SC16:
+      return (float)INT16_MAX;
+    case SRSRAN_RF_SAMPLE_FORMAT_SC12:
+      return (float)SC12_MAX;
+    case SRSRAN_RF_SAMPLE_FORMAT_SC8:
+      return (float)INT8_MAX;
+    default:; // Do nothing
+  }
+  return 1.0f;
+}
+
+static inline int32_t rf_sample_format_saturate(float x, int32_t min, int32_t max)
+{
+  // Clamp in the float domain so the loops vectorize, then truncate like the SIMD kernels do
+  x = (x > (float)max) ? (float)max : x;
+  x = (x < (float)min) ? (float)min : x;
+  return (int32_t)x;
+}
+
+/*
+ * Packed sc12: every complex sample is stored as a 24-bit little-endian word with I in the 12 LSB and Q in the 12 MSB
+ */
+static inline void rf_sample_format_sc12_unpack(const uint8_t* p, int16_t* i, int16_t* q)
+{
+  uint32_t w = (uint32_t)p[0] | ((uint32_t)p[1] << 8U) | ((uint32_t)p[2] << 16U);
+
+  // Sign extension from 12 to 16 bit
+  *i = (int16_t)((int16_t)((w & 0xfffU) << 4U) >> 4);
+  *q = (int16_t)((int16_t)(((w >> 12U) & 0xfffU) << 4U) >> 4);
+}
+
+static inline void rf_sample_format_sc12_pack(int32_t i, int32_t q, uint8_t* p)
+{
+  uint32_t w = ((uint32_t)i & 0xfffU) | (((uint32_t)q & 0xfffU) << 12U);
+  p[0]       = (uint8_t)(w & 0xffU);
+  p[1]       = (uint8_t)((w >> 8U) & 0xffU);
+  p[2]       = (uint8_t)((w >> 16U) & 0xffU);
+}
+
+/*
+ * Strided kernels, stride is given in complex samples. They are used for both, single channel (stride 1) and
+ * (de)interleaving of multiple channels.
+ */
+static void rf_sample_format_to_cf_strided(srsran_rf_sample_format_t format,
+                                           const void*               src,
+                                           uint32_t                  stride,
+                                           cf_t*                     dst,
+                                           float                     gain,
+                                           uint32_t                  nof_samples)
+{
+  const float k = gain / srsran_rf_sample_format_full_scale(format);
+
+  switch (format) {
+    case SRSRAN_RF_SAMPLE_FORMAT_FC32: {
+      const float* x = (const float*)src;
+      float*       z = (float*)dst;
+      for (uint32_t n = 0; n < nof_samples; n++) {
+        z[2 * n]     = x[2 * n * stride] * k;
+        z[2 * n + 1] = x[2 * n * stride + 1] * k;
+      }
+    } break;
+    case SRSRAN_RF_SAMPLE_FORMAT_SC16: {
+      const int16_t* x = (const int16_t*)src;
+      float*         z = (float*)dst;
+      for (uint32_t n = 0; n < nof_samples; n++) {
+        z[2 * n]     = (float)x[2 * n * stride] * k;
+        z[2 * n + 1] = (float)x[2 * n * stride + 1] * k;
+      }
+    } break;
+    case SRSRAN_RF_SAMPLE_FORMAT_SC12: {
+      const uint8_t* x = (const uint8_t*)src;
+      float*         z = (float*)dst;
+      for (uint32_t n = 0; n < nof_samples; n++) {
+        int16_t i, q;
+        rf_sample_format_sc12_unpack(&x[SC12_NOF_BYTES * n * stride], &i, &q);
+        z[2 * n]     = (float)i * k;
+        z[2 * n + 1] = (float)q * k;
+      }
+    } break;
+    case SRSRAN_RF_SAMPLE_FORMAT_SC8: {
+      const int8_t* x = (const int8_t*)src;
+      float*        z = (float*)dst;
+      for (uint32_t n = 0; n < nof_samples; n++) {
+        z[2 * n]     = (float)x[2 * n * stride] * k;
+        z[2 * n + 1] = (float)x[2 * n * stride + 1] * k;
+      }
+    } break;
+    default:; // Do nothing
+  }
+}
+
+static void rf_sample_format_from_cf_strided(srsran_rf_sample_format_t format,
+                                             const cf_t*               src,
+                                             void*                     dst,
+                                             uint32_t                  stride,
+                                             float                     gain,
+                                             uint32_t                  nof_samples)
+{
+  const float k = gain * srsran_rf_sample_format_full_scale(format);
+
+  // A NULL source transmits zeros
+  const float* x    = (const float*)src;
+  float        zero = 0.0f;
+  uint32_t     step = 1;
+  if (x == NULL) {
+    x    = &zero;
+    step = 0;
+  }
+
+  switch (format) {
+    case SRSRAN_RF_SAMPLE_FORMAT_FC32: {
+      float* z = (float*)dst;
+      for (uint32_t n = 0; n < nof_samples; n++) {
+        z[2 * n * stride]     = x[2 * n * step] * k;
+        z[2 * n * stride + 1] = x[(2 * n + 1) * step] * k;
+      }
+    } break;
+    case SRSRAN_RF_SAMPLE_FORMAT_SC16: {
+      int16_t* z = (int16_t*)dst;
+      for (uint32_t n = 0; n < nof_samples; n++) {
+        z[2 * n * stride]     = (int16_t)rf_sample_format_saturate(x[2 * n * step] * k, INT16_MIN, INT16_MAX);
+        z[2 * n * stride + 1] = (int16_t)rf_sample_format_saturate(x[(2 * n + 1) * step] * k, INT16_MIN, INT16_MAX);
+      }
+    } break;
+    case SRSRAN_RF_SAMPLE_FORMAT_SC12: {
+      uint8_t* z = (uint8_t*)dst;
+      for (uint32_t n = 0; n < nof_samples; n++) {
+        int32_t i = rf_sample_format_saturate(x[2 * n * step] * k, SC12_MIN, SC12_MAX);
+        int32_t q = rf_sample_format_saturate(x[(2 * n + 1) * step] * k, SC12_MIN, SC12_MAX);
+        rf_sample_format_sc12_pack(i, q, &z[SC12_NOF_BYTES * n * stride]);
+      }
+    } break;
+    case SRSRAN_RF_SAMPLE_FORMAT_SC8: {
+      int8_t* z = (int8_t*)dst;
+      for (uint32_t n = 0; n < nof_samples; n++) {
+        z[2 * n * stride]     = (int8_t)rf_sample_format_saturate(x[2 * n * step] * k, INT8_MIN, INT8_MAX);
+        z[2 * n * stride + 1] = (int8_t)rf_sample_format_saturate(x[(2 * n + 1) * step] * k, INT8_MIN, INT8_MAX);
+      }
+    } break;
+    default:; // Do nothing
+  }
+}
+
+void srsran_rf_convert_to_cf(srsran_rf_sample_format_t format,
+                             const void*               src,
+                             cf_t*                     dst,
+                             float                     gain,
+                             uint32_t                  nof_samples)
+{
+  if (src == NULL || dst == NULL || nof_samples == 0) {
+    return;
+  }
+
+  switch (format) {
+    case SRSRAN_RF_SAMPLE_FORMAT_FC32:
+      srsran_vec_sc_prod_cfc((const cf_t*)src, gain, dst, nof_samples);
+      break;
+    case SRSRAN_RF_SAMPLE_FORMAT_SC16:
+      // SIMD conversion, it divides by the given scale
+      srsran_vec_convert_if((const int16_t*)src, (float)INT16_MAX / gain, (float*)dst, 2 * nof_samples);
+      break;
+    default:
+      rf_sample_format_to_cf_strided(format, src, 1, dst, gain, nof_samples);
+  }
+}
+
+void srsran_rf_convert_from_cf(srsran_rf_sample_format_t format,
+                               const cf_t*               src,
+                               void*                     dst,
+                               float                     gain,
+                               uint32_t                  nof_samples)
+{
+  if (dst == NULL || nof_samples == 0) {
+    return;
+  }
+
+  if (src == NULL) {
+    memset(dst, 0, srsran_rf_sample_format_nof_bytes(format, nof_samples));
+    return;
+  }
+
+  switch (format) {
+    case SRSRAN_RF_SAMPLE_FORMAT_FC32:
+      srsran_vec_sc_prod_cfc(src, gain, (cf_t*)dst, nof_samples);
+      break;
+    case SRSRAN_RF_SAMPLE_FORMAT_SC16:
+      // SIMD conversion, it saturates when packing to 16 bit
+      srsran_vec_convert_fi((const float*)src, (float)INT16_MAX * gain, (int16_t*)dst, 2 * nof_samples);
+      break;
+    case SRSRAN_RF_SAMPLE_FORMAT_SC8:
+      srsran_vec_convert_fb((const float*)src, (float)INT8_MAX * gain, (int8_t*)dst, 2 * nof_samples);
+      break;
+    default:
+      rf_sample_format_from_cf_strided(format, src, dst, 1, gain, nof_samples);
+  }
+}
+
+void srsran_rf_convert_to_cf_deinterleave(srsran_rf_sample_format_t format,
+                                          const void*               src,
+                                          cf_t**                    dst,
+                                          uint32_t                  nof_channels,
+                                          float                     gain,
+                                          uint32_t                  nof_samples)
+{
+  if (src == NULL || dst == NULL || nof_channels == 0) {
+    return;
+  }
+
+  // Single channel does not need deinterleaving, use the contiguous kernels
+  if (nof_channels == 1) {
+    srsran_rf_convert_to_cf(format, src, dst[0], gain, nof_samples);
+    return;
+  }
+
+  for (uint32_t ch = 0; ch < nof_channels; ch++) {
+    if (dst[ch] == NULL) {
+      continue;
+    }
+    const uint8_t* ptr = (const uint8_t*)src + srsran_rf_sample_format_nof_bytes(format, ch);
+    rf_sample_format_to_cf_strided(format, ptr, nof_channels, dst[ch], gain, nof_samples);
+  }
+}
+
+void srsran_rf_convert_from_cf_interleave(srsran_rf_sample_format_t format,
+                                          const cf_t**              src,
+                                          void*                     dst,
+                                          uint32_t                  nof_channels,
+                                          float                     gain,
+                                          uint32_t                  nof_samples)
+{
+  if (src == NULL || dst == NULL || nof_channels == 0) {
+    return;
+  }
+
+  if (nof_channels == 1) {
+    srsran_rf_convert_from_cf(format, src[0], dst, gain, nof_samples);
+    return;
+  }
+
+  for (uint32_t ch = 0; ch < nof_channels; ch++) {
+    uint8_t* ptr = (uint8_t*)dst + srsran_rf_sample_format_nof_bytes(format, ch);
+    rf_sample_format_from_cf_strided(format, src[ch], ptr, nof_channels, gain, nof_samples);
+  }
+}
@@ -0,0 +1,253 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/rf/rf_sample_format.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/random.h"
+#include "srsran/phy/utils/vector.h"
+#include <complex.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#define NOF_CHANNELS 4
+#define SATURATION_LEN 37
+
+static uint32_t nof_samples     = 23040;
+static uint32_t nof_repetitions = 100;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [nr]\n", prog);
+  printf("\t-n nof_samples [Default %d]\n", nof_samples);
+  printf("\t-r nof_repetitions for the throughput measurement [Default %d]\n", nof_repetitions);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "nr")) != -1) {
+    switch (opt) {
+      case 'n':
+        nof_samples = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'r':
+        nof_repetitions = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+static double elapsed_us(struct timeval* ts_start, struct timeval* ts_end)
+{
+  if (ts_end->tv_usec > ts_start->tv_usec) {
+    return ((double)ts_end->tv_sec - (double)ts_start->tv_sec) * 1000000 + (double)ts_end->tv_usec -
+           (double)ts_start->tv_usec;
+  }
+  return ((double)ts_end->tv_sec - (double)ts_start->tv_sec - 1) * 1000000 + ((double)ts_end->tv_usec + 1000000) -
+         (double)ts_start->tv_usec;
+}
+
+static float max_error(const cf_t* a, const cf_t* b, uint32_t len)
+{
+  float err = 0.0f;
+  for (uint32_t i = 0; i < len; i++) {
+    err = SRSRAN_MAX(err, cabsf(a[i] - b[i]));
+  }
+  return err;
+}
+
+// Checks the packing of the sc12 format against a known pattern
+static int test_sc12_packing()
+{
+  float   k    = 1.0f / 2047.0f;
+  cf_t    x[2] = {k * (1.0f - 2.0f * _Complex_I), k * (-2048.0f + 2047.0f * _Complex_I)};
+  uint8_t y[6] = {};
+
+  srsran_rf_convert_from_cf(SRSRAN_RF_SAMPLE_FORMAT_SC12, x, y, 1.0f, 2);
+
+  // I=1 (0x001), Q=-2 (0xffe); I=-2048 (0x800), Q=2047 (0x7ff)
+  uint8_t expected[6] = {0x01, 0xe0, 0xff, 0x00, 0xf8, 0x7f};
+  if (memcmp(y, expected, sizeof(expected)) != 0) {
+    ERROR("sc12 packing mismatch");
+    srsran_vec_fprint_byte(stdout, y, 6);
+    return SRSRAN_ERROR;
+  }
+
+  cf_t z[2] = {};
+  srsran_rf_convert_to_cf(SRSRAN_RF_SAMPLE_FORMAT_SC12, y, z, 1.0f, 2);
+  if (max_error(x, z, 2) > 1e-6f) {
+    ERROR("sc12 unpacking mismatch");
+    return SRSRAN_ERROR;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+// Checks that out of range samples saturate, in the SIMD body and in the scalar tail of an unaligned buffer
+static int test_saturation(srsran_rf_sample_format_t format)
+{
+  // SATURATION_LEN samples do not fill a whole number of SIMD registers, and starting at index 1 unaligns the buffers
+  cf_t        x[SATURATION_LEN + 1]        = {};
+  int16_t     wire[2 * SATURATION_LEN + 1] = {};
+  cf_t        z[SATURATION_LEN]            = {};
+  const float amplitudes[]                 = {1.5f, 4.0f, 100.0f, -1.5f, -4.0f, -100.0f};
+  uint32_t    len                          = SATURATION_LEN;
+  for (uint32_t i = 0; i < len; i++) {
+    x[i + 1] = amplitudes[i % 6] - amplitudes[(i + 1) % 6] * _Complex_I;
+  }
+
+  srsran_rf_convert_from_cf(format, &x[1], &wire[1], 1.0f, len);
+  srsran_rf_convert_to_cf(format, &wire[1], z, 1.0f, len);
+
+  // The negative full scale is one LSB larger than the positive one
+  float tolerance = 1.5f / srsran_rf_sample_format_full_scale(format);
+  for (uint32_t i = 0; i < len; i++) {
+    cf_t expected = (crealf(x[i + 1]) > 0 ? 1.0f : -1.0f) + (cimagf(x[i + 1]) > 0 ? 1.0f : -1.0f) * _Complex_I;
+    if (cabsf(z[i] - expected) > tolerance) {
+      ERROR("%s: sample %d (%+.1f%+.1fi) did not saturate, got %+f%+fi",
+            srsran_rf_sample_format_to_string(format),
+            i,
+            crealf(x[i + 1]),
+            cimagf(x[i + 1]),
+            crealf(z[i]),
+            cimagf(z[i]));
+      return SRSRAN_ERROR;
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+static int test_format(srsran_rf_sample_format_t format, srsran_random_t random_gen)
+{
+  int      ret       = SRSRAN_ERROR;
+  uint32_t nof_bytes = srsran_rf_sample_format_nof_bytes(format, nof_samples * NOF_CHANNELS);
+  float    gain      = 0.5f;
+
+  cf_t*    x[NOF_CHANNELS] = {};
+  cf_t*    z[NOF_CHANNELS] = {};
+  uint8_t* wire            = srsran_vec_u8_malloc(nof_bytes);
+  for (uint32_t ch = 0; ch < NOF_CHANNELS; ch++) {
+    x[ch] = srsran_vec_cf_malloc(nof_samples);
+    z[ch] = srsran_vec_cf_malloc(nof_samples);
+    if (x[ch] == NULL || z[ch] == NULL) {
+      goto clean_exit;
+    }
+    srsran_random_uniform_complex_dist_vector(random_gen, x[ch], nof_samples, -1.0f, 1.0f);
+  }
+  if (wire == NULL) {
+    goto clean_exit;
+  }
+
+  // Quantization error of a round trip: up to one LSB per component (truncating kernels), after scaling both ways
+  float tolerance = 1.5f / srsran_rf_sample_format_full_scale(format) + 1e-5f;
+
+  // Single channel, Tx gain and inverse Rx gain
+  srsran_rf_convert_from_cf(format, x[0], wire, gain, nof_samples);
+  srsran_rf_convert_to_cf(format, wire, z[0], 1.0f / gain, nof_samples);
+  float err = max_error(x[0], z[0], nof_samples);
+  if (err > tolerance / gain) {
+    ERROR("%s: single channel error %e exceeds %e", srsran_rf_sample_format_to_string(format), err, tolerance / gain);
+    goto clean_exit;
+  }
+
+  // Interleaved channels
+  srsran_rf_convert_from_cf_interleave(format, (const cf_t**)x, wire, NOF_CHANNELS, 1.0f, nof_samples);
+  srsran_rf_convert_to_cf_deinterleave(format, wire, z, NOF_CHANNELS, 1.0f, nof_samples);
+  for (uint32_t ch = 0; ch < NOF_CHANNELS; ch++) {
+    err = max_error(x[ch], z[ch], nof_samples);
+    if (err > tolerance) {
+      ERROR("%s: channel %d error %e exceeds %e", srsran_rf_sample_format_to_string(format), ch, err, tolerance);
+      goto clean_exit;
+    }
+  }
+
+  // Throughput
+  struct timeval t[3];
+  gettimeofday(&t[1], NULL);
+  for (uint32_t r = 0; r < nof_repetitions; r++) {
+    srsran_rf_convert_from_cf(format, x[0], wire, gain, nof_samples);
+  }
+  gettimeofday(&t[2], NULL);
+  double tx_us = elapsed_us(&t[1], &t[2]);
+
+  gettimeofday(&t[1], NULL);
+  for (uint32_t r = 0; r < nof_repetitions; r++) {
+    srsran_rf_convert_to_cf(format, wire, z[0], gain, nof_samples);
+  }
+  gettimeofday(&t[2], NULL);
+  double rx_us = elapsed_us(&t[1], &t[2]);
+
+  printf("%s: %d bytes/sample; cf32->wire %.1f Msps; wire->cf32 %.1f Msps\n",
+         srsran_rf_sample_format_to_string(format),
+         srsran_rf_sample_format_nof_bytes(format, 1),
+         (double)nof_samples * nof_repetitions / tx_us,
+         (double)nof_samples * nof_repetitions / rx_us);
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  for (uint32_t ch = 0; ch < NOF_CHANNELS; ch++) {
+    if (x[ch]) {
+      free(x[ch]);
+    }
+    if (z[ch]) {
+      free(z[ch]);
+    }
+  }
+  if (wire) {
+    free(wire);
+  }
+  return ret;
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  srsran_random_t random_gen = srsran_random_init(0x1234);
+
+  int ret = test_sc12_packing();
+
+  for (srsran_rf_sample_format_t format = SRSRAN_RF_SAMPLE_FORMAT_FC32;
+       format < SRSRAN_RF_SAMPLE_FORMAT_INVALID && ret == SRSRAN_SUCCESS;
+       format++) {
+    if (srsran_rf_sample_format_from_string(srsran_rf_sample_format_to_string(format)) != format) {
+      ERROR("Sample format %d does not match its name", format);
+      ret = SRSRAN_ERROR;
+      break;
+    }
+    ret = test_format(format, random_gen);
+    if (ret == SRSRAN_SUCCESS && format != SRSRAN_RF_SAMPLE_FORMAT_FC32) {
+      ret = test_saturation(format);
+    }
+  }
+
+  srsran_random_free(random_gen);
+
+  printf("%s!\n", ret == SRSRAN_SUCCESS ? "Ok" : "Failed");
+  return ret;
+}
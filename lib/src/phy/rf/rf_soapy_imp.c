@@ -28,6 +28,7 @@
 #include "rf_plugin.h"
 #include "rf_soapy_imp.h"
 #include "srsran/phy/common/phy_common.h"
+#include "srsran/phy/rf/rf_sample_format.h"
 #include "srsran/phy/utils/debug.h"
 #include "srsran/phy/utils/vector.h"
 
@@ -47,6 +48,9 @@
 #define PRINT_RX_STATS 0
 #define PRINT_TX_STATS 0
 
+// Maximum number of samples per channel converted at once when the host format is not fc32
+#define SOAPY_CONVERT_BUFFER_SAMPLES (64 * 1024)
+
 typedef struct {
   char*            devname;
   SoapySDRKwargs   args;
@@ -62,6 +66,10 @@ typedef struct {
   size_t           num_rx_channels;
   size_t           num_tx_channels;
 
+  srsran_rf_sample_format_t host_format;
+  void*                     rx_convert_buffer[SRSRAN_MAX_PORTS];
+  void*                     tx_convert_buffer[SRSRAN_MAX_PORTS];
+
   srsran_rf_error_handler_t soapy_error_handler;
   void*                     soapy_error_handler_arg;
 
@@ -290,6 +298,20 @@ float rf_soapy_get_rssi(void* h)
   return 0.0;
 }
 
+static const char* rf_soapy_host_format(srsran_rf_sample_format_t format)
+{
+  switch (format) {
+    case SRSRAN_RF_SAMPLE_FORMAT_SC16:
+      return SOAPY_SDR_CS16;
+    case SRSRAN_RF_SAMPLE_FORMAT_SC12:
+      return SOAPY_SDR_CS12;
+    case SRSRAN_RF_SAMPLE_FORMAT_SC8:
+      return SOAPY_SDR_CS8;
+    default:; // Do nothing
+  }
+  return SOAPY_SDR_CF32;
+}
+
 int rf_soapy_open_multi(char* args, void** h, uint32_t num_requested_channels)
 {
   size_t length;
@@ -359,6 +381,37 @@ int rf_soapy_open_multi(char* args, void** h, uint32_t num_requested_channels)
   handler->rx_stream_active = false;
   handler->devname          = DEVNAME_SOAPY;
 
+  // Host sample format, integer formats are converted by srsRAN kernels instead of the SoapySDR converters
+  handler->host_format = SRSRAN_RF_SAMPLE_FORMAT_FC32;
+  if (args != NULL) {
+    const char format_arg[]   = "host_format=";
+    char       format_str[64] = {0};
+    char*      format_ptr     = strstr(args, format_arg);
+    if (format_ptr) {
+      copy_subdev_string(format_str, format_ptr + strlen(format_arg));
+      handler->host_format = srsran_rf_sample_format_from_string(format_str);
+      if (handler->host_format == SRSRAN_RF_SAMPLE_FORMAT_INVALID) {
+        ERROR("Unsupported host sample format %s", format_str);
+        return SRSRAN_ERROR;
+      }
+      remove_substring(args, format_arg);
+      remove_substring(args, format_str);
+    }
+  }
+  const char* soapy_format = rf_soapy_host_format(handler->host_format);
+  if (handler->host_format != SRSRAN_RF_SAMPLE_FORMAT_FC32) {
+    printf("Using %s host sample format\n", srsran_rf_sample_format_to_string(handler->host_format));
+    uint32_t nbytes = srsran_rf_sample_format_nof_bytes(handler->host_format, SOAPY_CONVERT_BUFFER_SAMPLES);
+    for (uint32_t i = 0; i < SRSRAN_MAX_PORTS; i++) {
+      handler->rx_convert_buffer[i] = srsran_vec_u8_malloc(nbytes);
+      handler->tx_convert_buffer[i] = srsran_vec_u8_malloc(nbytes);
+      if (handler->rx_convert_buffer[i] == NULL || handler->tx_convert_buffer[i] == NULL) {
+        ERROR("Error allocating conversion buffers");
+        return SRSRAN_ERROR;
+      }
+    }
+  }
+
   // create stream args from device args
   SoapySDRKwargs stream_args = {};
 #if SOAPY_SDR_API_VERSION >= 0x00060000
@@ -378,13 +431,13 @@ int rf_soapy_open_multi(char* args, void** h, uint32_t num_requested_channels)
     if (SoapySDRDevice_setupStream(handler->device,
                                    &handler->rxStream,
                                    SOAPY_SDR_RX,
-                                   SOAPY_SDR_CF32,
+                                   soapy_format,
                                    rx_channels,
                                    handler->num_rx_channels,
                                    &stream_args) != 0) {
 #else
     handler->rxStream = SoapySDRDevice_setupStream(
-        handler->device, SOAPY_SDR_RX, SOAPY_SDR_CF32, rx_channels, handler->num_rx_channels, &stream_args);
+        handler->device, SOAPY_SDR_RX, soapy_format, rx_channels, handler->num_rx_channels, &stream_args);
     if (handler->rxStream == NULL) {
 #endif
       printf("Rx setupStream fail: %s\n", SoapySDRDevice_lastError());
@@ -406,13 +459,13 @@ int rf_soapy_open_multi(char* args, void** h, uint32_t num_requested_channels)
     if (SoapySDRDevice_setupStream(handler->device,
                                    &handler->txStream,
                                    SOAPY_SDR_TX,
-                                   SOAPY_SDR_CF32,
+                                   soapy_format,
                                    tx_channels,
                                    handler->num_tx_channels,
                                    &stream_args) != 0) {
 #else
     handler->txStream = SoapySDRDevice_setupStream(
-        handler->device, SOAPY_SDR_TX, SOAPY_SDR_CF32, tx_channels, handler->num_tx_channels, &stream_args);
+        handler->device, SOAPY_SDR_TX, soapy_format, tx_channels, handler->num_tx_channels, &stream_args);
     if (handler->txStream == NULL) {
 #endif
       printf("Tx setupStream fail: %s\n", SoapySDRDevice_lastError());
@@ -585,6 +638,15 @@ int rf_soapy_close(void* h)
 
   SoapySDRDevice_unmake(handler->device);
 
+  for (uint32_t i = 0; i < SRSRAN_MAX_PORTS; i++) {
+    if (handler->rx_convert_buffer[i]) {
+      free(handler->rx_convert_buffer[i]);
+    }
+    if (handler->tx_convert_buffer[i]) {
+      free(handler->tx_convert_buffer[i]);
+    }
+  }
+
   // print statistics
   if (handler->num_lates)
     printf("#lates=%d\n", handler->num_lates);
@@ -816,8 +878,13 @@ int rf_soapy_recv_with_time_multi(void*    h,
   printf("rx: nsamples=%d rx_mtu=%zd\n", nsamples, handler->rx_mtu);
 #endif
 
+  bool convert = handler->host_format != SRSRAN_RF_SAMPLE_FORMAT_FC32;
+
   do {
     size_t rx_samples = SRSRAN_MIN(nsamples - n, handler->rx_mtu);
+    if (convert) {
+      rx_samples = SRSRAN_MIN(rx_samples, SOAPY_CONVERT_BUFFER_SAMPLES);
+    }
 #if PRINT_RX_STATS
     printf(" - rx_samples=%zd\n", rx_samples);
 #endif
@@ -825,7 +892,7 @@ int rf_soapy_recv_with_time_multi(void*    h,
     void* buffs_ptr[SRSRAN_MAX_PORTS] = {};
     for (int i = 0; i < handler->num_rx_channels; i++) {
       cf_t* data_c = (cf_t*)data[i];
-      buffs_ptr[i] = &data_c[n];
+      buffs_ptr[i] = convert ? handler->rx_convert_buffer[i] : &data_c[n];
     }
 
     ret = SoapySDRDevice_readStream(
@@ -853,6 +920,16 @@ int rf_soapy_recv_with_time_multi(void*    h,
     printf(" - rx: %d/%zd\n", ret, rx_samples);
 #endif
 
+    // Convert received samples from the host format
+    if (convert && ret > 0) {
+      for (int i = 0; i < handler->num_rx_channels; i++) {
+        if (data[i] != NULL) {
+          cf_t* data_c = (cf_t*)data[i];
+          srsran_rf_convert_to_cf(handler->host_format, buffs_ptr[i], &data_c[n], 1.0f, (uint32_t)ret);
+        }
+      }
+    }
+
     n += ret;
     trials++;
   } while (n < nsamples && trials < 100);
@@ -915,6 +992,8 @@ int rf_soapy_send_timed_multi(void*  h,
     timeNs = timeNs + (frac_secs * 1000000000);
   }
 
+  bool convert = handler->host_format != SRSRAN_RF_SAMPLE_FORMAT_FC32;
+
   do {
 #if USE_TX_MTU
     size_t tx_samples = SRSRAN_MIN(nsamples - n, handler->tx_mtu);
@@ -924,6 +1003,9 @@ int rf_soapy_send_timed_multi(void*  h,
       tx_samples = nsamples - n;
     }
 #endif
+    if (convert) {
+      tx_samples = SRSRAN_MIN(tx_samples, SOAPY_CONVERT_BUFFER_SAMPLES);
+    }
 
     // (re-)set stream flags
     flags = 0;
@@ -948,6 +1030,13 @@ int rf_soapy_send_timed_multi(void*  h,
     for (int i = 0; i < handler->num_tx_channels; i++) {
       cf_t* data_c = data[i] ? data[i] : zero_mem;
       buffs_ptr[i] = &data_c[n];
+
+      // Convert samples into the host format, NULL channels are converted into zeros
+      if (convert) {
+        srsran_rf_convert_from_cf(
+            handler->host_format, data[i] ? &data_c[n] : NULL, handler->tx_convert_buffer[i], 1.0f, tx_samples);
+        buffs_ptr[i] = handler->tx_convert_buffer[i];
+      }
     }
 
     ret = SoapySDRDevice_writeStream(
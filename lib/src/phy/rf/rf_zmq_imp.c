@@ -258,11 +258,10 @@ int rf_zmq_open_multi(char* args, void** h, uint32_t nof_channels)
       }
 
       // rx_format
-      rx_opts.sample_format = ZMQ_TYPE_FC32;
+      rx_opts.sample_format = SRSRAN_RF_SAMPLE_FORMAT_FC32;
       if (parse_string(args, "rx_format", -1, tmp) == SRSRAN_SUCCESS) {
-        if (!strcmp(tmp, "sc16")) {
-          rx_opts.sample_format = ZMQ_TYPE_SC16;
-        } else {
+        rx_opts.sample_format = srsran_rf_sample_format_from_string(tmp);
+        if (rx_opts.sample_format == SRSRAN_RF_SAMPLE_FORMAT_INVALID) {
           printf("Unsupported sample format %s\n", tmp);
           goto clean_exit;
         }
@@ -279,11 +278,10 @@ int rf_zmq_open_multi(char* args, void** h, uint32_t nof_channels)
       }
 
       // tx_format
-      tx_opts.sample_format = ZMQ_TYPE_FC32;
+      tx_opts.sample_format = SRSRAN_RF_SAMPLE_FORMAT_FC32;
       if (parse_string(args, "tx_format", -1, tmp) == SRSRAN_SUCCESS) {
-        if (!strcmp(tmp, "sc16")) {
-          tx_opts.sample_format = ZMQ_TYPE_SC16;
-        } else {
+        tx_opts.sample_format = srsran_rf_sample_format_from_string(tmp);
+        if (tx_opts.sample_format == SRSRAN_RF_SAMPLE_FORMAT_INVALID) {
           printf("Unsupported sample format %s\n", tmp);
           goto clean_exit;
         }
@@ -720,6 +718,16 @@ int rf_zmq_recv_with_time_multi(void* h, void** data, uint32_t nsamples, bool bl
       }
     }
 
+    // Load the gain, it also incorporates the decimation factor. Without decimation it is applied while converting the
+    // received samples
+    pthread_mutex_lock(&handler->rx_gain_mutex);
+    float scale = srsran_convert_dB_to_amplitude(handler->rx_gain);
+    pthread_mutex_unlock(&handler->rx_gain_mutex);
+    if (decim_factor > 0) {
+      scale = scale / decim_factor;
+    }
+    float rx_gain = (decim_factor == 1) ? scale : 1.0f;
+
     // copy from rx buffer as many samples as requested into provided buffer
     bool    completed                  = false;
     int32_t count[SRSRAN_MAX_CHANNELS] = {};
@@ -733,7 +741,7 @@ int rf_zmq_recv_with_time_multi(void* h, void** data, uint32_t nsamples, bool bl
         // Completed condition
         if (count[i] < nsamples_baserate && rf_zmq_rx_is_running(&handler->receiver[i])) {
           // Keep receiving
-          int32_t n = rf_zmq_rx_baseband(&handler->receiver[i], &ptr[count[i]], nsamples_baserate);
+          int32_t n = rf_zmq_rx_baseband(&handler->receiver[i], &ptr[count[i]], nsamples_baserate, rx_gain);
 #if ZMQ_MONITOR
           // handle socket events
           int event = rf_zmq_rx_get_monitor_event(handler->receiver[i].socket_monitor, NULL, NULL);
@@ -807,17 +815,12 @@ int rf_zmq_recv_with_time_multi(void* h, void** data, uint32_t nsamples, bool bl
       }
     }
 
-    // Set gain
-    pthread_mutex_lock(&handler->rx_gain_mutex);
-    float scale = srsran_convert_dB_to_amplitude(handler->rx_gain);
-    pthread_mutex_unlock(&handler->rx_gain_mutex);
-    // scale shall also incorporate decim_factor
-    if (decim_factor > 0) {
-      scale = scale / decim_factor;
-    }
-    for (uint32_t c = 0; c < handler->nof_channels; c++) {
-      if (buffers[c]) {
-        srsran_vec_sc_prod_cfc(buffers[c], scale, buffers[c], nsamples);
+    // Set gain if it was not applied while converting
+    if (decim_factor != 1) {
+      for (uint32_t c = 0; c < handler->nof_channels; c++) {
+        if (buffers[c]) {
+          srsran_vec_sc_prod_cfc(buffers[c], scale, buffers[c], nsamples);
+        }
       }
     }
 
@@ -970,11 +973,8 @@ int rf_zmq_send_timed_multi(void*  h,
           }
         }
 
-        // Scale according to current gain
-        srsran_vec_sc_prod_cfc(buf, tx_gain, buf, nsamples_baseband);
-
-        // Finally, transmit baseband
-        int n = rf_zmq_tx_baseband(&handler->transmitter[i], buf, nsamples_baseband);
+        // Finally, transmit baseband, it is scaled according to current gain while converting
+        int n = rf_zmq_tx_baseband(&handler->transmitter[i], buf, nsamples_baseband, tx_gain);
         if (n == SRSRAN_ERROR) {
           goto clean_exit;
         }
@@ -207,13 +207,12 @@ clean_exit:
   return ret;
 }
 
-int rf_zmq_rx_baseband(rf_zmq_rx_t* q, cf_t* buffer, uint32_t nsamples)
+int rf_zmq_rx_baseband(rf_zmq_rx_t* q, cf_t* buffer, uint32_t nsamples, float gain)
 {
   void*    dst_buffer = buffer;
-  uint32_t sample_sz  = sizeof(cf_t);
-  if (q->sample_format != ZMQ_TYPE_FC32) {
+  uint32_t sample_sz  = srsran_rf_sample_format_nof_bytes(q->sample_format, 1);
+  if (q->sample_format != SRSRAN_RF_SAMPLE_FORMAT_FC32) {
     dst_buffer = q->temp_buffer_convert;
-    sample_sz  = 2 * sizeof(short);
   }
 
   // If the read needs to be delayed
@@ -243,8 +242,9 @@ int rf_zmq_rx_baseband(rf_zmq_rx_t* q, cf_t* buffer, uint32_t nsamples)
     return n;
   }
 
-  if (q->sample_format == ZMQ_TYPE_SC16) {
-    srsran_vec_convert_if(dst_buffer, INT16_MAX, (float*)buffer, 2 * nsamples);
+  // Convert and scale in a single pass, fc32 is scaled in place
+  if (q->sample_format != SRSRAN_RF_SAMPLE_FORMAT_FC32 || gain != 1.0f) {
+    srsran_rf_convert_to_cf(q->sample_format, dst_buffer, buffer, gain, nsamples);
   }
 
   return n;
@@ -23,6 +23,7 @@
 #define SRSRAN_RF_ZMQ_IMP_TRX_H
 
 #include <pthread.h>
+#include <srsran/phy/rf/rf_sample_format.h>
 #include <srsran/phy/utils/ringbuffer.h>
 #include <stdbool.h>
 
@@ -38,27 +39,25 @@
 #define ZMQ_MAX_GAIN_DB (30.0f)
 #define ZMQ_MIN_GAIN_DB (0.0f)
 
-typedef enum { ZMQ_TYPE_FC32 = 0, ZMQ_TYPE_SC16 } rf_zmq_format_t;
-
 typedef struct {
-  char            id[ZMQ_ID_STRLEN];
-  uint32_t        socket_type;
-  rf_zmq_format_t sample_format;
-  void*           sock;
-  uint64_t        nsamples;
-  bool            running;
-  pthread_mutex_t mutex;
-  cf_t*           zeros;
-  void*           temp_buffer_convert;
-  uint32_t        frequency_mhz;
-  int32_t         sample_offset;
+  char                      id[ZMQ_ID_STRLEN];
+  uint32_t                  socket_type;
+  srsran_rf_sample_format_t sample_format;
+  void*                     sock;
+  uint64_t                  nsamples;
+  bool                      running;
+  pthread_mutex_t           mutex;
+  cf_t*                     zeros;
+  void*                     temp_buffer_convert;
+  uint32_t                  frequency_mhz;
+  int32_t                   sample_offset;
 } rf_zmq_tx_t;
 
 typedef struct {
-  char            id[ZMQ_ID_STRLEN];
-  uint32_t        socket_type;
-  rf_zmq_format_t sample_format;
-  void*           sock;
+  char                      id[ZMQ_ID_STRLEN];
+  uint32_t                  socket_type;
+  srsran_rf_sample_format_t sample_format;
+  void*                     sock;
 #if ZMQ_MONITOR
   void* socket_monitor;
   bool  tx_connected;
@@ -78,14 +77,14 @@ typedef struct {
 } rf_zmq_rx_t;
 
 typedef struct {
-  const char*     id;
-  uint32_t        socket_type;
-  rf_zmq_format_t sample_format;
-  uint32_t        frequency_mhz;
-  bool            fail_on_disconnect;
-  uint32_t        trx_timeout_ms;
-  bool            log_trx_timeout;
-  int32_t         sample_offset; ///< offset in samples
+  const char*               id;
+  uint32_t                  socket_type;
+  srsran_rf_sample_format_t sample_format;
+  uint32_t                  frequency_mhz;
+  bool                      fail_on_disconnect;
+  uint32_t                  trx_timeout_ms;
+  bool                      log_trx_timeout;
+  int32_t                   sample_offset; ///< offset in samples
 } rf_zmq_opts_t;
 
 /*
@@ -104,7 +103,7 @@ SRSRAN_API int rf_zmq_tx_open(rf_zmq_tx_t* q, rf_zmq_opts_t opts, void* zmq_ctx,
 
 SRSRAN_API int rf_zmq_tx_align(rf_zmq_tx_t* q, uint64_t ts);
 
-SRSRAN_API int rf_zmq_tx_baseband(rf_zmq_tx_t* q, cf_t* buffer, uint32_t nsamples);
+SRSRAN_API int rf_zmq_tx_baseband(rf_zmq_tx_t* q, cf_t* buffer, uint32_t nsamples, float gain);
 
 SRSRAN_API int rf_zmq_tx_get_nsamples(rf_zmq_tx_t* q);
 
@@ -121,7 +120,7 @@ SRSRAN_API bool rf_zmq_tx_is_running(rf_zmq_tx_t* q);
  */
 SRSRAN_API int rf_zmq_rx_open(rf_zmq_rx_t* q, rf_zmq_opts_t opts, void* zmq_ctx, char* sock_args);
 
-SRSRAN_API int rf_zmq_rx_baseband(rf_zmq_rx_t* q, cf_t* buffer, uint32_t nsamples);
+SRSRAN_API int rf_zmq_rx_baseband(rf_zmq_rx_t* q, cf_t* buffer, uint32_t nsamples, float gain);
 
 SRSRAN_API bool rf_zmq_rx_match_freq(rf_zmq_rx_t* q, uint32_t freq_hz);
 
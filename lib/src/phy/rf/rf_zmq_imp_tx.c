@@ -104,7 +104,7 @@ clean_exit:
   return ret;
 }
 
-static int _rf_zmq_tx_baseband(rf_zmq_tx_t* q, cf_t* buffer, uint32_t nsamples)
+static int _rf_zmq_tx_baseband(rf_zmq_tx_t* q, cf_t* buffer, uint32_t nsamples, float gain)
 {
   int n = SRSRAN_ERROR;
 
@@ -127,28 +127,29 @@ static int _rf_zmq_tx_baseband(rf_zmq_tx_t* q, cf_t* buffer, uint32_t nsamples)
       n = 1;
     }
 
-    // convert samples if necessary
-    void*    buf       = (buffer) ? buffer : q->zeros;
-    uint32_t sample_sz = sizeof(cf_t);
-
-    if (q->sample_format == ZMQ_TYPE_SC16) {
-      buf       = q->temp_buffer_convert;
-      sample_sz = 2 * sizeof(short);
-      srsran_vec_convert_fi((float*)buffer, INT16_MAX, (short*)q->temp_buffer_convert, 2 * nsamples);
+    // Convert and scale samples in a single pass, zeros are the same in every format
+    void*    buf    = q->zeros;
+    uint32_t nbytes = srsran_rf_sample_format_nof_bytes(q->sample_format, nsamples);
+    if (buffer != NULL && buffer != q->zeros) {
+      buf = buffer;
+      if (q->sample_format != SRSRAN_RF_SAMPLE_FORMAT_FC32 || gain != 1.0f) {
+        buf = q->temp_buffer_convert;
+        srsran_rf_convert_from_cf(q->sample_format, buffer, buf, gain, nsamples);
+      }
     }
 
     // Send base-band if request was received
     if (n > 0) {
-      n = zmq_send(q->sock, buf, (size_t)sample_sz * nsamples, 0);
+      n = zmq_send(q->sock, buf, (size_t)nbytes, 0);
       if (n < 0) {
         if (rf_zmq_handle_error(q->id, "tx baseband send")) {
           n = SRSRAN_ERROR;
           goto clean_exit;
         }
-      } else if (n != NSAMPLES2NBYTES(nsamples)) {
+      } else if (n != nbytes) {
         rf_zmq_error(q->id,
                      "[zmq] Error: transmitter expected %d bytes and sent %d. %s.\n",
-                     NSAMPLES2NBYTES(nsamples),
+                     nbytes,
                      n,
                      strerror(zmq_errno()));
         n = SRSRAN_ERROR;
@@ -175,7 +176,7 @@ int rf_zmq_tx_align(rf_zmq_tx_t* q, uint64_t ts)
 
   if (nsamples > 0) {
     rf_zmq_info(q->id, " - Detected Tx gap of %d samples.\n", nsamples);
-    _rf_zmq_tx_baseband(q, q->zeros, (uint32_t)nsamples);
+    _rf_zmq_tx_baseband(q, q->zeros, (uint32_t)nsamples, 1.0f);
   }
 
   pthread_mutex_unlock(&q->mutex);
@@ -183,14 +184,14 @@ int rf_zmq_tx_align(rf_zmq_tx_t* q, uint64_t ts)
   return (int)nsamples;
 }
 
-int rf_zmq_tx_baseband(rf_zmq_tx_t* q, cf_t* buffer, uint32_t nsamples)
+int rf_zmq_tx_baseband(rf_zmq_tx_t* q, cf_t* buffer, uint32_t nsamples, float gain)
 {
   int n;
 
   pthread_mutex_lock(&q->mutex);
 
   if (q->sample_offset > 0) {
-    _rf_zmq_tx_baseband(q, q->zeros, (uint32_t)q->sample_offset);
+    _rf_zmq_tx_baseband(q, q->zeros, (uint32_t)q->sample_offset, 1.0f);
     q->sample_offset = 0;
   } else if (q->sample_offset < 0) {
     n = SRSRAN_MIN(-q->sample_offset, nsamples);
@@ -202,7 +203,7 @@ int rf_zmq_tx_baseband(rf_zmq_tx_t* q, cf_t* buffer, uint32_t nsamples)
     }
   }
 
-  n = _rf_zmq_tx_baseband(q, buffer, nsamples);
+  n = _rf_zmq_tx_baseband(q, buffer, nsamples, gain);
 
   pthread_mutex_unlock(&q->mutex);
 
@@ -222,7 +223,7 @@ int rf_zmq_tx_zeros(rf_zmq_tx_t* q, uint32_t nsamples)
   pthread_mutex_lock(&q->mutex);
 
   rf_zmq_info(q->id, " - Tx %d Zeros.\n", nsamples);
-  _rf_zmq_tx_baseband(q, q->zeros, (uint32_t)nsamples);
+  _rf_zmq_tx_baseband(q, q->zeros, (uint32_t)nsamples, 1.0f);
 
   pthread_mutex_unlock(&q->mutex);
 
@@ -436,6 +436,114 @@ float compute_peak_sidelobe(srsran_pss_t* q, uint32_t corr_peak_pos, uint32_t co
   return q->conv_output_avg[corr_peak_pos] / side_lobe_value;
 }
 
+// Computes the squared magnitude of the correlation, averages it and finds its peak
+static int pss_find_peak(srsran_pss_t* q, uint32_t conv_output_len, float* corr_peak_value)
+{
+  uint32_t corr_peak_pos;
+
+  // If enabled, average the absolute value from previous calls. Otherwise, compute the modulus square in place
+  if (q->ema_alpha < 1.0 && q->ema_alpha > 0.0) {
+    srsran_vec_abs_square_cf(q->conv_output, q->conv_output_abs, conv_output_len - 1);
+    srsran_vec_sc_prod_fff(q->conv_output_abs, q->ema_alpha, q->conv_output_abs, conv_output_len - 1);
+    srsran_vec_sc_prod_fff(q->conv_output_avg, 1 - q->ema_alpha, q->conv_output_avg, conv_output_len - 1);
+
+    srsran_vec_sum_fff(q->conv_output_abs, q->conv_output_avg, q->conv_output_avg, conv_output_len - 1);
+  } else {
+    srsran_vec_abs_square_cf(q->conv_output, q->conv_output_avg, conv_output_len - 1);
+  }
+
+  /* Find maximum of the absolute value of the correlation */
+  corr_peak_pos = srsran_vec_max_fi(q->conv_output_avg, conv_output_len - 1);
+
+  // save absolute value
+  q->peak_value = q->conv_output_avg[corr_peak_pos];
+
+#ifdef SRSRAN_PSS_RETURN_PSR
+  if (corr_peak_value) {
+    *corr_peak_value = compute_peak_sidelobe(q, corr_peak_pos, conv_output_len);
+  }
+#else
+  if (corr_peak_value) {
+    *corr_peak_value = q->conv_output_avg[corr_peak_pos];
+  }
+#endif
+
+  if (q->decimate > 1) {
+    int decimation_correction = (q->filter.num_taps - 2);
+    corr_peak_pos             = corr_peak_pos - decimation_correction;
+    corr_peak_pos             = corr_peak_pos * q->decimate;
+  }
+
+  if (q->frame_size >= q->fft_size) {
+    return (int)corr_peak_pos;
+  }
+  return (int)corr_peak_pos + q->fft_size;
+}
+
+/** Transforms frame_size input samples to the frequency domain. The result can be correlated with any N_id_2 and with
+ * other PSS objects of the same size (e.g. with a different integer CFO offset) using srsran_pss_find_pss_fft(), so
+ * the forward transform is computed once for all hypotheses.
+ */
+int srsran_pss_input_fft(srsran_pss_t* q, const cf_t* input)
+{
+  if (q == NULL || input == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+#ifdef CONVOLUTION_FFT
+  // Small frames are correlated in the time domain
+  if (q->frame_size < q->fft_size) {
+    return SRSRAN_ERROR;
+  }
+
+  memcpy(q->tmp_input, input, (q->frame_size * q->decimate) * sizeof(cf_t));
+  if (q->decimate > 1) {
+    srsran_filt_decim_cc_execute(&(q->filter),
+                                 q->tmp_input,
+                                 q->filter.downsampled_input,
+                                 q->filter.filter_output,
+                                 (q->frame_size * q->decimate));
+    srsran_conv_fft_cc_run_input(&q->conv_fft, q->filter.filter_output);
+  } else {
+    srsran_conv_fft_cc_run_input(&q->conv_fft, q->tmp_input);
+  }
+
+  return SRSRAN_SUCCESS;
+#else
+  return SRSRAN_ERROR;
+#endif
+}
+
+/** Correlates the input previously transformed by srsran_pss_input_fft() on the object src (which can be q) with the
+ * PSS sequence of q. Both objects must have the same frame size, FFT size and decimation.
+ * Returns the index of the PSS correlation peak as srsran_pss_find_pss().
+ */
+int srsran_pss_find_pss_fft(srsran_pss_t* q, const srsran_pss_t* src, float* corr_peak_value)
+{
+  if (q == NULL || src == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  if (!srsran_N_id_2_isvalid(q->N_id_2)) {
+    ERROR("Error finding PSS peak, Must set N_id_2 first");
+    return SRSRAN_ERROR;
+  }
+
+#ifdef CONVOLUTION_FFT
+  if (src->conv_fft.output_len != q->conv_fft.output_len || src->decimate != q->decimate) {
+    ERROR("Error finding PSS peak, input transformed with a different size");
+    return SRSRAN_ERROR;
+  }
+
+  uint32_t conv_output_len = srsran_conv_fft_cc_run_freq(
+      &q->conv_fft, src->conv_fft.input_fft, q->pss_signal_freq_full[q->N_id_2], q->conv_output);
+
+  return pss_find_peak(q, conv_output_len, corr_peak_value);
+#else
+  return SRSRAN_ERROR;
+#endif
+}
+
 /** Performs time-domain PSS correlation.
  * Returns the index of the PSS correlation peak in a subframe.
  * The frame starts at corr_peak_pos-subframe_size/2.
@@ -448,7 +556,6 @@ int srsran_pss_find_pss(srsran_pss_t* q, const cf_t* input, float* corr_peak_val
   int ret = SRSRAN_ERROR_INVALID_INPUTS;
 
   if (q != NULL && input != NULL) {
-    uint32_t corr_peak_pos;
     uint32_t conv_output_len;
 
     if (!srsran_N_id_2_isvalid(q->N_id_2)) {
@@ -464,20 +571,8 @@ int srsran_pss_find_pss(srsran_pss_t* q, const cf_t* input, float* corr_peak_val
      */
     if (q->frame_size >= q->fft_size) {
 #ifdef CONVOLUTION_FFT
-      memcpy(q->tmp_input, input, (q->frame_size * q->decimate) * sizeof(cf_t));
-      if (q->decimate > 1) {
-        srsran_filt_decim_cc_execute(&(q->filter),
-                                     q->tmp_input,
-                                     q->filter.downsampled_input,
-                                     q->filter.filter_output,
-                                     (q->frame_size * q->decimate));
-        conv_output_len = srsran_conv_fft_cc_run_opt(
-            &q->conv_fft, q->filter.filter_output, q->pss_signal_freq_full[q->N_id_2], q->conv_output);
-      } else {
-        conv_output_len =
-            srsran_conv_fft_cc_run_opt(&q->conv_fft, q->tmp_input, q->pss_signal_freq_full[q->N_id_2], q->conv_output);
-      }
-
+      srsran_pss_input_fft(q, input);
+      return srsran_pss_find_pss_fft(q, q, corr_peak_value);
 #else
       conv_output_len =
           srsran_conv_cc(input, q->pss_signal_time[q->N_id_2], q->conv_output, q->frame_size, q->fft_size);
@@ -489,46 +584,7 @@ int srsran_pss_find_pss(srsran_pss_t* q, const cf_t* input, float* corr_peak_val
       conv_output_len = q->frame_size;
     }
 
-    // Compute modulus square
-    srsran_vec_abs_square_cf(q->conv_output, q->conv_output_abs, conv_output_len - 1);
-
-    // If enabled, average the absolute value from previous calls
-    if (q->ema_alpha < 1.0 && q->ema_alpha > 0.0) {
-      srsran_vec_sc_prod_fff(q->conv_output_abs, q->ema_alpha, q->conv_output_abs, conv_output_len - 1);
-      srsran_vec_sc_prod_fff(q->conv_output_avg, 1 - q->ema_alpha, q->conv_output_avg, conv_output_len - 1);
-
-      srsran_vec_sum_fff(q->conv_output_abs, q->conv_output_avg, q->conv_output_avg, conv_output_len - 1);
-    } else {
-      memcpy(q->conv_output_avg, q->conv_output_abs, sizeof(float) * (conv_output_len - 1));
-    }
-
-    /* Find maximum of the absolute value of the correlation */
-    corr_peak_pos = srsran_vec_max_fi(q->conv_output_avg, conv_output_len - 1);
-
-    // save absolute value
-    q->peak_value = q->conv_output_avg[corr_peak_pos];
-
-#ifdef SRSRAN_PSS_RETURN_PSR
-    if (corr_peak_value) {
-      *corr_peak_value = compute_peak_sidelobe(q, corr_peak_pos, conv_output_len);
-    }
-#else
-    if (corr_peak_value) {
-      *corr_peak_value = q->conv_output_avg[corr_peak_pos];
-    }
-#endif
-
-    if (q->decimate > 1) {
-      int decimation_correction = (q->filter.num_taps - 2);
-      corr_peak_pos             = corr_peak_pos - decimation_correction;
-      corr_peak_pos             = corr_peak_pos * q->decimate;
-    }
-
-    if (q->frame_size >= q->fft_size) {
-      ret = (int)corr_peak_pos;
-    } else {
-      ret = (int)corr_peak_pos + q->fft_size;
-    }
+    ret = pss_find_peak(q, conv_output_len, corr_peak_value);
   }
   return ret;
 }
@@ -595,9 +595,19 @@ static int cfo_i_estimate(srsran_sync_t* q, const cf_t* input, int find_offset,
   float         max_peak_value = -99;
   int           max_cfo_i      = 0;
   srsran_pss_t* pss_obj[3]     = {&q->pss_i[0], &q->pss, &q->pss_i[1]};
+
+  // Integer CFO hypotheses with the same correlation size share the input transform
+  bool shared_fft = srsran_pss_input_fft(&q->pss, &input[find_offset]) == SRSRAN_SUCCESS;
+
   for (int cfo = 0; cfo < 3; cfo++) {
     srsran_pss_set_N_id_2(pss_obj[cfo], q->N_id_2);
-    int p = srsran_pss_find_pss(pss_obj[cfo], &input[find_offset], &peak_value);
+    int p;
+    if (shared_fft && pss_obj[cfo]->conv_fft.output_len == q->pss.conv_fft.output_len &&
+        pss_obj[cfo]->decimate == q->pss.decimate) {
+      p = srsran_pss_find_pss_fft(pss_obj[cfo], &q->pss, &peak_value);
+    } else {
+      p = srsran_pss_find_pss(pss_obj[cfo], &input[find_offset], &peak_value);
+    }
     if (p < 0) {
       return -1;
     }
@@ -626,8 +636,11 @@ static int cfo_i_estimate(srsran_sync_t* q, const cf_t* input, int find_offset,
  *
  * The maximum of the correlation peak is always stored in *peak_position
  */
-srsran_sync_find_ret_t
-srsran_sync_find(srsran_sync_t* q, const cf_t* input, uint32_t find_offset, uint32_t* peak_position)
+static srsran_sync_find_ret_t sync_find(srsran_sync_t*       q,
+                                        const srsran_sync_t* src,
+                                        const cf_t*          input,
+                                        uint32_t             find_offset,
+                                        uint32_t*            peak_position)
 {
   srsran_sync_find_ret_t ret      = SRSRAN_SYNC_ERROR;
   int                    peak_pos = 0;
@@ -687,7 +700,12 @@ srsran_sync_find(srsran_sync_t* q, const cf_t* input, uint32_t find_offset, uint
      */
     if (!q->cfo_i_enable) {
       srsran_pss_set_N_id_2(&q->pss, q->N_id_2);
-      peak_pos = srsran_pss_find_pss(&q->pss, &input_ptr[find_offset], q->threshold > 0 ? &q->peak_value : NULL);
+      if (src != NULL && !q->cfo_cp_enable) {
+        // Reuse the input transform of the other object
+        peak_pos = srsran_pss_find_pss_fft(&q->pss, &src->pss, q->threshold > 0 ? &q->peak_value : NULL);
+      } else {
+        peak_pos = srsran_pss_find_pss(&q->pss, &input_ptr[find_offset], q->threshold > 0 ? &q->peak_value : NULL);
+      }
       if (peak_pos < 0) {
         ERROR("Error calling finding PSS sequence at : %d  ", peak_pos);
         return SRSRAN_ERROR;
@@ -842,6 +860,26 @@ srsran_sync_find(srsran_sync_t* q, const cf_t* input, uint32_t find_offset, uint
   return ret;
 }
 
+srsran_sync_find_ret_t
+srsran_sync_find(srsran_sync_t* q, const cf_t* input, uint32_t find_offset, uint32_t* peak_position)
+{
+  return sync_find(q, NULL, input, find_offset, peak_position);
+}
+
+srsran_sync_find_ret_t srsran_sync_find_shared(srsran_sync_t*       q,
+                                               const srsran_sync_t* src,
+                                               const cf_t*          input,
+                                               uint32_t             find_offset,
+                                               uint32_t*            peak_position)
+{
+  // The input transform of src can only be reused if it was not CFO corrected
+  if (src == NULL || src->cfo_cp_enable || src->cfo_i_enable || src->pss.frame_size != q->pss.frame_size ||
+      src->pss.fft_size != q->pss.fft_size) {
+    return sync_find(q, NULL, input, find_offset, peak_position);
+  }
+  return sync_find(q, src, input, find_offset, peak_position);
+}
+
 void srsran_sync_reset(srsran_sync_t* q)
 {
   q->M_ext_avg  = 0;
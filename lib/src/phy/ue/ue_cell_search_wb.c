@@ -0,0 +1,314 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/ue/ue_cell_search_wb.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
+#include <complex.h>
+#include <math.h>
+#include <string.h>
+
+// Cell search runs with 6 PRB, 128-point FFT at 1.92 MHz
+#define CS_WB_FFT_SIZE 128
+#define CS_WB_SF_LEN SRSRAN_SF_LEN(CS_WB_FFT_SIZE)
+
+// Each detection window covers half a radio frame, so it contains one PSS/SSS of every cell. Consecutive windows overlap
+// by one symbol so a PSS cut by the end of a window is fully contained in the next one
+#define CS_WB_FRAME_LEN (5 * CS_WB_SF_LEN)
+#define CS_WB_WINDOW_STEP (CS_WB_FRAME_LEN - CS_WB_FFT_SIZE)
+
+// Samples kept before the window so a PSS at its beginning still has its SSS available
+#define CS_WB_SSS_ROOM (2 * (CS_WB_FFT_SIZE + SRSRAN_CP_LEN_EXT(CS_WB_FFT_SIZE)))
+
+// The down-converter processes one narrowband subframe at a time
+#define CS_WB_NB_BUFFER_LEN (CS_WB_SSS_ROOM + CS_WB_FRAME_LEN + CS_WB_SF_LEN)
+
+// Bandwidth occupied by PSS/SSS
+#define CS_WB_SYNC_BW_HZ (SRSRAN_PSS_LEN * 15e3)
+
+#define CS_WB_DEFAULT_PSR_THRESHOLD 2.0f
+#define CS_WB_DEFAULT_EARLY_EXIT_PSR 8.0f
+#define CS_WB_DEFAULT_NOF_VALID_FRAMES 4
+
+int srsran_ue_cellsearch_wb_init(srsran_ue_cellsearch_wb_t* q, double srate_hz)
+{
+  int ret = SRSRAN_ERROR_INVALID_INPUTS;
+
+  if (q == NULL || !isnormal(srate_hz)) {
+    return ret;
+  }
+
+  SRSRAN_MEM_ZERO(q, srsran_ue_cellsearch_wb_t, 1);
+  ret = SRSRAN_ERROR;
+
+  double ratio = srate_hz / SRSRAN_CS_SAMP_FREQ;
+  if (ratio < 1.0 || fabs(ratio - round(ratio)) > 1e-6) {
+    ERROR("Wideband sampling rate (%.2f MHz) must be a multiple of %.2f MHz",
+          srate_hz / 1e6,
+          SRSRAN_CS_SAMP_FREQ / 1e6);
+    goto clean_exit;
+  }
+  q->srate_hz   = srate_hz;
+  q->decimation = (uint32_t)round(ratio);
+
+  if (q->decimation > 1) {
+    if (srsran_resampler_fft_init(&q->decimator, SRSRAN_RESAMPLER_MODE_DECIMATE, q->decimation) < SRSRAN_SUCCESS) {
+      ERROR("Error initiating decimator");
+      goto clean_exit;
+    }
+  }
+
+  q->mix_buffer = srsran_vec_cf_malloc(CS_WB_SF_LEN * q->decimation);
+  q->nb_buffer  = srsran_vec_cf_malloc(CS_WB_NB_BUFFER_LEN);
+  if (q->mix_buffer == NULL || q->nb_buffer == NULL) {
+    ERROR("Error allocating memory");
+    goto clean_exit;
+  }
+
+  // Same find configuration as ue_sync in cell search mode, one object per N_id_2
+  for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2; N_id_2++) {
+    srsran_sync_t* s = &q->sfind[N_id_2];
+    if (srsran_sync_init(s, CS_WB_FRAME_LEN, CS_WB_FRAME_LEN, CS_WB_FFT_SIZE) < SRSRAN_SUCCESS) {
+      ERROR("Error initiating sync find");
+      goto clean_exit;
+    }
+    srsran_sync_set_cfo_i_enable(s, false);
+    srsran_sync_set_cfo_pss_enable(s, true);
+    srsran_sync_set_pss_filt_enable(s, true);
+    srsran_sync_set_sss_eq_enable(s, false);
+    srsran_sync_cp_en(s, false);
+    srsran_sync_sss_en(s, true);
+    srsran_sync_set_cp(s, SRSRAN_CP_NORM);
+    srsran_sync_set_em_alpha(s, 1);
+    srsran_sync_set_cfo_ema_alpha(s, 0.1);
+    srsran_sync_set_N_id_2(s, N_id_2);
+  }
+
+  srsran_ue_cellsearch_wb_set_cfg(q, NULL);
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  if (ret == SRSRAN_ERROR) {
+    srsran_ue_cellsearch_wb_free(q);
+  }
+  return ret;
+}
+
+void srsran_ue_cellsearch_wb_free(srsran_ue_cellsearch_wb_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  srsran_resampler_fft_free(&q->decimator);
+  for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2; N_id_2++) {
+    srsran_sync_free(&q->sfind[N_id_2]);
+  }
+  if (q->mix_buffer) {
+    free(q->mix_buffer);
+  }
+  if (q->nb_buffer) {
+    free(q->nb_buffer);
+  }
+
+  SRSRAN_MEM_ZERO(q, srsran_ue_cellsearch_wb_t, 1);
+}
+
+void srsran_ue_cellsearch_wb_set_cfg(srsran_ue_cellsearch_wb_t* q, const srsran_ue_cellsearch_wb_cfg_t* cfg)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  if (cfg != NULL) {
+    q->cfg = *cfg;
+  } else {
+    q->cfg.psr_threshold    = CS_WB_DEFAULT_PSR_THRESHOLD;
+    q->cfg.early_exit_psr   = CS_WB_DEFAULT_EARLY_EXIT_PSR;
+    q->cfg.nof_valid_frames = CS_WB_DEFAULT_NOF_VALID_FRAMES;
+  }
+
+  for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2; N_id_2++) {
+    srsran_sync_set_threshold(&q->sfind[N_id_2], q->cfg.psr_threshold);
+  }
+}
+
+int srsran_ue_cellsearch_wb_set_channel(srsran_ue_cellsearch_wb_t* q, double offset_hz)
+{
+  if (q == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  if (fabs(offset_hz) + CS_WB_SYNC_BW_HZ / 2 > q->srate_hz / 2) {
+    ERROR("Channel offset %.3f MHz is out of the capture bandwidth (%.2f MHz)", offset_hz / 1e6, q->srate_hz / 1e6);
+    return SRSRAN_ERROR;
+  }
+
+  q->offset_hz  = offset_hz;
+  q->mix_count  = 0;
+  q->nb_len     = 0;
+  q->nof_frames = 0;
+  q->found      = false;
+  SRSRAN_MEM_ZERO(&q->best, srsran_ue_cellsearch_result_t, 1);
+  SRSRAN_MEM_ZERO(q->nof_detections, uint32_t, SRSRAN_NUM_PCI);
+
+  if (q->decimation > 1) {
+    srsran_resampler_fft_reset_state(&q->decimator);
+  }
+  for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2; N_id_2++) {
+    srsran_sync_reset(&q->sfind[N_id_2]);
+    srsran_sync_cfo_reset(&q->sfind[N_id_2], 0.0f);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+// Down-converts and decimates a block of at most one narrowband subframe, appending it to the narrowband buffer
+static void cellsearch_wb_ddc(srsran_ue_cellsearch_wb_t* q, const cf_t* wb, uint32_t nof_samples)
+{
+  // The oscillator restarts every block, so its initial phase is computed from the absolute sample count. This keeps
+  // the phase continuous across blocks without accumulating rounding errors on long captures
+  double freq_norm = -q->offset_hz / q->srate_hz;
+  double phase     = 2.0 * M_PI * fmod(freq_norm * (double)q->mix_count, 1.0);
+  cf_t   phase0    = (cf_t)cexp(I * phase);
+
+  srsran_vec_apply_cfo(wb, (float)freq_norm, q->mix_buffer, (int)nof_samples);
+  srsran_vec_sc_prod_ccc(q->mix_buffer, phase0, q->mix_buffer, nof_samples);
+  q->mix_count += nof_samples;
+
+  srsran_resampler_fft_run(&q->decimator, q->mix_buffer, &q->nb_buffer[q->nb_len], nof_samples);
+  q->nb_len += nof_samples / q->decimation;
+}
+
+// Registers a detection and decides whether the search terminates
+static bool cellsearch_wb_detection(srsran_ue_cellsearch_wb_t* q, const srsran_ue_cellsearch_result_t* candidate)
+{
+  uint32_t count = ++q->nof_detections[candidate->cell_id];
+
+  // Keep the most detected cell, the newest detection provides the averaged CFO
+  if (candidate->cell_id == q->best.cell_id || count > q->nof_detections[q->best.cell_id]) {
+    q->best = *candidate;
+  }
+  q->best.mode = (float)q->nof_detections[q->best.cell_id] / (float)SRSRAN_MAX(q->nof_frames, 1);
+
+  // A single peak with high confidence is enough, otherwise wait for enough detections of the same cell
+  if (candidate->psr >= q->cfg.early_exit_psr) {
+    q->best      = *candidate;
+    q->best.mode = (float)count / (float)SRSRAN_MAX(q->nof_frames, 1);
+    return true;
+  }
+  return count >= q->cfg.nof_valid_frames;
+}
+
+// Looks for PSS/SSS of all N_id_2 in the current detection window
+static int cellsearch_wb_detect(srsran_ue_cellsearch_wb_t* q)
+{
+  q->nof_frames++;
+
+  for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2 && !q->found; N_id_2++) {
+    srsran_sync_t* s        = &q->sfind[N_id_2];
+    uint32_t       peak_pos = 0;
+
+    // The PSS input transform of the first hypothesis is reused by the others
+    srsran_sync_find_ret_t ret =
+        (N_id_2 == 0) ? srsran_sync_find(s, q->nb_buffer, CS_WB_SSS_ROOM, &peak_pos)
+                      : srsran_sync_find_shared(s, &q->sfind[0], q->nb_buffer, CS_WB_SSS_ROOM, &peak_pos);
+    if (ret == SRSRAN_SYNC_ERROR) {
+      ERROR("Error finding PSS for N_id_2=%d", N_id_2);
+      return SRSRAN_ERROR;
+    }
+
+    if (ret == SRSRAN_SYNC_FOUND && srsran_sync_sss_detected(s)) {
+      int cell_id = srsran_sync_get_cell_id(s);
+      if (cell_id < 0) {
+        continue;
+      }
+
+      srsran_ue_cellsearch_result_t candidate = {};
+      candidate.cell_id                       = (uint32_t)cell_id;
+      candidate.cp                            = srsran_sync_get_cp(s);
+      candidate.frame_type                    = s->frame_type;
+      candidate.peak                          = s->pss.peak_value;
+      candidate.psr                           = srsran_sync_get_peak_value(s);
+      candidate.cfo                           = 15000 * srsran_sync_get_cfo(s);
+
+      DEBUG("CELL SEARCH WB: offset=%.3f MHz; N_id_2=%d; cell_id=%d; psr=%.1f; pos=%d",
+            q->offset_hz / 1e6,
+            N_id_2,
+            cell_id,
+            candidate.psr,
+            peak_pos);
+
+      q->found = cellsearch_wb_detection(q, &candidate);
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_ue_cellsearch_wb_feed(srsran_ue_cellsearch_wb_t*     q,
+                                 const cf_t*                    wb,
+                                 uint32_t                       nof_samples,
+                                 srsran_ue_cellsearch_result_t* result)
+{
+  if (q == NULL || wb == NULL || q->nb_buffer == NULL || nof_samples % q->decimation != 0) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  uint32_t block_len = CS_WB_SF_LEN * q->decimation;
+  uint32_t count     = 0;
+
+  while (count < nof_samples && !q->found) {
+    uint32_t n = SRSRAN_MIN(block_len, nof_samples - count);
+    cellsearch_wb_ddc(q, &wb[count], n);
+    count += n;
+
+    // Run detection as soon as a window and its SSS room are available
+    if (q->nb_len >= CS_WB_SSS_ROOM + CS_WB_FRAME_LEN) {
+      if (cellsearch_wb_detect(q) < SRSRAN_SUCCESS) {
+        return SRSRAN_ERROR;
+      }
+      q->nb_len -= CS_WB_WINDOW_STEP;
+      memmove(q->nb_buffer, &q->nb_buffer[CS_WB_WINDOW_STEP], sizeof(cf_t) * q->nb_len);
+    }
+  }
+
+  if (q->found && result != NULL) {
+    *result = q->best;
+  }
+
+  return q->found ? 1 : 0;
+}
+
+int srsran_ue_cellsearch_wb_get_best(srsran_ue_cellsearch_wb_t* q, srsran_ue_cellsearch_result_t* result)
+{
+  if (q == NULL || result == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  if (q->nof_detections[q->best.cell_id] == 0) {
+    return 0;
+  }
+
+  *result = q->best;
+  return 1;
+}
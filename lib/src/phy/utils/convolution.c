@@ -110,15 +110,26 @@ void srsran_conv_fft_cc_free(srsran_conv_fft_cc_t* q)
   bzero(q, sizeof(srsran_conv_fft_cc_t));
 }
 
-uint32_t srsran_conv_fft_cc_run_opt(srsran_conv_fft_cc_t* q, const cf_t* input, const cf_t* filter_freq, cf_t* output)
+void srsran_conv_fft_cc_run_input(srsran_conv_fft_cc_t* q, const cf_t* input)
 {
   srsran_dft_run_c(&q->input_plan, input, q->input_fft);
-  srsran_vec_prod_ccc(q->input_fft, filter_freq, q->output_fft, q->output_len);
+}
+
+uint32_t
+srsran_conv_fft_cc_run_freq(srsran_conv_fft_cc_t* q, const cf_t* input_freq, const cf_t* filter_freq, cf_t* output)
+{
+  srsran_vec_prod_ccc(input_freq, filter_freq, q->output_fft, q->output_len);
   srsran_dft_run_c(&q->output_plan, q->output_fft, output);
 
   return (q->output_len - 1); // divide output length by dec factor
 }
 
+uint32_t srsran_conv_fft_cc_run_opt(srsran_conv_fft_cc_t* q, const cf_t* input, const cf_t* filter_freq, cf_t* output)
+{
+  srsran_conv_fft_cc_run_input(q, input);
+  return srsran_conv_fft_cc_run_freq(q, q->input_fft, filter_freq, output);
+}
+
 uint32_t srsran_conv_fft_cc_run(srsran_conv_fft_cc_t* q, const cf_t* input, const cf_t* filter, cf_t* output)
 {
   srsran_dft_run_c(&q->filter_plan, filter, q->filter_fft);
@@ -0,0 +1,112 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/utils/mem_arena.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
+#include <stdlib.h>
+#include <string.h>
+
+int srsran_mem_arena_init(srsran_mem_arena_t* q, size_t size)
+{
+  if (q == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  SRSRAN_MEM_ZERO(q, srsran_mem_arena_t, 1);
+  q->epoch = 1;
+
+  if (size == 0) {
+    return SRSRAN_SUCCESS;
+  }
+
+  void* ptr = NULL;
+  q->size   = SRSRAN_MEM_ARENA_SIZE(uint8_t, size);
+  srsran_mem_guard_notify(q->size);
+  if (posix_memalign(&ptr, SRSRAN_MEM_ARENA_ALIGN, q->size)) {
+    ERROR("Error allocating %zd bytes", q->size);
+    q->size = 0;
+    return SRSRAN_ERROR;
+  }
+  q->buffer = (uint8_t*)ptr;
+
+  // Touch all the pages, so the real-time threads do not take page faults
+  memset(q->buffer, 0, q->size);
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_mem_arena_free(srsran_mem_arena_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  if (q->buffer) {
+    free(q->buffer);
+  }
+
+  SRSRAN_MEM_ZERO(q, srsran_mem_arena_t, 1);
+}
+
+void* srsran_mem_arena_alloc(srsran_mem_arena_t* q, size_t nbytes)
+{
+  if (q == NULL) {
+    return NULL;
+  }
+
+  // The offset is always aligned, so aligning the size keeps the next buffer aligned too
+  size_t aligned_nbytes = SRSRAN_MEM_ARENA_SIZE(uint8_t, nbytes);
+  if (q->buffer == NULL || aligned_nbytes > q->size - q->offset) {
+    q->nof_failed++;
+    return NULL;
+  }
+
+  void* ptr = q->buffer + q->offset;
+  q->offset += aligned_nbytes;
+  q->high_water = SRSRAN_MAX(q->high_water, q->offset);
+
+  return ptr;
+}
+
+void srsran_mem_arena_set_mark(srsran_mem_arena_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  q->mark = q->offset;
+}
+
+void srsran_mem_arena_reset(srsran_mem_arena_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  q->offset = q->mark;
+
+  // Epoch 0 is never used, so users can start with 0 to force their first allocation
+  q->epoch++;
+  if (q->epoch == 0) {
+    q->epoch = 1;
+  }
+}
@@ -0,0 +1,141 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/mem_arena.h"
+#include <cstdlib>
+#include <new>
+
+static thread_local bool     mem_guard_enabled = false;
+static thread_local bool     mem_guard_assert  = false;
+static thread_local uint32_t mem_guard_count   = 0;
+
+void srsran_mem_guard_enter(bool assert_no_alloc)
+{
+  mem_guard_enabled = true;
+  mem_guard_assert  = assert_no_alloc;
+  mem_guard_count   = 0;
+}
+
+uint32_t srsran_mem_guard_exit(void)
+{
+  mem_guard_enabled = false;
+  return mem_guard_count;
+}
+
+void srsran_mem_guard_notify(size_t nbytes)
+{
+  if (!mem_guard_enabled) {
+    return;
+  }
+
+  mem_guard_count++;
+
+  if (mem_guard_assert) {
+    // The logger may allocate too, stop counting before reporting
+    mem_guard_enabled = false;
+    ERROR("Heap allocation of %zd bytes in a real-time section", nbytes);
+    abort();
+  }
+}
+
+bool srsran_mem_guard_is_enabled(bool* assert_no_alloc)
+{
+  if (assert_no_alloc != NULL) {
+    *assert_no_alloc = mem_guard_assert;
+  }
+  return mem_guard_enabled;
+}
+
+void srsran_mem_guard_add(uint32_t nof_allocs)
+{
+  if (mem_guard_enabled) {
+    mem_guard_count += nof_allocs;
+  }
+}
+
+#ifdef ENABLE_NEW_GUARD
+// Replacement of the global allocation functions, so the guard also sees the C++ heap allocations (new, std::vector,
+// std::string, ...). It applies to every binary linking the PHY library, so it is only built with ENABLE_NEW_GUARD.
+static void* mem_guard_new(size_t nbytes) noexcept
+{
+  srsran_mem_guard_notify(nbytes);
+  return malloc(nbytes == 0 ? 1 : nbytes);
+}
+
+void* operator new(size_t nbytes)
+{
+  void* ptr = mem_guard_new(nbytes);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void* operator new[](size_t nbytes)
+{
+  void* ptr = mem_guard_new(nbytes);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void* operator new(size_t nbytes, const std::nothrow_t&) noexcept
+{
+  return mem_guard_new(nbytes);
+}
+
+void* operator new[](size_t nbytes, const std::nothrow_t&) noexcept
+{
+  return mem_guard_new(nbytes);
+}
+
+void operator delete(void* ptr) noexcept
+{
+  free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+  free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+  free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept
+{
+  free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+  free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+  free(ptr);
+}
+#endif // ENABLE_NEW_GUARD
@@ -0,0 +1,96 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/support/srsran_test.h"
+#include <stdlib.h>
+
+#include "srsran/phy/utils/mem_arena.h"
+#include "srsran/phy/utils/vector.h"
+
+#define ARENA_SIZE 4096
+
+static int test_arena_alloc(void)
+{
+  srsran_mem_arena_t arena = {};
+  TESTASSERT(srsran_mem_arena_init(&arena, ARENA_SIZE) == SRSRAN_SUCCESS);
+
+  // Buffers are aligned and do not overlap
+  uint8_t* a = SRSRAN_MEM_ARENA_ALLOC(&arena, uint8_t, 3);
+  cf_t*    b = SRSRAN_MEM_ARENA_ALLOC(&arena, cf_t, 10);
+  TESTASSERT(a != NULL && b != NULL);
+  TESTASSERT(((uintptr_t)a % SRSRAN_MEM_ARENA_ALIGN) == 0);
+  TESTASSERT(((uintptr_t)b % SRSRAN_MEM_ARENA_ALIGN) == 0);
+  TESTASSERT((uint8_t*)b >= a + 3);
+
+  // Buffers before the mark survive the reset
+  srsran_mem_arena_set_mark(&arena);
+  size_t   persistent = arena.offset;
+  uint32_t epoch      = arena.epoch;
+  uint8_t* c          = SRSRAN_MEM_ARENA_ALLOC(&arena, uint8_t, 100);
+  TESTASSERT(epoch != 0);
+  TESTASSERT(c != NULL && c >= (uint8_t*)(b + 10));
+  srsran_mem_arena_reset(&arena);
+  TESTASSERT(arena.offset == persistent);
+  TESTASSERT(arena.epoch != epoch);
+  TESTASSERT(SRSRAN_MEM_ARENA_ALLOC(&arena, uint8_t, 100) == c);
+
+  // Exhausting the arena fails without corrupting the state
+  srsran_mem_arena_reset(&arena);
+  TESTASSERT(srsran_mem_arena_alloc(&arena, ARENA_SIZE) == NULL);
+  TESTASSERT(arena.nof_failed == 1);
+  TESTASSERT(arena.offset == persistent);
+  TESTASSERT(srsran_mem_arena_alloc(&arena, ARENA_SIZE - persistent) != NULL);
+  TESTASSERT(arena.high_water == ARENA_SIZE);
+
+  srsran_mem_arena_free(&arena);
+  TESTASSERT(srsran_mem_arena_alloc(&arena, 1) == NULL);
+
+  return SRSRAN_SUCCESS;
+}
+
+static int test_guard(void)
+{
+  // Allocations out of the guard are not counted
+  void* ptr = srsran_vec_malloc(16);
+  TESTASSERT(ptr != NULL);
+
+  srsran_mem_guard_enter(false);
+  srsran_mem_arena_t arena = {};
+  TESTASSERT(srsran_mem_arena_init(&arena, ARENA_SIZE) == SRSRAN_SUCCESS);
+  ptr = srsran_vec_realloc(ptr, 16, 32);
+  TESTASSERT(ptr != NULL);
+  TESTASSERT(SRSRAN_MEM_ARENA_ALLOC(&arena, uint8_t, 16) != NULL);
+  TESTASSERT(srsran_mem_guard_exit() == 2);
+
+  free(ptr);
+  srsran_mem_arena_free(&arena);
+
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  TESTASSERT(test_arena_alloc() == SRSRAN_SUCCESS);
+  TESTASSERT(test_guard() == SRSRAN_SUCCESS);
+
+  printf("Ok\n");
+  return SRSRAN_SUCCESS;
+}
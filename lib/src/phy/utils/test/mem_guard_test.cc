@@ -0,0 +1,67 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/utils/mem_arena.h"
+#include "srsran/phy/utils/vector.h"
+#include "srsran/support/srsran_test.h"
+#include <memory>
+#include <vector>
+
+static int test_guard_vec_malloc()
+{
+  srsran_mem_guard_enter(false);
+  float* a = srsran_vec_f_malloc(32);
+  TESTASSERT(srsran_mem_guard_exit() == 1);
+  free(a);
+
+  return SRSRAN_SUCCESS;
+}
+
+static int test_guard_operator_new()
+{
+  srsran_mem_guard_enter(false);
+  std::unique_ptr<int>   a(new int(1));
+  std::unique_ptr<int[]> b(new int[16]);
+  std::vector<float>     c(32);
+  std::unique_ptr<int>   d(new (std::nothrow) int(2));
+#ifdef ENABLE_NEW_GUARD
+  TESTASSERT(srsran_mem_guard_exit() == 4);
+#else
+  // The global allocation functions are only replaced with ENABLE_NEW_GUARD
+  TESTASSERT(srsran_mem_guard_exit() == 0);
+#endif
+
+  // Allocations out of the guard are not counted
+  std::vector<float> e(32);
+  srsran_mem_guard_enter(false);
+  TESTASSERT(srsran_mem_guard_exit() == 0);
+
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  TESTASSERT(test_guard_vec_malloc() == SRSRAN_SUCCESS);
+  TESTASSERT(test_guard_operator_new() == SRSRAN_SUCCESS);
+
+  printf("Ok\n");
+  return SRSRAN_SUCCESS;
+}
@@ -27,6 +27,7 @@
 
 #include "srsran/phy/utils/bit.h"
 #include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/mem_arena.h"
 #include "srsran/phy/utils/simd.h"
 #include "srsran/phy/utils/vector.h"
 #include "srsran/phy/utils/vector_simd.h"
@@ -154,6 +155,7 @@ void srsran_vec_lut_sis(const short* x, const unsigned int* lut, short* y, const
 void* srsran_vec_malloc(uint32_t size)
 {
   void* ptr;
+  srsran_mem_guard_notify(size);
   if (posix_memalign(&ptr, SRSRAN_SIMD_BIT_ALIGN, size)) {
     return NULL;
   } else {
@@ -268,6 +270,7 @@ void srsran_vec_u16_copy(uint16_t* dst, const uint16_t* src, uint32_t len)
 
 void* srsran_vec_realloc(void* ptr, uint32_t old_size, uint32_t new_size)
 {
+  srsran_mem_guard_notify(new_size);
 #ifndef LV_HAVE_SSE
   return realloc(ptr, new_size);
 #else
@@ -433,6 +433,21 @@ void srsran_vec_convert_if_simd(const int16_t* x, float* z, const float scale, c
   }
 }
 
+// Scalar conversions of the SIMD kernel tails, they saturate like the SIMD packing does
+static inline int16_t vec_convert_saturate_s(float x)
+{
+  x = (x > (float)INT16_MAX) ? (float)INT16_MAX : x;
+  x = (x < (float)INT16_MIN) ? (float)INT16_MIN : x;
+  return (int16_t)x;
+}
+
+static inline int8_t vec_convert_saturate_b(float x)
+{
+  x = (x > (float)INT8_MAX) ? (float)INT8_MAX : x;
+  x = (x < (float)INT8_MIN) ? (float)INT8_MIN : x;
+  return (int8_t)x;
+}
+
 void srsran_vec_convert_fi_simd(const float* x, int16_t* z, const float scale, const int len)
 {
   int i = 0;
@@ -467,7 +482,7 @@ void srsran_vec_convert_fi_simd(const float* x, int16_t* z, const float scale, c
 #endif /* SRSRAN_SIMD_F_SIZE && SRSRAN_SIMD_S_SIZE */
 
   for (; i < len; i++) {
-    z[i] = (int16_t)(x[i] * scale);
+    z[i] = vec_convert_saturate_s(x[i] * scale);
   }
 }
 
@@ -513,9 +528,9 @@ void srsran_vec_convert_conj_cs_simd(const cf_t* x_, int16_t* z, const float sca
 #endif /* SRSRAN_SIMD_F_SIZE && SRSRAN_SIMD_S_SIZE */
 
   for (; i < len; i++) {
-    z[i] = (int16_t)(x[i] * scale);
+    z[i] = vec_convert_saturate_s(x[i] * scale);
     i++;
-    z[i] = (int16_t)(x[i] * -scale);
+    z[i] = vec_convert_saturate_s(x[i] * -scale);
   }
 }
 
@@ -555,10 +570,10 @@ void srsran_vec_convert_fb_simd(const float* x, int8_t* z, const float scale, co
     }
   } else {
     for (; i < len - 16 + 1; i += 16) {
-      __m128 a = _mm_load_ps(&x[i]);
-      __m128 b = _mm_load_ps(&x[i + 1 * 4]);
-      __m128 c = _mm_load_ps(&x[i + 2 * 4]);
-      __m128 d = _mm_load_ps(&x[i + 3 * 4]);
+      __m128 a = _mm_loadu_ps(&x[i]);
+      __m128 b = _mm_loadu_ps(&x[i + 1 * 4]);
+      __m128 c = _mm_loadu_ps(&x[i + 2 * 4]);
+      __m128 d = _mm_loadu_ps(&x[i + 3 * 4]);
 
       __m128 sa = _mm_mul_ps(a, s);
       __m128 sb = _mm_mul_ps(b, s);
@@ -584,7 +599,7 @@ void srsran_vec_convert_fb_simd(const float* x, int8_t* z, const float scale, co
 #endif /* HAVE_NEON */
 
   for (; i < len; i++) {
-    z[i] = (int8_t)(x[i] * scale);
+    z[i] = vec_convert_saturate_b(x[i] * scale);
   }
 }
 
@@ -360,7 +360,7 @@ void rlc_am_lte_tx::retransmit_pdu(uint32_t sn)
   rlc_amd_retx_lte_t& retx = retx_queue.push();
   retx.is_segment          = false;
   retx.so_start            = 0;
-  retx.so_end              = pdu.buf->N_bytes;
+  retx.so_end              = pdu.buf.size();
   retx.sn                  = pdu.rlc_sn;
 }
 
@@ -486,7 +486,7 @@ int rlc_am_lte_tx::build_retx_pdu(uint8_t* payload, uint32_t nof_bytes)
 
   // Set poll bit
   pdu_without_poll++;
-  byte_without_poll += (tx_window[retx.sn].buf->N_bytes + rlc_am_packed_length(&new_header));
+  byte_without_poll += (tx_window[retx.sn].buf.size() + rlc_am_packed_length(&new_header));
   RlcInfo("pdu_without_poll: %d", pdu_without_poll);
   RlcInfo("byte_without_poll: %d", byte_without_poll);
   if (poll_required()) {
@@ -503,32 +503,32 @@ int rlc_am_lte_tx::build_retx_pdu(uint8_t* payload, uint32_t nof_bytes)
 
   uint8_t* ptr = payload;
   rlc_am_write_data_pdu_header(&new_header, &ptr);
-  memcpy(ptr, tx_window[retx.sn].buf->msg, tx_window[retx.sn].buf->N_bytes);
+  tx_window[retx.sn].buf.copy_to(byte_span{ptr, tx_window[retx.sn].buf.size()});
 
   retx_queue.pop();
 
   RlcHexInfo(payload,
-             tx_window[retx.sn].buf->N_bytes,
+             tx_window[retx.sn].buf.size(),
              "Tx PDU SN=%d (%d B) (attempt %d/%d)",
              retx.sn,
-             tx_window[retx.sn].buf->N_bytes,
+             tx_window[retx.sn].buf.size(),
              tx_window[retx.sn].retx_count + 1,
              cfg.max_retx_thresh);
   log_rlc_amd_pdu_header_to_string(logger.debug, rb_name, "Tx PDU - %s", new_header);
 
   debug_state();
-  return (ptr - payload) + tx_window[retx.sn].buf->N_bytes;
+  return (ptr - payload) + tx_window[retx.sn].buf.size();
 }
 
 int rlc_am_lte_tx::build_segment(uint8_t* payload, uint32_t nof_bytes, rlc_amd_retx_lte_t retx)
 {
-  if (tx_window[retx.sn].buf == NULL) {
-    RlcError("In build_segment: retx.sn=%d has null buffer", retx.sn);
+  if (tx_window[retx.sn].buf.empty()) {
+    RlcError("In build_segment: retx.sn=%d has empty buffer", retx.sn);
     return 0;
   }
   if (!retx.is_segment) {
     retx.so_start = 0;
-    retx.so_end   = tx_window[retx.sn].buf->N_bytes;
+    retx.so_end   = tx_window[retx.sn].buf.size();
   }
 
   // Construct new header
@@ -536,7 +536,7 @@ int rlc_am_lte_tx::build_segment(uint8_t* payload, uint32_t nof_bytes, rlc_amd_r
   rlc_amd_pdu_header_t old_header = tx_window[retx.sn].header;
 
   pdu_without_poll++;
-  byte_without_poll += (tx_window[retx.sn].buf->N_bytes + rlc_am_packed_length(&new_header));
+  byte_without_poll += (tx_window[retx.sn].buf.size() + rlc_am_packed_length(&new_header));
   RlcInfo("pdu_without_poll: %d, byte_without_poll: %d", pdu_without_poll, byte_without_poll);
 
   new_header.dc   = RLC_DC_FIELD_DATA_PDU;
@@ -636,7 +636,7 @@ int rlc_am_lte_tx::build_segment(uint8_t* payload, uint32_t nof_bytes, rlc_amd_r
   srsran_expect(head_len + (retx.so_end - retx.so_start) <= nof_bytes, "The provided buffer was overflown.");
 
   // Update retx_queue
-  if (tx_window[retx.sn].buf->N_bytes == retx.so_end) {
+  if (tx_window[retx.sn].buf.size() == retx.so_end) {
     retx_queue.pop();
     new_header.lsf = 1;
     if (rlc_am_end_aligned(old_header.fi)) {
@@ -664,9 +664,8 @@ int rlc_am_lte_tx::build_segment(uint8_t* payload, uint32_t nof_bytes, rlc_amd_r
   // Write header and pdu
   uint8_t* ptr = payload;
   rlc_am_write_data_pdu_header(&new_header, &ptr);
-  uint8_t* data = &tx_window[retx.sn].buf->msg[retx.so_start];
-  uint32_t len  = retx.so_end - retx.so_start;
-  memcpy(ptr, data, len);
+  uint32_t len = retx.so_end - retx.so_start;
+  tx_window[retx.sn].buf.copy_to(byte_span{ptr, len}, retx.so_start);
 
   debug_state();
   int pdu_len = (ptr - payload) + len;
@@ -738,6 +737,15 @@ int rlc_am_lte_tx::build_data_pdu(uint8_t* payload, uint32_t nof_bytes)
     return 0;
   }
 
+  // The retx copy can't be allocated once the PDU is built, so its segments are taken for the largest possible PDU
+  uint32_t max_payload = SRSRAN_MIN(nof_bytes, pdu->get_tailroom()) - rlc_am_packed_length(&header);
+  max_payload = SRSRAN_MIN(max_payload, tx_sdu_queue.size_bytes() + (tx_sdu != nullptr ? tx_sdu->N_bytes : 0));
+  byte_buffer_chain retx_copy;
+  if (not retx_copy.resize(max_payload)) {
+    RlcInfo("Can't build a PDU - No buffer segments available for %d B", max_payload);
+    return 0;
+  }
+
   // insert newly assigned SN into window and use reference for in-place operations
   // NOTE: from now on, we can't return from this function anymore before increasing vt_s
   rlc_amd_tx_pdu_lte& tx_pdu = tx_window.add_pdu(header.sn);
@@ -884,15 +892,18 @@ int rlc_am_lte_tx::build_data_pdu(uint8_t* payload, uint32_t nof_bytes)
   // Update Tx window
   vt_s = (vt_s + 1) % MOD;
 
-  // Write final header and TX
-  tx_pdu.buf                      = std::move(pdu);
-  tx_pdu.header                   = header;
-  const byte_buffer_t* buffer_ptr = tx_pdu.buf.get();
+  // Keep a copy for retx in segments sized to the PDU, the byte buffer is released on return
+  srsran_assert(pdu->N_bytes <= retx_copy.size(), "RLC PDU of %d B exceeds its retx copy", pdu->N_bytes);
+  retx_copy.resize(pdu->N_bytes);
+  retx_copy.copy_from(make_span(pdu));
+  tx_pdu.header = header;
+  tx_pdu.buf    = std::move(retx_copy);
 
+  // Write final header and TX
   uint8_t* ptr = payload;
   rlc_am_write_data_pdu_header(&header, &ptr);
-  memcpy(ptr, buffer_ptr->msg, buffer_ptr->N_bytes);
-  int total_len = (ptr - payload) + buffer_ptr->N_bytes;
+  memcpy(ptr, pdu->msg, pdu->N_bytes);
+  int total_len = (ptr - payload) + pdu->N_bytes;
   RlcHexInfo(payload, total_len, "Tx PDU SN=%d (%d B)", header.sn, total_len);
   log_rlc_amd_pdu_header_to_string(logger.debug, rb_name, "%s", header);
   debug_state();
@@ -965,24 +976,24 @@ void rlc_am_lte_tx::handle_control_pdu(uint8_t* payload, uint32_t nof_bytes)
             retx.sn         = i;
             retx.is_segment = false;
             retx.so_start   = 0;
-            retx.so_end     = pdu.buf->N_bytes;
+            retx.so_end     = pdu.buf.size();
 
             if (status.nacks[j].has_so) {
               // sanity check
-              if (status.nacks[j].so_start >= pdu.buf->N_bytes) {
+              if (status.nacks[j].so_start >= pdu.buf.size()) {
                 // print error but try to send original PDU again
-                RlcInfo("SO_start is larger than original PDU (%d >= %d)", status.nacks[j].so_start, pdu.buf->N_bytes);
+                RlcInfo("SO_start is larger than original PDU (%d >= %d)", status.nacks[j].so_start, pdu.buf.size());
                 status.nacks[j].so_start = 0;
               }
 
               // check for special SO_end value
               if (status.nacks[j].so_end == 0x7FFF) {
-                status.nacks[j].so_end = pdu.buf->N_bytes;
+                status.nacks[j].so_end = pdu.buf.size();
               } else {
                 retx.so_end = status.nacks[j].so_end + 1;
               }
 
-              if (status.nacks[j].so_start < pdu.buf->N_bytes && status.nacks[j].so_end <= pdu.buf->N_bytes) {
+              if (status.nacks[j].so_start < pdu.buf.size() && status.nacks[j].so_end <= pdu.buf.size()) {
                 retx.is_segment = true;
                 retx.so_start   = status.nacks[j].so_start;
               } else {
@@ -990,7 +1001,7 @@ void rlc_am_lte_tx::handle_control_pdu(uint8_t* payload, uint32_t nof_bytes)
                            i,
                            status.nacks[j].so_start,
                            status.nacks[j].so_end,
-                           pdu.buf->N_bytes);
+                           pdu.buf.size());
               }
             }
           } else {
@@ -1088,10 +1099,10 @@ int rlc_am_lte_tx::required_buffer_size(const rlc_amd_retx_lte_t& retx)
 {
   if (!retx.is_segment) {
     if (tx_window.has_sn(retx.sn)) {
-      if (tx_window[retx.sn].buf) {
-        return rlc_am_packed_length(&tx_window[retx.sn].header) + tx_window[retx.sn].buf->N_bytes;
+      if (not tx_window[retx.sn].buf.empty()) {
+        return rlc_am_packed_length(&tx_window[retx.sn].header) + tx_window[retx.sn].buf.size();
       } else {
-        RlcWarning("retx.sn=%d has null ptr in required_buffer_size()", retx.sn);
+        RlcWarning("retx.sn=%d has empty buffer in required_buffer_size()", retx.sn);
         return -1;
       }
     } else {
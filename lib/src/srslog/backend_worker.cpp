@@ -98,18 +98,16 @@ void backend_worker::do_work()
   /// termination variable periodically.
   constexpr std::chrono::microseconds sleep_period{100};
 
-  while (running_flag) {
-    auto item = queue.try_pop();
+  auto process = [this](detail::log_entry&& entry) { process_log_entry(std::move(entry)); };
 
+  while (running_flag) {
     // Spin while there are no new entries to process.
-    if (!item.first) {
+    if (!queue.consume_one(process)) {
       std::this_thread::sleep_for(sleep_period);
       continue;
     }
 
-    report_queue_on_full_once();
-
-    process_log_entry(std::move(item.second));
+    report_dropped_entries_once();
   }
 
   // When we reach here, the thread is about to terminate, last chance to
@@ -139,13 +137,8 @@ void backend_worker::process_log_entry(detail::log_entry&& entry)
   assert(entry.format_func && "Invalid format function");
   fmt_buffer.clear();
 
-  // Save the pointer before moving the entry.
-  auto* arg_store = entry.metadata.store;
-
   entry.format_func(std::move(entry.metadata), fmt_buffer);
 
-  arg_pool.dealloc(arg_store);
-
   if (auto err_str = entry.s->write({fmt_buffer.data(), fmt_buffer.size()})) {
     err_handler(err_str.get_error());
   }
@@ -155,14 +148,6 @@ void backend_worker::process_outstanding_entries()
 {
   assert(!running_flag && "Cannot process outstanding entries while thread is running");
 
-  while (true) {
-    auto item = queue.try_pop();
-
-    // Check if the queue is empty.
-    if (!item.first) {
-      break;
-    }
-
-    process_log_entry(std::move(item.second));
+  while (queue.consume_one([this](detail::log_entry&& entry) { process_log_entry(std::move(entry)); })) {
   }
 }
@@ -22,9 +22,7 @@
 #ifndef SRSLOG_BACKEND_WORKER_H
 #define SRSLOG_BACKEND_WORKER_H
 
-#include "srsran/srslog/detail/log_entry.h"
-#include "srsran/srslog/detail/support/dyn_arg_store_pool.h"
-#include "srsran/srslog/detail/support/work_queue.h"
+#include "log_queue.h"
 #include "srsran/srslog/shared_types.h"
 #include <mutex>
 #include <thread>
@@ -32,13 +30,11 @@
 namespace srslog {
 
 /// The backend worker runs in a secondary thread a routine that endlessly pops
-/// log entries from a work queue and dispatches them to the selected sinks.
+/// log entries from the log queue and dispatches them to the selected sinks.
 class backend_worker
 {
 public:
-  backend_worker(detail::work_queue<detail::log_entry>& queue, detail::dyn_arg_store_pool& arg_pool) :
-    queue(queue), arg_pool(arg_pool), running_flag(false)
-  {}
+  explicit backend_worker(log_queue& queue) : queue(queue) {}
 
   backend_worker(const backend_worker&) = delete;
   backend_worker& operator=(const backend_worker&) = delete;
@@ -58,7 +54,7 @@ public:
 
   /// Returns true if the worker thread is currently running, otherwise
   /// returns false.
-  bool is_running() const { return running_flag; }
+  bool is_running() const { return running_flag.load(std::memory_order_relaxed); }
 
   /// Uses the specified error handler to receive error notifications. Calls to
   /// this method when the worker is running will get ignored.
@@ -93,17 +89,18 @@ private:
   /// Processes outstanding entries in the queue until it gets empty.
   void process_outstanding_entries();
 
-  /// Checks the current size of the queue reporting an error message if it is
-  /// about to reach its maximum capacity.
+  /// Reports an error message when log entries start being discarded because
+  /// of full queues.
   /// Error message is only reported once to avoid spamming.
-  void report_queue_on_full_once()
+  void report_dropped_entries_once()
   {
-    if (queue.is_almost_full()) {
-      err_handler(fmt::format("The backend queue size is about to reach its maximum "
-                              "capacity of {} elements, new log entries will get "
-                              "discarded.\nConsider increasing the queue capacity.",
+    if (!reported_drops && queue.get_nof_dropped() != 0) {
+      err_handler(fmt::format("The log queue of a thread has reached its maximum "
+                              "capacity of {} elements, new log entries are being "
+                              "discarded.\nConsider increasing the queue capacity or "
+                              "using the block queue policy.",
                               queue.get_capacity()));
-      err_handler = [](const std::string&) {};
+      reported_drops = true;
     }
   }
 
@@ -111,9 +108,9 @@ private:
   void set_thread_priority(backend_priority priority) const;
 
 private:
-  detail::work_queue<detail::log_entry>& queue;
-  detail::dyn_arg_store_pool&            arg_pool;
-  detail::shared_variable<bool>          running_flag;
+  log_queue&         queue;
+  std::atomic<bool>  running_flag{false};
+  bool               reported_drops = false;
   error_handler      err_handler = [](const std::string& error) { fmt::print(stderr, "srsLog error - {}\n", error); };
   std::once_flag     start_once_flag;
   std::thread        worker_thread;
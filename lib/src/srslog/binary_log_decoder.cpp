@@ -0,0 +1,256 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include "binary_log_decoder.h"
+#include "formatters/text_formatter.h"
+#include "sinks/file_utils.h"
+#include "srsran/srslog/detail/binary_log_writer.h"
+#include <unordered_map>
+
+using namespace srslog;
+using namespace srslog::detail::binary_log;
+
+namespace {
+
+/// Reads the fields of a record, checking its bounds.
+class record_reader
+{
+  const uint8_t* pos;
+  const uint8_t* end;
+
+public:
+  record_reader(const uint8_t* data, size_t size) : pos(data), end(data + size) {}
+
+  size_t remaining() const { return end - pos; }
+
+  template <typename T>
+  bool read(T& value)
+  {
+    if (remaining() < sizeof(T)) {
+      return false;
+    }
+    std::memcpy(&value, pos, sizeof(T));
+    pos += sizeof(T);
+    return true;
+  }
+
+  const uint8_t* read_bytes(size_t len)
+  {
+    if (remaining() < len) {
+      return nullptr;
+    }
+    const uint8_t* data = pos;
+    pos += len;
+    return data;
+  }
+};
+
+/// Decodes the arguments of an entry into the argument store.
+template <typename T>
+bool push_arg(record_reader& reader, fmt::dynamic_format_arg_store<fmt::printf_context>& store)
+{
+  T value;
+  if (!reader.read(value)) {
+    return false;
+  }
+  store.push_back(value);
+  return true;
+}
+
+bool decode_args(record_reader& reader, unsigned nof_args, fmt::dynamic_format_arg_store<fmt::printf_context>& store)
+{
+  for (unsigned i = 0; i != nof_args; ++i) {
+    uint8_t type;
+    if (!reader.read(type)) {
+      return false;
+    }
+
+    bool ok = true;
+    switch (static_cast<arg_type>(type)) {
+      case arg_type::i32:
+        ok = push_arg<int32_t>(reader, store);
+        break;
+      case arg_type::u32:
+        ok = push_arg<uint32_t>(reader, store);
+        break;
+      case arg_type::i64:
+        ok = push_arg<int64_t>(reader, store);
+        break;
+      case arg_type::u64:
+        ok = push_arg<uint64_t>(reader, store);
+        break;
+      case arg_type::dbl:
+        ok = push_arg<double>(reader, store);
+        break;
+      case arg_type::chr:
+        ok = push_arg<char>(reader, store);
+        break;
+      case arg_type::boolean: {
+        uint8_t value;
+        ok = reader.read(value);
+        if (ok) {
+          store.push_back(value != 0);
+        }
+        break;
+      }
+      case arg_type::ptr: {
+        uint64_t value;
+        ok = reader.read(value);
+        if (ok) {
+          store.push_back(reinterpret_cast<const void*>(value));
+        }
+        break;
+      }
+      case arg_type::str: {
+        uint32_t       len;
+        const uint8_t* data = nullptr;
+        ok                  = reader.read(len) && (data = reader.read_bytes(len));
+        if (ok) {
+          store.push_back(std::string(reinterpret_cast<const char*>(data), len));
+        }
+        break;
+      }
+      default:
+        return false;
+    }
+    if (!ok) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/// Decoder state for a binary log file.
+class decoder
+{
+  std::FILE*                                output;
+  text_formatter                            formatter;
+  fmt::memory_buffer                        buffer;
+  std::unordered_map<uint64_t, std::string> strings;
+
+public:
+  explicit decoder(std::FILE* output) : output(output) {}
+
+  /// Decodes a record, returns false when it is malformed.
+  bool decode(const uint8_t* data, size_t size)
+  {
+    record_reader reader(data, size);
+    uint8_t       type;
+    if (!reader.read(type)) {
+      return false;
+    }
+
+    switch (static_cast<record_type>(type)) {
+      case record_type::string_def: {
+        uint64_t id;
+        if (!reader.read(id)) {
+          return false;
+        }
+        size_t len  = reader.remaining();
+        strings[id] = std::string(reinterpret_cast<const char*>(reader.read_bytes(len)), len);
+        return true;
+      }
+      case record_type::text: {
+        size_t len = reader.remaining();
+        std::fwrite(reader.read_bytes(len), 1, len, output);
+        return true;
+      }
+      case record_type::entry:
+        return decode_entry(reader);
+      default:
+        return false;
+    }
+  }
+
+private:
+  bool decode_entry(record_reader& reader)
+  {
+    entry_header header;
+    if (!reader.read(header)) {
+      return false;
+    }
+    const uint8_t* hex = reader.read_bytes(header.hex_len);
+    if (!hex) {
+      return false;
+    }
+
+    auto fmt_it  = strings.find(header.fmt_id);
+    auto name_it = strings.find(header.name_id);
+    if (fmt_it == strings.end() || name_it == strings.end()) {
+      return false;
+    }
+
+    fmt::dynamic_format_arg_store<fmt::printf_context> store;
+    if (!decode_args(reader, header.nof_args, store)) {
+      return false;
+    }
+
+    detail::log_entry_metadata metadata = {
+        std::chrono::high_resolution_clock::time_point(std::chrono::high_resolution_clock::duration(header.timestamp)),
+        {header.ctx_value, header.ctx_enabled != 0},
+        fmt_it->second.c_str(),
+        &store,
+        name_it->second,
+        header.tag,
+        std::vector<uint8_t>(hex, hex + header.hex_len)};
+
+    buffer.clear();
+    formatter.format(std::move(metadata), buffer);
+    std::fwrite(buffer.data(), 1, buffer.size(), output);
+
+    return true;
+  }
+};
+
+} // namespace
+
+detail::error_string srslog::decode_binary_log(const std::string& path, std::FILE* output)
+{
+  std::unique_ptr<std::FILE, int (*)(std::FILE*)> input(std::fopen(path.c_str(), "rb"), &std::fclose);
+  if (!input) {
+    return file_utils::format_error(fmt::format("Unable to open binary log file \"{}\"", path), errno);
+  }
+
+  char magic[file_magic_size];
+  if (std::fread(magic, 1, sizeof(magic), input.get()) != sizeof(magic) ||
+      std::memcmp(magic, file_magic, sizeof(magic)) != 0) {
+    return fmt::format("File \"{}\" is not a binary log file", path);
+  }
+
+  decoder              dec(output);
+  std::vector<uint8_t> record;
+  uint64_t             offset = sizeof(magic);
+  uint32_t             size;
+  while (std::fread(&size, sizeof(size), 1, input.get()) == 1) {
+    record.resize(size);
+    if (std::fread(record.data(), 1, size, input.get()) != size) {
+      return fmt::format("Truncated record at offset {} of \"{}\"", offset, path);
+    }
+    if (!dec.decode(record.data(), size)) {
+      return fmt::format("Malformed record at offset {} of \"{}\"", offset, path);
+    }
+    offset += sizeof(size) + size;
+  }
+
+  return {};
+}
@@ -0,0 +1,40 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#ifndef SRSLOG_BINARY_LOG_DECODER_H
+#define SRSLOG_BINARY_LOG_DECODER_H
+
+#include "srsran/srslog/detail/support/error_string.h"
+#include <cstdio>
+#include <string>
+
+namespace srslog {
+
+/// Converts the binary log file in the specified path, as written by the
+/// binary file sink, into text that is written to the output stream. Entries
+/// are rendered with the text formatter, so the output is identical to the one
+/// of a text file sink.
+detail::error_string decode_binary_log(const std::string& path, std::FILE* output);
+
+} // namespace srslog
+
+#endif // SRSLOG_BINARY_LOG_DECODER_H
@@ -42,15 +42,13 @@ public:
 
   bool push(detail::log_entry&& entry) override
   {
-    auto* arg_store = entry.metadata.store;
-    if (!queue.push(std::move(entry))) {
-      arg_pool.dealloc(arg_store);
-      return false;
-    }
-    return true;
+    return queue.push(std::move(entry), [this]() { return worker.is_running(); });
   }
 
-  fmt::dynamic_format_arg_store<fmt::printf_context>* alloc_arg_store() override { return arg_pool.alloc(); }
+  fmt::dynamic_format_arg_store<fmt::printf_context>* alloc_arg_store() override
+  {
+    return queue.alloc_arg_store([this]() { return worker.is_running(); });
+  }
 
   bool is_running() const override { return worker.is_running(); }
 
@@ -60,10 +58,15 @@ public:
   /// Stops the backend worker thread.
   void stop() { worker.stop(); }
 
+  /// Sets the policy applied when the log queue of a thread is full.
+  void set_queue_policy(backend_queue_policy policy) { queue.set_policy(policy); }
+
+  /// Returns the metrics of the backend.
+  backend_metrics get_metrics() const { return queue.get_metrics(); }
+
 private:
-  detail::work_queue<detail::log_entry> queue;
-  detail::dyn_arg_store_pool            arg_pool;
-  backend_worker                        worker{queue, arg_pool};
+  log_queue      queue;
+  backend_worker worker{queue};
 };
 
 } // namespace srslog
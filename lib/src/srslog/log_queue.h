@@ -0,0 +1,267 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#ifndef SRSLOG_LOG_QUEUE_H
+#define SRSLOG_LOG_QUEUE_H
+
+#include "srsran/srslog/detail/log_entry.h"
+#include "srsran/srslog/detail/support/backend_capacity.h"
+#include "srsran/srslog/detail/support/spsc_queue.h"
+#include "srsran/srslog/shared_types.h"
+#include <algorithm>
+#include <array>
+#include <thread>
+
+namespace srslog {
+
+/// Queue of log entries between the logging threads and the backend worker.
+/// Each thread pushing entries gets its own lock-free queue and its own pool of
+/// argument stores, so logging threads never contend with each other. The
+/// backend worker pops the entries of all the queues merged by timestamp.
+/// NOTE: Thread safe class.
+class log_queue
+{
+  using arg_store = fmt::dynamic_format_arg_store<fmt::printf_context>;
+
+  /// Queue and argument stores of a logging thread.
+  struct producer {
+    explicit producer(size_t capacity) : entries(capacity), free_stores(capacity) {}
+
+    detail::spsc_queue<detail::log_entry> entries;
+    /// Stores given back by the backend worker.
+    detail::spsc_queue<arg_store*> free_stores;
+    /// Stores owned by this producer, accessed only by the producer thread.
+    std::vector<std::unique_ptr<arg_store> > stores;
+    /// Stores not pushed into the queue, accessed only by the producer thread.
+    std::vector<arg_store*> spare_stores;
+    std::thread::id         owner = std::this_thread::get_id();
+  };
+
+public:
+  explicit log_queue(size_t capacity = SRSLOG_QUEUE_CAPACITY) : capacity(capacity), queue_id(next_queue_id()) {}
+
+  log_queue(const log_queue&) = delete;
+  log_queue& operator=(const log_queue&) = delete;
+
+  /// Sets the policy applied when the queue of a thread is full.
+  void set_policy(backend_queue_policy p) { policy.store(p, std::memory_order_relaxed); }
+
+  /// Returns a free argument store of the calling thread. When all of them are
+  /// in use, either waits for the backend to free one or returns nullptr
+  /// depending on the queue policy. Producers only wait while
+  /// consumer_running() returns true.
+  template <typename F>
+  arg_store* alloc_arg_store(F&& consumer_running)
+  {
+    producer& p = get_producer();
+
+    if (!p.spare_stores.empty()) {
+      arg_store* store = p.spare_stores.back();
+      p.spare_stores.pop_back();
+      return store;
+    }
+    if (arg_store** store = p.free_stores.front()) {
+      arg_store* result = *store;
+      p.free_stores.pop();
+      return result;
+    }
+    if (p.stores.size() < p.entries.get_capacity()) {
+      p.stores.emplace_back(new arg_store);
+      // Reserve for 10 normal and 2 named arguments.
+      p.stores.back()->reserve(10, 2);
+      return p.stores.back().get();
+    }
+
+    // All the stores are queued, wait for the backend or drop the entry.
+    if (can_block(consumer_running)) {
+      increment(nof_blocked);
+      while (consumer_running()) {
+        std::this_thread::sleep_for(std::chrono::microseconds(10));
+        if (arg_store** store = p.free_stores.front()) {
+          arg_store* result = *store;
+          p.free_stores.pop();
+          return result;
+        }
+      }
+    }
+    increment(nof_dropped);
+    return nullptr;
+  }
+
+  /// Inserts a log entry into the queue of the calling thread. When the queue
+  /// is full, either waits for room or discards the entry depending on the
+  /// queue policy. Producers only wait while consumer_running() returns true.
+  /// Returns false when the entry is discarded, otherwise true.
+  template <typename F>
+  bool push(detail::log_entry&& entry, F&& consumer_running)
+  {
+    producer& p = get_producer();
+    if (p.entries.push(std::move(entry))) {
+      return true;
+    }
+
+    if (can_block(consumer_running)) {
+      increment(nof_blocked);
+      while (consumer_running()) {
+        std::this_thread::sleep_for(std::chrono::microseconds(10));
+        if (p.entries.push(std::move(entry))) {
+          return true;
+        }
+      }
+    }
+
+    // Flush commands are not discarded, the caller retries them.
+    if (!entry.flush_cmd) {
+      increment(nof_dropped);
+    }
+    if (entry.metadata.store) {
+      entry.metadata.store->clear();
+      p.spare_stores.push_back(entry.metadata.store);
+    }
+    return false;
+  }
+
+  /// Consumer side: calls f(detail::log_entry&& entry) for the entry with the
+  /// oldest timestamp among the front entries of all the queues. Returns false
+  /// when all the queues are empty, otherwise true.
+  /// NOTE: Entries of different threads are ordered on a best effort basis,
+  /// as a thread may get preempted between taking the timestamp of an entry and
+  /// pushing it.
+  template <typename F>
+  bool consume_one(F&& f)
+  {
+    if (nof_producers.load(std::memory_order_acquire) != consumer_view.size()) {
+      detail::scoped_lock lock(m);
+      consumer_view.clear();
+      for (const auto& p : producers) {
+        consumer_view.push_back(p.get());
+      }
+    }
+
+    producer*          oldest       = nullptr;
+    detail::log_entry* oldest_entry = nullptr;
+    for (producer* p : consumer_view) {
+      detail::log_entry* e = p->entries.front();
+      if (e && (!oldest_entry || e->metadata.tp < oldest_entry->metadata.tp)) {
+        oldest       = p;
+        oldest_entry = e;
+      }
+    }
+    if (!oldest) {
+      return false;
+    }
+
+    arg_store* store = oldest_entry->metadata.store;
+    f(std::move(*oldest_entry));
+
+    // Release the resources of the entry before giving the slot back.
+    *oldest_entry = {};
+    oldest->entries.pop();
+    if (store) {
+      store->clear();
+      oldest->free_stores.push(std::move(store));
+    }
+    nof_entries.store(nof_entries.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+    return true;
+  }
+
+  /// Returns the number of entries discarded so far.
+  uint64_t get_nof_dropped() const { return nof_dropped.load(std::memory_order_relaxed); }
+
+  /// Returns the capacity of the queue of each thread.
+  size_t get_capacity() const { return capacity; }
+
+  /// Returns the metrics of the queue.
+  backend_metrics get_metrics() const
+  {
+    backend_metrics metrics;
+    metrics.nof_entries         = nof_entries.load(std::memory_order_relaxed);
+    metrics.nof_dropped_entries = nof_dropped.load(std::memory_order_relaxed);
+    metrics.nof_blocked_entries = nof_blocked.load(std::memory_order_relaxed);
+    metrics.nof_producers       = nof_producers.load(std::memory_order_relaxed);
+    return metrics;
+  }
+
+private:
+  template <typename F>
+  bool can_block(F&& consumer_running) const
+  {
+    return policy.load(std::memory_order_relaxed) == backend_queue_policy::block && consumer_running();
+  }
+
+  static void increment(std::atomic<uint64_t>& counter) { counter.fetch_add(1, std::memory_order_relaxed); }
+
+  /// Returns the queue of the calling thread, creating it on its first call.
+  producer& get_producer()
+  {
+    struct cache_entry {
+      uint32_t  queue_id;
+      producer* p;
+    };
+    static thread_local std::array<cache_entry, 4> cache = {};
+
+    cache_entry& entry = cache[queue_id % cache.size()];
+    if (entry.queue_id == queue_id) {
+      return *entry.p;
+    }
+
+    // The entry may have been taken by another queue, look for the producer of
+    // this thread before creating a new one. Producers of finished threads are
+    // reused by new threads getting the same id.
+    detail::scoped_lock lock(m);
+    auto it = std::find_if(producers.begin(), producers.end(), [](const std::unique_ptr<producer>& p) {
+      return p->owner == std::this_thread::get_id();
+    });
+    if (it == producers.end()) {
+      producers.emplace_back(new producer(capacity));
+      it = producers.end() - 1;
+      nof_producers.store(producers.size(), std::memory_order_release);
+    }
+    entry = {queue_id, it->get()};
+
+    return *entry.p;
+  }
+
+  static uint32_t next_queue_id()
+  {
+    static std::atomic<uint32_t> counter{0};
+    return ++counter;
+  }
+
+private:
+  const size_t                            capacity;
+  const uint32_t                          queue_id;
+  std::atomic<backend_queue_policy>       policy{backend_queue_policy::drop};
+  detail::mutex                           m;
+  std::vector<std::unique_ptr<producer> > producers;
+  std::atomic<unsigned>                   nof_producers{0};
+  std::atomic<uint64_t>                   nof_entries{0};
+  std::atomic<uint64_t>                   nof_dropped{0};
+  std::atomic<uint64_t>                   nof_blocked{0};
+  /// Snapshot of the producers used by the consumer thread.
+  std::vector<producer*>                  consumer_view;
+};
+
+} // namespace srslog
+
+#endif // SRSLOG_LOG_QUEUE_H
@@ -0,0 +1,519 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include "async_file_writer.h"
+#include "file_utils.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <mutex>
+#include <thread>
+#include <unistd.h>
+
+#ifdef HAVE_IO_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#endif
+
+using namespace srslog;
+
+constexpr size_t async_file_writer::alignment;
+
+namespace {
+
+/// Engine that performs the writes in a dedicated thread with pwrite.
+class thread_engine : public detail::io_engine
+{
+  struct request {
+    int            fd        = -1;
+    const uint8_t* data      = nullptr;
+    size_t         len       = 0;
+    uint64_t       offset    = 0;
+    bool           submitted = false;
+    bool           done      = false;
+    int64_t        result    = 0;
+  };
+
+  std::mutex              mutex;
+  std::condition_variable cvar;
+  std::array<request, 2>  requests;
+  bool                    running = true;
+  std::thread             worker;
+
+public:
+  thread_engine() : worker([this]() { run(); }) {}
+
+  ~thread_engine() override
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      running = false;
+    }
+    cvar.notify_all();
+    worker.join();
+  }
+
+  void submit(unsigned slot, int fd, const uint8_t* data, size_t len, uint64_t offset) override
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      requests[slot] = {fd, data, len, offset, true, false, 0};
+    }
+    cvar.notify_all();
+  }
+
+  int64_t wait(unsigned slot) override
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    cvar.wait(lock, [this, slot]() { return requests[slot].done; });
+    requests[slot].submitted = false;
+    return requests[slot].result;
+  }
+
+private:
+  void run()
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+      request* req = nullptr;
+      cvar.wait(lock, [this, &req]() {
+        for (auto& r : requests) {
+          if (r.submitted && !r.done && (!req || r.offset < req->offset)) {
+            req = &r;
+          }
+        }
+        return req || !running;
+      });
+      if (!req) {
+        return;
+      }
+
+      request r = *req;
+      lock.unlock();
+      int64_t result = 0;
+      while (size_t(result) < r.len) {
+        ssize_t n = ::pwrite(r.fd, r.data + result, r.len - result, r.offset + result);
+        if (n < 0 && errno == EINTR) {
+          continue;
+        }
+        if (n <= 0) {
+          // Report the bytes written so far, the caller retries the rest.
+          result = (result == 0) ? ((n < 0) ? -errno : -EIO) : result;
+          break;
+        }
+        result += n;
+      }
+      lock.lock();
+
+      req->result = result;
+      req->done   = true;
+      cvar.notify_all();
+    }
+  }
+};
+
+#ifdef HAVE_IO_URING
+
+/// Engine that submits the writes to an io_uring instance. Uses the raw system
+/// calls, so it does not depend on liburing.
+class uring_engine : public detail::io_engine
+{
+  struct slot_state {
+    struct iovec iov     = {};
+    bool         pending = false;
+    int64_t      result  = 0;
+  };
+
+  int                       ring_fd   = -1;
+  void*                     sq_ptr    = MAP_FAILED;
+  void*                     cq_ptr    = MAP_FAILED;
+  size_t                    sq_size   = 0;
+  size_t                    cq_size   = 0;
+  struct io_uring_sqe*      sqes      = static_cast<struct io_uring_sqe*>(MAP_FAILED);
+  size_t                    sqes_size = 0;
+  unsigned*                 sq_tail   = nullptr;
+  unsigned*                 sq_mask   = nullptr;
+  unsigned*                 sq_array  = nullptr;
+  unsigned*                 cq_head   = nullptr;
+  unsigned*                 cq_tail   = nullptr;
+  unsigned*                 cq_mask   = nullptr;
+  struct io_uring_cqe*      cqes      = nullptr;
+  std::array<slot_state, 2> slots;
+
+public:
+  ~uring_engine() override
+  {
+    if (sqes != MAP_FAILED) {
+      ::munmap(sqes, sqes_size);
+    }
+    if (cq_ptr != MAP_FAILED && cq_ptr != sq_ptr) {
+      ::munmap(cq_ptr, cq_size);
+    }
+    if (sq_ptr != MAP_FAILED) {
+      ::munmap(sq_ptr, sq_size);
+    }
+    if (ring_fd >= 0) {
+      ::close(ring_fd);
+    }
+  }
+
+  /// Sets up the rings, returns false when io_uring is not usable.
+  bool init()
+  {
+    struct io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    ring_fd = ::syscall(__NR_io_uring_setup, unsigned(slots.size()), &params);
+    if (ring_fd < 0) {
+      return false;
+    }
+
+    sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+      sq_size = cq_size = std::max(sq_size, cq_size);
+    }
+
+    sq_ptr = ::mmap(nullptr, sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQ_RING);
+    if (sq_ptr == MAP_FAILED) {
+      return false;
+    }
+    cq_ptr = (params.features & IORING_FEAT_SINGLE_MMAP)
+                 ? sq_ptr
+                 : ::mmap(nullptr, cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_CQ_RING);
+    if (cq_ptr == MAP_FAILED) {
+      return false;
+    }
+    sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    sqes      = static_cast<struct io_uring_sqe*>(
+        ::mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQES));
+    if (sqes == MAP_FAILED) {
+      return false;
+    }
+
+    uint8_t* sq = static_cast<uint8_t*>(sq_ptr);
+    sq_tail     = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    sq_mask     = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    sq_array    = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+    uint8_t* cq = static_cast<uint8_t*>(cq_ptr);
+    cq_head     = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    cq_tail     = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    cq_mask     = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    cqes        = reinterpret_cast<struct io_uring_cqe*>(cq + params.cq_off.cqes);
+
+    return true;
+  }
+
+  void submit(unsigned slot, int fd, const uint8_t* data, size_t len, uint64_t offset) override
+  {
+    slot_state& s  = slots[slot];
+    s.iov.iov_base = const_cast<uint8_t*>(data);
+    s.iov.iov_len  = len;
+    s.pending      = true;
+
+    // At most one write per slot is in flight, so the submission queue always
+    // has room.
+    unsigned             tail = *sq_tail;
+    unsigned             idx  = tail & *sq_mask;
+    struct io_uring_sqe* sqe  = &sqes[idx];
+    std::memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode    = IORING_OP_WRITEV;
+    sqe->fd        = fd;
+    sqe->addr      = reinterpret_cast<uint64_t>(&s.iov);
+    sqe->len       = 1;
+    sqe->off       = offset;
+    sqe->user_data = slot;
+    sq_array[idx]  = idx;
+    __atomic_store_n(sq_tail, tail + 1, __ATOMIC_RELEASE);
+
+    int ret;
+    do {
+      ret = ::syscall(__NR_io_uring_enter, ring_fd, 1, 0, 0, nullptr, 0);
+    } while (ret < 0 && errno == EINTR);
+    if (ret < 0) {
+      // The entry was not consumed, take it back.
+      __atomic_store_n(sq_tail, tail, __ATOMIC_RELEASE);
+      s.pending = false;
+      s.result  = -errno;
+    }
+  }
+
+  int64_t wait(unsigned slot) override
+  {
+    while (slots[slot].pending) {
+      reap_completions();
+      if (!slots[slot].pending) {
+        break;
+      }
+      int ret = ::syscall(__NR_io_uring_enter, ring_fd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+      if (ret < 0 && errno != EINTR) {
+        slots[slot].pending = false;
+        slots[slot].result  = -errno;
+      }
+    }
+    return slots[slot].result;
+  }
+
+private:
+  void reap_completions()
+  {
+    unsigned head = *cq_head;
+    unsigned tail = __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE);
+    for (; head != tail; ++head) {
+      const struct io_uring_cqe& cqe = cqes[head & *cq_mask];
+      slot_state&                s   = slots[cqe.user_data];
+      s.result                       = cqe.res;
+      s.pending                      = false;
+    }
+    __atomic_store_n(cq_head, head, __ATOMIC_RELEASE);
+  }
+};
+
+#endif
+
+} // namespace
+
+async_file_writer::async_file_writer(size_t buffer_size, bool use_io_uring) :
+  buffer_size((std::max<size_t>(buffer_size, 1) + alignment - 1) / alignment * alignment), use_io_uring(use_io_uring)
+{}
+
+async_file_writer::~async_file_writer()
+{
+  close();
+  for (auto& slot : slots) {
+    std::free(slot.buffer);
+  }
+}
+
+async_file_writer::metrics async_file_writer::get_metrics() const
+{
+  return {bytes_written.load(std::memory_order_relaxed),
+          nof_writes.load(std::memory_order_relaxed),
+          nof_stalls.load(std::memory_order_relaxed),
+          stall_time_ns.load(std::memory_order_relaxed)};
+}
+
+detail::error_string async_file_writer::create(const std::string& new_path)
+{
+  close();
+
+  // Allocate the resources on first use, so that unused writers are cheap.
+  if (!engine) {
+#ifdef HAVE_IO_URING
+    if (use_io_uring) {
+      std::unique_ptr<uring_engine> uring(new uring_engine);
+      if (uring->init()) {
+        engine = std::move(uring);
+        type   = engine_type::io_uring;
+      }
+    }
+#endif
+    if (!engine) {
+      engine.reset(new thread_engine);
+      type = engine_type::thread;
+    }
+  }
+  for (auto& slot : slots) {
+    if (!slot.buffer) {
+      void* buffer = nullptr;
+      if (::posix_memalign(&buffer, alignment, buffer_size) != 0) {
+        return fmt::format("Unable to allocate the buffers of file \"{}\"", new_path);
+      }
+      slot.buffer = static_cast<uint8_t*>(buffer);
+    }
+  }
+
+  // Not all file systems support O_DIRECT, fall back to buffered I/O.
+  const int flags = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+  fd              = ::open(new_path.c_str(), flags | O_DIRECT, 0644);
+  direct          = fd >= 0;
+  if (fd < 0 && errno == EINVAL) {
+    fd = ::open(new_path.c_str(), flags, 0644);
+  }
+  if (fd < 0) {
+    return file_utils::format_error(fmt::format("Unable to create log file \"{}\"", new_path), errno);
+  }
+
+  path        = new_path;
+  active      = 0;
+  fill        = 0;
+  file_offset = 0;
+  size        = 0;
+
+  return {};
+}
+
+detail::error_string async_file_writer::write(const void* data, size_t len)
+{
+  const uint8_t* input = static_cast<const uint8_t*>(data);
+  while (fd >= 0 && len != 0) {
+    size_t n = std::min(len, buffer_size - fill);
+    std::memcpy(slots[active].buffer + fill, input, n);
+    fill += n;
+    size += n;
+    input += n;
+    len -= n;
+
+    if (fill == buffer_size) {
+      if (auto err_str = submit_active()) {
+        return err_str;
+      }
+    }
+  }
+
+  return {};
+}
+
+detail::error_string async_file_writer::flush()
+{
+  if (fd < 0) {
+    return {};
+  }
+
+  for (unsigned i = 0; i != slots.size(); ++i) {
+    if (auto err_str = complete(i)) {
+      return err_str;
+    }
+  }
+  if (fill == 0) {
+    return {};
+  }
+
+  // Write the partial buffer, padded to the alignment for O_DIRECT. The data is
+  // kept in the active buffer, which is written again at the same offset when
+  // it gets full, and the padding is removed by truncating the file.
+  size_t len = fill;
+  if (direct) {
+    len = (fill + alignment - 1) / alignment * alignment;
+    std::memset(slots[active].buffer + fill, 0, len - fill);
+  }
+  submit(active, len, file_offset);
+  if (auto err_str = complete(active)) {
+    return err_str;
+  }
+  if (len != fill && ::ftruncate(fd, file_offset + fill) != 0) {
+    return fail("Error encountered while flushing log file", errno);
+  }
+
+  return {};
+}
+
+detail::error_string async_file_writer::close()
+{
+  if (fd < 0) {
+    return {};
+  }
+
+  auto err_str = flush();
+  if (fd >= 0) {
+    ::close(fd);
+    fd = -1;
+    path.clear();
+  }
+
+  return err_str;
+}
+
+detail::error_string async_file_writer::submit_active()
+{
+  submit(active, buffer_size, file_offset);
+  file_offset += buffer_size;
+  active ^= 1;
+  fill = 0;
+
+  // The buffer to be filled next may still be in flight.
+  if (!slots[active].in_flight) {
+    return {};
+  }
+  auto start   = std::chrono::steady_clock::now();
+  auto err_str = complete(active);
+  nof_stalls.fetch_add(1, std::memory_order_relaxed);
+  stall_time_ns.fetch_add(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count(),
+      std::memory_order_relaxed);
+
+  return err_str;
+}
+
+void async_file_writer::submit(unsigned slot, size_t len, uint64_t offset)
+{
+  slot_state& s = slots[slot];
+  s.len         = len;
+  s.offset      = offset;
+  s.in_flight   = true;
+  engine->submit(slot, fd, s.buffer, len, offset);
+  bytes_written.fetch_add(len, std::memory_order_relaxed);
+  nof_writes.fetch_add(1, std::memory_order_relaxed);
+}
+
+detail::error_string async_file_writer::complete(unsigned slot)
+{
+  slot_state& s    = slots[slot];
+  size_t      done = 0;
+  while (s.in_flight) {
+    int64_t result = engine->wait(slot);
+    s.in_flight    = false;
+
+    // Some file systems accept O_DIRECT when opening the file but reject the
+    // writes, retry them through the page cache.
+    if (result == -EINVAL && direct) {
+      direct = false;
+      if (::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) & ~O_DIRECT) != 0) {
+        return fail("Unable to write log file", errno);
+      }
+      result = 0;
+    }
+    if (result < 0) {
+      return fail("Unable to write log file", int(-result));
+    }
+
+    // Retry the part of a short write that was not written.
+    done += size_t(result);
+    if (done < s.len) {
+      s.in_flight = true;
+      engine->submit(slot, fd, s.buffer + done, s.len - done, s.offset + done);
+    }
+  }
+
+  return {};
+}
+
+detail::error_string async_file_writer::fail(const std::string& action, int error_code)
+{
+  auto err_str = file_utils::format_error(fmt::format("{} \"{}\"", action, path), error_code);
+
+  // The pending writes reference the buffers, wait for them before closing.
+  for (unsigned i = 0; i != slots.size(); ++i) {
+    if (slots[i].in_flight) {
+      engine->wait(i);
+      slots[i].in_flight = false;
+    }
+  }
+  ::close(fd);
+  fd = -1;
+  path.clear();
+
+  return err_str;
+}
@@ -0,0 +1,166 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#ifndef SRSLOG_ASYNC_FILE_WRITER_H
+#define SRSLOG_ASYNC_FILE_WRITER_H
+
+#include "srsran/srslog/detail/support/error_string.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace srslog {
+
+namespace detail {
+
+/// Interface of the engines that perform the writes of the async file writer.
+class io_engine
+{
+public:
+  virtual ~io_engine() = default;
+
+  /// Starts writing len bytes of data at the specified offset of the file. The
+  /// write is identified by the slot index.
+  virtual void submit(unsigned slot, int fd, const uint8_t* data, size_t len, uint64_t offset) = 0;
+
+  /// Waits for the write of the specified slot to complete. Returns the number
+  /// of written bytes or a negative errno value.
+  virtual int64_t wait(unsigned slot) = 0;
+};
+
+} // namespace detail
+
+/// This class writes a file without blocking the caller on the disk. Data is
+/// copied into one of two buffers, and each full buffer is handed to an I/O
+/// engine while the caller fills the other one. Writes are submitted to an
+/// io_uring instance, or to a dedicated thread when io_uring is not available.
+/// Files are opened with O_DIRECT when the file system supports it, so the
+/// data does not go through the page cache.
+/// Like file_utils::file, the writer disables itself when it encounters an
+/// error.
+/// NOTE: This class is not thread safe, except for get_metrics().
+class async_file_writer
+{
+public:
+  enum class engine_type { io_uring, thread };
+
+  /// Counters of the writer, accumulated across files.
+  struct metrics {
+    /// Number of bytes handed to the I/O engine.
+    uint64_t bytes_written;
+    /// Number of writes handed to the I/O engine.
+    uint64_t nof_writes;
+    /// Number of times the caller waited for a write to complete before
+    /// reusing its buffer.
+    uint64_t nof_stalls;
+    /// Accumulated time spent in these waits.
+    uint64_t stall_time_ns;
+  };
+
+  /// Buffers are rounded up to a multiple of the O_DIRECT alignment. Setting
+  /// use_io_uring to false forces the thread based engine.
+  explicit async_file_writer(size_t buffer_size = 1024 * 1024, bool use_io_uring = true);
+
+  async_file_writer(const async_file_writer& other) = delete;
+  async_file_writer& operator=(const async_file_writer& other) = delete;
+
+  ~async_file_writer();
+
+  explicit operator bool() const { return fd >= 0; }
+
+  /// Returns the path of the file.
+  const std::string& get_path() const { return path; }
+
+  /// Returns the number of bytes written into the current file.
+  uint64_t get_size() const { return size; }
+
+  /// Returns the engine performing the writes, valid after the first call to
+  /// create().
+  engine_type get_engine_type() const { return type; }
+
+  /// Returns true when the current file bypasses the page cache.
+  bool is_direct() const { return direct; }
+
+  /// Returns the counters of the writer.
+  metrics get_metrics() const;
+
+  /// Creates a new file in the specified path by previously closing any opened
+  /// file.
+  detail::error_string create(const std::string& new_path);
+
+  /// Appends the provided data to an open file, otherwise does nothing. Only
+  /// blocks when both buffers are waiting to be written.
+  detail::error_string write(const void* data, size_t len);
+
+  /// Writes the buffered data into an open file and waits for the pending
+  /// writes to complete, otherwise does nothing.
+  detail::error_string flush();
+
+  /// Flushes and closes an open file, otherwise does nothing.
+  detail::error_string close();
+
+  /// Alignment of the buffers, offsets and lengths of the O_DIRECT writes.
+  static constexpr size_t alignment = 4096;
+
+private:
+  /// Hands the active buffer to the engine and switches to the other one.
+  detail::error_string submit_active();
+
+  /// Submits the first len bytes of the buffer of the slot.
+  void submit(unsigned slot, size_t len, uint64_t offset);
+
+  /// Waits for the write of a slot, resubmitting it until it completes.
+  detail::error_string complete(unsigned slot);
+
+  /// Closes the file after an error, returning the error description.
+  detail::error_string fail(const std::string& action, int error_code);
+
+  struct slot_state {
+    uint8_t* buffer    = nullptr;
+    size_t   len       = 0;
+    uint64_t offset    = 0;
+    bool     in_flight = false;
+  };
+
+  const size_t                       buffer_size;
+  const bool                         use_io_uring;
+  engine_type                        type = engine_type::thread;
+  std::unique_ptr<detail::io_engine> engine;
+  std::array<slot_state, 2>          slots;
+  unsigned                           active      = 0;
+  size_t                             fill        = 0;
+  uint64_t                           file_offset = 0;
+  uint64_t                           size        = 0;
+  std::string                        path;
+  int                                fd            = -1;
+  bool                               direct        = false;
+  std::atomic<uint64_t>              bytes_written = {0};
+  std::atomic<uint64_t>              nof_writes    = {0};
+  std::atomic<uint64_t>              nof_stalls    = {0};
+  std::atomic<uint64_t>              stall_time_ns = {0};
+};
+
+} // namespace srslog
+
+#endif // SRSLOG_ASYNC_FILE_WRITER_H
@@ -0,0 +1,212 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#ifndef SRSLOG_BINARY_FILE_SINK_H
+#define SRSLOG_BINARY_FILE_SINK_H
+
+#include "file_utils.h"
+#include "srsran/srslog/detail/binary_log_writer.h"
+#include "srsran/srslog/sink.h"
+#include <thread>
+#include <unordered_map>
+
+namespace srslog {
+
+/// This sink stores the log entries unformatted into binary log files, which
+/// are rendered as text offline by the srslog_decoder tool. The log channels
+/// encode their entries into per thread lock-free rings that a dedicated thread
+/// of the sink writes into the file, so no formatting nor locking takes place
+/// while logging.
+/// Entries that the channels cannot encode, e.g. contexts, are formatted by the
+/// backend and stored as text.
+/// Includes the optional feature of file rotation: a new file is created when
+/// file size exceeds an established threshold.
+class binary_file_sink : public sink
+{
+public:
+  binary_file_sink(std::string name, size_t max_size, size_t ring_size, std::unique_ptr<log_formatter> f) :
+    sink(std::move(f)),
+    max_size((max_size == 0) ? 0 : std::max<size_t>(max_size, 4 * 1024)),
+    base_filename(std::move(name)),
+    writer(ring_size)
+  {
+    writer_thread = std::thread([this]() { run_writer(); });
+  }
+
+  binary_file_sink(const binary_file_sink& other) = delete;
+  binary_file_sink& operator=(const binary_file_sink& other) = delete;
+
+  ~binary_file_sink() override
+  {
+    running = false;
+    writer_thread.join();
+    flush();
+  }
+
+  detail::binary_log_writer* get_binary_writer() override { return &writer; }
+
+  detail::error_string write(detail::memory_buffer buffer) override
+  {
+    writer.write_text(buffer.data(), buffer.size());
+    return {};
+  }
+
+  detail::error_string flush() override
+  {
+    detail::scoped_lock lock(m);
+    drain_rings();
+    if (error) {
+      detail::error_string err_str = std::move(error);
+      error                        = {};
+      return err_str;
+    }
+    return handler.flush();
+  }
+
+  /// Returns the number of log entries discarded because their ring was full.
+  uint64_t get_nof_dropped() const { return writer.get_nof_dropped(); }
+
+private:
+  void run_writer()
+  {
+    while (running) {
+      size_t count;
+      {
+        detail::scoped_lock lock(m);
+        count = drain_rings();
+      }
+      // Poll the rings periodically while they are idle.
+      if (count == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+    }
+  }
+
+  /// Writes the records of all the rings into the file. Returns the number of
+  /// records written.
+  /// NOTE: Called in locked context.
+  size_t drain_rings()
+  {
+    size_t count = 0;
+    buffer.clear();
+    writer.for_each_ring([this, &count](detail::byte_ring& ring) {
+      count += ring.consume([this](const uint8_t* data, uint32_t size) { append_record(data, size); });
+    });
+
+    // Report the discarded entries in the log itself.
+    uint64_t nof_dropped = writer.get_nof_dropped();
+    if (nof_dropped != last_nof_dropped) {
+      std::string text = fmt::format("srsLog: {} log entries dropped\n", nof_dropped - last_nof_dropped);
+      uint8_t     type = static_cast<uint8_t>(detail::binary_log::record_type::text);
+      std::string record(1, type);
+      record.append(text);
+      append_record(reinterpret_cast<const uint8_t*>(record.data()), record.size());
+      last_nof_dropped = nof_dropped;
+    }
+
+    if (buffer.size() != 0) {
+      write_buffer();
+    }
+
+    return count;
+  }
+
+  /// Appends a record to the buffer, keeping a copy of the string definitions.
+  void append_record(const uint8_t* data, uint32_t size)
+  {
+    const char* begin = reinterpret_cast<const char*>(data);
+    if (data[0] == static_cast<uint8_t>(detail::binary_log::record_type::string_def)) {
+      uint64_t id;
+      std::memcpy(&id, data + 1, sizeof(id));
+      std::string& def = definitions[id];
+      if (def.size() == size && std::equal(def.begin(), def.end(), begin)) {
+        // Already known, another thread referenced it first.
+        return;
+      }
+      def.assign(begin, size);
+    }
+    buffer.append(reinterpret_cast<const char*>(&size), reinterpret_cast<const char*>(&size) + sizeof(size));
+    buffer.append(begin, begin + size);
+  }
+
+  /// Writes the buffer into the current file, handling file creation and
+  /// rotation.
+  void write_buffer()
+  {
+    if (file_index == 0 || (max_size && current_size >= max_size)) {
+      if (auto err_str = create_file()) {
+        error = std::move(err_str);
+        return;
+      }
+    }
+
+    // Do not bother doing any work when the file was closed on a previous
+    // error.
+    if (!handler) {
+      return;
+    }
+
+    if (auto err_str = handler.write({buffer.data(), buffer.size()})) {
+      error = std::move(err_str);
+    }
+    current_size += buffer.size();
+  }
+
+  /// Creates a new file, starting with the definitions of all the strings
+  /// referenced so far so that each file can be decoded on its own.
+  detail::error_string create_file()
+  {
+    if (auto err_str = handler.create(file_utils::build_filename_with_index(base_filename, file_index++))) {
+      return err_str;
+    }
+
+    fmt::memory_buffer header;
+    header.append(detail::binary_log::file_magic, detail::binary_log::file_magic + detail::binary_log::file_magic_size);
+    for (const auto& def : definitions) {
+      uint32_t size = def.second.size();
+      header.append(reinterpret_cast<const char*>(&size), reinterpret_cast<const char*>(&size) + sizeof(size));
+      header.append(def.second.data(), def.second.data() + def.second.size());
+    }
+    current_size = header.size();
+
+    return handler.write({header.data(), header.size()});
+  }
+
+private:
+  const size_t                               max_size;
+  const std::string                          base_filename;
+  detail::binary_log_writer                  writer;
+  detail::mutex                              m;
+  file_utils::file                           handler;
+  fmt::memory_buffer                         buffer;
+  std::unordered_map<uint64_t, std::string> definitions;
+  detail::error_string                       error;
+  size_t                                     current_size     = 0;
+  uint32_t                                   file_index       = 0;
+  uint64_t                                   last_nof_dropped = 0;
+  std::atomic<bool>                          running{true};
+  std::thread                                writer_thread;
+};
+
+} // namespace srslog
+
+#endif // SRSLOG_BINARY_FILE_SINK_H
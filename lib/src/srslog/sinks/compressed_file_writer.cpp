@@ -0,0 +1,298 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include "compressed_file_writer.h"
+#include "srsran/srslog/bundled/fmt/format.h"
+#include <ctime>
+
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+using namespace srslog;
+
+#ifdef HAVE_ZSTD
+
+struct compressed_file_writer::codec {
+  ZSTD_CCtx* ctx = ZSTD_createCCtx();
+
+  ~codec() { ZSTD_freeCCtx(ctx); }
+};
+
+bool compressed_file_writer::is_supported()
+{
+  return true;
+}
+
+#else
+
+struct compressed_file_writer::codec {};
+
+bool compressed_file_writer::is_supported()
+{
+  return false;
+}
+
+#endif
+
+/// Returns the CPU time consumed by the calling thread in nanoseconds.
+static uint64_t thread_cpu_time_ns()
+{
+  struct timespec ts = {};
+  ::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return uint64_t(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+compressed_file_writer::compressed_file_writer(int level, size_t chunk_size, size_t nof_chunks) :
+  level(level), cctx(new codec), chunks(std::max<size_t>(nof_chunks, 2))
+{
+  for (size_t i = 0; i != chunks.size(); ++i) {
+    chunks[i].reserve(chunk_size);
+    if (i != active) {
+      free_chunks.push_back(i);
+    }
+  }
+#ifdef HAVE_ZSTD
+  output.resize(ZSTD_CStreamOutSize());
+#endif
+
+  worker = std::thread([this]() { run_thread(); });
+}
+
+compressed_file_writer::~compressed_file_writer()
+{
+  close();
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    running = false;
+  }
+  cvar.notify_all();
+  worker.join();
+}
+
+compressed_file_writer::metrics compressed_file_writer::get_metrics() const
+{
+  return {bytes_in.load(std::memory_order_relaxed),
+          bytes_out.load(std::memory_order_relaxed),
+          cpu_time_ns.load(std::memory_order_relaxed),
+          nof_stalls.load(std::memory_order_relaxed)};
+}
+
+detail::error_string compressed_file_writer::create(const std::string& new_path)
+{
+  close();
+
+  if (!is_supported()) {
+    return fmt::format("Unable to create compressed file \"{}\": zstd support is not available", new_path);
+  }
+
+  // The compression thread is idle once the previous file is closed.
+  if (auto err_str = writer.create(new_path)) {
+    return err_str;
+  }
+#ifdef HAVE_ZSTD
+  ZSTD_CCtx_reset(cctx->ctx, ZSTD_reset_session_only);
+  ZSTD_CCtx_setParameter(cctx->ctx, ZSTD_c_compressionLevel, level);
+  ZSTD_CCtx_setParameter(cctx->ctx, ZSTD_c_checksumFlag, 1);
+#endif
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    error = {};
+  }
+  size    = 0;
+  is_open = true;
+
+  return {};
+}
+
+detail::error_string compressed_file_writer::write(const void* data, size_t len)
+{
+  const uint8_t* input = static_cast<const uint8_t*>(data);
+  while (is_open && len != 0) {
+    std::vector<uint8_t>& chunk = chunks[active];
+    size_t                n     = std::min(len, chunk.capacity() - chunk.size());
+    chunk.insert(chunk.end(), input, input + n);
+    size += n;
+    input += n;
+    len -= n;
+
+    if (chunk.size() == chunk.capacity()) {
+      if (auto err_str = submit_chunk()) {
+        return err_str;
+      }
+    }
+  }
+
+  return {};
+}
+
+detail::error_string compressed_file_writer::flush()
+{
+  if (!is_open) {
+    return {};
+  }
+  return run_command(command_type::flush);
+}
+
+detail::error_string compressed_file_writer::close()
+{
+  if (!is_open) {
+    return {};
+  }
+  auto err_str = run_command(command_type::close);
+  is_open      = false;
+  return err_str;
+}
+
+detail::error_string compressed_file_writer::submit_chunk()
+{
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    commands.push_back({command_type::data, active});
+    ++nof_submitted;
+    cvar.notify_all();
+
+    if (free_chunks.empty()) {
+      nof_stalls.fetch_add(1, std::memory_order_relaxed);
+      cvar.wait(lock, [this]() { return !free_chunks.empty(); });
+    }
+    active = free_chunks.back();
+    free_chunks.pop_back();
+  }
+  chunks[active].clear();
+
+  return take_error();
+}
+
+detail::error_string compressed_file_writer::run_command(command_type type)
+{
+  if (!chunks[active].empty()) {
+    if (auto err_str = submit_chunk()) {
+      return err_str;
+    }
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    commands.push_back({type, 0});
+    uint64_t id = ++nof_submitted;
+    cvar.notify_all();
+    cvar.wait(lock, [this, id]() { return nof_completed >= id; });
+  }
+
+  return take_error();
+}
+
+detail::error_string compressed_file_writer::take_error()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  if (!error) {
+    return {};
+  }
+  // The compression thread has closed the file.
+  is_open      = false;
+  auto err_str = std::move(error);
+  error        = {};
+  return err_str;
+}
+
+void compressed_file_writer::run_thread()
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  while (true) {
+    cvar.wait(lock, [this]() { return !commands.empty() || !running; });
+    if (commands.empty()) {
+      return;
+    }
+    command cmd = commands.front();
+    commands.pop_front();
+    lock.unlock();
+
+    uint64_t start = thread_cpu_time_ns();
+#ifdef HAVE_ZSTD
+    switch (cmd.type) {
+      case command_type::data:
+        compress(chunks[cmd.chunk].data(), chunks[cmd.chunk].size(), ZSTD_e_continue);
+        break;
+      case command_type::flush:
+        compress(nullptr, 0, ZSTD_e_flush);
+        if (auto err_str = writer.flush()) {
+          std::lock_guard<std::mutex> err_lock(mutex);
+          error = std::move(err_str);
+        }
+        break;
+      case command_type::close:
+        compress(nullptr, 0, ZSTD_e_end);
+        if (auto err_str = writer.close()) {
+          std::lock_guard<std::mutex> err_lock(mutex);
+          error = std::move(err_str);
+        }
+        break;
+    }
+#endif
+    cpu_time_ns.fetch_add(thread_cpu_time_ns() - start, std::memory_order_relaxed);
+
+    lock.lock();
+    if (cmd.type == command_type::data) {
+      free_chunks.push_back(cmd.chunk);
+    }
+    ++nof_completed;
+    cvar.notify_all();
+  }
+}
+
+void compressed_file_writer::compress(const uint8_t* data, size_t len, int directive)
+{
+#ifdef HAVE_ZSTD
+  // Skip the data of a file that failed.
+  if (!writer) {
+    return;
+  }
+
+  ZSTD_inBuffer in = {data, len, 0};
+  while (true) {
+    ZSTD_outBuffer out       = {output.data(), output.size(), 0};
+    size_t         remaining = ZSTD_compressStream2(cctx->ctx, &out, &in, ZSTD_EndDirective(directive));
+    if (ZSTD_isError(remaining)) {
+      std::lock_guard<std::mutex> lock(mutex);
+      error = fmt::format("Unable to compress file \"{}\": {}", writer.get_path(), ZSTD_getErrorName(remaining));
+      writer.close();
+      return;
+    }
+    if (out.pos != 0) {
+      bytes_out.fetch_add(out.pos, std::memory_order_relaxed);
+      if (auto err_str = writer.write(output.data(), out.pos)) {
+        std::lock_guard<std::mutex> lock(mutex);
+        error = std::move(err_str);
+        return;
+      }
+    }
+    // Data is consumed once the input is empty, flush and end are completed
+    // when zstd has no more output.
+    if ((directive == ZSTD_e_continue) ? (in.pos == in.size) : (remaining == 0)) {
+      break;
+    }
+  }
+  bytes_in.fetch_add(len, std::memory_order_relaxed);
+#endif
+}
@@ -0,0 +1,148 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#ifndef SRSLOG_COMPRESSED_FILE_WRITER_H
+#define SRSLOG_COMPRESSED_FILE_WRITER_H
+
+#include "async_file_writer.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace srslog {
+
+/// This class writes a zstd compressed file. Data is collected into chunks
+/// that a dedicated thread compresses and writes with an async file writer, so
+/// the caller neither compresses nor blocks on the disk. Each file is a single
+/// zstd frame that standard tools decompress, e.g. Wireshark opens compressed
+/// PCAP files directly.
+/// Like async_file_writer, the writer disables itself when it encounters an
+/// error.
+/// NOTE: This class is not thread safe, except for get_metrics().
+class compressed_file_writer
+{
+public:
+  /// Counters of the writer, accumulated across files.
+  struct metrics {
+    /// Number of bytes before compression.
+    uint64_t bytes_in;
+    /// Number of compressed bytes.
+    uint64_t bytes_out;
+    /// CPU time spent by the compression thread.
+    uint64_t cpu_time_ns;
+    /// Number of times the caller waited for a free chunk.
+    uint64_t nof_stalls;
+  };
+
+  /// Returns true when the library was built with zstd support.
+  static bool is_supported();
+
+  /// The caller fills chunks of chunk_size bytes, up to nof_chunks of them are
+  /// queued for compression before the caller blocks.
+  explicit compressed_file_writer(int level, size_t chunk_size = 256 * 1024, size_t nof_chunks = 8);
+
+  compressed_file_writer(const compressed_file_writer& other) = delete;
+  compressed_file_writer& operator=(const compressed_file_writer& other) = delete;
+
+  ~compressed_file_writer();
+
+  explicit operator bool() const { return is_open; }
+
+  /// Returns the number of bytes written into the current file, before
+  /// compression.
+  uint64_t get_size() const { return size; }
+
+  /// Returns the counters of the writer.
+  metrics get_metrics() const;
+
+  /// Creates a new file in the specified path by previously closing any opened
+  /// file.
+  detail::error_string create(const std::string& new_path);
+
+  /// Appends the provided data to an open file, otherwise does nothing.
+  detail::error_string write(const void* data, size_t len);
+
+  /// Compresses and writes the pending data of an open file, otherwise does
+  /// nothing. The file remains a valid zstd stream that can be decompressed up
+  /// to this point.
+  detail::error_string flush();
+
+  /// Ends the zstd frame and closes an open file, otherwise does nothing.
+  detail::error_string close();
+
+private:
+  enum class command_type { data, flush, close };
+
+  struct command {
+    command_type type;
+    size_t       chunk;
+  };
+
+  /// Queues the active chunk for compression.
+  detail::error_string submit_chunk();
+
+  /// Queues a command and waits for the compression thread to process it.
+  detail::error_string run_command(command_type type);
+
+  /// Returns the error reported by the compression thread, if any.
+  detail::error_string take_error();
+
+  void run_thread();
+
+  /// Compresses the input with the specified zstd directive and writes the
+  /// output into the file. Called from the compression thread.
+  void compress(const uint8_t* data, size_t len, int directive);
+
+  /// Context of the compression library.
+  struct codec;
+
+  const int                         level;
+  std::unique_ptr<codec>            cctx;
+  async_file_writer                 writer;
+  std::vector<std::vector<uint8_t>> chunks;
+  std::vector<uint8_t>              output;
+  size_t                            active  = 0;
+  uint64_t                          size    = 0;
+  bool                              is_open = false;
+
+  // State shared with the compression thread, protected by the mutex.
+  std::mutex              mutex;
+  std::condition_variable cvar;
+  std::deque<command>     commands;
+  std::vector<size_t>     free_chunks;
+  uint64_t                nof_completed = 0;
+  uint64_t                nof_submitted = 0;
+  detail::error_string    error;
+  bool                    running = true;
+  std::thread             worker;
+
+  std::atomic<uint64_t> bytes_in    = {0};
+  std::atomic<uint64_t> bytes_out   = {0};
+  std::atomic<uint64_t> cpu_time_ns = {0};
+  std::atomic<uint64_t> nof_stalls  = {0};
+};
+
+} // namespace srslog
+
+#endif // SRSLOG_COMPRESSED_FILE_WRITER_H
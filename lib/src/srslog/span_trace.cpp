@@ -0,0 +1,398 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/srslog/span_trace.h"
+#include "srsran/srslog/detail/support/thread_utils.h"
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace srslog;
+
+std::atomic<bool> srslog::detail::span_trace_enabled{false};
+
+namespace {
+
+struct span_record {
+  const char*       category;
+  const char*       name;
+  uint64_t          id;
+  uint64_t          start;
+  uint64_t          end;
+  detail::span_kind kind;
+};
+
+/// Ring of the spans of one thread, where the newest spans overwrite the
+/// oldest ones. The owner thread announces the position it is about to write
+/// in claimed and publishes it in committed, so that a reader copying the ring
+/// concurrently can discard the spans that were overwritten while copying.
+struct thread_spans {
+  thread_spans(size_t capacity, uint32_t tid, std::string thread_name) :
+    records(capacity), tid(tid), thread_name(std::move(thread_name))
+  {}
+
+  std::vector<span_record> records;
+  std::atomic<uint64_t>    claimed{0};
+  std::atomic<uint64_t>    committed{0};
+  const uint32_t           tid;
+  const std::string        thread_name;
+};
+
+/// A span copied out of a ring, tagged with its thread.
+struct exported_span {
+  span_record record;
+  uint32_t    tid;
+};
+
+class span_tracer
+{
+public:
+  bool init(const std::string& filename_, size_t nof_spans, uint32_t max_snapshots_)
+  {
+    detail::scoped_lock lock(m);
+    // Nothing to do if this is not the first time this function is called.
+    if (detail::span_trace_enabled.load(std::memory_order_relaxed) || nof_spans == 0) {
+      return false;
+    }
+
+    filename      = filename_;
+    ring_size     = round_up_pow2(nof_spans);
+    max_snapshots = max_snapshots_;
+    ref_ticks     = detail::span_clock_now();
+    ref_time      = std::chrono::steady_clock::now();
+
+    // The tracer is never destroyed, as threads may keep recording spans during the program exit.
+    std::thread(&span_tracer::run_snapshot_writer, this).detach();
+
+    detail::span_trace_enabled.store(true, std::memory_order_release);
+    return true;
+  }
+
+  void record(const span_record& r)
+  {
+    thread_local thread_spans* spans = nullptr;
+    if (spans == nullptr) {
+      spans = register_thread();
+    }
+
+    uint64_t pos = spans->committed.load(std::memory_order_relaxed);
+    spans->claimed.store(pos + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    spans->records[pos & (ring_size - 1)] = r;
+    spans->committed.store(pos + 1, std::memory_order_release);
+  }
+
+  bool flush(const std::string& file)
+  {
+    if (!detail::span_trace_enabled.load(std::memory_order_acquire)) {
+      return false;
+    }
+
+    std::vector<exported_span>                     spans;
+    std::vector<std::pair<uint32_t, std::string> > thread_names;
+    {
+      detail::scoped_lock lock(m);
+      for (const auto& t : threads) {
+        copy_spans(*t, spans);
+        thread_names.emplace_back(t->tid, t->thread_name);
+      }
+    }
+
+    return write_json(file, spans, thread_names);
+  }
+
+  bool flush() { return flush(filename); }
+
+  void request_snapshot()
+  {
+    if (detail::span_trace_enabled.load(std::memory_order_relaxed) &&
+        nof_snapshots.load(std::memory_order_relaxed) < max_snapshots) {
+      snapshot_requested.store(true, std::memory_order_relaxed);
+    }
+  }
+
+private:
+  static size_t round_up_pow2(size_t n)
+  {
+    size_t v = 1;
+    while (v < n) {
+      v <<= 1;
+    }
+    return v;
+  }
+
+  thread_spans* register_thread()
+  {
+    char name[16] = {};
+    ::pthread_getname_np(::pthread_self(), name, sizeof(name));
+
+    detail::scoped_lock lock(m);
+    threads.emplace_back(new thread_spans(ring_size, static_cast<uint32_t>(::syscall(SYS_gettid)), name));
+    return threads.back().get();
+  }
+
+  /// Appends the spans of the ring that are still valid to the output vector.
+  /// NOTE: Called in locked context.
+  void copy_spans(const thread_spans& t, std::vector<exported_span>& out) const
+  {
+    uint64_t end   = t.committed.load(std::memory_order_acquire);
+    uint64_t begin = (end > ring_size) ? end - ring_size : 0;
+    size_t   first = out.size();
+    for (uint64_t pos = begin; pos != end; ++pos) {
+      out.push_back({t.records[pos & (ring_size - 1)], t.tid});
+    }
+
+    // Drop the spans whose position was claimed again by the owner while copying them.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    uint64_t claimed     = t.claimed.load(std::memory_order_relaxed);
+    uint64_t valid_begin = (claimed > ring_size) ? claimed - ring_size : 0;
+    if (valid_begin > begin) {
+      size_t nof_overwritten = std::min<uint64_t>(valid_begin - begin, end - begin);
+      out.erase(out.begin() + first, out.begin() + first + nof_overwritten);
+    }
+  }
+
+  /// Writes the spans in the Chrome trace event JSON format.
+  bool write_json(const std::string&                                     file,
+                  std::vector<exported_span>&                            spans,
+                  const std::vector<std::pair<uint32_t, std::string> >& thread_names) const
+  {
+    std::FILE* f = std::fopen(file.c_str(), "w");
+    if (!f) {
+      return false;
+    }
+
+    // The ticks to microseconds ratio is measured from the initialization, the calibration needs a few milliseconds.
+    auto     min_calibration = std::chrono::milliseconds(10);
+    uint64_t now_ticks       = detail::span_clock_now();
+    auto     now_time        = std::chrono::steady_clock::now();
+    while (now_time - ref_time < min_calibration) {
+      std::this_thread::sleep_for(min_calibration - (now_time - ref_time));
+      now_ticks = detail::span_clock_now();
+      now_time  = std::chrono::steady_clock::now();
+    }
+    double us_per_tick = std::chrono::duration<double, std::micro>(now_time - ref_time).count() /
+                         static_cast<double>(now_ticks - ref_ticks);
+    auto to_us = [this, us_per_tick](uint64_t ticks) {
+      return (ticks > ref_ticks) ? static_cast<double>(ticks - ref_ticks) * us_per_tick : 0.0;
+    };
+
+    std::sort(spans.begin(), spans.end(), [](const exported_span& lhs, const exported_span& rhs) {
+      return lhs.record.start < rhs.record.start;
+    });
+
+    // Chain the flow spans with the same category and id. A flow step extends the last chain of its key or starts a
+    // new chain when the flow start was not recorded.
+    const uint32_t                                       no_chain = UINT32_MAX;
+    std::vector<uint32_t>                                chain_of(spans.size(), no_chain);
+    std::vector<uint32_t>                                chain_size;
+    std::vector<size_t>                                  chain_last;
+    std::map<std::pair<std::string, uint64_t>, uint32_t> last_chain;
+    for (size_t i = 0, e = spans.size(); i != e; ++i) {
+      const span_record& r = spans[i].record;
+      if (r.kind != detail::span_kind::flow_start && r.kind != detail::span_kind::flow_step) {
+        continue;
+      }
+      auto key = std::make_pair(std::string(r.category), r.id);
+      auto it  = last_chain.find(key);
+      if (r.kind == detail::span_kind::flow_start || it == last_chain.end()) {
+        uint32_t chain = static_cast<uint32_t>(chain_size.size());
+        chain_size.push_back(0);
+        chain_last.push_back(i);
+        last_chain[key] = chain;
+        it              = last_chain.find(key);
+      }
+      chain_of[i] = it->second;
+      chain_size[it->second]++;
+      chain_last[it->second] = i;
+    }
+
+    unsigned pid = static_cast<unsigned>(::getpid());
+    std::fprintf(f, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    bool first = true;
+    for (const auto& t : thread_names) {
+      std::fprintf(f,
+                   "%s{\"ph\":\"M\",\"pid\":%u,\"tid\":%u,\"name\":\"thread_name\",\"args\":{\"name\":\"%s\"}}",
+                   first ? "" : ",\n",
+                   pid,
+                   t.first,
+                   escape(t.second).c_str());
+      first = false;
+    }
+
+    std::vector<bool> chain_started(chain_size.size(), false);
+    for (size_t i = 0, e = spans.size(); i != e; ++i) {
+      const span_record& r  = spans[i].record;
+      double             ts = to_us(r.start);
+      if (r.kind == detail::span_kind::instant) {
+        std::fprintf(f,
+                     "%s{\"ph\":\"i\",\"s\":\"t\",\"pid\":%u,\"tid\":%u,\"cat\":\"%s\",\"name\":\"%s\",\"ts\":%.3f,"
+                     "\"args\":{\"id\":%" PRIu64 "}}",
+                     first ? "" : ",\n",
+                     pid,
+                     spans[i].tid,
+                     r.category,
+                     r.name,
+                     ts,
+                     r.id);
+        first = false;
+        continue;
+      }
+
+      std::fprintf(f,
+                   "%s{\"ph\":\"X\",\"pid\":%u,\"tid\":%u,\"cat\":\"%s\",\"name\":\"%s\",\"ts\":%.3f,\"dur\":%.3f,"
+                   "\"args\":{\"id\":%" PRIu64 "}}",
+                   first ? "" : ",\n",
+                   pid,
+                   spans[i].tid,
+                   r.category,
+                   r.name,
+                   ts,
+                   to_us(r.end) - ts,
+                   r.id);
+      first = false;
+
+      // Flow events bind to the span that encloses their timestamp in the same thread.
+      uint32_t chain = chain_of[i];
+      if (chain == no_chain || chain_size[chain] < 2) {
+        continue;
+      }
+      const char* phase = !chain_started[chain] ? "s" : (chain_last[chain] == i ? "f" : "t");
+      chain_started[chain] = true;
+      std::fprintf(f,
+                   ",\n{\"ph\":\"%s\",\"bp\":\"e\",\"pid\":%u,\"tid\":%u,\"cat\":\"%s\",\"name\":\"%s\",\"id\":%u,"
+                   "\"ts\":%.3f}",
+                   phase,
+                   pid,
+                   spans[i].tid,
+                   r.category,
+                   r.category,
+                   chain,
+                   ts);
+    }
+    std::fprintf(f, "\n]}\n");
+
+    return std::fclose(f) == 0;
+  }
+
+  /// Escapes the characters of the input string that are not valid inside a JSON string.
+  static std::string escape(const std::string& str)
+  {
+    std::string out;
+    for (char c : str) {
+      if (c == '"' || c == '\\') {
+        out.push_back('\\');
+        out.push_back(c);
+      } else if (static_cast<unsigned char>(c) >= 0x20) {
+        out.push_back(c);
+      }
+    }
+    return out;
+  }
+
+  /// Returns the name of the specified snapshot, e.g. "trace_0.json" for "trace.json".
+  std::string snapshot_filename(uint32_t n) const
+  {
+    std::string suffix = "_" + std::to_string(n);
+    size_t      dot    = filename.find_last_of('.');
+    if (dot == std::string::npos || filename.find('/', dot) != std::string::npos) {
+      return filename + suffix;
+    }
+    return filename.substr(0, dot) + suffix + filename.substr(dot);
+  }
+
+  void run_snapshot_writer()
+  {
+    while (true) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      if (!snapshot_requested.exchange(false, std::memory_order_relaxed)) {
+        continue;
+      }
+      uint32_t n = nof_snapshots.fetch_add(1, std::memory_order_relaxed);
+      if (n < max_snapshots) {
+        flush(snapshot_filename(n));
+      }
+    }
+  }
+
+private:
+  detail::mutex                               m;
+  std::string                                 filename;
+  size_t                                      ring_size     = 0;
+  uint32_t                                    max_snapshots = 0;
+  uint64_t                                    ref_ticks     = 0;
+  std::chrono::steady_clock::time_point       ref_time;
+  std::vector<std::unique_ptr<thread_spans> > threads;
+  std::atomic<bool>                           snapshot_requested{false};
+  std::atomic<uint32_t>                       nof_snapshots{0};
+};
+
+} // namespace
+
+/// Returns the tracer instance, it is never destroyed.
+static span_tracer& get_tracer()
+{
+  static span_tracer* tracer = new span_tracer;
+  return *tracer;
+}
+
+bool srslog::span_trace_init(const std::string& filename, std::size_t nof_spans, uint32_t max_snapshots)
+{
+  return get_tracer().init(filename, nof_spans, max_snapshots);
+}
+
+bool srslog::span_trace_flush()
+{
+  return get_tracer().flush();
+}
+
+bool srslog::span_trace_flush(const std::string& filename)
+{
+  return get_tracer().flush(filename);
+}
+
+void srslog::span_trace_snapshot()
+{
+  get_tracer().request_snapshot();
+}
+
+uint64_t srslog::span_trace_new_flow_id()
+{
+  static std::atomic<uint64_t> next_flow_id{1};
+  return next_flow_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+void srslog::detail::record_span(const char* category,
+                                 const char* name,
+                                 uint64_t    id,
+                                 span_kind   kind,
+                                 uint64_t    start,
+                                 uint64_t    end)
+{
+  get_tracer().record({category, name, id, start, end, kind});
+}
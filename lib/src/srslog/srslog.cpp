@@ -21,6 +21,9 @@
 
 #include "srsran/srslog/srslog.h"
 #include "formatters/json_formatter.h"
+#include "formatters/text_formatter.h"
+#include "sinks/async_file_sink.h"
+#include "sinks/binary_file_sink.h"
 #include "sinks/file_sink.h"
 #include "sinks/syslog_sink.h"
 #include "srslog_instance.h"
@@ -178,6 +181,46 @@ sink& srslog::fetch_file_sink(const std::string&             path,
   return *s;
 }
 
+sink& srslog::fetch_async_file_sink(const std::string&             path,
+                                    size_t                         max_size,
+                                    size_t                         buffer_size,
+                                    std::unique_ptr<log_formatter> f)
+{
+  assert(!path.empty() && "Empty path string");
+
+  if (auto* s = find_sink(path)) {
+    return *s;
+  }
+
+  //: TODO: GCC5 or lower versions emits an error if we use the new() expression
+  // directly, use redundant piecewise_construct instead.
+  auto& s = srslog_instance::get().get_sink_repo().emplace(
+      std::piecewise_construct,
+      std::forward_as_tuple(path),
+      std::forward_as_tuple(new async_file_sink(path, max_size, buffer_size, std::move(f))));
+
+  return *s;
+}
+
+sink& srslog::fetch_binary_file_sink(const std::string& path, size_t max_size, size_t ring_size)
+{
+  assert(!path.empty() && "Empty path string");
+
+  if (auto* s = find_sink(path)) {
+    return *s;
+  }
+
+  //: TODO: GCC5 or lower versions emits an error if we use the new() expression
+  // directly, use redundant piecewise_construct instead.
+  auto& s = srslog_instance::get().get_sink_repo().emplace(
+      std::piecewise_construct,
+      std::forward_as_tuple(path),
+      std::forward_as_tuple(
+          new binary_file_sink(path, max_size, ring_size, std::unique_ptr<log_formatter>(new text_formatter))));
+
+  return *s;
+}
+
 sink& srslog::fetch_syslog_sink(const std::string&             preamble_,
                                 syslog_local_type              log_local_,
                                 std::unique_ptr<log_formatter> f)
@@ -237,7 +280,10 @@ void srslog::flush()
     sinks.push_back(s->get());
   }
 
+  // The backend merges the queues of all threads by timestamp, so entries
+  // logged before this point get processed before the flush command.
   detail::log_entry cmd;
+  cmd.metadata.tp    = std::chrono::high_resolution_clock::now();
   cmd.metadata.store = nullptr;
   cmd.flush_cmd =
       std::unique_ptr<detail::flush_backend_cmd>(new detail::flush_backend_cmd{completion_flag, std::move(sinks)});
@@ -258,6 +304,16 @@ void srslog::set_error_handler(error_handler handler)
   srslog_instance::get().set_error_handler(std::move(handler));
 }
 
+void srslog::set_backend_queue_policy(backend_queue_policy policy)
+{
+  srslog_instance::get().set_backend_queue_policy(policy);
+}
+
+backend_metrics srslog::get_backend_metrics()
+{
+  return srslog_instance::get().get_backend_metrics();
+}
+
 ///
 /// Logger management function implementations.
 ///
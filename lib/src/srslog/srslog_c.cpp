@@ -20,8 +20,12 @@
  */
 
 #include "srsran/srslog/srslog_c.h"
+#include "sinks/async_file_writer.h"
+#include "sinks/compressed_file_writer.h"
+#include "sinks/file_utils.h"
 #include "srsran/srslog/srslog.h"
 #include <cstdarg>
+#include <vector>
 
 using namespace srslog;
 
@@ -194,3 +198,127 @@ srslog_sink* srslog_fetch_file_sink(const char* path, size_t max_size, srslog_bo
 {
   return c_cast<srslog_sink>(&fetch_file_sink(path, max_size, force_flush));
 }
+
+namespace {
+
+/// State of a stream returned by srslog_open_async_file or
+/// srslog_open_compressed_file, which write through the specified writer type.
+template <typename Writer>
+struct file_stream {
+  template <typename... Args>
+  file_stream(std::string name, size_t max_size, const void* header, size_t header_len, Args&&... args) :
+    base_filename(std::move(name)),
+    max_size(max_size),
+    header(static_cast<const uint8_t*>(header), static_cast<const uint8_t*>(header) + header_len),
+    writer(std::forward<Args>(args)...)
+  {}
+
+  /// Creates the next file of the stream, starting with the header.
+  detail::error_string create_file()
+  {
+    if (auto err_str = writer.create(file_utils::build_filename_with_index(base_filename, file_index++))) {
+      return err_str;
+    }
+    current_size = header.size();
+    return writer.write(header.data(), header.size());
+  }
+
+  const std::string          base_filename;
+  const size_t               max_size;
+  const std::vector<uint8_t> header;
+  Writer                     writer;
+  size_t                     current_size = 0;
+  uint32_t                   file_index   = 0;
+};
+
+} // namespace
+
+template <typename Writer>
+static ssize_t file_stream_write(void* cookie, const char* buf, size_t size)
+{
+  auto& stream = *static_cast<file_stream<Writer>*>(cookie);
+
+  // Rotate before the write that exceeds the maximum size, unless the file
+  // only holds the header.
+  detail::error_string err_str;
+  if (stream.max_size && stream.current_size + size > stream.max_size &&
+      stream.current_size > stream.header.size()) {
+    err_str = stream.create_file();
+  }
+  if (!err_str) {
+    stream.current_size += size;
+    err_str = stream.writer.write(buf, size);
+  }
+
+  if (err_str || !stream.writer) {
+    if (err_str) {
+      fmt::print(stderr, "srsLog error - {}\n", err_str.get_error());
+    }
+    errno = EIO;
+    return -1;
+  }
+  return size;
+}
+
+/// Prints the compression figures of a stream when it gets closed.
+static void report_close(const file_stream<async_file_writer>& stream) {}
+
+static void report_close(const file_stream<compressed_file_writer>& stream)
+{
+  compressed_file_writer::metrics m = stream.writer.get_metrics();
+  fmt::print("Compressed {:.1f} MB of \"{}\" into {:.1f} MB, ratio {:.1f}, {:.2f} s of CPU\n",
+             m.bytes_in / (1024.0 * 1024.0),
+             stream.base_filename,
+             m.bytes_out / (1024.0 * 1024.0),
+             m.bytes_out ? double(m.bytes_in) / m.bytes_out : 0.0,
+             m.cpu_time_ns / 1e9);
+}
+
+template <typename Writer>
+static int file_stream_close(void* cookie)
+{
+  std::unique_ptr<file_stream<Writer> > stream(static_cast<file_stream<Writer>*>(cookie));
+  if (auto err_str = stream->writer.close()) {
+    fmt::print(stderr, "srsLog error - {}\n", err_str.get_error());
+    return EOF;
+  }
+  report_close(*stream);
+  return 0;
+}
+
+/// Creates the first file of the stream and wraps it into a FILE object.
+template <typename Writer>
+static FILE* open_file_stream(std::unique_ptr<file_stream<Writer> > stream)
+{
+  if (auto err_str = stream->create_file()) {
+    fmt::print(stderr, "srsLog error - {}\n", err_str.get_error());
+    return nullptr;
+  }
+
+  cookie_io_functions_t functions = {nullptr, file_stream_write<Writer>, nullptr, file_stream_close<Writer>};
+  FILE*                 f         = ::fopencookie(stream.get(), "w", functions);
+  if (!f) {
+    return nullptr;
+  }
+  stream.release();
+
+  // The writers already buffer the data, avoid copying it into the stream.
+  std::setvbuf(f, nullptr, _IONBF, 0);
+
+  return f;
+}
+
+FILE* srslog_open_async_file(const char* path, size_t max_size, const void* header, size_t header_len)
+{
+  return open_file_stream(std::unique_ptr<file_stream<async_file_writer> >(
+      new file_stream<async_file_writer>(path, max_size, header, header_len)));
+}
+
+FILE* srslog_open_compressed_file(const char* path, size_t max_size, const void* header, size_t header_len, int level)
+{
+  if (!compressed_file_writer::is_supported()) {
+    return nullptr;
+  }
+  return open_file_stream(std::unique_ptr<file_stream<compressed_file_writer> >(
+      new file_stream<compressed_file_writer>(path, max_size, header, header_len, level)));
+}
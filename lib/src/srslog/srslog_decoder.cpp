@@ -0,0 +1,49 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include "binary_log_decoder.h"
+#include <memory>
+
+/// Converts binary log files written by the binary file sink into text.
+int main(int argc, char** argv)
+{
+  if (argc < 2 || argc > 3) {
+    std::fprintf(stderr, "Usage: %s <binary log file> [output text file]\n", argv[0]);
+    return 1;
+  }
+
+  std::unique_ptr<std::FILE, int (*)(std::FILE*)> output(stdout, [](std::FILE*) { return 0; });
+  if (argc == 3) {
+    output = std::unique_ptr<std::FILE, int (*)(std::FILE*)>(std::fopen(argv[2], "w"), &std::fclose);
+    if (!output) {
+      std::fprintf(stderr, "Unable to create output file \"%s\"\n", argv[2]);
+      return 1;
+    }
+  }
+
+  if (auto err_str = srslog::decode_binary_log(argv[1], output.get())) {
+    std::fprintf(stderr, "%s\n", err_str.get_error().c_str());
+    return 1;
+  }
+
+  return 0;
+}
@@ -88,6 +88,13 @@ public:
   /// Installs the specified error handler into the backend.
   void set_error_handler(error_handler callback) { backend.set_error_handler(std::move(callback)); }
 
+  /// Sets the policy applied by the backend when the log queue of a thread is
+  /// full.
+  void set_backend_queue_policy(backend_queue_policy policy) { backend.set_queue_policy(policy); }
+
+  /// Returns the metrics of the backend.
+  backend_metrics get_backend_metrics() const { return backend.get_metrics(); }
+
   /// Set the specified sink as the default one.
   void set_default_sink(sink& s) { default_sink = &s; }
 
@@ -21,6 +21,8 @@
 
 #include "srsran/adt/bounded_bitset.h"
 #include "srsran/common/test_common.h"
+#include <chrono>
+#include <random>
 
 void test_bit_operations()
 {
@@ -278,6 +280,117 @@ void test_bitset_find()
   }
 }
 
+/// Bit by bit search of the lowest run, as a reference
+template <size_t N, bool reversed>
+int find_lowest_run_ref(const srsran::bounded_bitset<N, reversed>& bitset, size_t start, size_t stop, size_t len, bool v)
+{
+  if (len == 0) {
+    return static_cast<int>(start);
+  }
+  size_t run = 0;
+  for (size_t i = start; i < stop; ++i) {
+    run = bitset.test(i) == v ? run + 1 : 0;
+    if (run == len) {
+      return static_cast<int>(i + 1 - len);
+    }
+  }
+  return -1;
+}
+
+template <bool reversed>
+int test_bitset_runs()
+{
+  std::mt19937                           rgen(reversed ? 1 : 2);
+  std::uniform_real_distribution<double> unif(0, 1);
+
+  for (size_t size : {1, 6, 25, 63, 64, 65, 100, 128, 200, 275}) {
+    srsran::bounded_bitset<275, reversed> bitset(size);
+    for (uint32_t trial = 0; trial < 500; ++trial) {
+      // Bitsets with long and short runs
+      double density = unif(rgen);
+      bitset.reset();
+      for (size_t i = 0; i < size; ++i) {
+        if (unif(rgen) < density) {
+          bitset.set(i);
+        }
+      }
+      size_t start = rgen() % (size + 1), stop = start + rgen() % (size + 1 - start);
+      size_t len   = rgen() % (size + 1);
+      bool   value = rgen() % 2 == 0;
+
+      size_t nof_ones = 0;
+      for (size_t i = start; i < stop; ++i) {
+        nof_ones += bitset.test(i) ? 1 : 0;
+      }
+      TESTASSERT(bitset.count(start, stop) == nof_ones);
+      TESTASSERT(bitset.any(start, stop) == (nof_ones > 0));
+
+      if (len > stop - start) {
+        TESTASSERT(bitset.find_lowest_run(start, stop, len, value) == -1);
+      } else {
+        TESTASSERT(bitset.find_lowest_run(start, stop, len, value) == find_lowest_run_ref(bitset, start, stop, len, value));
+      }
+
+      std::pair<int, size_t> longest = bitset.find_longest_run(start, stop, value);
+      size_t                 best    = 0;
+      for (size_t l = 1; l <= stop - start; ++l) {
+        if (find_lowest_run_ref(bitset, start, stop, l, value) < 0) {
+          break;
+        }
+        best = l;
+      }
+      TESTASSERT(longest.second == best);
+      TESTASSERT(best == 0 ? longest.first == -1 : longest.first == find_lowest_run_ref(bitset, start, stop, best, value));
+
+      srsran::bounded_bitset<275, reversed> filled(bitset);
+      filled.fill(start, stop, value);
+      for (size_t i = 0; i < size; ++i) {
+        TESTASSERT(filled.test(i) == ((i >= start and i < stop) ? value : bitset.test(i)));
+      }
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+/// Searches for PRB allocations of random length in partially occupied grids of 100 PRBs
+int test_bitset_run_benchmark()
+{
+  const size_t                          nof_prbs = 100, nof_masks = 256, nof_attempts = 1000000;
+  std::mt19937                          rgen(0);
+  std::vector<srsran::bounded_bitset<275, true> > masks(nof_masks, srsran::bounded_bitset<275, true>(nof_prbs));
+  for (auto& mask : masks) {
+    // Occupied PRBs in bursts, as the grants of other UEs
+    for (size_t i = 0; i < nof_prbs;) {
+      size_t len = 1 + rgen() % 12;
+      if (rgen() % 2 == 0) {
+        mask.fill(i, std::min(nof_prbs, i + len));
+      }
+      i += len;
+    }
+  }
+
+  int  checksum_ref = 0, checksum = 0;
+  auto tp           = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < nof_attempts; ++i) {
+    checksum_ref += find_lowest_run_ref(masks[i % nof_masks], 0, nof_prbs, 1 + i % 24, false);
+  }
+  auto tp2 = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < nof_attempts; ++i) {
+    checksum += masks[i % nof_masks].find_lowest_run(0, nof_prbs, 1 + i % 24, false);
+  }
+  auto tp3 = std::chrono::steady_clock::now();
+  TESTASSERT(checksum == checksum_ref);
+
+  double t_ref = std::chrono::duration_cast<std::chrono::nanoseconds>(tp2 - tp).count() / 1e9;
+  double t     = std::chrono::duration_cast<std::chrono::nanoseconds>(tp3 - tp2).count() / 1e9;
+  printf("PRB allocation attempts per second: bit by bit %.1fM, word level %.1fM\n",
+         nof_attempts / t_ref / 1e6,
+         nof_attempts / t / 1e6);
+
+  return SRSRAN_SUCCESS;
+}
+
 int main()
 {
   test_bit_operations();
@@ -289,6 +402,9 @@ int main()
   TESTASSERT(test_bitset_resize() == SRSRAN_SUCCESS);
   test_bitset_find<false>();
   test_bitset_find<true>();
+  TESTASSERT(test_bitset_runs<false>() == SRSRAN_SUCCESS);
+  TESTASSERT(test_bitset_runs<true>() == SRSRAN_SUCCESS);
+  TESTASSERT(test_bitset_run_benchmark() == SRSRAN_SUCCESS);
   printf("Success\n");
   return 0;
 }
@@ -0,0 +1,219 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/adt/indexed_heap.h"
+#include "srsran/common/test_common.h"
+#include <chrono>
+#include <cmath>
+#include <queue>
+#include <random>
+
+using srsran::indexed_heap;
+
+int test_heap_ops()
+{
+  indexed_heap<int> heap(8);
+  TESTASSERT(heap.empty() and heap.capacity() == 8);
+
+  heap.set(3, 10);
+  heap.set(5, 30);
+  heap.set(1, 20);
+  TESTASSERT(heap.size() == 3);
+  TESTASSERT(heap.top() == 5 and heap.top_key() == 30);
+  TESTASSERT(heap.contains(1) and not heap.contains(2) and not heap.contains(100));
+
+  // Key updates move the object up and down
+  heap.set(3, 40);
+  TESTASSERT(heap.top() == 3 and heap.key(3) == 40);
+  heap.set(3, 0);
+  TESTASSERT(heap.top() == 5);
+  TESTASSERT(heap.size() == 3);
+
+  // Erasing the top and objects in the middle
+  heap.erase(5);
+  TESTASSERT(heap.top() == 1 and not heap.contains(5));
+  heap.erase(5);
+  TESTASSERT(heap.size() == 2);
+  heap.pop();
+  TESTASSERT(heap.top() == 3 and heap.size() == 1);
+
+  heap.set(7, 5);
+  heap.clear();
+  TESTASSERT(heap.empty() and not heap.contains(3) and not heap.contains(7));
+
+  // Min-heap
+  indexed_heap<float, std::greater<float> > min_heap(4);
+  min_heap.set(0, 2.0);
+  min_heap.set(1, 1.0);
+  TESTASSERT(min_heap.top() == 1);
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_heap_random()
+{
+  const uint32_t                          capacity = 100;
+  std::mt19937                            rgen(1234);
+  std::uniform_int_distribution<uint32_t> idx_dist(0, capacity - 1);
+  std::uniform_int_distribution<int>      key_dist(0, 1000);
+  std::vector<int>                        ref(capacity, -1);
+  indexed_heap<int>                       heap(capacity);
+
+  for (uint32_t n = 0; n < 100000; ++n) {
+    uint32_t idx = idx_dist(rgen);
+    if (rgen() % 4 == 0) {
+      heap.erase(idx);
+      ref[idx] = -1;
+    } else {
+      int key = key_dist(rgen);
+      heap.set(idx, key);
+      ref[idx] = key;
+    }
+
+    int max_key = *std::max_element(ref.begin(), ref.end());
+    TESTASSERT(heap.size() == capacity - (size_t)std::count(ref.begin(), ref.end(), -1));
+    if (max_key < 0) {
+      TESTASSERT(heap.empty());
+    } else {
+      TESTASSERT(heap.top_key() == max_key and ref[heap.top()] == max_key);
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+/// Proportional fair ordering of UEs, as done by a MAC scheduler. Each TTI, the UEs with the highest metric
+/// r / R^fairness are allocated, and a few UEs report a new CQI. The averaged rates R of all UEs decay every TTI
+int test_pf_benchmark()
+{
+  const uint32_t nof_ues     = 1000;
+  const uint32_t nof_ttis    = 5000;
+  const uint32_t nof_allocs  = 8;
+  const uint32_t nof_cqi_upd = 20;
+  const double   alpha       = 0.01;
+  const double   fairness    = 1;
+  auto           metric      = [fairness](double r, double R) {
+    return R != 0 ? r / pow(R, fairness) : std::numeric_limits<double>::max();
+  };
+
+  std::mt19937                            rgen(0);
+  std::uniform_int_distribution<uint32_t> ue_dist(0, nof_ues - 1);
+  std::uniform_real_distribution<double>  rate_dist(100, 10000);
+  std::vector<double>                     rates(nof_ues);
+  for (double& r : rates) {
+    r = rate_dist(rgen);
+  }
+  std::vector<std::vector<uint32_t> > cqi_updates(nof_ttis);
+  for (auto& upd : cqi_updates) {
+    for (uint32_t i = 0; i < nof_cqi_upd; ++i) {
+      upd.push_back(ue_dist(rgen));
+    }
+  }
+  std::vector<uint32_t> nof_served_rebuild(nof_ues, 0), nof_served_incr(nof_ues, 0);
+
+  // Reference: the priority queue is rebuilt every TTI from the metrics of all the UEs
+  {
+    std::vector<double> r = rates, R(nof_ues, 0);
+    auto                t = std::chrono::steady_clock::now();
+    for (uint32_t tti = 0; tti < nof_ttis; ++tti) {
+      for (uint32_t ue : cqi_updates[tti]) {
+        r[ue] = rates[(ue + tti) % nof_ues];
+      }
+      std::priority_queue<std::pair<double, uint32_t> > queue;
+      for (uint32_t ue = 0; ue < nof_ues; ++ue) {
+        queue.emplace(metric(r[ue], R[ue]), ue);
+      }
+      std::vector<uint32_t> served;
+      for (uint32_t n = 0; n < nof_allocs; ++n) {
+        served.push_back(queue.top().second);
+        queue.pop();
+      }
+      for (uint32_t ue = 0; ue < nof_ues; ++ue) {
+        R[ue] *= 1 - alpha;
+      }
+      for (uint32_t ue : served) {
+        R[ue] += alpha * r[ue];
+        nof_served_rebuild[ue]++;
+      }
+    }
+    auto dur = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t);
+    printf("PF rebuild: %d UEs, %.2f usec per TTI\n", nof_ues, dur.count() / 1000.0 / nof_ttis);
+  }
+
+  // Indexed heap: only the metrics of the allocated UEs and of the UEs with a new CQI are updated. The decay of the
+  // averaged rates is applied through a common scale factor
+  {
+    std::vector<double>   r = rates, R(nof_ues, 0);
+    double                scale = 1;
+    indexed_heap<double>  heap(nof_ues);
+    std::vector<uint32_t> served;
+    for (uint32_t ue = 0; ue < nof_ues; ++ue) {
+      heap.set(ue, metric(r[ue], R[ue]));
+    }
+    auto t = std::chrono::steady_clock::now();
+    for (uint32_t tti = 0; tti < nof_ttis; ++tti) {
+      for (uint32_t ue : cqi_updates[tti]) {
+        r[ue] = rates[(ue + tti) % nof_ues];
+        heap.set(ue, metric(r[ue], R[ue]));
+      }
+      served.clear();
+      for (uint32_t n = 0; n < nof_allocs; ++n) {
+        served.push_back(heap.top());
+        heap.pop();
+      }
+      scale /= 1 - alpha;
+      if (scale > 1e9) {
+        for (uint32_t ue = 0; ue < nof_ues; ++ue) {
+          R[ue] /= scale;
+          if (heap.contains(ue)) {
+            heap.set(ue, metric(r[ue], R[ue]));
+          }
+        }
+        scale = 1;
+      }
+      for (uint32_t ue : served) {
+        R[ue] += alpha * r[ue] * scale;
+        heap.set(ue, metric(r[ue], R[ue]));
+        nof_served_incr[ue]++;
+      }
+    }
+    auto dur = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t);
+    printf("PF indexed heap: %d UEs, %.2f usec per TTI\n", nof_ues, dur.count() / 1000.0 / nof_ttis);
+  }
+
+  // Both orderings serve the UEs with the same frequency, up to rounding differences between close metrics
+  for (uint32_t ue = 0; ue < nof_ues; ++ue) {
+    TESTASSERT(nof_served_incr[ue] > 0);
+    TESTASSERT(std::abs((int)nof_served_incr[ue] - (int)nof_served_rebuild[ue]) <= 2);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  TESTASSERT(test_heap_ops() == SRSRAN_SUCCESS);
+  TESTASSERT(test_heap_random() == SRSRAN_SUCCESS);
+  TESTASSERT(test_pf_benchmark() == SRSRAN_SUCCESS);
+
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
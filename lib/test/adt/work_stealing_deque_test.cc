@@ -0,0 +1,116 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/adt/work_stealing_deque.h"
+#include "srsran/common/test_common.h"
+#include <thread>
+#include <vector>
+
+int test_work_stealing_deque_owner()
+{
+  srsran::work_stealing_deque<uint32_t> deque(5);
+  TESTASSERT(deque.capacity() == 8);
+
+  uint32_t v = 0;
+  TESTASSERT(not deque.try_pop(v));
+  TESTASSERT(not deque.try_steal(v));
+
+  for (uint32_t i = 0; i < 8; ++i) {
+    TESTASSERT(deque.try_push(i));
+  }
+  TESTASSERT(not deque.try_push(8));
+  TESTASSERT(deque.size() == 8);
+
+  // The owner takes the newest values, the thieves the oldest ones
+  TESTASSERT(deque.try_pop(v) and v == 7);
+  TESTASSERT(deque.try_steal(v) and v == 0);
+  TESTASSERT(deque.try_pop(v) and v == 6);
+  TESTASSERT(deque.try_steal(v) and v == 1);
+  TESTASSERT(deque.size() == 4);
+
+  // The freed cells are reused
+  TESTASSERT(deque.try_push(10));
+  TESTASSERT(deque.try_push(11));
+  TESTASSERT(deque.try_push(12));
+  TESTASSERT(deque.try_push(13));
+  TESTASSERT(not deque.try_push(14));
+  for (uint32_t expected : {13, 12, 11, 10, 5, 4, 3, 2}) {
+    TESTASSERT(deque.try_pop(v) and v == expected);
+  }
+  TESTASSERT(not deque.try_pop(v));
+  TESTASSERT(deque.size() == 0);
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_work_stealing_deque_concurrent()
+{
+  // The owner pushes and pops while several thieves steal, every value must be taken exactly once
+  const uint32_t                        nof_values = 200000, nof_thieves = 3;
+  srsran::work_stealing_deque<uint32_t> deque(64);
+  std::vector<std::atomic<uint32_t> >   taken(nof_values);
+  std::atomic<bool>                     done{false};
+
+  std::vector<std::thread> thieves;
+  for (uint32_t i = 0; i < nof_thieves; ++i) {
+    thieves.emplace_back([&deque, &taken, &done]() {
+      uint32_t v = 0;
+      while (not done or deque.size() > 0) {
+        if (deque.try_steal(v)) {
+          taken[v]++;
+        }
+      }
+    });
+  }
+
+  uint32_t v = 0;
+  for (uint32_t i = 0; i < nof_values; ++i) {
+    while (not deque.try_push(i)) {
+      if (deque.try_pop(v)) {
+        taken[v]++;
+      }
+    }
+    if (i % 3 == 0 and deque.try_pop(v)) {
+      taken[v]++;
+    }
+  }
+  while (deque.try_pop(v)) {
+    taken[v]++;
+  }
+  done = true;
+  for (std::thread& t : thieves) {
+    t.join();
+  }
+
+  for (uint32_t i = 0; i < nof_values; ++i) {
+    TESTASSERT(taken[i] == 1);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  TESTASSERT(test_work_stealing_deque_owner() == SRSRAN_SUCCESS);
+  TESTASSERT(test_work_stealing_deque_concurrent() == SRSRAN_SUCCESS);
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,234 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/buffer_pool.h"
+#include "srsran/common/test_common.h"
+#include <chrono>
+#include <getopt.h>
+#include <thread>
+
+static uint32_t nof_threads = 4;
+static uint32_t nof_iters   = 200000;
+
+void usage(char* prog)
+{
+  printf("Usage: %s [ti]\n", prog);
+  printf("\t-t Number of threads [Default %d]\n", nof_threads);
+  printf("\t-i Number of alloc/free per thread [Default %d]\n", nof_iters);
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "ti")) != -1) {
+    switch (opt) {
+      case 't':
+        nof_threads = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'i':
+        nof_iters = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+struct pdu_t {
+  uint8_t data[1500];
+#ifdef SRSRAN_BUFFER_POOL_LOG_ENABLED
+  char debug_name[SRSRAN_BUFFER_POOL_LOG_NAME_LEN];
+#endif
+};
+
+/// Previous design of buffer_pool, with a free list protected by a mutex, as reference for the benchmark
+class mutexed_pdu_pool
+{
+public:
+  explicit mutexed_pdu_pool(uint32_t capacity) : pool(capacity)
+  {
+    for (pdu_t& p : pool) {
+      free_list.push_back(&p);
+    }
+  }
+  pdu_t* allocate()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (free_list.empty()) {
+      return nullptr;
+    }
+    pdu_t* p = free_list.back();
+    free_list.pop_back();
+    return p;
+  }
+  bool deallocate(pdu_t* p)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    free_list.push_back(p);
+    return true;
+  }
+
+private:
+  std::mutex           mutex;
+  std::vector<pdu_t>   pool;
+  std::vector<pdu_t*>  free_list;
+};
+
+int test_buffer_pool()
+{
+  srsran::buffer_pool<pdu_t> pool(16);
+  std::vector<pdu_t*>        pdus;
+
+  // The pool can be depleted
+  for (uint32_t i = 0; i < 16; ++i) {
+    pdus.push_back(pool.allocate("test_buffer_pool"));
+    TESTASSERT(pdus.back() != nullptr);
+  }
+  TESTASSERT(pool.nof_available_pdus() == 0);
+  TESTASSERT(pool.allocate("test_buffer_pool") == nullptr);
+
+  // Only buffers of the pool are accepted
+  pdu_t other;
+  TESTASSERT(not pool.deallocate(&other));
+
+  // A blocking allocation waits for a buffer to be released by another thread
+  std::thread t([&pool, &pdus]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    pool.deallocate(pdus.back());
+  });
+  pdu_t* p = pool.allocate("test_buffer_pool", true);
+  TESTASSERT(p == pdus.back());
+  t.join();
+
+  for (pdu_t* pdu : pdus) {
+    TESTASSERT(pool.deallocate(pdu));
+  }
+  TESTASSERT(pool.nof_available_pdus() == 16);
+
+  return SRSRAN_SUCCESS;
+}
+
+/// Runs the alloc/free function in each thread and returns the million operations per second
+template <typename AllocFreeFunc>
+double run_threads(uint32_t threads, const AllocFreeFunc& alloc_free)
+{
+  auto                     t_start = std::chrono::steady_clock::now();
+  std::vector<std::thread> workers;
+  for (uint32_t i = 0; i < threads; ++i) {
+    workers.emplace_back([&alloc_free]() {
+      for (uint32_t n = 0; n < nof_iters; ++n) {
+        alloc_free();
+      }
+    });
+  }
+  for (std::thread& w : workers) {
+    w.join();
+  }
+  double elapsed_us =
+      std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - t_start).count();
+  return threads * nof_iters / elapsed_us;
+}
+
+int bench_same_thread()
+{
+  srsran::buffer_pool<pdu_t> pool(1024);
+  mutexed_pdu_pool           ref_pool(1024);
+
+  // Create the byte_buffer_t pool out of the measurements
+  srsran::byte_buffer_pool::get_instance();
+
+  for (uint32_t threads = 1; threads <= nof_threads; threads *= 2) {
+    // Each thread keeps a few buffers, as a worker processing several PDUs
+    double byte_buffer_mops = run_threads(threads, []() {
+      srsran::unique_byte_buffer_t b1 = srsran::make_byte_buffer(), b2 = srsran::make_byte_buffer();
+      TESTASSERT(b1 != nullptr and b2 != nullptr);
+    });
+    double pool_mops = run_threads(threads, [&pool]() {
+      pdu_t *p1 = pool.allocate(), *p2 = pool.allocate();
+      TESTASSERT(p1 != nullptr and p2 != nullptr);
+      pool.deallocate(p1);
+      pool.deallocate(p2);
+    });
+    double ref_mops = run_threads(threads, [&ref_pool]() {
+      pdu_t *p1 = ref_pool.allocate(), *p2 = ref_pool.allocate();
+      TESTASSERT(p1 != nullptr and p2 != nullptr);
+      ref_pool.deallocate(p1);
+      ref_pool.deallocate(p2);
+    });
+    printf("%d threads: byte_buffer_t=%.2f, buffer_pool=%.2f, mutexed pool=%.2f M alloc-free pairs/s\n",
+           threads,
+           2 * byte_buffer_mops,
+           2 * pool_mops,
+           2 * ref_mops);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int bench_producer_consumer()
+{
+  // Buffers allocated by one thread and released by another, as the PDUs passed from the PHY to the stack
+  srsran::lockfree_bounded_queue<srsran::byte_buffer_t*> queue(256);
+  std::atomic<bool>                                      running = {true};
+
+  auto        t_start = std::chrono::steady_clock::now();
+  std::thread consumer([&queue, &running]() {
+    srsran::byte_buffer_t* b = nullptr;
+    while (running or queue.size() > 0) {
+      if (queue.try_pop(b)) {
+        delete b;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  });
+  for (uint32_t n = 0; n < nof_iters; ++n) {
+    srsran::byte_buffer_t* b = new (std::nothrow) srsran::byte_buffer_t();
+    while (b == nullptr) {
+      // All the free buffers are cached by the consumer, until it returns a batch to the central cache
+      std::this_thread::yield();
+      b = new (std::nothrow) srsran::byte_buffer_t();
+    }
+    while (not queue.try_push(b)) {
+      std::this_thread::yield();
+    }
+  }
+  running = false;
+  consumer.join();
+  double elapsed_us =
+      std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - t_start).count();
+
+  printf("Producer/consumer: %.2f M byte_buffer_t/s\n", nof_iters / elapsed_us);
+
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  TESTASSERT(test_buffer_pool() == SRSRAN_SUCCESS);
+  TESTASSERT(bench_same_thread() == SRSRAN_SUCCESS);
+  TESTASSERT(bench_producer_consumer() == SRSRAN_SUCCESS);
+
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,278 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/byte_buffer_chain.h"
+#include "srsran/common/buffer_pool.h"
+#include "srsran/common/test_common.h"
+#include <chrono>
+#include <numeric>
+#include <vector>
+
+using srsran::byte_buffer_chain;
+using srsran::byte_buffer_segment;
+
+std::vector<uint8_t> make_bytes(uint32_t len, uint8_t first = 0)
+{
+  std::vector<uint8_t> v(len);
+  std::iota(v.begin(), v.end(), first);
+  return v;
+}
+
+bool has_bytes(const byte_buffer_chain& chain, const std::vector<uint8_t>& expected)
+{
+  std::vector<uint8_t> v(chain.size());
+  return chain.copy_to(v) == expected.size() and v == expected;
+}
+
+int test_append()
+{
+  byte_buffer_chain chain;
+  TESTASSERT(chain.empty() and chain.nof_segments() == 0);
+
+  // The bytes fill the first segment after its headroom, then the next ones
+  std::vector<uint8_t> bytes = make_bytes(3000);
+  TESTASSERT(chain.append(bytes));
+  TESTASSERT(chain.size() == 3000);
+  TESTASSERT(chain.nof_segments() == 4);
+  TESTASSERT(chain.segment(0).size() == byte_buffer_segment::capacity - byte_buffer_chain::default_headroom);
+  TESTASSERT(has_bytes(chain, bytes));
+  for (uint32_t i = 0; i < chain.size(); ++i) {
+    TESTASSERT(chain[i] == bytes[i]);
+  }
+
+  // Partial copies
+  std::vector<uint8_t> part(10);
+  TESTASSERT(chain.copy_to(part, 2995) == 5);
+  TESTASSERT(std::equal(part.begin(), part.begin() + 5, bytes.begin() + 2995));
+  TESTASSERT(chain.copy_to(part, 3000) == 0);
+
+  // Small appends fill the tail segment
+  std::vector<uint8_t> tail = make_bytes(10, 200);
+  TESTASSERT(chain.append(tail));
+  TESTASSERT(chain.nof_segments() == 4);
+  bytes.insert(bytes.end(), tail.begin(), tail.end());
+  TESTASSERT(has_bytes(chain, bytes));
+
+  chain.clear();
+  TESTASSERT(chain.empty() and chain.nof_segments() == 0);
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_prepend_and_trim()
+{
+  std::vector<uint8_t> bytes = make_bytes(100);
+  byte_buffer_chain    chain;
+  TESTASSERT(chain.append(bytes));
+
+  // Headers are written in the headroom
+  std::vector<uint8_t> hdr = make_bytes(3, 100);
+  TESTASSERT(chain.prepend(hdr));
+  TESTASSERT(chain.nof_segments() == 1);
+  bytes.insert(bytes.begin(), hdr.begin(), hdr.end());
+  TESTASSERT(has_bytes(chain, bytes));
+
+  // Headers larger than the headroom left take a new segment
+  hdr = make_bytes(byte_buffer_chain::default_headroom, 150);
+  TESTASSERT(chain.prepend(hdr));
+  TESTASSERT(chain.nof_segments() == 2);
+  bytes.insert(bytes.begin(), hdr.begin(), hdr.end());
+  TESTASSERT(has_bytes(chain, bytes));
+
+  chain.trim_head(70);
+  TESTASSERT(chain.nof_segments() == 1);
+  bytes.erase(bytes.begin(), bytes.begin() + 70);
+  TESTASSERT(has_bytes(chain, bytes));
+
+  chain.trim_tail(10);
+  bytes.resize(bytes.size() - 10);
+  TESTASSERT(has_bytes(chain, bytes));
+
+  chain.trim_tail(chain.size());
+  TESTASSERT(chain.empty() and chain.nof_segments() == 0);
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_resize_and_copy_from()
+{
+  // The segments are taken before the bytes are known, then the unused ones are released
+  byte_buffer_chain chain;
+  TESTASSERT(chain.resize(3000));
+  TESTASSERT(chain.size() == 3000 and chain.nof_segments() == 4);
+  std::vector<uint8_t> bytes = make_bytes(1500);
+  TESTASSERT(chain.resize(bytes.size()));
+  TESTASSERT(chain.nof_segments() == 2);
+  TESTASSERT(chain.copy_from(bytes) == bytes.size());
+  TESTASSERT(has_bytes(chain, bytes));
+
+  // Partial overwrites
+  std::vector<uint8_t> part = make_bytes(10, 50);
+  TESTASSERT(chain.copy_from(part, 1495) == 5);
+  std::copy(part.begin(), part.begin() + 5, bytes.begin() + 1495);
+  TESTASSERT(has_bytes(chain, bytes));
+  TESTASSERT(chain.copy_from(part, 1500) == 0);
+
+  // Growing beyond the maximum number of segments fails, leaving the chain unchanged
+  TESTASSERT(not chain.resize(byte_buffer_chain::max_segments * byte_buffer_segment::capacity));
+  TESTASSERT(has_bytes(chain, bytes));
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_slice_and_concat()
+{
+  std::vector<uint8_t> bytes = make_bytes(2500);
+  byte_buffer_chain    chain;
+  TESTASSERT(chain.append(bytes));
+
+  // Slices share the segments
+  byte_buffer_chain s1 = chain.slice(0, 1000), s2 = chain.slice(1000, 1500);
+  TESTASSERT(s1.size() == 1000 and s2.size() == 1500);
+  TESTASSERT(has_bytes(s1, std::vector<uint8_t>(bytes.begin(), bytes.begin() + 1000)));
+  TESTASSERT(has_bytes(s2, std::vector<uint8_t>(bytes.begin() + 1000, bytes.end())));
+
+  // Writing to a slice does not modify the bytes of the others
+  std::vector<uint8_t> hdr = make_bytes(4, 50), tail = make_bytes(4, 60);
+  TESTASSERT(s2.prepend(hdr));
+  TESTASSERT(s1.append(tail));
+  TESTASSERT(has_bytes(chain, bytes));
+  s2.trim_head(4);
+  s1.trim_tail(4);
+
+  // The slices of the same segment are rejoined
+  TESTASSERT(s1.append(std::move(s2)));
+  TESTASSERT(s2.empty());
+  TESTASSERT(s1.nof_segments() == chain.nof_segments());
+  TESTASSERT(has_bytes(s1, bytes));
+
+  // The segments are released with the last chain using them
+  chain.clear();
+  TESTASSERT(has_bytes(s1, bytes));
+
+  // Concatenation with itself
+  byte_buffer_chain c = s1.slice(10, 20);
+  TESTASSERT(c.append(c));
+  TESTASSERT(c.size() == 40);
+  for (uint32_t i = 0; i < 20; ++i) {
+    TESTASSERT(c[i] == bytes[10 + i] and c[20 + i] == bytes[10 + i]);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_max_segments()
+{
+  byte_buffer_chain    chain;
+  std::vector<uint8_t> bytes = make_bytes(byte_buffer_chain::max_segments * byte_buffer_segment::capacity);
+
+  // The chain is left unchanged when it runs out of segments
+  TESTASSERT(chain.append(srsran::const_byte_span{bytes.data(), 10}));
+  TESTASSERT(not chain.append(bytes));
+  TESTASSERT(chain.size() == 10 and chain.nof_segments() == 1);
+
+  byte_buffer_chain other;
+  TESTASSERT(other.append(srsran::const_byte_span{bytes.data(), 2 * byte_buffer_segment::capacity}));
+  for (uint32_t i = 0; i < byte_buffer_chain::max_segments - 2; ++i) {
+    // Not contiguous, each slice takes a segment of the chain
+    TESTASSERT(chain.append(other.slice(2 * i, 1)));
+  }
+  TESTASSERT(not chain.append(other));
+  TESTASSERT(chain.size() == 10 + byte_buffer_chain::max_segments - 2);
+
+  return SRSRAN_SUCCESS;
+}
+
+/// Compares the pool memory and the time taken to build and transmit PDUs with both buffer types
+int test_memory_and_throughput()
+{
+  using clock_t = std::chrono::steady_clock;
+
+  const uint32_t       nof_pdus = 20000;
+  std::vector<uint8_t> tb(SRSRAN_MAX_BUFFER_SIZE_BYTES);
+  uint8_t              hdr[4]   = {};
+  uint32_t             checksum = 0;
+
+  // The pools are created before the measurements
+  srsran::make_byte_buffer();
+  byte_buffer_chain().append(hdr);
+
+  for (uint32_t pdu_len : {40, 1500, 9000}) {
+    std::vector<uint8_t> payload = make_bytes(pdu_len);
+
+    // Payload from the upper layers, PDCP and RLC headers, copy to the MAC TB
+    auto t0 = clock_t::now();
+    for (uint32_t i = 0; i < nof_pdus; ++i) {
+      srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
+      TESTASSERT(pdu != nullptr);
+      pdu->append_bytes(payload.data(), pdu_len);
+      for (uint32_t h = 0; h < 2; ++h) {
+        pdu->msg -= sizeof(hdr);
+        pdu->N_bytes += sizeof(hdr);
+        memcpy(pdu->msg, hdr, sizeof(hdr));
+      }
+      memcpy(tb.data(), pdu->msg, pdu->N_bytes);
+      checksum += tb[i % pdu->N_bytes];
+    }
+    auto t1 = clock_t::now();
+    for (uint32_t i = 0; i < nof_pdus; ++i) {
+      byte_buffer_chain pdu;
+      TESTASSERT(pdu.append(payload));
+      for (uint32_t h = 0; h < 2; ++h) {
+        TESTASSERT(pdu.prepend(hdr));
+      }
+      pdu.copy_to(tb);
+      checksum += tb[i % pdu.size()];
+    }
+    auto t2 = clock_t::now();
+
+    byte_buffer_chain chain;
+    chain.append(payload);
+    printf("PDU of %d B: byte_buffer_t=%zd B, %.1f ns/PDU; byte_buffer_chain=%d B, %.1f ns/PDU\n",
+           pdu_len,
+           sizeof(srsran::byte_buffer_t),
+           std::chrono::duration<double, std::nano>(t1 - t0).count() / nof_pdus,
+           chain.nof_segments() * byte_buffer_segment::block_size,
+           std::chrono::duration<double, std::nano>(t2 - t1).count() / nof_pdus);
+  }
+
+  // Memory of the RLC AM Tx window of a UE full of TCP ACKs
+  const uint32_t window_size = 512;
+  printf("RLC AM Tx window of %d PDUs of 40 B: byte_buffer_t=%.1f KB, byte_buffer_chain=%.1f KB (checksum %d)\n",
+         window_size,
+         window_size * sizeof(srsran::byte_buffer_t) / 1024.0,
+         window_size * byte_buffer_segment::block_size / 1024.0,
+         checksum);
+
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  TESTASSERT(test_append() == SRSRAN_SUCCESS);
+  TESTASSERT(test_prepend_and_trim() == SRSRAN_SUCCESS);
+  TESTASSERT(test_resize_and_copy_from() == SRSRAN_SUCCESS);
+  TESTASSERT(test_slice_and_concat() == SRSRAN_SUCCESS);
+  TESTASSERT(test_max_segments() == SRSRAN_SUCCESS);
+  TESTASSERT(test_memory_and_throughput() == SRSRAN_SUCCESS);
+
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,141 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/multiqueue.h"
+#include "srsran/common/test_common.h"
+#include <cinttypes>
+#include <getopt.h>
+#include <thread>
+
+static uint32_t nof_producers = 8;
+static uint32_t nof_tasks     = 100000;
+
+void usage(char* prog)
+{
+  printf("Usage: %s [pn]\n", prog);
+  printf("\t-p Number of producer threads [Default %d]\n", nof_producers);
+  printf("\t-n Number of tasks per producer [Default %d]\n", nof_tasks);
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "pn")) != -1) {
+    switch (opt) {
+      case 'p':
+        nof_producers = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'n':
+        nof_tasks = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+void print_metrics(srsran::task_multiqueue& multiqueue)
+{
+  std::vector<srsran::task_multiqueue::port_metrics_t> metrics;
+  multiqueue.get_metrics(metrics);
+  for (uint32_t i = 0; i < metrics.size(); ++i) {
+    printf("  queue %d: popped=%" PRIu64 ", max_depth=%d/%d, latency avg=%.1f max=%.1f usec\n",
+           i,
+           metrics[i].nof_popped,
+           metrics[i].max_depth,
+           metrics[i].capacity,
+           metrics[i].avg_latency_us,
+           metrics[i].max_latency_us);
+  }
+}
+
+/// Runs the producers, one queue each as the PHY workers and the GTPU, and a consumer as the stack thread
+int run_benchmark(const char* name, uint32_t tasks_per_producer, std::chrono::microseconds push_period)
+{
+  srsran::task_multiqueue                multiqueue(512, 8);
+  std::vector<srsran::task_queue_handle> queues;
+  for (uint32_t i = 0; i < nof_producers; ++i) {
+    queues.push_back(multiqueue.add_queue());
+  }
+
+  uint64_t    nof_runs = 0, sum_latency_ns = 0;
+  std::thread consumer([&multiqueue, &nof_runs]() {
+    srsran::move_task_t task;
+    while (multiqueue.wait_pop(&task)) {
+      task();
+    }
+  });
+
+  auto                     t_start = std::chrono::steady_clock::now();
+  std::vector<std::thread> producers;
+  for (uint32_t i = 0; i < nof_producers; ++i) {
+    producers.emplace_back([&queues, &nof_runs, &sum_latency_ns, i, tasks_per_producer, push_period]() {
+      for (uint32_t n = 0; n < tasks_per_producer; ++n) {
+        queues[i].push([&nof_runs, &sum_latency_ns, t_push = std::chrono::steady_clock::now()]() {
+          nof_runs++;
+          sum_latency_ns +=
+              std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t_push).count();
+        });
+        if (push_period.count() > 0) {
+          std::this_thread::sleep_for(push_period);
+        }
+      }
+    });
+  }
+  for (std::thread& t : producers) {
+    t.join();
+  }
+  // wait for the consumer to run all the tasks
+  std::atomic<bool> done = {false};
+  queues[0].push([&done]() { done = true; });
+  while (not done) {
+    std::this_thread::yield();
+  }
+  double elapsed_us =
+      std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - t_start).count();
+
+  printf("%s: %d producers, %.2f M tasks/s, average latency %.1f usec\n",
+         name,
+         nof_producers,
+         nof_producers * tasks_per_producer / elapsed_us,
+         sum_latency_ns / (1000.0 * nof_producers * tasks_per_producer));
+  print_metrics(multiqueue);
+
+  multiqueue.stop();
+  consumer.join();
+  TESTASSERT(nof_runs == (uint64_t)nof_producers * tasks_per_producer);
+
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  // Producers pushing as fast as possible, the ports get full
+  TESTASSERT(run_benchmark("Saturated", nof_tasks, std::chrono::microseconds(0)) == SRSRAN_SUCCESS);
+
+  // Producers pushing sporadically, the latency is dominated by the wake up of the consumer
+  TESTASSERT(run_benchmark("Sporadic", 200, std::chrono::microseconds(500)) == SRSRAN_SUCCESS);
+
+  return SRSRAN_SUCCESS;
+}
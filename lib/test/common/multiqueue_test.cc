@@ -306,6 +306,49 @@ int test_multiqueue_threading4()
   return 0;
 }
 
+int test_multiqueue_batch()
+{
+  std::cout << "\n===== TEST multiqueue batch test: start =====\n";
+  // Description: the consumer pops up to batch_size messages from a queue before moving to the next one
+
+  int                     number = 0;
+  multiqueue_handler<int> multiqueue(16, 3);
+  auto                    qid1 = multiqueue.add_queue();
+  auto                    qid2 = multiqueue.add_queue();
+  for (int i = 0; i < 5; ++i) {
+    TESTASSERT(qid1.try_push(i));
+    TESTASSERT(qid2.try_push(10 + i));
+  }
+  std::vector<int> expected = {0, 1, 2, 10, 11, 12, 3, 4, 13, 14};
+  for (int e : expected) {
+    TESTASSERT(multiqueue.try_pop(&number) and number == e);
+  }
+  TESTASSERT(not multiqueue.try_pop(&number));
+
+  // metrics of the full queue
+  for (int i = 0; i < 16; ++i) {
+    TESTASSERT(qid1.try_push(i));
+  }
+  TESTASSERT(not qid1.try_push(16));
+  TESTASSERT(multiqueue.try_pop(&number));
+  std::vector<multiqueue_handler<int>::port_metrics_t> metrics;
+  multiqueue.get_metrics(metrics);
+  TESTASSERT(metrics.size() == 2);
+  TESTASSERT(metrics[0].capacity == 16 and metrics[0].depth == 15 and metrics[0].max_depth == 16);
+  TESTASSERT(metrics[0].nof_popped == 6 and metrics[0].nof_rejected == 1);
+  TESTASSERT(metrics[1].depth == 0 and metrics[1].nof_popped == 5);
+  TESTASSERT(metrics[0].max_latency_us >= metrics[0].avg_latency_us);
+
+  // the metrics are reset by every call
+  multiqueue.get_metrics(metrics);
+  TESTASSERT(metrics[0].depth == 15 and metrics[0].nof_popped == 0 and metrics[0].nof_rejected == 0);
+
+  std::cout << "outcome: Success\n";
+  std::cout << "===================================================\n";
+
+  return 0;
+}
+
 int test_task_thread_pool()
 {
   std::cout << "\n====== TEST task thread pool test 1: start ======\n";
@@ -410,6 +453,93 @@ int test_task_thread_pool3()
   return 0;
 }
 
+int test_task_thread_pool_priorities()
+{
+  std::cout << "\n====== TEST task thread pool priorities: start ======\n";
+  // Description: the pending high priority tasks run before the low priority ones, regardless of the push order
+
+  task_thread_pool  thread_pool(1);
+  std::atomic<bool> started{false}, release{false};
+  std::mutex        mut;
+  std::string       order;
+
+  thread_pool.push_task([&started, &release]() {
+    started = true;
+    while (not release) {
+      std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+  });
+  while (not started) {
+    usleep(10);
+  }
+
+  // The worker is busy, all these tasks stay pending
+  for (uint32_t i = 0; i < 10; ++i) {
+    thread_pool.push_task([&order, &mut]() {
+      std::lock_guard<std::mutex> lock(mut);
+      order += 'L';
+    });
+    thread_pool.push_task(
+        [&order, &mut]() {
+          std::lock_guard<std::mutex> lock(mut);
+          order += 'H';
+        },
+        task_thread_pool::task_priority::high);
+  }
+  TESTASSERT(thread_pool.nof_pending_tasks() == 20);
+  release = true;
+
+  while (thread_pool.nof_pending_tasks() > 0) {
+    usleep(100);
+  }
+  thread_pool.stop();
+
+  TESTASSERT(order == std::string(10, 'H') + std::string(10, 'L'));
+
+  std::cout << "outcome: Success\n";
+  std::cout << "===================================================\n";
+  return 0;
+}
+
+int test_task_thread_pool_stealing()
+{
+  std::cout << "\n====== TEST task thread pool stealing: start ======\n";
+  // Description: the tasks pushed by a worker go to its own deque. While that worker is busy, the other workers steal
+  //              them
+
+  uint32_t              nof_workers = 4, nof_tasks = 100;
+  std::atomic<uint32_t> count{0};
+  std::atomic<bool>     all_stolen{false};
+
+  task_thread_pool thread_pool(nof_workers);
+
+  thread_pool.push_task([&thread_pool, &count, &all_stolen, nof_tasks]() {
+    for (uint32_t i = 0; i < nof_tasks; ++i) {
+      thread_pool.push_task([&count]() { count++; });
+    }
+    // This worker does not return until the other workers have run all of its tasks
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+    while (count < nof_tasks and std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    all_stolen = count == nof_tasks;
+  });
+
+  while (thread_pool.nof_pending_tasks() > 0 or count < nof_tasks) {
+    usleep(100);
+  }
+  thread_pool.stop();
+
+  TESTASSERT(all_stolen);
+  task_thread_pool::metrics_t metrics = thread_pool.get_metrics();
+  TESTASSERT(metrics.nof_tasks == nof_tasks + 1);
+  TESTASSERT(metrics.nof_stolen_tasks == nof_tasks);
+
+  std::cout << "outcome: Success\n";
+  std::cout << "===================================================\n";
+  return 0;
+}
+
 struct C {
   std::unique_ptr<int> val{new int{5}};
 };
@@ -499,10 +629,13 @@ int main()
   TESTASSERT(test_multiqueue_threading2() == 0);
   TESTASSERT(test_multiqueue_threading3() == 0);
   TESTASSERT(test_multiqueue_threading4() == 0);
+  TESTASSERT(test_multiqueue_batch() == 0);
 
   TESTASSERT(test_task_thread_pool() == 0);
   TESTASSERT(test_task_thread_pool2() == 0);
   TESTASSERT(test_task_thread_pool3() == 0);
+  TESTASSERT(test_task_thread_pool_priorities() == 0);
+  TESTASSERT(test_task_thread_pool_stealing() == 0);
 
   TESTASSERT(test_inplace_task() == 0);
 }
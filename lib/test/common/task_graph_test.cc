@@ -0,0 +1,300 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/task_graph.h"
+#include "srsran/common/test_common.h"
+#include "srsran/phy/utils/mem_arena.h"
+#include <cinttypes>
+#include <thread>
+
+int test_graph_build()
+{
+  srsran::task_graph graph(3);
+
+  srsran::task_graph::task_id a = graph.add_task([]() {});
+  srsran::task_graph::task_id b = graph.add_task([]() {});
+  TESTASSERT(a == 0 and b == 1);
+  TESTASSERT(graph.add_dependency(a, b));
+
+  // Dependencies on newer tasks, on itself or on unknown tasks are rejected
+  TESTASSERT(not graph.add_dependency(b, a));
+  TESTASSERT(not graph.add_dependency(a, a));
+  TESTASSERT(not graph.add_dependency(a, 5));
+
+  // The graph capacity is fixed
+  TESTASSERT(graph.add_task([]() {}) == 2);
+  TESTASSERT(graph.add_task([]() {}) == srsran::task_graph::invalid_task);
+
+  graph.clear();
+  TESTASSERT(graph.empty());
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_inline_executor()
+{
+  srsran::task_graph_executor executor(0);
+  srsran::task_graph          graph(8);
+
+  // Chain of tasks, each one must see the result of the previous one
+  std::vector<uint32_t> order;
+  for (uint32_t i = 0; i < 8; i++) {
+    graph.add_task([&order, i]() { order.push_back(i); });
+    if (i > 0) {
+      TESTASSERT(graph.add_dependency(i - 1, i));
+    }
+  }
+  TESTASSERT(executor.run(graph));
+  TESTASSERT(order.size() == 8);
+  for (uint32_t i = 0; i < 8; i++) {
+    TESTASSERT(order[i] == i);
+  }
+
+  srsran::task_graph_executor::metrics_t m = executor.get_metrics();
+  TESTASSERT(m.nof_graphs == 1);
+  TESTASSERT(m.nof_tasks == 8);
+  TESTASSERT(m.nof_deadline_misses == 0);
+
+  return SRSRAN_SUCCESS;
+}
+
+/// Builds a fork-join graph as the PHY does for one TTI: N UL tasks, one scheduling task and N DL tasks
+int build_fork_join(srsran::task_graph& graph, uint32_t nof_branches, std::atomic<uint32_t>* counters, bool* ok)
+{
+  graph.clear();
+
+  std::vector<srsran::task_graph::task_id> ul;
+  for (uint32_t i = 0; i < nof_branches; i++) {
+    ul.push_back(graph.add_task([counters, i]() { counters[i]++; }));
+  }
+
+  srsran::task_graph::task_id sched = graph.add_task([counters, nof_branches, ok]() {
+    // All the UL tasks are complete
+    for (uint32_t i = 0; i < nof_branches; i++) {
+      if (counters[i].load() % 2 != 1) {
+        *ok = false;
+      }
+    }
+  });
+  for (srsran::task_graph::task_id id : ul) {
+    TESTASSERT(graph.add_dependency(id, sched));
+  }
+
+  for (uint32_t i = 0; i < nof_branches; i++) {
+    srsran::task_graph::task_id dl = graph.add_task([counters, i]() { counters[i]++; });
+    TESTASSERT(graph.add_dependency(sched, dl));
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_threaded_executor()
+{
+  const uint32_t nof_branches = 4;
+  const uint32_t nof_runs     = 2000;
+
+  srsran::task_graph_executor executor(3);
+
+  // Two threads running graphs concurrently, as two PHY workers processing consecutive TTIs
+  std::atomic<uint32_t> counters[2][nof_branches] = {};
+  bool                  ok[2]                      = {true, true};
+  auto                  run_graphs                 = [&](uint32_t idx) {
+    srsran::task_graph graph(2 * nof_branches + 1);
+    for (uint32_t n = 0; n < nof_runs; n++) {
+      build_fork_join(graph, nof_branches, counters[idx], &ok[idx]);
+      executor.run(graph);
+    }
+  };
+  std::thread t0(run_graphs, 0);
+  std::thread t1(run_graphs, 1);
+  t0.join();
+  t1.join();
+
+  for (uint32_t idx = 0; idx < 2; idx++) {
+    TESTASSERT(ok[idx]);
+    for (uint32_t i = 0; i < nof_branches; i++) {
+      TESTASSERT(counters[idx][i] == 2 * nof_runs);
+    }
+  }
+
+  srsran::task_graph_executor::metrics_t m = executor.get_metrics();
+  TESTASSERT(m.nof_graphs == 2 * nof_runs);
+  TESTASSERT(m.nof_tasks == 2 * nof_runs * (2 * nof_branches + 1));
+  printf("Executed %" PRIu64 " tasks, %" PRIu64 " stolen\n", m.nof_tasks, m.nof_stolen_tasks);
+
+  executor.stop();
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_deadline()
+{
+  srsran::task_graph_executor executor(1);
+  srsran::task_graph          graph(2);
+
+  // Deadline already expired, both the tasks and the graph are late
+  graph.add_task([]() {});
+  graph.add_task([]() {});
+  graph.set_deadline(srsran::task_graph::clock_t::now() - std::chrono::milliseconds(1));
+  TESTASSERT(not executor.run(graph));
+  TESTASSERT(graph.is_late());
+
+  // A generous deadline is met
+  graph.set_deadline(srsran::task_graph::clock_t::now() + std::chrono::seconds(10));
+  TESTASSERT(executor.run(graph));
+  TESTASSERT(not graph.is_late());
+
+  srsran::task_graph_executor::metrics_t m = executor.get_metrics();
+  TESTASSERT(m.nof_graphs == 2);
+  TESTASSERT(m.nof_deadline_misses == 1);
+  TESTASSERT(m.nof_late_tasks == 2);
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_start_wait()
+{
+  srsran::task_graph_executor executor(0);
+  srsran::task_graph          late_graph(1);
+  srsran::task_graph          early_graph(1);
+
+  // A graph started first can be completed after a graph run later, as the PHY does with the UL and DL of a slot
+  std::vector<uint32_t> order;
+  late_graph.add_task([&order]() { order.push_back(1); });
+  early_graph.add_task([&order]() { order.push_back(0); });
+  executor.start(late_graph);
+  TESTASSERT(executor.run(early_graph));
+  TESTASSERT(order.size() == 1 and order[0] == 0);
+  TESTASSERT(executor.wait(late_graph));
+  TESTASSERT(order.size() == 2 and order[1] == 1);
+
+  // Empty graphs complete immediately
+  srsran::task_graph empty_graph(1);
+  executor.start(empty_graph);
+  TESTASSERT(executor.wait(empty_graph));
+
+  srsran::task_graph_executor::metrics_t m = executor.get_metrics();
+  TESTASSERT(m.nof_graphs == 2);
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_caller_isolation()
+{
+  const uint32_t nof_runs = 2000;
+
+  srsran::task_graph_executor executor(1);
+
+  // The threads waiting for a graph never execute the tasks of the graph of the other thread
+  static thread_local int32_t caller = -1;
+  std::atomic<bool>           ok     = {true};
+  auto                        run_graphs = [&](uint32_t idx) {
+    caller = idx;
+    srsran::task_graph graph(8);
+    for (uint32_t n = 0; n < nof_runs; n++) {
+      graph.clear();
+      for (uint32_t i = 0; i < 8; i++) {
+        graph.add_task([&ok, idx]() {
+          // Gives the other thread the chance to wait for its graph while this one is incomplete
+          std::this_thread::yield();
+          if (caller == static_cast<int32_t>(1 - idx)) {
+            ok = false;
+          }
+        });
+        if (i > 0) {
+          graph.add_dependency(i / 2, i);
+        }
+      }
+      executor.run(graph);
+    }
+  };
+  std::thread t0(run_graphs, 0);
+  std::thread t1(run_graphs, 1);
+  t0.join();
+  t1.join();
+  TESTASSERT(ok);
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_mem_guard()
+{
+  srsran::task_graph_executor executor(2);
+  srsran::task_graph          graph(16);
+
+  // The heap allocations of the tasks are accounted to the thread running the graph, wherever they are executed
+  for (uint32_t i = 0; i < 16; i++) {
+    graph.add_task([]() { srsran_mem_guard_notify(64); });
+  }
+  srsran_mem_guard_enter(false);
+  TESTASSERT(executor.run(graph));
+  TESTASSERT(srsran_mem_guard_exit() == 16);
+
+  // Without guard, nothing is counted
+  TESTASSERT(executor.run(graph));
+  srsran_mem_guard_enter(false);
+  TESTASSERT(srsran_mem_guard_exit() == 0);
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_max_graphs()
+{
+  srsran::task_graph_executor executor(1, -1, 255, 256, 1);
+  srsran::task_graph          first_graph(2);
+  srsran::task_graph          second_graph(2);
+
+  // The second graph finds no free submission queue and is executed by the thread waiting for it
+  std::atomic<uint32_t> count = {0};
+  for (srsran::task_graph* graph : {&first_graph, &second_graph}) {
+    graph->add_task([&count]() { count++; });
+    graph->add_task([&count]() { count++; });
+    graph->add_dependency(0, 1);
+  }
+  executor.start(first_graph);
+  TESTASSERT(executor.run(second_graph));
+  TESTASSERT(executor.wait(first_graph));
+  TESTASSERT(count == 4);
+
+  // The submission queue is free again
+  TESTASSERT(executor.run(second_graph));
+  TESTASSERT(count == 6);
+
+  srsran::task_graph_executor::metrics_t m = executor.get_metrics();
+  TESTASSERT(m.nof_graphs == 3);
+  TESTASSERT(m.nof_tasks == 6);
+
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  TESTASSERT(test_graph_build() == SRSRAN_SUCCESS);
+  TESTASSERT(test_inline_executor() == SRSRAN_SUCCESS);
+  TESTASSERT(test_threaded_executor() == SRSRAN_SUCCESS);
+  TESTASSERT(test_deadline() == SRSRAN_SUCCESS);
+  TESTASSERT(test_start_wait() == SRSRAN_SUCCESS);
+  TESTASSERT(test_caller_isolation() == SRSRAN_SUCCESS);
+  TESTASSERT(test_mem_guard() == SRSRAN_SUCCESS);
+  TESTASSERT(test_max_graphs() == SRSRAN_SUCCESS);
+
+  return SRSRAN_SUCCESS;
+}
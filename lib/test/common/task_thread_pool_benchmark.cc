@@ -0,0 +1,185 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/test_common.h"
+#include "srsran/common/thread_pool.h"
+#include <algorithm>
+#include <cinttypes>
+#include <getopt.h>
+#include <thread>
+
+using srsran::task_thread_pool;
+
+static uint32_t nof_workers = 4;
+static uint32_t nof_tasks   = 2000;
+
+void usage(char* prog)
+{
+  printf("Usage: %s [wn]\n", prog);
+  printf("\t-w Number of workers of the pool [Default %d]\n", nof_workers);
+  printf("\t-n Number of latency-critical tasks per run [Default %d]\n", nof_tasks);
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "wn")) != -1) {
+    switch (opt) {
+      case 'w':
+        nof_workers = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'n':
+        nof_tasks = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+static void busy_wait(std::chrono::microseconds duration)
+{
+  auto t_end = std::chrono::steady_clock::now() + duration;
+  while (std::chrono::steady_clock::now() < t_end) {
+  }
+}
+
+static double percentile_us(std::vector<uint64_t>& latencies_ns, double p)
+{
+  size_t idx = std::min(latencies_ns.size() - 1, (size_t)(p * latencies_ns.size()));
+  std::nth_element(latencies_ns.begin(), latencies_ns.begin() + idx, latencies_ns.end());
+  return latencies_ns[idx] / 1000.0;
+}
+
+void print_metrics(task_thread_pool& pool)
+{
+  task_thread_pool::metrics_t metrics = pool.get_metrics();
+  printf("  pool: tasks=%" PRIu64 ", stolen=%" PRIu64 ", remote_steals=%" PRIu64 "\n",
+         metrics.nof_tasks,
+         metrics.nof_stolen_tasks,
+         metrics.nof_remote_steals);
+}
+
+/// Measures the push-to-start latency of short tasks while the workers are flooded with long background jobs
+int run_mixed_benchmark(const char* name, task_thread_pool::task_priority priority)
+{
+  const std::chrono::microseconds background_duration(200), push_period(100);
+  const uint32_t                  max_background_pending = 4 * nof_workers;
+
+  task_thread_pool      pool(nof_workers);
+  std::vector<uint64_t> latencies_ns(nof_tasks);
+  std::atomic<uint32_t> nof_runs   = {0};
+  std::atomic<bool>     flooding   = {true};
+  uint64_t              nof_floods = 0;
+
+  // Keeps a backlog of background jobs so that every worker is always busy
+  std::thread flooder([&pool, &flooding, &nof_floods, background_duration, max_background_pending]() {
+    while (flooding) {
+      if (pool.nof_pending_tasks() < max_background_pending) {
+        pool.push_task([background_duration]() { busy_wait(background_duration); });
+        nof_floods++;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  for (uint32_t n = 0; n < nof_tasks; ++n) {
+    pool.push_task(
+        [&latencies_ns, &nof_runs, n, t_push = std::chrono::steady_clock::now()]() {
+          latencies_ns[n] =
+              std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t_push).count();
+          nof_runs++;
+        },
+        priority);
+    std::this_thread::sleep_for(push_period);
+  }
+  while (nof_runs < nof_tasks) {
+    std::this_thread::yield();
+  }
+  flooding = false;
+  flooder.join();
+
+  printf("%s: %d workers, %" PRIu64 " background jobs, latency p50=%.1f p99=%.1f p99.9=%.1f max=%.1f usec\n",
+         name,
+         nof_workers,
+         nof_floods,
+         percentile_us(latencies_ns, 0.5),
+         percentile_us(latencies_ns, 0.99),
+         percentile_us(latencies_ns, 0.999),
+         *std::max_element(latencies_ns.begin(), latencies_ns.end()) / 1000.0);
+  print_metrics(pool);
+
+  pool.stop();
+  TESTASSERT(nof_runs == nof_tasks);
+
+  return SRSRAN_SUCCESS;
+}
+
+/// Root tasks fanning out small jobs from inside the pool, the other workers have to steal them
+int run_fan_out_benchmark()
+{
+  const uint32_t nof_roots = 50, nof_children = 200;
+
+  task_thread_pool      pool(nof_workers);
+  std::atomic<uint32_t> nof_runs = {0};
+
+  auto t_start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < nof_roots; ++i) {
+    pool.push_task([&pool, &nof_runs, nof_children]() {
+      for (uint32_t n = 0; n < nof_children; ++n) {
+        pool.push_task([&nof_runs]() {
+          busy_wait(std::chrono::microseconds(5));
+          nof_runs++;
+        });
+      }
+    });
+  }
+  while (nof_runs < nof_roots * nof_children) {
+    std::this_thread::yield();
+  }
+  double elapsed_us =
+      std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - t_start).count();
+
+  printf("Fan-out: %d workers, %.2f M tasks/s\n", nof_workers, nof_roots * nof_children / elapsed_us);
+  print_metrics(pool);
+
+  pool.stop();
+  TESTASSERT(nof_runs == nof_roots * nof_children);
+
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  // Latency-critical tasks pushed with the same priority as the background jobs wait behind the backlog
+  TESTASSERT(run_mixed_benchmark("Mixed, low priority", task_thread_pool::task_priority::low) == SRSRAN_SUCCESS);
+
+  // With high priority they only wait for a worker to finish its current job
+  TESTASSERT(run_mixed_benchmark("Mixed, high priority", task_thread_pool::task_priority::high) == SRSRAN_SUCCESS);
+
+  TESTASSERT(run_fan_out_benchmark() == SRSRAN_SUCCESS);
+
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,230 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include "srsran/common/test_common.h"
+#include "srsran/common/timers.h"
+#include <cinttypes>
+#include <getopt.h>
+#include <random>
+#include <thread>
+
+static uint32_t nof_ues        = 64;
+static uint32_t timers_per_ue  = 128;
+static uint32_t nof_tics       = 10000;
+static uint32_t nof_rem_thread = 4;
+
+void usage(char* prog)
+{
+  printf("Usage: %s [utnr]\n", prog);
+  printf("\t-u Number of UEs [Default %d]\n", nof_ues);
+  printf("\t-t Number of timers per UE [Default %d]\n", timers_per_ue);
+  printf("\t-n Number of tics [Default %d]\n", nof_tics);
+  printf("\t-r Number of threads starting and stopping timers [Default %d]\n", nof_rem_thread);
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "utnr")) != -1) {
+    switch (opt) {
+      case 'u':
+        nof_ues = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 't':
+        timers_per_ue = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'n':
+        nof_tics = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'r':
+        nof_rem_thread = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+/// Timers restarted on expiry, as the RLC/PDCP reordering and poll timers of many UEs, with the stack thread stepping
+int bench_step()
+{
+  srsran::timer_handler                     timers(nof_ues * timers_per_ue);
+  std::vector<srsran::unique_timer>         ue_timers(nof_ues * timers_per_ue);
+  std::mt19937                              rgen(0);
+  std::uniform_int_distribution<uint32_t>   dist(1, 2000);
+  uint64_t                                  nof_expiries = 0;
+
+  for (uint32_t i = 0; i < ue_timers.size(); ++i) {
+    ue_timers[i] = timers.get_unique_timer();
+    ue_timers[i].set(dist(rgen), [&ue_timers, &nof_expiries, i](uint32_t tid) {
+      nof_expiries++;
+      ue_timers[i].run();
+    });
+    ue_timers[i].run();
+  }
+  TESTASSERT(timers.nof_running_timers() == ue_timers.size());
+
+  auto t_start = std::chrono::steady_clock::now();
+  for (uint32_t t = 0; t < nof_tics; ++t) {
+    timers.step_all();
+  }
+  double elapsed_ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t_start).count();
+
+  printf("Step: %zd timers, %" PRIu64 " expiries, %.2f usec/tic\n",
+         ue_timers.size(),
+         nof_expiries,
+         elapsed_ns / (1000.0 * nof_tics));
+  TESTASSERT(timers.nof_running_timers() == ue_timers.size());
+
+  return SRSRAN_SUCCESS;
+}
+
+/// Timers started and stopped by other threads, as the PDCP/RLC entities of the UEs in the PHY workers, while the
+/// stack thread keeps stepping the time
+int bench_remote()
+{
+  const uint32_t                    nof_ops_per_thread = 100000;
+  srsran::timer_handler             timers(nof_ues * timers_per_ue);
+  std::vector<srsran::unique_timer> ue_timers(nof_ues * timers_per_ue);
+  for (srsran::unique_timer& t : ue_timers) {
+    t = timers.get_unique_timer();
+    t.set(100);
+  }
+
+  std::atomic<uint32_t>    nof_finished{0};
+  std::vector<std::thread> threads;
+  auto                     t_start = std::chrono::steady_clock::now();
+  for (uint32_t r = 0; r < nof_rem_thread; ++r) {
+    threads.emplace_back([&, r]() {
+      size_t i = r;
+      for (uint32_t n = 0; n < nof_ops_per_thread; n += 2) {
+        ue_timers[i].run();
+        ue_timers[(i + ue_timers.size() / 2) % ue_timers.size()].stop();
+        i = (i + nof_rem_thread) % ue_timers.size();
+      }
+      nof_finished++;
+    });
+  }
+
+  uint32_t nof_steps = 0;
+  while (nof_finished < nof_rem_thread) {
+    timers.step_all();
+    nof_steps++;
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+  for (std::thread& t : threads) {
+    t.join();
+  }
+  double elapsed_us =
+      std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - t_start).count();
+
+  printf("Remote: %d threads, %d tics, %.2f M run/stop per sec\n",
+         nof_rem_thread,
+         nof_steps,
+         nof_rem_thread * nof_ops_per_thread / elapsed_us);
+
+  // All the changes are applied once the threads stop
+  timers.step_all();
+  uint32_t nof_running = 0;
+  for (srsran::unique_timer& t : ue_timers) {
+    nof_running += t.is_running() ? 1 : 0;
+  }
+  TESTASSERT(timers.nof_running_timers() == nof_running);
+
+  return SRSRAN_SUCCESS;
+}
+
+/// Time stepped by the stack thread, with its timers restarted on expiry, while other threads keep starting and
+/// stopping the timers of other UEs in the same timer handler
+int bench_contended()
+{
+  srsran::timer_handler                   timers(2 * nof_ues * timers_per_ue);
+  std::vector<srsran::unique_timer>       stack_timers(nof_ues * timers_per_ue);
+  std::vector<srsran::unique_timer>       rem_timers(nof_ues * timers_per_ue);
+  std::mt19937                            rgen(0);
+  std::uniform_int_distribution<uint32_t> dist(1, 2000);
+
+  for (uint32_t i = 0; i < stack_timers.size(); ++i) {
+    stack_timers[i] = timers.get_unique_timer();
+    stack_timers[i].set(dist(rgen), [&stack_timers, i](uint32_t tid) { stack_timers[i].run(); });
+    stack_timers[i].run();
+  }
+  for (srsran::unique_timer& t : rem_timers) {
+    t = timers.get_unique_timer();
+    t.set(dist(rgen));
+  }
+
+  std::atomic<bool>        stop{false};
+  std::atomic<uint64_t>    nof_rem_ops{0};
+  std::vector<std::thread> threads;
+  for (uint32_t r = 0; r < nof_rem_thread; ++r) {
+    threads.emplace_back([&, r]() {
+      size_t   i = r;
+      uint64_t n = 0;
+      while (not stop.load(std::memory_order_relaxed)) {
+        rem_timers[i].run();
+        rem_timers[(i + rem_timers.size() / 2) % rem_timers.size()].stop();
+        i = (i + nof_rem_thread) % rem_timers.size();
+        n += 2;
+      }
+      nof_rem_ops += n;
+    });
+  }
+
+  std::chrono::nanoseconds max_step{0};
+  auto                     t_start = std::chrono::steady_clock::now();
+  for (uint32_t t = 0; t < nof_tics; ++t) {
+    auto t_step = std::chrono::steady_clock::now();
+    timers.step_all();
+    max_step = std::max(max_step, std::chrono::steady_clock::now() - t_step);
+  }
+  double elapsed_ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t_start).count();
+  stop = true;
+  for (std::thread& t : threads) {
+    t.join();
+  }
+
+  printf("Contended: %d threads, %.2f usec/tic, max %.2f usec/tic, %.2f M remote run/stop per sec\n",
+         nof_rem_thread,
+         elapsed_ns / (1000.0 * nof_tics),
+         max_step.count() / 1000.0,
+         nof_rem_ops * 1000.0 / elapsed_ns);
+
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  printf("Timer handler size: %zd bytes\n", sizeof(srsran::timer_handler));
+  // The stack is always multi-threaded. Without any other thread, the mutexes skip their atomic instructions
+  std::thread([]() {}).join();
+  TESTASSERT(bench_step() == SRSRAN_SUCCESS);
+  TESTASSERT(bench_remote() == SRSRAN_SUCCESS);
+  TESTASSERT(bench_contended() == SRSRAN_SUCCESS);
+
+  return SRSRAN_SUCCESS;
+}
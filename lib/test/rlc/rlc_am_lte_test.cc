@@ -21,6 +21,7 @@
 
 #include "rlc_test_common.h"
 #include "srsran/common/buffer_pool.h"
+#include "srsran/common/byte_buffer_chain.h"
 #include "srsran/common/rlc_pcap.h"
 #include "srsran/common/test_common.h"
 #include "srsran/common/threads.h"
@@ -3422,6 +3423,67 @@ bool incorrect_status_pdu_test2()
   return SRSRAN_SUCCESS;
 }
 
+/// The test checks that no PDU is built, and no SN is assigned, while the segments of its retx copy can't be allocated
+bool depleted_segment_pool_test()
+{
+  rlc_am_tester         tester;
+  srsran::timer_handler timers(8);
+  int                   len = 0;
+
+  rlc_am rlc1(srsran_rat_t::lte, srslog::fetch_basic_logger("RLC_AM_1"), 1, &tester, &tester, &timers);
+
+  if (not rlc1.configure(rlc_config_t::default_rlc_am_config())) {
+    return -1;
+  }
+
+  unique_byte_buffer_t sdu = srsran::make_byte_buffer();
+  sdu->N_bytes             = 100;
+  for (uint32_t i = 0; i < sdu->N_bytes; i++) {
+    sdu->msg[i] = i;
+  }
+  rlc1.write_sdu(std::move(sdu));
+
+  // Take every segment of the pool
+  std::vector<byte_buffer_chain> hogs;
+  while (true) {
+    byte_buffer_chain hog;
+    if (not hog.resize(byte_buffer_segment::capacity)) {
+      break;
+    }
+    hogs.push_back(std::move(hog));
+  }
+
+  byte_buffer_t pdu;
+  len = rlc1.read_pdu(pdu.msg, 102);
+  TESTASSERT(len == 0);
+  TESTASSERT(rlc1.get_buffer_state() == 102);
+
+  // Once the segments are back, the SDU goes out with SN 0
+  hogs.clear();
+  len         = rlc1.read_pdu(pdu.msg, 102);
+  pdu.N_bytes = len;
+  TESTASSERT(len == 102);
+  rlc_amd_pdu_header_t header = {};
+  rlc_am_read_data_pdu_header(&pdu, &header);
+  TESTASSERT(header.sn == 0);
+
+  // NACK SN 0 and check the retx carries the original bytes
+  rlc_status_pdu_t status_pdu = {};
+  status_pdu.ack_sn           = 1;
+  status_pdu.N_nack           = 1;
+  status_pdu.nacks[0].nack_sn = 0;
+  byte_buffer_t status_buf;
+  rlc_am_write_status_pdu(&status_pdu, &status_buf);
+  rlc1.write_pdu(status_buf.msg, status_buf.N_bytes);
+
+  byte_buffer_t retx;
+  len          = rlc1.read_pdu(retx.msg, 102);
+  retx.N_bytes = len;
+  TESTASSERT(len == 102);
+  TESTASSERT(memcmp(retx.msg + 2, pdu.msg + 2, 100) == 0);
+  return SRSRAN_SUCCESS;
+}
+
 // This test checks the correct functioning of RLC reestablishment
 // after maxRetx attempt.
 bool reestablish_test()
@@ -3966,6 +4028,11 @@ int main(int argc, char** argv)
     exit(-1);
   };
 
+  if (depleted_segment_pool_test()) {
+    printf("depleted_segment_pool_test failed\n");
+    exit(-1);
+  };
+
   if (discard_test()) {
     printf("discard_test failed\n");
     exit(-1);
@@ -0,0 +1,173 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include "file_test_utils.h"
+#include "src/srslog/sinks/async_file_sink.h"
+#include "srsran/srslog/srslog_c.h"
+#include "test_dummies.h"
+#include "testing_helpers.h"
+#include <fstream>
+#include <sstream>
+
+using namespace srslog;
+
+static constexpr char log_filename[] = "async_file_writer_test.log";
+
+/// Returns the contents of the file in the specified path.
+static std::string read_file(const std::string& path)
+{
+  std::ifstream      file(path, std::ios::binary);
+  std::ostringstream contents;
+  contents << file.rdbuf();
+  return contents.str();
+}
+
+/// Returns a string of the specified size with varying contents.
+static std::string build_data(size_t size, char seed)
+{
+  std::string data(size, 0);
+  for (size_t i = 0; i != size; ++i) {
+    data[i] = char(seed + i % 251);
+  }
+  return data;
+}
+
+static bool when_data_is_written_then_file_contents_are_valid(bool use_io_uring)
+{
+  file_test_utils::scoped_file_deleter deleter(log_filename);
+  async_file_writer                    writer(4096, use_io_uring);
+
+  ASSERT_EQ(bool(writer.create(log_filename)), false);
+  ASSERT_EQ(bool(writer), true);
+
+  // Writes of different sizes, some of them bigger than the buffers.
+  std::string expected;
+  for (unsigned i = 0; i != 50; ++i) {
+    std::string data = build_data(1 + (i * 997) % 9000, char(i));
+    ASSERT_EQ(bool(writer.write(data.data(), data.size())), false);
+    expected += data;
+  }
+  ASSERT_EQ(writer.get_size(), expected.size());
+  ASSERT_EQ(bool(writer.close()), false);
+
+  ASSERT_EQ(read_file(log_filename), expected);
+  ASSERT_NE(writer.get_metrics().nof_writes, 0);
+
+  return true;
+}
+
+static bool when_file_is_flushed_then_contents_are_visible_and_can_be_appended(bool use_io_uring)
+{
+  file_test_utils::scoped_file_deleter deleter(log_filename);
+  async_file_writer                    writer(8192, use_io_uring);
+
+  ASSERT_EQ(bool(writer.create(log_filename)), false);
+
+  // A partial buffer is written without the O_DIRECT padding.
+  std::string expected = build_data(100, 'a');
+  writer.write(expected.data(), expected.size());
+  ASSERT_EQ(bool(writer.flush()), false);
+  ASSERT_EQ(read_file(log_filename), expected);
+
+  // Data appended after the flush completes the same buffer.
+  std::string more = build_data(10000, 'b');
+  writer.write(more.data(), more.size());
+  expected += more;
+  ASSERT_EQ(bool(writer.flush()), false);
+  ASSERT_EQ(read_file(log_filename), expected);
+
+  ASSERT_EQ(bool(writer.close()), false);
+  ASSERT_EQ(read_file(log_filename), expected);
+
+  return true;
+}
+
+static bool when_io_uring_is_disabled_then_thread_engine_is_used()
+{
+  file_test_utils::scoped_file_deleter deleter(log_filename);
+  async_file_writer                    writer(4096, false);
+
+  ASSERT_EQ(bool(writer.create(log_filename)), false);
+  ASSERT_EQ(writer.get_engine_type() == async_file_writer::engine_type::thread, true);
+
+  return true;
+}
+
+static bool when_data_written_exceeds_size_threshold_then_sink_creates_new_file()
+{
+  std::string                          filename0 = file_utils::build_filename_with_index(log_filename, 0);
+  std::string                          filename1 = file_utils::build_filename_with_index(log_filename, 1);
+  file_test_utils::scoped_file_deleter deleter   = {filename0, filename1};
+
+  async_file_sink file(log_filename, 5001, 4096, std::unique_ptr<log_formatter>(new test_dummies::log_formatter_dummy));
+
+  // Fill in the file with 5000 bytes, one byte less than the threshold.
+  std::string entry(1000, 'a');
+  for (unsigned i = 0; i != 5; ++i) {
+    file.write(detail::memory_buffer(entry));
+  }
+  file.flush();
+  ASSERT_EQ(file_test_utils::file_exists(filename1), false);
+
+  // This write exceeds the threshold.
+  file.write(detail::memory_buffer("b"));
+  file.flush();
+  ASSERT_EQ(file_test_utils::file_exists(filename1), true);
+  ASSERT_EQ(read_file(filename0), std::string(5000, 'a'));
+  ASSERT_EQ(read_file(filename1), "b");
+
+  return true;
+}
+
+static bool when_stream_is_rotated_then_each_file_starts_with_header()
+{
+  std::string                          filename0 = file_utils::build_filename_with_index(log_filename, 0);
+  std::string                          filename1 = file_utils::build_filename_with_index(log_filename, 1);
+  file_test_utils::scoped_file_deleter deleter   = {filename0, filename1};
+
+  std::string header = "HEADER";
+  FILE*       f      = srslog_open_async_file(log_filename, 30, header.data(), header.size());
+  ASSERT_NE(f, nullptr);
+
+  // The second record does not fit in the first file and is not split.
+  ASSERT_EQ(std::fwrite("0123456789", 1, 10, f), 10);
+  ASSERT_EQ(std::fwrite("abcdefghijklmnopq", 1, 17, f), 17);
+  ASSERT_EQ(std::fclose(f), 0);
+
+  ASSERT_EQ(read_file(filename0), header + "0123456789");
+  ASSERT_EQ(read_file(filename1), header + "abcdefghijklmnopq");
+
+  return true;
+}
+
+int main()
+{
+  TEST_FUNCTION(when_data_is_written_then_file_contents_are_valid, true);
+  TEST_FUNCTION(when_data_is_written_then_file_contents_are_valid, false);
+  TEST_FUNCTION(when_file_is_flushed_then_contents_are_visible_and_can_be_appended, true);
+  TEST_FUNCTION(when_file_is_flushed_then_contents_are_visible_and_can_be_appended, false);
+  TEST_FUNCTION(when_io_uring_is_disabled_then_thread_engine_is_used);
+  TEST_FUNCTION(when_data_written_exceeds_size_threshold_then_sink_creates_new_file);
+  TEST_FUNCTION(when_stream_is_rotated_then_each_file_starts_with_header);
+
+  return 0;
+}
@@ -0,0 +1,106 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include "src/srslog/sinks/async_file_sink.h"
+#include "src/srslog/sinks/file_sink.h"
+#include "srsran/srslog/srslog.h"
+#include <cstdio>
+
+using namespace srslog;
+
+/// Size of each log entry, a typical formatted line with a short hex dump.
+static constexpr size_t entry_size = 160;
+
+/// Writes nof_bytes of log entries into the sink as the backend thread does,
+/// returning the time taken by each write in nanoseconds.
+static std::vector<uint64_t> run_writes(sink& s, size_t nof_bytes, double& throughput)
+{
+  std::string entry(entry_size - 1, 'x');
+  entry.push_back('\n');
+
+  size_t                nof_entries = nof_bytes / entry_size;
+  std::vector<uint64_t> results;
+  results.reserve(nof_entries);
+
+  auto begin = std::chrono::steady_clock::now();
+  for (size_t i = 0; i != nof_entries; ++i) {
+    auto start = std::chrono::steady_clock::now();
+    s.write(detail::memory_buffer(entry));
+    auto end = std::chrono::steady_clock::now();
+    results.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+  }
+  s.flush();
+  auto end = std::chrono::steady_clock::now();
+
+  throughput = nof_entries * entry_size / std::chrono::duration<double>(end - begin).count() / (1024 * 1024);
+
+  std::sort(results.begin(), results.end());
+  return results;
+}
+
+static void benchmark(const char* name, sink& s, size_t nof_bytes)
+{
+  double                throughput = 0;
+  std::vector<uint64_t> results    = run_writes(s, nof_bytes, throughput);
+
+  fmt::print("SRSLOG {} sink, {} MB\n"
+             "Write latency in nanoseconds\n"
+             "Percentiles: | 50th | 75th | 90th | 99th | 99.9th | 99.99th | Worst |\n"
+             "             |{:6}|{:6}|{:6}|{:6}|{:8}|{:9}|{:7}|\n"
+             "Throughput: {:.1f} MB/s\n\n",
+             name,
+             nof_bytes / (1024 * 1024),
+             results[static_cast<size_t>(results.size() * 0.5)],
+             results[static_cast<size_t>(results.size() * 0.75)],
+             results[static_cast<size_t>(results.size() * 0.9)],
+             results[static_cast<size_t>(results.size() * 0.99)],
+             results[static_cast<size_t>(results.size() * 0.999)],
+             results[static_cast<size_t>(results.size() * 0.9999)],
+             results.back(),
+             throughput);
+}
+
+/// Usage: srslog_async_file_sink [size in MB, 1024 by default]
+int main(int argc, char** argv)
+{
+  size_t nof_bytes = size_t((argc > 1) ? std::atoi(argv[1]) : 1024) * 1024 * 1024;
+
+  {
+    file_sink s("srslog_async_benchmark_sync.log", 0, false, srslog::create_text_formatter());
+    benchmark("file", s, nof_bytes);
+  }
+  std::remove("srslog_async_benchmark_sync.log");
+
+  {
+    async_file_sink s("srslog_async_benchmark.log", 0, 1024 * 1024, srslog::create_text_formatter());
+    benchmark("async file", s, nof_bytes);
+
+    async_file_writer::metrics m = s.get_metrics();
+    fmt::print("Async writer: {} writes, {} stalls, {:.1f} ms stalled\n",
+               m.nof_writes,
+               m.nof_stalls,
+               m.stall_time_ns / 1e6);
+  }
+  std::remove("srslog_async_benchmark.log");
+
+  return 0;
+}
@@ -0,0 +1,115 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include "srsran/srslog/srslog.h"
+#include <thread>
+
+using namespace srslog;
+
+static constexpr unsigned num_iterations       = 4000;
+static constexpr unsigned num_entries_per_iter = 40;
+
+/// Busy waits in the calling thread for the specified amount of time.
+static void busy_wait(std::chrono::microseconds interval)
+{
+  auto end = std::chrono::steady_clock::now() + interval;
+  while (std::chrono::steady_clock::now() < end) {
+  }
+}
+
+/// Logs the benchmark entries into the channel, returning the time taken by each entry in nanoseconds. The entries
+/// are generated in bursts, as a PHY worker does in each TTI.
+static std::vector<uint64_t> run_bursts(log_channel& c)
+{
+  std::vector<uint64_t> results;
+  results.reserve(num_iterations);
+
+  for (unsigned iter = 0; iter != num_iterations; ++iter) {
+    auto begin = std::chrono::steady_clock::now();
+    for (unsigned entry_num = 0; entry_num != num_entries_per_iter; ++entry_num) {
+      double d = entry_num;
+      c("SRSLOG binary benchmark: int: %u, double: %f, string: %s", iter, d, "test");
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    results.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count() / num_entries_per_iter);
+
+    busy_wait(std::chrono::microseconds(500));
+  }
+
+  std::sort(results.begin(), results.end());
+  return results;
+}
+
+/// Returns the number of entries per second that can be logged and written into the file, back to back.
+static double run_throughput(log_channel& c)
+{
+  const unsigned nof_entries = num_iterations * num_entries_per_iter;
+
+  auto begin = std::chrono::steady_clock::now();
+  for (unsigned i = 0; i != nof_entries; ++i) {
+    c("SRSLOG binary benchmark: int: %u, double: %f, string: %s", i, double(i), "test");
+    // Leave room for the sink to drain the entries as a real application does.
+    if (i % 1000 == 999) {
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+  }
+  srslog::flush();
+  auto end = std::chrono::steady_clock::now();
+
+  return nof_entries / std::chrono::duration<double>(end - begin).count();
+}
+
+static void benchmark(const char* name, sink& s)
+{
+  auto& channel = srslog::fetch_log_channel(name, s, {});
+
+  std::vector<uint64_t> results    = run_bursts(channel);
+  double                throughput = run_throughput(channel);
+
+  fmt::print("SRSLOG {} sink\n"
+             "Latency in nanoseconds\n"
+             "Percentiles: | 50th | 75th | 90th | 99th | 99.9th | Worst |\n"
+             "             |{:6}|{:6}|{:6}|{:6}|{:8}|{:7}|\n"
+             "Throughput: {:.0f} entries/s\n\n",
+             name,
+             results[static_cast<size_t>(results.size() * 0.5)],
+             results[static_cast<size_t>(results.size() * 0.75)],
+             results[static_cast<size_t>(results.size() * 0.9)],
+             results[static_cast<size_t>(results.size() * 0.99)],
+             results[static_cast<size_t>(results.size() * 0.999)],
+             results.back(),
+             throughput);
+}
+
+int main()
+{
+  auto& text_sink   = srslog::fetch_file_sink("srslog_binary_benchmark.txt");
+  auto& binary_sink = srslog::fetch_binary_file_sink("srslog_binary_benchmark.bin");
+
+  srslog::init();
+
+  benchmark("text", text_sink);
+  benchmark("binary", binary_sink);
+
+  return 0;
+}
@@ -0,0 +1,157 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+
+#include "src/srslog/sinks/compressed_file_writer.h"
+#include "srsran/srslog/srslog.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+using namespace srslog;
+
+/// Size of the PCAP record header plus the MAC-LTE UDP framing of each PDU.
+static constexpr size_t record_header_size = 16 + 28 + 20;
+
+/// Builds a pool of capture records that resemble MAC user-plane PDUs: a
+/// mostly constant header, IP and transport headers with changing counters and
+/// a payload where only part of the bytes are random. PDUs longer than
+/// max_pdu_len are truncated the way the MAC PCAP writer does, zero disables
+/// truncation.
+static std::vector<std::string> build_records(size_t nof_records, size_t max_pdu_len)
+{
+  static const char text[] = "GET /index.html HTTP/1.1\r\nHost: example.com\r\nAccept: */*\r\n";
+
+  std::vector<std::string> records;
+  uint32_t                 state = 0x12345678;
+  for (size_t i = 0; i != nof_records; ++i) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    size_t pdu_len = 100 + state % 1400;
+
+    std::string pdu(pdu_len, 0);
+    for (size_t j = 0; j != pdu_len; ++j) {
+      if (j < 40) {
+        pdu[j] = char((j == 4 || j == 5) ? i >> (8 * (j - 4)) : j);
+      } else if (j % 4 == 0) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        pdu[j] = char(state);
+      } else {
+        pdu[j] = text[j % (sizeof(text) - 1)];
+      }
+    }
+    if (max_pdu_len != 0 && pdu.size() > max_pdu_len) {
+      pdu.resize(max_pdu_len);
+    }
+
+    std::string record(record_header_size, 0);
+    std::memcpy(&record[0], &i, sizeof(i));
+    records.push_back(record + pdu);
+  }
+  return records;
+}
+
+template <typename Writer>
+static void benchmark(const char* name, Writer& writer, const std::vector<std::string>& records, size_t nof_bytes)
+{
+  const char* filename = "srslog_compressed_pcap_benchmark.pcap";
+  writer.create(filename);
+
+  std::vector<uint64_t> results;
+  size_t                written = 0;
+  auto                  begin   = std::chrono::steady_clock::now();
+  for (size_t i = 0; written < nof_bytes; ++i) {
+    const std::string& record = records[i % records.size()];
+    auto               start  = std::chrono::steady_clock::now();
+    writer.write(record.data(), record.size());
+    auto end = std::chrono::steady_clock::now();
+    results.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    written += record.size();
+  }
+  writer.close();
+  double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+  FILE* f = std::fopen(filename, "rb");
+  std::fseek(f, 0, SEEK_END);
+  long file_size = std::ftell(f);
+  std::fclose(f);
+  std::remove(filename);
+
+  std::sort(results.begin(), results.end());
+  fmt::print("{}: {:.1f} MB captured at {:.1f} MB/s into {:.1f} MB, ratio {:.2f}\n"
+             "Write latency in nanoseconds, 50th: {}, 99th: {}, 99.99th: {}, worst: {}\n",
+             name,
+             written / (1024.0 * 1024),
+             written / elapsed / (1024 * 1024),
+             file_size / (1024.0 * 1024),
+             double(written) / file_size,
+             results[static_cast<size_t>(results.size() * 0.5)],
+             results[static_cast<size_t>(results.size() * 0.99)],
+             results[static_cast<size_t>(results.size() * 0.9999)],
+             results.back());
+}
+
+static void benchmark_compressed(const char* name, int level, const std::vector<std::string>& records, size_t nof_bytes)
+{
+  compressed_file_writer writer(level);
+  benchmark(name, writer, records, nof_bytes);
+
+  compressed_file_writer::metrics m = writer.get_metrics();
+  fmt::print("Compression thread: {:.2f} s of CPU, {:.1f} ms per captured MB, {} stalls\n\n",
+             m.cpu_time_ns / 1e9,
+             m.cpu_time_ns / 1e6 / (m.bytes_in / (1024.0 * 1024)),
+             m.nof_stalls);
+}
+
+/// Usage: srslog_compressed_pcap [size in MB, 512 by default] [max PDU length, 128 by default]
+int main(int argc, char** argv)
+{
+  size_t nof_bytes   = size_t((argc > 1) ? std::atoi(argv[1]) : 512) * 1024 * 1024;
+  size_t max_pdu_len = (argc > 2) ? std::atoi(argv[2]) : 128;
+
+  if (!compressed_file_writer::is_supported()) {
+    fmt::print("zstd support is not available\n");
+    return 0;
+  }
+
+  // The pools are larger than the zstd window so that records are not matched
+  // against previous copies of themselves.
+  std::vector<std::string> records = build_records(64 * 1024, 0);
+  {
+    async_file_writer writer(1024 * 1024);
+    benchmark("Uncompressed", writer, records, nof_bytes);
+    fmt::print("\n");
+  }
+  benchmark_compressed("zstd level 1", 1, records, nof_bytes);
+  benchmark_compressed("zstd level 3", 3, records, nof_bytes);
+  benchmark_compressed("zstd level 9", 9, records, nof_bytes);
+
+  // Truncation reduces the captured data before compression.
+  std::vector<std::string> truncated = build_records(64 * 1024, max_pdu_len);
+  benchmark_compressed("zstd level 3, truncated PDUs", 3, truncated, nof_bytes);
+
+  return 0;
+}
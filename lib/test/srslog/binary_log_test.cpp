@@ -0,0 +1,357 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include "file_test_utils.h"
+#include "src/srslog/binary_log_decoder.h"
+#include "src/srslog/formatters/text_formatter.h"
+#include "src/srslog/sinks/binary_file_sink.h"
+#include "src/srslog/sinks/file_sink.h"
+#include "srsran/srslog/log_channel.h"
+#include "testing_helpers.h"
+#include <fstream>
+
+using namespace srslog;
+
+static constexpr char text_filename[]    = "binary_log_test.log";
+static constexpr char binary_filename[]  = "binary_log_test.bin";
+static constexpr char decoded_filename[] = "binary_log_test.txt";
+
+static bool when_records_are_committed_then_they_are_consumed_in_order()
+{
+  detail::byte_ring ring(64);
+
+  std::vector<std::string> records = {"first", "second", "third"};
+  for (const auto& r : records) {
+    uint8_t* p = ring.reserve(r.size());
+    ASSERT_NE(p, nullptr);
+    std::memcpy(p, r.data(), r.size());
+    ring.commit();
+  }
+
+  // A reserved but not committed record is invisible to the consumer.
+  ASSERT_NE(ring.reserve(4), nullptr);
+
+  std::vector<std::string> consumed;
+  size_t                   count = ring.consume(
+      [&consumed](const uint8_t* data, uint32_t size) { consumed.emplace_back(data, data + size); });
+
+  ASSERT_EQ(count, records.size());
+  ASSERT_EQ(consumed, records);
+
+  return true;
+}
+
+static bool when_ring_is_full_then_reserve_fails_until_records_are_consumed()
+{
+  detail::byte_ring ring(64);
+  ASSERT_EQ(ring.get_capacity(), 64);
+
+  // Records bigger than the ring never fit.
+  ASSERT_EQ(ring.reserve(64), nullptr);
+
+  // 4 records of 12 + 4 bytes fill the ring.
+  for (unsigned i = 0; i != 4; ++i) {
+    ASSERT_NE(ring.reserve(12), nullptr);
+    ring.commit();
+  }
+  ASSERT_EQ(ring.reserve(1), nullptr);
+
+  ASSERT_EQ(ring.consume([](const uint8_t*, uint32_t) {}), 4);
+  ASSERT_NE(ring.reserve(12), nullptr);
+
+  return true;
+}
+
+static bool when_records_wrap_around_then_contents_are_preserved()
+{
+  detail::byte_ring ring(64);
+
+  // Use record sizes that leave different gaps at the end of the buffer,
+  // including gaps smaller than the record size prefix.
+  unsigned expected = 0;
+  for (unsigned i = 0; i != 200; ++i) {
+    uint32_t size = 1 + (i * 7) % 29;
+    uint8_t* p    = ring.reserve(size);
+    ASSERT_NE(p, nullptr);
+    std::memset(p, i & 0xff, size);
+    ring.commit();
+
+    bool valid = true;
+    ring.consume([&](const uint8_t* data, uint32_t len) {
+      valid &= (len == 1 + (expected * 7) % 29);
+      valid &= std::all_of(data, data + len, [expected](uint8_t b) { return b == (expected & 0xff); });
+      ++expected;
+    });
+    ASSERT_EQ(valid, true);
+  }
+  ASSERT_EQ(expected, 200);
+
+  return true;
+}
+
+namespace {
+
+/// A log backend that formats the log entries and writes them into their sink
+/// in the calling thread.
+class sync_backend : public detail::log_backend
+{
+  fmt::dynamic_format_arg_store<fmt::printf_context> store;
+
+public:
+  void start(srslog::backend_priority priority) override {}
+
+  bool push(detail::log_entry&& entry) override
+  {
+    fmt::memory_buffer buffer;
+    entry.format_func(std::move(entry.metadata), buffer);
+    entry.s->write({buffer.data(), buffer.size()});
+    return true;
+  }
+
+  bool is_running() const override { return true; }
+
+  fmt::dynamic_format_arg_store<fmt::printf_context>* alloc_arg_store() override
+  {
+    store.clear();
+    return &store;
+  }
+};
+
+} // namespace
+
+/// Reads the lines of a file removing the timestamps of the log entries.
+static std::vector<std::string> read_lines_without_timestamps(const std::string& path)
+{
+  // Length of "YYYY-MM-DDTHH:MM:SS.uuuuuu ".
+  const size_t timestamp_len = 27;
+
+  std::ifstream            file(path, std::ios::binary);
+  std::vector<std::string> lines;
+  for (std::string line; std::getline(file, line);) {
+    if (line.size() >= timestamp_len && line[4] == '-' && line[10] == 'T') {
+      line.erase(0, timestamp_len);
+    }
+    lines.push_back(line);
+  }
+  return lines;
+}
+
+/// Logs the same entries into the specified channel.
+static void log_test_entries(log_channel& log)
+{
+  enum class test_enum : uint8_t { value = 3 };
+  const uint8_t hex[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19};
+  std::string   str   = "std::string";
+  int           i     = -5;
+
+  log.set_hex_dump_max_size(-1);
+  log("Entry without arguments");
+  log("Integers: %d %u %ld %lu %d", i, 5u, int64_t(-1) << 40, uint64_t(1) << 63, uint8_t(200));
+  log("Floating point: %.3f %f %e", 1.5f, 3.14159, 1e-9);
+  log("Chars and bools: %c %s %d", 'x', true, false);
+  log("Strings: %s %s %s", "literal", str, fmt::string_view("view"));
+  log("Enum and pointer: %d %p", test_enum::value, static_cast<const void*>(hex));
+  log("Escaped percent 100%%");
+  log.set_context(42);
+  log(hex, sizeof(hex), "Hex dump of %d bytes", int(sizeof(hex)));
+  log.set_hex_dump_max_size(4);
+  log(hex, sizeof(hex), "Truncated hex dump");
+}
+
+static bool when_entries_are_decoded_then_output_matches_text_sink()
+{
+  file_test_utils::scoped_file_deleter deleter = {text_filename, binary_filename, decoded_filename};
+
+  sync_backend backend;
+  {
+    file_sink text_sink(text_filename, 0, false, std::unique_ptr<log_formatter>(new text_formatter));
+    binary_file_sink binary_sink(binary_filename, 0, 64 * 1024, std::unique_ptr<log_formatter>(new text_formatter));
+
+    log_channel text_log("text", text_sink, backend, {"TEST", 'I', true});
+    log_channel binary_log("binary", binary_sink, backend, {"TEST", 'I', true});
+    ASSERT_EQ(binary_sink.get_binary_writer() != nullptr, true);
+
+    log_test_entries(text_log);
+    log_test_entries(binary_log);
+
+    // Text entries formatted by the backend are stored as they are.
+    text_sink.write(detail::memory_buffer("Formatted text entry\n"));
+    binary_sink.write(detail::memory_buffer("Formatted text entry\n"));
+
+    ASSERT_EQ(bool(text_sink.flush()), false);
+    ASSERT_EQ(bool(binary_sink.flush()), false);
+    ASSERT_EQ(binary_sink.get_nof_dropped(), 0);
+  }
+
+  std::unique_ptr<std::FILE, int (*)(std::FILE*)> output(std::fopen(decoded_filename, "w"), &std::fclose);
+  ASSERT_EQ(bool(decode_binary_log(binary_filename, output.get())), false);
+  output.reset();
+
+  std::vector<std::string> expected = read_lines_without_timestamps(text_filename);
+  ASSERT_EQ(expected.size(), 13);
+  ASSERT_EQ(read_lines_without_timestamps(decoded_filename), expected);
+
+  return true;
+}
+
+static bool when_entries_are_logged_from_several_threads_then_all_of_them_are_decoded()
+{
+  file_test_utils::scoped_file_deleter deleter = {binary_filename, decoded_filename};
+
+  const unsigned nof_threads = 4;
+  const unsigned nof_entries = 1000;
+
+  sync_backend backend;
+  {
+    binary_file_sink binary_sink(binary_filename, 0, 64 * 1024, std::unique_ptr<log_formatter>(new text_formatter));
+    log_channel      log("binary", binary_sink, backend);
+
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t != nof_threads; ++t) {
+      threads.emplace_back([&log, t]() {
+        for (unsigned i = 0; i != nof_entries; ++i) {
+          log("Thread %u entry %u", t, i);
+          if (i % 100 == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+          }
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    ASSERT_EQ(binary_sink.get_nof_dropped(), 0);
+  }
+
+  std::unique_ptr<std::FILE, int (*)(std::FILE*)> output(std::fopen(decoded_filename, "w"), &std::fclose);
+  ASSERT_EQ(bool(decode_binary_log(binary_filename, output.get())), false);
+  output.reset();
+
+  // Entries of each thread keep their order.
+  std::vector<unsigned> next(nof_threads, 0);
+  for (const auto& line : read_lines_without_timestamps(decoded_filename)) {
+    unsigned t, i;
+    ASSERT_EQ(std::sscanf(line.c_str(), "Thread %u entry %u", &t, &i), 2);
+    ASSERT_EQ(t < nof_threads, true);
+    ASSERT_EQ(next[t], i);
+    ++next[t];
+  }
+  ASSERT_EQ(next, std::vector<unsigned>(nof_threads, nof_entries));
+
+  return true;
+}
+
+static bool when_file_is_rotated_then_each_file_can_be_decoded()
+{
+  std::string                          filename0 = file_utils::build_filename_with_index(binary_filename, 0);
+  std::string                          filename1 = file_utils::build_filename_with_index(binary_filename, 1);
+  file_test_utils::scoped_file_deleter deleter   = {filename0, filename1, decoded_filename};
+
+  sync_backend backend;
+  {
+    binary_file_sink binary_sink(binary_filename, 4096, 64 * 1024, std::unique_ptr<log_formatter>(new text_formatter));
+    log_channel      log("binary", binary_sink, backend);
+
+    // Exceed the size of the first file.
+    std::string padding(4096, 'a');
+    log("First file %s", padding);
+    binary_sink.flush();
+    log("Second file");
+    binary_sink.flush();
+  }
+
+  ASSERT_EQ(file_test_utils::file_exists(filename1), true);
+
+  std::unique_ptr<std::FILE, int (*)(std::FILE*)> output(std::fopen(decoded_filename, "w"), &std::fclose);
+  ASSERT_EQ(bool(decode_binary_log(filename1, output.get())), false);
+  output.reset();
+
+  ASSERT_EQ(read_lines_without_timestamps(decoded_filename), std::vector<std::string>{"Second file"});
+
+  return true;
+}
+
+static bool when_format_buffer_is_reused_then_each_entry_keeps_its_format()
+{
+  file_test_utils::scoped_file_deleter deleter = {binary_filename, decoded_filename};
+
+  sync_backend backend;
+  {
+    binary_file_sink binary_sink(binary_filename, 0, 64 * 1024, std::unique_ptr<log_formatter>(new text_formatter));
+    log_channel      log("binary", binary_sink, backend);
+
+    // Same buffer with different contents, as the C API does.
+    char fmtstr[32];
+    std::strcpy(fmtstr, "First format %d");
+    log(fmtstr, 1);
+    std::strcpy(fmtstr, "Second format %d");
+    log(fmtstr, 2);
+    binary_sink.flush();
+  }
+
+  std::unique_ptr<std::FILE, int (*)(std::FILE*)> output(std::fopen(decoded_filename, "w"), &std::fclose);
+  ASSERT_EQ(bool(decode_binary_log(binary_filename, output.get())), false);
+  output.reset();
+
+  std::vector<std::string> expected = {"First format 1", "Second format 2"};
+  ASSERT_EQ(read_lines_without_timestamps(decoded_filename), expected);
+
+  return true;
+}
+
+static bool when_ring_is_full_then_entries_are_dropped_and_reported()
+{
+  file_test_utils::scoped_file_deleter deleter = {binary_filename, decoded_filename};
+
+  sync_backend backend;
+  {
+    binary_file_sink binary_sink(binary_filename, 0, 256, std::unique_ptr<log_formatter>(new text_formatter));
+    log_channel      log("binary", binary_sink, backend);
+
+    // Does not fit in the ring.
+    log("Big entry %s", std::string(512, 'a'));
+    ASSERT_EQ(binary_sink.get_nof_dropped(), 1);
+    binary_sink.flush();
+  }
+
+  std::unique_ptr<std::FILE, int (*)(std::FILE*)> output(std::fopen(decoded_filename, "w"), &std::fclose);
+  ASSERT_EQ(bool(decode_binary_log(binary_filename, output.get())), false);
+  output.reset();
+
+  ASSERT_EQ(file_test_utils::compare_file_contents(decoded_filename, {"srsLog: 1 log entries dropped\n"}), true);
+
+  return true;
+}
+
+int main()
+{
+  TEST_FUNCTION(when_records_are_committed_then_they_are_consumed_in_order);
+  TEST_FUNCTION(when_ring_is_full_then_reserve_fails_until_records_are_consumed);
+  TEST_FUNCTION(when_records_wrap_around_then_contents_are_preserved);
+  TEST_FUNCTION(when_entries_are_decoded_then_output_matches_text_sink);
+  TEST_FUNCTION(when_entries_are_logged_from_several_threads_then_all_of_them_are_decoded);
+  TEST_FUNCTION(when_file_is_rotated_then_each_file_can_be_decoded);
+  TEST_FUNCTION(when_format_buffer_is_reused_then_each_entry_keeps_its_format);
+  TEST_FUNCTION(when_ring_is_full_then_entries_are_dropped_and_reported);
+
+  return 0;
+}
@@ -0,0 +1,214 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include "file_test_utils.h"
+#include "src/srslog/sinks/compressed_file_writer.h"
+#include "src/srslog/sinks/file_utils.h"
+#include "srsran/srslog/srslog_c.h"
+#include "testing_helpers.h"
+#include <fstream>
+#include <sstream>
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+using namespace srslog;
+
+static constexpr char log_filename[] = "compressed_file_writer_test.log";
+
+/// Returns the contents of the file in the specified path.
+static std::string read_file(const std::string& path)
+{
+  std::ifstream      file(path, std::ios::binary);
+  std::ostringstream contents;
+  contents << file.rdbuf();
+  return contents.str();
+}
+
+/// Returns a string of the specified size with varying contents.
+static std::string build_data(size_t size, char seed)
+{
+  std::string data(size, 0);
+  for (size_t i = 0; i != size; ++i) {
+    data[i] = char(seed + (i / 7) % 13);
+  }
+  return data;
+}
+
+/// Decompresses the zstd stream stored in the specified path. Decoding stops
+/// at the end of the file even if the frame is not finished, so that flushed
+/// files can be checked while they are still open.
+static std::string decompress_file(const std::string& path)
+{
+  std::string output;
+#ifdef HAVE_ZSTD
+  std::string  input = read_file(path);
+  ZSTD_DCtx*   dctx  = ZSTD_createDCtx();
+  ZSTD_inBuffer in   = {input.data(), input.size(), 0};
+  std::string  buffer(ZSTD_DStreamOutSize(), 0);
+  while (in.pos < in.size) {
+    ZSTD_outBuffer out = {&buffer[0], buffer.size(), 0};
+    size_t         ret = ZSTD_decompressStream(dctx, &out, &in);
+    if (ZSTD_isError(ret)) {
+      break;
+    }
+    output.append(buffer.data(), out.pos);
+  }
+  // Drain any data that is still buffered by the decoder.
+  for (;;) {
+    ZSTD_outBuffer out = {&buffer[0], buffer.size(), 0};
+    size_t         ret = ZSTD_decompressStream(dctx, &out, &in);
+    output.append(buffer.data(), out.pos);
+    if (ZSTD_isError(ret) || out.pos == 0) {
+      break;
+    }
+  }
+  ZSTD_freeDCtx(dctx);
+#endif
+  return output;
+}
+
+static bool when_data_is_written_then_decompressed_contents_are_valid()
+{
+  file_test_utils::scoped_file_deleter deleter(log_filename);
+  compressed_file_writer               writer(3, 4096, 2);
+
+  ASSERT_EQ(bool(writer.create(log_filename)), false);
+  ASSERT_EQ(bool(writer), true);
+
+  // Writes of different sizes, some of them bigger than the chunks.
+  std::string expected;
+  for (unsigned i = 0; i != 50; ++i) {
+    std::string data = build_data(1 + (i * 997) % 9000, char('a' + i % 10));
+    ASSERT_EQ(bool(writer.write(data.data(), data.size())), false);
+    expected += data;
+  }
+  ASSERT_EQ(writer.get_size(), expected.size());
+  ASSERT_EQ(bool(writer.close()), false);
+
+  // The file starts with the zstd frame magic number.
+  std::string contents = read_file(log_filename);
+  ASSERT_EQ(contents.substr(0, 4), std::string("\x28\xb5\x2f\xfd"));
+  ASSERT_EQ(decompress_file(log_filename), expected);
+
+  compressed_file_writer::metrics metrics = writer.get_metrics();
+  ASSERT_EQ(metrics.bytes_in, expected.size());
+  ASSERT_EQ(metrics.bytes_out, contents.size());
+  ASSERT_EQ(metrics.bytes_out < metrics.bytes_in, true);
+
+  return true;
+}
+
+static bool when_file_is_flushed_then_contents_are_decodable_and_can_be_appended()
+{
+  file_test_utils::scoped_file_deleter deleter(log_filename);
+  compressed_file_writer               writer(1);
+
+  ASSERT_EQ(bool(writer.create(log_filename)), false);
+
+  std::string expected = build_data(100, 'a');
+  writer.write(expected.data(), expected.size());
+  ASSERT_EQ(bool(writer.flush()), false);
+  ASSERT_EQ(decompress_file(log_filename), expected);
+
+  std::string more = build_data(10000, 'b');
+  writer.write(more.data(), more.size());
+  expected += more;
+  ASSERT_EQ(bool(writer.flush()), false);
+  ASSERT_EQ(decompress_file(log_filename), expected);
+
+  ASSERT_EQ(bool(writer.close()), false);
+  ASSERT_EQ(decompress_file(log_filename), expected);
+
+  return true;
+}
+
+static bool when_file_is_recreated_then_each_file_is_a_complete_stream()
+{
+  std::string                          filename0 = file_utils::build_filename_with_index(log_filename, 0);
+  std::string                          filename1 = file_utils::build_filename_with_index(log_filename, 1);
+  file_test_utils::scoped_file_deleter deleter   = {filename0, filename1};
+  compressed_file_writer               writer(3);
+
+  std::string data0 = build_data(5000, 'a');
+  ASSERT_EQ(bool(writer.create(filename0)), false);
+  writer.write(data0.data(), data0.size());
+
+  std::string data1 = build_data(3000, 'k');
+  ASSERT_EQ(bool(writer.create(filename1)), false);
+  ASSERT_EQ(writer.get_size(), 0);
+  writer.write(data1.data(), data1.size());
+  ASSERT_EQ(bool(writer.close()), false);
+
+  ASSERT_EQ(decompress_file(filename0), data0);
+  ASSERT_EQ(decompress_file(filename1), data1);
+
+  return true;
+}
+
+static bool when_stream_is_rotated_then_each_file_starts_with_header()
+{
+  std::string                          filename0 = file_utils::build_filename_with_index(log_filename, 0);
+  std::string                          filename1 = file_utils::build_filename_with_index(log_filename, 1);
+  file_test_utils::scoped_file_deleter deleter   = {filename0, filename1};
+
+  std::string header = "HEADER";
+  FILE*       f      = srslog_open_compressed_file(log_filename, 30, header.data(), header.size(), 3);
+  ASSERT_NE(f, nullptr);
+
+  // The second record does not fit in the first file and is not split.
+  ASSERT_EQ(std::fwrite("0123456789", 1, 10, f), 10);
+  ASSERT_EQ(std::fwrite("abcdefghijklmnopq", 1, 17, f), 17);
+  ASSERT_EQ(std::fclose(f), 0);
+
+  ASSERT_EQ(decompress_file(filename0), header + "0123456789");
+  ASSERT_EQ(decompress_file(filename1), header + "abcdefghijklmnopq");
+
+  return true;
+}
+
+static bool when_zstd_is_not_available_then_files_are_not_opened()
+{
+  file_test_utils::scoped_file_deleter deleter(log_filename);
+  compressed_file_writer               writer(3);
+
+  ASSERT_EQ(bool(writer.create(log_filename)), true);
+  ASSERT_EQ(bool(writer), false);
+  ASSERT_EQ(srslog_open_compressed_file(log_filename, 0, nullptr, 0, 3), nullptr);
+
+  return true;
+}
+
+int main()
+{
+  if (!compressed_file_writer::is_supported()) {
+    TEST_FUNCTION(when_zstd_is_not_available_then_files_are_not_opened);
+    return 0;
+  }
+
+  TEST_FUNCTION(when_data_is_written_then_decompressed_contents_are_valid);
+  TEST_FUNCTION(when_file_is_flushed_then_contents_are_decodable_and_can_be_appended);
+  TEST_FUNCTION(when_file_is_recreated_then_each_file_is_a_complete_stream);
+  TEST_FUNCTION(when_stream_is_rotated_then_each_file_starts_with_header);
+
+  return 0;
+}
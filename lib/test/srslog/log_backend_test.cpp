@@ -22,6 +22,7 @@
 #include "src/srslog/log_backend_impl.h"
 #include "test_dummies.h"
 #include "testing_helpers.h"
+#include <thread>
 
 using namespace srslog;
 
@@ -233,6 +234,102 @@ static bool when_empty_handler_is_used_then_backend_does_not_crash()
   return true;
 }
 
+/// Builds a log entry with the specified timestamp that stores it in the output vector when formatted.
+static detail::log_entry build_timed_log_entry(sink* s, int64_t ticks, std::vector<int64_t>& output)
+{
+  std::chrono::high_resolution_clock::time_point tp{std::chrono::high_resolution_clock::duration(ticks)};
+
+  return {s,
+          [&output](detail::log_entry_metadata&& metadata, fmt::memory_buffer& buffer) {
+            output.push_back(metadata.tp.time_since_epoch().count());
+          },
+          {tp, {0, false}, "Text", nullptr, "", '\0'}};
+}
+
+static bool when_entries_are_pushed_from_several_threads_then_they_are_processed_in_timestamp_order()
+{
+  test_dummies::sink_dummy s;
+  std::vector<int64_t>     output;
+
+  log_backend_impl backend;
+
+  // Each thread pushes into its own queue.
+  auto producer = [&](int64_t first) {
+    for (int64_t ticks = first; ticks < 10; ticks += 2) {
+      backend.push(build_timed_log_entry(&s, ticks, output));
+    }
+  };
+  std::thread t(producer, 0);
+  t.join();
+  producer(1);
+
+  backend.start();
+  // Stop the backend to ensure the entries have been processed.
+  backend.stop();
+
+  ASSERT_EQ(output, std::vector<int64_t>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+  ASSERT_EQ(backend.get_metrics().nof_entries, 10);
+
+  return true;
+}
+
+static bool when_queue_is_full_then_entries_are_dropped_and_counted()
+{
+  test_dummies::sink_dummy s;
+  std::vector<int64_t>     output;
+
+  log_backend_impl backend;
+
+  // The backend is not running so the queue fills up.
+  for (unsigned i = 0; i != SRSLOG_QUEUE_CAPACITY; ++i) {
+    ASSERT_EQ(backend.push(build_timed_log_entry(&s, i, output)), true);
+  }
+  ASSERT_EQ(backend.push(build_timed_log_entry(&s, 0, output)), false);
+
+  backend_metrics metrics = backend.get_metrics();
+  ASSERT_EQ(metrics.nof_dropped_entries, 1);
+  ASSERT_EQ(metrics.nof_producers, 1);
+
+  return true;
+}
+
+static bool when_block_policy_is_used_then_entries_are_not_dropped()
+{
+  test_dummies::sink_dummy s;
+  std::vector<int64_t>     output;
+
+  log_backend_impl backend;
+  backend.set_queue_policy(backend_queue_policy::block);
+  backend.start();
+
+  // Slow down the backend so that the queue fills up.
+  auto entry        = build_timed_log_entry(&s, 0, output);
+  entry.format_func = [](detail::log_entry_metadata&& metadata, fmt::memory_buffer& buffer) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  };
+  backend.push(std::move(entry));
+
+  const unsigned nof_entries = 2 * SRSLOG_QUEUE_CAPACITY;
+  for (unsigned i = 1; i != nof_entries; ++i) {
+    auto* store = backend.alloc_arg_store();
+    ASSERT_NE(store, nullptr);
+    auto e            = build_timed_log_entry(&s, i, output);
+    e.metadata.store = store;
+    ASSERT_EQ(backend.push(std::move(e)), true);
+  }
+
+  // Stop the backend to ensure the entries have been processed.
+  backend.stop();
+
+  backend_metrics metrics = backend.get_metrics();
+  ASSERT_EQ(metrics.nof_entries, nof_entries);
+  ASSERT_EQ(metrics.nof_dropped_entries, 0);
+  ASSERT_NE(metrics.nof_blocked_entries, 0);
+  ASSERT_EQ(output.size(), nof_entries - 1);
+
+  return true;
+}
+
 int main()
 {
   TEST_FUNCTION(when_backend_is_started_then_is_started_returns_true);
@@ -243,6 +340,9 @@ int main()
   TEST_FUNCTION(when_sink_write_fails_then_error_handler_is_invoked);
   TEST_FUNCTION(when_handler_is_set_after_start_then_handler_is_not_used);
   TEST_FUNCTION(when_empty_handler_is_used_then_backend_does_not_crash);
+  TEST_FUNCTION(when_entries_are_pushed_from_several_threads_then_they_are_processed_in_timestamp_order);
+  TEST_FUNCTION(when_queue_is_full_then_entries_are_dropped_and_counted);
+  TEST_FUNCTION(when_block_policy_is_used_then_entries_are_not_dropped);
 
   return 0;
 }
@@ -0,0 +1,249 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "file_test_utils.h"
+#include "srsran/srslog/span_trace.h"
+#include "testing_helpers.h"
+#include <fstream>
+#include <pthread.h>
+#include <sstream>
+#include <thread>
+
+using namespace srslog;
+
+static constexpr char        trace_filename[]    = "span_trace_test.json";
+static constexpr char        snapshot_filename[] = "span_trace_test_0.json";
+static constexpr char        flush_filename[]    = "span_trace_test_flush.json";
+static constexpr std::size_t nof_spans           = 64;
+
+/// Returns the contents of the file in the specified path.
+static std::string read_file(const std::string& path)
+{
+  std::ifstream      file(path, std::ios::binary);
+  std::ostringstream contents;
+  contents << file.rdbuf();
+  return contents.str();
+}
+
+/// Returns the number of occurrences of the pattern in the string.
+static unsigned count(const std::string& str, const std::string& pattern)
+{
+  unsigned n = 0;
+  for (size_t pos = str.find(pattern); pos != std::string::npos; pos = str.find(pattern, pos + 1)) {
+    ++n;
+  }
+  return n;
+}
+
+/// Returns the number of lines of the string that contain both patterns.
+static unsigned count_lines(const std::string& str, const std::string& pattern1, const std::string& pattern2)
+{
+  unsigned           n = 0;
+  std::istringstream lines(str);
+  for (std::string line; std::getline(lines, line);) {
+    if (line.find(pattern1) != std::string::npos && line.find(pattern2) != std::string::npos) {
+      ++n;
+    }
+  }
+  return n;
+}
+
+static bool when_tracer_is_not_initialized_then_flush_fails()
+{
+  {
+    trace_span("test", "ignored");
+  }
+  ASSERT_EQ(span_trace_flush(flush_filename), false);
+  ASSERT_EQ(file_test_utils::file_exists(flush_filename), false);
+
+  return true;
+}
+
+static bool when_tracer_is_initialized_twice_then_second_init_fails()
+{
+  ASSERT_EQ(span_trace_init(trace_filename, nof_spans), true);
+  ASSERT_EQ(span_trace_init(trace_filename, nof_spans), false);
+
+  return true;
+}
+
+static bool when_spans_are_nested_then_they_are_exported_as_complete_events()
+{
+  file_test_utils::scoped_file_deleter deleter = {flush_filename};
+
+  {
+    trace_span("test", "outer");
+    {
+      trace_span("test", "inner");
+      trace_span_instant("test", "mark", 7);
+    }
+  }
+  ASSERT_EQ(span_trace_flush(flush_filename), true);
+
+  std::string trace = read_file(flush_filename);
+  ASSERT_EQ(trace.find("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["), 0);
+  ASSERT_EQ(trace.substr(trace.size() - 3), "]}\n");
+  ASSERT_EQ(count(trace, "\"ph\":\"X\""), 2);
+  ASSERT_EQ(count(trace, "\"ph\":\"i\""), 1);
+  ASSERT_EQ(count(trace, "\"name\":\"thread_name\""), 1);
+
+  // Spans are sorted by their start, the outer span is first.
+  size_t outer = trace.find("\"name\":\"outer\"");
+  size_t inner = trace.find("\"name\":\"inner\"");
+  ASSERT_NE(outer, std::string::npos);
+  ASSERT_NE(inner, std::string::npos);
+  ASSERT_EQ(outer < inner, true);
+  ASSERT_NE(trace.find("\"name\":\"mark\",\"ts\":"), std::string::npos);
+  ASSERT_NE(trace.find("\"args\":{\"id\":7}"), std::string::npos);
+
+  return true;
+}
+
+static bool when_flow_crosses_threads_then_its_spans_are_linked()
+{
+  file_test_utils::scoped_file_deleter deleter = {flush_filename};
+
+  // Two flows with the same id, each one running through three threads.
+  for (unsigned i = 0; i != 2; ++i) {
+    {
+      trace_span_flow_start("flow", "stage0", 42);
+    }
+    std::thread t1([]() {
+      ::pthread_setname_np(::pthread_self(), "stage1_thread");
+      trace_span_flow("flow", "stage1", 42);
+    });
+    t1.join();
+    std::thread t2([]() { trace_span_flow("flow", "stage2", 42); });
+    t2.join();
+  }
+  // A span with another id does not take part in the flows.
+  {
+    trace_span_flow("flow", "other", 43);
+  }
+  ASSERT_EQ(span_trace_flush(flush_filename), true);
+
+  std::string trace = read_file(flush_filename);
+  ASSERT_NE(trace.find("\"args\":{\"name\":\"stage1_thread\"}"), std::string::npos);
+  ASSERT_EQ(count(trace, "\"ph\":\"s\""), 2);
+  ASSERT_EQ(count(trace, "\"ph\":\"t\""), 2);
+  ASSERT_EQ(count(trace, "\"ph\":\"f\""), 2);
+  ASSERT_NE(trace.find("\"cat\":\"flow\",\"name\":\"flow\",\"id\":0,"), std::string::npos);
+  ASSERT_NE(trace.find("\"cat\":\"flow\",\"name\":\"flow\",\"id\":1,"), std::string::npos);
+  ASSERT_EQ(trace.find("\"cat\":\"flow\",\"name\":\"flow\",\"id\":2,"), std::string::npos);
+
+  return true;
+}
+
+static bool when_storage_of_a_flow_is_reused_then_stamped_ids_keep_flows_apart()
+{
+  file_test_utils::scoped_file_deleter deleter = {flush_filename};
+
+  // Two packets in the same storage, as pooled buffers are reused.
+  uint64_t flow_ids[2] = {};
+  for (unsigned i = 0; i != 2; ++i) {
+    uint64_t flow_id = 0;
+    trace_span_stamp_flow(flow_id);
+    flow_ids[i] = flow_id;
+    // A stamped id is kept by the later stages.
+    trace_span_stamp_flow(flow_id);
+    ASSERT_EQ(flow_id, flow_ids[i]);
+    {
+      trace_span_flow("pkt", "ingress", flow_id);
+    }
+    {
+      trace_span_flow("pkt", "egress", flow_id);
+    }
+  }
+  ASSERT_NE(flow_ids[0], 0);
+  ASSERT_NE(flow_ids[1], flow_ids[0]);
+  ASSERT_EQ(span_trace_flush(flush_filename), true);
+
+  // Each packet is a chain of its own, with a start and an end but no intermediate steps.
+  std::string trace = read_file(flush_filename);
+  ASSERT_EQ(count_lines(trace, "\"ph\":\"s\"", "\"cat\":\"pkt\""), 2);
+  ASSERT_EQ(count_lines(trace, "\"ph\":\"t\"", "\"cat\":\"pkt\""), 0);
+  ASSERT_EQ(count_lines(trace, "\"ph\":\"f\"", "\"cat\":\"pkt\""), 2);
+
+  return true;
+}
+
+static bool when_ring_is_full_then_oldest_spans_are_overwritten()
+{
+  file_test_utils::scoped_file_deleter deleter = {flush_filename};
+
+  std::thread t([]() {
+    for (unsigned i = 0; i != 3 * nof_spans; ++i) {
+      trace_span_flow("ring", "span", i);
+    }
+  });
+  t.join();
+  ASSERT_EQ(span_trace_flush(flush_filename), true);
+
+  std::string trace = read_file(flush_filename);
+  ASSERT_EQ(count(trace, "\"cat\":\"ring\",\"name\":\"span\""), nof_spans);
+  ASSERT_EQ(trace.find("\"args\":{\"id\":" + std::to_string(2 * nof_spans - 1) + "}"), std::string::npos);
+  ASSERT_NE(trace.find("\"args\":{\"id\":" + std::to_string(2 * nof_spans) + "}"), std::string::npos);
+  ASSERT_NE(trace.find("\"args\":{\"id\":" + std::to_string(3 * nof_spans - 1) + "}"), std::string::npos);
+
+  return true;
+}
+
+static bool when_snapshot_is_requested_then_it_is_written_in_background()
+{
+  file_test_utils::scoped_file_deleter deleter = {snapshot_filename};
+
+  trace_span_snapshot();
+  for (unsigned i = 0; i != 200 && !file_test_utils::file_exists(snapshot_filename); ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  // Wait for the writer to complete the file.
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  std::string trace = read_file(snapshot_filename);
+  ASSERT_EQ(trace.find("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["), 0);
+  ASSERT_EQ(trace.substr(trace.size() - 3), "]}\n");
+
+  return true;
+}
+
+static bool when_tracer_is_flushed_then_trace_file_is_written()
+{
+  file_test_utils::scoped_file_deleter deleter = {trace_filename};
+
+  ASSERT_EQ(span_trace_flush(), true);
+  ASSERT_EQ(file_test_utils::file_exists(trace_filename), true);
+
+  return true;
+}
+
+int main()
+{
+  TEST_FUNCTION(when_tracer_is_not_initialized_then_flush_fails);
+  TEST_FUNCTION(when_tracer_is_initialized_twice_then_second_init_fails);
+  TEST_FUNCTION(when_spans_are_nested_then_they_are_exported_as_complete_events);
+  TEST_FUNCTION(when_flow_crosses_threads_then_its_spans_are_linked);
+  TEST_FUNCTION(when_storage_of_a_flow_is_reused_then_stamped_ids_keep_flows_apart);
+  TEST_FUNCTION(when_ring_is_full_then_oldest_spans_are_overwritten);
+  TEST_FUNCTION(when_snapshot_is_requested_then_it_is_written_in_background);
+  TEST_FUNCTION(when_tracer_is_flushed_then_trace_file_is_written);
+
+  return 0;
+}
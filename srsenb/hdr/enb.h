@@ -84,6 +84,8 @@ struct log_args_t {
   int         all_hex_limit;
   int         file_max_size;
   std::string filename;
+  bool        binary;
+  bool        async;
 };
 
 struct gui_args_t {
@@ -104,6 +106,9 @@ struct general_args_t {
   bool        tracing_enable;
   std::size_t tracing_buffcapacity;
   std::string tracing_filename;
+  bool        span_tracing_enable;
+  std::size_t span_tracing_nof_spans;
+  std::string span_tracing_filename;
   std::string eia_pref_list;
   std::string eea_pref_list;
   uint32_t    max_mac_dl_kos;
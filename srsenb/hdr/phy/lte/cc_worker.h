@@ -37,7 +37,7 @@ class cc_worker
 public:
   cc_worker(srslog::basic_logger& logger);
   ~cc_worker();
-  void init(phy_common* phy, uint32_t cc_idx);
+  void init(phy_common* phy, uint32_t cc_idx, srsran_mem_arena_t* arena);
   void reset();
 
   cf_t* get_buffer_rx(uint32_t antenna_idx);
@@ -87,8 +87,9 @@ private:
   cf_t*    signal_buffer_tx[SRSRAN_MAX_PORTS] = {};
   uint32_t tti_rx = 0, tti_tx_dl = 0, tti_tx_ul = 0;
 
-  srsran_enb_dl_t enb_dl = {};
-  srsran_enb_ul_t enb_ul = {};
+  srsran_enb_dl_t    enb_dl  = {};
+  srsran_enb_ul_t    enb_ul  = {};
+  srsran_mem_arena_t scratch = {}; ///< PDSCH subframe scratch, reset at the start of every DL subframe
 
   srsran_dl_sf_cfg_t dl_sf = {};
   srsran_ul_sf_cfg_t ul_sf = {};
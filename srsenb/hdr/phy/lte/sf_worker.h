@@ -60,6 +60,9 @@ public:
 
 private:
   void work_imp() final;
+  void work_sf();
+  bool work_sched();
+  void stage_completed(srsran::latency_histogram& latency, std::chrono::microseconds deadline);
 
   /* Common objects */
   srslog::basic_logger& logger;
@@ -72,6 +75,21 @@ private:
   std::vector<std::unique_ptr<cc_worker> >       cc_workers;
   srsran::phy_common_interface::worker_context_t context = {};
 
+  // Memory of the carrier workers, allocated once at initialisation
+  srsran_mem_arena_t arena = {};
+
+  // Subframe processing state, shared by the tasks of the graph. The carrier UL tasks run first, then the scheduling
+  // task and last the carrier DL tasks
+  srsran::task_graph                       graph{2 * SRSRAN_MAX_CARRIERS + 1};
+  srsran::task_graph::clock_t::time_point  tti_start    = {};
+  srsran_ul_sf_cfg_t                       ul_sf        = {};
+  srsran_dl_sf_cfg_t                       dl_sf        = {};
+  srsran_mbsfn_cfg_t                       mbsfn_cfg    = {};
+  stack_interface_phy_lte::ul_sched_list_t ul_grants    = {};
+  stack_interface_phy_lte::ul_sched_list_t ul_grants_tx = {};
+  stack_interface_phy_lte::dl_sched_list_t dl_grants    = {};
+  bool                                     sched_ok     = false;
+
   srsran_softbuffer_tx_t temp_mbsfn_softbuffer = {};
 };
 
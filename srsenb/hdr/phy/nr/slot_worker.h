@@ -22,11 +22,14 @@
 #ifndef SRSENB_NR_SLOT_WORKER_H
 #define SRSENB_NR_SLOT_WORKER_H
 
+#include "srsran/common/task_graph.h"
 #include "srsran/common/thread_pool.h"
+#include "srsran/common/time_prof.h"
 #include "srsran/interfaces/gnb_interfaces.h"
 #include "srsran/interfaces/phy_common_interface.h"
 #include "srsran/srslog/srslog.h"
 #include "srsran/srsran.h"
+#include <atomic>
 
 namespace srsenb {
 namespace nr {
@@ -59,15 +62,24 @@ public:
   };
 
   struct args_t {
-    uint32_t                    cell_index       = 0;
-    uint32_t                    nof_max_prb      = SRSRAN_MAX_PRB_NR;
-    uint32_t                    nof_tx_ports     = 1;
-    uint32_t                    nof_rx_ports     = 1;
-    uint32_t                    rf_port          = 0;
-    srsran_subcarrier_spacing_t scs              = srsran_subcarrier_spacing_15kHz;
-    uint32_t                    pusch_max_its    = 10;
-    float                       pusch_min_snr_dB = -10.0f;
-    double                      srate_hz         = 0.0;
+    uint32_t                     cell_index         = 0;
+    uint32_t                     nof_max_prb        = SRSRAN_MAX_PRB_NR;
+    uint32_t                     nof_tx_ports       = 1;
+    uint32_t                     nof_rx_ports       = 1;
+    uint32_t                     rf_port            = 0;
+    srsran_subcarrier_spacing_t  scs                = srsran_subcarrier_spacing_15kHz;
+    uint32_t                     pusch_max_its      = 10;
+    float                        pusch_min_snr_dB   = -10.0f;
+    double                       srate_hz           = 0.0;
+    bool                         assert_no_alloc    = false;
+    bool                         pusch_mmse_enable  = false; ///< MMSE DMRS filter for the grants that do not select it
+    srsran_wiener_2d_cfg_t       pusch_mmse         = {};    ///< Channel statistics assumed by the PUSCH MMSE filter
+    uint32_t                     tti_deadline_us    = 3000;
+    uint32_t                     tti_ul_deadline_us = 4000;
+    srsran::task_graph_executor* task_executor      = nullptr; ///< Runs the UL and DL processing in parallel
+    srsran::latency_histogram*   ul_latency         = nullptr; ///< Completion time of the UL processing
+    srsran::latency_histogram*   dl_latency         = nullptr; ///< Completion time of the DL processing
+    std::atomic<uint64_t>*       heap_allocs        = nullptr; ///< Counter of the slot processing heap allocations
   };
 
   slot_worker(srsran::phy_common_interface& common_,
@@ -95,10 +107,34 @@ private:
   void work_imp() override;
 
   /**
-   * @brief Retrieves the scheduling results for the UL processing and performs reception
+   * @brief Runs the UL and DL processing of the slot. The UCI is decoded before scheduling the DL, which is
+   * transmitted as soon as it is ready. The UL data decoding does not delay it and can complete afterwards
+   */
+  void work_slot();
+
+  /**
+   * @brief Retrieves the scheduling results for the UL processing, demodulates the slot and decodes the PUCCH and the
+   * PUSCH carrying UCI
+   * @return True if no error occurs, false otherwise
+   */
+  bool work_ul_uci();
+
+  /**
+   * @brief Decodes the PUSCH of the slot without UCI, after work_ul_uci()
    * @return True if no error occurs, false otherwise
    */
-  bool work_ul();
+  bool work_ul_data();
+
+  /**
+   * @brief Decodes a PUSCH transmission and informs the stack
+   * @return True if no error occurs, false otherwise
+   */
+  bool decode_pusch(stack_interface_phy_nr::pusch_t& pusch);
+
+  /**
+   * @brief Records the completion time of a processing stage of the slot, since its reception
+   */
+  void stage_completed(srsran::latency_histogram* latency, std::chrono::microseconds deadline);
 
   /**
    * @brief Retrieves the scheduling results for the DL processing and performs transmission
@@ -120,8 +156,26 @@ private:
   srsran_pdcch_cfg_nr_t                          pdcch_cfg   = {};
   srsran_gnb_dl_t                                gnb_dl      = {};
   srsran_gnb_ul_t                                gnb_ul      = {};
+  srsran::bounded_vector<stack_interface_phy_nr::pusch_t, stack_interface_phy_nr::MAX_GRANTS>
+      ul_data_pusch; ///< PUSCH without UCI of the current slot, copied out of the scheduler slot grid
   std::vector<cf_t*>                             tx_buffer; ///< Baseband transmit buffers
   std::vector<cf_t*>                             rx_buffer; ///< Baseband receive buffers
+  srsran_mem_arena_t                             arena             = {}; ///< Baseband buffers and DL slot scratch
+  srsran_mem_arena_t                             ul_arena          = {}; ///< UL data slot scratch, used concurrently
+  bool                                           assert_no_alloc   = false;
+  bool                                           pusch_mmse_enable = false;
+  srsran_wiener_2d_cfg_t                         pusch_mmse        = {};
+  srsran::task_graph_executor*                   task_executor     = nullptr;
+  srsran::task_graph                             ul_graph{1}; ///< UL processing task of the slot
+  srsran::task_graph                             dl_graph{1}; ///< DL processing task of the slot
+  std::chrono::microseconds                      tti_deadline      = {};
+  std::chrono::microseconds                      ul_deadline       = {};
+  srsran::latency_histogram*                     ul_latency        = nullptr;
+  srsran::latency_histogram*                     dl_latency        = nullptr;
+  std::atomic<uint64_t>*                         heap_allocs       = nullptr;
+  srsran::task_graph::clock_t::time_point        tti_start         = {};
+  bool                                           ul_ok             = true;
+  bool                                           dl_ok             = true;
   std::mutex mutex; ///< Protect concurrent access from workers (and main process that inits the class)
 };
 
@@ -101,13 +101,22 @@ private:
 
 public:
   struct args_t {
-    double                 srate_hz          = 0.0;
-    uint32_t               nof_phy_threads   = 3;
-    uint32_t               nof_prach_workers = 0;
-    uint32_t               prio              = 52;
-    uint32_t               pusch_max_its     = 10;
-    float                  pusch_min_snr_dB  = -10;
-    srsran::phy_log_args_t log               = {};
+    double                       srate_hz           = 0.0;
+    uint32_t                     nof_phy_threads    = 3;
+    uint32_t                     nof_prach_workers  = 0;
+    uint32_t                     prio               = 52;
+    uint32_t                     pusch_max_its      = 10;
+    float                        pusch_min_snr_dB   = -10;
+    bool                         assert_no_alloc    = false;
+    bool                         pusch_mmse_enable  = false;
+    srsran_wiener_2d_cfg_t       pusch_mmse         = {};
+    uint32_t                     tti_deadline_us    = 3000;
+    uint32_t                     tti_ul_deadline_us = 4000;
+    srsran::task_graph_executor* task_executor      = nullptr;
+    srsran::latency_histogram*   ul_latency         = nullptr;
+    srsran::latency_histogram*   dl_latency         = nullptr;
+    std::atomic<uint64_t>*       heap_allocs        = nullptr;
+    srsran::phy_log_args_t       log                = {};
   };
   slot_worker* operator[](std::size_t pos) { return workers.at(pos).get(); }
 
@@ -27,14 +27,17 @@
 #include "srsran/common/gen_mch_tables.h"
 #include "srsran/common/interfaces_common.h"
 #include "srsran/common/standard_streams.h"
+#include "srsran/common/task_graph.h"
 #include "srsran/common/thread_pool.h"
 #include "srsran/common/threads.h"
+#include "srsran/common/time_prof.h"
 #include "srsran/interfaces/enb_metrics_interface.h"
 #include "srsran/interfaces/phy_common_interface.h"
 #include "srsran/interfaces/radio_interfaces.h"
 #include "srsran/phy/channel/channel.h"
 #include "srsran/radio/radio.h"
 
+#include <atomic>
 #include <map>
 #include <srsran/common/tti_sempahore.h>
 #include <string.h>
@@ -273,6 +276,23 @@ public:
    */
   phy_ue_db ue_db;
 
+  /**
+   * Executor of the per-TTI task graphs of the PHY workers. Its threads take the carrier processing tasks that the
+   * worker running the TTI cannot do in parallel
+   */
+  std::unique_ptr<srsran::task_graph_executor> task_executor;
+
+  /**
+   * Completion time of the processing stages of every TTI since its reception, LTE and NR. The DL stage has to be
+   * completed by the transmission time, the UL stage by the time its feedback is needed
+   */
+  srsran::latency_histogram ul_stage_latency;
+  srsran::latency_histogram sched_stage_latency;
+  srsran::latency_histogram dl_stage_latency;
+
+  /// Heap allocations done by the workers while processing TTIs, LTE and NR
+  std::atomic<uint64_t> nof_heap_allocs = {0};
+
   void configure_mbsfn(srsran::phy_cfg_mbsfn_t* cfg);
   void build_mch_table();
   void build_mcch_table();
@@ -23,6 +23,7 @@
 #define SRSENB_PHY_METRICS_H
 
 #include <limits>
+#include <stdint.h>
 
 namespace srsenb {
 
@@ -53,6 +54,27 @@ struct phy_metrics_t {
   ul_metrics_t ul;
 };
 
+// PHY processing metrics, common to all users
+
+struct phy_stage_metrics_t {
+  uint64_t nof_tti  = 0; ///< Number of TTIs that went through the stage
+  uint64_t nof_late = 0; ///< TTIs that completed the stage after its deadline
+  uint32_t p50_us   = 0; ///< Median completion time since the TTI reception, upper bound
+  uint32_t p99_us   = 0; ///< 99th percentile completion time since the TTI reception, upper bound
+  uint32_t max_us   = 0; ///< Maximum completion time since the TTI reception
+};
+
+struct phy_timing_metrics_t {
+  uint64_t            nof_tti             = 0; ///< Number of processed TTIs, LTE and NR
+  uint64_t            nof_deadline_misses = 0; ///< TTIs completed after their deadline
+  uint64_t            nof_late_tasks      = 0; ///< Processing tasks started after the deadline of their TTI
+  uint64_t            nof_stolen_tasks    = 0; ///< Processing tasks executed by an idle thread
+  uint64_t            nof_heap_allocs     = 0; ///< Heap allocations by the workers while processing TTIs
+  phy_stage_metrics_t ul_stage;                ///< UL decoding
+  phy_stage_metrics_t sched_stage;             ///< Scheduling, LTE only
+  phy_stage_metrics_t dl_stage;                ///< DL encoding, until the baseband is ready for transmission
+};
+
 } // namespace srsenb
 
 #endif // SRSENB_PHY_METRICS_H
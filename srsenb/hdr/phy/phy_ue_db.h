@@ -24,6 +24,7 @@
 
 #include "phy_interfaces.h"
 #include "srsran/interfaces/enb_mac_interfaces.h"
+#include "srsran/common/rwlock_guard.h"
 #include "srsran/interfaces/enb_phy_interfaces.h"
 #include <map>
 #include <mutex>
@@ -96,11 +97,19 @@ private:
 
   /**
    * UE object stored in the PHY common database
+   *
+   * The configuration fields (states, PHY configuration and stashed values) are only written with the database write
+   * lock held. The rest are written by the workers with the database read lock held, so they have finer locks:
+   * - The pending ACK and the grant availability of a TTI are protected by the mutex of the TTI slot. Workers
+   *   processing different TTIs do not contend.
+   * - The last rank indicator and the last PUSCH resource allocations are protected by the UE mutex.
    */
   struct common_ue {
     bool                                                  stashed_multiple_csi_request_enabled = false;
     srsran::circular_array<srsran_pdsch_ack_t, TTIMOD_SZ> pdsch_ack = {}; ///< Pending acknowledgements for this Cell
     std::array<cell_info_t, SRSRAN_MAX_CARRIERS>          cell_info = {}; ///< Cell information, indexed by ue_cell_idx
+    mutable srsran::circular_array<std::mutex, TTIMOD_SZ> tti_mutex;      ///< Protects the TTI slot dynamic fields
+    mutable std::mutex                                    ue_mutex;       ///< Protects last_ri and last_tb
   };
 
   /**
@@ -109,9 +118,10 @@ private:
   std::map<uint16_t, common_ue> ue_db;
 
   /**
-   * Concurrency protection mutex, allowed modifications from const methods.
+   * Concurrency protection read/write lock. Adding, removing and configuring UEs take it for writing, the per-TTI
+   * accessors from the workers take it for reading.
    */
-  mutable std::mutex mutex;
+  mutable pthread_rwlock_t rwlock = {};
 
   /**
    * Stack interface
@@ -175,6 +185,15 @@ private:
    */
   uint32_t _get_uci_enb_cc_idx(uint32_t tti, uint16_t rnti) const;
 
+  /**
+   * Reads the last rank indicator reported for a serving cell, it takes the UE mutex
+   *
+   * @param ue the UE database entry (requires assertion prior to call)
+   * @param ue_cc_idx the serving cell index
+   * @return the last reported rank indicator
+   */
+  inline uint8_t _get_last_ri(const common_ue& ue, uint32_t ue_cc_idx) const;
+
   /**
    * Checks if a given RNTI exists in the database
    * @param rnti provides UE identifier
@@ -245,6 +264,11 @@ private:
   inline uint32_t _count_nof_configured_scell(uint16_t rnti);
 
 public:
+  phy_ue_db();
+  ~phy_ue_db();
+  phy_ue_db(const phy_ue_db&) = delete;
+  phy_ue_db& operator=(const phy_ue_db&) = delete;
+
   /**
    * Initialises the UE database with the stack and cell list
    * @param stack_ptr points to the stack (read/write)
@@ -33,6 +33,8 @@ namespace srsenb {
 typedef struct {
   bool        enable;
   std::string filename;
+  int         compression_level; // zstd level, 0 writes plain PCAPs
+  uint32_t    max_pdu_len;       // Captured bytes of each user-plane PDU, 0 captures whole PDUs
 } pcap_args_t;
 
 typedef struct {
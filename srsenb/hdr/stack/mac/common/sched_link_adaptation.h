@@ -0,0 +1,74 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_SCHED_LINK_ADAPTATION_H
+#define SRSRAN_SCHED_LINK_ADAPTATION_H
+
+#include <algorithm>
+
+namespace srsenb {
+
+/**
+ * Outer loop link adaptation (OLLA), shared by the LTE and NR schedulers.
+ * Keeps an offset to the reported channel quality (e.g. CQI or SNR) that converges to the value that achieves the
+ * target BLER. Each ACK increases the offset by delta_up and each NACK decreases it by
+ * delta_down = (1 - target_bler) * delta_up / target_bler. A target_bler of 0 disables the adaptation.
+ */
+class outer_loop_link_adaptation
+{
+public:
+  outer_loop_link_adaptation() = default;
+  outer_loop_link_adaptation(float target_bler_, float step_size, float max_offset_) :
+    target_bler(target_bler_), delta_up(step_size), max_offset(max_offset_)
+  {
+    if (enabled()) {
+      delta_down = (1 - target_bler) * delta_up / target_bler;
+    }
+  }
+
+  bool  enabled() const { return target_bler > 0; }
+  float offset() const { return offset_; }
+  void  reset() { offset_ = 0; }
+
+  /// Updates the offset with the HARQ outcome of a transmission that used the given MCS
+  void update(bool ack, int mcs, int max_mcs)
+  {
+    if (not enabled()) {
+      return;
+    }
+    // Note: Avoid increasing (decreasing) the offset further if the MCS is already at its upper (lower) limit
+    float delta_down_eff = mcs <= 0 ? 0 : delta_down;
+    float delta_up_eff   = mcs >= max_mcs ? 0 : delta_up;
+    offset_ += ack ? delta_up_eff : -delta_down_eff;
+    offset_ = std::min(std::max(-max_offset, offset_), max_offset);
+  }
+
+private:
+  float target_bler = 0;
+  float delta_up    = 0;
+  float delta_down  = 0;
+  float max_offset  = 0;
+  float offset_     = 0;
+};
+
+} // namespace srsenb
+
+#endif // SRSRAN_SCHED_LINK_ADAPTATION_H
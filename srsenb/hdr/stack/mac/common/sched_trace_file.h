@@ -0,0 +1,264 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_SCHED_TRACE_FILE_H
+#define SRSRAN_SCHED_TRACE_FILE_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace srsenb {
+
+/**
+ * Binary trace of the inputs of a scheduler, used to reproduce scheduling hotspots offline.
+ *
+ * The file starts with a header that identifies the RAT and the layout of the traced structs, followed by one record
+ * per scheduler API call. A record is made of its type, the length of the payload and the payload, which contains the
+ * arguments of the call. Trivially copyable arguments are stored as raw bytes, so a trace can only be replayed by
+ * builds where the scheduler interface structs have the same layout.
+ */
+enum class sched_trace_rat : uint32_t { lte = 0, nr = 1 };
+
+struct sched_trace_record {
+  uint32_t             type = 0;
+  std::vector<uint8_t> payload;
+};
+
+/// Appends the arguments of a scheduler call to a record payload
+class sched_trace_encoder
+{
+public:
+  explicit sched_trace_encoder(std::vector<uint8_t>& buffer_) : buffer(buffer_) {}
+
+  void pack_bytes(const void* data, size_t len)
+  {
+    size_t pos = buffer.size();
+    buffer.resize(pos + len);
+    memcpy(buffer.data() + pos, data, len);
+  }
+
+private:
+  std::vector<uint8_t>& buffer;
+};
+
+/// Extracts the arguments of a scheduler call from a record payload
+class sched_trace_decoder
+{
+public:
+  explicit sched_trace_decoder(const std::vector<uint8_t>& buffer) : ptr(buffer.data()), end(ptr + buffer.size()) {}
+
+  bool unpack_bytes(void* data, size_t len)
+  {
+    if (static_cast<size_t>(end - ptr) < len) {
+      return false;
+    }
+    memcpy(data, ptr, len);
+    ptr += len;
+    return true;
+  }
+
+  bool empty() const { return ptr == end; }
+
+private:
+  const uint8_t* ptr;
+  const uint8_t* end;
+};
+
+template <typename T>
+typename std::enable_if<std::is_trivially_copyable<T>::value>::type sched_trace_pack(sched_trace_encoder& enc,
+                                                                                       const T&             v)
+{
+  enc.pack_bytes(&v, sizeof(T));
+}
+
+template <typename T>
+typename std::enable_if<std::is_trivially_copyable<T>::value, bool>::type sched_trace_unpack(sched_trace_decoder& dec,
+                                                                                               T&                   v)
+{
+  return dec.unpack_bytes(&v, sizeof(T));
+}
+
+inline void sched_trace_pack(sched_trace_encoder& enc, const std::string& s)
+{
+  sched_trace_pack(enc, static_cast<uint32_t>(s.size()));
+  enc.pack_bytes(s.data(), s.size());
+}
+
+inline bool sched_trace_unpack(sched_trace_decoder& dec, std::string& s)
+{
+  uint32_t len = 0;
+  if (not sched_trace_unpack(dec, len)) {
+    return false;
+  }
+  s.resize(len);
+  return dec.unpack_bytes(&s[0], len);
+}
+
+template <typename T>
+void sched_trace_pack(sched_trace_encoder& enc, const std::vector<T>& vec)
+{
+  sched_trace_pack(enc, static_cast<uint32_t>(vec.size()));
+  for (const T& v : vec) {
+    sched_trace_pack(enc, v);
+  }
+}
+
+template <typename T>
+bool sched_trace_unpack(sched_trace_decoder& dec, std::vector<T>& vec)
+{
+  uint32_t len = 0;
+  if (not sched_trace_unpack(dec, len)) {
+    return false;
+  }
+  vec.resize(len);
+  for (T& v : vec) {
+    if (not sched_trace_unpack(dec, v)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+inline void sched_trace_pack_all(sched_trace_encoder& enc) {}
+
+template <typename T, typename... Args>
+void sched_trace_pack_all(sched_trace_encoder& enc, const T& v, const Args&... args)
+{
+  sched_trace_pack(enc, v);
+  sched_trace_pack_all(enc, args...);
+}
+
+inline bool sched_trace_unpack_all(sched_trace_decoder& dec)
+{
+  return true;
+}
+
+template <typename T, typename... Args>
+bool sched_trace_unpack_all(sched_trace_decoder& dec, T& v, Args&... args)
+{
+  return sched_trace_unpack(dec, v) and sched_trace_unpack_all(dec, args...);
+}
+
+/// Writes the records of a scheduler trace. Records can be written concurrently, and are stored in call order
+class sched_trace_writer
+{
+public:
+  sched_trace_writer() = default;
+  sched_trace_writer(const sched_trace_writer&) = delete;
+  sched_trace_writer& operator=(const sched_trace_writer&) = delete;
+  ~sched_trace_writer() { close(); }
+
+  bool open(const std::string& filename, sched_trace_rat rat, uint32_t layout_signature);
+  void close();
+  bool is_open() const { return enabled.load(std::memory_order_relaxed); }
+
+  template <typename... Args>
+  void write(uint32_t type, const Args&... args)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (file == nullptr) {
+      return;
+    }
+    // Reserve the record header, its length is only known once the arguments are packed
+    size_t hdr_pos = buffer.size();
+    buffer.resize(hdr_pos + sizeof(record_header_t));
+    sched_trace_encoder enc(buffer);
+    sched_trace_pack_all(enc, args...);
+    record_header_t hdr{type, static_cast<uint32_t>(buffer.size() - hdr_pos - sizeof(record_header_t))};
+    memcpy(buffer.data() + hdr_pos, &hdr, sizeof(hdr));
+
+    if (buffer.size() >= flush_threshold) {
+      flush();
+    }
+  }
+
+  /// Writes the buffered records to the file
+  void flush();
+
+private:
+  friend class sched_trace_reader;
+
+  struct file_header_t {
+    char     magic[8];
+    uint32_t version;
+    uint32_t rat;
+    uint32_t layout_signature;
+  };
+  struct record_header_t {
+    uint32_t type;
+    uint32_t len;
+  };
+
+  static const char     file_magic[8];
+  static const uint32_t file_version    = 1;
+  static const size_t   flush_threshold = 64 * 1024;
+
+  std::mutex           mutex;
+  FILE*                file = nullptr;
+  std::atomic<bool>    enabled{false};
+  std::vector<uint8_t> buffer;
+};
+
+/// Reads the records of a scheduler trace, in the order they were written
+class sched_trace_reader
+{
+public:
+  sched_trace_reader() = default;
+  sched_trace_reader(const sched_trace_reader&) = delete;
+  sched_trace_reader& operator=(const sched_trace_reader&) = delete;
+  ~sched_trace_reader() { close(); }
+
+  /// Opens a trace and checks its header. Returns false if the file is not a scheduler trace
+  bool open(const std::string& filename);
+  void close();
+
+  sched_trace_rat get_rat() const { return rat; }
+  uint32_t        get_layout_signature() const { return layout_signature; }
+
+  /// Reads the next record. Returns false at the end of the trace or if the last record is truncated
+  bool read(sched_trace_record& record);
+
+private:
+  FILE*           file             = nullptr;
+  sched_trace_rat rat              = sched_trace_rat::lte;
+  uint32_t        layout_signature = 0;
+};
+
+/// Combines the sizes of the traced types into a signature of their layout
+template <typename... Args>
+uint32_t sched_trace_layout_signature()
+{
+  uint32_t sig = 0;
+  for (size_t size : {sizeof(Args)...}) {
+    sig = sig * 31 + static_cast<uint32_t>(size);
+  }
+  return sig;
+}
+
+} // namespace srsenb
+
+#endif // SRSRAN_SCHED_TRACE_FILE_H
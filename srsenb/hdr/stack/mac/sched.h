@@ -24,11 +24,14 @@
 
 #include "sched_grid.h"
 #include "sched_interface.h"
+#include "sched_trace.h"
 #include "sched_ue.h"
 #include "srsenb/hdr/common/common_enb.h"
+#include "srsran/common/task_graph.h"
 #include <atomic>
 #include <map>
 #include <mutex>
+#include <pthread.h>
 
 namespace srsenb {
 
@@ -94,10 +97,14 @@ public:
 
 protected:
   void new_tti(srsran::tti_point tti_rx);
+  void generate_carriers(srsran::tti_point tti_rx, uint32_t cc_mask);
   bool is_generated(srsran::tti_point, uint32_t enb_cc_idx) const;
   // Helper methods
   template <typename Func>
   int ue_db_access_locked(uint16_t rnti, Func&& f, const char* func_name = nullptr, bool log_fail = true);
+  // Same as ue_db_access_locked(), for callers that already hold sched_mutex
+  template <typename Func>
+  int ue_db_access(uint16_t rnti, Func&& f, const char* func_name = nullptr, bool log_fail = true);
 
   // args
   rrc_interface_mac*               rrc       = nullptr;
@@ -112,9 +119,20 @@ protected:
   // Storage of past scheduling results
   sched_result_ringbuffer sched_results;
 
+  // Runs the scheduling of carriers that do not share UEs in parallel
+  std::unique_ptr<srsran::task_graph_executor> carrier_executor;
+  srsran::task_graph                           carrier_graph{SRSRAN_MAX_CARRIERS};
+
+  // Records the calls to the scheduler API, if enabled by sched_args_t::trace_filename. The calls are recorded while
+  // holding sched_mutex, so that the trace keeps the order in which the scheduler processes them
+  sched_trace_recorder trace;
+
   srsran::tti_point last_tti;
   std::mutex        sched_mutex;
-  bool              configured;
+  // Protects the insertion and removal of UEs, so that buffer state reports can reach a UE without sched_mutex.
+  // Writers must hold sched_mutex too
+  pthread_rwlock_t ue_db_rwlock;
+  bool             configured;
 };
 
 } // namespace srsenb
@@ -80,6 +80,8 @@ public:
     int         init_dl_cqi               = 5;
     float       max_sib_coderate          = 0.8;
     int         pdcch_cqi_offset          = 0;
+    uint32_t    nof_carrier_threads       = 0;
+    std::string trace_filename            = ""; ///< If not empty, file where the scheduler inputs are recorded
   };
 
   struct cell_cfg_t {
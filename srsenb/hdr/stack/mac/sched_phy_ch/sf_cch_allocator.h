@@ -21,6 +21,7 @@
 
 #include "../sched_lte_common.h"
 #include "sched_result.h"
+#include <array>
 
 #ifndef SRSRAN_PDCCH_SCHED_H
 #define SRSRAN_PDCCH_SCHED_H
@@ -34,6 +35,13 @@ class sf_cch_allocator
 {
 public:
   const static uint32_t MAX_CFI = 3;
+  /// Maximum number of DCIs allocated per TTI, enough for a crowded PDCCH of DL and UL grants
+  const static uint32_t MAX_NOF_ALLOCS = 64;
+  /// Maximum number of DFS nodes visited per CFI while searching a solution for a new DCI. Bounds the backtracking
+  /// cost when the PDCCH is crowded with many UEs
+  const static uint32_t MAX_DFS_NODE_VISITS = 16;
+  /// CCE occupancy mask with one bit per CCE, stored in machine words for fast collision checks
+  using cce_word_mask_t = std::array<uint64_t, (MAX_NOF_CCES + 63) / 64>;
   struct tree_node {
     int8_t                pucch_n_prb = -1; ///< this PUCCH resource identifier
     uint16_t              rnti        = SRSRAN_INVALID_RNTI;
@@ -43,8 +51,10 @@ public:
     /// Accumulation of all PDCCH masks for the current solution (DFS path)
     pdcch_mask_t total_mask, current_mask;
     prbmask_t    total_pucch_mask;
+    /// Word-level copy of total_mask used for the collision checks
+    cce_word_mask_t total_cce_words = {};
   };
-  using alloc_result_t = srsran::bounded_vector<const tree_node*, 16>;
+  using alloc_result_t = srsran::bounded_vector<const tree_node*, MAX_NOF_ALLOCS>;
 
   sf_cch_allocator() : logger(srslog::fetch_basic_logger("MAC")) {}
 
@@ -92,6 +102,7 @@ private:
   tti_point                 tti_rx;
   uint32_t                  current_cfix     = 0;
   uint32_t                  current_max_cfix = 0;
+  uint32_t                  nof_node_visits  = 0; ///< DFS nodes visited for the current CFI
   std::vector<tree_node>    last_dci_dfs, temp_dci_dfs;
   std::vector<alloc_record> dci_record_list; ///< Keeps a record of all the PDCCH allocations done so far
 };
@@ -0,0 +1,131 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSENB_SCHED_TRACE_H
+#define SRSENB_SCHED_TRACE_H
+
+#include "sched_interface.h"
+#include "srsenb/hdr/stack/mac/common/sched_trace_file.h"
+#include "srsran/srslog/bundled/fmt/format.h"
+
+namespace srsenb {
+
+class rrc_interface_mac;
+class sched;
+
+/// Scheduler API calls stored in the LTE scheduler traces
+enum class sched_trace_event : uint32_t {
+  init,
+  cell_cfg,
+  reset,
+  ue_cfg,
+  ue_rem,
+  phy_config_enabled,
+  bearer_ue_cfg,
+  bearer_ue_rem,
+  dl_rlc_buffer_state,
+  dl_mac_buffer_state,
+  dl_ack_info,
+  dl_rach_info,
+  dl_ri_info,
+  dl_pmi_info,
+  dl_cqi_info,
+  dl_sb_cqi_info,
+  ul_crc_info,
+  ul_sr_info,
+  ul_bsr,
+  ul_buffer_add,
+  ul_phr,
+  ul_snr_info,
+  dl_sched,
+  ul_sched,
+  set_pdcch_order,
+  set_dl_tti_mask,
+  nof_events
+};
+
+void sched_trace_pack(sched_trace_encoder& enc, const sched_interface::sched_args_t& args);
+bool sched_trace_unpack(sched_trace_decoder& dec, sched_interface::sched_args_t& args);
+void sched_trace_pack(sched_trace_encoder& enc, const sched_interface::cell_cfg_t& cfg);
+bool sched_trace_unpack(sched_trace_decoder& dec, sched_interface::cell_cfg_t& cfg);
+void sched_trace_pack(sched_trace_encoder& enc, const sched_interface::ue_cfg_t& cfg);
+bool sched_trace_unpack(sched_trace_decoder& dec, sched_interface::ue_cfg_t& cfg);
+
+/// Signature of the layout of the structs stored as raw bytes in the LTE traces
+uint32_t sched_trace_lte_signature();
+
+/// Records the calls to the scheduler API in a trace file. Recording is disabled until open() succeeds
+class sched_trace_recorder
+{
+public:
+  bool open(const std::string& filename)
+  {
+    return writer.open(filename, sched_trace_rat::lte, sched_trace_lte_signature());
+  }
+  void close() { writer.close(); }
+  bool is_open() const { return writer.is_open(); }
+
+  template <typename... Args>
+  void record(sched_trace_event ev, const Args&... args)
+  {
+    if (writer.is_open()) {
+      writer.write(static_cast<uint32_t>(ev), args...);
+    }
+  }
+
+private:
+  sched_trace_writer writer;
+};
+
+/// Calls the scheduler API as described by the records of a trace
+class sched_trace_player
+{
+public:
+  sched_trace_player(sched& sched_obj_, rrc_interface_mac* rrc_) : sched_obj(sched_obj_), rrc(rrc_) {}
+
+  /// Replays a recorded call. Returns false if the record cannot be decoded
+  bool play(const sched_trace_record& record);
+
+  // Last replayed call and, for dl_sched and ul_sched, its result
+  sched_trace_event               event      = sched_trace_event::nof_events;
+  uint32_t                        tti        = 0;
+  uint32_t                        enb_cc_idx = 0;
+  sched_interface::dl_sched_res_t dl_result;
+  sched_interface::ul_sched_res_t ul_result;
+
+private:
+  sched&             sched_obj;
+  rrc_interface_mac* rrc;
+};
+
+/// Describes the decisions of a DL or UL scheduling result in a single line, to compare the decisions of two runs
+void sched_trace_fmt_dl_result(fmt::memory_buffer&                    buffer,
+                               uint32_t                               tti,
+                               uint32_t                               enb_cc_idx,
+                               const sched_interface::dl_sched_res_t& result);
+void sched_trace_fmt_ul_result(fmt::memory_buffer&                    buffer,
+                               uint32_t                               tti,
+                               uint32_t                               enb_cc_idx,
+                               const sched_interface::ul_sched_res_t& result);
+
+} // namespace srsenb
+
+#endif // SRSENB_SCHED_TRACE_H
@@ -29,6 +29,8 @@
 #include "srsenb/hdr/common/common_enb.h"
 #include "srsenb/hdr/stack/mac/common/mac_metrics.h"
 #include "srsran/srslog/srslog.h"
+#include <array>
+#include <atomic>
 #include <bitset>
 #include <map>
 #include <vector>
@@ -62,6 +64,11 @@ public:
 
   void dl_buffer_state(uint8_t lc_id, uint32_t tx_queue, uint32_t retx_queue);
   void ul_buffer_state(uint8_t lcg_id, uint32_t bsr);
+  /// Lock-free versions of dl_buffer_state and ul_buffer_state, safe to call while the UE is being scheduled. Only the
+  /// last report of each LCID/LCG is kept, and it takes effect in the next call to apply_pending_buffer_states()
+  bool push_dl_buffer_state(uint8_t lc_id, uint32_t tx_queue, uint32_t retx_queue);
+  bool push_ul_buffer_state(uint8_t lcg_id, uint32_t bsr);
+  void apply_pending_buffer_states();
   void ul_phr(int phr, uint32_t grant_nof_prb);
   void mac_buffer_state(uint32_t ce_code, uint32_t nof_cmds);
 
@@ -211,6 +218,14 @@ private:
   bool           sr = false;
   lch_ue_manager lch_handler;
 
+  /* Buffer states reported without the scheduler lock. Each DL slot packs the tx and retx queues. A slot without a
+   * report to apply holds the no_pending value, which is swapped back in when the report is taken */
+  constexpr static uint64_t no_pending_dl_bs  = UINT64_MAX;
+  constexpr static uint32_t no_pending_ul_bsr = UINT32_MAX;
+
+  std::array<std::atomic<uint64_t>, sched_interface::MAX_LC>       pending_dl_bs;
+  std::array<std::atomic<uint32_t>, sched_interface::MAX_LC_GROUP> pending_ul_bsr;
+
   uint32_t cqi_request_tti = 0;
   uint16_t rnti            = 0;
   uint32_t max_msg3retx    = 0;
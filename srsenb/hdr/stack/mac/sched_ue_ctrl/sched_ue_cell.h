@@ -25,6 +25,7 @@
 #include "../sched_lte_common.h"
 #include "sched_dl_cqi.h"
 #include "sched_harq.h"
+#include "srsenb/hdr/stack/mac/common/sched_link_adaptation.h"
 #include "srsenb/hdr/stack/mac/sched_phy_ch/sched_dci.h"
 #include "tpc.h"
 
@@ -52,8 +53,8 @@ struct sched_ue_cell {
   const ue_cc_cfg* get_ue_cc_cfg() const { return configured() ? &ue_cfg->supported_cc_list[ue_cc_idx] : nullptr; }
   const sched_interface::ue_cfg_t* get_ue_cfg() const { return configured() ? ue_cfg : nullptr; }
   cc_st                            cc_state() const { return cc_state_; }
-  float                            get_ul_snr_offset() const { return ul_snr_coeff; }
-  float                            get_dl_cqi_offset() const { return dl_cqi_coeff; }
+  float                            get_ul_snr_offset() const { return ul_olla.offset(); }
+  float                            get_dl_cqi_offset() const { return dl_olla.offset(); }
 
   int get_dl_cqi() const;
   int get_dl_cqi(const rbgmask_t& rbgs) const;
@@ -104,11 +105,8 @@ private:
   tti_point current_tti;
   cc_st     cc_state_ = cc_st::idle;
 
-  // CQI
-  float ul_delta_inc = 0, ul_delta_dec = 0;
-  float dl_delta_inc = 0, dl_delta_dec = 0;
-  float dl_cqi_coeff = 0, ul_snr_coeff = 0;
-  float max_cqi_coeff = -5, max_snr_coeff = 5;
+  // CQI and SNR offsets derived from the HARQ outcomes
+  outer_loop_link_adaptation dl_olla, ul_olla;
 
   sched_dl_cqi dl_cqi_ctxt;
 };
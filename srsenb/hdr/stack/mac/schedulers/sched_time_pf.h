@@ -25,10 +25,17 @@
 #include "sched_base.h"
 #include "srsenb/hdr/common/common_enb.h"
 #include "srsran/adt/circular_map.h"
-#include <queue>
+#include "srsran/adt/indexed_heap.h"
 
 namespace srsenb {
 
+/**
+ * Proportional fair scheduler. The UEs are kept in DL and UL heaps ordered by their PF metric r / R^fairness_coeff,
+ * where r is the rate expected from the last CQI and R the exponentially averaged allocated rate. The heaps are not
+ * rebuilt every TTI. The metric of a UE is only updated when its CQI changes or when it gets an allocation, as the
+ * averaged rate of the UEs without allocation is decayed through a common scale factor. During the first 1 / avg_alpha
+ * TTIs of a UE its averaged rate is the plain mean of its allocations, as the exponential average would start from 0.
+ */
 class sched_time_pf final : public sched_base
 {
   using ue_cit_t = sched_ue_list::const_iterator;
@@ -43,53 +50,63 @@ private:
 
   const sched_cell_params_t* cc_cfg         = nullptr;
   float                      fairness_coeff = 1;
+  float                      avg_alpha      = 0.01; ///< Exponential average coefficient of the allocated rates
+  uint32_t                   warmup_ttis    = 100;  ///< First TTIs of a UE, averaged with a plain mean
 
   srsran::tti_point current_tti_rx;
 
+  // The averaged rates are stored multiplied by rate_scale, which grows by 1 / (1 - avg_alpha) every TTI
+  double rate_scale = 1;
+
   struct ue_ctxt {
-    ue_ctxt(uint16_t rnti_, float fairness_coeff_) : rnti(rnti_), fairness_coeff(fairness_coeff_) {}
-    float    dl_avg_rate() const { return dl_nof_samples == 0 ? 0 : dl_avg_rate_; }
-    float    ul_avg_rate() const { return ul_nof_samples == 0 ? 0 : ul_avg_rate_; }
-    uint32_t dl_count() const { return dl_nof_samples; }
-    uint32_t ul_count() const { return ul_nof_samples; }
-    void     new_tti(const sched_cell_params_t& cell, sched_ue& ue, sf_sched* tti_sched);
-    void     save_dl_alloc(uint32_t alloc_bytes, float alpha);
-    void     save_ul_alloc(uint32_t alloc_bytes, float alpha);
+    explicit ue_ctxt(uint16_t rnti_) : rnti(rnti_) {}
+    void   new_tti(const sched_cell_params_t& cell, sched_ue& ue, sf_sched* tti_sched);
+    double dl_metric(float fairness_coeff) const;
+    double ul_metric(float fairness_coeff) const;
 
     const uint16_t rnti;
-    const float    fairness_coeff;
-
-    int                 ue_cc_idx  = 0;
-    float               dl_prio    = 0;
-    float               ul_prio    = 0;
-    const dl_harq_proc* dl_retx_h  = nullptr;
-    const dl_harq_proc* dl_newtx_h = nullptr;
-    const ul_harq_proc* ul_h       = nullptr;
-
-  private:
-    float    dl_avg_rate_   = 0;
-    float    ul_avg_rate_   = 0;
-    uint32_t dl_nof_samples = 0;
-    uint32_t ul_nof_samples = 0;
+
+    int                 ue_cc_idx = -1;
+    const dl_harq_proc* dl_retx_h = nullptr;
+    const ul_harq_proc* ul_retx_h = nullptr;
+
+    // Rates expected from the last CQI, and the CQIs they were derived from
+    int   dl_cqi  = -1;
+    int   ul_cqi  = -1;
+    float dl_rate = 0;
+    float ul_rate = 0;
+
+    // Scaled exponential average of the allocated bytes per TTI
+    double dl_avg_rate = 0;
+    double ul_avg_rate = 0;
+
+    // Fast start: during its first warmup_ttis TTIs, the average of a UE is the mean of its allocated bytes
+    uint32_t nof_samples = 0;
+    double   dl_sum      = 0;
+    double   ul_sum      = 0;
   };
 
   rnti_map_t<ue_ctxt> ue_history_db;
 
-  struct ue_dl_prio_compare {
-    bool operator()(const ue_ctxt* lhs, const ue_ctxt* rhs) const;
-  };
-  struct ue_ul_prio_compare {
-    bool operator()(const ue_ctxt* lhs, const ue_ctxt* rhs) const;
-  };
+  // The index of a UE in the heaps is its position in ue_history_db
+  using ue_heap_t = srsran::indexed_heap<double>;
+  ue_heap_t dl_heap{SRSENB_MAX_UES};
+  ue_heap_t ul_heap{SRSENB_MAX_UES};
 
-  using ue_dl_queue_t = std::priority_queue<ue_ctxt*, std::vector<ue_ctxt*>, ue_dl_prio_compare>;
-  using ue_ul_queue_t = std::priority_queue<ue_ctxt*, std::vector<ue_ctxt*>, ue_ul_prio_compare>;
+  // UEs with pending retransmissions in the current TTI, served before the new transmissions
+  srsran::bounded_vector<ue_ctxt*, SRSENB_MAX_UES> dl_retx_list;
+  srsran::bounded_vector<ue_ctxt*, SRSENB_MAX_UES> ul_retx_list;
+  // UEs popped from the heaps in the current TTI, inserted back once their allocation is saved
+  srsran::bounded_vector<ue_ctxt*, SRSENB_MAX_UES> popped_list;
+  std::array<ue_ctxt*, SRSENB_MAX_UES>             ue_by_index = {};
 
-  ue_dl_queue_t dl_queue;
-  ue_ul_queue_t ul_queue;
+  static uint32_t heap_index(uint16_t rnti) { return rnti % SRSENB_MAX_UES; }
 
+  void     save_dl_alloc(ue_ctxt& ue, uint32_t alloc_bytes);
+  void     save_ul_alloc(ue_ctxt& ue, uint32_t alloc_bytes);
+  void     rescale_rates();
   uint32_t try_dl_alloc(ue_ctxt& ue_ctxt, sched_ue& ue, sf_sched* tti_sched);
-  uint32_t try_ul_alloc(ue_ctxt& ue_ctxt, sched_ue& ue, sf_sched* tti_sched);
+  uint32_t try_ul_alloc(ue_ctxt& ue_ctxt, sched_ue& ue, sf_sched* tti_sched, const ul_harq_proc* h);
 };
 
 } // namespace srsenb
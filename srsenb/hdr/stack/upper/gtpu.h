@@ -27,6 +27,7 @@
 #include "srsran/adt/bounded_vector.h"
 #include "srsran/adt/circular_map.h"
 #include "srsran/common/buffer_pool.h"
+#include "srsran/common/byte_buffer_chain.h"
 #include "srsran/common/network_utils.h"
 #include "srsran/common/task_scheduler.h"
 #include "srsran/common/threads.h"
@@ -50,9 +51,10 @@ class pdcp_interface_gtpu;
 class gtpu_tunnel_manager
 {
   // Buffer used to store SDUs while PDCP is still getting configured during handover.
-  // Note: The buffer cannot be too large, otherwise it risks depleting the byte buffer pool.
+  // Note: The SDUs are kept in chains, so they only take the segments they need rather than a full byte buffer each.
+  // The list is too large for a byte buffer pool block, so it is allocated from the heap at handover.
   const static size_t BUFFER_SIZE = 512;
-  using buffered_sdu_list = srsran::bounded_vector<std::pair<uint32_t, srsran::unique_byte_buffer_t>, BUFFER_SIZE>;
+  using buffered_sdu_list = srsran::bounded_vector<std::pair<uint32_t, srsran::byte_buffer_chain>, BUFFER_SIZE>;
 
   static const uint32_t undefined_pdcp_sn = std::numeric_limits<uint32_t>::max();
 
@@ -69,11 +71,11 @@ public:
     uint32_t teid_out      = 0;
     uint32_t spgw_addr     = 0;
 
-    tunnel_state                                    state = tunnel_state::pdcp_active;
-    srsran::unique_timer                            rx_timer;
-    srsran::byte_buffer_pool_ptr<buffered_sdu_list> buffer;
-    tunnel*                                         fwd_tunnel = nullptr; ///< forward Rx SDUs to this TEID
-    srsran::move_callback<void()>                   on_removal;
+    tunnel_state                       state = tunnel_state::pdcp_active;
+    srsran::unique_timer               rx_timer;
+    std::unique_ptr<buffered_sdu_list> buffer;
+    tunnel*                            fwd_tunnel = nullptr; ///< forward Rx SDUs to this TEID
+    srsran::move_callback<void()>      on_removal;
 
     tunnel()                  = default;
     tunnel(tunnel&&) noexcept = default;
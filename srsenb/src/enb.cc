@@ -212,6 +212,7 @@ bool enb::get_metrics(enb_metrics_t* m)
   }
   radio->get_metrics(&m->rf);
   phy->get_metrics(m->phy);
+  phy->get_timing_metrics(m->phy_timing);
   if (eutra_stack) {
     eutra_stack->get_metrics(&m->stack);
   }
@@ -1804,8 +1804,10 @@ int set_derived_args_nr(all_args_t* args_, rrc_nr_cfg_t* rrc_nr_cfg_, phy_cfg_t*
   }
 
   // MAC-NR PCAP options
-  args_->nr_stack.mac.pcap.enable = args_->stack.mac_pcap.enable;
-  args_->nr_stack.log             = args_->stack.log;
+  args_->nr_stack.mac.pcap.enable            = args_->stack.mac_pcap.enable;
+  args_->nr_stack.mac.pcap.compression_level = args_->stack.mac_pcap.compression_level;
+  args_->nr_stack.mac.pcap.max_pdu_len       = args_->stack.mac_pcap.max_pdu_len;
+  args_->nr_stack.log                        = args_->stack.log;
 
   // Sanity check for unsupported/untested configuration
   for (auto& cfg : rrc_nr_cfg_->cell_list) {
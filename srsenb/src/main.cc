@@ -31,6 +31,7 @@
 #include "srsran/common/crash_handler.h"
 #include "srsran/common/tsan_options.h"
 #include "srsran/srslog/event_trace.h"
+#include "srsran/srslog/span_trace.h"
 #include "srsran/srslog/srslog.h"
 #include "srsran/support/emergency_handlers.h"
 #include "srsran/support/signal_handler.h"
@@ -140,6 +141,8 @@ void parse_args(all_args_t* args, int argc, char* argv[])
 
     ("log.filename",      bpo::value<string>(&args->log.filename)->default_value("/tmp/ue.log"),"Log filename")
     ("log.file_max_size", bpo::value<int>(&args->log.file_max_size)->default_value(-1), "Maximum file size (in kilobytes). When passed, multiple files are created. Default -1 (single file)")
+    ("log.binary",        bpo::value<bool>(&args->log.binary)->default_value(false), "Write the log file unformatted, to be converted to text with srslog_decoder")
+    ("log.async",         bpo::value<bool>(&args->log.async)->default_value(false), "Write the log file in the background, using io_uring when available")
 
     /* PCAP */
     ("pcap.enable",    bpo::value<bool>(&args->stack.mac_pcap.enable)->default_value(false),         "Enable MAC packet captures for wireshark")
@@ -149,6 +152,8 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("pcap.s1ap_filename", bpo::value<string>(&args->stack.s1ap_pcap.filename)->default_value("/tmp/enb_s1ap.pcap"), "S1AP layer capture filename")
     ("pcap.ngap_enable",   bpo::value<bool>(&args->nr_stack.ngap_pcap.enable)->default_value(false),         "Enable NGAP packet captures for wireshark")
     ("pcap.ngap_filename", bpo::value<string>(&args->nr_stack.ngap_pcap.filename)->default_value("/tmp/enb_ngap.pcap"), "NGAP layer capture filename")
+    ("pcap.compression_level", bpo::value<int>(&args->stack.mac_pcap.compression_level)->default_value(0), "zstd compression level of the packet captures (0 writes plain PCAPs)")
+    ("pcap.max_pdu_len", bpo::value<uint32_t>(&args->stack.mac_pcap.max_pdu_len)->default_value(0), "Captured bytes of each MAC user-plane PDU (0 captures whole PDUs)")
     ("pcap.mac_net_enable", bpo::value<bool>(&args->stack.mac_pcap_net.enable)->default_value(false),         "Enable MAC network captures")
     ("pcap.bind_ip", bpo::value<string>(&args->stack.mac_pcap_net.bind_ip)->default_value("0.0.0.0"),         "Bind IP address for MAC network trace")
     ("pcap.bind_port", bpo::value<uint16_t>(&args->stack.mac_pcap_net.bind_port)->default_value(5687),        "Bind port for MAC network trace")
@@ -180,6 +185,8 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("scheduler.init_dl_cqi", bpo::value<int>(&args->stack.mac.sched.init_dl_cqi)->default_value(5), "DL CQI value used before any CQI report is available to the eNB")
     ("scheduler.max_sib_coderate", bpo::value<float>(&args->stack.mac.sched.max_sib_coderate)->default_value(0.8), "Upper bound on SIB and RAR grants coderate")
     ("scheduler.pdcch_cqi_offset", bpo::value<int>(&args->stack.mac.sched.pdcch_cqi_offset)->default_value(0), "CQI offset in derivation of PDCCH aggregation level")
+    ("scheduler.nof_carrier_threads", bpo::value<uint32_t>(&args->stack.mac.sched.nof_carrier_threads)->default_value(0), "Number of threads scheduling independent carriers in parallel (0 schedules them sequentially)")
+    ("scheduler.trace_filename", bpo::value<string>(&args->stack.mac.sched.trace_filename)->default_value(""), "File where the scheduler inputs are recorded for offline replay (empty disables it)")
 
 
 
@@ -239,6 +246,10 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("expert.pusch_meas_evm", bpo::value<bool>(&args->phy.pusch_meas_evm)->default_value(false), "Enable/Disable PUSCH EVM measure.")
     ("expert.tx_amplitude", bpo::value<float>(&args->phy.tx_amplitude)->default_value(0.6), "Transmit amplitude factor.")
     ("expert.nof_phy_threads", bpo::value<uint32_t>(&args->phy.nof_phy_threads)->default_value(3), "Number of PHY threads.")
+    ("expert.nof_phy_task_threads", bpo::value<uint32_t>(&args->phy.nof_task_threads)->default_value(0), "Number of threads helping the PHY threads with the carrier UL/DL processing of each TTI.")
+    ("expert.phy_task_cpu_mask", bpo::value<uint32_t>(&args->phy.task_cpu_mask)->default_value(255), "CPU mask for pinning the PHY task threads, one CPU per thread. 255 leaves them unpinned.")
+    ("expert.phy_tti_deadline_us", bpo::value<uint32_t>(&args->phy.tti_deadline_us)->default_value(3000), "Time available for processing a TTI since its reception. Late TTIs are counted in the metrics.")
+    ("expert.phy_tti_ul_deadline_us", bpo::value<uint32_t>(&args->phy.tti_ul_deadline_us)->default_value(4000), "Time available for the UL decoding of a TTI since its reception. NR decodes the UL after transmitting the DL, LTE needs it before the scheduling and it is also bounded by phy_tti_deadline_us.")
     ("expert.nof_prach_threads", bpo::value<uint32_t>(&args->phy.nof_prach_threads)->default_value(1), "Number of PRACH workers per carrier. Only 1 or 0 is supported.")
     ("expert.max_prach_offset_us", bpo::value<float>(&args->phy.max_prach_offset_us)->default_value(30), "Maximum allowed RACH offset (in us).")
     ("expert.equalizer_mode", bpo::value<string>(&args->phy.equalizer_mode)->default_value("mmse"), "Equalizer mode.")
@@ -252,6 +263,9 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("expert.tracing_enable",  bpo::value<bool>(&args->general.tracing_enable)->default_value(false), "Events tracing.")
     ("expert.tracing_filename", bpo::value<string>(&args->general.tracing_filename)->default_value("/tmp/enb_tracing.log"), "Tracing events filename.")
     ("expert.tracing_buffcapacity", bpo::value<std::size_t>(&args->general.tracing_buffcapacity)->default_value(1000000), "Tracing buffer capcity.")
+    ("expert.span_tracing_enable",  bpo::value<bool>(&args->general.span_tracing_enable)->default_value(false), "Span tracing in Chrome/Perfetto trace format.")
+    ("expert.span_tracing_filename", bpo::value<string>(&args->general.span_tracing_filename)->default_value("/tmp/enb_spans.json"), "Span tracing filename.")
+    ("expert.span_tracing_nof_spans", bpo::value<std::size_t>(&args->general.span_tracing_nof_spans)->default_value(16384), "Number of spans kept per thread.")
     ("expert.stdout_ts_enable", bpo::value<bool>(&stdout_ts_enable)->default_value(false), "Prints once per second the timestamp into stdout.")
     ("expert.rrc_inactivity_timer", bpo::value<uint32_t>(&args->general.rrc_inactivity_timer)->default_value(30000), "Inactivity timer in ms.")
     ("expert.print_buffer_state", bpo::value<bool>(&args->general.print_buffer_state)->default_value(false), "Prints on the console the buffer state every 10 seconds.")
@@ -264,6 +278,7 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("expert.gtpu_tunnel_timeout", bpo::value<uint32_t>(&args->stack.gtpu_indirect_tunnel_timeout_msec)->default_value(0), "Maximum time that GTPU takes to release indirect forwarding tunnel since the last received GTPU PDU (0 for infinity).")
     ("expert.rlf_release_timer_ms", bpo::value<uint32_t>(&args->general.rlf_release_timer_ms)->default_value(4000), "Time taken by eNB to release UE context after it detects an RLF.")
     ("expert.extended_cp", bpo::value<bool>(&args->phy.extended_cp)->default_value(false), "Use extended cyclic prefix")
+    ("expert.phy_assert_no_alloc", bpo::value<bool>(&args->phy.assert_no_alloc)->default_value(false), "Aborts if a PHY worker allocates heap memory while processing a subframe (debug)")
     ("expert.ts1_reloc_prep_timeout", bpo::value<uint32_t>(&args->stack.s1ap.ts1_reloc_prep_timeout)->default_value(10000), "S1AP TS 36.413 TS1RelocPrep Expiry Timeout value in milliseconds.")
     ("expert.ts1_reloc_overall_timeout", bpo::value<uint32_t>(&args->stack.s1ap.ts1_reloc_overall_timeout)->default_value(10000), "S1AP TS 36.413 TS1RelocOverall Expiry Timeout value in milliseconds.")
     ("expert.rlf_min_ul_snr_estim", bpo::value<int>(&args->stack.mac.rlf_min_ul_snr_estim)->default_value(-2), "SNR threshold in dB below which the eNB is notified with rlf ko.")
@@ -279,7 +294,18 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     // NR section
     ("scheduler.nr_pdsch_mcs", bpo::value<int>(&args->nr_stack.mac.sched_cfg.fixed_dl_mcs)->default_value(28), "Fixed NR DL MCS (-1 for dynamic).")
     ("scheduler.nr_pusch_mcs", bpo::value<int>(&args->nr_stack.mac.sched_cfg.fixed_ul_mcs)->default_value(28), "Fixed NR UL MCS (-1 for dynamic).")
+    ("scheduler.nr_target_bler", bpo::value<float>(&args->nr_stack.mac.sched_cfg.target_bler)->default_value(0.05), "Target BLER of the NR DL link adaptation (0 disables it)")
+    ("scheduler.nr_max_delta_dl_cqi", bpo::value<float>(&args->nr_stack.mac.sched_cfg.max_delta_dl_cqi)->default_value(5.0), "Maximum shift in NR CQI applied by the DL link adaptation")
+    ("scheduler.nr_adaptive_dl_mcs_step_size", bpo::value<float>(&args->nr_stack.mac.sched_cfg.adaptive_dl_mcs_step_size)->default_value(0.001), "Step size or learning rate used in the NR DL link adaptation")
+    ("scheduler.nr_policy", bpo::value<string>(&args->nr_stack.mac.sched_cfg.sched_policy)->default_value("time_rr"), "NR data scheduling policy (time_rr, time_pf)")
+    ("scheduler.nr_policy_args", bpo::value<string>(&args->nr_stack.mac.sched_cfg.sched_policy_args)->default_value(""), "NR scheduler policy-specific arguments")
+    ("scheduler.nr_lookahead_slots", bpo::value<uint32_t>(&args->nr_stack.mac.sched_cfg.nof_lookahead_slots)->default_value(0), "Number of slots the NR scheduling decisions are generated in advance")
+    ("scheduler.nr_nof_carrier_threads", bpo::value<uint32_t>(&args->nr_stack.mac.sched_cfg.nof_carrier_threads)->default_value(0), "Number of threads scheduling the NR carriers in parallel")
+    ("scheduler.nr_trace_filename", bpo::value<string>(&args->nr_stack.mac.sched_cfg.trace_filename)->default_value(""), "File where the NR scheduler inputs are recorded for offline replay (empty disables it)")
     ("expert.nr_pusch_max_its", bpo::value<uint32_t>(&args->phy.nr_pusch_max_its)->default_value(10),     "Maximum number of LDPC iterations for NR.")
+    ("expert.nr_pusch_mmse_enable", bpo::value<bool>(&args->phy.nr_pusch_mmse_enable)->default_value(false), "Estimates the NR PUSCH with a 2D MMSE filter instead of interpolating.")
+    ("expert.nr_pusch_mmse_delay_ns", bpo::value<float>(&args->phy.nr_pusch_mmse.delay_spread_ns)->default_value(0.0f), "RMS delay spread assumed by the NR PUSCH MMSE channel estimator (0 for default).")
+    ("expert.nr_pusch_mmse_doppler_hz", bpo::value<float>(&args->phy.nr_pusch_mmse.doppler_hz)->default_value(0.0f), "Maximum Doppler assumed by the NR PUSCH MMSE channel estimator (0 for default).")
   ;
 
   // Positional options - config file location
@@ -367,6 +393,10 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     }
   }
 
+  // Packet capture compression applies to all PCAP files
+  args->stack.s1ap_pcap.compression_level    = args->stack.mac_pcap.compression_level;
+  args->nr_stack.ngap_pcap.compression_level = args->stack.mac_pcap.compression_level;
+
   // Check PRACH workers
   if (args->phy.nof_prach_threads > 1) {
     fprintf(stderr,
@@ -607,10 +637,18 @@ int main(int argc, char* argv[])
   parse_args(&args, argc, argv);
 
   // Setup the default log sink.
-  srslog::set_default_sink(
-      (args.log.filename == "stdout")
-          ? srslog::fetch_stdout_sink()
-          : srslog::fetch_file_sink(args.log.filename, fixup_log_file_maxsize(args.log.file_max_size)));
+  if (args.log.filename == "stdout") {
+    srslog::set_default_sink(srslog::fetch_stdout_sink());
+  } else if (args.log.binary) {
+    srslog::set_default_sink(
+        srslog::fetch_binary_file_sink(args.log.filename, fixup_log_file_maxsize(args.log.file_max_size)));
+  } else if (args.log.async) {
+    srslog::set_default_sink(
+        srslog::fetch_async_file_sink(args.log.filename, fixup_log_file_maxsize(args.log.file_max_size)));
+  } else {
+    srslog::set_default_sink(
+        srslog::fetch_file_sink(args.log.filename, fixup_log_file_maxsize(args.log.file_max_size)));
+  }
 
   // Alarms log channel creation.
   srslog::sink&        alarm_sink     = srslog::fetch_file_sink(args.general.alarms_filename, 0, true);
@@ -623,6 +661,11 @@ int main(int argc, char* argv[])
       return SRSRAN_ERROR;
     }
   }
+  if (args.general.span_tracing_enable) {
+    if (!srslog::span_trace_init(args.general.span_tracing_filename, args.general.span_tracing_nof_spans)) {
+      return SRSRAN_ERROR;
+    }
+  }
 #endif
 
   // Start the log backend.
@@ -707,6 +750,11 @@ int main(int argc, char* argv[])
   input.join();
   metricshub.stop();
   enb->stop();
+#ifdef ENABLE_SRSLOG_EVENT_TRACE
+  if (args.general.span_tracing_enable) {
+    srslog::span_trace_flush();
+  }
+#endif
   cout << "---  exiting  ---" << endl;
 
   return SRSRAN_SUCCESS;
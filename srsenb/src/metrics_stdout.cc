@@ -178,6 +178,20 @@ void metrics_stdout::set_metrics_helper(uint32_t                          num_ue
   }
 }
 
+static void print_phy_stage(const char* name, const phy_stage_metrics_t& stage)
+{
+  if (stage.nof_late == 0) {
+    return;
+  }
+
+  fmt::print("  {} stage: {} late, p50={}us p99={}us max={}us\n",
+             name,
+             stage.nof_late,
+             stage.p50_us,
+             stage.p99_us,
+             stage.max_us);
+}
+
 void metrics_stdout::set_metrics(const enb_metrics_t& metrics, const uint32_t period_usec)
 {
   if (!do_print || enb == nullptr) {
@@ -188,6 +202,19 @@ void metrics_stdout::set_metrics(const enb_metrics_t& metrics, const uint32_t pe
     fmt::print("RF status: O={}, U={}, L={}\n", metrics.rf.rf_o, metrics.rf.rf_u, metrics.rf.rf_l);
   }
 
+  if (metrics.phy_timing.nof_deadline_misses > 0) {
+    fmt::print("PHY status: {} of {} TTIs processed after their deadline\n",
+               metrics.phy_timing.nof_deadline_misses,
+               metrics.phy_timing.nof_tti);
+    print_phy_stage("UL", metrics.phy_timing.ul_stage);
+    print_phy_stage("sched", metrics.phy_timing.sched_stage);
+    print_phy_stage("DL", metrics.phy_timing.dl_stage);
+  }
+
+  if (metrics.phy_timing.nof_heap_allocs > 0) {
+    fmt::print("PHY status: {} heap allocations while processing TTIs\n", metrics.phy_timing.nof_heap_allocs);
+  }
+
   if (metrics.stack.rrc.ues.size() == 0 && metrics.nr_stack.mac.ues.size() == 0) {
     return;
   }
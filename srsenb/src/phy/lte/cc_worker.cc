@@ -66,15 +66,7 @@ cc_worker::~cc_worker()
   srsran_softbuffer_tx_free(&temp_mbsfn_softbuffer);
   srsran_enb_dl_free(&enb_dl);
   srsran_enb_ul_free(&enb_ul);
-
-  for (int p = 0; p < SRSRAN_MAX_PORTS; p++) {
-    if (signal_buffer_rx[p]) {
-      free(signal_buffer_rx[p]);
-    }
-    if (signal_buffer_tx[p]) {
-      free(signal_buffer_tx[p]);
-    }
-  }
+  srsran_mem_arena_free(&scratch);
 
   // Delete all users
   for (auto& it : ue_db) {
@@ -86,7 +78,7 @@ cc_worker::~cc_worker()
 FILE* f;
 #endif
 
-void cc_worker::init(phy_common* phy_, uint32_t cc_idx_)
+void cc_worker::init(phy_common* phy_, uint32_t cc_idx_, srsran_mem_arena_t* arena)
 {
   phy                         = phy_;
   cc_idx                      = cc_idx_;
@@ -95,15 +87,15 @@ void cc_worker::init(phy_common* phy_, uint32_t cc_idx_)
   uint32_t         sf_len     = SRSRAN_SF_LEN_PRB(nof_prb);
   srsran_cfr_cfg_t cfr_config = phy_->get_cfr_config();
 
-  // Init cell here
+  // Init cell here, signal buffers belong to the worker arena
   for (uint32_t p = 0; p < phy->get_nof_ports(cc_idx); p++) {
-    signal_buffer_rx[p] = srsran_vec_cf_malloc(2 * sf_len);
+    signal_buffer_rx[p] = SRSRAN_MEM_ARENA_ALLOC(arena, cf_t, 2 * sf_len);
     if (!signal_buffer_rx[p]) {
       ERROR("Error allocating memory");
       return;
     }
     srsran_vec_cf_zero(signal_buffer_rx[p], 2 * sf_len);
-    signal_buffer_tx[p] = srsran_vec_cf_malloc(2 * sf_len);
+    signal_buffer_tx[p] = SRSRAN_MEM_ARENA_ALLOC(arena, cf_t, 2 * sf_len);
     if (!signal_buffer_tx[p]) {
       ERROR("Error allocating memory");
       return;
@@ -114,6 +106,15 @@ void cc_worker::init(phy_common* phy_, uint32_t cc_idx_)
     ERROR("Error initiating ENB DL (cc=%d)", cc_idx);
     return;
   }
+  // The carrier DL tasks run in parallel, so each carrier takes its PDSCH subframe scratch from its own arena
+  if (srsran_mem_arena_init(&scratch, srsran_pdsch_scratch_size(nof_prb, 0)) < SRSRAN_SUCCESS) {
+    ERROR("Error initiating the PDSCH scratch arena (cc=%d)", cc_idx);
+    return;
+  }
+  if (srsran_pdsch_set_scratch(&enb_dl.pdsch, &scratch)) {
+    ERROR("Error setting the PDSCH scratch arena (cc=%d)", cc_idx);
+    return;
+  }
   if (srsran_enb_dl_set_cell(&enb_dl, cell)) {
     ERROR("Error initiating ENB DL (cc=%d)", cc_idx);
     return;
@@ -236,6 +237,9 @@ void cc_worker::work_dl(const srsran_dl_sf_cfg_t&            dl_sf_cfg,
   std::lock_guard<std::mutex> lock(mutex);
   dl_sf = dl_sf_cfg;
 
+  // Release the PDSCH scratch of the previous subframe
+  srsran_mem_arena_reset(&scratch);
+
   // Put base signals (references, PBCH, PCFICH and PSS/SSS) into the resource grid
   srsran_enb_dl_put_base(&enb_dl, &dl_sf);
 
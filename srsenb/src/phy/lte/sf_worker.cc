@@ -20,6 +20,7 @@
  */
 
 #include "srsran/common/threads.h"
+#include "srsran/srslog/span_trace.h"
 #include "srsran/srsran.h"
 
 #include "srsenb/hdr/phy/lte/sf_worker.h"
@@ -76,13 +77,24 @@ void sf_worker::init(phy_common* phy_)
 {
   phy = phy_;
 
+  // Each carrier worker has 2 subframes of Rx and Tx buffers for each port
+  size_t arena_sz = 0;
+  for (uint32_t i = 0; i < phy->get_nof_carriers_lte(); i++) {
+    size_t buffer_sz = SRSRAN_MEM_ARENA_SIZE(cf_t, 2 * SRSRAN_SF_LEN_PRB(phy->get_nof_prb(i)));
+    arena_sz += 2 * phy->get_nof_ports(i) * buffer_sz;
+  }
+  if (srsran_mem_arena_init(&arena, arena_sz) < SRSRAN_SUCCESS) {
+    ERROR("Error initiating worker arena");
+    exit(-1);
+  }
+
   // Initialise each component carrier workers
   for (uint32_t i = 0; i < phy->get_nof_carriers_lte(); i++) {
     // Create pointer
     auto q = new cc_worker(logger);
 
     // Initialise
-    q->init(phy, i);
+    q->init(phy, i, &arena);
 
     // Create unique pointer
     cc_workers.push_back(std::unique_ptr<cc_worker>(q));
@@ -112,6 +124,7 @@ cf_t* sf_worker::get_buffer_rx(uint32_t cc_idx, uint32_t antenna_idx)
 
 void sf_worker::set_context(const srsran::phy_common_interface::worker_context_t& w_ctx)
 {
+  tti_start = srsran::task_graph::clock_t::now();
   tti_rx    = w_ctx.sf_idx;
   tti_tx_dl = TTI_ADD(tti_rx, FDD_HARQ_DELAY_UL_MS);
   tti_tx_ul = TTI_RX_ACK(tti_rx);
@@ -149,10 +162,20 @@ uint32_t sf_worker::get_nof_rnti()
 
 void sf_worker::work_imp()
 {
-  std::lock_guard<std::mutex> lock(work_mutex);
+  // Count the heap allocations of the subframe processing
+  srsran_mem_guard_enter(phy->params.assert_no_alloc);
+  work_sf();
+  uint32_t nof_allocs = srsran_mem_guard_exit();
+  if (nof_allocs > 0) {
+    logger.warning("Subframe processing did %d heap allocations", nof_allocs);
+    phy->nof_heap_allocs += nof_allocs;
+  }
+}
 
-  srsran_ul_sf_cfg_t ul_sf = {};
-  srsran_dl_sf_cfg_t dl_sf = {};
+void sf_worker::work_sf()
+{
+  std::lock_guard<std::mutex> lock(work_mutex);
+  trace_span_flow_start("tti", "phy::sf_worker", tti_rx);
 
   // Get Transmission buffers
   srsran::rf_buffer_t tx_buffer = {};
@@ -163,18 +186,16 @@ void sf_worker::work_imp()
     return;
   }
 
-  srsran_mbsfn_cfg_t mbsfn_cfg;
-  srsran_sf_t        sf_type = phy->is_mbsfn_sf(&mbsfn_cfg, tti_tx_dl) ? SRSRAN_SF_MBSFN : SRSRAN_SF_NORM;
+  srsran_sf_t sf_type = phy->is_mbsfn_sf(&mbsfn_cfg, tti_tx_dl) ? SRSRAN_SF_MBSFN : SRSRAN_SF_NORM;
 
   // Uplink grants to receive this TTI
-  stack_interface_phy_lte::ul_sched_list_t ul_grants = phy->get_ul_grants(tti_rx);
+  ul_grants = phy->get_ul_grants(tti_rx);
   // Uplink grants to transmit this tti and receive in the future
-  stack_interface_phy_lte::ul_sched_list_t ul_grants_tx = phy->get_ul_grants(tti_tx_ul);
+  ul_grants_tx = phy->get_ul_grants(tti_tx_ul);
 
   // Downlink grants to transmit this TTI
-  stack_interface_phy_lte::dl_sched_list_t dl_grants(phy->get_nof_carriers_lte());
-
-  stack_interface_phy_lte* stack = phy->stack;
+  dl_grants.clear();
+  dl_grants.resize(phy->get_nof_carriers_lte());
 
   logger.set_context(tti_rx);
 
@@ -188,50 +209,65 @@ void sf_worker::work_imp()
     Info("Failed setting UL grants. Some grant's RNTI does not exist.");
   }
 
-  // Process UL
-  for (uint32_t cc = 0; cc < cc_workers.size(); cc++) {
-    cc_workers[cc]->work_ul(ul_sf, ul_grants[cc]);
-  }
-
-  // Get DL scheduling for the TX TTI from MAC
-  if (sf_type == SRSRAN_SF_NORM) {
-    if (stack->get_dl_sched(tti_tx_dl, dl_grants) < 0) {
-      Error("Getting DL scheduling from MAC");
-      phy->worker_end(context, true, tx_buffer);
-      return;
-    }
-  } else {
-    dl_grants[0].cfi = mbsfn_cfg.non_mbsfn_region_length;
-    if (stack->get_mch_sched(tti_tx_dl, mbsfn_cfg.is_mcch, dl_grants)) {
-      Error("Getting MCH packets from MAC");
-      phy->worker_end(context, true, tx_buffer);
-      return;
-    }
-  }
-
-  // Get UL scheduling for the TX TTI from MAC
-  if (stack->get_ul_sched(tti_tx_ul, ul_grants_tx) < 0) {
-    Error("Getting UL scheduling from MAC");
-    phy->worker_end(context, true, tx_buffer);
-    return;
-  }
-
   // Configure DL subframe
   dl_sf.tti              = tti_tx_dl;
   dl_sf.sf_type          = sf_type;
   dl_sf.non_mbsfn_region = mbsfn_cfg.non_mbsfn_region_length;
 
-  // Prepare for receive ACK for DL grants in t_tx_dl+4
-  phy->ue_db.clear_tti_pending_ack(tti_tx_ul);
+  // Build the task graph of the subframe. The carriers are processed in parallel, the scheduling needs the UL
+  // feedback of all of them and the DL processing needs the scheduling. As the PHICH and the DL HARQ retransmissions
+  // of this subframe depend on the UL decoding, the UL stage deadline can not be later than the transmission
+  std::chrono::microseconds dl_deadline(phy->params.tti_deadline_us);
+  std::chrono::microseconds ul_deadline(std::min(phy->params.tti_ul_deadline_us, phy->params.tti_deadline_us));
+  graph.clear();
+  graph.set_deadline(tti_start + dl_deadline);
 
-  // Process DL
+  srsran::bounded_vector<srsran::task_graph::task_id, SRSRAN_MAX_CARRIERS> ul_tasks;
   for (uint32_t cc = 0; cc < cc_workers.size(); cc++) {
-    // Select CFI and make sure it is in the right range
-    dl_sf.cfi = dl_grants[cc].cfi;
-    dl_sf.cfi = SRSRAN_MAX(dl_sf.cfi, 1);
-    dl_sf.cfi = SRSRAN_MIN(dl_sf.cfi, 3);
+    ul_tasks.push_back(graph.add_task([this, cc]() {
+      trace_span_flow("tti", "phy::work_ul", tti_rx);
+      cc_workers[cc]->work_ul(ul_sf, ul_grants[cc]);
+    }));
+  }
 
-    cc_workers[cc]->work_dl(dl_sf, dl_grants[cc], ul_grants_tx[cc], &mbsfn_cfg);
+  srsran::task_graph::task_id sched_task = graph.add_task([this, ul_deadline, dl_deadline]() {
+    trace_span_flow("tti", "phy::work_sched", tti_rx);
+    stage_completed(phy->ul_stage_latency, ul_deadline);
+    sched_ok = work_sched();
+    stage_completed(phy->sched_stage_latency, dl_deadline);
+  });
+  for (srsran::task_graph::task_id ul_task : ul_tasks) {
+    graph.add_dependency(ul_task, sched_task);
+  }
+
+  for (uint32_t cc = 0; cc < cc_workers.size(); cc++) {
+    srsran::task_graph::task_id dl_task = graph.add_task([this, cc]() {
+      if (not sched_ok) {
+        return;
+      }
+      trace_span_flow("tti", "phy::work_dl", tti_rx);
+
+      // Select CFI and make sure it is in the right range
+      srsran_dl_sf_cfg_t dl_sf_cc = dl_sf;
+      dl_sf_cc.cfi                = dl_grants[cc].cfi;
+      dl_sf_cc.cfi                = SRSRAN_MAX(dl_sf_cc.cfi, 1);
+      dl_sf_cc.cfi                = SRSRAN_MIN(dl_sf_cc.cfi, 3);
+
+      cc_workers[cc]->work_dl(dl_sf_cc, dl_grants[cc], ul_grants_tx[cc], &mbsfn_cfg);
+    });
+    graph.add_dependency(sched_task, dl_task);
+  }
+
+  if (not phy->task_executor->run(graph)) {
+    Info("Subframe processing completed after its deadline");
+    trace_span_instant("tti", "phy::deadline_miss", tti_rx);
+    trace_span_snapshot();
+  }
+  stage_completed(phy->dl_stage_latency, dl_deadline);
+
+  if (not sched_ok) {
+    phy->worker_end(context, true, tx_buffer);
+    return;
   }
 
   // Save grants
@@ -266,6 +302,42 @@ void sf_worker::work_imp()
 #endif
 }
 
+void sf_worker::stage_completed(srsran::latency_histogram& latency, std::chrono::microseconds deadline)
+{
+  auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(srsran::task_graph::clock_t::now() - tti_start);
+  latency.add(elapsed, elapsed > deadline);
+}
+
+bool sf_worker::work_sched()
+{
+  stack_interface_phy_lte* stack = phy->stack;
+
+  // Get DL scheduling for the TX TTI from MAC
+  if (dl_sf.sf_type == SRSRAN_SF_NORM) {
+    if (stack->get_dl_sched(tti_tx_dl, dl_grants) < 0) {
+      Error("Getting DL scheduling from MAC");
+      return false;
+    }
+  } else {
+    dl_grants[0].cfi = mbsfn_cfg.non_mbsfn_region_length;
+    if (stack->get_mch_sched(tti_tx_dl, mbsfn_cfg.is_mcch, dl_grants)) {
+      Error("Getting MCH packets from MAC");
+      return false;
+    }
+  }
+
+  // Get UL scheduling for the TX TTI from MAC
+  if (stack->get_ul_sched(tti_tx_ul, ul_grants_tx) < 0) {
+    Error("Getting UL scheduling from MAC");
+    return false;
+  }
+
+  // Prepare for receive ACK for DL grants in t_tx_dl+4
+  phy->ue_db.clear_tti_pending_ack(tti_tx_ul);
+
+  return true;
+}
+
 /************ METRICS interface ********************/
 uint32_t sf_worker::get_metrics(std::vector<phy_metrics_t>& metrics)
 {
@@ -343,6 +415,10 @@ int sf_worker::read_pucch_d(uint32_t cc_idx, cf_t* pdsch_d)
 sf_worker::~sf_worker()
 {
   srsran_softbuffer_tx_free(&temp_mbsfn_softbuffer);
+
+  // The carrier workers use the arena memory
+  cc_workers.clear();
+  srsran_mem_arena_free(&arena);
 }
 
 } // namespace lte
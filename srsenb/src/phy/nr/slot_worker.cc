@@ -50,13 +50,56 @@ bool slot_worker::init(const args_t& args)
   sf_len = (uint32_t)(args.srate_hz / 1000.0);
 
   // Copy common configurations
-  cell_index = args.cell_index;
-  rf_port    = args.rf_port;
+  cell_index        = args.cell_index;
+  rf_port           = args.rf_port;
+  assert_no_alloc   = args.assert_no_alloc;
+  pusch_mmse_enable = args.pusch_mmse_enable;
+  pusch_mmse        = args.pusch_mmse;
+  task_executor     = args.task_executor;
+  tti_deadline      = std::chrono::microseconds(args.tti_deadline_us);
+  ul_deadline       = std::chrono::microseconds(args.tti_ul_deadline_us);
+  ul_latency        = args.ul_latency;
+  dl_latency        = args.dl_latency;
+  heap_allocs       = args.heap_allocs;
+
+  // Prepare DL arguments
+  srsran_gnb_dl_args_t dl_args = {};
+  dl_args.pdsch.measure_time   = true;
+  dl_args.pdsch.max_layers     = args.nof_tx_ports;
+  dl_args.pdsch.max_prb        = args.nof_max_prb;
+  dl_args.pdsch.scratch        = &arena;
+  dl_args.nof_tx_antennas      = args.nof_tx_ports;
+  dl_args.nof_max_prb          = args.nof_max_prb;
+  dl_args.srate_hz             = args.srate_hz;
+
+  // Prepare UL arguments, the UL data is decoded concurrently with the DL so it has its own scratch arena
+  srsran_gnb_ul_args_t ul_args   = {};
+  ul_args.pusch.measure_time     = true;
+  ul_args.pusch.measure_evm      = true;
+  ul_args.pusch.max_layers       = args.nof_rx_ports;
+  ul_args.pusch.sch.max_nof_iter = args.pusch_max_its;
+  ul_args.pusch.max_prb          = args.nof_max_prb;
+  ul_args.pusch.scratch          = &ul_arena;
+  ul_args.nof_max_prb            = args.nof_max_prb;
+  ul_args.pusch_min_snr_dB       = args.pusch_min_snr_dB;
+
+  // Allocate the memory of all baseband buffers at once, followed by the room of the DL slot scratch
+  size_t buffer_sz = SRSRAN_MEM_ARENA_SIZE(cf_t, sf_len);
+  if (srsran_mem_arena_init(&arena,
+                            (args.nof_tx_ports + args.nof_rx_ports) * buffer_sz +
+                                srsran_pdsch_nr_scratch_size(&dl_args.pdsch)) < SRSRAN_SUCCESS) {
+    logger.error("Error initiating worker arena");
+    return false;
+  }
+  if (srsran_mem_arena_init(&ul_arena, srsran_pusch_nr_scratch_size(&ul_args.pusch)) < SRSRAN_SUCCESS) {
+    logger.error("Error initiating worker UL arena");
+    return false;
+  }
 
   // Allocate Tx buffers
   tx_buffer.resize(args.nof_tx_ports);
   for (uint32_t i = 0; i < args.nof_tx_ports; i++) {
-    tx_buffer[i] = srsran_vec_cf_malloc(sf_len);
+    tx_buffer[i] = SRSRAN_MEM_ARENA_ALLOC(&arena, cf_t, sf_len);
     if (tx_buffer[i] == nullptr) {
       logger.error("Error allocating Tx buffer");
       return false;
@@ -66,21 +109,15 @@ bool slot_worker::init(const args_t& args)
   // Allocate Rx buffers
   rx_buffer.resize(args.nof_rx_ports);
   for (uint32_t i = 0; i < args.nof_rx_ports; i++) {
-    rx_buffer[i] = srsran_vec_cf_malloc(sf_len);
+    rx_buffer[i] = SRSRAN_MEM_ARENA_ALLOC(&arena, cf_t, sf_len);
     if (rx_buffer[i] == nullptr) {
       logger.error("Error allocating Rx buffer");
       return false;
     }
   }
 
-  // Prepare DL arguments
-  srsran_gnb_dl_args_t dl_args = {};
-  dl_args.pdsch.measure_time   = true;
-  dl_args.pdsch.max_layers     = args.nof_tx_ports;
-  dl_args.pdsch.max_prb        = args.nof_max_prb;
-  dl_args.nof_tx_antennas      = args.nof_tx_ports;
-  dl_args.nof_max_prb          = args.nof_max_prb;
-  dl_args.srate_hz             = args.srate_hz;
+  // The baseband buffers survive the slot scratch resets
+  srsran_mem_arena_set_mark(&arena);
 
   // Initialise DL
   if (srsran_gnb_dl_init(&gnb_dl, tx_buffer.data(), &dl_args) < SRSRAN_SUCCESS) {
@@ -88,16 +125,6 @@ bool slot_worker::init(const args_t& args)
     return false;
   }
 
-  // Prepare UL arguments
-  srsran_gnb_ul_args_t ul_args   = {};
-  ul_args.pusch.measure_time     = true;
-  ul_args.pusch.measure_evm      = true;
-  ul_args.pusch.max_layers       = args.nof_rx_ports;
-  ul_args.pusch.sch.max_nof_iter = args.pusch_max_its;
-  ul_args.pusch.max_prb          = args.nof_max_prb;
-  ul_args.nof_max_prb            = args.nof_max_prb;
-  ul_args.pusch_min_snr_dB       = args.pusch_min_snr_dB;
-
   // Initialise UL
   if (srsran_gnb_ul_init(&gnb_ul, rx_buffer[0], &ul_args) < SRSRAN_SUCCESS) {
     logger.error("Error gNb DL init");
@@ -115,20 +142,12 @@ bool slot_worker::init(const args_t& args)
 
 slot_worker::~slot_worker()
 {
-  for (auto& b : tx_buffer) {
-    if (b) {
-      free(b);
-      b = nullptr;
-    }
-  }
-  for (auto& b : rx_buffer) {
-    if (b) {
-      free(b);
-      b = nullptr;
-    }
-  }
+  tx_buffer.clear();
+  rx_buffer.clear();
   srsran_gnb_dl_free(&gnb_dl);
   srsran_gnb_ul_free(&gnb_ul);
+  srsran_mem_arena_free(&arena);
+  srsran_mem_arena_free(&ul_arena);
 }
 
 cf_t* slot_worker::get_buffer_rx(uint32_t antenna_idx)
@@ -159,13 +178,16 @@ uint32_t slot_worker::get_buffer_len()
 void slot_worker::set_context(const srsran::phy_common_interface::worker_context_t& w_ctx)
 {
   logger.set_context(w_ctx.sf_idx);
+  tti_start       = srsran::task_graph::clock_t::now();
   ul_slot_cfg.idx = w_ctx.sf_idx;
   dl_slot_cfg.idx = TTI_ADD(w_ctx.sf_idx, FDD_HARQ_DELAY_UL_MS);
   context.copy(w_ctx);
 }
 
-bool slot_worker::work_ul()
+bool slot_worker::work_ul_uci()
 {
+  ul_data_pusch.clear();
+
   stack_interface_phy_nr::ul_sched_t* ul_sched = stack.get_ul_sched(ul_slot_cfg);
   if (ul_sched == nullptr) {
     logger.error("Error retrieving UL scheduling");
@@ -234,49 +256,80 @@ bool slot_worker::work_ul()
     }
   }
 
-  // For each PUSCH...
+  // The HARQ-ACK multiplexed in the PUSCH is also needed for scheduling the DL of this slot. The other PUSCH are
+  // copied, the scheduler resets its slot grid while they are decoded
   for (stack_interface_phy_nr::pusch_t& pusch : ul_sched->pusch) {
-    // Prepare PUSCH
-    stack_interface_phy_nr::pusch_info_t pusch_info = {};
-    pusch_info.uci_cfg                              = pusch.sch.uci;
-    pusch_info.pid                                  = pusch.pid;
-    pusch_info.rnti                                 = pusch.sch.grant.rnti;
-    pusch_info.pdu                                  = srsran::make_byte_buffer();
-    if (pusch_info.pdu == nullptr) {
-      logger.error("Couldn't allocate PDU in %s().", __FUNCTION__);
+    if (srsran_uci_nr_total_bits(&pusch.sch.uci) == 0) {
+      ul_data_pusch.push_back(pusch);
+    } else if (not decode_pusch(pusch)) {
       return false;
     }
-    pusch_info.pdu->N_bytes             = pusch.sch.grant.tb[0].tbs / 8;
-    pusch_info.pusch_data.tb[0].payload = pusch_info.pdu->data();
+  }
+
+  return true;
+}
 
-    // Decode PUSCH
-    if (srsran_gnb_ul_get_pusch(&gnb_ul, &ul_slot_cfg, &pusch.sch, &pusch.sch.grant, &pusch_info.pusch_data) <
-        SRSRAN_SUCCESS) {
-      logger.error("Error getting PUSCH");
+bool slot_worker::work_ul_data()
+{
+  // Decode the PUSCH that do not carry UCI, the DL does not depend on them
+  for (stack_interface_phy_nr::pusch_t& pusch : ul_data_pusch) {
+    if (not decode_pusch(pusch)) {
       return false;
     }
+  }
 
-    // Extract DMRS information
-    pusch_info.csi = gnb_ul.dmrs.csi;
+  return true;
+}
 
-    // Inform stack
-    if (stack.pusch_info(ul_slot_cfg, pusch_info) < SRSRAN_SUCCESS) {
-      logger.error("Error pushing PUSCH information to stack");
-      return false;
-    }
+bool slot_worker::decode_pusch(stack_interface_phy_nr::pusch_t& pusch)
+{
+  // Prepare PUSCH
+  stack_interface_phy_nr::pusch_info_t pusch_info = {};
+  pusch_info.uci_cfg                              = pusch.sch.uci;
+  pusch_info.pid                                  = pusch.pid;
+  pusch_info.rnti                                 = pusch.sch.grant.rnti;
+  pusch_info.pdu                                  = srsran::make_byte_buffer();
+  if (pusch_info.pdu == nullptr) {
+    logger.error("Couldn't allocate PDU in %s().", __FUNCTION__);
+    return false;
+  }
+  pusch_info.pdu->N_bytes             = pusch.sch.grant.tb[0].tbs / 8;
+  pusch_info.pusch_data.tb[0].payload = pusch_info.pdu->data();
+
+  // The grant selects the channel estimator from the UE configuration, the worker setting only enables the MMSE
+  // estimator for the grants that do not select it
+  if (pusch_mmse_enable and not pusch.sch.dmrs.mmse_enable) {
+    pusch.sch.dmrs.mmse_enable = true;
+    pusch.sch.dmrs.mmse        = pusch_mmse;
+  }
 
-    // Log PUSCH decoding
-    if (logger.info.enabled()) {
-      std::array<char, 512> str;
-      srsran_gnb_ul_pusch_info(&gnb_ul, &pusch.sch, &pusch_info.pusch_data, str.data(), (uint32_t)str.size());
+  // Decode PUSCH
+  if (srsran_gnb_ul_get_pusch(&gnb_ul, &ul_slot_cfg, &pusch.sch, &pusch.sch.grant, &pusch_info.pusch_data) <
+      SRSRAN_SUCCESS) {
+    logger.error("Error getting PUSCH");
+    return false;
+  }
 
-      if (logger.debug.enabled()) {
-        std::array<char, 1024> str_extra = {};
-        srsran_sch_cfg_nr_info(&pusch.sch, str_extra.data(), (uint32_t)str_extra.size());
-        logger.info("PUSCH: %s\n%s", str.data(), str_extra.data());
-      } else {
-        logger.info("PUSCH: %s", str.data());
-      }
+  // Extract DMRS information
+  pusch_info.csi = gnb_ul.dmrs.csi;
+
+  // Inform stack
+  if (stack.pusch_info(ul_slot_cfg, pusch_info) < SRSRAN_SUCCESS) {
+    logger.error("Error pushing PUSCH information to stack");
+    return false;
+  }
+
+  // Log PUSCH decoding
+  if (logger.info.enabled()) {
+    std::array<char, 512> str;
+    srsran_gnb_ul_pusch_info(&gnb_ul, &pusch.sch, &pusch_info.pusch_data, str.data(), (uint32_t)str.size());
+
+    if (logger.debug.enabled()) {
+      std::array<char, 1024> str_extra = {};
+      srsran_sch_cfg_nr_info(&pusch.sch, str_extra.data(), (uint32_t)str_extra.size());
+      logger.info("PUSCH: %s\n%s", str.data(), str_extra.data());
+    } else {
+      logger.info("PUSCH: %s", str.data());
     }
   }
 
@@ -401,7 +454,35 @@ bool slot_worker::work_dl()
   return true;
 }
 
+void slot_worker::stage_completed(srsran::latency_histogram* latency, std::chrono::microseconds deadline)
+{
+  if (latency == nullptr) {
+    return;
+  }
+
+  auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(srsran::task_graph::clock_t::now() - tti_start);
+  latency->add(elapsed, elapsed > deadline);
+}
+
 void slot_worker::work_imp()
+{
+  // Release the scratch buffers of the previous slot, its UL data decoding has been waited for
+  srsran_mem_arena_reset(&arena);
+  srsran_mem_arena_reset(&ul_arena);
+
+  // Count the heap allocations of the slot processing
+  srsran_mem_guard_enter(assert_no_alloc);
+  work_slot();
+  uint32_t nof_allocs = srsran_mem_guard_exit();
+  if (nof_allocs > 0) {
+    logger.warning("Slot processing did %d heap allocations", nof_allocs);
+    if (heap_allocs != nullptr) {
+      *heap_allocs += nof_allocs;
+    }
+  }
+}
+
+void slot_worker::work_slot()
 {
   // Inform Scheduler about new slot
   stack.slot_indication(dl_slot_cfg);
@@ -414,22 +495,43 @@ void slot_worker::work_imp()
     tx_rf_buffer.set(rf_port, a, nof_ant, tx_buffer[a]);
   }
 
-  // Process uplink
-  if (not work_ul()) {
-    // Wait and release synchronization
-    sync.wait(this);
-    sync.release();
-    common.worker_end(context, false, tx_rf_buffer);
-    return;
-  }
+  // The scheduler needs the HARQ-ACK of this slot before scheduling its DL, so the UCI is decoded first
+  ul_ok = work_ul_uci();
+
+  if (task_executor != nullptr) {
+    // The UL data and DL processing use different objects and the DL does not need the UL data of the slot. The UL
+    // data decoding is released first, so idle threads can take it, but it is only waited for after the transmission
+    ul_graph.clear();
+    ul_graph.set_deadline(tti_start + ul_deadline);
+    ul_graph.add_task([this]() {
+      ul_ok = ul_ok && work_ul_data();
+      stage_completed(ul_latency, ul_deadline);
+    });
+    task_executor->start(ul_graph);
+
+    dl_graph.clear();
+    dl_graph.set_deadline(tti_start + tti_deadline);
+    dl_graph.add_task([this]() { dl_ok = work_dl(); });
+    if (not task_executor->run(dl_graph)) {
+      logger.info("Slot DL processing completed after its deadline");
+    }
+    stage_completed(dl_latency, tti_deadline);
+    common.worker_end(context, dl_ok, tx_rf_buffer);
 
-  // Process downlink
-  if (not work_dl()) {
-    common.worker_end(context, false, tx_rf_buffer);
+    if (not task_executor->wait(ul_graph)) {
+      logger.info("Slot UL processing completed after its deadline");
+    }
     return;
   }
 
-  common.worker_end(context, true, tx_rf_buffer);
+  // Process and transmit downlink, the uplink data decoding does not delay the transmission
+  dl_ok = work_dl();
+  stage_completed(dl_latency, tti_deadline);
+  common.worker_end(context, dl_ok, tx_rf_buffer);
+
+  // Process the uplink data
+  ul_ok = ul_ok && work_ul_data();
+  stage_completed(ul_latency, ul_deadline);
 
 #ifdef DEBUG_WRITE_FILE
   if (num_slots++ < slots_to_dump) {
@@ -73,6 +73,15 @@ bool worker_pool::init(const args_t& args, const phy_cell_cfg_list_nr_t& cell_li
     w_args.srate_hz                = srate_hz;
     w_args.pusch_max_its           = args.pusch_max_its;
     w_args.pusch_min_snr_dB        = args.pusch_min_snr_dB;
+    w_args.assert_no_alloc         = args.assert_no_alloc;
+    w_args.pusch_mmse_enable       = args.pusch_mmse_enable;
+    w_args.pusch_mmse              = args.pusch_mmse;
+    w_args.tti_deadline_us         = args.tti_deadline_us;
+    w_args.tti_ul_deadline_us      = args.tti_ul_deadline_us;
+    w_args.task_executor           = args.task_executor;
+    w_args.ul_latency              = args.ul_latency;
+    w_args.dl_latency              = args.dl_latency;
+    w_args.heap_allocs             = args.heap_allocs;
 
     if (not w->init(w_args)) {
       return false;
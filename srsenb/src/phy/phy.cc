@@ -173,6 +173,9 @@ int phy::init_lte(const phy_args_t&            args,
 
   workers_common.params = args;
 
+  workers_common.task_executor.reset(
+      new srsran::task_graph_executor(args.nof_task_threads, WORKERS_THREAD_PRIO, args.task_cpu_mask));
+
   workers_common.init(cfg.phy_cell_cfg, cfg.phy_cell_cfg_nr, radio, stack_lte_);
   if (cfg.cfr_config.cfr_enable) {
     workers_common.set_cfr_config(cfg.cfr_config);
@@ -211,6 +214,9 @@ void phy::stop()
       nr_workers->stop();
     }
     prach.stop();
+    if (workers_common.task_executor != nullptr) {
+      workers_common.task_executor->stop();
+    }
 
     initialized = false;
   }
@@ -247,6 +253,36 @@ void phy::set_activation_deactivation_scell(uint16_t rnti, const std::array<bool
   }
 }
 
+static void get_stage_metrics(srsran::latency_histogram& latency, phy_stage_metrics_t& metrics)
+{
+  srsran::latency_histogram::summary_t s = latency.get_and_reset();
+  metrics.nof_tti                        = s.nof_samples;
+  metrics.nof_late                       = s.nof_late;
+  metrics.p50_us                         = s.p50_us;
+  metrics.p99_us                         = s.p99_us;
+  metrics.max_us                         = s.max_us;
+}
+
+void phy::get_timing_metrics(phy_timing_metrics_t& metrics)
+{
+  metrics = {};
+  get_stage_metrics(workers_common.ul_stage_latency, metrics.ul_stage);
+  get_stage_metrics(workers_common.sched_stage_latency, metrics.sched_stage);
+  get_stage_metrics(workers_common.dl_stage_latency, metrics.dl_stage);
+  metrics.nof_heap_allocs = workers_common.nof_heap_allocs.exchange(0);
+
+  if (workers_common.task_executor == nullptr) {
+    return;
+  }
+
+  // The NR slots run two graphs, the DL stage is recorded once for every LTE subframe and NR slot
+  srsran::task_graph_executor::metrics_t m = workers_common.task_executor->get_metrics();
+  metrics.nof_tti                          = metrics.dl_stage.nof_tti;
+  metrics.nof_deadline_misses              = m.nof_deadline_misses;
+  metrics.nof_late_tasks                   = m.nof_late_tasks;
+  metrics.nof_stolen_tasks                 = m.nof_stolen_tasks;
+}
+
 void phy::get_metrics(std::vector<phy_metrics_t>& metrics)
 {
   std::vector<phy_metrics_t> metrics_tmp;
@@ -374,6 +410,15 @@ int phy::init_nr(const phy_args_t& args, const phy_cfg_t& cfg, stack_interface_p
   worker_args.log.phy_level           = args.log.phy_level;
   worker_args.log.phy_hex_limit       = args.log.phy_hex_limit;
   worker_args.pusch_max_its           = args.nr_pusch_max_its;
+  worker_args.assert_no_alloc         = args.assert_no_alloc;
+  worker_args.pusch_mmse_enable       = args.nr_pusch_mmse_enable;
+  worker_args.pusch_mmse              = args.nr_pusch_mmse;
+  worker_args.tti_deadline_us         = args.tti_deadline_us;
+  worker_args.tti_ul_deadline_us      = args.tti_ul_deadline_us;
+  worker_args.task_executor           = workers_common.task_executor.get();
+  worker_args.ul_latency              = &workers_common.ul_stage_latency;
+  worker_args.dl_latency              = &workers_common.dl_stage_latency;
+  worker_args.heap_allocs             = &workers_common.nof_heap_allocs;
 
   if (not nr_workers->init(worker_args, cfg.phy_cell_cfg_nr)) {
     return SRSRAN_ERROR;
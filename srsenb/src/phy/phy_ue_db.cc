@@ -23,6 +23,16 @@
 
 using namespace srsenb;
 
+phy_ue_db::phy_ue_db()
+{
+  pthread_rwlock_init(&rwlock, nullptr);
+}
+
+phy_ue_db::~phy_ue_db()
+{
+  pthread_rwlock_destroy(&rwlock);
+}
+
 void phy_ue_db::init(stack_interface_phy_lte*   stack_ptr,
                      const phy_args_t&          phy_args_,
                      const phy_cell_cfg_list_t& cell_cfg_list_)
@@ -42,9 +52,6 @@ inline int phy_ue_db::_add_rnti(uint16_t rnti)
   }
 
   // Create new UE by accesing it
-  ue_db[rnti].cell_info[0] = {};
-
-  // Get UE
   common_ue& ue = ue_db[rnti];
 
   // Load default values to PCell
@@ -66,12 +73,13 @@ inline int phy_ue_db::_add_rnti(uint16_t rnti)
 
 inline void phy_ue_db::_clear_tti_pending_rnti(uint32_t tti, uint16_t rnti)
 {
-  // Private function not mutexed, no need to assert RNTI or TTI
+  // Private function, the caller holds the database lock. No need to assert RNTI or TTI
 
   // Get UE
-  common_ue& ue = ue_db[rnti];
+  common_ue& ue = ue_db.at(rnti);
 
-  srsran_pdsch_ack_t& pdsch_ack = ue.pdsch_ack[tti];
+  std::lock_guard<std::mutex> lock(ue.tti_mutex[tti]);
+  srsran_pdsch_ack_t&         pdsch_ack = ue.pdsch_ack[tti];
 
   // Reset ACK information
   pdsch_ack = {};
@@ -137,6 +145,12 @@ uint32_t phy_ue_db::_get_uci_enb_cc_idx(uint32_t tti, uint16_t rnti) const
   return (uint32_t)cell_cfg_list->size();
 }
 
+inline uint8_t phy_ue_db::_get_last_ri(const common_ue& ue, uint32_t ue_cc_idx) const
+{
+  std::lock_guard<std::mutex> ue_lock(ue.ue_mutex);
+  return ue.cell_info[ue_cc_idx].last_ri;
+}
+
 inline int phy_ue_db::_assert_rnti(uint16_t rnti) const
 {
   if (not ue_db.count(rnti)) {
@@ -235,15 +249,13 @@ inline int phy_ue_db::_assert_cell_list_cfg() const
 
 inline int phy_ue_db::_get_rnti_config(uint16_t rnti, uint32_t enb_cc_idx, srsran::phy_cfg_t& phy_cfg) const
 {
-  srsran::phy_cfg_t default_cfg = {};
-  default_cfg.set_defaults();
-  default_cfg.dl_cfg.pdsch.rnti = rnti;
-  default_cfg.ul_cfg.pucch.rnti = rnti;
-  default_cfg.ul_cfg.pusch.rnti = rnti;
-
   // Use default configuration for non-user C-RNTI
   if (not SRSRAN_RNTI_ISUSER(rnti)) {
-    phy_cfg = default_cfg;
+    phy_cfg = {};
+    phy_cfg.set_defaults();
+    phy_cfg.dl_cfg.pdsch.rnti = rnti;
+    phy_cfg.ul_cfg.pucch.rnti = rnti;
+    phy_cfg.ul_cfg.pusch.rnti = rnti;
     return SRSRAN_SUCCESS;
   }
 
@@ -260,7 +272,7 @@ inline int phy_ue_db::_get_rnti_config(uint16_t rnti, uint32_t enb_cc_idx, srsra
 
 void phy_ue_db::clear_tti_pending_ack(uint32_t tti)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  srsran::rwlock_read_guard lock(rwlock);
 
   // Iterate all UEs
   for (auto& iter : ue_db) {
@@ -270,7 +282,7 @@ void phy_ue_db::clear_tti_pending_ack(uint32_t tti)
 
 void phy_ue_db::addmod_rnti(uint16_t rnti, const phy_interface_rrc_lte::phy_rrc_cfg_list_t& phy_cfg_list)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  srsran::rwlock_write_guard lock(rwlock);
 
   // Create new user if did not exist
   if (ue_db.count(rnti) == 0) {
@@ -346,7 +358,7 @@ void phy_ue_db::addmod_rnti(uint16_t rnti, const phy_interface_rrc_lte::phy_rrc_
 
 int phy_ue_db::rem_rnti(uint16_t rnti)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  srsran::rwlock_write_guard lock(rwlock);
 
   if (ue_db.count(rnti) == 0) {
     return SRSRAN_ERROR;
@@ -371,7 +383,7 @@ uint32_t phy_ue_db::_count_nof_configured_scell(uint16_t rnti)
 
 int phy_ue_db::complete_config(uint16_t rnti)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  srsran::rwlock_write_guard lock(rwlock);
 
   // Makes sure the RNTI exists
   if (_assert_rnti(rnti) != SRSRAN_SUCCESS) {
@@ -393,7 +405,7 @@ int phy_ue_db::complete_config(uint16_t rnti)
 
 int phy_ue_db::activate_deactivate_scell(uint16_t rnti, uint32_t ue_cc_idx, bool activate)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  srsran::rwlock_write_guard lock(rwlock);
 
   // Assert RNTI and SCell are valid
   if (_assert_ue_cc(rnti, ue_cc_idx) != SRSRAN_SUCCESS) {
@@ -415,14 +427,14 @@ int phy_ue_db::activate_deactivate_scell(uint16_t rnti, uint32_t ue_cc_idx, bool
 
 bool phy_ue_db::is_pcell(uint16_t rnti, uint32_t enb_cc_idx) const
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  srsran::rwlock_read_guard lock(rwlock);
   return _assert_enb_pcell(rnti, enb_cc_idx) == SRSRAN_SUCCESS;
 }
 
 int phy_ue_db::get_dl_config(uint16_t rnti, uint32_t enb_cc_idx, srsran_dl_cfg_t& dl_cfg) const
 {
-  std::lock_guard<std::mutex> lock(mutex);
-  srsran::phy_cfg_t           phy_cfg = {};
+  srsran::rwlock_read_guard lock(rwlock);
+  srsran::phy_cfg_t         phy_cfg = {};
 
   if (_get_rnti_config(rnti, enb_cc_idx, phy_cfg) < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
@@ -442,8 +454,8 @@ int phy_ue_db::get_dl_config(uint16_t rnti, uint32_t enb_cc_idx, srsran_dl_cfg_t
 
 int phy_ue_db::get_dci_dl_config(uint16_t rnti, uint32_t enb_cc_idx, srsran_dci_cfg_t& dci_cfg) const
 {
-  std::lock_guard<std::mutex> lock(mutex);
-  srsran::phy_cfg_t           phy_cfg = {};
+  srsran::rwlock_read_guard lock(rwlock);
+  srsran::phy_cfg_t         phy_cfg = {};
 
   if (_get_rnti_config(rnti, enb_cc_idx, phy_cfg) < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
@@ -463,8 +475,8 @@ int phy_ue_db::get_dci_dl_config(uint16_t rnti, uint32_t enb_cc_idx, srsran_dci_
 
 int phy_ue_db::get_ul_config(uint16_t rnti, uint32_t enb_cc_idx, srsran_ul_cfg_t& ul_cfg) const
 {
-  std::lock_guard<std::mutex> lock(mutex);
-  srsran::phy_cfg_t           phy_cfg = {};
+  srsran::rwlock_read_guard lock(rwlock);
+  srsran::phy_cfg_t         phy_cfg = {};
 
   if (_get_rnti_config(rnti, enb_cc_idx, phy_cfg) < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
@@ -476,8 +488,8 @@ int phy_ue_db::get_ul_config(uint16_t rnti, uint32_t enb_cc_idx, srsran_ul_cfg_t
 
 int phy_ue_db::get_dci_ul_config(uint16_t rnti, uint32_t enb_cc_idx, srsran_dci_cfg_t& dci_cfg) const
 {
-  std::lock_guard<std::mutex> lock(mutex);
-  srsran::phy_cfg_t           phy_cfg = {};
+  srsran::rwlock_read_guard lock(rwlock);
+  srsran::phy_cfg_t         phy_cfg = {};
 
   if (_get_rnti_config(rnti, enb_cc_idx, phy_cfg) < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
@@ -489,7 +501,7 @@ int phy_ue_db::get_dci_ul_config(uint16_t rnti, uint32_t enb_cc_idx, srsran_dci_
 
 bool phy_ue_db::set_ack_pending(uint32_t tti, uint32_t enb_cc_idx, const srsran_dci_dl_t& dci)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  srsran::rwlock_read_guard lock(rwlock);
 
   // Assert rnti and cell exits and it is active
   if (_assert_active_enb_cc(dci.rnti, enb_cc_idx) != SRSRAN_SUCCESS) {
@@ -499,7 +511,8 @@ bool phy_ue_db::set_ack_pending(uint32_t tti, uint32_t enb_cc_idx, const srsran_
   common_ue& ue        = ue_db.at(dci.rnti);
   uint32_t   ue_cc_idx = _get_ue_cc_idx(dci.rnti, enb_cc_idx);
 
-  srsran_pdsch_ack_cc_t& pdsch_ack_cc = ue.pdsch_ack[tti].cc[ue_cc_idx];
+  std::lock_guard<std::mutex> tti_lock(ue.tti_mutex[tti]);
+  srsran_pdsch_ack_cc_t&      pdsch_ack_cc = ue.pdsch_ack[tti].cc[ue_cc_idx];
   pdsch_ack_cc.M                      = 1; ///< Hardcoded for FDD
 
   // Fill PDSCH ACK information
@@ -530,7 +543,7 @@ int phy_ue_db::fill_uci_cfg(uint32_t          tti,
                             bool              is_pusch_available,
                             srsran_uci_cfg_t& uci_cfg)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  srsran::rwlock_read_guard lock(rwlock);
 
   // Reset UCI CFG, avoid returning carrying cached information
   uci_cfg = {};
@@ -545,6 +558,10 @@ int phy_ue_db::fill_uci_cfg(uint32_t          tti,
     return SRSRAN_ERROR;
   }
 
+  // The grant availability and the pending ACK of this TTI are only accessed with the TTI slot locked
+  common_ue&                  ue = ue_db.at(rnti);
+  std::lock_guard<std::mutex> tti_lock(ue.tti_mutex[tti]);
+
   // Get the eNb cell/carrier index with lowest serving cell index (ue_cc_idx) that has an available grant.
   uint32_t uci_enb_cc_id         = _get_uci_enb_cc_idx(tti, rnti);
   bool     pusch_grant_available = (uci_enb_cc_id < (uint32_t)cell_cfg_list->size());
@@ -564,7 +581,6 @@ int phy_ue_db::fill_uci_cfg(uint32_t          tti,
     return SRSRAN_SUCCESS;
   }
 
-  common_ue&               ue           = ue_db.at(rnti);
   const srsran::phy_cfg_t& pcell_cfg    = ue.cell_info[0].phy_cfg;
   bool                     uci_required = false;
 
@@ -587,7 +603,8 @@ int phy_ue_db::fill_uci_cfg(uint32_t          tti,
       const srsran_cell_t& cell = cell_cfg_list->at(cell_info.enb_cc_idx).cell;
 
       // Check if CQI report is required
-      periodic_cqi_required = srsran_enb_dl_gen_cqi_periodic(&cell, &dl_cfg, tti, cell_info.last_ri, &uci_cfg.cqi);
+      periodic_cqi_required =
+          srsran_enb_dl_gen_cqi_periodic(&cell, &dl_cfg, tti, _get_last_ri(ue, cell_idx), &uci_cfg.cqi);
 
       // Save SCell index for using it after
       uci_cfg.cqi.scell_index = cell_idx;
@@ -600,7 +617,7 @@ int phy_ue_db::fill_uci_cfg(uint32_t          tti,
     // Aperiodic only supported for PCell
     const srsran_dl_cfg_t& dl_cfg = pcell_info.phy_cfg.dl_cfg;
 
-    uci_required = srsran_enb_dl_gen_cqi_aperiodic(&pcell, &dl_cfg, pcell_info.last_ri, &uci_cfg.cqi);
+    uci_required = srsran_enb_dl_gen_cqi_aperiodic(&pcell, &dl_cfg, _get_last_ri(ue, 0), &uci_cfg.cqi);
   }
 
   // Get pending ACKs from PDSCH
@@ -660,7 +677,7 @@ int phy_ue_db::send_uci_data(uint32_t                  tti,
                              const srsran_uci_cfg_t&   uci_cfg,
                              const srsran_uci_value_t& uci_value)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  srsran::rwlock_read_guard lock(rwlock);
 
   // Assert UE RNTI database entry and eNb cell/carrier must be active
   if (_assert_active_enb_cc(rnti, enb_cc_idx) != SRSRAN_SUCCESS) {
@@ -681,7 +698,8 @@ int phy_ue_db::send_uci_data(uint32_t                  tti,
   common_ue& ue = ue_db.at(rnti);
 
   // Get ACK info
-  srsran_pdsch_ack_t& pdsch_ack = ue.pdsch_ack[tti];
+  std::lock_guard<std::mutex> tti_lock(ue.tti_mutex[tti]);
+  srsran_pdsch_ack_t&         pdsch_ack = ue.pdsch_ack[tti];
   const srsran_cell_t& cell      = cell_cfg_list->at(ue.cell_info[0].enb_cc_idx).cell;
   srsran_enb_dl_get_ack(&cell, &uci_cfg, &uci_value, &pdsch_ack);
 
@@ -736,6 +754,7 @@ int phy_ue_db::send_uci_data(uint32_t                  tti,
   // Rank indicator (TM3 and TM4)
   if (uci_cfg.cqi.ri_len) {
     stack->ri_info(tti, rnti, cqi_cc_idx, uci_value.ri);
+    std::lock_guard<std::mutex> ue_lock(ue.ue_mutex);
     cqi_scell_info.last_ri = uci_value.ri;
   }
 
@@ -744,7 +763,7 @@ int phy_ue_db::send_uci_data(uint32_t                  tti,
 
 int phy_ue_db::set_last_ul_tb(uint16_t rnti, uint32_t enb_cc_idx, uint32_t pid, srsran_ra_tb_t tb)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  srsran::rwlock_read_guard lock(rwlock);
 
   // Assert UE DB entry
   if (_assert_active_enb_cc(rnti, enb_cc_idx) != SRSRAN_SUCCESS) {
@@ -752,14 +771,16 @@ int phy_ue_db::set_last_ul_tb(uint16_t rnti, uint32_t enb_cc_idx, uint32_t pid,
   }
 
   // Save resource allocation
-  ue_db.at(rnti).cell_info[_get_ue_cc_idx(rnti, enb_cc_idx)].last_tb[pid] = tb;
+  common_ue&                  ue = ue_db.at(rnti);
+  std::lock_guard<std::mutex> ue_lock(ue.ue_mutex);
+  ue.cell_info[_get_ue_cc_idx(rnti, enb_cc_idx)].last_tb[pid] = tb;
 
   return SRSRAN_SUCCESS;
 }
 
 int phy_ue_db::get_last_ul_tb(uint16_t rnti, uint32_t enb_cc_idx, uint32_t pid, srsran_ra_tb_t& ra_tb) const
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  srsran::rwlock_read_guard lock(rwlock);
 
   // Assert UE DB entry
   if (_assert_active_enb_cc(rnti, enb_cc_idx) != SRSRAN_SUCCESS) {
@@ -767,18 +788,21 @@ int phy_ue_db::get_last_ul_tb(uint16_t rnti, uint32_t enb_cc_idx, uint32_t pid,
   }
 
   // writes the latest stored UL transmission grant
-  ra_tb = ue_db.at(rnti).cell_info[_get_ue_cc_idx(rnti, enb_cc_idx)].last_tb[pid];
+  const common_ue&            ue = ue_db.at(rnti);
+  std::lock_guard<std::mutex> ue_lock(ue.ue_mutex);
+  ra_tb = ue.cell_info[_get_ue_cc_idx(rnti, enb_cc_idx)].last_tb[pid];
 
   return SRSRAN_SUCCESS;
 }
 
 int phy_ue_db::set_ul_grant_available(uint32_t tti, const stack_interface_phy_lte::ul_sched_list_t& ul_sched_list)
 {
-  int                         ret = SRSRAN_SUCCESS;
-  std::lock_guard<std::mutex> lock(mutex);
+  int                       ret = SRSRAN_SUCCESS;
+  srsran::rwlock_read_guard lock(rwlock);
 
   // Reset all available grants flags for the given TTI
   for (auto& ue : ue_db) {
+    std::lock_guard<std::mutex> tti_lock(ue.second.tti_mutex[tti]);
     for (cell_info_t& cell_info : ue.second.cell_info) {
       cell_info.is_grant_available[tti] = false;
     }
@@ -797,7 +821,9 @@ int phy_ue_db::set_ul_grant_available(uint32_t tti, const stack_interface_phy_lt
         continue;
       }
       // Rise Grant available flag
-      ue_db[rnti].cell_info[_get_ue_cc_idx(rnti, enb_cc_idx)].is_grant_available[tti] = true;
+      common_ue&                  ue = ue_db.at(rnti);
+      std::lock_guard<std::mutex> tti_lock(ue.tti_mutex[tti]);
+      ue.cell_info[_get_ue_cc_idx(rnti, enb_cc_idx)].is_grant_available[tti] = true;
     }
   }
 
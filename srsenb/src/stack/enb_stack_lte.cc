@@ -27,6 +27,8 @@
 #include "srsran/interfaces/enb_x2_interfaces.h"
 #include "srsran/rlc/bearer_mem_pool.h"
 #include "srsran/srslog/event_trace.h"
+#include "srsran/srslog/span_trace.h"
+#include <cinttypes>
 
 using namespace srsran;
 
@@ -100,7 +102,8 @@ int enb_stack_lte::init(const stack_args_t&      args_,
 
   // Set up pcap and trace
   if (args.mac_pcap.enable) {
-    mac_pcap.open(args.mac_pcap.filename);
+    mac_pcap.open(args.mac_pcap.filename, 0, args.mac_pcap.compression_level);
+    mac_pcap.set_max_pdu_len(args.mac_pcap.max_pdu_len);
     mac.start_pcap(&mac_pcap);
   }
 
@@ -113,7 +116,7 @@ int enb_stack_lte::init(const stack_args_t&      args_,
   }
 
   if (args.s1ap_pcap.enable) {
-    s1ap_pcap.open(args.s1ap_pcap.filename.c_str());
+    s1ap_pcap.open(args.s1ap_pcap.filename.c_str(), args.s1ap_pcap.compression_level);
     s1ap.start_pcap(&s1ap_pcap);
   }
 
@@ -171,6 +174,7 @@ void enb_stack_lte::tti_clock()
 
 void enb_stack_lte::tti_clock_impl()
 {
+  trace_span("stack", "stack::tti_clock");
   task_sched.tic();
   rrc.tti_clock();
 }
@@ -224,6 +228,23 @@ bool enb_stack_lte::get_metrics(stack_metrics_t* metrics)
     }
     rrc.get_metrics(metrics.rrc);
     s1ap.get_metrics(metrics.s1ap);
+    if (stack_logger.debug.enabled()) {
+      std::vector<srsran::task_multiqueue::port_metrics_t> queue_metrics;
+      task_sched.get_queue_metrics(queue_metrics);
+      for (uint32_t i = 0; i < queue_metrics.size(); ++i) {
+        const srsran::task_multiqueue::port_metrics_t& q = queue_metrics[i];
+        stack_logger.debug("Task queue %d: depth=%d/%d, max_depth=%d, popped=%" PRIu64 ", rejected=%" PRIu64
+                           ", latency avg=%.1f max=%.1f usec",
+                           i,
+                           q.depth,
+                           q.capacity,
+                           q.max_depth,
+                           q.nof_popped,
+                           q.nof_rejected,
+                           q.avg_latency_us,
+                           q.max_latency_us);
+      }
+    }
     if (not pending_stack_metrics.try_push(metrics)) {
       stack_logger.error("Unable to push metrics to queue");
     }
@@ -0,0 +1,118 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/stack/mac/common/sched_trace_file.h"
+
+namespace srsenb {
+
+const char sched_trace_writer::file_magic[8] = {'S', 'R', 'S', 'S', 'C', 'H', 'E', 'D'};
+
+bool sched_trace_writer::open(const std::string& filename, sched_trace_rat rat, uint32_t layout_signature)
+{
+  close();
+
+  std::lock_guard<std::mutex> lock(mutex);
+  file = fopen(filename.c_str(), "wb");
+  if (file == nullptr) {
+    return false;
+  }
+
+  file_header_t hdr = {};
+  memcpy(hdr.magic, file_magic, sizeof(hdr.magic));
+  hdr.version          = file_version;
+  hdr.rat              = static_cast<uint32_t>(rat);
+  hdr.layout_signature = layout_signature;
+  if (fwrite(&hdr, sizeof(hdr), 1, file) != 1) {
+    fclose(file);
+    file = nullptr;
+    return false;
+  }
+
+  buffer.reserve(2 * flush_threshold);
+  enabled.store(true, std::memory_order_relaxed);
+  return true;
+}
+
+void sched_trace_writer::close()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  if (file == nullptr) {
+    return;
+  }
+  enabled.store(false, std::memory_order_relaxed);
+  flush();
+  fclose(file);
+  file = nullptr;
+}
+
+void sched_trace_writer::flush()
+{
+  if (file != nullptr and not buffer.empty()) {
+    fwrite(buffer.data(), 1, buffer.size(), file);
+  }
+  buffer.clear();
+}
+
+bool sched_trace_reader::open(const std::string& filename)
+{
+  close();
+
+  file = fopen(filename.c_str(), "rb");
+  if (file == nullptr) {
+    return false;
+  }
+
+  sched_trace_writer::file_header_t hdr = {};
+  if (fread(&hdr, sizeof(hdr), 1, file) != 1 or
+      memcmp(hdr.magic, sched_trace_writer::file_magic, sizeof(hdr.magic)) != 0 or
+      hdr.version != sched_trace_writer::file_version) {
+    close();
+    return false;
+  }
+  rat              = static_cast<sched_trace_rat>(hdr.rat);
+  layout_signature = hdr.layout_signature;
+  return true;
+}
+
+void sched_trace_reader::close()
+{
+  if (file != nullptr) {
+    fclose(file);
+    file = nullptr;
+  }
+}
+
+bool sched_trace_reader::read(sched_trace_record& record)
+{
+  if (file == nullptr) {
+    return false;
+  }
+
+  sched_trace_writer::record_header_t hdr = {};
+  if (fread(&hdr, sizeof(hdr), 1, file) != 1) {
+    return false;
+  }
+  record.type = hdr.type;
+  record.payload.resize(hdr.len);
+  return hdr.len == 0 or fread(record.payload.data(), 1, hdr.len, file) == hdr.len;
+}
+
+} // namespace srsenb
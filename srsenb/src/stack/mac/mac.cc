@@ -31,6 +31,7 @@
 #include "srsran/interfaces/enb_rlc_interfaces.h"
 #include "srsran/interfaces/enb_rrc_interface_mac.h"
 #include "srsran/srslog/event_trace.h"
+#include "srsran/srslog/span_trace.h"
 
 // #define WRITE_SIB_PCAP
 using namespace asn1::rrc;
@@ -637,6 +638,7 @@ int mac::get_dl_sched(uint32_t tti_tx_dl, dl_sched_list_t& dl_sched_res_list)
   }
 
   trace_threshold_complete_event("mac::get_dl_sched", "total_time", std::chrono::microseconds(100));
+  trace_span("mac", "mac::get_dl_sched");
   logger.set_context(TTI_SUB(tti_tx_dl, FDD_HARQ_DELAY_UL_MS));
   if (do_padding) {
     add_padding();
@@ -960,6 +962,7 @@ int mac::get_ul_sched(uint32_t tti_tx_ul, ul_sched_list_t& ul_sched_res_list)
   if (!started) {
     return SRSRAN_SUCCESS;
   }
+  trace_span("mac", "mac::get_ul_sched");
 
   logger.set_context(TTI_SUB(tti_tx_ul, FDD_HARQ_DELAY_UL_MS + FDD_HARQ_DELAY_DL_MS));
 
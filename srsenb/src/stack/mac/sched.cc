@@ -25,6 +25,7 @@
 #include "srsenb/hdr/stack/mac/sched.h"
 #include "srsenb/hdr/stack/mac/sched_carrier.h"
 #include "srsenb/hdr/stack/mac/sched_helpers.h"
+#include "srsran/common/rwlock_guard.h"
 #include "srsran/srslog/srslog.h"
 
 #define Console(fmt, ...) srsran::console(fmt, ##__VA_ARGS__)
@@ -40,15 +41,33 @@ namespace srsenb {
  *
  *******************************************************/
 
-sched::sched() {}
+sched::sched()
+{
+  pthread_rwlock_init(&ue_db_rwlock, nullptr);
+}
 
-sched::~sched() {}
+sched::~sched()
+{
+  carrier_executor.reset();
+  pthread_rwlock_destroy(&ue_db_rwlock);
+}
 
 void sched::init(rrc_interface_mac* rrc_, const sched_args_t& sched_cfg_)
 {
   rrc       = rrc_;
   sched_cfg = sched_cfg_;
 
+  if (not sched_cfg.trace_filename.empty()) {
+    if (not trace.open(sched_cfg.trace_filename)) {
+      Error("SCHED: Could not open the trace file %s", sched_cfg.trace_filename.c_str());
+    }
+  }
+  trace.record(sched_trace_event::init, sched_cfg);
+
+  if (sched_cfg.nof_carrier_threads > 0) {
+    carrier_executor.reset(new srsran::task_graph_executor(sched_cfg.nof_carrier_threads));
+  }
+
   // Initialize first carrier scheduler
   carrier_schedulers.emplace_back(new carrier_sched{rrc, &ue_db, 0, &sched_results});
 
@@ -58,9 +77,11 @@ void sched::init(rrc_interface_mac* rrc_, const sched_args_t& sched_cfg_)
 int sched::reset()
 {
   std::lock_guard<std::mutex> lock(sched_mutex);
+  trace.record(sched_trace_event::reset);
   for (std::unique_ptr<carrier_sched>& c : carrier_schedulers) {
     c->reset();
   }
+  srsran::rwlock_write_guard ue_db_lock(ue_db_rwlock);
   ue_db.clear();
   return 0;
 }
@@ -69,6 +90,7 @@ int sched::reset()
 int sched::cell_cfg(const std::vector<sched_interface::cell_cfg_t>& cell_cfg)
 {
   std::lock_guard<std::mutex> lock(sched_mutex);
+  trace.record(sched_trace_event::cell_cfg, cell_cfg);
   // Setup derived config params
   sched_cell_params.resize(cell_cfg.size());
   for (uint32_t cc_idx = 0; cc_idx < cell_cfg.size(); ++cc_idx) {
@@ -108,6 +130,7 @@ int sched::ue_cfg(uint16_t rnti, const sched_interface::ue_cfg_t& ue_cfg)
     std::lock_guard<std::mutex> lock(sched_mutex);
     auto                        it = ue_db.find(rnti);
     if (it != ue_db.end()) {
+      trace.record(sched_trace_event::ue_cfg, rnti, ue_cfg);
       it->second->set_cfg(ue_cfg);
       return SRSRAN_SUCCESS;
     }
@@ -116,6 +139,8 @@ int sched::ue_cfg(uint16_t rnti, const sched_interface::ue_cfg_t& ue_cfg)
   // Add new user case
   std::unique_ptr<sched_ue>   ue{new sched_ue(rnti, sched_cell_params, ue_cfg)};
   std::lock_guard<std::mutex> lock(sched_mutex);
+  trace.record(sched_trace_event::ue_cfg, rnti, ue_cfg);
+  srsran::rwlock_write_guard ue_db_lock(ue_db_rwlock);
   ue_db.insert(rnti, std::move(ue));
   return SRSRAN_SUCCESS;
 }
@@ -123,6 +148,8 @@ int sched::ue_cfg(uint16_t rnti, const sched_interface::ue_cfg_t& ue_cfg)
 int sched::ue_rem(uint16_t rnti)
 {
   std::lock_guard<std::mutex> lock(sched_mutex);
+  trace.record(sched_trace_event::ue_rem, rnti);
+  srsran::rwlock_write_guard ue_db_lock(ue_db_rwlock);
   if (ue_db.contains(rnti)) {
     ue_db.erase(rnti);
   } else {
@@ -140,19 +167,25 @@ bool sched::ue_exists(uint16_t rnti)
 
 void sched::phy_config_enabled(uint16_t rnti, bool enabled)
 {
+  std::lock_guard<std::mutex> lock(sched_mutex);
+  trace.record(sched_trace_event::phy_config_enabled, rnti, enabled);
   // TODO: Check if correct use of last_tti
-  ue_db_access_locked(
+  ue_db_access(
       rnti, [this, enabled](sched_ue& ue) { ue.phy_config_enabled(last_tti, enabled); }, __PRETTY_FUNCTION__);
 }
 
 int sched::bearer_ue_cfg(uint16_t rnti, uint32_t lc_id, const mac_lc_ch_cfg_t& cfg_)
 {
-  return ue_db_access_locked(rnti, [lc_id, cfg_](sched_ue& ue) { ue.set_bearer_cfg(lc_id, cfg_); });
+  std::lock_guard<std::mutex> lock(sched_mutex);
+  trace.record(sched_trace_event::bearer_ue_cfg, rnti, lc_id, cfg_);
+  return ue_db_access(rnti, [lc_id, cfg_](sched_ue& ue) { ue.set_bearer_cfg(lc_id, cfg_); });
 }
 
 int sched::bearer_ue_rem(uint16_t rnti, uint32_t lc_id)
 {
-  return ue_db_access_locked(rnti, [lc_id](sched_ue& ue) { ue.rem_bearer(lc_id); });
+  std::lock_guard<std::mutex> lock(sched_mutex);
+  trace.record(sched_trace_event::bearer_ue_rem, rnti, lc_id);
+  return ue_db_access(rnti, [lc_id](sched_ue& ue) { ue.rem_bearer(lc_id); });
 }
 
 uint32_t sched::get_dl_buffer(uint16_t rnti)
@@ -176,18 +209,39 @@ uint32_t sched::get_ul_buffer(uint16_t rnti)
 
 int sched::dl_rlc_buffer_state(uint16_t rnti, uint32_t lc_id, uint32_t tx_queue, uint32_t prio_tx_queue)
 {
-  return ue_db_access_locked(rnti, [&](sched_ue& ue) { ue.dl_buffer_state(lc_id, tx_queue, prio_tx_queue); });
+  // Buffer state reports do not wait for the scheduling of the current TTI to finish. Only when tracing, they take
+  // sched_mutex, so that the recorded report is ordered with the scheduler call that applies it
+  std::unique_lock<std::mutex> trace_lock(sched_mutex, std::defer_lock);
+  if (trace.is_open()) {
+    trace_lock.lock();
+    trace.record(sched_trace_event::dl_rlc_buffer_state, rnti, lc_id, tx_queue, prio_tx_queue);
+  }
+  srsran::rwlock_read_guard lock(ue_db_rwlock);
+  auto                      it = ue_db.find(rnti);
+  if (it == ue_db.end()) {
+    Error("SCHED: User rnti=0x%x not found.", rnti);
+    return SRSRAN_ERROR;
+  }
+  if (not it->second->push_dl_buffer_state(lc_id, tx_queue, prio_tx_queue)) {
+    Error("SCHED: The provided lcid=%d for rnti=0x%x is not valid", lc_id, rnti);
+    return SRSRAN_ERROR;
+  }
+  return SRSRAN_SUCCESS;
 }
 
 int sched::dl_mac_buffer_state(uint16_t rnti, uint32_t ce_code, uint32_t nof_cmds)
 {
-  return ue_db_access_locked(rnti, [ce_code, nof_cmds](sched_ue& ue) { ue.mac_buffer_state(ce_code, nof_cmds); });
+  std::lock_guard<std::mutex> lock(sched_mutex);
+  trace.record(sched_trace_event::dl_mac_buffer_state, rnti, ce_code, nof_cmds);
+  return ue_db_access(rnti, [ce_code, nof_cmds](sched_ue& ue) { ue.mac_buffer_state(ce_code, nof_cmds); });
 }
 
 int sched::dl_ack_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, uint32_t tb_idx, bool ack)
 {
+  std::lock_guard<std::mutex> lock(sched_mutex);
+  trace.record(sched_trace_event::dl_ack_info, tti_rx, rnti, enb_cc_idx, tb_idx, ack);
   int ret = -1;
-  ue_db_access_locked(
+  ue_db_access(
       rnti,
       [&](sched_ue& ue) { ret = ue.set_ack_info(tti_point{tti_rx}, enb_cc_idx, tb_idx, ack); },
       __PRETTY_FUNCTION__);
@@ -196,31 +250,41 @@ int sched::dl_ack_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, uint
 
 int sched::ul_crc_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, bool crc)
 {
-  return ue_db_access_locked(
+  std::lock_guard<std::mutex> lock(sched_mutex);
+  trace.record(sched_trace_event::ul_crc_info, tti_rx, rnti, enb_cc_idx, crc);
+  return ue_db_access(
       rnti, [tti_rx, enb_cc_idx, crc](sched_ue& ue) { ue.set_ul_crc(tti_point{tti_rx}, enb_cc_idx, crc); });
 }
 
 int sched::dl_ri_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t ri_value)
 {
-  return ue_db_access_locked(
+  std::lock_guard<std::mutex> lock(sched_mutex);
+  trace.record(sched_trace_event::dl_ri_info, tti, rnti, enb_cc_idx, ri_value);
+  return ue_db_access(
       rnti, [tti, enb_cc_idx, ri_value](sched_ue& ue) { ue.set_dl_ri(tti_point{tti}, enb_cc_idx, ri_value); });
 }
 
 int sched::dl_pmi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t pmi_value)
 {
-  return ue_db_access_locked(
+  std::lock_guard<std::mutex> lock(sched_mutex);
+  trace.record(sched_trace_event::dl_pmi_info, tti, rnti, enb_cc_idx, pmi_value);
+  return ue_db_access(
       rnti, [tti, enb_cc_idx, pmi_value](sched_ue& ue) { ue.set_dl_pmi(tti_point{tti}, enb_cc_idx, pmi_value); });
 }
 
 int sched::dl_cqi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t cqi_value)
 {
-  return ue_db_access_locked(
+  std::lock_guard<std::mutex> lock(sched_mutex);
+  trace.record(sched_trace_event::dl_cqi_info, tti, rnti, enb_cc_idx, cqi_value);
+  return ue_db_access(
       rnti, [tti, enb_cc_idx, cqi_value](sched_ue& ue) { ue.set_dl_cqi(tti_point{tti}, enb_cc_idx, cqi_value); });
 }
 
 int sched::dl_sb_cqi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t sb_idx, uint32_t cqi_value)
 {
-  return ue_db_access_locked(rnti, [tti, enb_cc_idx, cqi_value, sb_idx](sched_ue& ue) {
+  std::lock_guard<std::mutex> lock(sched_mutex);
+  trace.record(sched_trace_event::dl_sb_cqi_info, tti, rnti, enb_cc_idx, sb_idx, cqi_value);
+  return ue_db_access(rnti, [tti, enb_cc_idx, cqi_value, sb_idx](sched_ue& ue) {
     ue.set_dl_sb_cqi(tti_point{tti}, enb_cc_idx, sb_idx, cqi_value);
   });
 }
@@ -228,40 +292,66 @@ int sched::dl_sb_cqi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint
 int sched::dl_rach_info(uint32_t enb_cc_idx, dl_sched_rar_info_t rar_info)
 {
   std::lock_guard<std::mutex> lock(sched_mutex);
+  trace.record(sched_trace_event::dl_rach_info, enb_cc_idx, rar_info);
   return carrier_schedulers[enb_cc_idx]->dl_rach_info(rar_info);
 }
 
 int sched::ul_snr_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, float snr, uint32_t ul_ch_code)
 {
-  return ue_db_access_locked(rnti,
-                             [&](sched_ue& ue) { ue.set_ul_snr(tti_point{tti_rx}, enb_cc_idx, snr, ul_ch_code); });
+  std::lock_guard<std::mutex> lock(sched_mutex);
+  trace.record(sched_trace_event::ul_snr_info, tti_rx, rnti, enb_cc_idx, snr, ul_ch_code);
+  return ue_db_access(rnti, [&](sched_ue& ue) { ue.set_ul_snr(tti_point{tti_rx}, enb_cc_idx, snr, ul_ch_code); });
 }
 
 int sched::ul_bsr(uint16_t rnti, uint32_t lcg_id, uint32_t bsr)
 {
-  return ue_db_access_locked(rnti, [lcg_id, bsr](sched_ue& ue) { ue.ul_buffer_state(lcg_id, bsr); });
+  // Buffer state reports do not wait for the scheduling of the current TTI to finish. Only when tracing, they take
+  // sched_mutex, so that the recorded report is ordered with the scheduler call that applies it
+  std::unique_lock<std::mutex> trace_lock(sched_mutex, std::defer_lock);
+  if (trace.is_open()) {
+    trace_lock.lock();
+    trace.record(sched_trace_event::ul_bsr, rnti, lcg_id, bsr);
+  }
+  srsran::rwlock_read_guard lock(ue_db_rwlock);
+  auto                      it = ue_db.find(rnti);
+  if (it == ue_db.end()) {
+    Error("SCHED: User rnti=0x%x not found.", rnti);
+    return SRSRAN_ERROR;
+  }
+  if (not it->second->push_ul_buffer_state(lcg_id, bsr)) {
+    Error("SCHED: The provided lcg_id=%d for rnti=0x%x is not valid", lcg_id, rnti);
+    return SRSRAN_ERROR;
+  }
+  return SRSRAN_SUCCESS;
 }
 
 int sched::ul_buffer_add(uint16_t rnti, uint32_t lcid, uint32_t bytes)
 {
-  return ue_db_access_locked(rnti, [lcid, bytes](sched_ue& ue) { ue.ul_buffer_add(lcid, bytes); });
+  std::lock_guard<std::mutex> lock(sched_mutex);
+  trace.record(sched_trace_event::ul_buffer_add, rnti, lcid, bytes);
+  return ue_db_access(rnti, [lcid, bytes](sched_ue& ue) { ue.ul_buffer_add(lcid, bytes); });
 }
 
 int sched::ul_phr(uint16_t rnti, int phr, uint32_t ul_nof_prb)
 {
-  return ue_db_access_locked(
+  std::lock_guard<std::mutex> lock(sched_mutex);
+  trace.record(sched_trace_event::ul_phr, rnti, phr, ul_nof_prb);
+  return ue_db_access(
       rnti, [phr, ul_nof_prb](sched_ue& ue) { ue.ul_phr(phr, ul_nof_prb); }, __PRETTY_FUNCTION__);
 }
 
 int sched::ul_sr_info(uint32_t tti, uint16_t rnti)
 {
-  return ue_db_access_locked(
+  std::lock_guard<std::mutex> lock(sched_mutex);
+  trace.record(sched_trace_event::ul_sr_info, tti, rnti);
+  return ue_db_access(
       rnti, [](sched_ue& ue) { ue.set_sr(); }, __PRETTY_FUNCTION__);
 }
 
 void sched::set_dl_tti_mask(uint8_t* tti_mask, uint32_t nof_sfs)
 {
   std::lock_guard<std::mutex> lock(sched_mutex);
+  trace.record(sched_trace_event::set_dl_tti_mask, std::vector<uint8_t>(tti_mask, tti_mask + nof_sfs));
   carrier_schedulers[0]->set_dl_tti_mask(tti_mask, nof_sfs);
 }
 
@@ -304,6 +394,7 @@ std::array<int, SRSRAN_MAX_CARRIERS> sched::get_enb_ue_activ_cc_map(uint16_t rnt
 int sched::set_pdcch_order(uint32_t enb_cc_idx, dl_sched_po_info_t pdcch_order_info)
 {
   std::lock_guard<std::mutex> lock(sched_mutex);
+  trace.record(sched_trace_event::set_pdcch_order, enb_cc_idx, pdcch_order_info);
   return carrier_schedulers[enb_cc_idx]->pdcch_order_info(pdcch_order_info);
 }
 
@@ -317,6 +408,7 @@ int sched::set_pdcch_order(uint32_t enb_cc_idx, dl_sched_po_info_t pdcch_order_i
 int sched::dl_sched(uint32_t tti_tx_dl, uint32_t enb_cc_idx, sched_interface::dl_sched_res_t& sched_result)
 {
   std::lock_guard<std::mutex> lock(sched_mutex);
+  trace.record(sched_trace_event::dl_sched, tti_tx_dl, enb_cc_idx);
   if (not configured) {
     return 0;
   }
@@ -337,6 +429,7 @@ int sched::dl_sched(uint32_t tti_tx_dl, uint32_t enb_cc_idx, sched_interface::dl
 int sched::ul_sched(uint32_t tti, uint32_t enb_cc_idx, srsenb::sched_interface::ul_sched_res_t& sched_result)
 {
   std::lock_guard<std::mutex> lock(sched_mutex);
+  trace.record(sched_trace_event::ul_sched, tti, enb_cc_idx);
   if (not configured) {
     return 0;
   }
@@ -361,10 +454,93 @@ void sched::new_tti(tti_point tti_rx)
 {
   last_tti = std::max(last_tti, tti_rx);
 
-  // Generate sched results for all CCs, if not yet generated
+  uint32_t pending_mask = 0;
   for (size_t cc_idx = 0; cc_idx < carrier_schedulers.size(); ++cc_idx) {
     if (not is_generated(tti_rx, cc_idx)) {
-      // Generate carrier scheduling result
+      pending_mask |= 1U << cc_idx;
+    }
+  }
+  if (pending_mask == 0) {
+    return;
+  }
+
+  // Prepare the state shared by all the carriers before scheduling them
+  if (not sched_results.has_sf(tti_rx)) {
+    sched_results.new_tti(tti_rx);
+  }
+  if (not sched_results.has_sf(tti_rx + MSG3_DELAY_MS)) {
+    sched_results.new_tti(tti_rx + MSG3_DELAY_MS);
+  }
+  for (auto& u : ue_db) {
+    u.second->apply_pending_buffer_states();
+    u.second->new_subframe(tti_rx, 0);
+  }
+
+  if (carrier_executor == nullptr) {
+    generate_carriers(tti_rx, pending_mask);
+    return;
+  }
+
+  // The carriers of a UE share its buffers and its UCI is multiplexed in one of them, so carriers linked by a UE (CA)
+  // are scheduled in order by the same task. Each group of carriers is scheduled in parallel with the others
+  std::array<uint32_t, SRSRAN_MAX_CARRIERS> group_mask = {};
+  for (size_t cc_idx = 0; cc_idx < carrier_schedulers.size(); ++cc_idx) {
+    group_mask[cc_idx] = 1U << cc_idx;
+  }
+  for (auto& u : ue_db) {
+    uint32_t ue_mask = 0;
+    for (size_t cc_idx = 0; cc_idx < carrier_schedulers.size(); ++cc_idx) {
+      if (u.second->find_ue_carrier(cc_idx) != nullptr) {
+        ue_mask |= 1U << cc_idx;
+      }
+    }
+    for (size_t cc_idx = 0; cc_idx < carrier_schedulers.size(); ++cc_idx) {
+      if ((ue_mask & (1U << cc_idx)) != 0) {
+        group_mask[cc_idx] |= ue_mask;
+      }
+    }
+  }
+
+  // Close the groups over the carriers they contain (connected components), until no group grows
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (size_t cc_idx = 0; cc_idx < carrier_schedulers.size(); ++cc_idx) {
+      uint32_t merged = group_mask[cc_idx];
+      for (size_t other = 0; other < carrier_schedulers.size(); ++other) {
+        if ((group_mask[cc_idx] & (1U << other)) != 0) {
+          merged |= group_mask[other];
+        }
+      }
+      if (merged != group_mask[cc_idx]) {
+        group_mask[cc_idx] = merged;
+        changed            = true;
+      }
+    }
+  }
+
+  carrier_graph.clear();
+  uint32_t grouped_mask = 0;
+  for (size_t cc_idx = 0; cc_idx < carrier_schedulers.size(); ++cc_idx) {
+    uint32_t cc_mask = group_mask[cc_idx] & pending_mask;
+    if ((pending_mask & (1U << cc_idx)) == 0 or (grouped_mask & (1U << cc_idx)) != 0) {
+      continue;
+    }
+    grouped_mask |= cc_mask;
+    carrier_graph.add_task([this, tti_rx, cc_mask]() { generate_carriers(tti_rx, cc_mask); });
+  }
+  if (carrier_graph.size() == 1) {
+    generate_carriers(tti_rx, pending_mask);
+    return;
+  }
+  carrier_executor->run(carrier_graph);
+}
+
+/// Generate the scheduling results of a set of carriers, in order
+void sched::generate_carriers(tti_point tti_rx, uint32_t cc_mask)
+{
+  for (size_t cc_idx = 0; cc_idx < carrier_schedulers.size(); ++cc_idx) {
+    if ((cc_mask & (1U << cc_idx)) != 0) {
       carrier_schedulers[cc_idx]->generate_tti_result(tti_rx);
     }
   }
@@ -387,8 +563,16 @@ template <typename Func>
 int sched::ue_db_access_locked(uint16_t rnti, Func&& f, const char* func_name, bool log_fail)
 {
   std::lock_guard<std::mutex> lock(sched_mutex);
-  auto                        it = ue_db.find(rnti);
+  return ue_db_access(rnti, std::forward<Func>(f), func_name, log_fail);
+}
+
+template <typename Func>
+int sched::ue_db_access(uint16_t rnti, Func&& f, const char* func_name, bool log_fail)
+{
+  auto it = ue_db.find(rnti);
   if (it != ue_db.end()) {
+    // Keep the order of the events, the buffer states reported before must be visible
+    it->second->apply_pending_buffer_states();
     f(*it->second);
   } else {
     if (log_fail) {
@@ -34,22 +34,28 @@ void sf_sched_result::new_tti(tti_point tti_rx_)
   }
 }
 
-bool sf_sched_result::is_ul_alloc(uint16_t rnti) const
+bool sf_sched_result::is_ul_alloc(const sched_ue& user) const
 {
-  for (const auto& cc : enb_cc_list) {
-    for (const auto& pusch : cc.ul_sched_result.pusch) {
-      if (pusch.dci.rnti == rnti) {
+  for (uint32_t enb_cc_idx = 0; enb_cc_idx < enb_cc_list.size(); ++enb_cc_idx) {
+    if (user.enb_to_ue_cc_idx(enb_cc_idx) < 0) {
+      continue;
+    }
+    for (const auto& pusch : enb_cc_list[enb_cc_idx].ul_sched_result.pusch) {
+      if (pusch.dci.rnti == user.get_rnti()) {
         return true;
       }
     }
   }
   return false;
 }
-bool sf_sched_result::is_dl_alloc(uint16_t rnti) const
+bool sf_sched_result::is_dl_alloc(const sched_ue& user) const
 {
-  for (const auto& cc : enb_cc_list) {
-    for (const auto& data : cc.dl_sched_result.data) {
-      if (data.dci.rnti == rnti) {
+  for (uint32_t enb_cc_idx = 0; enb_cc_idx < enb_cc_list.size(); ++enb_cc_idx) {
+    if (user.enb_to_ue_cc_idx(enb_cc_idx) < 0) {
+      continue;
+    }
+    for (const auto& data : enb_cc_list[enb_cc_idx].dl_sched_result.data) {
+      if (data.dci.rnti == user.get_rnti()) {
         return true;
       }
     }
@@ -280,21 +286,21 @@ alloc_result sf_grid_t::reserve_ul_prbs(const prbmask_t& prbmask, bool strict)
  */
 bool sf_grid_t::find_ul_alloc(uint32_t L, prb_interval* alloc) const
 {
-  *alloc = {};
-  for (uint32_t n = 0; n < ul_mask.size() && alloc->length() < L; n++) {
-    if (not ul_mask.test(n) && alloc->length() == 0) {
-      alloc->displace_to(n);
+  *alloc    = {};
+  int start = ul_mask.find_lowest(0, ul_mask.size(), false);
+  while (start >= 0) {
+    uint32_t max_stop = std::min((uint32_t)ul_mask.size(), start + L);
+    int      stop     = ul_mask.find_lowest(start, max_stop, true);
+    if (stop < 0) {
+      *alloc = {(uint32_t)start, max_stop};
+      break;
     }
-    if (not ul_mask.test(n)) {
-      alloc->resize_by(1);
-    } else if (alloc->length() > 0) {
-      // avoid edges
-      if (n < 3) {
-        *alloc = {};
-      } else {
-        break;
-      }
+    // avoid edges
+    if (stop >= 3) {
+      *alloc = {(uint32_t)start, (uint32_t)stop};
+      break;
     }
+    start = ul_mask.find_lowest(stop, ul_mask.size(), false);
   }
   if (alloc->length() == 0) {
     return false;
@@ -538,7 +544,7 @@ alloc_result sf_sched::alloc_dl_user(sched_ue* user, const rbgmask_t& user_mask,
     }
   }
 
-  bool has_pusch_grant = is_ul_alloc(user->get_rnti()) or cc_results->is_ul_alloc(user->get_rnti());
+  bool has_pusch_grant = is_ul_alloc(user->get_rnti()) or cc_results->is_ul_alloc(*user);
 
   // Check if there is space in the PUCCH for HARQ ACKs
   const sched_interface::ue_cfg_t& ue_cfg    = user->get_ue_cfg();
@@ -822,12 +828,16 @@ uci_pusch_t is_uci_included(const sf_sched*        sf_sched,
   }
 
   for (uint32_t enbccidx = 0; enbccidx < other_cc_results.enb_cc_list.size(); ++enbccidx) {
+    auto p = user->get_active_cell_index(enbccidx);
+    if (not p.first) {
+      // Do not look into the carriers of other UEs, they may be being scheduled in parallel
+      continue;
+    }
     for (uint32_t j = 0; j < other_cc_results.enb_cc_list[enbccidx].ul_sched_result.pusch.size(); ++j) {
       // Checks all the UL grants already allocated for the given rnti
       if (other_cc_results.enb_cc_list[enbccidx].ul_sched_result.pusch[j].dci.rnti == user->get_rnti()) {
-        auto p = user->get_active_cell_index(enbccidx);
         // If the UE CC Idx is the lowest so far
-        if (p.first and p.second < ue_cc_idx) {
+        if (p.second < ue_cc_idx) {
           ue_cc_idx      = p.second;
           sel_enb_cc_idx = enbccidx;
         }
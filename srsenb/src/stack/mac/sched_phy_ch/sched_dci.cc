@@ -24,8 +24,11 @@
 #include "srsenb/hdr/stack/mac/sched_lte_common.h"
 #include "srsran/common/string_helpers.h"
 
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstdint>
+#include <limits>
 
 namespace srsenb {
 
@@ -41,6 +44,112 @@ int coderate_to_tbs(float max_coderate, uint32_t nof_re)
   return static_cast<int>(floorf(nof_re * max_coderate - 24));
 }
 
+namespace {
+
+/**
+ * Lookup tables of TS 36.213 - Tables 7.1.7.1-1/1A, 8.6.1-1 and 7.1.7.2.1-1, derived once from the PHY helpers so
+ * that the MCS/TBS derivation does not search the standard tables for every grant candidate.
+ * The TBS table is not monotonic in I_TBS (e.g. I_TBS=7 for N_prb=1 and I_TBS=26). For each N_prb, only the I_TBS
+ * that can be the result of a "largest I_TBS whose TBS <= max_tbs" search are stored, contiguously and sorted by TBS.
+ * Note: The lists are short and the searched TBS is usually close to their end, so a backwards linear search is faster
+ * than a binary search.
+ */
+class mcs_tbs_table
+{
+public:
+  enum table_id { dl = 0, dl_alt, ul, nof_tables };
+
+  static constexpr uint32_t nof_mcs     = 32;
+  static constexpr uint32_t nof_tbs_idx = SRSRAN_RA_NOF_TBS_IDX;
+
+  static const mcs_tbs_table& get()
+  {
+    static const mcs_tbs_table table;
+    return table;
+  }
+
+  static table_id get_table_id(bool is_ul, bool use_tbs_index_alt)
+  {
+    return is_ul ? ul : (use_tbs_index_alt ? dl_alt : dl);
+  }
+
+  int tbs_idx_from_mcs(table_id t, uint32_t mcs) const { return mcs < nof_mcs ? mcs_to_tbs_idx[t][mcs] : -1; }
+  int mcs_from_tbs_idx(table_id t, uint32_t tbs_idx) const
+  {
+    return tbs_idx < nof_tbs_idx ? tbs_idx_to_mcs[t][tbs_idx] : -1;
+  }
+  uint32_t Qm(table_id t, uint32_t mcs) const { return mcs_to_Qm[t][mcs]; }
+
+  /// TBS in bits. Equivalent to srsran_ra_tbs_from_idx() for valid arguments
+  int tbs(uint32_t tbs_idx, uint32_t nof_prb) const { return tbs_by_prb[nof_prb - 1][tbs_idx]; }
+
+  /// Same result as srsran_ra_tbs_to_table_idx() for max_tbs_idx of 26 (use_tbs_index_alt=false) or 33 (true)
+  int tbs_to_table_idx(uint32_t tbs, uint32_t nof_prb, bool use_tbs_index_alt) const
+  {
+    if (nof_prb == 0 or nof_prb > SRSRAN_MAX_PRB) {
+      return SRSRAN_ERROR_INVALID_INPUTS;
+    }
+    const tbs_search_list& l = search_lists[use_tbs_index_alt ? 1 : 0][nof_prb - 1];
+    for (int i = (int)l.size - 1; i >= 0; --i) {
+      if (l.tbs[i] <= tbs) {
+        return l.tbs_idx[i] + 1;
+      }
+    }
+    return 0;
+  }
+
+private:
+  struct tbs_search_list {
+    std::array<uint32_t, nof_tbs_idx> tbs; ///< Sorted in increasing order
+    std::array<uint8_t, nof_tbs_idx>  tbs_idx;
+    uint32_t                          size = 0;
+  };
+
+  mcs_tbs_table()
+  {
+    for (uint32_t t = 0; t < nof_tables; ++t) {
+      bool is_ul = t == ul, alt = t == dl_alt;
+      for (uint32_t mcs = 0; mcs < nof_mcs; ++mcs) {
+        mcs_to_tbs_idx[t][mcs] = srsran_ra_tbs_idx_from_mcs(mcs, alt, is_ul);
+        srsran_mod_t mod       = is_ul ? srsran_ra_ul_mod_from_mcs(mcs) : srsran_ra_dl_mod_from_mcs(mcs, alt);
+        mcs_to_Qm[t][mcs]      = srsran_mod_bits_x_symbol(mod);
+      }
+      for (uint32_t tbs_idx = 0; tbs_idx < nof_tbs_idx; ++tbs_idx) {
+        tbs_idx_to_mcs[t][tbs_idx] = srsran_ra_mcs_from_tbs_idx(tbs_idx, alt, is_ul);
+      }
+    }
+
+    for (uint32_t nof_prb = 1; nof_prb <= SRSRAN_MAX_PRB; ++nof_prb) {
+      for (uint32_t tbs_idx = 0; tbs_idx < nof_tbs_idx; ++tbs_idx) {
+        tbs_by_prb[nof_prb - 1][tbs_idx] = srsran_ra_tbs_from_idx(tbs_idx, nof_prb);
+      }
+      for (uint32_t i = 0; i < 2; ++i) {
+        // An I_TBS is a possible search result only if its TBS is lower than the TBS of all the higher I_TBS
+        uint32_t         max_tbs_idx = i == 0 ? 26 : 33;
+        tbs_search_list& l           = search_lists[i][nof_prb - 1];
+        uint32_t         min_tbs     = std::numeric_limits<uint32_t>::max();
+        for (int tbs_idx = max_tbs_idx; tbs_idx >= 0; --tbs_idx) {
+          uint32_t tbs = tbs_by_prb[nof_prb - 1][tbs_idx];
+          if (tbs < min_tbs) {
+            l.tbs[l.size]     = tbs;
+            l.tbs_idx[l.size] = tbs_idx;
+            l.size++;
+            min_tbs = tbs;
+          }
+        }
+        std::reverse(l.tbs.begin(), l.tbs.begin() + l.size);
+        std::reverse(l.tbs_idx.begin(), l.tbs_idx.begin() + l.size);
+      }
+    }
+  }
+
+  std::array<std::array<int, nof_mcs>, nof_tables>           mcs_to_tbs_idx;
+  std::array<std::array<int, nof_tbs_idx>, nof_tables>       tbs_idx_to_mcs;
+  std::array<std::array<uint8_t, nof_mcs>, nof_tables>       mcs_to_Qm;
+  std::array<std::array<int, nof_tbs_idx>, SRSRAN_MAX_PRB>   tbs_by_prb;
+  std::array<std::array<tbs_search_list, SRSRAN_MAX_PRB>, 2> search_lists; ///< Without and with 256QAM
+};
+
 /// Compute {mcs, tbs_idx} based on {max_tbs, nof_prb}
 int compute_mcs_from_max_tbs(uint32_t nof_prb,
                              uint32_t max_tbs,
@@ -50,35 +159,36 @@ int compute_mcs_from_max_tbs(uint32_t nof_prb,
                              int&     mcs,
                              int&     tbs_idx)
 {
-  constexpr static std::array<int, 6> forbidden_tbs_idx_alt{1, 3, 5, 7, 9, 26};
+  const mcs_tbs_table&    table    = mcs_tbs_table::get();
+  mcs_tbs_table::table_id table_id = mcs_tbs_table::get_table_id(is_ul, use_tbs_index_alt);
 
   // Compute I_TBS based on max TBS
-  uint32_t max_tbs_idx = (use_tbs_index_alt) ? 33 : 26;
-  tbs_idx              = srsran_ra_tbs_to_table_idx(max_tbs, nof_prb, max_tbs_idx);
+  tbs_idx = table.tbs_to_table_idx(max_tbs, nof_prb, use_tbs_index_alt);
   if (tbs_idx <= 0) {
     return SRSRAN_ERROR;
   }
   --tbs_idx; // get TBS index lower bound
-  if (use_tbs_index_alt and
-      std::find(forbidden_tbs_idx_alt.begin(), forbidden_tbs_idx_alt.end(), tbs_idx) != forbidden_tbs_idx_alt.end()) {
-    // some tbs_idx are invalid for 256QAM. See TS 36.213 - Table 7.1.7.1-1A
+  if (use_tbs_index_alt and (tbs_idx == 26 or (tbs_idx < 10 and tbs_idx % 2 == 1))) {
+    // some tbs_idx are invalid for 256QAM (1, 3, 5, 7, 9 and 26). See TS 36.213 - Table 7.1.7.1-1A
     --tbs_idx;
   }
 
   // Compute I_mcs based on I_TBS. Reverse of TS 36.213 - Table 7.1.7.1-1/1A
-  mcs = srsran_ra_mcs_from_tbs_idx(tbs_idx, use_tbs_index_alt, is_ul);
+  mcs = table.mcs_from_tbs_idx(table_id, tbs_idx);
   if (mcs < 0) {
     return SRSRAN_ERROR;
   }
   if (mcs > (int)max_mcs) {
     // bound mcs
     mcs     = max_mcs;
-    tbs_idx = srsran_ra_tbs_idx_from_mcs(mcs, use_tbs_index_alt, is_ul);
+    tbs_idx = table.tbs_idx_from_mcs(table_id, mcs);
   }
 
   return SRSRAN_SUCCESS;
 }
 
+} // namespace
+
 tbs_info compute_mcs_and_tbs(uint32_t nof_prb,
                              uint32_t nof_re,
                              uint32_t cqi,
@@ -102,6 +212,9 @@ tbs_info compute_mcs_and_tbs(uint32_t nof_prb,
   assert((not is_ul or not use_tbs_index_alt) && "UL cannot use Alt CQI Table");
   assert((is_ul or not ulqam64_enabled) && "DL cannot use UL-QAM64 enable flag");
 
+  const mcs_tbs_table&    table    = mcs_tbs_table::get();
+  mcs_tbs_table::table_id table_id = mcs_tbs_table::get_table_id(is_ul, use_tbs_index_alt);
+
   uint32_t max_Qm = (is_ul) ? (ulqam64_enabled ? 6 : 4) : (use_tbs_index_alt ? 8 : 6);
   max_coderate    = std::min(max_coderate, 0.930F * max_Qm);
 
@@ -126,13 +239,12 @@ tbs_info compute_mcs_and_tbs(uint32_t nof_prb,
     }
 
     // compute real TBS and coderate based on maximum achievable MCS
-    int   tbs      = srsran_ra_tbs_from_idx(tbs_idx, nof_prb);
+    int   tbs      = table.tbs(tbs_idx, nof_prb);
     float coderate = srsran_coderate(tbs, nof_re);
 
     // update max coderate based on mcs
-    srsran_mod_t mod = (is_ul) ? srsran_ra_ul_mod_from_mcs(mcs) : srsran_ra_dl_mod_from_mcs(mcs, use_tbs_index_alt);
-    uint32_t     Qm  = srsran_mod_bits_x_symbol(mod);
-    max_coderate     = std::min(0.930F * Qm, max_coderate);
+    uint32_t Qm  = table.Qm(table_id, mcs);
+    max_coderate = std::min(0.930F * Qm, max_coderate);
 
     if (coderate <= max_coderate) {
       // solution was found
@@ -51,26 +51,17 @@ template <typename RBMask,
               typename std::conditional<std::is_same<RBMask, prbmask_t>::value, prb_interval, rbg_interval>::type>
 RBInterval find_contiguous_interval(const RBMask& in_mask, uint32_t max_size)
 {
-  RBInterval max_interv;
-
-  for (size_t n = 0; n < in_mask.size();) {
-    int pos = in_mask.find_lowest(n, in_mask.size(), false);
-    if (pos < 0) {
-      break;
-    }
+  int pos = in_mask.find_lowest_run(0, in_mask.size(), max_size, false);
+  if (pos >= 0) {
+    return RBInterval(pos, pos + max_size);
+  }
 
-    size_t     max_pos = std::min(in_mask.size(), (size_t)pos + max_size);
-    int        pos2    = in_mask.find_lowest(pos + 1, max_pos, true);
-    RBInterval interv(pos, pos2 < 0 ? max_pos : pos2);
-    if (interv.length() >= max_size) {
-      return interv;
-    }
-    if (interv.length() > max_interv.length()) {
-      max_interv = interv;
-    }
-    n = interv.stop();
+  // No interval is large enough, return the largest one
+  std::pair<int, size_t> run = in_mask.find_longest_run(0, in_mask.size(), false);
+  if (run.first < 0) {
+    return RBInterval();
   }
-  return max_interv;
+  return RBInterval(run.first, run.first + run.second);
 }
 
 rbgmask_t find_available_rbgmask(const rbgmask_t& in_mask, uint32_t max_size)
@@ -83,13 +74,12 @@ rbgmask_t find_available_rbgmask(const rbgmask_t& in_mask, uint32_t max_size)
     return localmask;
   }
 
-  uint32_t i = 0, nof_alloc = 0;
-  for (; i < localmask.size() and nof_alloc < max_size; ++i) {
-    if (localmask.test(i)) {
-      nof_alloc++;
-    }
+  // Keep the max_size lowest free RBGs
+  int pos = -1;
+  for (uint32_t nof_alloc = 0; nof_alloc < max_size; ++nof_alloc) {
+    pos = localmask.find_lowest(pos + 1, localmask.size());
   }
-  localmask.fill(i, localmask.size(), false);
+  localmask.fill(pos + 1, localmask.size(), false);
   return localmask;
 }
 
@@ -37,9 +37,9 @@ void sf_cch_allocator::init(const sched_cell_params_t& cell_params_)
 {
   cc_cfg           = &cell_params_;
   pucch_cfg_common = cc_cfg->pucch_cfg_common;
-  dci_record_list.reserve(16);
-  last_dci_dfs.reserve(16);
-  temp_dci_dfs.reserve(16);
+  dci_record_list.reserve(MAX_NOF_ALLOCS);
+  last_dci_dfs.reserve(MAX_NOF_ALLOCS);
+  temp_dci_dfs.reserve(MAX_NOF_ALLOCS);
 }
 
 void sf_cch_allocator::new_tti(tti_point tti_rx_)
@@ -74,8 +74,13 @@ sf_cch_allocator::get_cce_loc_table(alloc_type_t alloc_type, sched_ue* user, uin
 
 bool sf_cch_allocator::alloc_dci(alloc_type_t alloc_type, uint32_t aggr_idx, sched_ue* user, bool has_pusch_grant)
 {
+  if (nof_allocs() >= MAX_NOF_ALLOCS) {
+    return false;
+  }
+
   temp_dci_dfs.clear();
   uint32_t start_cfix = current_cfix;
+  nof_node_visits     = 0;
 
   alloc_record record;
   record.user       = user;
@@ -134,6 +139,11 @@ bool sf_cch_allocator::get_next_dfs()
       if (current_cfix > current_max_cfix) {
         return false;
       }
+      nof_node_visits = 0;
+    } else if (nof_node_visits >= MAX_DFS_NODE_VISITS) {
+      // The search at this CFI is taking too long. Give up on it and restart the search from the root at a higher CFI
+      last_dci_dfs.clear();
+      continue;
     } else {
       // Attempt to re-add last tree node, but with a higher node child index
       start_child_idx = last_dci_dfs.back().dci_pos_idx + 1;
@@ -161,6 +171,8 @@ bool sf_cch_allocator::alloc_dfs_node(const alloc_record& record, uint32_t start
     return false;
   }
 
+  nof_node_visits++;
+
   tree_node node;
   node.dci_pos_idx = start_dci_idx;
   node.dci_pos.L   = record.aggr_idx;
@@ -170,14 +182,26 @@ bool sf_cch_allocator::alloc_dfs_node(const alloc_record& record, uint32_t start
   if (not last_dci_dfs.empty()) {
     node.total_mask       = last_dci_dfs.back().total_mask;
     node.total_pucch_mask = last_dci_dfs.back().total_pucch_mask;
+    node.total_cce_words  = last_dci_dfs.back().total_cce_words;
   } else {
     node.total_mask.resize(nof_cces());
     node.total_pucch_mask.resize(cc_cfg->nof_prb());
   }
 
+  // The candidates of aggregation level L start at a multiple of L (TS 36.213, 9.1.1), so their CCEs never cross a
+  // word boundary
+  uint32_t nof_cce   = 1U << record.aggr_idx;
+  uint64_t cce_block = (1ULL << nof_cce) - 1U;
+
   for (; node.dci_pos_idx < dci_pos_list.size(); ++node.dci_pos_idx) {
     node.dci_pos.ncce = dci_pos_list[node.dci_pos_idx];
 
+    uint64_t cand_word = cce_block << (node.dci_pos.ncce % 64U);
+    if ((node.total_cce_words[node.dci_pos.ncce / 64U] & cand_word) != 0) {
+      // there is a PDCCH collision. Try another CCE position
+      continue;
+    }
+
     if (record.alloc_type == alloc_type_t::DL_DATA and not record.pusch_uci) {
       // The UE needs to allocate space in PUCCH for HARQ-ACK
       pucch_cfg_common.n_pucch = node.dci_pos.ncce + pucch_cfg_common.N_pucch_1;
@@ -203,15 +227,10 @@ bool sf_cch_allocator::alloc_dfs_node(const alloc_record& record, uint32_t start
       }
     }
 
-    node.current_mask.reset();
-    node.current_mask.fill(node.dci_pos.ncce, node.dci_pos.ncce + (1U << record.aggr_idx));
-    if ((node.total_mask & node.current_mask).any()) {
-      // there is a PDCCH collision. Try another CCE position
-      continue;
-    }
-
     // Allocation successful
+    node.current_mask.fill(node.dci_pos.ncce, node.dci_pos.ncce + nof_cce);
     node.total_mask |= node.current_mask;
+    node.total_cce_words[node.dci_pos.ncce / 64U] |= cand_word;
     if (node.pucch_n_prb >= 0) {
       node.total_pucch_mask.set(node.pucch_n_prb);
     }
@@ -0,0 +1,417 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/stack/mac/sched_trace.h"
+#include "srsenb/hdr/stack/mac/sched.h"
+
+namespace srsenb {
+
+/*******************************************************
+ *          Encoding of the configuration structs
+ *******************************************************/
+
+template <typename Args, typename Visitor>
+static void visit_sched_args_fields(Args& a, Visitor&& v)
+{
+  v(a.sched_policy);
+  v(a.sched_policy_args);
+  v(a.pdsch_mcs);
+  v(a.pdsch_max_mcs);
+  v(a.pusch_mcs);
+  v(a.pusch_max_mcs);
+  v(a.min_nof_ctrl_symbols);
+  v(a.max_nof_ctrl_symbols);
+  v(a.min_aggr_level);
+  v(a.max_aggr_level);
+  v(a.adaptive_aggr_level);
+  v(a.pucch_mux_enabled);
+  v(a.pucch_harq_max_rb);
+  v(a.target_bler);
+  v(a.max_delta_dl_cqi);
+  v(a.max_delta_ul_snr);
+  v(a.adaptive_dl_mcs_step_size);
+  v(a.adaptive_ul_mcs_step_size);
+  v(a.min_tpc_tti_interval);
+  v(a.ul_snr_avg_alpha);
+  v(a.init_ul_snr_value);
+  v(a.init_dl_cqi);
+  v(a.max_sib_coderate);
+  v(a.pdcch_cqi_offset);
+  v(a.nof_carrier_threads);
+}
+
+template <typename Cfg, typename Visitor>
+static void visit_cell_cfg_fields(Cfg& c, Visitor&& v)
+{
+  v(c.cell);
+  v(c.sibs);
+  v(c.si_window_ms);
+  v(c.target_pucch_ul_sinr);
+  v(c.pusch_hopping_cfg);
+  v(c.target_pusch_ul_sinr);
+  v(c.min_phr_thres);
+  v(c.enable_phr_handling);
+  v(c.enable_64qam);
+  v(c.prach_config);
+  v(c.prach_nof_preambles);
+  v(c.prach_freq_offset);
+  v(c.prach_rar_window);
+  v(c.prach_contention_resolution_timer);
+  v(c.maxharq_msg3tx);
+  v(c.n1pucch_an);
+  v(c.delta_pucch_shift);
+  v(c.nrb_pucch);
+  v(c.nrb_cqi);
+  v(c.ncs_an);
+  v(c.srs_subframe_config);
+  v(c.srs_subframe_offset);
+  v(c.srs_bw_config);
+  v(c.scell_list);
+}
+
+template <typename Cfg, typename Visitor>
+static void visit_ue_cfg_fields(Cfg& c, Visitor&& v)
+{
+  v(c.maxharq_tx);
+  v(c.continuous_pusch);
+  v(c.uci_offset);
+  v(c.pucch_cfg);
+  v(c.ue_bearers);
+  v(c.supported_cc_list);
+  v(c.dl_ant_info);
+  v(c.use_tbs_index_alt);
+  v(c.measgap_period);
+  v(c.measgap_offset);
+  v(c.support_ul64qam);
+}
+
+void sched_trace_pack(sched_trace_encoder& enc, const sched_interface::sched_args_t& args)
+{
+  visit_sched_args_fields(args, [&enc](const auto& f) { sched_trace_pack(enc, f); });
+}
+
+bool sched_trace_unpack(sched_trace_decoder& dec, sched_interface::sched_args_t& args)
+{
+  bool ok = true;
+  visit_sched_args_fields(args, [&dec, &ok](auto& f) { ok = ok and sched_trace_unpack(dec, f); });
+  return ok;
+}
+
+void sched_trace_pack(sched_trace_encoder& enc, const sched_interface::cell_cfg_t& cfg)
+{
+  visit_cell_cfg_fields(cfg, [&enc](const auto& f) { sched_trace_pack(enc, f); });
+}
+
+bool sched_trace_unpack(sched_trace_decoder& dec, sched_interface::cell_cfg_t& cfg)
+{
+  bool ok = true;
+  visit_cell_cfg_fields(cfg, [&dec, &ok](auto& f) { ok = ok and sched_trace_unpack(dec, f); });
+  return ok;
+}
+
+void sched_trace_pack(sched_trace_encoder& enc, const sched_interface::ue_cfg_t& cfg)
+{
+  visit_ue_cfg_fields(cfg, [&enc](const auto& f) { sched_trace_pack(enc, f); });
+}
+
+bool sched_trace_unpack(sched_trace_decoder& dec, sched_interface::ue_cfg_t& cfg)
+{
+  bool ok = true;
+  visit_ue_cfg_fields(cfg, [&dec, &ok](auto& f) { ok = ok and sched_trace_unpack(dec, f); });
+  return ok;
+}
+
+uint32_t sched_trace_lte_signature()
+{
+  return sched_trace_layout_signature<srsran_cell_t,
+                                      sched_interface::cell_cfg_sib_t,
+                                      srsran_pusch_hopping_cfg_t,
+                                      sched_interface::cell_cfg_t::scell_cfg_t,
+                                      srsran_uci_offset_cfg_t,
+                                      srsran_pucch_cfg_t,
+                                      mac_lc_ch_cfg_t,
+                                      sched_interface::ue_cfg_t::cc_cfg_t,
+                                      sched_interface::ant_info_ded_t,
+                                      sched_interface::dl_sched_rar_info_t,
+                                      sched_interface::dl_sched_po_info_t>();
+}
+
+/*******************************************************
+ *                   Trace replay
+ *******************************************************/
+
+bool sched_trace_player::play(const sched_trace_record& record)
+{
+  if (record.type >= static_cast<uint32_t>(sched_trace_event::nof_events)) {
+    return false;
+  }
+  event = static_cast<sched_trace_event>(record.type);
+
+  sched_trace_decoder dec(record.payload);
+  uint16_t            rnti = 0;
+  uint32_t            a = 0, b = 0, c = 0;
+  bool                flag = false;
+  switch (event) {
+    case sched_trace_event::init: {
+      sched_interface::sched_args_t args;
+      if (not sched_trace_unpack(dec, args)) {
+        return false;
+      }
+      sched_obj.init(rrc, args);
+      break;
+    }
+    case sched_trace_event::cell_cfg: {
+      std::vector<sched_interface::cell_cfg_t> cell_list;
+      if (not sched_trace_unpack(dec, cell_list)) {
+        return false;
+      }
+      sched_obj.cell_cfg(cell_list);
+      break;
+    }
+    case sched_trace_event::reset:
+      sched_obj.reset();
+      break;
+    case sched_trace_event::ue_cfg: {
+      sched_interface::ue_cfg_t ue_cfg;
+      if (not sched_trace_unpack_all(dec, rnti, ue_cfg)) {
+        return false;
+      }
+      sched_obj.ue_cfg(rnti, ue_cfg);
+      break;
+    }
+    case sched_trace_event::ue_rem:
+      if (not sched_trace_unpack_all(dec, rnti)) {
+        return false;
+      }
+      sched_obj.ue_rem(rnti);
+      break;
+    case sched_trace_event::phy_config_enabled:
+      if (not sched_trace_unpack_all(dec, rnti, flag)) {
+        return false;
+      }
+      sched_obj.phy_config_enabled(rnti, flag);
+      break;
+    case sched_trace_event::bearer_ue_cfg: {
+      mac_lc_ch_cfg_t lc_cfg;
+      if (not sched_trace_unpack_all(dec, rnti, a, lc_cfg)) {
+        return false;
+      }
+      sched_obj.bearer_ue_cfg(rnti, a, lc_cfg);
+      break;
+    }
+    case sched_trace_event::bearer_ue_rem:
+      if (not sched_trace_unpack_all(dec, rnti, a)) {
+        return false;
+      }
+      sched_obj.bearer_ue_rem(rnti, a);
+      break;
+    case sched_trace_event::dl_rlc_buffer_state:
+      if (not sched_trace_unpack_all(dec, rnti, a, b, c)) {
+        return false;
+      }
+      sched_obj.dl_rlc_buffer_state(rnti, a, b, c);
+      break;
+    case sched_trace_event::dl_mac_buffer_state:
+      if (not sched_trace_unpack_all(dec, rnti, a, b)) {
+        return false;
+      }
+      sched_obj.dl_mac_buffer_state(rnti, a, b);
+      break;
+    case sched_trace_event::dl_ack_info:
+      if (not sched_trace_unpack_all(dec, tti, rnti, enb_cc_idx, a, flag)) {
+        return false;
+      }
+      sched_obj.dl_ack_info(tti, rnti, enb_cc_idx, a, flag);
+      break;
+    case sched_trace_event::dl_rach_info: {
+      sched_interface::dl_sched_rar_info_t rar_info;
+      if (not sched_trace_unpack_all(dec, enb_cc_idx, rar_info)) {
+        return false;
+      }
+      sched_obj.dl_rach_info(enb_cc_idx, rar_info);
+      break;
+    }
+    case sched_trace_event::dl_ri_info:
+      if (not sched_trace_unpack_all(dec, tti, rnti, enb_cc_idx, a)) {
+        return false;
+      }
+      sched_obj.dl_ri_info(tti, rnti, enb_cc_idx, a);
+      break;
+    case sched_trace_event::dl_pmi_info:
+      if (not sched_trace_unpack_all(dec, tti, rnti, enb_cc_idx, a)) {
+        return false;
+      }
+      sched_obj.dl_pmi_info(tti, rnti, enb_cc_idx, a);
+      break;
+    case sched_trace_event::dl_cqi_info:
+      if (not sched_trace_unpack_all(dec, tti, rnti, enb_cc_idx, a)) {
+        return false;
+      }
+      sched_obj.dl_cqi_info(tti, rnti, enb_cc_idx, a);
+      break;
+    case sched_trace_event::dl_sb_cqi_info:
+      if (not sched_trace_unpack_all(dec, tti, rnti, enb_cc_idx, a, b)) {
+        return false;
+      }
+      sched_obj.dl_sb_cqi_info(tti, rnti, enb_cc_idx, a, b);
+      break;
+    case sched_trace_event::ul_crc_info:
+      if (not sched_trace_unpack_all(dec, tti, rnti, enb_cc_idx, flag)) {
+        return false;
+      }
+      sched_obj.ul_crc_info(tti, rnti, enb_cc_idx, flag);
+      break;
+    case sched_trace_event::ul_sr_info:
+      if (not sched_trace_unpack_all(dec, tti, rnti)) {
+        return false;
+      }
+      sched_obj.ul_sr_info(tti, rnti);
+      break;
+    case sched_trace_event::ul_bsr:
+      if (not sched_trace_unpack_all(dec, rnti, a, b)) {
+        return false;
+      }
+      sched_obj.ul_bsr(rnti, a, b);
+      break;
+    case sched_trace_event::ul_buffer_add:
+      if (not sched_trace_unpack_all(dec, rnti, a, b)) {
+        return false;
+      }
+      sched_obj.ul_buffer_add(rnti, a, b);
+      break;
+    case sched_trace_event::ul_phr: {
+      int phr = 0;
+      if (not sched_trace_unpack_all(dec, rnti, phr, a)) {
+        return false;
+      }
+      sched_obj.ul_phr(rnti, phr, a);
+      break;
+    }
+    case sched_trace_event::ul_snr_info: {
+      float snr = 0;
+      if (not sched_trace_unpack_all(dec, tti, rnti, enb_cc_idx, snr, a)) {
+        return false;
+      }
+      sched_obj.ul_snr_info(tti, rnti, enb_cc_idx, snr, a);
+      break;
+    }
+    case sched_trace_event::dl_sched:
+      if (not sched_trace_unpack_all(dec, tti, enb_cc_idx)) {
+        return false;
+      }
+      sched_obj.dl_sched(tti, enb_cc_idx, dl_result);
+      break;
+    case sched_trace_event::ul_sched:
+      if (not sched_trace_unpack_all(dec, tti, enb_cc_idx)) {
+        return false;
+      }
+      sched_obj.ul_sched(tti, enb_cc_idx, ul_result);
+      break;
+    case sched_trace_event::set_pdcch_order: {
+      sched_interface::dl_sched_po_info_t po_info;
+      if (not sched_trace_unpack_all(dec, enb_cc_idx, po_info)) {
+        return false;
+      }
+      sched_obj.set_pdcch_order(enb_cc_idx, po_info);
+      break;
+    }
+    case sched_trace_event::set_dl_tti_mask: {
+      std::vector<uint8_t> tti_mask;
+      if (not sched_trace_unpack(dec, tti_mask)) {
+        return false;
+      }
+      sched_obj.set_dl_tti_mask(tti_mask.data(), tti_mask.size());
+      break;
+    }
+    default:
+      return false;
+  }
+
+  return dec.empty();
+}
+
+/*******************************************************
+ *                 Decision summaries
+ *******************************************************/
+
+static uint32_t dci_dl_alloc(const srsran_dci_dl_t& dci)
+{
+  switch (dci.alloc_type) {
+    case SRSRAN_RA_ALLOC_TYPE0:
+      return dci.type0_alloc.rbg_bitmask;
+    case SRSRAN_RA_ALLOC_TYPE1:
+      return dci.type1_alloc.vrb_bitmask;
+    default:
+      return dci.type2_alloc.riv;
+  }
+}
+
+void sched_trace_fmt_dl_result(fmt::memory_buffer&                    buffer,
+                               uint32_t                               tti,
+                               uint32_t                               enb_cc_idx,
+                               const sched_interface::dl_sched_res_t& result)
+{
+  fmt::format_to(buffer, "tti={} cc={} dl: cfi={}", tti, enb_cc_idx, result.cfi);
+  for (const auto& data : result.data) {
+    fmt::format_to(buffer,
+                   " data=0x{:x},{:x},{}/{},{},{}",
+                   data.dci.rnti,
+                   dci_dl_alloc(data.dci),
+                   data.dci.location.L,
+                   data.dci.location.ncce,
+                   data.dci.tb[0].mcs_idx,
+                   data.tbs[0] + data.tbs[1]);
+  }
+  for (const auto& rar : result.rar) {
+    fmt::format_to(
+        buffer, " rar=0x{:x},{:x},{},{}", rar.dci.rnti, dci_dl_alloc(rar.dci), rar.msg3_grant.size(), rar.tbs);
+  }
+  for (const auto& bc : result.bc) {
+    fmt::format_to(buffer, " bc={},{},{:x},{}", (int)bc.type, bc.index, dci_dl_alloc(bc.dci), bc.tbs);
+  }
+  for (const auto& po : result.po) {
+    fmt::format_to(buffer, " po=0x{:x},{}", po.crnti, po.preamble_idx);
+  }
+  fmt::format_to(buffer, "\n");
+}
+
+void sched_trace_fmt_ul_result(fmt::memory_buffer&                    buffer,
+                               uint32_t                               tti,
+                               uint32_t                               enb_cc_idx,
+                               const sched_interface::ul_sched_res_t& result)
+{
+  fmt::format_to(buffer, "tti={} cc={} ul:", tti, enb_cc_idx);
+  for (const auto& pusch : result.pusch) {
+    fmt::format_to(buffer,
+                   " pusch=0x{:x},{:x},{},{},{}",
+                   pusch.dci.rnti,
+                   pusch.dci.type2_alloc.riv,
+                   pusch.dci.tb.mcs_idx,
+                   pusch.tbs,
+                   pusch.needs_pdcch ? "pdcch" : "nopdcch");
+  }
+  for (const auto& phich : result.phich) {
+    fmt::format_to(buffer, " phich=0x{:x},{}", phich.rnti, phich.phich == sched_interface::ul_sched_phich_t::ACK);
+  }
+  fmt::format_to(buffer, "\n");
+}
+
+} // namespace srsenb
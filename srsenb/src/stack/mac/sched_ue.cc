@@ -44,6 +44,13 @@ namespace srsenb {
 sched_ue::sched_ue(uint16_t rnti_, const std::vector<sched_cell_params_t>& cell_list_params_, const ue_cfg_t& cfg_) :
   logger(srslog::fetch_basic_logger("MAC")), rnti(rnti_), lch_handler(rnti_)
 {
+  for (auto& bs : pending_dl_bs) {
+    bs.store(no_pending_dl_bs, std::memory_order_relaxed);
+  }
+  for (auto& bsr : pending_ul_bsr) {
+    bsr.store(no_pending_ul_bsr, std::memory_order_relaxed);
+  }
+
   cells.reserve(cell_list_params_.size());
   for (auto& c : cell_list_params_) {
     cells.emplace_back(rnti_, c, current_tti);
@@ -150,6 +157,43 @@ void sched_ue::dl_buffer_state(uint8_t lc_id, uint32_t tx_queue, uint32_t retx_q
   lch_handler.dl_buffer_state(lc_id, tx_queue, retx_queue);
 }
 
+bool sched_ue::push_dl_buffer_state(uint8_t lc_id, uint32_t tx_queue, uint32_t retx_queue)
+{
+  if (lc_id >= pending_dl_bs.size()) {
+    return false;
+  }
+  pending_dl_bs[lc_id].store(((uint64_t)retx_queue << 32U) | tx_queue, std::memory_order_release);
+  return true;
+}
+
+bool sched_ue::push_ul_buffer_state(uint8_t lcg_id, uint32_t bsr)
+{
+  if (lcg_id >= pending_ul_bsr.size()) {
+    return false;
+  }
+  pending_ul_bsr[lcg_id].store(bsr, std::memory_order_release);
+  return true;
+}
+
+void sched_ue::apply_pending_buffer_states()
+{
+  // Each report is taken by swapping the no_pending value in, so it is applied exactly once. A report pushed after the
+  // swap stays in its slot for the next call
+  for (uint32_t lcid = 0; lcid < pending_dl_bs.size(); ++lcid) {
+    if (pending_dl_bs[lcid].load(std::memory_order_relaxed) == no_pending_dl_bs) {
+      continue;
+    }
+    uint64_t bs = pending_dl_bs[lcid].exchange(no_pending_dl_bs, std::memory_order_acquire);
+    dl_buffer_state(lcid, (uint32_t)bs, (uint32_t)(bs >> 32U));
+  }
+  for (uint32_t lcg = 0; lcg < pending_ul_bsr.size(); ++lcg) {
+    if (pending_ul_bsr[lcg].load(std::memory_order_relaxed) == no_pending_ul_bsr) {
+      continue;
+    }
+    ul_buffer_state(lcg, pending_ul_bsr[lcg].exchange(no_pending_ul_bsr, std::memory_order_acquire));
+  }
+}
+
 void sched_ue::mac_buffer_state(uint32_t ce_code, uint32_t nof_cmds)
 {
   auto cmd = (lch_ue_manager::ce_cmd)ce_code;
@@ -57,16 +57,14 @@ sched_ue_cell::sched_ue_cell(uint16_t rnti_, const sched_cell_params_t& cell_cfg
   fixed_mcs_ul(cell_cfg_.sched_cfg->pusch_mcs),
   current_tti(current_tti_),
   max_aggr_level(cell_cfg_.sched_cfg->max_aggr_level >= 0 ? cell_cfg_.sched_cfg->max_aggr_level : 3),
+  dl_olla(cell_cfg_.sched_cfg->target_bler,
+          cell_cfg_.sched_cfg->adaptive_dl_mcs_step_size,
+          cell_cfg_.sched_cfg->max_delta_dl_cqi),
+  ul_olla(cell_cfg_.sched_cfg->target_bler,
+          cell_cfg_.sched_cfg->adaptive_ul_mcs_step_size,
+          cell_cfg_.sched_cfg->max_delta_ul_snr),
   dl_cqi_ctxt(cell_cfg_.nof_prb(), 0, cell_cfg_.sched_cfg->init_dl_cqi)
-{
-  float target_bler = cell_cfg->sched_cfg->target_bler;
-  dl_delta_inc      = cell_cfg->sched_cfg->adaptive_dl_mcs_step_size; // delta_{down} of OLLA
-  dl_delta_dec      = (1 - target_bler) * dl_delta_inc / target_bler;
-  ul_delta_inc      = cell_cfg->sched_cfg->adaptive_ul_mcs_step_size; // delta_{down} of OLLA
-  ul_delta_dec      = (1 - target_bler) * ul_delta_inc / target_bler;
-  max_cqi_coeff     = cell_cfg->sched_cfg->max_delta_dl_cqi;
-  max_snr_coeff     = cell_cfg->sched_cfg->max_delta_ul_snr;
-}
+{}
 
 void sched_ue_cell::set_ue_cfg(const sched_interface::ue_cfg_t& ue_cfg_)
 {
@@ -213,20 +211,16 @@ int sched_ue_cell::set_ul_crc(tti_point tti_rx, bool crc_res)
   CHECK_VALID_CC("UL CRC");
 
   // Adapt UL MCS based on BLER
-  if (cell_cfg->sched_cfg->target_bler > 0 and fixed_mcs_ul < 0) {
+  if (ul_olla.enabled() and fixed_mcs_ul < 0) {
     auto* ul_harq = harq_ent.get_ul_harq(tti_rx);
     if (ul_harq != nullptr) {
       int mcs = ul_harq->get_mcs(0);
-      // Note: Avoid keeping increasing the snr delta offset, if MCS is already is at its limit
-      float delta_dec_eff = mcs <= 0 ? 0 : ul_delta_dec;
-      float delta_inc_eff = mcs >= (int)max_mcs_ul ? 0 : ul_delta_inc;
-      ul_snr_coeff += crc_res ? delta_inc_eff : -delta_dec_eff;
-      ul_snr_coeff = std::min(std::max(-max_snr_coeff, ul_snr_coeff), max_snr_coeff);
+      ul_olla.update(crc_res, mcs, (int)max_mcs_ul);
       logger.info("SCHED: UL adaptive link: rnti=0x%x, snr_estim=%.2f, last_mcs=%d, snr_offset=%f",
                   rnti,
                   tpc_fsm.get_ul_snr_estim(),
                   mcs,
-                  ul_snr_coeff);
+                  ul_olla.offset());
     }
   }
 
@@ -252,18 +246,14 @@ int sched_ue_cell::set_ack_info(tti_point tti_rx, uint32_t tb_idx, bool ack)
   }
 
   // Adapt DL MCS based on BLER
-  if (cell_cfg->sched_cfg->target_bler > 0 and fixed_mcs_dl < 0) {
+  if (dl_olla.enabled() and fixed_mcs_dl < 0) {
     int mcs = std::get<2>(p2);
-    // Note: Avoid keeping increasing the snr delta offset, if MCS is already is at its limit
-    float delta_dec_eff = mcs <= 0 ? 0 : dl_delta_dec;
-    float delta_inc_eff = mcs >= (int)max_mcs_dl ? 0 : dl_delta_inc;
-    dl_cqi_coeff += ack ? delta_inc_eff : -delta_dec_eff;
-    dl_cqi_coeff = std::min(std::max(-max_cqi_coeff, dl_cqi_coeff), max_cqi_coeff);
+    dl_olla.update(ack, mcs, (int)max_mcs_dl);
     logger.info("SCHED: DL adaptive link: rnti=0x%x, cqi=%d, last_mcs=%d, cqi_offset=%f",
                 rnti,
                 dl_cqi_ctxt.get_avg_cqi(),
                 mcs,
-                dl_cqi_coeff);
+                dl_olla.offset());
   }
   return tbs_acked;
 }
@@ -288,19 +278,19 @@ int sched_ue_cell::get_ul_cqi() const
     return 1;
   }
   float snr = tpc_fsm.get_ul_snr_estim();
-  return srsran_cqi_from_snr(snr + ul_snr_coeff);
+  return srsran_cqi_from_snr(snr + ul_olla.offset());
 }
 
 int sched_ue_cell::get_dl_cqi(const rbgmask_t& rbgs) const
 {
   int min_cqi;
   find_min_cqi_rbgs(rbgs, dl_cqi_ctxt, min_cqi);
-  return std::max(0, (int)std::min(static_cast<float>(min_cqi) + dl_cqi_coeff, 15.0f));
+  return std::max(0, (int)std::min(static_cast<float>(min_cqi) + dl_olla.offset(), 15.0f));
 }
 
 int sched_ue_cell::get_dl_cqi() const
 {
-  return std::max(0, (int)std::min(dl_cqi_ctxt.get_avg_cqi() + dl_cqi_coeff, 15.0f));
+  return std::max(0, (int)std::min(dl_cqi_ctxt.get_avg_cqi() + dl_olla.offset(), 15.0f));
 }
 
 uint32_t sched_ue_cell::get_aggr_level(uint32_t nof_bits) const
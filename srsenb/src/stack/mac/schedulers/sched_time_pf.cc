@@ -20,59 +20,125 @@
  */
 
 #include "srsenb/hdr/stack/mac/schedulers/sched_time_pf.h"
+#include <algorithm>
+#include <cmath>
 #include <vector>
 
 namespace srsenb {
 
 using srsran::tti_point;
 
+/// Above this value, the scaled rates are brought back to their real value
+static const double max_rate_scale = 1e9;
+
 sched_time_pf::sched_time_pf(const sched_cell_params_t& cell_params_, const sched_interface::sched_args_t& sched_args)
 {
   cc_cfg = &cell_params_;
+  // Format: "<fairness_coeff>[,<avg_alpha>]"
   if (not sched_args.sched_policy_args.empty()) {
-    fairness_coeff = std::stof(sched_args.sched_policy_args);
+    fairness_coeff   = std::stof(sched_args.sched_policy_args);
+    size_t comma_pos = sched_args.sched_policy_args.find(',');
+    if (comma_pos != std::string::npos) {
+      avg_alpha = std::stof(sched_args.sched_policy_args.substr(comma_pos + 1));
+    }
   }
-
-  std::vector<ue_ctxt*> dl_storage;
-  dl_storage.reserve(SRSENB_MAX_UES);
-  dl_queue = ue_dl_queue_t(ue_dl_prio_compare{}, std::move(dl_storage));
-
-  std::vector<ue_ctxt*> ul_storage;
-  ul_storage.reserve(SRSENB_MAX_UES);
-  ul_queue = ue_ul_queue_t(ue_ul_prio_compare{}, std::move(ul_storage));
+  if (avg_alpha <= 0 or avg_alpha >= 1) {
+    logger.warning("SCHED: Invalid PF averaging coefficient %f. Using 0.01", avg_alpha);
+    avg_alpha = 0.01;
+  }
+  warmup_ttis = static_cast<uint32_t>(std::ceil(1 / avg_alpha));
 }
 
 void sched_time_pf::new_tti(sched_ue_list& ue_db, sf_sched* tti_sched)
 {
-  while (not dl_queue.empty()) {
-    dl_queue.pop();
-  }
-  while (not ul_queue.empty()) {
-    ul_queue.pop();
-  }
   current_tti_rx = tti_point{tti_sched->get_tti_rx()};
+  dl_retx_list.clear();
+  ul_retx_list.clear();
+
   // remove deleted users from history
   for (auto it = ue_history_db.begin(); it != ue_history_db.end();) {
     if (not ue_db.contains(it->first)) {
-      it = ue_history_db.erase(it);
+      dl_heap.erase(heap_index(it->first));
+      ul_heap.erase(heap_index(it->first));
+      ue_by_index[heap_index(it->first)] = nullptr;
+      it                                 = ue_history_db.erase(it);
     } else {
       ++it;
     }
   }
-  // add new users to history db, and update priority queues
+
+  // Decay the averaged rates of all the UEs at once
+  rate_scale /= 1 - avg_alpha;
+  if (rate_scale > max_rate_scale) {
+    rescale_rates();
+  }
+
+  // add new users to history db, and update the metrics of the UEs whose CQI changed
   for (auto& u : ue_db) {
     auto it = ue_history_db.find(u.first);
     if (it == ue_history_db.end()) {
-      it = ue_history_db.insert(u.first, ue_ctxt{u.first, fairness_coeff}).value();
+      it                             = ue_history_db.insert(u.first, ue_ctxt{u.first}).value();
+      ue_by_index[heap_index(u.first)] = &it->second;
+    }
+    ue_ctxt& ue     = it->second;
+    uint32_t idx    = heap_index(ue.rnti);
+    float    dl_old = ue.dl_rate, ul_old = ue.ul_rate;
+    ue.new_tti(*cc_cfg, *u.second, tti_sched);
+    if (ue.ue_cc_idx < 0) {
+      dl_heap.erase(idx);
+      ul_heap.erase(idx);
+      continue;
+    }
+
+    // The mean of a warming up UE changes every TTI, it does not follow the common decay
+    if (ue.nof_samples <= warmup_ttis) {
+      ue.nof_samples++;
+    }
+    bool warmup = ue.nof_samples <= warmup_ttis;
+    if (warmup) {
+      ue.dl_avg_rate = ue.dl_sum / ue.nof_samples * rate_scale;
+      ue.ul_avg_rate = ue.ul_sum / ue.nof_samples * rate_scale;
+    }
+    if (warmup or not dl_heap.contains(idx) or ue.dl_rate != dl_old) {
+      dl_heap.set(idx, ue.dl_metric(fairness_coeff));
     }
-    it->second.new_tti(*cc_cfg, *u.second, tti_sched);
-    if (it->second.dl_newtx_h != nullptr or it->second.dl_retx_h != nullptr) {
-      dl_queue.push(&it->second);
+    if (warmup or not ul_heap.contains(idx) or ue.ul_rate != ul_old) {
+      ul_heap.set(idx, ue.ul_metric(fairness_coeff));
     }
-    if (it->second.ul_h != nullptr) {
-      ul_queue.push(&it->second);
+    if (ue.dl_retx_h != nullptr) {
+      dl_retx_list.push_back(&ue);
+    }
+    if (ue.ul_retx_h != nullptr) {
+      ul_retx_list.push_back(&ue);
+    }
+  }
+
+  // Retransmissions are served in PF order too
+  auto dl_cmp = [this](const ue_ctxt* lhs, const ue_ctxt* rhs) {
+    return dl_heap.key(heap_index(lhs->rnti)) > dl_heap.key(heap_index(rhs->rnti));
+  };
+  std::sort(dl_retx_list.begin(), dl_retx_list.end(), dl_cmp);
+  auto ul_cmp = [this](const ue_ctxt* lhs, const ue_ctxt* rhs) {
+    return ul_heap.key(heap_index(lhs->rnti)) > ul_heap.key(heap_index(rhs->rnti));
+  };
+  std::sort(ul_retx_list.begin(), ul_retx_list.end(), ul_cmp);
+}
+
+void sched_time_pf::rescale_rates()
+{
+  for (auto& u : ue_history_db) {
+    ue_ctxt& ue = u.second;
+    ue.dl_avg_rate /= rate_scale;
+    ue.ul_avg_rate /= rate_scale;
+    uint32_t idx = heap_index(ue.rnti);
+    if (dl_heap.contains(idx)) {
+      dl_heap.set(idx, ue.dl_metric(fairness_coeff));
+    }
+    if (ul_heap.contains(idx)) {
+      ul_heap.set(idx, ue.ul_metric(fairness_coeff));
     }
   }
+  rate_scale = 1;
 }
 
 /*****************************************************************
@@ -86,10 +152,22 @@ void sched_time_pf::sched_dl_users(sched_ue_list& ue_db, sf_sched* tti_sched)
     new_tti(ue_db, tti_sched);
   }
 
-  while (not dl_queue.empty()) {
-    ue_ctxt& ue = *dl_queue.top();
-    ue.save_dl_alloc(try_dl_alloc(ue, *ue_db[ue.rnti], tti_sched), 0.01);
-    dl_queue.pop();
+  for (ue_ctxt* ue : dl_retx_list) {
+    save_dl_alloc(*ue, try_dl_alloc(*ue, *ue_db[ue->rnti], tti_sched));
+  }
+
+  // New transmissions in PF order, until the RBGs are exhausted
+  popped_list.clear();
+  while (not dl_heap.empty() and not tti_sched->get_dl_mask().all()) {
+    ue_ctxt& ue = *ue_by_index[dl_heap.top()];
+    dl_heap.pop();
+    popped_list.push_back(&ue);
+    if (ue.dl_retx_h == nullptr) {
+      save_dl_alloc(ue, try_dl_alloc(ue, *ue_db[ue.rnti], tti_sched));
+    }
+  }
+  for (ue_ctxt* ue : popped_list) {
+    dl_heap.set(heap_index(ue->rnti), ue->dl_metric(fairness_coeff));
   }
 }
 
@@ -104,9 +182,13 @@ uint32_t sched_time_pf::try_dl_alloc(ue_ctxt& ue_ctxt, sched_ue& ue, sf_sched* t
   }
 
   // There is space in PDCCH and an available DL HARQ
-  if (code != alloc_result::no_cch_space and ue_ctxt.dl_newtx_h != nullptr) {
+  if (code != alloc_result::no_cch_space) {
+    const dl_harq_proc* newtx_h = get_dl_newtx_harq(ue, tti_sched);
+    if (newtx_h == nullptr) {
+      return 0;
+    }
     rbgmask_t alloc_mask;
-    code = try_dl_newtx_alloc_greedy(*tti_sched, ue, *ue_ctxt.dl_newtx_h, &alloc_mask);
+    code = try_dl_newtx_alloc_greedy(*tti_sched, ue, *newtx_h, &alloc_mask);
     if (code == alloc_result::success) {
       return ue.get_expected_dl_bitrate(cc_cfg->enb_cc_idx, alloc_mask.count()) * tti_duration_ms / 8;
     }
@@ -114,6 +196,23 @@ uint32_t sched_time_pf::try_dl_alloc(ue_ctxt& ue_ctxt, sched_ue& ue, sf_sched* t
   return 0;
 }
 
+void sched_time_pf::save_dl_alloc(ue_ctxt& ue, uint32_t alloc_bytes)
+{
+  if (alloc_bytes == 0) {
+    return;
+  }
+  if (ue.nof_samples <= warmup_ttis) {
+    ue.dl_sum += alloc_bytes;
+    ue.dl_avg_rate = ue.dl_sum / ue.nof_samples * rate_scale;
+  } else {
+    ue.dl_avg_rate += avg_alpha * alloc_bytes * rate_scale;
+  }
+  uint32_t idx = heap_index(ue.rnti);
+  if (dl_heap.contains(idx)) {
+    dl_heap.set(idx, ue.dl_metric(fairness_coeff));
+  }
+}
+
 /*****************************************************************
  *                         Uplink
  *****************************************************************/
@@ -125,29 +224,42 @@ void sched_time_pf::sched_ul_users(sched_ue_list& ue_db, sf_sched* tti_sched)
     new_tti(ue_db, tti_sched);
   }
 
-  while (not ul_queue.empty()) {
-    ue_ctxt& ue = *ul_queue.top();
-    ue.save_ul_alloc(try_ul_alloc(ue, *ue_db[ue.rnti], tti_sched), 0.01);
-    ul_queue.pop();
+  for (ue_ctxt* ue : ul_retx_list) {
+    save_ul_alloc(*ue, try_ul_alloc(*ue, *ue_db[ue->rnti], tti_sched, ue->ul_retx_h));
+  }
+
+  // New transmissions in PF order, until the PRBs are exhausted
+  popped_list.clear();
+  while (not ul_heap.empty() and not tti_sched->get_ul_mask().all()) {
+    ue_ctxt& ue = *ue_by_index[ul_heap.top()];
+    ul_heap.pop();
+    popped_list.push_back(&ue);
+    if (ue.ul_retx_h == nullptr) {
+      sched_ue& user = *ue_db[ue.rnti];
+      save_ul_alloc(ue, try_ul_alloc(ue, user, tti_sched, get_ul_newtx_harq(user, tti_sched)));
+    }
+  }
+  for (ue_ctxt* ue : popped_list) {
+    ul_heap.set(heap_index(ue->rnti), ue->ul_metric(fairness_coeff));
   }
 }
 
-uint32_t sched_time_pf::try_ul_alloc(ue_ctxt& ue_ctxt, sched_ue& ue, sf_sched* tti_sched)
+uint32_t sched_time_pf::try_ul_alloc(ue_ctxt& ue_ctxt, sched_ue& ue, sf_sched* tti_sched, const ul_harq_proc* h)
 {
-  if (ue_ctxt.ul_h == nullptr) {
+  if (h == nullptr) {
     // In case the UL HARQ could not be allocated (e.g. meas gap occurrence)
     return 0;
   }
   if (tti_sched->is_ul_alloc(ue_ctxt.rnti)) {
     // NOTE: An UL grant could have been previously allocated for UCI
-    return ue_ctxt.ul_h->get_pending_data();
+    return h->get_pending_data();
   }
 
   alloc_result code;
   uint32_t     estim_tbs_bytes = 0;
-  if (ue_ctxt.ul_h->has_pending_retx()) {
-    code            = try_ul_retx_alloc(*tti_sched, ue, *ue_ctxt.ul_h);
-    estim_tbs_bytes = code == alloc_result::success ? ue_ctxt.ul_h->get_pending_data() : 0;
+  if (h->has_pending_retx()) {
+    code            = try_ul_retx_alloc(*tti_sched, ue, *h);
+    estim_tbs_bytes = code == alloc_result::success ? h->get_pending_data() : 0;
   } else {
     // Note: h->is_empty check is required, in case CA allocated a small UL grant for UCI
     uint32_t pending_data = ue.get_pending_ul_new_data(tti_sched->get_tti_tx_ul(), cc_cfg->enb_cc_idx);
@@ -168,78 +280,64 @@ uint32_t sched_time_pf::try_ul_alloc(ue_ctxt& ue_ctxt, sched_ue& ue, sf_sched* t
   return estim_tbs_bytes;
 }
 
+void sched_time_pf::save_ul_alloc(ue_ctxt& ue, uint32_t alloc_bytes)
+{
+  if (alloc_bytes == 0) {
+    return;
+  }
+  if (ue.nof_samples <= warmup_ttis) {
+    ue.ul_sum += alloc_bytes;
+    ue.ul_avg_rate = ue.ul_sum / ue.nof_samples * rate_scale;
+  } else {
+    ue.ul_avg_rate += avg_alpha * alloc_bytes * rate_scale;
+  }
+  uint32_t idx = heap_index(ue.rnti);
+  if (ul_heap.contains(idx)) {
+    ul_heap.set(idx, ue.ul_metric(fairness_coeff));
+  }
+}
+
 /*****************************************************************
  *                          UE history
  *****************************************************************/
 
 void sched_time_pf::ue_ctxt::new_tti(const sched_cell_params_t& cell, sched_ue& ue, sf_sched* tti_sched)
 {
-  dl_retx_h  = nullptr;
-  dl_newtx_h = nullptr;
-  ul_h       = nullptr;
-  dl_prio    = 0;
-  ue_cc_idx  = ue.enb_to_ue_cc_idx(cell.enb_cc_idx);
+  dl_retx_h = nullptr;
+  ul_retx_h = nullptr;
+  ue_cc_idx = ue.enb_to_ue_cc_idx(cell.enb_cc_idx);
   if (ue_cc_idx < 0) {
     // not active
     return;
   }
 
-  // Calculate DL priority
-  dl_retx_h  = get_dl_retx_harq(ue, tti_sched);
-  dl_newtx_h = get_dl_newtx_harq(ue, tti_sched);
-  if (dl_retx_h != nullptr or dl_newtx_h != nullptr) {
-    // calculate DL PF priority
-    float r = ue.get_expected_dl_bitrate(cell.enb_cc_idx) / 8;
-    float R = dl_avg_rate();
-    dl_prio = (R != 0) ? r / pow(R, fairness_coeff) : (r == 0 ? 0 : std::numeric_limits<float>::max());
+  // The expected rates are only derived again when the CQI changes
+  const sched_ue_cell* ue_cell = ue.find_ue_carrier(cell.enb_cc_idx);
+  int                  cqi     = ue_cell->get_dl_cqi();
+  if (cqi != dl_cqi) {
+    dl_cqi  = cqi;
+    dl_rate = ue.get_expected_dl_bitrate(cell.enb_cc_idx) / 8;
   }
-
-  // Calculate UL priority
-  ul_h = get_ul_retx_harq(ue, tti_sched);
-  if (ul_h == nullptr) {
-    ul_h = get_ul_newtx_harq(ue, tti_sched);
-  }
-  if (ul_h != nullptr) {
-    float r = ue.get_expected_ul_bitrate(cell.enb_cc_idx) / 8;
-    float R = ul_avg_rate();
-    ul_prio = (R != 0) ? r / pow(R, fairness_coeff) : (r == 0 ? 0 : std::numeric_limits<float>::max());
+  cqi = ue_cell->get_ul_cqi();
+  if (cqi != ul_cqi) {
+    ul_cqi  = cqi;
+    ul_rate = ue.get_expected_ul_bitrate(cell.enb_cc_idx) / 8;
   }
-}
 
-void sched_time_pf::ue_ctxt::save_dl_alloc(uint32_t alloc_bytes, float exp_avg_alpha)
-{
-  if (dl_nof_samples < 1 / exp_avg_alpha) {
-    // fast start
-    dl_avg_rate_ = dl_avg_rate_ + (alloc_bytes - dl_avg_rate_) / (dl_nof_samples + 1);
-  } else {
-    dl_avg_rate_ = (1 - exp_avg_alpha) * dl_avg_rate_ + (exp_avg_alpha)*alloc_bytes;
-  }
-  dl_nof_samples++;
-}
-
-void sched_time_pf::ue_ctxt::save_ul_alloc(uint32_t alloc_bytes, float exp_avg_alpha)
-{
-  if (ul_nof_samples < 1 / exp_avg_alpha) {
-    // fast start
-    ul_avg_rate_ = ul_avg_rate_ + (alloc_bytes - ul_avg_rate_) / (ul_nof_samples + 1);
-  } else {
-    ul_avg_rate_ = (1 - exp_avg_alpha) * ul_avg_rate_ + (exp_avg_alpha)*alloc_bytes;
-  }
-  ul_nof_samples++;
+  dl_retx_h = get_dl_retx_harq(ue, tti_sched);
+  ul_retx_h = get_ul_retx_harq(ue, tti_sched);
 }
 
-bool sched_time_pf::ue_dl_prio_compare::operator()(const sched_time_pf::ue_ctxt* lhs,
-                                                   const sched_time_pf::ue_ctxt* rhs) const
+double sched_time_pf::ue_ctxt::dl_metric(float fairness_coeff) const
 {
-  bool is_retx1 = lhs->dl_retx_h != nullptr, is_retx2 = rhs->dl_retx_h != nullptr;
-  return (not is_retx1 and is_retx2) or (is_retx1 == is_retx2 and lhs->dl_prio < rhs->dl_prio);
+  return (dl_avg_rate != 0) ? dl_rate / pow(dl_avg_rate, fairness_coeff)
+                            : (dl_rate == 0 ? 0 : std::numeric_limits<double>::max());
 }
 
-bool sched_time_pf::ue_ul_prio_compare::operator()(const sched_time_pf::ue_ctxt* lhs,
-                                                   const sched_time_pf::ue_ctxt* rhs) const
+double sched_time_pf::ue_ctxt::ul_metric(float fairness_coeff) const
 {
-  bool is_retx1 = lhs->ul_h->has_pending_retx(), is_retx2 = rhs->ul_h->has_pending_retx();
-  return (not is_retx1 and is_retx2) or (is_retx1 == is_retx2 and lhs->ul_prio < rhs->ul_prio);
+  return (ul_avg_rate != 0) ? ul_rate / pow(ul_avg_rate, fairness_coeff)
+                            : (ul_rate == 0 ? 0 : std::numeric_limits<double>::max());
 }
 
 } // namespace srsenb
@@ -26,6 +26,7 @@
 #include "srsran/common/string_helpers.h"
 #include "srsran/interfaces/enb_interfaces.h"
 #include "srsran/interfaces/enb_pdcp_interfaces.h"
+#include "srsran/srslog/span_trace.h"
 #include "srsran/support/srsran_assert.h"
 
 #include <errno.h>
@@ -223,14 +224,20 @@ void gtpu_tunnel_manager::activate_tunnel(uint32_t teid)
               tun.teid_in,
               tun.buffer->size());
   // Forward buffered SDUs to lower layers and delete buffer
-  auto lower_sn = [](const std::pair<uint32_t, srsran::unique_byte_buffer_t>& lhs,
-                     const std::pair<uint32_t, srsran::unique_byte_buffer_t>& rhs) { return lhs.first < rhs.first; };
+  auto lower_sn = [](const std::pair<uint32_t, srsran::byte_buffer_chain>& lhs,
+                     const std::pair<uint32_t, srsran::byte_buffer_chain>& rhs) { return lhs.first < rhs.first; };
   std::stable_sort(tun.buffer->begin(), tun.buffer->end(), lower_sn);
 
   for (auto& sdu_pair : *tun.buffer) {
-    uint32_t pdcp_sn = sdu_pair.first;
-    pdcp->write_sdu(
-        tun.rnti, tun.eps_bearer_id, std::move(sdu_pair.second), pdcp_sn == undefined_pdcp_sn ? -1 : pdcp_sn);
+    uint32_t                     pdcp_sn = sdu_pair.first;
+    srsran::unique_byte_buffer_t sdu     = srsran::make_byte_buffer();
+    if (sdu == nullptr) {
+      logger.warning("Couldn't allocate buffer for buffered SDU. Discarding SDU.");
+      continue;
+    }
+    sdu->N_bytes = sdu_pair.second.copy_to(srsran::byte_span{sdu->msg, sdu->get_tailroom()});
+    sdu->md      = sdu_pair.second.md;
+    pdcp->write_sdu(tun.rnti, tun.eps_bearer_id, std::move(sdu), pdcp_sn == undefined_pdcp_sn ? -1 : pdcp_sn);
   }
   tun.buffer.reset();
   tun.state = tunnel_state::pdcp_active;
@@ -244,7 +251,7 @@ void gtpu_tunnel_manager::suspend_tunnel(uint32_t teid)
     return;
   }
   // Create a container for buffering SDUs
-  tun.buffer.emplace();
+  tun.buffer.reset(new buffered_sdu_list());
   tun.state = tunnel_state::buffering;
 }
 
@@ -314,7 +321,13 @@ void gtpu_tunnel_manager::buffer_pdcp_sdu(uint32_t teid, uint32_t pdcp_sn, srsra
 
   srsran_assert(rx_tun.state == tunnel_state::buffering, "Buffering of PDCP SDUs only enabled when PDCP is not active");
   if (not rx_tun.buffer->full()) {
-    rx_tun.buffer->push_back(std::make_pair(pdcp_sn, std::move(sdu)));
+    srsran::byte_buffer_chain buffered_sdu;
+    if (not buffered_sdu.append(srsran::make_span(sdu))) {
+      logger.warning("GTPU tunnel " TEID_IN_FMT " has no buffer segments left. Discarding SDU.", teid);
+      return;
+    }
+    buffered_sdu.md = sdu->md;
+    rx_tun.buffer->push_back(std::make_pair(pdcp_sn, std::move(buffered_sdu)));
   } else {
     fmt::memory_buffer str_buffer;
     if (pdcp_sn != undefined_pdcp_sn) {
@@ -614,6 +627,9 @@ void gtpu::handle_end_marker(const gtpu_tunnel& rx_tunnel)
 void gtpu::handle_gtpu_s1u_rx_packet(srsran::unique_byte_buffer_t pdu, const sockaddr_in& addr)
 {
   srsran_assert(pdu != nullptr, "Called with null PDU");
+  // The packets read from the S1-U socket already carry their flow id, the ones forwarded internally get one here
+  trace_span_stamp_flow(pdu->md.flow_id);
+  trace_span_flow("pkt", "gtpu::s1u_rx", pdu->md.flow_id);
 
   logger.debug("Received %d bytes from S1-U interface", pdu->N_bytes);
   pdu->set_timestamp();
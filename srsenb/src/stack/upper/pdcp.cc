@@ -24,6 +24,7 @@
 #include "srsran/interfaces/enb_gtpu_interfaces.h"
 #include "srsran/interfaces/enb_rlc_interfaces.h"
 #include "srsran/interfaces/enb_rrc_interface_pdcp.h"
+#include "srsran/srslog/span_trace.h"
 
 namespace srsenb {
 
@@ -174,6 +175,9 @@ void pdcp::notify_failure(uint16_t rnti, uint32_t lcid, const srsran::pdcp_sn_ve
 
 void pdcp::write_sdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t sdu, int pdcp_sn)
 {
+  // The SDUs of the signalling bearers start their flow here
+  trace_span_stamp_flow(sdu->md.flow_id);
+  trace_span_flow("pkt", "pdcp::write_sdu", sdu->md.flow_id);
   if (users.count(rnti)) {
     if (rnti != SRSRAN_MRNTI) {
       // TODO: Handle PDCP SN coming from GTPU
@@ -24,6 +24,7 @@
 #include "srsran/interfaces/enb_mac_interfaces.h"
 #include "srsran/interfaces/enb_pdcp_interfaces.h"
 #include "srsran/interfaces/enb_rrc_interface_rlc.h"
+#include "srsran/srslog/span_trace.h"
 
 namespace srsenb {
 
@@ -204,6 +205,7 @@ void rlc::update_bsr(uint32_t rnti, uint32_t lcid, uint32_t tx_queue, uint32_t p
 
 int rlc::read_pdu(uint16_t rnti, uint32_t lcid, uint8_t* payload, uint32_t nof_bytes)
 {
+  trace_span("rlc", "rlc::read_pdu");
   int ret;
 
   pthread_rwlock_rdlock(&rwlock);
@@ -231,6 +233,8 @@ void rlc::write_pdu(uint16_t rnti, uint32_t lcid, uint8_t* payload, uint32_t nof
 
 void rlc::write_sdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t sdu)
 {
+  trace_span_stamp_flow(sdu->md.flow_id);
+  trace_span_flow("pkt", "rlc::write_sdu", sdu->md.flow_id);
   pthread_rwlock_rdlock(&rwlock);
   if (users.count(rnti)) {
     if (rnti != SRSRAN_MRNTI) {
@@ -0,0 +1,226 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "sched_test_common.h"
+#include "sched_ue_ded_test_suite.h"
+#include "srsenb/hdr/stack/mac/sched.h"
+#include "srsran/adt/accumulators.h"
+#include "srsran/common/test_common.h"
+#include <chrono>
+#include <getopt.h>
+
+using namespace srsenb;
+
+static uint32_t nof_carriers = 4;
+static uint32_t nof_ues      = 16;
+static uint32_t nof_prb      = 100;
+static uint32_t nof_ttis     = 2000;
+
+void usage(char* prog)
+{
+  printf("Usage: %s [cupt]\n", prog);
+  printf("\t-c Number of carriers [Default %d]\n", nof_carriers);
+  printf("\t-u Number of UEs per carrier [Default %d]\n", nof_ues);
+  printf("\t-p Number of PRBs [Default %d]\n", nof_prb);
+  printf("\t-t Number of TTIs [Default %d]\n", nof_ttis);
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "cupt")) != -1) {
+    switch (opt) {
+      case 'c':
+        nof_carriers = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'u':
+        nof_ues = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'p':
+        nof_prb = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 't':
+        nof_ttis = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+class carrier_tester : public sched_sim_base
+{
+public:
+  carrier_tester(sched*                                          sched_obj_,
+                 const sched_interface::sched_args_t&            sched_args,
+                 const std::vector<sched_interface::cell_cfg_t>& cell_cfg_list) :
+    sched_sim_base(sched_obj_, sched_args, cell_cfg_list),
+    sched_ptr(sched_obj_),
+    dl_result(cell_cfg_list.size()),
+    ul_result(cell_cfg_list.size())
+  {}
+
+  sched*                                       sched_ptr;
+  std::vector<sched_interface::dl_sched_res_t> dl_result;
+  std::vector<sched_interface::ul_sched_res_t> ul_result;
+  uint64_t                                     dl_bytes = 0;
+  uint64_t                                     ul_bytes = 0;
+  srsran::rolling_average<double>              avg_latency;
+  std::vector<uint32_t>                        latency_samples;
+
+  /// Runs the scheduler for all the carriers of a TTI and checks the results
+  int advance_tti()
+  {
+    tti_point tti_rx = get_tti_rx().is_valid() ? get_tti_rx() + 1 : tti_point(0);
+    new_tti(tti_rx);
+
+    // The first carrier triggers the scheduling of all of them, the latency is the one of the whole TTI
+    auto tp = std::chrono::steady_clock::now();
+    for (uint32_t cc = 0; cc < get_cell_params().size(); ++cc) {
+      TESTASSERT(sched_ptr->dl_sched(to_tx_dl(tti_rx).to_uint(), cc, dl_result[cc]) == SRSRAN_SUCCESS);
+      TESTASSERT(sched_ptr->ul_sched(to_tx_ul(tti_rx).to_uint(), cc, ul_result[cc]) == SRSRAN_SUCCESS);
+    }
+    auto tdur = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tp);
+    avg_latency.push(tdur.count());
+    latency_samples.push_back(tdur.count());
+
+    sf_output_res_t sf_out{get_cell_params(), tti_rx, ul_result, dl_result};
+    TESTASSERT(test_all_common(sf_out) == SRSRAN_SUCCESS);
+    TESTASSERT(test_all_ues(get_enb_ctxt(), sf_out) == SRSRAN_SUCCESS);
+    update(sf_out);
+
+    for (uint32_t cc = 0; cc < get_cell_params().size(); ++cc) {
+      for (const auto& data : dl_result[cc].data) {
+        dl_bytes += data.tbs[0] + data.tbs[1];
+      }
+      for (const auto& pusch : ul_result[cc].pusch) {
+        ul_bytes += pusch.tbs;
+      }
+    }
+
+    return SRSRAN_SUCCESS;
+  }
+
+  void set_external_tti_events(const sim_ue_ctxt_t& ue_ctxt, ue_tti_events& pending_events) override
+  {
+    if (ue_ctxt.conres_rx) {
+      sched_ptr->ul_bsr(ue_ctxt.rnti, 1, 100000);
+      sched_ptr->dl_rlc_buffer_state(ue_ctxt.rnti, 3, 100000, 0);
+
+      if (get_tti_rx().to_uint() % 5 == 0) {
+        for (auto& cc : pending_events.cc_list) {
+          cc.dl_cqi = 15;
+          cc.ul_snr = 40;
+        }
+      }
+    }
+  }
+};
+
+struct run_result_t {
+  uint64_t dl_bytes;
+  uint64_t ul_bytes;
+};
+
+/// Schedules nof_ues single carrier UEs in each carrier, with the given number of carrier threads
+int run_scenario(uint32_t nof_threads, run_result_t& result)
+{
+  // Same random sequence for all the runs, so that the scheduling decisions can be compared
+  set_randseed(0);
+
+  std::vector<sched_interface::cell_cfg_t> cell_list(nof_carriers, generate_default_cell_cfg(nof_prb));
+  for (uint32_t cc = 0; cc < nof_carriers; ++cc) {
+    cell_list[cc].cell.id = cc + 1;
+  }
+  sched_interface::sched_args_t sched_args = {};
+  sched_args.nof_carrier_threads           = nof_threads;
+
+  sched     sched_obj;
+  rrc_dummy rrc{};
+  sched_obj.init(&rrc, sched_args);
+  carrier_tester tester(&sched_obj, sched_args, cell_list);
+
+  for (uint32_t ue_idx = 0; ue_idx < nof_ues * nof_carriers; ++ue_idx) {
+    sched_interface::ue_cfg_t ue_cfg            = generate_default_ue_cfg();
+    ue_cfg.supported_cc_list[0].enb_cc_idx      = ue_idx % nof_carriers;
+    const sched_interface::cell_cfg_t& cell_cfg = tester.get_cell_params()[ue_idx % nof_carriers].cfg;
+    while (not srsran_prach_tti_opportunity_config_fdd(cell_cfg.prach_config, tester.get_tti_rx().to_uint(), -1)) {
+      TESTASSERT(tester.advance_tti() == SRSRAN_SUCCESS);
+    }
+    TESTASSERT(tester.add_user(0x46 + ue_idx, ue_cfg, 16) == SRSRAN_SUCCESS);
+    TESTASSERT(tester.advance_tti() == SRSRAN_SUCCESS);
+  }
+
+  // Wait for all the UEs to complete the RA procedure
+  auto ue_db_ctxt = tester.get_enb_ctxt().ue_db;
+  while (not std::all_of(ue_db_ctxt.begin(), ue_db_ctxt.end(), [](std::pair<uint16_t, const sim_ue_ctxt_t*> p) {
+    return p.second->conres_rx;
+  })) {
+    TESTASSERT(tester.advance_tti() == SRSRAN_SUCCESS);
+    ue_db_ctxt = tester.get_enb_ctxt().ue_db;
+  }
+
+  tester.dl_bytes    = 0;
+  tester.ul_bytes    = 0;
+  tester.avg_latency = {};
+  tester.latency_samples.clear();
+  tester.latency_samples.reserve(nof_ttis);
+  for (uint32_t count = 0; count < nof_ttis; ++count) {
+    TESTASSERT(tester.advance_tti() == SRSRAN_SUCCESS);
+  }
+  std::sort(tester.latency_samples.begin(), tester.latency_samples.end());
+
+  result.dl_bytes = tester.dl_bytes;
+  result.ul_bytes = tester.ul_bytes;
+  printf("%d carriers, %d threads: DL/UL %.1f/%.1f Mbps, latency %.1f usec, latency q0.9 %.1f usec\n",
+         nof_carriers,
+         nof_threads,
+         tester.dl_bytes * 8.0 / (nof_ttis * 1000.0),
+         tester.ul_bytes * 8.0 / (nof_ttis * 1000.0),
+         tester.avg_latency.value() / 1000,
+         tester.latency_samples[static_cast<size_t>(tester.latency_samples.size() * 0.9)] / 1000.0);
+
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  auto& mac_log = srslog::fetch_basic_logger("MAC");
+  mac_log.set_level(srslog::basic_levels::warning);
+  auto& test_log = srslog::fetch_basic_logger("TEST", false);
+  test_log.set_level(srslog::basic_levels::warning);
+  srslog::init();
+
+  // The carriers do not share UEs, so scheduling them in parallel must not change the decisions
+  run_result_t sequential = {}, parallel = {};
+  TESTASSERT(run_scenario(0, sequential) == SRSRAN_SUCCESS);
+  TESTASSERT(run_scenario(nof_carriers - 1, parallel) == SRSRAN_SUCCESS);
+  TESTASSERT(sequential.dl_bytes > 0 and sequential.ul_bytes > 0);
+  TESTASSERT(sequential.dl_bytes == parallel.dl_bytes);
+  TESTASSERT(sequential.ul_bytes == parallel.ul_bytes);
+
+  srslog::flush();
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,160 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "sched_test_common.h"
+#include "srsenb/hdr/stack/mac/sched_phy_ch/sf_cch_allocator.h"
+#include "srsran/common/test_common.h"
+#include <chrono>
+#include <getopt.h>
+#include <memory>
+
+using namespace srsenb;
+
+static uint32_t nof_ues  = 64;
+static uint32_t nof_prb  = 100;
+static uint32_t nof_ttis = 2000;
+
+void usage(char* prog)
+{
+  printf("Usage: %s [upt]\n", prog);
+  printf("\t-u Number of active UEs [Default %d]\n", nof_ues);
+  printf("\t-p Number of PRBs [Default %d]\n", nof_prb);
+  printf("\t-t Number of TTIs [Default %d]\n", nof_ttis);
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "upt")) != -1) {
+    switch (opt) {
+      case 'u':
+        nof_ues = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'p':
+        nof_prb = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 't':
+        nof_ttis = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+/// Checks that the DCIs of a PDCCH allocation result do not overlap
+int check_pdcch_result(const sf_cch_allocator& pdcch)
+{
+  sf_cch_allocator::alloc_result_t dci_result;
+  pdcch_mask_t                     total_mask;
+  pdcch.get_allocs(&dci_result, &total_mask);
+  TESTASSERT(dci_result.size() == pdcch.nof_allocs());
+
+  pdcch_mask_t acc_mask(pdcch.nof_cces());
+  for (const sf_cch_allocator::tree_node* node : dci_result) {
+    TESTASSERT(node->current_mask.count() == 1U << node->dci_pos.L);
+    TESTASSERT((acc_mask & node->current_mask).none());
+    acc_mask |= node->current_mask;
+  }
+  TESTASSERT(acc_mask == total_mask);
+
+  return SRSRAN_SUCCESS;
+}
+
+/// Every TTI, all the UEs request a DL and an UL grant, as the scheduler does with a crowded cell
+int run_pdcch_stress()
+{
+  std::vector<sched_cell_params_t> cell_params(1);
+  sched_interface::ue_cfg_t        ue_cfg   = generate_default_ue_cfg();
+  sched_interface::cell_cfg_t      cell_cfg = generate_default_cell_cfg(nof_prb);
+  sched_interface::sched_args_t    sched_args{};
+  TESTASSERT(cell_params[0].set_cfg(0, cell_cfg, sched_args));
+
+  std::vector<std::unique_ptr<sched_ue> > ues;
+  for (uint32_t i = 0; i < nof_ues; ++i) {
+    ues.emplace_back(new sched_ue(0x46 + i, cell_params, ue_cfg));
+  }
+
+  sf_cch_allocator pdcch;
+  pdcch.init(cell_params[0]);
+
+  // Mostly low aggregation levels, which leave more UEs competing for the CCEs
+  std::discrete_distribution<uint32_t> aggr_dist{4, 3, 2, 1};
+
+  uint64_t  nof_allocs = 0, nof_failures = 0;
+  double    total_us = 0, max_us = 0;
+  tti_point tti_rx{0};
+  for (uint32_t count = 0; count < nof_ttis; ++count, ++tti_rx) {
+    std::vector<uint32_t> aggr_idxs(nof_ues);
+    for (uint32_t& aggr_idx : aggr_idxs) {
+      aggr_idx = aggr_dist(get_rand_gen());
+    }
+
+    auto tp = std::chrono::steady_clock::now();
+    pdcch.new_tti(tti_rx);
+    bool pucch_multiplexed = false;
+    for (uint32_t i = 0; i < nof_ues; ++i) {
+      // Round-robin of the UE priority
+      uint32_t ue_idx = (count + i) % nof_ues;
+      for (alloc_type_t alloc_type : {alloc_type_t::DL_DATA, alloc_type_t::UL_DATA}) {
+        if (pdcch.alloc_dci(alloc_type, aggr_idxs[ue_idx], ues[ue_idx].get(), pucch_multiplexed)) {
+          nof_allocs++;
+        } else {
+          nof_failures++;
+        }
+      }
+      pucch_multiplexed = not pucch_multiplexed;
+    }
+    double us = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tp).count() /
+                1000.0;
+    total_us += us;
+    max_us = std::max(max_us, us);
+
+    TESTASSERT(check_pdcch_result(pdcch) == SRSRAN_SUCCESS);
+  }
+
+  printf("%d UEs, %d PRBs: %.1f DCIs per TTI, %.1f failed attempts per TTI, %.1f us per TTI (max %.1f us)\n",
+         nof_ues,
+         nof_prb,
+         (double)nof_allocs / nof_ttis,
+         (double)nof_failures / nof_ttis,
+         total_us / nof_ttis,
+         max_us);
+
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  srsenb::set_randseed(0);
+  auto& mac_log = srslog::fetch_basic_logger("MAC");
+  mac_log.set_level(srslog::basic_levels::warning);
+  srslog::init();
+
+  TESTASSERT(run_pdcch_stress() == SRSRAN_SUCCESS);
+
+  srslog::flush();
+
+  return SRSRAN_SUCCESS;
+}
@@ -24,6 +24,7 @@
 #include "srsenb/hdr/stack/mac/sched_phy_ch/sched_dci.h"
 #include "srsran/common/common_lte.h"
 #include "srsran/support/srsran_test.h"
+#include <chrono>
 
 namespace srsenb {
 
@@ -317,6 +318,118 @@ void test_ul_mcs_tbs_derivation()
   TESTASSERT_EQ(23, compute_tbs_mcs(100, 100 - 5).mcs);
 }
 
+/// Reference MCS/TBS derivation through the search functions of the PHY library, as done before the lookup tables
+tbs_info ref_compute_mcs_and_tbs(uint32_t nof_prb,
+                                 uint32_t nof_re,
+                                 uint32_t cqi,
+                                 uint32_t max_mcs,
+                                 bool     is_ul,
+                                 bool     ulqam64_enabled,
+                                 bool     use_tbs_index_alt)
+{
+  float    max_coderate = srsran_cqi_to_coderate(std::min(cqi + 1U, 15U), use_tbs_index_alt);
+  uint32_t max_Qm       = (is_ul) ? (ulqam64_enabled ? 6 : 4) : (use_tbs_index_alt ? 8 : 6);
+  max_coderate          = std::min(max_coderate, 0.930F * max_Qm);
+
+  int mcs = 0;
+  do {
+    int max_tbs = static_cast<int>(floorf(nof_re * max_coderate - 24));
+    if (max_tbs < 16) {
+      return tbs_info{};
+    }
+    int tbs_idx = srsran_ra_tbs_to_table_idx(max_tbs, nof_prb, use_tbs_index_alt ? 33 : 26);
+    if (tbs_idx <= 0) {
+      return tbs_info{};
+    }
+    --tbs_idx;
+    if (use_tbs_index_alt and (tbs_idx == 1 or tbs_idx == 3 or tbs_idx == 5 or tbs_idx == 7 or tbs_idx == 9 or
+                               tbs_idx == 26)) {
+      --tbs_idx;
+    }
+    mcs = srsran_ra_mcs_from_tbs_idx(tbs_idx, use_tbs_index_alt, is_ul);
+    if (mcs < 0) {
+      return tbs_info{};
+    }
+    if (mcs > (int)max_mcs) {
+      mcs     = max_mcs;
+      tbs_idx = srsran_ra_tbs_idx_from_mcs(mcs, use_tbs_index_alt, is_ul);
+    }
+    if (mcs == 6 and nof_prb == 1) {
+      max_mcs = mcs - 1;
+      continue;
+    }
+    int          tbs      = srsran_ra_tbs_from_idx(tbs_idx, nof_prb);
+    float        coderate = srsran_coderate(tbs, nof_re);
+    srsran_mod_t mod = (is_ul) ? srsran_ra_ul_mod_from_mcs(mcs) : srsran_ra_dl_mod_from_mcs(mcs, use_tbs_index_alt);
+    max_coderate     = std::min(0.930F * srsran_mod_bits_x_symbol(mod), max_coderate);
+    if (coderate <= max_coderate) {
+      return tbs_info{tbs / 8, mcs};
+    }
+    max_mcs = mcs - 1;
+  } while (mcs > 0);
+
+  return tbs_info{};
+}
+
+/// Verify that the table based MCS/TBS derivation matches the reference one, and compare their execution times
+int test_mcs_tbs_tables_vs_reference()
+{
+  using clock_t = std::chrono::steady_clock;
+
+  struct input_t {
+    uint32_t nof_prb, nof_re, cqi, max_mcs;
+    bool     is_ul, ulqam64_enabled, use_tbs_index_alt;
+  };
+  std::vector<input_t> inputs;
+  for (uint32_t table = 0; table < 4; ++table) {
+    bool is_ul = table >= 2, alt = table == 1, ulqam64 = table == 3;
+    for (uint32_t nof_prb = 1; nof_prb <= SRSRAN_MAX_PRB; ++nof_prb) {
+      for (uint32_t nof_re = nof_prb * 100; nof_re <= nof_prb * 168; nof_re += nof_prb * 4 + 1) {
+        for (uint32_t cqi = 0; cqi < 16; ++cqi) {
+          for (uint32_t max_mcs = 0; max_mcs <= (alt ? 27U : 28U); ++max_mcs) {
+            inputs.push_back(input_t{nof_prb, nof_re, cqi, max_mcs, is_ul, ulqam64, alt});
+          }
+        }
+      }
+    }
+  }
+
+  std::vector<tbs_info> ref_results(inputs.size()), results(inputs.size());
+  auto                  t0 = clock_t::now();
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    const input_t& in = inputs[i];
+    ref_results[i]    = ref_compute_mcs_and_tbs(
+        in.nof_prb, in.nof_re, in.cqi, in.max_mcs, in.is_ul, in.ulqam64_enabled, in.use_tbs_index_alt);
+  }
+  auto t1 = clock_t::now();
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    const input_t& in = inputs[i];
+    results[i] =
+        compute_mcs_and_tbs(in.nof_prb, in.nof_re, in.cqi, in.max_mcs, in.is_ul, in.ulqam64_enabled, in.use_tbs_index_alt);
+  }
+  auto t2 = clock_t::now();
+
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    CONDERROR(results[i] != ref_results[i],
+              "MCS/TBS mismatch for {nof_prb=%d, nof_re=%d, cqi=%d, max_mcs=%d}: {%d, %d}!={%d, %d}",
+              inputs[i].nof_prb,
+              inputs[i].nof_re,
+              inputs[i].cqi,
+              inputs[i].max_mcs,
+              results[i].tbs_bytes,
+              results[i].mcs,
+              ref_results[i].tbs_bytes,
+              ref_results[i].mcs);
+  }
+
+  printf("MCS/TBS derivation of %zd grants: reference=%.1f ns/grant, tables=%.1f ns/grant\n",
+         inputs.size(),
+         std::chrono::duration<double, std::nano>(t1 - t0).count() / inputs.size(),
+         std::chrono::duration<double, std::nano>(t2 - t1).count() / inputs.size());
+
+  return SRSRAN_SUCCESS;
+}
+
 } // namespace srsenb
 
 int main()
@@ -333,6 +446,7 @@ int main()
   TESTASSERT(srsenb::test_mcs_tbs_consistency_all() == SRSRAN_SUCCESS);
   TESTASSERT(srsenb::test_min_mcs_tbs_specific() == SRSRAN_SUCCESS);
   srsenb::test_ul_mcs_tbs_derivation();
+  TESTASSERT(srsenb::test_mcs_tbs_tables_vs_reference() == SRSRAN_SUCCESS);
 
   printf("Success\n");
   return 0;
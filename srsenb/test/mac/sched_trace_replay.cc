@@ -0,0 +1,190 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * Replays a scheduler trace recorded with the option scheduler.trace_filename. It reports the time spent in the
+ * scheduler calls of each TTI and, optionally, writes the scheduling decisions or compares them with the decisions of a
+ * previous replay, e.g. to benchmark a scheduler change with the inputs of a real deployment.
+ */
+
+#include "sched_test_common.h"
+#include "srsenb/hdr/stack/mac/sched.h"
+#include "srsenb/hdr/stack/mac/sched_trace.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <getopt.h>
+
+using namespace srsenb;
+
+static std::string trace_filename;
+static std::string output_filename;
+static std::string reference_filename;
+
+void usage(char* prog)
+{
+  printf("Usage: %s [or] trace_file\n", prog);
+  printf("\t-o File where the scheduling decisions are written\n");
+  printf("\t-r File with reference scheduling decisions to compare with\n");
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "o:r:")) != -1) {
+    switch (opt) {
+      case 'o':
+        output_filename = optarg;
+        break;
+      case 'r':
+        reference_filename = optarg;
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+  if (optind >= argc) {
+    usage(argv[0]);
+    exit(-1);
+  }
+  trace_filename = argv[optind];
+}
+
+static double percentile(const std::vector<uint32_t>& sorted_samples, double q)
+{
+  if (sorted_samples.empty()) {
+    return 0;
+  }
+  return sorted_samples[std::min(static_cast<size_t>(sorted_samples.size() * q), sorted_samples.size() - 1)] / 1000.0;
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  auto& mac_log = srslog::fetch_basic_logger("MAC");
+  mac_log.set_level(srslog::basic_levels::warning);
+  srslog::init();
+
+  sched_trace_reader reader;
+  if (not reader.open(trace_filename)) {
+    fprintf(stderr, "Error: %s is not a scheduler trace\n", trace_filename.c_str());
+    return SRSRAN_ERROR;
+  }
+  if (reader.get_rat() != sched_trace_rat::lte) {
+    fprintf(stderr, "Error: only LTE scheduler traces can be replayed by this tool\n");
+    return SRSRAN_ERROR;
+  }
+  if (reader.get_layout_signature() != sched_trace_lte_signature()) {
+    fprintf(stderr, "Error: the trace was recorded by a build with a different scheduler interface\n");
+    return SRSRAN_ERROR;
+  }
+
+  std::ofstream output;
+  if (not output_filename.empty()) {
+    output.open(output_filename);
+  }
+  std::ifstream reference;
+  if (not reference_filename.empty()) {
+    reference.open(reference_filename);
+    if (not reference.is_open()) {
+      fprintf(stderr, "Error: could not open %s\n", reference_filename.c_str());
+      return SRSRAN_ERROR;
+    }
+  }
+
+  sched                 sched_obj;
+  rrc_dummy             rrc{};
+  sched_trace_player    player(sched_obj, &rrc);
+  sched_trace_record    record;
+  std::vector<uint32_t> tti_latency_samples;
+  uint64_t              tti_latency_ns = 0;
+  uint32_t              current_tti    = 0;
+  bool                  tti_started    = false;
+  uint32_t              nof_records = 0, nof_decisions = 0, nof_mismatches = 0;
+  while (reader.read(record)) {
+    auto tp = std::chrono::steady_clock::now();
+    if (not player.play(record)) {
+      fprintf(stderr, "Error: could not decode record %d of type %d\n", nof_records, record.type);
+      return SRSRAN_ERROR;
+    }
+    auto tdur = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tp);
+    nof_records++;
+
+    // A TTI starts with its first dl_sched call, the calls until the next one are accounted to it
+    if (player.event == sched_trace_event::dl_sched and (not tti_started or player.tti != current_tti)) {
+      if (tti_started) {
+        tti_latency_samples.push_back(tti_latency_ns);
+      }
+      tti_latency_ns = 0;
+      current_tti    = player.tti;
+      tti_started    = true;
+    }
+    tti_latency_ns += tdur.count();
+
+    fmt::memory_buffer buffer;
+    if (player.event == sched_trace_event::dl_sched) {
+      sched_trace_fmt_dl_result(buffer, player.tti, player.enb_cc_idx, player.dl_result);
+    } else if (player.event == sched_trace_event::ul_sched) {
+      sched_trace_fmt_ul_result(buffer, player.tti, player.enb_cc_idx, player.ul_result);
+    } else {
+      continue;
+    }
+    nof_decisions++;
+
+    std::string line = fmt::to_string(buffer);
+    if (output.is_open()) {
+      output << line;
+    }
+    if (reference.is_open()) {
+      std::string ref_line;
+      std::getline(reference, ref_line);
+      ref_line += "\n";
+      if (ref_line != line) {
+        if (nof_mismatches == 0) {
+          printf("First mismatch:\n  reference: %s  replay:    %s", ref_line.c_str(), line.c_str());
+        }
+        nof_mismatches++;
+      }
+    }
+  }
+  if (tti_started) {
+    tti_latency_samples.push_back(tti_latency_ns);
+  }
+
+  std::sort(tti_latency_samples.begin(), tti_latency_samples.end());
+  printf("Replayed %d records, %d TTIs, %d scheduling results\n",
+         nof_records,
+         (int)tti_latency_samples.size(),
+         nof_decisions);
+  printf("TTI latency: p50 %.1f usec, p90 %.1f usec, p99 %.1f usec, max %.1f usec\n",
+         percentile(tti_latency_samples, 0.5),
+         percentile(tti_latency_samples, 0.9),
+         percentile(tti_latency_samples, 0.99),
+         percentile(tti_latency_samples, 1.0));
+  if (reference.is_open()) {
+    printf("%d of %d decisions differ from the reference\n", nof_mismatches, nof_decisions);
+  }
+
+  srslog::flush();
+  return nof_mismatches == 0 ? SRSRAN_SUCCESS : SRSRAN_ERROR;
+}
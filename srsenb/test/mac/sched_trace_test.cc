@@ -0,0 +1,217 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "sched_test_common.h"
+#include "sched_ue_ded_test_suite.h"
+#include "srsenb/hdr/stack/mac/sched.h"
+#include "srsenb/hdr/stack/mac/sched_trace.h"
+#include "srsran/common/test_common.h"
+
+using namespace srsenb;
+
+static const char*    trace_filename = "sched_trace_test.trace";
+static const uint32_t nof_carriers   = 2;
+static const uint32_t nof_ues        = 4;
+static const uint32_t nof_ttis       = 500;
+
+/// Runs a scenario with traffic in all the carriers and keeps the description of every scheduling result
+class trace_tester : public sched_sim_base
+{
+public:
+  trace_tester(sched*                                          sched_obj_,
+               const sched_interface::sched_args_t&            sched_args,
+               const std::vector<sched_interface::cell_cfg_t>& cell_cfg_list) :
+    sched_sim_base(sched_obj_, sched_args, cell_cfg_list),
+    sched_ptr(sched_obj_),
+    dl_result(cell_cfg_list.size()),
+    ul_result(cell_cfg_list.size())
+  {}
+
+  sched*                                       sched_ptr;
+  std::vector<sched_interface::dl_sched_res_t> dl_result;
+  std::vector<sched_interface::ul_sched_res_t> ul_result;
+  std::vector<std::string>                     decisions;
+
+  int advance_tti()
+  {
+    tti_point tti_rx = get_tti_rx().is_valid() ? get_tti_rx() + 1 : tti_point(0);
+    new_tti(tti_rx);
+
+    for (uint32_t cc = 0; cc < get_cell_params().size(); ++cc) {
+      uint32_t tti_tx_dl = to_tx_dl(tti_rx).to_uint();
+      uint32_t tti_tx_ul = to_tx_ul(tti_rx).to_uint();
+      TESTASSERT(sched_ptr->dl_sched(tti_tx_dl, cc, dl_result[cc]) == SRSRAN_SUCCESS);
+      TESTASSERT(sched_ptr->ul_sched(tti_tx_ul, cc, ul_result[cc]) == SRSRAN_SUCCESS);
+
+      fmt::memory_buffer buffer;
+      sched_trace_fmt_dl_result(buffer, tti_tx_dl, cc, dl_result[cc]);
+      decisions.push_back(fmt::to_string(buffer));
+      buffer.clear();
+      sched_trace_fmt_ul_result(buffer, tti_tx_ul, cc, ul_result[cc]);
+      decisions.push_back(fmt::to_string(buffer));
+    }
+
+    sf_output_res_t sf_out{get_cell_params(), tti_rx, ul_result, dl_result};
+    TESTASSERT(test_all_common(sf_out) == SRSRAN_SUCCESS);
+    TESTASSERT(test_all_ues(get_enb_ctxt(), sf_out) == SRSRAN_SUCCESS);
+    update(sf_out);
+
+    return SRSRAN_SUCCESS;
+  }
+
+  void set_external_tti_events(const sim_ue_ctxt_t& ue_ctxt, ue_tti_events& pending_events) override
+  {
+    if (ue_ctxt.conres_rx) {
+      sched_ptr->ul_bsr(ue_ctxt.rnti, 1, 10000 + ue_ctxt.rnti);
+      sched_ptr->dl_rlc_buffer_state(ue_ctxt.rnti, 3, 10000 + 100 * get_tti_rx().to_uint() % 5000, 0);
+    }
+  }
+};
+
+/// Runs the scenario with the trace enabled. Returns the decisions of the scheduler
+int record_scenario(std::vector<std::string>& decisions)
+{
+  set_randseed(0);
+
+  std::vector<sched_interface::cell_cfg_t> cell_list(nof_carriers, generate_default_cell_cfg(25));
+  for (uint32_t cc = 0; cc < nof_carriers; ++cc) {
+    cell_list[cc].cell.id = cc + 1;
+  }
+  sched_interface::sched_args_t sched_args = {};
+  sched_args.trace_filename                = trace_filename;
+
+  sched     sched_obj;
+  rrc_dummy rrc{};
+  sched_obj.init(&rrc, sched_args);
+  trace_tester tester(&sched_obj, sched_args, cell_list);
+
+  for (uint32_t ue_idx = 0; ue_idx < nof_ues * nof_carriers; ++ue_idx) {
+    sched_interface::ue_cfg_t ue_cfg            = generate_default_ue_cfg();
+    ue_cfg.supported_cc_list[0].enb_cc_idx      = ue_idx % nof_carriers;
+    const sched_interface::cell_cfg_t& cell_cfg = tester.get_cell_params()[ue_idx % nof_carriers].cfg;
+    while (not srsran_prach_tti_opportunity_config_fdd(cell_cfg.prach_config, tester.get_tti_rx().to_uint(), -1)) {
+      TESTASSERT(tester.advance_tti() == SRSRAN_SUCCESS);
+    }
+    TESTASSERT(tester.add_user(0x46 + ue_idx, ue_cfg, 16) == SRSRAN_SUCCESS);
+    TESTASSERT(tester.advance_tti() == SRSRAN_SUCCESS);
+  }
+  for (uint32_t count = 0; count < nof_ttis; ++count) {
+    TESTASSERT(tester.advance_tti() == SRSRAN_SUCCESS);
+  }
+
+  decisions = std::move(tester.decisions);
+  return SRSRAN_SUCCESS;
+}
+
+/// Replays the trace in a new scheduler. Returns the decisions of the scheduler
+int replay_scenario(std::vector<std::string>& decisions)
+{
+  sched_trace_reader reader;
+  TESTASSERT(reader.open(trace_filename));
+  TESTASSERT(reader.get_rat() == sched_trace_rat::lte);
+  TESTASSERT(reader.get_layout_signature() == sched_trace_lte_signature());
+
+  sched              sched_obj;
+  rrc_dummy          rrc{};
+  sched_trace_player player(sched_obj, &rrc);
+  sched_trace_record record;
+  uint32_t           nof_records = 0;
+  while (reader.read(record)) {
+    TESTASSERT(player.play(record));
+    nof_records++;
+
+    fmt::memory_buffer buffer;
+    if (player.event == sched_trace_event::dl_sched) {
+      sched_trace_fmt_dl_result(buffer, player.tti, player.enb_cc_idx, player.dl_result);
+      decisions.push_back(fmt::to_string(buffer));
+    } else if (player.event == sched_trace_event::ul_sched) {
+      sched_trace_fmt_ul_result(buffer, player.tti, player.enb_cc_idx, player.ul_result);
+      decisions.push_back(fmt::to_string(buffer));
+    }
+  }
+  TESTASSERT(nof_records > 0);
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_record_replay()
+{
+  std::vector<std::string> recorded, replayed;
+  TESTASSERT(record_scenario(recorded) == SRSRAN_SUCCESS);
+  TESTASSERT(replay_scenario(replayed) == SRSRAN_SUCCESS);
+
+  // The replayed scheduler must take the same decisions, and some of them must allocate data
+  TESTASSERT(recorded.size() == replayed.size());
+  for (uint32_t i = 0; i < recorded.size(); ++i) {
+    TESTASSERT(recorded[i] == replayed[i]);
+  }
+  TESTASSERT(std::any_of(recorded.begin(), recorded.end(), [](const std::string& s) {
+    return s.find(" data=") != std::string::npos;
+  }));
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_encoding()
+{
+  // Round trip of the configurations, which include vectors and strings
+  sched_interface::ue_cfg_t ue_cfg = generate_default_ue_cfg();
+  ue_cfg.supported_cc_list.resize(2);
+  ue_cfg.supported_cc_list[1].enb_cc_idx = 1;
+  ue_cfg.maxharq_tx                      = 7;
+
+  std::vector<uint8_t> payload;
+  sched_trace_encoder  enc(payload);
+  sched_trace_pack_all(enc, uint16_t(0x46), ue_cfg, std::string("time_pf"));
+
+  sched_trace_decoder       dec(payload);
+  uint16_t                  rnti = 0;
+  sched_interface::ue_cfg_t ue_cfg2;
+  std::string               policy;
+  TESTASSERT(sched_trace_unpack_all(dec, rnti, ue_cfg2, policy));
+  TESTASSERT(dec.empty());
+  TESTASSERT(rnti == 0x46 and policy == "time_pf");
+  TESTASSERT(ue_cfg2.supported_cc_list.size() == 2 and ue_cfg2.supported_cc_list[1].enb_cc_idx == 1);
+  TESTASSERT(ue_cfg2.maxharq_tx == 7);
+
+  // Truncated payloads are rejected
+  std::vector<uint8_t> truncated(payload.begin(), payload.end() - 1);
+  sched_trace_decoder  dec2(truncated);
+  TESTASSERT(not sched_trace_unpack_all(dec2, rnti, ue_cfg2, policy));
+
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  auto& mac_log = srslog::fetch_basic_logger("MAC");
+  mac_log.set_level(srslog::basic_levels::warning);
+  auto& test_log = srslog::fetch_basic_logger("TEST", false);
+  test_log.set_level(srslog::basic_levels::warning);
+  srslog::init();
+
+  TESTASSERT(test_encoding() == SRSRAN_SUCCESS);
+  TESTASSERT(test_record_replay() == SRSRAN_SUCCESS);
+
+  srslog::flush();
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -135,6 +135,34 @@ void test_interferer_subband_cqi_scenario()
   TESTASSERT(grant_mask == test_mask);
 }
 
+void test_outer_loop_link_adaptation()
+{
+  // Disabled when no target BLER is set
+  outer_loop_link_adaptation disabled_olla(0, 0.1, 5);
+  disabled_olla.update(true, 10, 28);
+  TESTASSERT(not disabled_olla.enabled() and disabled_olla.offset() == 0);
+
+  // With BLER == target BLER, the offset does not drift
+  outer_loop_link_adaptation olla(0.1, 0.01, 5);
+  for (uint32_t i = 0; i < 100; ++i) {
+    olla.update(i % 10 != 0, 10, 28);
+  }
+  TESTASSERT(std::abs(olla.offset()) < 0.001);
+
+  // The offset is bounded and does not grow further with the MCS at its limits
+  for (uint32_t i = 0; i < 1000; ++i) {
+    olla.update(true, 10, 28);
+  }
+  TESTASSERT(olla.offset() == 5);
+  olla.reset();
+  olla.update(true, 28, 28);
+  TESTASSERT(olla.offset() == 0);
+  olla.update(false, 0, 28);
+  TESTASSERT(olla.offset() == 0);
+  olla.update(false, 1, 28);
+  TESTASSERT(olla.offset() < 0);
+}
+
 int main()
 {
   srsenb::set_randseed(seed);
@@ -148,6 +176,7 @@ int main()
 
   test_neg_phr_scenario();
   test_interferer_subband_cqi_scenario();
+  test_outer_loop_link_adaptation();
 
   srslog::flush();
 
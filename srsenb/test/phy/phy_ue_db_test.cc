@@ -0,0 +1,207 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/phy/phy_ue_db.h"
+#include "srsran/common/test_common.h"
+#include <atomic>
+#include <chrono>
+#include <getopt.h>
+#include <thread>
+
+static uint32_t nof_ues     = 256;
+static uint32_t nof_workers = 4;
+static uint32_t nof_ttis    = 2000;
+
+static const uint16_t first_rnti = 0x46;
+
+void usage(char* prog)
+{
+  printf("Usage: %s [uwt]\n", prog);
+  printf("\t-u Number of UEs [Default %d]\n", nof_ues);
+  printf("\t-w Number of PHY workers [Default %d]\n", nof_workers);
+  printf("\t-t Number of TTIs [Default %d]\n", nof_ttis);
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "uwt")) != -1) {
+    switch (opt) {
+      case 'u':
+        nof_ues = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'w':
+        nof_workers = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 't':
+        nof_ttis = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+class phy_ue_db_bench
+{
+public:
+  phy_ue_db_bench()
+  {
+    srsenb::phy_cell_cfg_t cell_cfg = {};
+    cell_cfg.cell.nof_prb           = 25;
+    cell_cfg.cell.nof_ports         = 1;
+    cell_cfg.cell.cp                = SRSRAN_CP_NORM;
+    cell_cfg.cell.frame_type        = SRSRAN_FDD;
+    cell_list.push_back(cell_cfg);
+
+    ue_db.init(nullptr, args, cell_list);
+  }
+
+  void add_ues(uint32_t count)
+  {
+    for (uint32_t i = 0; i < count; i++) {
+      ue_db.addmod_rnti(first_rnti + i, get_cfg());
+      ue_db.complete_config(first_rnti + i);
+    }
+  }
+
+  /// Runs the per-TTI accesses of a LTE worker for all the UEs. Returns the number of UEs whose ACK was lost
+  uint32_t run_tti(uint32_t tti, uint32_t count)
+  {
+    uint32_t nof_errors = 0;
+    for (uint32_t i = 0; i < count; i++) {
+      uint16_t rnti = first_rnti + i;
+
+      // DL processing, the ACK is expected in the UL of the same TTI slot
+      srsran_dl_cfg_t  dl_cfg  = {};
+      srsran_dci_cfg_t dci_cfg = {};
+      srsran_dci_dl_t  dci     = {};
+      dci.rnti                 = rnti;
+      dci.format               = SRSRAN_DCI_FORMAT1;
+      dci.location.ncce        = i % 20;
+      dci.tb[0].mcs_idx        = 10;
+      dci.tb[0].rv             = 0;
+      dci.tb[1].mcs_idx        = 0;
+      dci.tb[1].rv             = 1;
+      if (ue_db.get_dci_dl_config(rnti, 0, dci_cfg) < SRSRAN_SUCCESS or
+          ue_db.get_dl_config(rnti, 0, dl_cfg) < SRSRAN_SUCCESS or not ue_db.set_ack_pending(tti, 0, dci)) {
+        nof_errors++;
+        continue;
+      }
+
+      // UL processing
+      srsran_ul_cfg_t ul_cfg = {};
+      if (ue_db.get_ul_config(rnti, 0, ul_cfg) < SRSRAN_SUCCESS or
+          ue_db.fill_uci_cfg(tti, 0, rnti, false, false, ul_cfg.pucch.uci_cfg) < SRSRAN_SUCCESS or
+          srsran_uci_cfg_total_ack(&ul_cfg.pucch.uci_cfg) != 1) {
+        nof_errors++;
+      }
+    }
+
+    ue_db.clear_tti_pending_ack(tti);
+
+    return nof_errors;
+  }
+
+  /// Reconfigures the UEs beyond the ones used by the workers, as the stack does while UEs attach and leave
+  void run_stack(uint32_t count, const std::atomic<bool>& running)
+  {
+    uint32_t i = 0;
+    while (running) {
+      uint16_t rnti = first_rnti + count + (i % 16);
+      ue_db.addmod_rnti(rnti, get_cfg());
+      ue_db.complete_config(rnti);
+      if (i % 4 == 0) {
+        ue_db.rem_rnti(rnti);
+      }
+      i++;
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+  }
+
+private:
+  static srsenb::phy_interface_rrc_lte::phy_rrc_cfg_list_t get_cfg()
+  {
+    srsenb::phy_interface_rrc_lte::phy_rrc_cfg_list_t cfg_list(1);
+    cfg_list[0].configured = true;
+    cfg_list[0].enb_cc_idx = 0;
+    cfg_list[0].phy_cfg.set_defaults();
+    return cfg_list;
+  }
+
+  srsenb::phy_args_t          args = {};
+  srsenb::phy_cell_cfg_list_t cell_list;
+  srsenb::phy_ue_db           ue_db;
+};
+
+/// Runs nof_ttis TTIs distributed among the given number of workers while the stack reconfigures other UEs
+int run_bench(uint32_t workers)
+{
+  phy_ue_db_bench bench;
+  bench.add_ues(nof_ues);
+
+  std::atomic<bool>     running    = {true};
+  std::atomic<uint32_t> nof_errors = {0};
+  std::thread           stack_thread([&bench, &running]() { bench.run_stack(nof_ues, running); });
+
+  auto                     t_start = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (uint32_t w = 0; w < workers; w++) {
+    // Each worker owns a set of TTI slots, so no two workers process the same slot concurrently
+    threads.emplace_back([&bench, &nof_errors, w, workers]() {
+      for (uint32_t tti = 0; tti < nof_ttis; tti++) {
+        if (TTIMOD(tti) % workers == w) {
+          nof_errors += bench.run_tti(tti, nof_ues);
+        }
+      }
+    });
+  }
+  for (std::thread& t : threads) {
+    t.join();
+  }
+  auto t_end = std::chrono::steady_clock::now();
+
+  running = false;
+  stack_thread.join();
+
+  double elapsed_us = std::chrono::duration_cast<std::chrono::microseconds>(t_end - t_start).count();
+  printf("%d workers, %d UEs: %.1f us per TTI, %.1f ns per UE access\n",
+         workers,
+         nof_ues,
+         elapsed_us / nof_ttis,
+         1000.0 * elapsed_us / (nof_ttis * nof_ues));
+
+  TESTASSERT(nof_errors == 0);
+
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  // Single worker reference, then all the workers contending for the database
+  TESTASSERT(run_bench(1) == SRSRAN_SUCCESS);
+  TESTASSERT(run_bench(nof_workers) == SRSRAN_SUCCESS);
+
+  return SRSRAN_SUCCESS;
+}
@@ -24,10 +24,12 @@
 
 #include "sched_nr_cfg.h"
 #include "sched_nr_interface.h"
+#include "sched_nr_trace.h"
 #include "sched_nr_ue.h"
 #include "srsran/adt/pool/cached_alloc.h"
 #include "srsran/adt/pool/circular_stack_pool.h"
 #include "srsran/common/slot_point.h"
+#include "srsran/common/task_graph.h"
 #include <array>
 extern "C" {
 #include "srsran/config.h"
@@ -73,6 +75,11 @@ private:
   int ue_cfg_impl(uint16_t rnti, const ue_cfg_t& cfg);
   int add_ue_impl(uint16_t rnti, sched_nr_impl::unique_ue_ptr u);
 
+  /// Whether the scheduling decisions are computed in slot_indication() rather than in get_dl_sched()
+  bool precompute_slots() const { return cfg.sched_cfg.nof_lookahead_slots > 0 or carrier_executor != nullptr; }
+  void run_cc_slot(slot_point pdcch_slot, uint32_t cc);
+  void precompute_slot(slot_point pdcch_slot);
+
   // args
   sched_nr_impl::sched_params_t cfg;
   srslog::basic_logger*         logger = nullptr;
@@ -84,6 +91,11 @@ private:
   using slot_cc_worker = sched_nr_impl::cc_worker;
   std::vector<std::unique_ptr<sched_nr_impl::cc_worker> > cc_workers;
 
+  // Precomputation of slot decisions, one task per carrier
+  slot_point                                   last_sched_slot;
+  std::unique_ptr<srsran::task_graph>          cc_graph;
+  std::unique_ptr<srsran::task_graph_executor> carrier_executor;
+
   // UE Database
   std::unique_ptr<srsran::circular_stack_pool<SRSENB_MAX_UES> > ue_pool;
   using ue_map_t = sched_nr_impl::ue_map_t;
@@ -96,6 +108,9 @@ private:
   // metrics extraction
   class ue_metrics_manager;
   std::unique_ptr<ue_metrics_manager> metrics_handler;
+
+  // Records the calls to the scheduler API, if enabled by sched_args_t::trace_filename
+  sched_nr_trace_recorder trace;
 };
 
 } // namespace srsenb
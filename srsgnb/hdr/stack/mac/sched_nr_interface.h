@@ -35,14 +35,15 @@
 
 namespace srsenb {
 
-const static size_t   SCHED_NR_MAX_CARRIERS     = 4;
-const static uint16_t SCHED_NR_INVALID_RNTI     = 0;
-const static size_t   SCHED_NR_MAX_NOF_RBGS     = 18;
-const static size_t   SCHED_NR_MAX_TB           = 1;
-const static size_t   SCHED_NR_MAX_HARQ         = SRSRAN_DEFAULT_HARQ_PROC_DL_NR;
-const static size_t   SCHED_NR_MAX_BWP_PER_CELL = 2;
-const static size_t   SCHED_NR_MAX_LCID         = srsran::MAX_NR_NOF_BEARERS;
-const static size_t   SCHED_NR_MAX_LC_GROUP     = 7;
+const static size_t   SCHED_NR_MAX_CARRIERS        = 4;
+const static uint16_t SCHED_NR_INVALID_RNTI        = 0;
+const static size_t   SCHED_NR_MAX_NOF_RBGS        = 18;
+const static size_t   SCHED_NR_MAX_TB              = 1;
+const static size_t   SCHED_NR_MAX_HARQ            = SRSRAN_DEFAULT_HARQ_PROC_DL_NR;
+const static size_t   SCHED_NR_MAX_BWP_PER_CELL    = 2;
+const static size_t   SCHED_NR_MAX_LCID            = srsran::MAX_NR_NOF_BEARERS;
+const static size_t   SCHED_NR_MAX_LC_GROUP        = 7;
+const static uint32_t SCHED_NR_MAX_LOOKAHEAD_SLOTS = 4; ///< Bounded by the size of the slot grid and the RAR window
 
 struct sched_nr_ue_cc_cfg_t {
   bool     active = false;
@@ -116,12 +117,20 @@ public:
 
   ///// Configuration /////
   struct sched_args_t {
-    bool        pdsch_enabled      = true;
-    bool        pusch_enabled      = true;
-    bool        auto_refill_buffer = false;
-    int         fixed_dl_mcs       = 28;
-    int         fixed_ul_mcs       = 28;
-    std::string logger_name        = "MAC-NR";
+    bool        pdsch_enabled             = true;
+    bool        pusch_enabled             = true;
+    bool        auto_refill_buffer        = false;
+    int         fixed_dl_mcs              = 28;
+    int         fixed_ul_mcs              = 28;
+    float       target_bler               = 0.05;      ///< Target BLER of the DL link adaptation (0 disables it)
+    float       max_delta_dl_cqi          = 5;         ///< Maximum CQI offset of the DL link adaptation
+    float       adaptive_dl_mcs_step_size = 0.001;     ///< CQI offset increment after each DL ACK
+    std::string sched_policy              = "time_rr"; ///< UE data scheduling policy (time_rr, time_pf)
+    std::string sched_policy_args         = "";        ///< For time_pf, "<fairness_coeff>[,<avg_alpha>]"
+    uint32_t    nof_lookahead_slots       = 0;         ///< Slots the decisions are generated ahead of the PHY
+    uint32_t    nof_carrier_threads       = 0;         ///< Threads scheduling the carriers in parallel
+    std::string logger_name               = "MAC-NR";
+    std::string trace_filename            = ""; ///< If not empty, file where the scheduler inputs are recorded
   };
 
   using ue_cc_cfg_t = sched_nr_ue_cc_cfg_t;
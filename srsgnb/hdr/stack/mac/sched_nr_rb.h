@@ -255,22 +255,20 @@ find_next_empty_interval(const prb_bitmap& mask, size_t start_prb_idx = 0, size_
 
 inline prb_interval find_empty_interval_of_length(const prb_bitmap& mask, size_t nof_prbs, uint32_t start_prb_idx = 0)
 {
-  prb_interval max_interv;
-  do {
-    prb_interval interv = find_next_empty_interval(mask, start_prb_idx, mask.size());
-    if (interv.empty()) {
-      break;
-    }
-    if (interv.length() >= nof_prbs) {
-      max_interv.set(interv.start(), interv.start() + nof_prbs);
-      break;
-    }
-    if (interv.length() > max_interv.length()) {
-      max_interv = interv;
-    }
-    start_prb_idx = interv.stop() + 1;
-  } while (start_prb_idx < mask.size());
-  return max_interv;
+  if (start_prb_idx >= mask.size()) {
+    return {};
+  }
+  int pos = mask.find_lowest_run(start_prb_idx, mask.size(), nof_prbs, false);
+  if (pos >= 0) {
+    return {(uint32_t)pos, (uint32_t)(pos + nof_prbs)};
+  }
+
+  // No interval is large enough, return the largest one
+  std::pair<int, size_t> run = mask.find_longest_run(start_prb_idx, mask.size(), false);
+  if (run.first < 0) {
+    return {};
+  }
+  return {(uint32_t)run.first, (uint32_t)(run.first + run.second)};
 }
 
 } // namespace sched_nr_impl
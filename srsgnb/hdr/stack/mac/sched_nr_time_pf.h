@@ -0,0 +1,74 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_SCHED_NR_TIME_PF_H
+#define SRSRAN_SCHED_NR_TIME_PF_H
+
+#include "sched_nr_time_rr.h"
+#include "srsran/adt/bounded_vector.h"
+#include <array>
+
+namespace srsenb {
+namespace sched_nr_impl {
+
+/**
+ * Proportional fair scheduler. The UEs are served in decreasing order of their PF metric r / R^fairness_coeff, where
+ * r is the spectral efficiency expected from the last CQI and R the exponentially averaged number of bytes allocated
+ * per slot. HARQ retxs are served first, in the same order. The averaged rates are kept per carrier.
+ */
+class sched_nr_time_pf final : public sched_nr_base
+{
+public:
+  explicit sched_nr_time_pf(const bwp_params_t& bwp_cfg_);
+
+  void sched_dl_users(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc) override;
+  void sched_ul_users(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc) override;
+
+private:
+  struct ue_ctxt {
+    uint16_t   rnti        = SRSRAN_INVALID_RNTI;
+    double     dl_avg_rate = 0;
+    double     ul_avg_rate = 0;
+    slot_point dl_last_slot, ul_last_slot;
+  };
+  struct ue_prio {
+    slot_ue* ue;
+    double   metric;
+  };
+  using ue_prio_list = srsran::bounded_vector<ue_prio, SRSENB_MAX_UES>;
+
+  ue_ctxt& get_ctxt(uint16_t rnti);
+  void     decay_rate(double& avg_rate, slot_point& last_slot, slot_point current_slot) const;
+  double   metric(float rate, double avg_rate) const;
+  void     sort_by_metric(ue_prio_list& ues) const;
+
+  const bwp_params_t* bwp_cfg        = nullptr;
+  float               fairness_coeff = 1;
+  float               avg_alpha      = 0.01; ///< Exponential average coefficient of the allocated bytes per slot
+
+  std::array<ue_ctxt, SRSENB_MAX_UES> ue_ctxts;
+  ue_prio_list                        retx_ues, newtx_ues;
+};
+
+} // namespace sched_nr_impl
+} // namespace srsenb
+
+#endif // SRSRAN_SCHED_NR_TIME_PF_H
@@ -0,0 +1,116 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_SCHED_NR_TRACE_H
+#define SRSRAN_SCHED_NR_TRACE_H
+
+#include "sched_nr_interface.h"
+#include "srsenb/hdr/stack/mac/common/sched_trace_file.h"
+#include "srsran/srslog/bundled/fmt/format.h"
+
+namespace srsenb {
+
+class sched_nr;
+
+/// Scheduler API calls stored in the NR scheduler traces
+enum class sched_nr_trace_event : uint32_t {
+  config,
+  ue_cfg,
+  ue_rem,
+  dl_rach_info,
+  dl_ack_info,
+  ul_crc_info,
+  ul_sr_info,
+  ul_bsr,
+  dl_buffer_state,
+  dl_mac_ce,
+  dl_cqi_info,
+  slot_indication,
+  get_dl_sched,
+  get_ul_sched,
+  nof_events
+};
+
+void sched_trace_pack(sched_trace_encoder& enc, const sched_nr_interface::sched_args_t& args);
+bool sched_trace_unpack(sched_trace_decoder& dec, sched_nr_interface::sched_args_t& args);
+void sched_trace_pack(sched_trace_encoder& enc, const sched_nr_cell_cfg_t& cfg);
+bool sched_trace_unpack(sched_trace_decoder& dec, sched_nr_cell_cfg_t& cfg);
+void sched_trace_pack(sched_trace_encoder& enc, const sched_nr_ue_cfg_t& cfg);
+bool sched_trace_unpack(sched_trace_decoder& dec, sched_nr_ue_cfg_t& cfg);
+
+/// Signature of the layout of the structs stored as raw bytes in the NR traces
+uint32_t sched_trace_nr_signature();
+
+/// Records the calls to the NR scheduler API in a trace file. Recording is disabled until open() succeeds
+class sched_nr_trace_recorder
+{
+public:
+  bool open(const std::string& filename)
+  {
+    return writer.open(filename, sched_trace_rat::nr, sched_trace_nr_signature());
+  }
+  void close() { writer.close(); }
+
+  template <typename... Args>
+  void record(sched_nr_trace_event ev, const Args&... args)
+  {
+    if (writer.is_open()) {
+      writer.write(static_cast<uint32_t>(ev), args...);
+    }
+  }
+
+private:
+  sched_trace_writer writer;
+};
+
+/// Calls the NR scheduler API as described by the records of a trace
+class sched_nr_trace_player
+{
+public:
+  explicit sched_nr_trace_player(sched_nr& sched_obj_) : sched_obj(sched_obj_) {}
+
+  /// Replays a recorded call. Returns false if the record cannot be decoded
+  bool play(const sched_trace_record& record);
+
+  // Last replayed call and, for get_dl_sched and get_ul_sched, its result
+  sched_nr_trace_event          event  = sched_nr_trace_event::nof_events;
+  slot_point                    slot;
+  uint32_t                      cc     = 0;
+  sched_nr_interface::dl_res_t* dl_res = nullptr;
+  sched_nr_interface::ul_res_t* ul_res = nullptr;
+
+private:
+  sched_nr& sched_obj;
+};
+
+/// Describes the decisions of a DL or UL scheduling result in a single line, to compare the decisions of two runs
+void sched_nr_trace_fmt_dl_result(fmt::memory_buffer&                 buffer,
+                                  slot_point                          slot,
+                                  uint32_t                            cc,
+                                  const sched_nr_interface::dl_res_t& result);
+void sched_nr_trace_fmt_ul_result(fmt::memory_buffer&                 buffer,
+                                  slot_point                          slot,
+                                  uint32_t                            cc,
+                                  const sched_nr_interface::ul_res_t& result);
+
+} // namespace srsenb
+
+#endif // SRSRAN_SCHED_NR_TRACE_H
@@ -28,6 +28,7 @@
 #include "sched_ue/ue_cfg_manager.h"
 #include "srsenb/hdr/stack/mac/common/base_ue_buffer_manager.h"
 #include "srsenb/hdr/stack/mac/common/mac_metrics.h"
+#include "srsenb/hdr/stack/mac/common/sched_link_adaptation.h"
 #include "srsran/adt/circular_map.h"
 #include "srsran/adt/move_callback.h"
 #include "srsran/adt/pool/cached_alloc.h"
@@ -102,6 +103,9 @@ public:
   int dl_ack_info(uint32_t pid, uint32_t tb_idx, bool ack);
   int ul_crc_info(uint32_t pid, bool crc);
 
+  /// DL CQI corrected by the outer loop link adaptation
+  uint32_t get_dl_cqi() const;
+
   const uint16_t             rnti;
   const uint32_t             cc;
   const cell_config_manager& cell_params;
@@ -123,8 +127,9 @@ public:
 private:
   friend class slot_ue;
 
-  srslog::basic_logger& logger;
-  ue_carrier_params_t   bwp_cfg;
+  srslog::basic_logger&      logger;
+  ue_carrier_params_t        bwp_cfg;
+  outer_loop_link_adaptation dl_olla;
 };
 
 class ue
@@ -146,7 +151,7 @@ public:
 
   /// UE state feedback
   void ul_bsr(uint32_t lcg, uint32_t bsr_val) { buffers.ul_bsr(lcg, bsr_val); }
-  void ul_sr_info() { last_sr_slot = last_tx_slot - TX_ENB_DELAY; }
+  void ul_sr_info() { last_sr_slot = last_tx_slot - TX_ENB_DELAY - sched_cfg.sched_cfg.nof_lookahead_slots; }
 
   bool has_ca() const
   {
@@ -198,7 +203,7 @@ public:
   bool get_pending_bytes(uint32_t lcid) const { return ue->pdu_builder.pending_bytes(lcid); }
 
   /// Channel Information Getters
-  uint32_t dl_cqi() const { return ue->dl_cqi; }
+  uint32_t dl_cqi() const { return ue->get_dl_cqi(); }
   uint32_t ul_cqi() const { return ue->ul_cqi; }
 
   // UE parameters common to all sectors
@@ -113,7 +113,7 @@ int gnb_stack_nr::init(const gnb_stack_args_t& args_,
     pdcp.init(&rlc, &rrc, gtpu_adapter.get());
 
     if (args.ngap_pcap.enable) {
-      ngap_pcap.open(args.ngap_pcap.filename.c_str());
+      ngap_pcap.open(args.ngap_pcap.filename.c_str(), args.ngap_pcap.compression_level);
       ngap->start_pcap(&ngap_pcap);
     }
 
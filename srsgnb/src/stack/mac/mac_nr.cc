@@ -239,7 +239,8 @@ int mac_nr::init(const mac_nr_args_t&    args_,
 
   if (args.pcap.enable) {
     pcap = std::unique_ptr<srsran::mac_pcap>(new srsran::mac_pcap());
-    pcap->open(args.pcap.filename);
+    pcap->open(args.pcap.filename, 0, args.pcap.compression_level);
+    pcap->set_max_pdu_len(args.pcap.max_pdu_len);
   }
 
   logger.info("Started");
@@ -297,6 +297,9 @@ sched_nr::~sched_nr()
 void sched_nr::stop()
 {
   metrics_handler->stop();
+  if (carrier_executor != nullptr) {
+    carrier_executor->stop();
+  }
 }
 
 int sched_nr::config(const sched_args_t& sched_cfg, srsran::const_span<sched_nr_cell_cfg_t> cell_list)
@@ -304,6 +307,20 @@ int sched_nr::config(const sched_args_t& sched_cfg, srsran::const_span<sched_nr_
   cfg    = sched_params_t{sched_cfg};
   logger = &srslog::fetch_basic_logger(sched_cfg.logger_name);
 
+  if (sched_cfg.nof_lookahead_slots > SCHED_NR_MAX_LOOKAHEAD_SLOTS) {
+    logger->error("SCHED: Invalid number of lookahead slots=%d (max=%d)",
+                  sched_cfg.nof_lookahead_slots,
+                  SCHED_NR_MAX_LOOKAHEAD_SLOTS);
+    return SRSRAN_ERROR;
+  }
+
+  if (not sched_cfg.trace_filename.empty() and not trace.open(sched_cfg.trace_filename)) {
+    logger->error("SCHED: Could not open the trace file %s", sched_cfg.trace_filename.c_str());
+  }
+  trace.record(sched_nr_trace_event::config,
+               sched_cfg,
+               std::vector<sched_nr_cell_cfg_t>(cell_list.begin(), cell_list.end()));
+
   // Initiate UE memory pool
   ue_pool.reset(new srsran::circular_stack_pool<SRSENB_MAX_UES>(8, sizeof(ue), 4));
 
@@ -321,12 +338,19 @@ int sched_nr::config(const sched_args_t& sched_cfg, srsran::const_span<sched_nr_
     cc_workers[cc].reset(new slot_cc_worker{cfg.cells[cc]});
   }
 
+  // Initiate the threads that schedule the carriers of a slot in parallel
+  if (sched_cfg.nof_carrier_threads > 0 and cfg.cells.size() > 1) {
+    cc_graph.reset(new srsran::task_graph(cfg.cells.size()));
+    carrier_executor.reset(new srsran::task_graph_executor(sched_cfg.nof_carrier_threads));
+  }
+
   return SRSRAN_SUCCESS;
 }
 
 void sched_nr::ue_cfg(uint16_t rnti, const ue_cfg_t& uecfg)
 {
   srsran_assert(assert_ue_cfg_valid(rnti, uecfg) == SRSRAN_SUCCESS, "Invalid UE configuration");
+  trace.record(sched_nr_trace_event::ue_cfg, rnti, uecfg);
   pending_events->enqueue_event("ue_cfg", [this, rnti, uecfg](event_manager::logger& ev_logger) {
     if (ue_cfg_impl(rnti, uecfg) == SRSRAN_SUCCESS) {
       ev_logger.push("ue_cfg(0x{:x})", rnti);
@@ -338,6 +362,7 @@ void sched_nr::ue_cfg(uint16_t rnti, const ue_cfg_t& uecfg)
 
 void sched_nr::ue_rem(uint16_t rnti)
 {
+  trace.record(sched_nr_trace_event::ue_rem, rnti);
   pending_events->enqueue_event("ue_rem", [this, rnti](event_manager::logger& ev_logger) {
     ue_db.erase(rnti);
     logger->info("SCHED: Removed user rnti=0x%x", rnti);
@@ -365,6 +390,7 @@ int sched_nr::ue_cfg_impl(uint16_t rnti, const ue_cfg_t& uecfg)
 // NOTE: there is no parallelism in these operations
 void sched_nr::slot_indication(slot_point slot_tx)
 {
+  trace.record(sched_nr_trace_event::slot_indication, slot_tx);
   srsran_assert(worker_count.load(std::memory_order_relaxed) == 0,
                 "Call of sched slot_indication when previous TTI has not been completed");
   // mark the start of slot.
@@ -375,11 +401,23 @@ void sched_nr::slot_indication(slot_point slot_tx)
   // Note: non-CA UEs are updated later in get_dl_sched, to leverage parallelism
   pending_events->process_common(ue_db);
 
-  // prepare CA-enabled UEs internal state for new slot
-  // Note: non-CA UEs are updated later in get_dl_sched, to leverage parallelism
-  for (auto& u : ue_db) {
-    if (u.second->has_ca()) {
-      u.second->new_slot(slot_tx);
+  if (precompute_slots()) {
+    // Schedule the slots up to slot_tx + lookahead that were not scheduled yet. The first call also schedules slot_tx
+    slot_point last_slot = slot_tx + cfg.sched_cfg.nof_lookahead_slots;
+    if (not last_sched_slot.valid() or last_sched_slot < slot_tx or last_sched_slot > last_slot) {
+      last_sched_slot = slot_tx - 1;
+    }
+    while (last_sched_slot < last_slot) {
+      ++last_sched_slot;
+      precompute_slot(last_sched_slot);
+    }
+  } else {
+    // prepare CA-enabled UEs internal state for new slot
+    // Note: non-CA UEs are updated later in get_dl_sched, to leverage parallelism
+    for (auto& u : ue_db) {
+      if (u.second->has_ca()) {
+        u.second->new_slot(slot_tx);
+      }
     }
   }
 
@@ -387,23 +425,58 @@ void sched_nr::slot_indication(slot_point slot_tx)
   metrics_handler->save_metrics();
 }
 
-/// Generate {pdcch_slot,cc} scheduling decision
-sched_nr::dl_res_t* sched_nr::get_dl_sched(slot_point pdsch_tti, uint32_t cc)
+/// Generate the {pdcch_slot,cc} decision. It can run concurrently for different carriers
+void sched_nr::run_cc_slot(slot_point pdcch_slot, uint32_t cc)
 {
-  srsran_assert(pdsch_tti == current_slot_tx, "Unexpected pdsch_tti slot received");
-
   // process non-cc specific feedback if pending (e.g. SRs, buffer state updates, UE config) for non-CA UEs
   pending_events->process_cc_events(ue_db, cc);
 
   // prepare non-CA UEs internal state for new slot
   for (auto& u : ue_db) {
     if (not u.second->has_ca() and u.second->carriers[cc] != nullptr) {
-      u.second->new_slot(current_slot_tx);
+      u.second->new_slot(pdcch_slot);
     }
   }
 
   // Process pending CC-specific feedback, generate {slot_idx,cc} scheduling decision
-  sched_nr::dl_res_t* ret = cc_workers[cc]->run_slot(pdsch_tti, ue_db);
+  cc_workers[cc]->run_slot(pdcch_slot, ue_db);
+}
+
+/// Generate the decisions of all the carriers for a slot, in parallel when carrier threads are configured
+void sched_nr::precompute_slot(slot_point pdcch_slot)
+{
+  for (auto& u : ue_db) {
+    if (u.second->has_ca()) {
+      u.second->new_slot(pdcch_slot);
+    }
+  }
+
+  if (carrier_executor == nullptr) {
+    for (uint32_t cc = 0; cc < cc_workers.size(); ++cc) {
+      run_cc_slot(pdcch_slot, cc);
+    }
+    return;
+  }
+
+  // Carriers do not share state for non-CA UEs, so there are no dependencies between the tasks
+  cc_graph->clear();
+  for (uint32_t cc = 0; cc < cc_workers.size(); ++cc) {
+    cc_graph->add_task([this, pdcch_slot, cc]() { run_cc_slot(pdcch_slot, cc); });
+  }
+  carrier_executor->run(*cc_graph);
+}
+
+/// Generate {pdcch_slot,cc} scheduling decision
+sched_nr::dl_res_t* sched_nr::get_dl_sched(slot_point pdsch_tti, uint32_t cc)
+{
+  trace.record(sched_nr_trace_event::get_dl_sched, pdsch_tti, cc);
+  srsran_assert(pdsch_tti == current_slot_tx, "Unexpected pdsch_tti slot received");
+
+  // Note: with precomputation, the decision was already generated in slot_indication()
+  if (not precompute_slots()) {
+    run_cc_slot(pdsch_tti, cc);
+  }
+  sched_nr::dl_res_t* ret = cc_workers[cc]->get_dl_sched(pdsch_tti);
 
   // decrement the number of active workers
   int rem_workers = worker_count.fetch_sub(1, std::memory_order_release) - 1;
@@ -419,6 +492,7 @@ sched_nr::dl_res_t* sched_nr::get_dl_sched(slot_point pdsch_tti, uint32_t cc)
 /// Fetch {ul_slot,cc} UL scheduling decision
 sched_nr::ul_res_t* sched_nr::get_ul_sched(slot_point slot_ul, uint32_t cc)
 {
+  trace.record(sched_nr_trace_event::get_ul_sched, slot_ul, cc);
   return cc_workers[cc]->get_ul_sched(slot_ul);
 }
 
@@ -429,6 +503,8 @@ void sched_nr::get_metrics(mac_metrics_t& metrics)
 
 int sched_nr::dl_rach_info(const rar_info_t& rar_info)
 {
+  trace.record(sched_nr_trace_event::dl_rach_info, rar_info);
+
   // create user object outside of sched main thread
   unique_ue_ptr u =
       srsran::make_pool_obj_with_fallback<ue>(*ue_pool, rar_info.temp_crnti, rar_info.temp_crnti, rar_info.cc, cfg);
@@ -451,6 +527,7 @@ int sched_nr::dl_rach_info(const rar_info_t& rar_info)
 
 void sched_nr::dl_ack_info(uint16_t rnti, uint32_t cc, uint32_t pid, uint32_t tb_idx, bool ack)
 {
+  trace.record(sched_nr_trace_event::dl_ack_info, rnti, cc, pid, tb_idx, ack);
   auto callback = [pid, tb_idx, ack](ue_carrier& ue_cc, event_manager::logger& ev_logger) {
     if (ue_cc.dl_ack_info(pid, tb_idx, ack) >= 0) {
       ev_logger.push("0x{:x}: dl_ack_info(pid={}, ack={})", ue_cc.rnti, pid, ack ? "OK" : "KO");
@@ -461,6 +538,7 @@ void sched_nr::dl_ack_info(uint16_t rnti, uint32_t cc, uint32_t pid, uint32_t tb
 
 void sched_nr::ul_crc_info(uint16_t rnti, uint32_t cc, uint32_t pid, bool crc)
 {
+  trace.record(sched_nr_trace_event::ul_crc_info, rnti, cc, pid, crc);
   auto callback = [pid, crc](ue_carrier& ue_cc, event_manager::logger& ev_logger) {
     if (ue_cc.ul_crc_info(pid, crc) >= 0) {
       ev_logger.push("0x{:x}: ul_crc_info(pid={}, crc={})", ue_cc.rnti, pid, crc ? "OK" : "KO");
@@ -471,6 +549,7 @@ void sched_nr::ul_crc_info(uint16_t rnti, uint32_t cc, uint32_t pid, bool crc)
 
 void sched_nr::ul_sr_info(uint16_t rnti)
 {
+  trace.record(sched_nr_trace_event::ul_sr_info, rnti);
   pending_events->enqueue_ue_event("ul_sr_info", rnti, [](ue& u, event_manager::logger& evlogger) {
     u.ul_sr_info();
     evlogger.push("0x{:x}: ul_sr_info()", u.rnti);
@@ -479,6 +558,7 @@ void sched_nr::ul_sr_info(uint16_t rnti)
 
 void sched_nr::ul_bsr(uint16_t rnti, uint32_t lcg_id, uint32_t bsr)
 {
+  trace.record(sched_nr_trace_event::ul_bsr, rnti, lcg_id, bsr);
   pending_events->enqueue_ue_event("ul_bsr", rnti, [lcg_id, bsr](ue& u, event_manager::logger& evlogger) {
     u.ul_bsr(lcg_id, bsr);
     evlogger.push("0x{:x}: ul_bsr(lcg={}, bsr={})", u.rnti, lcg_id, bsr);
@@ -487,6 +567,7 @@ void sched_nr::ul_bsr(uint16_t rnti, uint32_t lcg_id, uint32_t bsr)
 
 void sched_nr::dl_mac_ce(uint16_t rnti, uint32_t ce_lcid)
 {
+  trace.record(sched_nr_trace_event::dl_mac_ce, rnti, ce_lcid);
   pending_events->enqueue_ue_event("dl_mac_ce", rnti, [ce_lcid](ue& u, event_manager::logger& event_logger) {
     // CE is added to list of pending CE
     u.add_dl_mac_ce(ce_lcid, 1);
@@ -496,6 +577,7 @@ void sched_nr::dl_mac_ce(uint16_t rnti, uint32_t ce_lcid)
 
 void sched_nr::dl_buffer_state(uint16_t rnti, uint32_t lcid, uint32_t newtx, uint32_t retx)
 {
+  trace.record(sched_nr_trace_event::dl_buffer_state, rnti, lcid, newtx, retx);
   pending_events->enqueue_ue_event(
       "dl_buffer_state", rnti, [lcid, newtx, retx](ue& u, event_manager::logger& event_logger) {
         u.rlc_buffer_state(lcid, newtx, retx);
@@ -505,6 +587,7 @@ void sched_nr::dl_buffer_state(uint16_t rnti, uint32_t lcid, uint32_t newtx, uin
 
 void sched_nr::dl_cqi_info(uint16_t rnti, uint32_t cc, uint32_t cqi_value)
 {
+  trace.record(sched_nr_trace_event::dl_cqi_info, rnti, cc, cqi_value);
   auto callback = [cqi_value](ue_carrier& ue_cc, event_manager::logger& ev_logger) {
     ue_cc.dl_cqi = cqi_value;
     ev_logger.push("0x{:x}: dl_cqi_info(cqi={})", ue_cc.rnti, ue_cc.dl_cqi);
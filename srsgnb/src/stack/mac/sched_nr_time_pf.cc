@@ -0,0 +1,188 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsgnb/hdr/stack/mac/sched_nr_time_pf.h"
+#include <algorithm>
+#include <cmath>
+
+namespace srsenb {
+namespace sched_nr_impl {
+
+/// Spectral efficiency of each CQI, see TS 38.214, Table 5.2.2.1-2
+static const std::array<float, 16> cqi_efficiency = {0,
+                                                     0.1523,
+                                                     0.2344,
+                                                     0.3770,
+                                                     0.6016,
+                                                     0.8770,
+                                                     1.1758,
+                                                     1.4766,
+                                                     1.9141,
+                                                     2.4063,
+                                                     2.7305,
+                                                     3.3223,
+                                                     3.9023,
+                                                     4.5234,
+                                                     5.1152,
+                                                     5.5547};
+
+sched_nr_time_pf::sched_nr_time_pf(const bwp_params_t& bwp_cfg_) : bwp_cfg(&bwp_cfg_)
+{
+  // Format: "<fairness_coeff>[,<avg_alpha>]"
+  const std::string& args = bwp_cfg->sched_cfg.sched_policy_args;
+  if (not args.empty()) {
+    fairness_coeff   = std::stof(args);
+    size_t comma_pos = args.find(',');
+    if (comma_pos != std::string::npos) {
+      avg_alpha = std::stof(args.substr(comma_pos + 1));
+    }
+  }
+  if (avg_alpha <= 0 or avg_alpha >= 1) {
+    logger.warning("SCHED: Invalid PF averaging coefficient %f. Using 0.01", avg_alpha);
+    avg_alpha = 0.01;
+  }
+}
+
+sched_nr_time_pf::ue_ctxt& sched_nr_time_pf::get_ctxt(uint16_t rnti)
+{
+  ue_ctxt& ctxt = ue_ctxts[rnti % SRSENB_MAX_UES];
+  if (ctxt.rnti != rnti) {
+    // New UE, or a removed UE whose position was reused
+    ctxt      = {};
+    ctxt.rnti = rnti;
+  }
+  return ctxt;
+}
+
+void sched_nr_time_pf::decay_rate(double& avg_rate, slot_point& last_slot, slot_point current_slot) const
+{
+  // The averaged rates are only updated when the UE is a candidate, so the decay of the skipped slots is applied at once
+  if (last_slot.valid() and current_slot > last_slot) {
+    avg_rate *= std::pow(1 - avg_alpha, current_slot - last_slot);
+  }
+  last_slot = current_slot;
+}
+
+double sched_nr_time_pf::metric(float rate, double avg_rate) const
+{
+  return (avg_rate != 0) ? rate / std::pow(avg_rate, fairness_coeff)
+                         : (rate == 0 ? 0 : std::numeric_limits<double>::max());
+}
+
+void sched_nr_time_pf::sort_by_metric(ue_prio_list& ues) const
+{
+  // Ties, e.g. UEs without allocations yet, are broken by RNTI to keep the decisions deterministic
+  std::sort(ues.begin(), ues.end(), [](const ue_prio& lhs, const ue_prio& rhs) {
+    return lhs.metric > rhs.metric or (lhs.metric == rhs.metric and (*lhs.ue)->rnti < (*rhs.ue)->rnti);
+  });
+}
+
+void sched_nr_time_pf::sched_dl_users(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc)
+{
+  slot_point pdcch_slot = slot_alloc.get_pdcch_tti();
+
+  retx_ues.clear();
+  newtx_ues.clear();
+  for (auto& ue_pair : ue_db) {
+    slot_ue& ue = ue_pair.second;
+    if (ue.h_dl == nullptr) {
+      continue;
+    }
+    ue_ctxt& ctxt = get_ctxt(ue->rnti);
+    decay_rate(ctxt.dl_avg_rate, ctxt.dl_last_slot, pdcch_slot);
+    float rate = ue->fixed_pdsch_mcs() >= 0 ? 1.0f : cqi_efficiency[std::min(ue.dl_cqi(), 15u)];
+    if (ue.h_dl->has_pending_retx(slot_alloc.get_tti_rx())) {
+      retx_ues.push_back(ue_prio{&ue, metric(rate, ctxt.dl_avg_rate)});
+    } else if (ue.dl_bytes > 0 and ue.h_dl->empty()) {
+      newtx_ues.push_back(ue_prio{&ue, metric(rate, ctxt.dl_avg_rate)});
+    }
+  }
+
+  // Start with retxs
+  sort_by_metric(retx_ues);
+  for (ue_prio& p : retx_ues) {
+    slot_ue& ue = *p.ue;
+    if (slot_alloc.alloc_pdsch(ue, ue->find_ss_id(srsran_dci_format_nr_1_0), ue.h_dl->prbs()) ==
+        alloc_result::success) {
+      return;
+    }
+  }
+
+  // Move on to new txs. The first UE allocated takes all the available PRBs
+  sort_by_metric(newtx_ues);
+  for (ue_prio& p : newtx_ues) {
+    slot_ue& ue    = *p.ue;
+    int      ss_id = ue->find_ss_id(srsran_dci_format_nr_1_0);
+    if (ss_id < 0) {
+      continue;
+    }
+    prb_grant prbs = find_optimal_dl_grant(slot_alloc, ue, ss_id);
+    if (slot_alloc.alloc_pdsch(ue, ss_id, prbs) == alloc_result::success) {
+      get_ctxt(ue->rnti).dl_avg_rate += avg_alpha * ue.h_dl->tbs() / 8;
+      return;
+    }
+  }
+}
+
+void sched_nr_time_pf::sched_ul_users(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc)
+{
+  slot_point pdcch_slot = slot_alloc.get_pdcch_tti();
+
+  // The UL MCS is fixed, so all the UEs are expected to get the same rate
+  const float rate = 1.0f;
+
+  retx_ues.clear();
+  newtx_ues.clear();
+  for (auto& ue_pair : ue_db) {
+    slot_ue& ue = ue_pair.second;
+    if (ue.h_ul == nullptr) {
+      continue;
+    }
+    ue_ctxt& ctxt = get_ctxt(ue->rnti);
+    decay_rate(ctxt.ul_avg_rate, ctxt.ul_last_slot, pdcch_slot);
+    if (ue.h_ul->has_pending_retx(slot_alloc.get_tti_rx())) {
+      retx_ues.push_back(ue_prio{&ue, metric(rate, ctxt.ul_avg_rate)});
+    } else if (ue.ul_bytes > 0 and ue.h_ul->empty()) {
+      newtx_ues.push_back(ue_prio{&ue, metric(rate, ctxt.ul_avg_rate)});
+    }
+  }
+
+  // Start with retxs
+  sort_by_metric(retx_ues);
+  for (ue_prio& p : retx_ues) {
+    if (slot_alloc.alloc_pusch(*p.ue, p.ue->h_ul->prbs()) == alloc_result::success) {
+      return;
+    }
+  }
+
+  // Move on to new txs
+  sort_by_metric(newtx_ues);
+  for (ue_prio& p : newtx_ues) {
+    slot_ue& ue = *p.ue;
+    if (slot_alloc.alloc_pusch(ue, prb_interval{0, slot_alloc.cfg.cfg.rb_width}) == alloc_result::success) {
+      get_ctxt(ue->rnti).ul_avg_rate += avg_alpha * ue.h_ul->tbs() / 8;
+      return;
+    }
+  }
+}
+
+} // namespace sched_nr_impl
+} // namespace srsenb
@@ -0,0 +1,402 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsgnb/hdr/stack/mac/sched_nr_trace.h"
+#include "srsgnb/hdr/stack/mac/sched_nr.h"
+
+namespace srsenb {
+
+/*******************************************************
+ *          Encoding of the configuration structs
+ *******************************************************/
+
+/// Maximum size of an ASN.1 message stored in a trace
+static const uint32_t max_asn1_msg_size = 16384;
+
+/// ASN.1 messages are stored with their packed length, as they are not trivially copyable
+template <typename Msg>
+static void pack_asn1(sched_trace_encoder& enc, const Msg& msg)
+{
+  std::vector<uint8_t> buf(max_asn1_msg_size);
+  asn1::bit_ref        bref(buf.data(), buf.size());
+  uint32_t             len = 0;
+  if (msg.pack(bref) == asn1::SRSASN_SUCCESS) {
+    len = bref.distance_bytes();
+  }
+  sched_trace_pack(enc, len);
+  enc.pack_bytes(buf.data(), len);
+}
+
+template <typename Msg>
+static bool unpack_asn1(sched_trace_decoder& dec, Msg& msg)
+{
+  uint32_t len = 0;
+  if (not sched_trace_unpack(dec, len) or len == 0) {
+    return false;
+  }
+  std::vector<uint8_t> buf(len);
+  if (not dec.unpack_bytes(buf.data(), len)) {
+    return false;
+  }
+  asn1::cbit_ref bref(buf.data(), buf.size());
+  return msg.unpack(bref) == asn1::SRSASN_SUCCESS;
+}
+
+template <typename Msg>
+static void pack_asn1(sched_trace_encoder& enc, const asn1::copy_ptr<Msg>& msg)
+{
+  sched_trace_pack(enc, msg.is_present());
+  if (msg.is_present()) {
+    pack_asn1(enc, *msg);
+  }
+}
+
+template <typename Msg>
+static bool unpack_asn1(sched_trace_decoder& dec, asn1::copy_ptr<Msg>& msg)
+{
+  bool present = false;
+  if (not sched_trace_unpack(dec, present)) {
+    return false;
+  }
+  msg.reset(present ? new Msg() : nullptr);
+  return not present or unpack_asn1(dec, *msg);
+}
+
+void sched_trace_pack(sched_trace_encoder& enc, const sched_nr_interface::sched_args_t& args)
+{
+  sched_trace_pack_all(enc,
+                       args.pdsch_enabled,
+                       args.pusch_enabled,
+                       args.auto_refill_buffer,
+                       args.fixed_dl_mcs,
+                       args.fixed_ul_mcs,
+                       args.target_bler,
+                       args.max_delta_dl_cqi,
+                       args.adaptive_dl_mcs_step_size,
+                       args.sched_policy,
+                       args.sched_policy_args,
+                       args.nof_lookahead_slots,
+                       args.nof_carrier_threads,
+                       args.logger_name);
+}
+
+bool sched_trace_unpack(sched_trace_decoder& dec, sched_nr_interface::sched_args_t& args)
+{
+  return sched_trace_unpack_all(dec,
+                                args.pdsch_enabled,
+                                args.pusch_enabled,
+                                args.auto_refill_buffer,
+                                args.fixed_dl_mcs,
+                                args.fixed_ul_mcs,
+                                args.target_bler,
+                                args.max_delta_dl_cqi,
+                                args.adaptive_dl_mcs_step_size,
+                                args.sched_policy,
+                                args.sched_policy_args,
+                                args.nof_lookahead_slots,
+                                args.nof_carrier_threads,
+                                args.logger_name);
+}
+
+void sched_trace_pack(sched_trace_encoder& enc, const sched_nr_cell_cfg_t& cfg)
+{
+  sched_trace_pack_all(enc, cfg.nof_layers, cfg.pci, cfg.dl_cell_nof_prb, cfg.ul_cell_nof_prb);
+  pack_asn1(enc, cfg.dl_cfg_common);
+  pack_asn1(enc, cfg.ul_cfg_common);
+  sched_trace_pack(enc, cfg.tdd_ul_dl_cfg_common.has_value());
+  if (cfg.tdd_ul_dl_cfg_common.has_value()) {
+    pack_asn1(enc, *cfg.tdd_ul_dl_cfg_common);
+  }
+  sched_trace_pack_all(enc,
+                       cfg.ssb_positions_in_burst.group_presence_present,
+                       cfg.ssb_positions_in_burst.in_one_group.to_number(),
+                       cfg.ssb_positions_in_burst.group_presence.to_number(),
+                       cfg.ssb_periodicity_ms,
+                       cfg.dmrs_type_a_position,
+                       cfg.ssb_scs);
+  pack_asn1(enc, cfg.pdcch_cfg_sib1);
+  sched_trace_pack_all(enc,
+                       cfg.ss_pbch_block_power,
+                       cfg.bwps,
+                       cfg.sibs,
+                       cfg.dl_center_frequency_hz,
+                       cfg.ul_center_frequency_hz,
+                       cfg.ssb_center_freq_hz);
+}
+
+bool sched_trace_unpack(sched_trace_decoder& dec, sched_nr_cell_cfg_t& cfg)
+{
+  if (not sched_trace_unpack_all(dec, cfg.nof_layers, cfg.pci, cfg.dl_cell_nof_prb, cfg.ul_cell_nof_prb) or
+      not unpack_asn1(dec, cfg.dl_cfg_common) or not unpack_asn1(dec, cfg.ul_cfg_common)) {
+    return false;
+  }
+  bool tdd = false;
+  if (not sched_trace_unpack(dec, tdd)) {
+    return false;
+  }
+  cfg.tdd_ul_dl_cfg_common.reset();
+  if (tdd) {
+    cfg.tdd_ul_dl_cfg_common.emplace();
+    if (not unpack_asn1(dec, *cfg.tdd_ul_dl_cfg_common)) {
+      return false;
+    }
+  }
+  uint64_t in_one_group = 0, group_presence = 0;
+  if (not sched_trace_unpack_all(dec,
+                                 cfg.ssb_positions_in_burst.group_presence_present,
+                                 in_one_group,
+                                 group_presence,
+                                 cfg.ssb_periodicity_ms,
+                                 cfg.dmrs_type_a_position,
+                                 cfg.ssb_scs)) {
+    return false;
+  }
+  cfg.ssb_positions_in_burst.in_one_group.from_number(in_one_group);
+  cfg.ssb_positions_in_burst.group_presence.from_number(group_presence);
+  return unpack_asn1(dec, cfg.pdcch_cfg_sib1) and
+         sched_trace_unpack_all(dec,
+                                cfg.ss_pbch_block_power,
+                                cfg.bwps,
+                                cfg.sibs,
+                                cfg.dl_center_frequency_hz,
+                                cfg.ul_center_frequency_hz,
+                                cfg.ssb_center_freq_hz);
+}
+
+void sched_trace_pack(sched_trace_encoder& enc, const sched_nr_ue_cfg_t& cfg)
+{
+  sched_trace_pack_all(enc, cfg.maxharq_tx, static_cast<uint32_t>(cfg.carriers.size()));
+  for (const sched_nr_ue_cc_cfg_t& cc : cfg.carriers) {
+    sched_trace_pack(enc, cc);
+  }
+  sched_trace_pack(enc, cfg.phy_cfg);
+  pack_asn1(enc, cfg.mac_cell_group_cfg);
+  pack_asn1(enc, cfg.phy_cell_group_cfg);
+  pack_asn1(enc, cfg.sp_cell_cfg);
+  sched_trace_pack_all(enc, cfg.lc_ch_to_add, cfg.lc_ch_to_rem);
+}
+
+bool sched_trace_unpack(sched_trace_decoder& dec, sched_nr_ue_cfg_t& cfg)
+{
+  uint32_t nof_carriers = 0;
+  if (not sched_trace_unpack_all(dec, cfg.maxharq_tx, nof_carriers) or nof_carriers > SCHED_NR_MAX_CARRIERS) {
+    return false;
+  }
+  cfg.carriers.resize(nof_carriers);
+  for (sched_nr_ue_cc_cfg_t& cc : cfg.carriers) {
+    if (not sched_trace_unpack(dec, cc)) {
+      return false;
+    }
+  }
+  return sched_trace_unpack(dec, cfg.phy_cfg) and unpack_asn1(dec, cfg.mac_cell_group_cfg) and
+         unpack_asn1(dec, cfg.phy_cell_group_cfg) and unpack_asn1(dec, cfg.sp_cell_cfg) and
+         sched_trace_unpack_all(dec, cfg.lc_ch_to_add, cfg.lc_ch_to_rem);
+}
+
+uint32_t sched_trace_nr_signature()
+{
+  return sched_trace_layout_signature<sched_nr_bwp_cfg_t,
+                                      sched_nr_cell_cfg_sib_t,
+                                      sched_nr_ue_cc_cfg_t,
+                                      srsran::phy_cfg_nr_t,
+                                      sched_nr_ue_lc_ch_cfg_t,
+                                      sched_nr_interface::rar_info_t,
+                                      slot_point>();
+}
+
+/*******************************************************
+ *                   Trace replay
+ *******************************************************/
+
+bool sched_nr_trace_player::play(const sched_trace_record& record)
+{
+  if (record.type >= static_cast<uint32_t>(sched_nr_trace_event::nof_events)) {
+    return false;
+  }
+  event = static_cast<sched_nr_trace_event>(record.type);
+
+  sched_trace_decoder dec(record.payload);
+  uint16_t            rnti = 0;
+  uint32_t            a = 0, b = 0;
+  bool                flag = false;
+  switch (event) {
+    case sched_nr_trace_event::config: {
+      sched_nr_interface::sched_args_t args;
+      std::vector<sched_nr_cell_cfg_t> cell_list;
+      if (not sched_trace_unpack_all(dec, args, cell_list)) {
+        return false;
+      }
+      sched_obj.config(args, cell_list);
+      break;
+    }
+    case sched_nr_trace_event::ue_cfg: {
+      sched_nr_ue_cfg_t ue_cfg;
+      if (not sched_trace_unpack_all(dec, rnti, ue_cfg)) {
+        return false;
+      }
+      sched_obj.ue_cfg(rnti, ue_cfg);
+      break;
+    }
+    case sched_nr_trace_event::ue_rem:
+      if (not sched_trace_unpack_all(dec, rnti)) {
+        return false;
+      }
+      sched_obj.ue_rem(rnti);
+      break;
+    case sched_nr_trace_event::dl_rach_info: {
+      sched_nr_interface::rar_info_t rar_info;
+      if (not sched_trace_unpack_all(dec, rar_info)) {
+        return false;
+      }
+      sched_obj.dl_rach_info(rar_info);
+      break;
+    }
+    case sched_nr_trace_event::dl_ack_info:
+      if (not sched_trace_unpack_all(dec, rnti, cc, a, b, flag)) {
+        return false;
+      }
+      sched_obj.dl_ack_info(rnti, cc, a, b, flag);
+      break;
+    case sched_nr_trace_event::ul_crc_info:
+      if (not sched_trace_unpack_all(dec, rnti, cc, a, flag)) {
+        return false;
+      }
+      sched_obj.ul_crc_info(rnti, cc, a, flag);
+      break;
+    case sched_nr_trace_event::ul_sr_info:
+      if (not sched_trace_unpack_all(dec, rnti)) {
+        return false;
+      }
+      sched_obj.ul_sr_info(rnti);
+      break;
+    case sched_nr_trace_event::ul_bsr:
+      if (not sched_trace_unpack_all(dec, rnti, a, b)) {
+        return false;
+      }
+      sched_obj.ul_bsr(rnti, a, b);
+      break;
+    case sched_nr_trace_event::dl_buffer_state: {
+      uint32_t retx = 0;
+      if (not sched_trace_unpack_all(dec, rnti, a, b, retx)) {
+        return false;
+      }
+      sched_obj.dl_buffer_state(rnti, a, b, retx);
+      break;
+    }
+    case sched_nr_trace_event::dl_mac_ce:
+      if (not sched_trace_unpack_all(dec, rnti, a)) {
+        return false;
+      }
+      sched_obj.dl_mac_ce(rnti, a);
+      break;
+    case sched_nr_trace_event::dl_cqi_info:
+      if (not sched_trace_unpack_all(dec, rnti, cc, a)) {
+        return false;
+      }
+      sched_obj.dl_cqi_info(rnti, cc, a);
+      break;
+    case sched_nr_trace_event::slot_indication:
+      if (not sched_trace_unpack_all(dec, slot)) {
+        return false;
+      }
+      sched_obj.slot_indication(slot);
+      break;
+    case sched_nr_trace_event::get_dl_sched:
+      if (not sched_trace_unpack_all(dec, slot, cc)) {
+        return false;
+      }
+      dl_res = sched_obj.get_dl_sched(slot, cc);
+      break;
+    case sched_nr_trace_event::get_ul_sched:
+      if (not sched_trace_unpack_all(dec, slot, cc)) {
+        return false;
+      }
+      ul_res = sched_obj.get_ul_sched(slot, cc);
+      break;
+    default:
+      return false;
+  }
+
+  return dec.empty();
+}
+
+/*******************************************************
+ *                 Decision summaries
+ *******************************************************/
+
+void sched_nr_trace_fmt_dl_result(fmt::memory_buffer&                 buffer,
+                                  slot_point                          slot,
+                                  uint32_t                            cc,
+                                  const sched_nr_interface::dl_res_t& result)
+{
+  fmt::format_to(buffer, "slot={} cc={} dl: ssb={}", slot, cc, result.phy.ssb.size());
+  for (const auto& pdcch : result.phy.pdcch_dl) {
+    fmt::format_to(buffer,
+                   " pdcch_dl=0x{:x},{}/{},{:x},{},{},{}",
+                   pdcch.dci.ctx.rnti,
+                   pdcch.dci.ctx.location.L,
+                   pdcch.dci.ctx.location.ncce,
+                   pdcch.dci.freq_domain_assigment,
+                   pdcch.dci.time_domain_assigment,
+                   pdcch.dci.mcs,
+                   pdcch.dci.pid);
+  }
+  for (const auto& pdcch : result.phy.pdcch_ul) {
+    fmt::format_to(buffer,
+                   " pdcch_ul=0x{:x},{}/{},{:x},{},{},{}",
+                   pdcch.dci.ctx.rnti,
+                   pdcch.dci.ctx.location.L,
+                   pdcch.dci.ctx.location.ncce,
+                   pdcch.dci.freq_domain_assigment,
+                   pdcch.dci.time_domain_assigment,
+                   pdcch.dci.mcs,
+                   pdcch.dci.pid);
+  }
+  for (const auto& pdsch : result.phy.pdsch) {
+    fmt::format_to(buffer, " pdsch=0x{:x},{}", pdsch.sch.grant.rnti, pdsch.sch.grant.tb[0].tbs);
+  }
+  for (const auto& rar : result.rar) {
+    fmt::format_to(buffer, " rar={}", rar.grants.size());
+  }
+  for (uint32_t sib_idx : result.sib_idxs) {
+    fmt::format_to(buffer, " sib={}", sib_idx);
+  }
+  fmt::format_to(buffer, "\n");
+}
+
+void sched_nr_trace_fmt_ul_result(fmt::memory_buffer&                 buffer,
+                                  slot_point                          slot,
+                                  uint32_t                            cc,
+                                  const sched_nr_interface::ul_res_t& result)
+{
+  fmt::format_to(buffer, "slot={} cc={} ul:", slot, cc);
+  for (const auto& pusch : result.pusch) {
+    fmt::format_to(buffer, " pusch=0x{:x},{},{}", pusch.sch.grant.rnti, pusch.pid, pusch.sch.grant.tb[0].tbs);
+  }
+  for (const auto& pucch : result.pucch) {
+    if (not pucch.candidates.empty()) {
+      fmt::format_to(buffer, " pucch=0x{:x},{}", pucch.candidates[0].uci_cfg.pucch.rnti, pucch.candidates.size());
+    }
+  }
+  fmt::format_to(buffer, "\n");
+}
+
+} // namespace srsenb
@@ -53,7 +53,7 @@ dl_sched_res_t* cc_worker::run_slot(slot_point tx_sl, ue_map_t& ue_db)
   }
   while (last_tx_sl != tx_sl) {
     last_tx_sl++;
-    slot_point old_slot = last_tx_sl - TX_ENB_DELAY - 1;
+    slot_point old_slot = last_tx_sl - cfg.sched_args.nof_lookahead_slots - TX_ENB_DELAY - 1;
     for (bwp_manager& bwp : bwps) {
       bwp.grid[old_slot].reset();
     }
@@ -108,6 +108,11 @@ dl_sched_res_t* cc_worker::run_slot(slot_point tx_sl, ue_map_t& ue_db)
   return &bwp_alloc.tx_slot_grid().dl;
 }
 
+dl_sched_res_t* cc_worker::get_dl_sched(slot_point sl)
+{
+  return &bwps[0].grid[sl].dl;
+}
+
 ul_sched_t* cc_worker::get_ul_sched(slot_point sl)
 {
   return &bwps[0].grid[sl].ul;
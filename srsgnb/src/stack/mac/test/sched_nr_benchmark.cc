@@ -0,0 +1,194 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "sched_nr_cfg_generators.h"
+#include "sched_nr_sim_ue.h"
+#include "srsran/common/test_common.h"
+#include <getopt.h>
+
+namespace srsenb {
+
+static uint32_t nof_ues     = SRSENB_MAX_UES / 2;
+static uint32_t nof_cells   = 4;
+static uint32_t nof_slots   = 2000;
+static uint32_t nof_threads = 2;
+static uint32_t lookahead   = 2;
+
+/// Test bench that reports a different CQI per UE and accumulates the DL bytes allocated to each UE
+class sched_nr_bench : public sched_nr_base_test_bench
+{
+public:
+  using sched_nr_base_test_bench::sched_nr_base_test_bench;
+
+  void set_external_slot_events(const sim_nr_ue_ctxt_t& ue_ctxt, ue_nr_slot_events& pending_events) override
+  {
+    for (auto& cc_feedback : pending_events.cc_list) {
+      if (cc_feedback.cqi >= 0) {
+        cc_feedback.cqi = 3 + (ue_ctxt.rnti * 7) % 13;
+      }
+    }
+  }
+
+  void process_slot_result(const sim_nr_enb_ctxt_t& slot_ctxt, srsran::const_span<cc_result_t> cc_list) override
+  {
+    tot_latency_sched_ns +=
+        std::max_element(cc_list.begin(), cc_list.end(), [](const cc_result_t& lhs, const cc_result_t& rhs) {
+          return lhs.cc_latency_ns < rhs.cc_latency_ns;
+        })->cc_latency_ns.count();
+
+    for (auto& cc_out : cc_list) {
+      for (auto& pdsch : cc_out.res.dl->phy.pdsch) {
+        if (pdsch.sch.grant.rnti_type == srsran_rnti_type_c) {
+          ue_dl_bytes[pdsch.sch.grant.rnti] += pdsch.sch.grant.tb[0].tbs / 8;
+        }
+      }
+    }
+  }
+
+  uint64_t tot_dl_bytes() const
+  {
+    uint64_t sum = 0;
+    for (auto& u : ue_dl_bytes) {
+      sum += u.second;
+    }
+    return sum;
+  }
+
+  /// Jain's fairness index of the DL bytes allocated to the UEs
+  double jain_index() const
+  {
+    double sum = 0, sum_sq = 0;
+    for (auto& u : ue_dl_bytes) {
+      sum += u.second;
+      sum_sq += (double)u.second * u.second;
+    }
+    return sum_sq > 0 ? sum * sum / (ue_dl_bytes.size() * sum_sq) : 0;
+  }
+
+  uint64_t                     tot_latency_sched_ns = 0;
+  std::map<uint16_t, uint64_t> ue_dl_bytes;
+};
+
+int run_sched_nr_bench(const char* policy, uint32_t threads, uint32_t lookahead_slots)
+{
+  sched_nr_interface::sched_args_t cfg;
+  cfg.auto_refill_buffer  = true;
+  cfg.fixed_dl_mcs        = -1;
+  cfg.sched_policy        = policy;
+  cfg.nof_carrier_threads = threads;
+  cfg.nof_lookahead_slots = lookahead_slots;
+
+  std::vector<sched_nr_cell_cfg_t> cells_cfg = get_default_cells_cfg(nof_cells);
+  std::string test_name = fmt::format("{} policy, {} carrier threads, {} lookahead slots", policy, threads, lookahead_slots);
+  sched_nr_bench bench(cfg, cells_cfg, test_name);
+
+  for (uint32_t n = 0; n < nof_slots; ++n) {
+    slot_point slot_tx = slot_point(0, n % 10240) + TX_ENB_DELAY;
+    if (n == 9) {
+      for (uint32_t i = 0; i < nof_ues; ++i) {
+        sched_nr_interface::ue_cfg_t uecfg = get_default_ue_cfg(nof_cells);
+        uecfg.lc_ch_to_add.emplace_back();
+        uecfg.lc_ch_to_add.back().lcid          = 1;
+        uecfg.lc_ch_to_add.back().cfg.direction = mac_lc_ch_cfg_t::BOTH;
+        bench.user_cfg(0x4601 + i, uecfg);
+      }
+    }
+    bench.run_slot(slot_tx);
+  }
+  bench.stop();
+
+  double elapsed_sec = bench.tot_latency_sched_ns / 1e9;
+  printf("%s: %d UEs, %d cells: %.0f slots/s, %.1f Mbps per cell, %d UEs served, Jain index %.3f\n",
+         test_name.c_str(),
+         nof_ues,
+         nof_cells,
+         nof_slots / elapsed_sec,
+         bench.tot_dl_bytes() * 8 / (nof_slots * 1e-3) / nof_cells / 1e6,
+         (int)bench.ue_dl_bytes.size(),
+         bench.jain_index());
+
+  TESTASSERT(bench.tot_dl_bytes() > 0);
+
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace srsenb
+
+void usage(char* prog)
+{
+  printf("Usage: %s [ucstl]\n", prog);
+  printf("\t-u Number of UEs [Default %d]\n", srsenb::nof_ues);
+  printf("\t-c Number of cells [Default %d]\n", srsenb::nof_cells);
+  printf("\t-s Number of slots [Default %d]\n", srsenb::nof_slots);
+  printf("\t-t Number of carrier threads [Default %d]\n", srsenb::nof_threads);
+  printf("\t-l Number of lookahead slots [Default %d]\n", srsenb::lookahead);
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "u:c:s:t:l:")) != -1) {
+    switch (opt) {
+      case 'u':
+        srsenb::nof_ues = std::min((uint32_t)strtol(optarg, NULL, 10), (uint32_t)SRSENB_MAX_UES);
+        break;
+      case 'c':
+        srsenb::nof_cells = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 's':
+        srsenb::nof_slots = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 't':
+        srsenb::nof_threads = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'l':
+        srsenb::lookahead = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  auto& test_logger = srslog::fetch_basic_logger("TEST");
+  test_logger.set_level(srslog::basic_levels::warning);
+  auto& mac_nr_logger = srslog::fetch_basic_logger("MAC-NR");
+  // Note: the PUCCH resources of the default cell configuration do not fit the UCI of all the UEs
+  mac_nr_logger.set_level(srslog::basic_levels::error);
+
+  // Start the log backend.
+  srslog::init();
+
+  // Serialized reference of both policies, then carrier threads and slot lookahead. The first run is repeated, as it
+  // also measures the warm-up of the memory pools
+  TESTASSERT(srsenb::run_sched_nr_bench("time_rr", 0, 0) == SRSRAN_SUCCESS);
+  TESTASSERT(srsenb::run_sched_nr_bench("time_rr", 0, 0) == SRSRAN_SUCCESS);
+  TESTASSERT(srsenb::run_sched_nr_bench("time_pf", 0, 0) == SRSRAN_SUCCESS);
+  TESTASSERT(srsenb::run_sched_nr_bench("time_pf", srsenb::nof_threads, 0) == SRSRAN_SUCCESS);
+  TESTASSERT(srsenb::run_sched_nr_bench("time_pf", srsenb::nof_threads, srsenb::lookahead) == SRSRAN_SUCCESS);
+
+  return SRSRAN_SUCCESS;
+}
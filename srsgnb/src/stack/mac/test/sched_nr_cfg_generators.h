@@ -69,6 +69,16 @@ inline sched_nr_cell_cfg_t get_default_cell_cfg(const srsran::phy_cfg_nr_t& phy_
       phy_cfg.carrier.offset_to_carrier;
   cell_cfg.dl_cfg_common.init_dl_bwp.generic_params.subcarrier_spacing =
       (asn1::rrc_nr::subcarrier_spacing_opts::options)phy_cfg.carrier.scs;
+  // Mandatory SIB1 fields, which the scheduler does not use
+  cell_cfg.dl_cfg_common.freq_info_dl.freq_band_list.resize(1);
+  cell_cfg.dl_cfg_common.bcch_cfg.mod_period_coeff.value = asn1::rrc_nr::bcch_cfg_s::mod_period_coeff_opts::n4;
+  cell_cfg.dl_cfg_common.pcch_cfg.default_paging_cycle.value = asn1::rrc_nr::paging_cycle_opts::rf128;
+  cell_cfg.dl_cfg_common.pcch_cfg.nand_paging_frame_offset.set_one_t();
+  cell_cfg.dl_cfg_common.pcch_cfg.ns.value = asn1::rrc_nr::pcch_cfg_s::ns_opts::one;
+  cell_cfg.ul_cfg_common.freq_info_ul.scs_specific_carrier_list =
+      cell_cfg.dl_cfg_common.freq_info_dl.scs_specific_carrier_list;
+  cell_cfg.ul_cfg_common.init_ul_bwp.generic_params    = cell_cfg.dl_cfg_common.init_dl_bwp.generic_params;
+  cell_cfg.ul_cfg_common.time_align_timer_common.value = asn1::rrc_nr::time_align_timer_opts::infinity;
   cell_cfg.ul_cfg_common.init_ul_bwp.rach_cfg_common_present = true;
   srsran::fill_rach_cfg_common(phy_cfg.prach, cell_cfg.ul_cfg_common.init_ul_bwp.rach_cfg_common.set_setup());
   cell_cfg.dl_cell_nof_prb    = phy_cfg.carrier.nof_prb;
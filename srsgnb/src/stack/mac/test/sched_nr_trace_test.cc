@@ -0,0 +1,147 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "sched_nr_cfg_generators.h"
+#include "sched_nr_sim_ue.h"
+#include "srsgnb/hdr/stack/mac/sched_nr.h"
+#include "srsgnb/hdr/stack/mac/sched_nr_trace.h"
+#include "srsran/common/test_common.h"
+
+namespace srsenb {
+
+static const char*    trace_filename = "sched_nr_trace_test.trace";
+static const uint32_t nof_cells      = 2;
+static const uint32_t nof_ues        = 8;
+static const uint32_t nof_slots      = 500;
+
+/// Test bench that keeps the description of every scheduling result
+class sched_nr_trace_bench : public sched_nr_base_test_bench
+{
+public:
+  using sched_nr_base_test_bench::sched_nr_base_test_bench;
+
+  void process_slot_result(const sim_nr_enb_ctxt_t& slot_ctxt, srsran::const_span<cc_result_t> cc_list) override
+  {
+    for (auto& cc_out : cc_list) {
+      fmt::memory_buffer buffer;
+      sched_nr_trace_fmt_dl_result(buffer, cc_out.res.slot, cc_out.res.cc, *cc_out.res.dl);
+      decisions.push_back(fmt::to_string(buffer));
+      buffer.clear();
+      sched_nr_trace_fmt_ul_result(buffer, cc_out.res.slot, cc_out.res.cc, *cc_out.res.ul);
+      decisions.push_back(fmt::to_string(buffer));
+    }
+  }
+
+  std::vector<std::string> decisions;
+};
+
+/// Runs the scenario with the trace enabled. Returns the decisions of the scheduler
+int record_scenario(std::vector<std::string>& decisions)
+{
+  sched_nr_interface::sched_args_t cfg;
+  cfg.auto_refill_buffer = true;
+  cfg.fixed_dl_mcs       = -1;
+  cfg.sched_policy       = "time_pf";
+  cfg.trace_filename     = trace_filename;
+
+  sched_nr_trace_bench bench(cfg, get_default_cells_cfg(nof_cells), "Trace recording");
+  for (uint32_t n = 0; n < nof_slots; ++n) {
+    slot_point slot_tx = slot_point(0, n % 10240) + TX_ENB_DELAY;
+    if (n == 9) {
+      for (uint32_t i = 0; i < nof_ues; ++i) {
+        sched_nr_interface::ue_cfg_t uecfg = get_default_ue_cfg(nof_cells);
+        uecfg.lc_ch_to_add.emplace_back();
+        uecfg.lc_ch_to_add.back().lcid          = 1;
+        uecfg.lc_ch_to_add.back().cfg.direction = mac_lc_ch_cfg_t::BOTH;
+        bench.user_cfg(0x4601 + i, uecfg);
+      }
+    }
+    bench.run_slot(slot_tx);
+  }
+  bench.stop();
+
+  decisions = std::move(bench.decisions);
+  return SRSRAN_SUCCESS;
+}
+
+/// Replays the trace in a new scheduler. Returns the decisions of the scheduler
+int replay_scenario(std::vector<std::string>& decisions)
+{
+  sched_trace_reader reader;
+  TESTASSERT(reader.open(trace_filename));
+  TESTASSERT(reader.get_rat() == sched_trace_rat::nr);
+  TESTASSERT(reader.get_layout_signature() == sched_trace_nr_signature());
+
+  sched_nr              sched_obj;
+  sched_nr_trace_player player(sched_obj);
+  sched_trace_record    record;
+  while (reader.read(record)) {
+    TESTASSERT(player.play(record));
+
+    fmt::memory_buffer buffer;
+    if (player.event == sched_nr_trace_event::get_dl_sched) {
+      sched_nr_trace_fmt_dl_result(buffer, player.slot, player.cc, *player.dl_res);
+      decisions.push_back(fmt::to_string(buffer));
+    } else if (player.event == sched_nr_trace_event::get_ul_sched) {
+      sched_nr_trace_fmt_ul_result(buffer, player.slot, player.cc, *player.ul_res);
+      decisions.push_back(fmt::to_string(buffer));
+    }
+  }
+  sched_obj.stop();
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_record_replay()
+{
+  std::vector<std::string> recorded, replayed;
+  TESTASSERT(record_scenario(recorded) == SRSRAN_SUCCESS);
+  TESTASSERT(replay_scenario(replayed) == SRSRAN_SUCCESS);
+
+  // The replayed scheduler must take the same decisions, and some of them must allocate data
+  TESTASSERT(recorded.size() == replayed.size());
+  for (uint32_t i = 0; i < recorded.size(); ++i) {
+    TESTASSERT(recorded[i] == replayed[i]);
+  }
+  TESTASSERT(std::any_of(recorded.begin(), recorded.end(), [](const std::string& s) {
+    return s.find(" pdsch=") != std::string::npos;
+  }));
+
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace srsenb
+
+int main()
+{
+  auto& test_logger = srslog::fetch_basic_logger("TEST");
+  test_logger.set_level(srslog::basic_levels::warning);
+  auto& mac_nr_logger = srslog::fetch_basic_logger("MAC-NR");
+  // Note: the PUCCH resources of the default cell configuration do not fit the UCI of all the UEs
+  mac_nr_logger.set_level(srslog::basic_levels::error);
+
+  srslog::init();
+
+  TESTASSERT(srsenb::test_record_replay() == SRSRAN_SUCCESS);
+
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -32,7 +32,11 @@ namespace lte {
 class cc_worker
 {
 public:
-  cc_worker(uint32_t cc_idx, uint32_t max_prb, phy_common* phy, srslog::basic_logger& logger);
+  cc_worker(uint32_t              cc_idx,
+            uint32_t              max_prb,
+            phy_common*           phy,
+            srsran_mem_arena_t*   arena,
+            srslog::basic_logger& logger);
   ~cc_worker();
 
   /* Functions used by main PHY thread */
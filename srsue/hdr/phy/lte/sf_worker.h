@@ -78,6 +78,7 @@ private:
   /* Inherited from thread_pool::worker. Function called every subframe to run the DL/UL processing */
   void work_imp() final;
 
+  void work_sf();
   void update_measurements();
   void reset_uci(srsran_uci_data_t* uci_data);
 
@@ -85,6 +86,12 @@ private:
 
   phy_common* phy = nullptr;
 
+  // Memory of the carrier workers, allocated once at construction
+  srsran_mem_arena_t arena = {};
+
+  // Measurements of the serving cells, reused every subframe
+  std::vector<phy_meas_t> serving_cells;
+
   srslog::basic_logger& logger;
 
   srsran_cell_t       cell = {};
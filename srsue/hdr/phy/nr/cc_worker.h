@@ -31,7 +31,11 @@ namespace nr {
 class cc_worker
 {
 public:
-  cc_worker(uint32_t cc_idx, srslog::basic_logger& log, state& phy_state_, const srsran::phy_cfg_nr_t& cfg);
+  cc_worker(uint32_t                    cc_idx,
+            srslog::basic_logger&       log,
+            state&                      phy_state_,
+            const srsran::phy_cfg_nr_t& cfg,
+            srsran_mem_arena_t*         arena);
   ~cc_worker();
 
   void update_cfg(const srsran::phy_cfg_nr_t& new_config);
@@ -44,7 +44,7 @@ public:
             state&                        phy_state_,
             const srsran::phy_cfg_nr_t&   cfg,
             srslog::basic_logger&         logger);
-  ~sf_worker() = default;
+  ~sf_worker();
 
   /* Functions used by main PHY thread */
   cf_t*    get_buffer(uint32_t cc_idx, uint32_t antenna_idx);
@@ -66,11 +66,16 @@ private:
   /* Inherited from thread_pool::worker. Function called every subframe to run the DL/UL processing */
   void work_imp() override;
 
+  void work_slot();
+
   void update_cfg(uint32_t cc_idx, const srsran::phy_cfg_nr_t& new_cfg);
 
 private:
   std::vector<std::unique_ptr<cc_worker> > cc_workers;
 
+  // Memory of the carrier workers, allocated once at construction
+  srsran_mem_arena_t arena = {};
+
   srsran::phy_common_interface&                  common;
   state&                                         phy_state;
   srslog::basic_logger&                          logger;
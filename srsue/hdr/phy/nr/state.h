@@ -76,6 +76,9 @@ private:
   /// Other measurements
   std::atomic<float> ul_ext_cfo_hz = {0.0f};
 
+  /// Heap allocations done by the workers while processing slots
+  std::atomic<uint32_t> nof_heap_allocs = {0};
+
   /**
    * @brief Resets all metrics (unprotected)
    */
@@ -440,6 +443,12 @@ public:
     ul_metrics.set(m);
   }
 
+  /**
+   * @brief Accounts the heap allocations done by a worker while processing a slot
+   * @param n Number of allocations
+   */
+  void add_heap_allocs(uint32_t n) { nof_heap_allocs += n; }
+
   /**
    * @brief Resets all metrics (protected)
    */
@@ -464,6 +473,7 @@ public:
     m.dl[cc]    = dl_metrics;
     m.ul[cc]    = ul_metrics;
     m.nof_active_cc++;
+    m.nof_heap_allocs += nof_heap_allocs.exchange(0);
 
     // Reset all metrics
     reset_metrics_();
@@ -235,6 +235,10 @@ public:
   void set_sync_metrics(const uint32_t& cc_idx, const sync_metrics_t& m);
   void get_sync_metrics(sync_metrics_t::array_t& m);
 
+  /* Heap allocations done by the workers while processing subframes, reset when read */
+  void     add_heap_allocs(uint32_t nof_allocs) { nof_heap_allocs += nof_allocs; }
+  uint32_t get_heap_allocs() { return nof_heap_allocs.exchange(0); }
+
   void reset();
   void reset_radio();
 
@@ -401,10 +405,11 @@ private:
 
   std::mutex metrics_mutex;
 
-  ch_metrics_t::array_t   ch_metrics   = {};
-  dl_metrics_t::array_t   dl_metrics   = {};
-  ul_metrics_t::array_t   ul_metrics   = {};
-  sync_metrics_t::array_t sync_metrics = {};
+  ch_metrics_t::array_t   ch_metrics      = {};
+  dl_metrics_t::array_t   dl_metrics      = {};
+  ul_metrics_t::array_t   ul_metrics      = {};
+  sync_metrics_t::array_t sync_metrics    = {};
+  std::atomic<uint32_t>   nof_heap_allocs = {0};
 
   // MBSFN
   bool     sib13_configured = false;
@@ -171,12 +171,13 @@ private:
 #undef PHY_METRICS_SET
 
 struct phy_metrics_t {
-  info_metrics_t::array_t info          = {};
-  sync_metrics_t::array_t sync          = {};
-  ch_metrics_t::array_t   ch            = {};
-  dl_metrics_t::array_t   dl            = {};
-  ul_metrics_t::array_t   ul            = {};
-  uint32_t                nof_active_cc = 0;
+  info_metrics_t::array_t info            = {};
+  sync_metrics_t::array_t sync            = {};
+  ch_metrics_t::array_t   ch              = {};
+  dl_metrics_t::array_t   dl              = {};
+  ul_metrics_t::array_t   ul              = {};
+  uint32_t                nof_active_cc   = 0;
+  uint32_t                nof_heap_allocs = 0; ///< Heap allocations by the workers while processing subframes
 };
 
 } // namespace srsue
@@ -41,6 +41,7 @@
 #include "srsran/srsran.h"
 #include "srsue/hdr/phy/lte/worker_pool.h"
 #include "srsue/hdr/phy/nr/worker_pool.h"
+#include "srsue/hdr/phy/wideband_search.h"
 #include "sync_state.h"
 
 namespace srsue {
@@ -146,6 +147,12 @@ private:
    */
   void run_cell_search_state();
 
+  /**
+   * Wideband pre-scan of the EARFCN list, marks the EARFCNs where a cell is detected. The result is kept for the
+   * following cell searches until the EARFCN list changes.
+   */
+  void run_wideband_search();
+
   /**
    * SFN synchronization using MIB. run_subframe() receives and processes 1 subframe
    * and returns
@@ -214,6 +221,10 @@ private:
   // Objects for internal use
   search                                                  search_p;
   sfn_sync                                                sfn_p;
+  std::unique_ptr<wideband_search>                        wb_search;
+  bool                                                    wb_search_pending = false;
+  std::vector<bool>                                       wb_candidates;
+  std::vector<uint32_t>                                   wb_earfcn_list; ///< EARFCN list wb_candidates belongs to
   std::vector<std::unique_ptr<scell::intra_measure_lte> > intra_freq_meas;
   std::mutex                                              intra_freq_cfg_mutex;
 
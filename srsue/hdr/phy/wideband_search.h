@@ -0,0 +1,100 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSUE_WIDEBAND_SEARCH_H
+#define SRSUE_WIDEBAND_SEARCH_H
+
+#include "srsran/common/thread_pool.h"
+#include "srsran/interfaces/radio_interfaces.h"
+#include "srsran/srslog/srslog.h"
+#include "srsran/srsran.h"
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace srsue {
+
+/**
+ * Searches LTE cells on a list of EARFCN. Channels that fit in the same capture bandwidth are received at once and
+ * every channel is down-converted, decimated and searched in parallel by a pool of workers. The search of a channel
+ * terminates as soon as a cell is detected with enough confidence, and the capture of a center frequency terminates
+ * when all its channels are done.
+ */
+class wideband_search
+{
+public:
+  struct args_t {
+    double                        srate_hz       = 23.04e6; ///< Capture sampling rate, multiple of 1.92 MHz
+    double                        usable_bw_hz   = 18e6;    ///< Span of channel centers searched in a single capture
+    uint32_t                      nof_workers    = 4;       ///< Number of threads searching channels
+    uint32_t                      capture_ms     = 5;       ///< Samples captured and processed in each step
+    uint32_t                      max_capture_ms = 100;     ///< Maximum capture time for each center frequency
+    srsran_ue_cellsearch_wb_cfg_t cfg            = {2.0f, 8.0f, 4};
+  };
+
+  struct result_t {
+    uint32_t                      earfcn         = 0;
+    bool                          found          = false; ///< The search terminated with a confident detection
+    bool                          best_effort    = false; ///< Not terminated, cell is the most detected one
+    srsran_ue_cellsearch_result_t cell           = {};
+    uint32_t                      search_time_ms = 0; ///< Capture time until the channel search terminated
+  };
+
+  explicit wideband_search(srslog::basic_logger& logger) : logger(logger) {}
+  ~wideband_search();
+
+  bool init(const args_t& args_);
+
+  /**
+   * Searches the given EARFCN list, the results keep the same order. The channels whose search did not terminate
+   * within the maximum capture time report the most detected cell, if any, as a best-effort result
+   * @param radio Radio used for capturing, its Rx frequency and sampling rate are modified
+   * @param earfcn_list List of DL EARFCN
+   * @return One result for each EARFCN
+   */
+  std::vector<result_t> run(srsran::radio_interface_phy* radio, const std::vector<uint32_t>& earfcn_list);
+
+private:
+  struct channel_t {
+    srsran_ue_cellsearch_wb_t cs     = {};
+    result_t*                 result = nullptr;
+    bool                      done   = false;
+  };
+
+  srslog::basic_logger&                     logger;
+  args_t                                    args        = {};
+  uint32_t                                  capture_len = 0;
+  std::unique_ptr<srsran::task_thread_pool> pool;
+  std::vector<std::unique_ptr<channel_t> >  channels;
+  std::vector<cf_t>                         capture_buffer[2];
+  std::mutex                                mutex;
+  std::condition_variable                   cvar;
+  uint32_t                                  nof_pending = 0;
+
+  bool search_group(srsran::radio_interface_phy* radio, double center_freq_hz, uint32_t nof_channels);
+  void dispatch(const cf_t* buffer, uint32_t nof_channels, uint32_t capture_count);
+  void wait_all();
+};
+
+} // namespace srsue
+
+#endif // SRSUE_WIDEBAND_SEARCH_H
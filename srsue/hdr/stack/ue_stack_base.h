@@ -41,6 +41,8 @@ typedef struct {
   pcap_args_t mac_pcap;
   pcap_args_t mac_nr_pcap;
   pcap_args_t nas_pcap;
+  int         compression_level; // zstd level, 0 writes plain PCAPs
+  uint32_t    max_pdu_len;       // Captured bytes of each MAC user-plane PDU, 0 captures whole PDUs
 } pkt_trace_args_t;
 
 typedef struct {
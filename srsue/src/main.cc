@@ -165,6 +165,8 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
     ("pcap.mac_filename", bpo::value<string>(&args->stack.pkt_trace.mac_pcap.filename)->default_value("/tmp/ue_mac.pcap"), "MAC layer capture filename")
     ("pcap.mac_nr_filename", bpo::value<string>(&args->stack.pkt_trace.mac_nr_pcap.filename)->default_value("/tmp/ue_mac_nr.pcap"), "MAC_NR layer capture filename")
     ("pcap.nas_filename", bpo::value<string>(&args->stack.pkt_trace.nas_pcap.filename)->default_value("/tmp/ue_nas.pcap"), "NAS layer capture filename")
+    ("pcap.compression_level", bpo::value<int>(&args->stack.pkt_trace.compression_level)->default_value(0), "zstd compression level of the packet captures (0 writes plain PCAPs)")
+    ("pcap.max_pdu_len", bpo::value<uint32_t>(&args->stack.pkt_trace.max_pdu_len)->default_value(0), "Captured bytes of each MAC user-plane PDU (0 captures whole PDUs)")
     
     ("gui.enable", bpo::value<bool>(&args->gui.enable)->default_value(false), "Enable GUI plots")
 
@@ -385,6 +387,18 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
      bpo::value<uint32_t>(&args->phy.estimator_fil_order)->default_value(4),
      "Sets the channel estimator smooth gaussian filter order (even values perform better).")
 
+    ("phy.estimator_mmse_enabled",
+     bpo::value<bool>(&args->phy.estimator_mmse_enabled)->default_value(false),
+     "Estimates the channel with a 2D MMSE filter instead of interpolating.")
+
+    ("phy.estimator_mmse_delay_ns",
+     bpo::value<float>(&args->phy.estimator_mmse_delay_ns)->default_value(0.0f),
+     "RMS delay spread assumed by the MMSE channel estimator (0 for default).")
+
+    ("phy.estimator_mmse_doppler_hz",
+     bpo::value<float>(&args->phy.estimator_mmse_doppler_hz)->default_value(0.0f),
+     "Maximum Doppler assumed by the MMSE channel estimator (0 for default).")
+
     ("phy.snr_to_cqi_offset",
      bpo::value<float>(&args->phy.snr_to_cqi_offset)->default_value(0),
      "Sets an offset in the SNR to CQI table. This is used to adjust the reported CQI.")
@@ -409,6 +423,10 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
       bpo::value<bool>(&args->phy.detect_cp)->default_value(false),
       "enable CP length detection")
 
+    ("phy.assert_no_alloc",
+     bpo::value<bool>(&args->phy.assert_no_alloc)->default_value(false),
+     "Aborts if a PHY worker allocates heap memory while processing a subframe (debug)")
+
     ("phy.in_sync_rsrp_dbm_th",
      bpo::value<float>(&args->phy.in_sync_rsrp_dbm_th)->default_value(-130.0f),
      "RSRP threshold (in dBm) above which the UE considers to be in-sync")
@@ -437,6 +455,10 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
      bpo::value<int>(&args->phy.force_N_id_1)->default_value(-1),
      "Force using a specific SSS (set to -1 to allow all SSSs).")
 
+    ("phy.cellsearch_wideband",
+     bpo::value<bool>(&args->phy.cellsearch_wideband)->default_value(false),
+     "Pre-scan the DL EARFCN list with wideband captures and search only the EARFCNs with a detected cell.")
+
     // PHY NR args
     ("phy.nr.store_pdsch_ko",
       bpo::value<bool>(&args->phy.nr_store_pdsch_ko)->default_value(false),
@@ -181,11 +181,16 @@ void metrics_stdout::set_metrics(const ue_metrics_t& metrics, const uint32_t per
     return;
   }
 
-  // always print RF error
+  // always print RF errors and PHY heap allocations
   if (metrics.rf.rf_error) {
     fmt::print("RF status: O={}, U={}, L={}\n", metrics.rf.rf_o, metrics.rf.rf_u, metrics.rf.rf_l);
   }
 
+  uint32_t nof_heap_allocs = metrics.phy.nof_heap_allocs + metrics.phy_nr.nof_heap_allocs;
+  if (nof_heap_allocs > 0) {
+    fmt::print("PHY status: {} heap allocations while processing TTIs\n", nof_heap_allocs);
+  }
+
   if (!do_print) {
     return;
   }
@@ -50,7 +50,11 @@ namespace lte {
  *
  */
 
-cc_worker::cc_worker(uint32_t cc_idx_, uint32_t max_prb, srsue::phy_common* phy_, srslog::basic_logger& logger) :
+cc_worker::cc_worker(uint32_t              cc_idx_,
+                     uint32_t              max_prb,
+                     srsue::phy_common*    phy_,
+                     srsran_mem_arena_t*   arena,
+                     srslog::basic_logger& logger) :
   logger(logger)
 {
   cc_idx = cc_idx_;
@@ -60,13 +64,14 @@ cc_worker::cc_worker(uint32_t cc_idx_, uint32_t max_prb, srsue::phy_common* phy_
 
   signal_buffer_max_samples = 3 * SRSRAN_SF_LEN_PRB(max_prb);
 
+  // Signal buffers belong to the worker arena
   for (uint32_t i = 0; i < phy->args->nof_rx_ant; i++) {
-    signal_buffer_rx[i] = srsran_vec_cf_malloc(signal_buffer_max_samples);
+    signal_buffer_rx[i] = SRSRAN_MEM_ARENA_ALLOC(arena, cf_t, signal_buffer_max_samples);
     if (!signal_buffer_rx[i]) {
       Error("Allocating memory");
       return;
     }
-    signal_buffer_tx[i] = srsran_vec_cf_malloc(signal_buffer_max_samples);
+    signal_buffer_tx[i] = SRSRAN_MEM_ARENA_ALLOC(arena, cf_t, signal_buffer_max_samples);
     if (!signal_buffer_tx[i]) {
       Error("Allocating memory");
       return;
@@ -78,6 +83,12 @@ cc_worker::cc_worker(uint32_t cc_idx_, uint32_t max_prb, srsue::phy_common* phy_
     return;
   }
 
+  // The PDSCH subframe buffers are released with the worker arena every subframe
+  if (srsran_pdsch_set_scratch(&ue_dl.pdsch, arena) < SRSRAN_SUCCESS) {
+    Error("Setting the PDSCH scratch");
+    return;
+  }
+
   if (srsran_ue_ul_init(&ue_ul, signal_buffer_tx[0], max_prb)) {
     Error("Initiating UE UL");
     return;
@@ -112,14 +123,6 @@ cc_worker::cc_worker(uint32_t cc_idx_, uint32_t max_prb, srsue::phy_common* phy_
 
 cc_worker::~cc_worker()
 {
-  for (uint32_t i = 0; i < phy->args->nof_rx_ant; i++) {
-    if (signal_buffer_tx[i]) {
-      free(signal_buffer_tx[i]);
-    }
-    if (signal_buffer_rx[i]) {
-      free(signal_buffer_rx[i]);
-    }
-  }
   srsran_ue_dl_free(&ue_dl);
   srsran_ue_ul_free(&ue_ul);
 }
@@ -155,7 +158,8 @@ bool cc_worker::set_cell_nolock(srsran_cell_t cell_)
       return false;
     }
 
-    if (cell.frame_type == SRSRAN_TDD && ue_dl_cfg.chest_cfg.estimator_alg != SRSRAN_ESTIMATOR_ALG_INTERPOLATE) {
+    if (cell.frame_type == SRSRAN_TDD && ue_dl_cfg.chest_cfg.estimator_alg != SRSRAN_ESTIMATOR_ALG_INTERPOLATE &&
+        ue_dl_cfg.chest_cfg.estimator_alg != SRSRAN_ESTIMATOR_ALG_MMSE) {
       chest_default_cfg.estimator_alg = SRSRAN_ESTIMATOR_ALG_INTERPOLATE;
       srsran::console("Enabling subframe interpolation for TDD cells (recommended setting)\n");
     }
@@ -926,6 +930,10 @@ int cc_worker::read_ce_abs(float* ce_abs, uint32_t tx_antenna, uint32_t rx_anten
 
 int cc_worker::read_pdsch_d(cf_t* pdsch_d)
 {
+  // Taken from the worker arena by the first decoded PDSCH
+  if (ue_dl.pdsch.d[0] == nullptr) {
+    return 0;
+  }
   memcpy(pdsch_d, ue_dl.pdsch.d[0], ue_dl_cfg.cfg.pdsch.grant.nof_re * sizeof(cf_t));
   return ue_dl_cfg.cfg.pdsch.grant.nof_re;
 }
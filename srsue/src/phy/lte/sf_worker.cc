@@ -60,10 +60,23 @@ sf_worker::sf_worker(uint32_t max_prb, phy_common* phy_, srslog::basic_logger& l
 {
   phy = phy_;
 
-  // ue_sync in phy.cc requires a buffer for 3 subframes
+  // ue_sync in phy.cc requires a buffer for 3 subframes for each Rx and Tx antenna
+  size_t buffer_sz = SRSRAN_MEM_ARENA_SIZE(cf_t, 3 * SRSRAN_SF_LEN_PRB(max_prb));
+  size_t arena_sz  = 2 * phy->args->nof_lte_carriers * phy->args->nof_rx_ant * buffer_sz;
+
+  // Subframe scratch is carved after the mark and released at the start of every subframe
+  arena_sz += phy->args->nof_lte_carriers * srsran_pdsch_scratch_size(max_prb, phy->args->nof_rx_ant);
+  if (srsran_mem_arena_init(&arena, arena_sz) < SRSRAN_SUCCESS) {
+    Error("Initiating worker arena");
+    return;
+  }
+
   for (uint32_t r = 0; r < phy->args->nof_lte_carriers; r++) {
-    cc_workers.push_back(new cc_worker(r, max_prb, phy, logger));
+    cc_workers.push_back(new cc_worker(r, max_prb, phy, &arena, logger));
   }
+  srsran_mem_arena_set_mark(&arena);
+
+  serving_cells.reserve(SRSRAN_MAX_CARRIERS);
 }
 
 sf_worker::~sf_worker()
@@ -71,6 +84,7 @@ sf_worker::~sf_worker()
   for (uint32_t r = 0; r < phy->args->nof_lte_carriers; r++) {
     delete cc_workers[r];
   }
+  srsran_mem_arena_free(&arena);
 }
 
 void sf_worker::reset_cell_nolock(uint32_t cc_idx)
@@ -156,6 +170,17 @@ void sf_worker::set_config_nolock(uint32_t cc_idx, const srsran::phy_cfg_t& phy_
 }
 
 void sf_worker::work_imp()
+{
+  // Release the previous subframe scratch
+  srsran_mem_arena_reset(&arena);
+
+  // Count the heap allocations of the subframe processing
+  srsran_mem_guard_enter(phy->args->assert_no_alloc);
+  work_sf();
+  phy->add_heap_allocs(srsran_mem_guard_exit());
+}
+
+void sf_worker::work_sf()
 {
   uint32_t            tti           = context.sf_idx;
   srsran::rf_buffer_t tx_signal_ptr = {};
@@ -256,7 +281,7 @@ void sf_worker::reset_uci(srsran_uci_data_t* uci_data)
 
 void sf_worker::update_measurements()
 {
-  std::vector<phy_meas_t> serving_cells = {};
+  serving_cells.clear();
   for (uint32_t cc_idx = 0; cc_idx < cc_workers.size(); cc_idx++) {
     cf_t* rssi_power_buffer = nullptr;
     // Setting rssi_power_buffer to nullptr disables RSSI update. Do it only by worker 0
@@ -28,25 +28,35 @@
 namespace srsue {
 namespace nr {
 
-cc_worker::cc_worker(uint32_t cc_idx_, srslog::basic_logger& log, state& phy_state_, const srsran::phy_cfg_nr_t& cfg) :
+cc_worker::cc_worker(uint32_t                    cc_idx_,
+                     srslog::basic_logger&       log,
+                     state&                      phy_state_,
+                     const srsran::phy_cfg_nr_t& cfg,
+                     srsran_mem_arena_t*         arena) :
   cc_idx(cc_idx_), phy(phy_state_), cfg(cfg), logger(log)
 {
   cf_t* rx_buffer_c[SRSRAN_MAX_PORTS] = {};
 
-  // Allocate buffers
+  // Carve buffers from the worker arena
   buffer_sz = SRSRAN_SF_LEN_PRB(phy.args.dl.nof_max_prb) * 5;
   for (uint32_t i = 0; i < phy.args.dl.nof_rx_antennas; i++) {
-    rx_buffer[i]   = srsran_vec_cf_malloc(buffer_sz);
+    rx_buffer[i]   = SRSRAN_MEM_ARENA_ALLOC(arena, cf_t, buffer_sz);
     rx_buffer_c[i] = rx_buffer[i];
-    tx_buffer[i]   = srsran_vec_cf_malloc(buffer_sz);
+    tx_buffer[i]   = SRSRAN_MEM_ARENA_ALLOC(arena, cf_t, buffer_sz);
   }
 
-  if (srsran_ue_dl_nr_init(&ue_dl, rx_buffer.data(), &phy.args.dl) < SRSRAN_SUCCESS) {
+  // The PDSCH and PUSCH slot buffers are released with the worker arena every slot
+  srsran_ue_dl_nr_args_t dl_args = phy.args.dl;
+  srsran_ue_ul_nr_args_t ul_args = phy.args.ul;
+  dl_args.pdsch.scratch          = arena;
+  ul_args.pusch.scratch          = arena;
+
+  if (srsran_ue_dl_nr_init(&ue_dl, rx_buffer.data(), &dl_args) < SRSRAN_SUCCESS) {
     ERROR("Error initiating UE DL NR");
     return;
   }
 
-  if (srsran_ue_ul_nr_init(&ue_ul, tx_buffer[0], &phy.args.ul) < SRSRAN_SUCCESS) {
+  if (srsran_ue_ul_nr_init(&ue_ul, tx_buffer[0], &ul_args) < SRSRAN_SUCCESS) {
     ERROR("Error initiating UE DL NR");
     return;
   }
@@ -66,16 +76,6 @@ cc_worker::~cc_worker()
   srsran_ue_dl_nr_free(&ue_dl);
   srsran_ue_ul_nr_free(&ue_ul);
   srsran_ssb_free(&ssb);
-  for (cf_t* p : rx_buffer) {
-    if (p != nullptr) {
-      free(p);
-    }
-  }
-  for (cf_t* p : tx_buffer) {
-    if (p != nullptr) {
-      free(p);
-    }
-  }
 }
 
 void cc_worker::update_cfg(const srsran::phy_cfg_nr_t& new_config)
@@ -708,6 +708,11 @@ bool cc_worker::work_ul()
 
 int cc_worker::read_pdsch_d(cf_t* pdsch_d)
 {
+  // Taken from the worker arena by the first decoded PDSCH
+  if (ue_dl.pdsch.d[0] == nullptr) {
+    return 0;
+  }
+
   uint32_t nof_re = ue_dl.carrier.nof_prb * SRSRAN_NRE * 12;
   srsran_vec_cf_copy(pdsch_d, ue_dl.pdsch.d[0], nof_re);
   return nof_re;
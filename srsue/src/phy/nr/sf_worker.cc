@@ -43,10 +43,30 @@ sf_worker::sf_worker(srsran::phy_common_interface& common_,
                      srslog::basic_logger&         log) :
   phy_state(phy_state_), common(common_), logger(log), sf_len(SRSRAN_SF_LEN_PRB_NR(cfg.carrier.nof_prb))
 {
+  // Each carrier worker has 5 subframes of Rx and Tx buffers for each antenna
+  size_t buffer_sz = SRSRAN_MEM_ARENA_SIZE(cf_t, SRSRAN_SF_LEN_PRB(phy_state.args.dl.nof_max_prb) * 5);
+  size_t arena_sz  = 2 * phy_state.args.nof_carriers * phy_state.args.dl.nof_rx_antennas * buffer_sz;
+
+  // Slot scratch is carved after the mark and released at the start of every slot
+  arena_sz += phy_state.args.nof_carriers * (srsran_pdsch_nr_scratch_size(&phy_state.args.dl.pdsch) +
+                                             srsran_pusch_nr_scratch_size(&phy_state.args.ul.pusch));
+  if (srsran_mem_arena_init(&arena, arena_sz) < SRSRAN_SUCCESS) {
+    logger.error("Error initiating worker arena");
+    return;
+  }
+
   for (uint32_t i = 0; i < phy_state.args.nof_carriers; i++) {
-    cc_worker* w = new cc_worker(i, log, phy_state, cfg);
+    cc_worker* w = new cc_worker(i, log, phy_state, cfg, &arena);
     cc_workers.push_back(std::unique_ptr<cc_worker>(w));
   }
+  srsran_mem_arena_set_mark(&arena);
+}
+
+sf_worker::~sf_worker()
+{
+  // The carrier workers use the arena memory
+  cc_workers.clear();
+  srsran_mem_arena_free(&arena);
 }
 
 void sf_worker::update_cfg(uint32_t cc_idx, const srsran::phy_cfg_nr_t& new_cfg)
@@ -82,6 +102,17 @@ void sf_worker::set_context(const srsran::phy_common_interface::worker_context_t
 }
 
 void sf_worker::work_imp()
+{
+  // Release the previous slot scratch
+  srsran_mem_arena_reset(&arena);
+
+  // Count the heap allocations of the slot processing
+  srsran_mem_guard_enter(phy_state.args.assert_no_alloc);
+  work_slot();
+  phy_state.add_heap_allocs(srsran_mem_guard_exit());
+}
+
+void sf_worker::work_slot()
 {
   srsran::rf_buffer_t tx_buffer = {};
 
@@ -202,8 +202,13 @@ int worker_pool::set_rar_grant(uint32_t                                       ra
   return SRSRAN_SUCCESS;
 }
 
-bool worker_pool::set_config(const srsran::phy_cfg_nr_t& new_cfg)
+bool worker_pool::set_config(const srsran::phy_cfg_nr_t& cfg_)
 {
+  // Add the receiver only parameters to the configuration provided by the higher layers
+  srsran::phy_cfg_nr_t new_cfg   = cfg_;
+  new_cfg.pdsch.dmrs_mmse_enable = phy_state.args.pdsch_mmse_enable;
+  new_cfg.pdsch.dmrs_mmse        = phy_state.args.pdsch_mmse;
+
   uint32_t dl_arfcn = srsran::srsran_band_helper().freq_to_nr_arfcn(new_cfg.carrier.dl_center_frequency_hz);
   sf_sz             = SRSRAN_SF_LEN_PRB_NR(new_cfg.carrier.nof_prb);
 
@@ -204,7 +204,8 @@ void phy::get_metrics(const srsran::srsran_rat_t& rat, phy_metrics_t* m)
     common.get_dl_metrics(m->dl);
     common.get_ul_metrics(m->ul);
     common.get_sync_metrics(m->sync);
-    m->nof_active_cc = args.nof_lte_carriers;
+    m->nof_active_cc   = args.nof_lte_carriers;
+    m->nof_heap_allocs = common.get_heap_allocs();
     return;
   }
 
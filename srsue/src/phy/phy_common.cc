@@ -104,6 +104,11 @@ void phy_common::set_ue_dl_cfg(srsran_ue_dl_cfg_t* ue_dl_cfg)
   chest_cfg->sync_error_enable = args->correct_sync_error;
   chest_cfg->estimator_alg =
       args->interpolate_subframe_enabled ? SRSRAN_ESTIMATOR_ALG_INTERPOLATE : SRSRAN_ESTIMATOR_ALG_AVERAGE;
+  if (args->estimator_mmse_enabled) {
+    chest_cfg->estimator_alg            = SRSRAN_ESTIMATOR_ALG_MMSE;
+    chest_cfg->mmse_cfg.delay_spread_ns = args->estimator_mmse_delay_ns;
+    chest_cfg->mmse_cfg.doppler_hz      = args->estimator_mmse_doppler_hz;
+  }
   chest_cfg->cfo_estimate_enable  = args->cfo_ref_mask != 0;
   chest_cfg->cfo_estimate_sf_mask = args->cfo_ref_mask;
 }
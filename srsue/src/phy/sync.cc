@@ -93,6 +93,14 @@ void sync::init(srsran::radio_interface_phy* _radio,
   // Initialize cell searcher
   search_p.init(sf_buffer, nof_rf_channels, this, worker_com->args->force_N_id_2, worker_com->args->force_N_id_1);
   search_p.set_cp_en(worker_com->args->detect_cp);
+
+  if (worker_com->args->cellsearch_wideband) {
+    wb_search = std::unique_ptr<wideband_search>(new wideband_search(phy_logger));
+    if (not wb_search->init(wideband_search::args_t{})) {
+      phy_logger.warning("Wideband cell search could not be initialised, searching EARFCNs one by one");
+      wb_search.reset();
+    }
+  }
   // Initialize SFN synchronizer, it uses only pcell buffer
   sfn_p.init(&ue_sync, worker_com->args, sf_buffer, sf_buffer.size());
 
@@ -239,6 +247,28 @@ rrc_interface_phy_lte::cell_search_ret_t sync::cell_search_start(phy_cell_t* fou
 
   rrc_proc_state = PROC_SEARCH_RUNNING;
 
+  // Pre-scan the whole EARFCN list at once, then search only the EARFCNs with a cell. The pre-scan result is reused by
+  // the following searches and it is only repeated when the EARFCN list (and with it the band) changes
+  if (earfcn < 0 and wb_search != nullptr) {
+    if (wb_earfcn_list != worker_com->args->dl_earfcn_list) {
+      cellsearch_earfcn_index = 0;
+      wb_search_pending       = true;
+      phy_state.run_cell_search();
+      // The pre-scan changed the sampling rate
+      srate.reset();
+    }
+    while (cellsearch_earfcn_index < wb_candidates.size() and not wb_candidates[cellsearch_earfcn_index]) {
+      cellsearch_earfcn_index++;
+    }
+    if (cellsearch_earfcn_index >= worker_com->args->dl_earfcn_list.size()) {
+      Info("Cell Search: No cell detected in the remaining EARFCNs");
+      cellsearch_earfcn_index = 0;
+      ret.found               = rrc_interface_phy_lte::cell_search_ret_t::CELL_NOT_FOUND;
+      rrc_proc_state          = PROC_IDLE;
+      return ret;
+    }
+  }
+
   if (srate.set_find()) {
     radio_h->set_rx_srate(1.92e6);
     radio_h->set_tx_srate(1.92e6);
@@ -286,7 +316,7 @@ rrc_interface_phy_lte::cell_search_ret_t sync::cell_search_start(phy_cell_t* fou
   }
 
   cellsearch_earfcn_index++;
-  if (cellsearch_earfcn_index >= worker_com->args->dl_earfcn_list.size() or earfcn < 0) {
+  if (cellsearch_earfcn_index >= worker_com->args->dl_earfcn_list.size() or earfcn >= 0) {
     Info("Cell Search: No more frequencies in the current EARFCN set");
     cellsearch_earfcn_index = 0;
     ret.last_freq           = rrc_interface_phy_lte::cell_search_ret_t::NO_MORE_FREQS;
@@ -422,6 +452,13 @@ bool sync::wait_idle()
 
 void sync::run_cell_search_state()
 {
+  if (wb_search_pending) {
+    wb_search_pending = false;
+    run_wideband_search();
+    phy_state.state_exit();
+    return;
+  }
+
   srsran_cell_t tmp_cell = cell.get();
   cell_search_ret        = search_p.run(&tmp_cell, mib);
   if (cell_search_ret == search::CELL_FOUND) {
@@ -431,6 +468,26 @@ void sync::run_cell_search_state()
   phy_state.state_exit();
 }
 
+void sync::run_wideband_search()
+{
+  const std::vector<uint32_t>& earfcn_list = worker_com->args->dl_earfcn_list;
+
+  std::vector<wideband_search::result_t> results = wb_search->run(radio_h, earfcn_list);
+
+  // Channels reported as best-effort are searched too, the narrowband search confirms them with the MIB
+  wb_candidates.assign(earfcn_list.size(), false);
+  wb_earfcn_list = earfcn_list;
+  uint32_t nof_candidates = 0;
+  for (uint32_t i = 0; i < results.size(); i++) {
+    if (results[i].found or results[i].best_effort) {
+      wb_candidates[i] = true;
+      nof_candidates++;
+    }
+  }
+  Info("Cell Search: Wideband pre-scan detected cells in %d of %zd EARFCNs", nof_candidates, earfcn_list.size());
+  cell_search_ret = search::CELL_NOT_FOUND;
+}
+
 void sync::run_sfn_sync_state()
 {
   srsran_cell_t old_cell = cell.get();
@@ -0,0 +1,221 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_ENB_RF_EMULATOR_H
+#define SRSRAN_ENB_RF_EMULATOR_H
+
+#include <algorithm>
+#include <cmath>
+#include <srsran/interfaces/radio_interfaces.h>
+#include <srsran/phy/resampling/resampler.h>
+#include <srsran/srsran.h>
+#include <srsran/support/srsran_assert.h>
+#include <vector>
+
+/**
+ * Wideband radio emulator of several LTE cells, possibly on different EARFCN. Each cell transmits only PSS and SSS with
+ * 6 PRB. The received signal follows the Rx frequency and sampling rate set through the radio interface.
+ */
+class enb_rf_emulator final : public srsran::radio_interface_phy
+{
+public:
+  struct cell_t {
+    uint32_t earfcn;
+    uint32_t pci;
+    uint32_t delay_samples; ///< Frame delay, in samples of the narrowband rate
+  };
+
+  struct args_t {
+    double              srate_hz = 23.04e6;
+    std::vector<cell_t> cells;
+    float               snr_db = 10.0f; ///< Signal-to-noise ratio of the PSS/SSS symbols in the capture bandwidth
+    uint32_t            seed   = 0;
+  };
+
+  enb_rf_emulator(const args_t& args_) : args(args_)
+  {
+    set_rx_srate(args.srate_hz);
+    srsran_assert(srsran_channel_awgn_init(&awgn, args.seed) == SRSRAN_SUCCESS, "Error initiating AWGN");
+    srsran_channel_awgn_set_n0(&awgn, -args.snr_db);
+  }
+
+  ~enb_rf_emulator() { srsran_channel_awgn_free(&awgn); }
+
+  void tx_end() override {}
+  bool tx(srsran::rf_buffer_interface& tx_buffer, const srsran::rf_timestamp_interface& tx_time) override
+  {
+    return false;
+  }
+  bool rx_now(srsran::rf_buffer_interface& rx_buffer, srsran::rf_timestamp_interface& rxd_time) override
+  {
+    uint32_t nof_samples = rx_buffer.get_nof_samples();
+    cf_t*    out         = rx_buffer.get(0);
+    if (out == nullptr) {
+      return false;
+    }
+
+    if (temp.size() < nof_samples) {
+      temp.resize(nof_samples);
+    }
+
+    srsran_vec_cf_zero(out, nof_samples);
+    for (const cell_signal_t& cell : cells) {
+      double offset_hz = cell.freq_hz - rx_freq_hz;
+      if (std::abs(offset_hz) + SRSRAN_PSS_LEN * 15e3 / 2 > srate_hz / 2) {
+        continue;
+      }
+
+      // Repeat the periodic frame
+      uint32_t frame_len = cell.frame.size();
+      uint32_t count     = 0;
+      while (count < nof_samples) {
+        uint32_t idx = (sample_count + count) % frame_len;
+        uint32_t n   = std::min(frame_len - idx, nof_samples - count);
+        srsran_vec_cf_copy(&temp[count], &cell.frame[idx], n);
+        count += n;
+      }
+
+      // Shift to the channel frequency, keeping the phase continuous between calls
+      double freq_norm = offset_hz / srate_hz;
+      float  phase     = (float)(2.0 * M_PI * std::fmod(freq_norm * (double)sample_count, 1.0));
+      cf_t   phase0;
+      __real__ phase0 = cosf(phase);
+      __imag__ phase0 = sinf(phase);
+      srsran_vec_apply_cfo(temp.data(), (float)freq_norm, temp.data(), nof_samples);
+      srsran_vec_sc_prod_ccc(temp.data(), phase0, temp.data(), nof_samples);
+      srsran_vec_sum_ccc(out, temp.data(), out, nof_samples);
+    }
+
+    srsran_channel_awgn_run_c(&awgn, out, out, nof_samples);
+
+    sample_count += nof_samples;
+    rxd_time.add((double)nof_samples / srate_hz);
+
+    return true;
+  }
+  void set_tx_freq(const uint32_t& carrier_idx, const double& freq) override {}
+  void set_rx_freq(const uint32_t& carrier_idx, const double& freq) override { rx_freq_hz = freq; }
+  void release_freq(const uint32_t& carrier_idx) override {}
+  void set_tx_gain(const float& gain) override {}
+  void set_rx_gain_th(const float& gain) override {}
+  void set_rx_gain(const float& gain) override {}
+  void set_tx_srate(const double& srate) override {}
+  void set_rx_srate(const double& srate) override
+  {
+    if (srate == srate_hz and not cells.empty()) {
+      return;
+    }
+    srate_hz = srate;
+    cells.clear();
+    for (const cell_t& cell : args.cells) {
+      cells.emplace_back(generate_cell(cell));
+    }
+  }
+  void              set_channel_rx_offset(uint32_t ch, int32_t offset_samples) override {}
+  double            get_freq_offset() override { return 0; }
+  float             get_rx_gain() override { return 0; }
+  bool              is_continuous_tx() override { return false; }
+  bool              get_is_start_of_burst() override { return false; }
+  bool              is_init() override { return true; }
+  void              reset() override {}
+  srsran_rf_info_t* get_info() override { return nullptr; }
+
+private:
+  struct cell_signal_t {
+    double            freq_hz;
+    std::vector<cf_t> frame; ///< One radio frame at the Rx sampling rate, centered at DC
+  };
+
+  args_t                     args;
+  double                     srate_hz     = 0.0;
+  double                     rx_freq_hz   = 0.0;
+  uint64_t                   sample_count = 0;
+  srsran_channel_awgn_t      awgn         = {};
+  std::vector<cf_t>          temp;
+  std::vector<cell_signal_t> cells;
+
+  cell_signal_t generate_cell(const cell_t& cell)
+  {
+    const uint32_t    fft_size = srsran_symbol_sz(SRSRAN_CS_NOF_PRB);
+    const uint32_t    sf_len   = SRSRAN_SF_LEN(fft_size);
+    const uint32_t    nb_len   = SRSRAN_NOF_SF_X_FRAME * sf_len;
+    const uint32_t    ratio    = (uint32_t)std::round(srate_hz / SRSRAN_CS_SAMP_FREQ);
+    const uint32_t    nof_re   = SRSRAN_SF_LEN_RE(SRSRAN_CS_NOF_PRB, SRSRAN_CP_NORM);
+    cf_t              pss[SRSRAN_PSS_LEN];
+    float             sss0[SRSRAN_SSS_LEN];
+    float             sss5[SRSRAN_SSS_LEN];
+    std::vector<cf_t> grid(nof_re);
+    std::vector<cf_t> nb_frame(nb_len);
+
+    srsran_pss_generate(pss, cell.pci % SRSRAN_NOF_NID_2);
+    srsran_sss_generate(sss0, sss5, cell.pci);
+
+    // Generate PSS/SSS in subframes 0 and 5 at the cell search rate
+    std::vector<cf_t> sf(sf_len);
+    srsran_ofdm_t     ofdm = {};
+    srsran_assert(srsran_ofdm_tx_init(&ofdm, SRSRAN_CP_NORM, grid.data(), sf.data(), SRSRAN_CS_NOF_PRB) ==
+                      SRSRAN_SUCCESS,
+                  "Error initiating OFDM");
+    for (uint32_t sf_idx = 0; sf_idx < SRSRAN_NOF_SF_X_FRAME; sf_idx++) {
+      srsran_vec_cf_zero(grid.data(), nof_re);
+      if (sf_idx == 0 or sf_idx == 5) {
+        srsran_pss_put_slot(pss, grid.data(), SRSRAN_CS_NOF_PRB, SRSRAN_CP_NORM);
+        srsran_sss_put_slot(sf_idx == 0 ? sss0 : sss5, grid.data(), SRSRAN_CS_NOF_PRB, SRSRAN_CP_NORM);
+      }
+      srsran_ofdm_tx_sf(&ofdm);
+
+      // Apply the delay circularly
+      uint32_t start = (sf_idx * sf_len + cell.delay_samples) % nb_len;
+      for (uint32_t i = 0; i < sf_len; i++) {
+        nb_frame[(start + i) % nb_len] = sf[i];
+      }
+    }
+    srsran_ofdm_tx_free(&ofdm);
+
+    cell_signal_t signal = {};
+    signal.freq_hz       = srsran_band_fd(cell.earfcn) * 1e6;
+    signal.frame.resize(nb_len * ratio);
+
+    // Interpolate twice so the second frame has the steady state of the periodic signal
+    if (ratio > 1) {
+      srsran_resampler_fft_t interp = {};
+      srsran_assert(srsran_resampler_fft_init(&interp, SRSRAN_RESAMPLER_MODE_INTERPOLATE, ratio) == SRSRAN_SUCCESS,
+                    "Error initiating interpolator");
+      srsran_resampler_fft_run(&interp, nb_frame.data(), signal.frame.data(), nb_len);
+      srsran_resampler_fft_run(&interp, nb_frame.data(), signal.frame.data(), nb_len);
+      srsran_resampler_fft_free(&interp);
+    } else {
+      srsran_vec_cf_copy(signal.frame.data(), nb_frame.data(), nb_len);
+    }
+
+    // Normalise the average power of the PSS/SSS symbols (4 out of 140 symbols in a frame) to 0 dBfs
+    float frame_pwr  = srsran_vec_avg_power_cf(signal.frame.data(), signal.frame.size());
+    float symbol_pwr = frame_pwr * (SRSRAN_NOF_SF_X_FRAME * SRSRAN_CP_NORM_SF_NSYMB) / 4.0f;
+    if (std::isnormal(symbol_pwr)) {
+      srsran_vec_sc_prod_cfc(
+          signal.frame.data(), 1.0f / std::sqrt(symbol_pwr), signal.frame.data(), signal.frame.size());
+    }
+
+    return signal;
+  }
+};
+
+#endif // SRSRAN_ENB_RF_EMULATOR_H
@@ -0,0 +1,221 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "enb_rf_emulator.h"
+#include "srsran/common/test_common.h"
+#include "srsran/srslog/srslog.h"
+#include "srsue/hdr/phy/wideband_search.h"
+#include <boost/program_options.hpp>
+#include <boost/program_options/parsers.hpp>
+#include <chrono>
+#include <iostream>
+#include <map>
+
+struct args_t {
+  double      srate_hz       = 23.04e6;
+  uint32_t    nof_workers    = 4;
+  float       snr_db         = -3.0f;
+  uint32_t    earfcn_start   = 2850;
+  uint32_t    earfcn_step    = 20;
+  uint32_t    nof_earfcn     = 10;
+  uint32_t    max_capture_ms = 100;
+  uint32_t    seed           = 0;
+  std::string log_level      = "error";
+};
+
+// shorten boost program options namespace
+namespace bpo = boost::program_options;
+
+static int parse_args(int argc, char** argv, args_t& args)
+{
+  int ret = SRSRAN_SUCCESS;
+
+  bpo::options_description options("General options");
+
+  // clang-format off
+  options.add_options()
+      ("help,h",         "Show this message")
+      ("srate",          bpo::value<double>(&args.srate_hz)->default_value(args.srate_hz),             "Capture sampling rate in Hz")
+      ("nof_workers",    bpo::value<uint32_t>(&args.nof_workers)->default_value(args.nof_workers),     "Number of search workers")
+      ("snr",            bpo::value<float>(&args.snr_db)->default_value(args.snr_db),                  "PSS/SSS SNR in the capture bandwidth in dB")
+      ("earfcn_start",   bpo::value<uint32_t>(&args.earfcn_start)->default_value(args.earfcn_start),   "First DL EARFCN to search")
+      ("earfcn_step",    bpo::value<uint32_t>(&args.earfcn_step)->default_value(args.earfcn_step),     "DL EARFCN step between searched channels")
+      ("nof_earfcn",     bpo::value<uint32_t>(&args.nof_earfcn)->default_value(args.nof_earfcn),       "Number of searched channels, cells are emulated on every other channel")
+      ("max_capture_ms", bpo::value<uint32_t>(&args.max_capture_ms)->default_value(args.max_capture_ms), "Maximum capture time per center frequency")
+      ("seed",           bpo::value<uint32_t>(&args.seed)->default_value(args.seed),                   "Random seed")
+      ("log_level",      bpo::value<std::string>(&args.log_level)->default_value(args.log_level),      "Log level (none, warning, info, debug)")
+      ;
+  // clang-format on
+
+  bpo::variables_map vm;
+  try {
+    bpo::store(bpo::command_line_parser(argc, argv).options(options).run(), vm);
+    bpo::notify(vm);
+  } catch (bpo::error& e) {
+    std::cerr << e.what() << std::endl;
+    ret = SRSRAN_ERROR;
+  }
+
+  // help option was given or error - print usage and exit
+  if (vm.count("help") || ret) {
+    std::cout << "Usage: " << argv[0] << " [OPTIONS]" << std::endl << std::endl;
+    std::cout << options << std::endl << std::endl;
+    ret = SRSRAN_ERROR;
+  }
+
+  return ret;
+}
+
+// Runs the search and checks that every emulated cell is found with the right PCI and no other channel reports a cell
+static int run_search(const args_t&                       args,
+                      uint32_t                            nof_workers,
+                      const std::vector<uint32_t>&        earfcn_list,
+                      const std::map<uint32_t, uint32_t>& expected_pci,
+                      const enb_rf_emulator::args_t&      emulator_args,
+                      srslog::basic_logger&               logger)
+{
+  enb_rf_emulator radio(emulator_args);
+
+  srsue::wideband_search::args_t search_args = {};
+  search_args.srate_hz                       = args.srate_hz;
+  search_args.nof_workers                    = nof_workers;
+  search_args.max_capture_ms                 = args.max_capture_ms;
+
+  srsue::wideband_search search(logger);
+  TESTASSERT(search.init(search_args));
+
+  auto                                          t_start = std::chrono::steady_clock::now();
+  std::vector<srsue::wideband_search::result_t> results = search.run(&radio, earfcn_list);
+  auto                                          t_end   = std::chrono::steady_clock::now();
+  double elapsed_ms = std::chrono::duration_cast<std::chrono::microseconds>(t_end - t_start).count() / 1000.0;
+
+  TESTASSERT(results.size() == earfcn_list.size());
+
+  uint32_t max_search_time_ms = 0;
+  for (const srsue::wideband_search::result_t& r : results) {
+    auto it = expected_pci.find(r.earfcn);
+    if (it == expected_pci.end()) {
+      TESTASSERT(not r.found);
+      continue;
+    }
+
+    printf("  EARFCN=%d; PCI=%3d; found=%s; psr=%4.1f; mode=%.2f; time=%3d ms;\n",
+           r.earfcn,
+           r.cell.cell_id,
+           r.found ? "y" : "n",
+           r.cell.psr,
+           r.cell.mode,
+           r.search_time_ms);
+    TESTASSERT(r.found);
+    TESTASSERT(r.cell.cell_id == it->second);
+    max_search_time_ms = std::max(max_search_time_ms, r.search_time_ms);
+  }
+
+  printf("workers=%d; channels=%d; srate=%.2f MHz; air time to find all cells=%d ms; processing time=%.1f ms\n",
+         nof_workers,
+         (uint32_t)earfcn_list.size(),
+         args.srate_hz / 1e6,
+         max_search_time_ms,
+         elapsed_ms);
+
+  return SRSRAN_SUCCESS;
+}
+
+// Runs the search with termination criteria that are never met, every emulated cell shall be reported as best-effort
+static int run_best_effort_search(const args_t&                       args,
+                                  const std::vector<uint32_t>&        earfcn_list,
+                                  const std::map<uint32_t, uint32_t>& expected_pci,
+                                  const enb_rf_emulator::args_t&      emulator_args,
+                                  srslog::basic_logger&               logger)
+{
+  enb_rf_emulator radio(emulator_args);
+
+  srsue::wideband_search::args_t search_args = {};
+  search_args.srate_hz                       = args.srate_hz;
+  search_args.nof_workers                    = args.nof_workers;
+  search_args.max_capture_ms                 = 40;
+  search_args.cfg.early_exit_psr             = 1e9f;
+  search_args.cfg.nof_valid_frames           = UINT32_MAX;
+
+  srsue::wideband_search search(logger);
+  TESTASSERT(search.init(search_args));
+
+  std::vector<srsue::wideband_search::result_t> results = search.run(&radio, earfcn_list);
+  TESTASSERT(results.size() == earfcn_list.size());
+
+  for (const srsue::wideband_search::result_t& r : results) {
+    TESTASSERT(not r.found);
+    auto it = expected_pci.find(r.earfcn);
+    if (it != expected_pci.end()) {
+      TESTASSERT(r.best_effort);
+      TESTASSERT(r.cell.cell_id == it->second);
+      TESTASSERT(r.search_time_ms == search_args.max_capture_ms);
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  args_t args = {};
+  if (parse_args(argc, argv, args) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  srslog::init();
+  srslog::basic_logger& logger = srslog::fetch_basic_logger("PHY");
+  logger.set_level(srslog::str_to_basic_level(args.log_level));
+
+  // Emulate a cell on every other channel, with different N_id_2 and random frame timing
+  srsran_random_t              random_gen    = srsran_random_init(args.seed);
+  enb_rf_emulator::args_t      emulator_args = {};
+  std::vector<uint32_t>        earfcn_list;
+  std::map<uint32_t, uint32_t> expected_pci;
+  emulator_args.srate_hz = args.srate_hz;
+  emulator_args.snr_db   = args.snr_db;
+  emulator_args.seed     = args.seed;
+  for (uint32_t i = 0; i < args.nof_earfcn; i++) {
+    uint32_t earfcn = args.earfcn_start + i * args.earfcn_step;
+    earfcn_list.push_back(earfcn);
+    if (i % 2 == 0) {
+      enb_rf_emulator::cell_t cell = {};
+      cell.earfcn                  = earfcn;
+      cell.pci                     = (uint32_t)srsran_random_uniform_int_dist(random_gen, 0, SRSRAN_NUM_PCI - 1);
+      cell.delay_samples           = (uint32_t)srsran_random_uniform_int_dist(random_gen, 0, 19199);
+      emulator_args.cells.push_back(cell);
+      expected_pci[earfcn] = cell.pci;
+    }
+  }
+  srsran_random_free(random_gen);
+
+  // Single worker baseline followed by the multi-threaded search
+  TESTASSERT(run_search(args, 1, earfcn_list, expected_pci, emulator_args, logger) == SRSRAN_SUCCESS);
+  if (args.nof_workers > 1) {
+    TESTASSERT(run_search(args, args.nof_workers, earfcn_list, expected_pci, emulator_args, logger) == SRSRAN_SUCCESS);
+  }
+  TESTASSERT(run_best_effort_search(args, earfcn_list, expected_pci, emulator_args, logger) == SRSRAN_SUCCESS);
+
+  srslog::flush();
+
+  printf("Ok\n");
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,239 @@
+/**
+ * Copyright 2013-2022 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsue/hdr/phy/wideband_search.h"
+#include "srsran/radio/rf_buffer.h"
+#include "srsran/radio/rf_timestamp.h"
+#include <algorithm>
+
+namespace srsue {
+
+wideband_search::~wideband_search()
+{
+  if (pool != nullptr) {
+    pool->stop();
+  }
+  for (std::unique_ptr<channel_t>& ch : channels) {
+    srsran_ue_cellsearch_wb_free(&ch->cs);
+  }
+}
+
+bool wideband_search::init(const args_t& args_)
+{
+  args = args_;
+
+  if (args.srate_hz < SRSRAN_CS_SAMP_FREQ or args.nof_workers == 0 or args.capture_ms == 0) {
+    logger.error("Invalid wideband search arguments");
+    return false;
+  }
+
+  // Every channel center must leave room for the synchronization signals inside the capture bandwidth
+  double max_usable_bw_hz = args.srate_hz - SRSRAN_PSS_LEN * 15e3;
+  if (args.usable_bw_hz > max_usable_bw_hz) {
+    logger.warning("Usable bandwidth %.2f MHz exceeds capture bandwidth, limiting to %.2f MHz",
+                   args.usable_bw_hz / 1e6,
+                   max_usable_bw_hz / 1e6);
+    args.usable_bw_hz = max_usable_bw_hz;
+  }
+
+  capture_len = (uint32_t)(args.srate_hz * args.capture_ms / 1000);
+  for (std::vector<cf_t>& buffer : capture_buffer) {
+    buffer.resize(capture_len);
+  }
+
+  pool = std::unique_ptr<srsran::task_thread_pool>(new srsran::task_thread_pool(args.nof_workers));
+
+  return true;
+}
+
+std::vector<wideband_search::result_t> wideband_search::run(srsran::radio_interface_phy* radio,
+                                                            const std::vector<uint32_t>& earfcn_list)
+{
+  std::vector<result_t> results(earfcn_list.size());
+
+  if (radio == nullptr or pool == nullptr) {
+    logger.error("Wideband search is not initialised");
+    return results;
+  }
+
+  // Sort channels by center frequency
+  std::vector<std::pair<double, uint32_t> > channel_freqs;
+  for (uint32_t i = 0; i < earfcn_list.size(); i++) {
+    results[i].earfcn = earfcn_list[i];
+
+    double freq_hz = srsran_band_fd(earfcn_list[i]) * 1e6;
+    if (freq_hz <= 0) {
+      logger.warning("Skipping invalid DL EARFCN=%d", earfcn_list[i]);
+      continue;
+    }
+    channel_freqs.emplace_back(freq_hz, i);
+  }
+  std::sort(channel_freqs.begin(), channel_freqs.end());
+
+  radio->set_rx_srate(args.srate_hz);
+
+  size_t first = 0;
+  while (first < channel_freqs.size()) {
+    // Group the following channels that fit in the usable bandwidth
+    size_t last = first;
+    while (last + 1 < channel_freqs.size() and
+           channel_freqs[last + 1].first - channel_freqs[first].first <= args.usable_bw_hz) {
+      last++;
+    }
+    uint32_t nof_channels   = last - first + 1;
+    double   center_freq_hz = (channel_freqs[first].first + channel_freqs[last].first) / 2;
+
+    // Create more channel searchers if required, they are reused between groups and calls
+    while (channels.size() < nof_channels) {
+      std::unique_ptr<channel_t> ch = std::unique_ptr<channel_t>(new channel_t);
+      if (srsran_ue_cellsearch_wb_init(&ch->cs, args.srate_hz) < SRSRAN_SUCCESS) {
+        logger.error("Error initiating wideband cell search");
+        return results;
+      }
+      channels.push_back(std::move(ch));
+    }
+
+    for (uint32_t i = 0; i < nof_channels; i++) {
+      channel_t& ch = *channels[i];
+      ch.result     = &results[channel_freqs[first + i].second];
+      ch.done       = false;
+      srsran_ue_cellsearch_wb_set_cfg(&ch.cs, &args.cfg);
+      if (srsran_ue_cellsearch_wb_set_channel(&ch.cs, channel_freqs[first + i].first - center_freq_hz) <
+          SRSRAN_SUCCESS) {
+        logger.error("Error setting channel EARFCN=%d", ch.result->earfcn);
+        return results;
+      }
+    }
+
+    logger.info("Wideband search: searching %d channels around %.2f MHz", nof_channels, center_freq_hz / 1e6);
+    if (not search_group(radio, center_freq_hz, nof_channels)) {
+      return results;
+    }
+
+    first = last + 1;
+  }
+
+  return results;
+}
+
+bool wideband_search::search_group(srsran::radio_interface_phy* radio, double center_freq_hz, uint32_t nof_channels)
+{
+  uint32_t               max_captures = std::max(1U, args.max_capture_ms / args.capture_ms);
+  srsran::rf_timestamp_t rx_time      = {};
+
+  radio->set_rx_freq(0, center_freq_hz);
+
+  srsran::rf_buffer_t first_buffer(capture_buffer[0].data(), capture_len);
+  if (not radio->rx_now(first_buffer, rx_time)) {
+    logger.error("Error receiving samples");
+    return false;
+  }
+
+  for (uint32_t capture_idx = 0; capture_idx < max_captures; capture_idx++) {
+    dispatch(capture_buffer[capture_idx % 2].data(), nof_channels, capture_idx + 1);
+
+    // Receive the next block while the workers process the current one
+    bool rx_ok = true;
+    if (capture_idx + 1 < max_captures) {
+      srsran::rf_buffer_t next_buffer(capture_buffer[(capture_idx + 1) % 2].data(), capture_len);
+      rx_ok = radio->rx_now(next_buffer, rx_time);
+    }
+
+    wait_all();
+
+    if (not rx_ok) {
+      logger.error("Error receiving samples");
+      return false;
+    }
+
+    bool all_done = true;
+    for (uint32_t i = 0; i < nof_channels; i++) {
+      all_done = all_done and channels[i]->done;
+    }
+    if (all_done) {
+      return true;
+    }
+  }
+
+  // Report the most detected cell of the channels that did not reach the termination criteria
+  for (uint32_t i = 0; i < nof_channels; i++) {
+    channel_t& ch = *channels[i];
+    if (not ch.done and srsran_ue_cellsearch_wb_get_best(&ch.cs, &ch.result->cell) > 0) {
+      ch.result->best_effort    = true;
+      ch.result->search_time_ms = max_captures * args.capture_ms;
+      logger.info("Wideband search: best-effort EARFCN=%d; PCI=%d; PSR=%.1f",
+                  ch.result->earfcn,
+                  ch.result->cell.cell_id,
+                  ch.result->cell.psr);
+    }
+  }
+
+  return true;
+}
+
+void wideband_search::dispatch(const cf_t* buffer, uint32_t nof_channels, uint32_t capture_count)
+{
+  for (uint32_t i = 0; i < nof_channels; i++) {
+    channel_t* ch = channels[i].get();
+    if (ch->done) {
+      continue;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      nof_pending++;
+    }
+
+    pool->push_task([this, ch, buffer, capture_count]() {
+      int ret = srsran_ue_cellsearch_wb_feed(&ch->cs, buffer, capture_len, &ch->result->cell);
+      if (ret < SRSRAN_SUCCESS) {
+        logger.error("Error searching EARFCN=%d", ch->result->earfcn);
+        ch->done = true;
+      } else if (ret > 0) {
+        ch->done                   = true;
+        ch->result->found          = true;
+        ch->result->search_time_ms = capture_count * args.capture_ms;
+        logger.info("Wideband search: found EARFCN=%d; PCI=%d; PSR=%.1f; CFO=%+.1f Hz; time=%d ms",
+                    ch->result->earfcn,
+                    ch->result->cell.cell_id,
+                    ch->result->cell.psr,
+                    ch->result->cell.cfo,
+                    ch->result->search_time_ms);
+      }
+
+      std::lock_guard<std::mutex> lock(mutex);
+      nof_pending--;
+      if (nof_pending == 0) {
+        cvar.notify_all();
+      }
+    });
+  }
+}
+
+void wideband_search::wait_all()
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  while (nof_pending > 0) {
+    cvar.wait(lock);
+  }
+}
+
+} // namespace srsue
@@ -171,7 +171,8 @@ int ue_stack_lte::init(const stack_args_t& args_)
   if (args.pkt_trace.mac_pcap.enable && args.pkt_trace.mac_nr_pcap.enable &&
       args.pkt_trace.mac_pcap.filename == args.pkt_trace.mac_nr_pcap.filename) {
     stack_logger.info("Using same MAC PCAP file %s for LTE and NR", args.pkt_trace.mac_pcap.filename.c_str());
-    if (mac_pcap.open(args.pkt_trace.mac_pcap.filename.c_str()) == SRSRAN_SUCCESS) {
+    if (mac_pcap.open(args.pkt_trace.mac_pcap.filename, 0, args.pkt_trace.compression_level) == SRSRAN_SUCCESS) {
+      mac_pcap.set_max_pdu_len(args.pkt_trace.max_pdu_len);
       mac.start_pcap(&mac_pcap);
       mac_nr.start_pcap(&mac_pcap);
       stack_logger.info("Open mac pcap file %s", args.pkt_trace.mac_pcap.filename.c_str());
@@ -180,7 +181,8 @@ int ue_stack_lte::init(const stack_args_t& args_)
     }
   } else {
     if (args.pkt_trace.mac_pcap.enable) {
-      if (mac_pcap.open(args.pkt_trace.mac_pcap.filename.c_str()) == SRSRAN_SUCCESS) {
+      if (mac_pcap.open(args.pkt_trace.mac_pcap.filename, 0, args.pkt_trace.compression_level) == SRSRAN_SUCCESS) {
+        mac_pcap.set_max_pdu_len(args.pkt_trace.max_pdu_len);
         mac.start_pcap(&mac_pcap);
         stack_logger.info("Open mac pcap file %s", args.pkt_trace.mac_pcap.filename.c_str());
       } else {
@@ -189,7 +191,9 @@ int ue_stack_lte::init(const stack_args_t& args_)
     }
 
     if (args.pkt_trace.mac_nr_pcap.enable) {
-      if (mac_nr_pcap.open(args.pkt_trace.mac_nr_pcap.filename.c_str()) == SRSRAN_SUCCESS) {
+      if (mac_nr_pcap.open(args.pkt_trace.mac_nr_pcap.filename, 0, args.pkt_trace.compression_level) ==
+          SRSRAN_SUCCESS) {
+        mac_nr_pcap.set_max_pdu_len(args.pkt_trace.max_pdu_len);
         mac_nr.start_pcap(&mac_nr_pcap);
         stack_logger.info("Open mac nr pcap file %s", args.pkt_trace.mac_nr_pcap.filename.c_str());
       } else {
@@ -199,7 +203,10 @@ int ue_stack_lte::init(const stack_args_t& args_)
   }
 
   if (args.pkt_trace.nas_pcap.enable) {
-    if (nas_pcap.open(args.pkt_trace.nas_pcap.filename.c_str()) == SRSRAN_SUCCESS) {
+    if (nas_pcap.open(args.pkt_trace.nas_pcap.filename,
+                      0,
+                      srsran::srsran_rat_t::lte,
+                      args.pkt_trace.compression_level) == SRSRAN_SUCCESS) {
       nas.start_pcap(&nas_pcap);
       stack_logger.info("Open nas pcap file %s", args.pkt_trace.nas_pcap.filename.c_str());
     } else {